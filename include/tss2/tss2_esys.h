@@ -91,8 +91,51 @@ typedef uint32_t ESYS_TR;
 #define ESYS_TR_RH_AC(x)                (ESYS_TR_RH_AC_FIRST + (ESYS_TR)(x))
 #define ESYS_TR_RH_AC_LAST              (ESYS_TR_RH_AC_FIRST + 0xFFFFU)
 
+#define ESYS_NAME_CACHE_NO_VERIFY       0x1U
+
 typedef struct ESYS_CONTEXT ESYS_CONTEXT;
 
+typedef struct ESYS_SESSION_POOL ESYS_SESSION_POOL;
+
+typedef struct ESYS_EXECUTOR ESYS_EXECUTOR;
+
+/** Send the command of an executor submission, e.g. by calling an _Async function.
+ * @param[in] esys_context The ESYS context of the submission.
+ * @param[in/out] userdata information.
+ * @retval TSS2_RC_SUCCESS if the command was sent.
+ */
+typedef TSS2_RC (*ESYS_EXECUTOR_ASYNC_FCN)(ESYS_CONTEXT *esys_context, void *userdata);
+
+/** Receive the response of an executor submission, e.g. by calling a _Finish function.
+ * @param[in] esys_context The ESYS context of the submission.
+ * @param[in/out] userdata information.
+ * @retval TSS2_BASE_RC_TRY_AGAIN if the response is not complete yet.
+ */
+typedef TSS2_RC (*ESYS_EXECUTOR_FINISH_FCN)(ESYS_CONTEXT *esys_context, void *userdata);
+
+/** Receive the result of an executor submission.
+ * @param[in] esys_context The ESYS context of the submission.
+ * @param[in] rc The response code of the finish or the failed async function.
+ * @param[in/out] userdata information.
+ */
+typedef void (*ESYS_EXECUTOR_DONE_FCN)(ESYS_CONTEXT *esys_context, TSS2_RC rc, void *userdata);
+
+/** Read the next data of Esys_HashStream.
+ * @param[out] buffer The buffer for the data.
+ * @param[in,out] size The size of the buffer; set to the bytes read, 0 at the end.
+ * @param[in/out] userdata information.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval USER_DEFINED user defined errors on failure.
+ */
+typedef TSS2_RC (*ESYS_HASH_STREAM_READ_FCN)(uint8_t *buffer, size_t *size, void *userdata);
+
+/** Report the progress of Esys_NV_ReadAll and Esys_NV_WriteAll.
+ * @param[in] done The number of octets transferred so far.
+ * @param[in] total The number of octets to transfer.
+ * @param[in/out] userdata information.
+ */
+typedef void (*ESYS_NV_PROGRESS_FCN)(size_t done, size_t total, void *userdata);
+
 typedef struct ESYS_CRYPTO_CONTEXT_BLOB ESYS_CRYPTO_CONTEXT_BLOB;
 
 /*
@@ -419,6 +462,109 @@ Esys_GetPollHandles(ESYS_CONTEXT *esys_context, TSS2_TCTI_POLL_HANDLE **handles,
 TSS2_RC
 Esys_SetTimeout(ESYS_CONTEXT *esys_context, int32_t timeout);
 
+TSS2_RC
+Esys_ArenaEnable(ESYS_CONTEXT *esys_context, size_t size);
+
+TSS2_RC
+Esys_ArenaReset(ESYS_CONTEXT *esys_context);
+
+TSS2_RC
+Esys_ResourceManagerEnable(ESYS_CONTEXT *esys_context,
+                           uint32_t      max_objects,
+                           uint32_t      max_sessions);
+
+TSS2_RC
+Esys_ResourceManagerDisable(ESYS_CONTEXT *esys_context);
+
+TSS2_RC
+Esys_Context_Save(ESYS_CONTEXT *esys_context, uint8_t **buffer, size_t *buffer_size);
+
+TSS2_RC
+Esys_Context_Restore(ESYS_CONTEXT *esys_context, const uint8_t *buffer, size_t buffer_size);
+
+TSS2_RC
+Esys_Executor_New(ESYS_EXECUTOR **executor, size_t threads);
+
+void Esys_Executor_Free(ESYS_EXECUTOR **executor);
+
+TSS2_RC
+Esys_Executor_Submit(ESYS_EXECUTOR           *executor,
+                     ESYS_CONTEXT            *esys_context,
+                     ESYS_EXECUTOR_ASYNC_FCN  async,
+                     ESYS_EXECUTOR_FINISH_FCN finish,
+                     ESYS_EXECUTOR_DONE_FCN   done,
+                     void                    *userdata);
+
+TSS2_RC
+Esys_Executor_Run(ESYS_EXECUTOR *executor, int32_t timeout);
+
+TSS2_RC
+Esys_HashStream(ESYS_CONTEXT             *esys_context,
+                ESYS_TR                   key,
+                ESYS_TR                   shandle1,
+                ESYS_TR                   shandle2,
+                ESYS_TR                   shandle3,
+                TPMI_ALG_HASH             hashAlg,
+                ESYS_TR                   hierarchy,
+                ESYS_HASH_STREAM_READ_FCN read,
+                void                     *userdata,
+                TPM2B_DIGEST            **result,
+                TPMT_TK_HASHCHECK       **validation);
+
+TSS2_RC
+Esys_HashBuffer(ESYS_CONTEXT       *esys_context,
+                ESYS_TR             key,
+                ESYS_TR             shandle1,
+                ESYS_TR             shandle2,
+                ESYS_TR             shandle3,
+                TPMI_ALG_HASH       hashAlg,
+                ESYS_TR             hierarchy,
+                const uint8_t      *buffer,
+                size_t              size,
+                TPM2B_DIGEST      **result,
+                TPMT_TK_HASHCHECK **validation);
+
+TSS2_RC
+Esys_NV_ReadAll(ESYS_CONTEXT        *esys_context,
+                ESYS_TR              authHandle,
+                ESYS_TR              nvIndex,
+                ESYS_TR              shandle1,
+                ESYS_TR              shandle2,
+                ESYS_TR              shandle3,
+                UINT16               offset,
+                uint8_t             *data,
+                size_t               size,
+                ESYS_NV_PROGRESS_FCN progress,
+                void                *userdata);
+
+TSS2_RC
+Esys_NV_WriteAll(ESYS_CONTEXT        *esys_context,
+                 ESYS_TR              authHandle,
+                 ESYS_TR              nvIndex,
+                 ESYS_TR              shandle1,
+                 ESYS_TR              shandle2,
+                 ESYS_TR              shandle3,
+                 UINT16               offset,
+                 const uint8_t       *data,
+                 size_t               size,
+                 ESYS_NV_PROGRESS_FCN progress,
+                 void                *userdata);
+
+TSS2_RC
+Esys_CapabilityCacheEnable(ESYS_CONTEXT *esys_context);
+
+TSS2_RC
+Esys_CapabilityCacheDisable(ESYS_CONTEXT *esys_context);
+
+TSS2_RC
+Esys_CapabilityCacheInvalidate(ESYS_CONTEXT *esys_context);
+
+TSS2_RC
+Esys_SerializedModeEnable(ESYS_CONTEXT *esys_context);
+
+TSS2_RC
+Esys_SerializedModeDisable(ESYS_CONTEXT *esys_context);
+
 TSS2_RC
 Esys_TR_Serialize(ESYS_CONTEXT *esys_context,
                   ESYS_TR       object,
@@ -449,6 +595,9 @@ Esys_TR_FromTPMPublic(ESYS_CONTEXT *esysContext,
                       ESYS_TR       optionalSession3,
                       ESYS_TR      *object);
 
+TSS2_RC
+Esys_SetNameCache(ESYS_CONTEXT *esys_context, const char *path, uint32_t flags);
+
 TSS2_RC
 Esys_TR_Close(ESYS_CONTEXT *esys_context, ESYS_TR *rsrc_handle);
 
@@ -478,6 +627,31 @@ Esys_TRSess_GetAuthRequired(ESYS_CONTEXT *esys_context,
                             ESYS_TR       esys_handle,
                             TPMI_YES_NO  *auth_needed);
 
+TSS2_RC
+Esys_SessionPool_New(ESYS_CONTEXT       *esys_context,
+                     ESYS_TR             tpmKey,
+                     ESYS_TR             bind,
+                     TPM2_SE             sessionType,
+                     const TPMT_SYM_DEF *symmetric,
+                     TPMI_ALG_HASH       authHash,
+                     size_t              min,
+                     size_t              max,
+                     ESYS_SESSION_POOL **pool);
+
+TSS2_RC
+Esys_SessionPool_SetMaxUses(ESYS_SESSION_POOL *pool, UINT32 maxUses);
+
+TSS2_RC
+Esys_SessionPool_Refill(ESYS_SESSION_POOL *pool, int32_t timeout);
+
+TSS2_RC
+Esys_SessionPool_Get(ESYS_SESSION_POOL *pool, ESYS_TR *session);
+
+TSS2_RC
+Esys_SessionPool_Put(ESYS_SESSION_POOL *pool, ESYS_TR session, TSS2_RC rc);
+
+void Esys_SessionPool_Free(ESYS_SESSION_POOL **pool);
+
 /* Table 5 - TPM2_Startup Command */
 
 TSS2_RC
@@ -891,6 +1065,9 @@ Esys_Unseal_Async(ESYS_CONTEXT *esysContext,
 TSS2_RC
 Esys_Unseal_Finish(ESYS_CONTEXT *esysContext, TPM2B_SENSITIVE_DATA **outData);
 
+TSS2_RC
+Esys_Unseal_FinishView(ESYS_CONTEXT *esysContext, const uint8_t **outData, UINT16 *outDataSize);
+
 /* Table 33 - TPM2_ObjectChangeAuth Command */
 
 TSS2_RC
@@ -1244,6 +1421,12 @@ Esys_EncryptDecrypt2_Finish(ESYS_CONTEXT      *esysContext,
                             TPM2B_MAX_BUFFER **outData,
                             TPM2B_IV         **ivOut);
 
+TSS2_RC
+Esys_EncryptDecrypt2_FinishView(ESYS_CONTEXT   *esysContext,
+                                const uint8_t **outData,
+                                UINT16         *outDataSize,
+                                TPM2B_IV       *ivOut);
+
 /* Table 62 - TPM2_Hash Command */
 
 TSS2_RC
@@ -3213,6 +3396,9 @@ Esys_NV_Read_Async(ESYS_CONTEXT *esysContext,
 TSS2_RC
 Esys_NV_Read_Finish(ESYS_CONTEXT *esysContext, TPM2B_MAX_NV_BUFFER **data);
 
+TSS2_RC
+Esys_NV_Read_FinishView(ESYS_CONTEXT *esysContext, const uint8_t **data, UINT16 *dataSize);
+
 /* Table 227 - TPM2_NV_ReadLock Command */
 
 TSS2_RC
@@ -221,6 +221,13 @@ Tss2_MU_TPM2B_MAX_NV_BUFFER_Unmarshal(uint8_t const        buffer[],
                                       size_t              *offset,
                                       TPM2B_MAX_NV_BUFFER *dest);
 
+TSS2_RC
+Tss2_MU_TPM2B_MAX_NV_BUFFER_UnmarshalView(uint8_t const   buffer[],
+                                          size_t          buffer_size,
+                                          size_t         *offset,
+                                          uint8_t const **data,
+                                          UINT16         *data_size);
+
 TSS2_RC
 Tss2_MU_TPM2B_SENSITIVE_DATA_Marshal(TPM2B_SENSITIVE_DATA const *src,
                                      uint8_t                     buffer[],
@@ -233,6 +240,13 @@ Tss2_MU_TPM2B_SENSITIVE_DATA_Unmarshal(uint8_t const         buffer[],
                                        size_t               *offset,
                                        TPM2B_SENSITIVE_DATA *dest);
 
+TSS2_RC
+Tss2_MU_TPM2B_SENSITIVE_DATA_UnmarshalView(uint8_t const   buffer[],
+                                           size_t          buffer_size,
+                                           size_t         *offset,
+                                           uint8_t const **data,
+                                           UINT16         *data_size);
+
 TSS2_RC
 Tss2_MU_TPM2B_ECC_PARAMETER_Marshal(TPM2B_ECC_PARAMETER const *src,
                                     uint8_t                    buffer[],
@@ -281,6 +295,13 @@ Tss2_MU_TPM2B_PRIVATE_Unmarshal(uint8_t const  buffer[],
                                 size_t        *offset,
                                 TPM2B_PRIVATE *dest);
 
+TSS2_RC
+Tss2_MU_TPM2B_PRIVATE_UnmarshalView(uint8_t const   buffer[],
+                                    size_t          buffer_size,
+                                    size_t         *offset,
+                                    uint8_t const **data,
+                                    UINT16         *data_size);
+
 TSS2_RC
 Tss2_MU_TPM2B_CONTEXT_SENSITIVE_Marshal(TPM2B_CONTEXT_SENSITIVE const *src,
                                         uint8_t                        buffer[],
@@ -470,6 +491,13 @@ Tss2_MU_TPM2B_MAX_BUFFER_Unmarshal(uint8_t const     buffer[],
                                    size_t           *offset,
                                    TPM2B_MAX_BUFFER *dest);
 
+TSS2_RC
+Tss2_MU_TPM2B_MAX_BUFFER_UnmarshalView(uint8_t const   buffer[],
+                                       size_t          buffer_size,
+                                       size_t         *offset,
+                                       uint8_t const **data,
+                                       UINT16         *data_size);
+
 TSS2_RC
 Tss2_MU_TPM2B_NONCE_Marshal(TPM2B_NONCE const *src,
                             uint8_t            buffer[],
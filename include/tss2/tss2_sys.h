@@ -25,6 +25,9 @@ extern "C" {
 /* SAPI context blob */
 typedef struct _TSS2_SYS_OPAQUE_CONTEXT_BLOB TSS2_SYS_CONTEXT;
 
+/* Prepared command template */
+typedef struct TSS2_SYS_CMD_TEMPLATE TSS2_SYS_CMD_TEMPLATE;
+
 #define TSS2_SYS_MAX_SESSIONS 3
 
 /* Input structure for authorization area(s). */
@@ -60,6 +63,10 @@ TSS2_RC Tss2_Sys_SetDecryptParam(TSS2_SYS_CONTEXT *sysContext,
                                  size_t            decryptParamSize,
                                  const uint8_t    *decryptParamBuffer);
 
+TSS2_RC Tss2_Sys_GetDecryptParamMutable(TSS2_SYS_CONTEXT *sysContext,
+                                        size_t           *decryptParamSize,
+                                        uint8_t         **decryptParamBuffer);
+
 TSS2_RC Tss2_Sys_GetCpBuffer(TSS2_SYS_CONTEXT *sysContext,
                              size_t           *cpBufferUsedSize,
                              const uint8_t   **cpBuffer);
@@ -67,6 +74,19 @@ TSS2_RC Tss2_Sys_GetCpBuffer(TSS2_SYS_CONTEXT *sysContext,
 TSS2_RC Tss2_Sys_SetCmdAuths(TSS2_SYS_CONTEXT             *sysContext,
                              const TSS2L_SYS_AUTH_COMMAND *cmdAuthsArray);
 
+/* Prepared Command Template Functions */
+TSS2_RC Tss2_Sys_SaveCommandTemplate(TSS2_SYS_CONTEXT      *sysContext,
+                                     TSS2_SYS_CMD_TEMPLATE *cmdTemplate,
+                                     size_t                *cmdTemplateSize);
+
+TSS2_RC Tss2_Sys_LoadCommandTemplate(TSS2_SYS_CONTEXT            *sysContext,
+                                     const TSS2_SYS_CMD_TEMPLATE *cmdTemplate);
+
+TSS2_RC Tss2_Sys_PatchCpBuffer(TSS2_SYS_CONTEXT *sysContext,
+                               size_t            offset,
+                               size_t            size,
+                               const uint8_t    *buffer);
+
 /* Command Execution Functions */
 TSS2_RC Tss2_Sys_ExecuteAsync(TSS2_SYS_CONTEXT *sysContext);
 
@@ -74,6 +94,22 @@ TSS2_RC Tss2_Sys_ExecuteFinish(TSS2_SYS_CONTEXT *sysContext, int32_t timeout);
 
 TSS2_RC Tss2_Sys_Execute(TSS2_SYS_CONTEXT *sysContext);
 
+typedef TSS2_RC (*TSS2_SYS_BATCH_PREPARE_FN)(TSS2_SYS_CONTEXT *sysContext,
+                                             size_t            index,
+                                             void             *userData);
+
+typedef TSS2_RC (*TSS2_SYS_BATCH_COMPLETE_FN)(TSS2_SYS_CONTEXT *sysContext,
+                                              size_t            index,
+                                              TSS2_RC           responseCode,
+                                              void             *userData);
+
+TSS2_RC Tss2_Sys_ExecuteBatch(TSS2_SYS_CONTEXT *const   *sysContexts,
+                              size_t                     numContexts,
+                              size_t                     numCommands,
+                              TSS2_SYS_BATCH_PREPARE_FN  prepare,
+                              TSS2_SYS_BATCH_COMPLETE_FN complete,
+                              void                      *userData);
+
 /* Command Completion functions */
 TSS2_RC Tss2_Sys_GetCommandCode(TSS2_SYS_CONTEXT *sysContext, UINT8 *commandCode);
 
@@ -87,6 +123,10 @@ TSS2_RC Tss2_Sys_SetEncryptParam(TSS2_SYS_CONTEXT *sysContext,
                                  size_t            encryptParamSize,
                                  const uint8_t    *encryptParamBuffer);
 
+TSS2_RC Tss2_Sys_GetEncryptParamMutable(TSS2_SYS_CONTEXT *sysContext,
+                                        size_t           *encryptParamSize,
+                                        uint8_t         **encryptParamBuffer);
+
 TSS2_RC Tss2_Sys_GetRpBuffer(TSS2_SYS_CONTEXT *sysContext,
                              size_t           *rpBufferUsedSize,
                              const uint8_t   **rpBuffer);
@@ -289,6 +329,10 @@ TSS2_RC Tss2_Sys_Unseal_Prepare(TSS2_SYS_CONTEXT *sysContext, TPMI_DH_OBJECT ite
 
 TSS2_RC Tss2_Sys_Unseal_Complete(TSS2_SYS_CONTEXT *sysContext, TPM2B_SENSITIVE_DATA *outData);
 
+TSS2_RC Tss2_Sys_Unseal_CompleteView(TSS2_SYS_CONTEXT *sysContext,
+                                     const uint8_t   **outData,
+                                     UINT16           *outDataSize);
+
 TSS2_RC Tss2_Sys_Unseal(TSS2_SYS_CONTEXT             *sysContext,
                         TPMI_DH_OBJECT                itemHandle,
                         TSS2L_SYS_AUTH_COMMAND const *cmdAuthsArray,
@@ -501,6 +545,11 @@ TSS2_RC Tss2_Sys_EncryptDecrypt2_Complete(TSS2_SYS_CONTEXT *sysContext,
                                           TPM2B_MAX_BUFFER *outData,
                                           TPM2B_IV         *ivOut);
 
+TSS2_RC Tss2_Sys_EncryptDecrypt2_CompleteView(TSS2_SYS_CONTEXT *sysContext,
+                                              const uint8_t   **outData,
+                                              UINT16           *outDataSize,
+                                              TPM2B_IV         *ivOut);
+
 TSS2_RC Tss2_Sys_EncryptDecrypt2(TSS2_SYS_CONTEXT             *sysContext,
                                  TPMI_DH_OBJECT                keyHandle,
                                  TSS2L_SYS_AUTH_COMMAND const *cmdAuthsArray,
@@ -1703,6 +1752,10 @@ TSS2_RC Tss2_Sys_NV_Read_Prepare(TSS2_SYS_CONTEXT *sysContext,
 
 TSS2_RC Tss2_Sys_NV_Read_Complete(TSS2_SYS_CONTEXT *sysContext, TPM2B_MAX_NV_BUFFER *data);
 
+TSS2_RC Tss2_Sys_NV_Read_CompleteView(TSS2_SYS_CONTEXT *sysContext,
+                                      const uint8_t   **data,
+                                      UINT16           *dataSize);
+
 TSS2_RC Tss2_Sys_NV_Read(TSS2_SYS_CONTEXT             *sysContext,
                          TPMI_RH_NV_AUTH               authHandle,
                          TPMI_RH_NV_INDEX              nvIndex,
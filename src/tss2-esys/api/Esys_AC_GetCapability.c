@@ -8,7 +8,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -64,8 +64,10 @@ Esys_AC_GetCapability(ESYS_CONTEXT          *esysContext,
                       TPML_AC_CAPABILITIES **capabilityData) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_AC_GetCapability_Async(esysContext, optionalSession1, optionalSession2,
                                     optionalSession3, ac, capability, count);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -89,6 +91,7 @@ Esys_AC_GetCapability(ESYS_CONTEXT          *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return r;
@@ -240,7 +243,7 @@ Esys_AC_GetCapability_Finish(ESYS_CONTEXT          *esysContext,
 
     /* Allocate memory for response parameters */
     if (capabilityData != NULL) {
-        *capabilityData = calloc(1, sizeof(TPML_AC_CAPABILITIES));
+        *capabilityData = iesys_output_calloc(esysContext, sizeof(TPML_AC_CAPABILITIES));
         if (*capabilityData == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -309,7 +312,7 @@ Esys_AC_GetCapability_Finish(ESYS_CONTEXT          *esysContext,
 
 error_cleanup:
     if (capabilityData != NULL)
-        SAFE_FREE(*capabilityData);
+        ESYS_OUTPUT_FREE(esysContext, *capabilityData);
 
     return r;
 }
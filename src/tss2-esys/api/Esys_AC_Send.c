@@ -8,7 +8,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, iesys_hand...
@@ -65,8 +65,10 @@ Esys_AC_Send(ESYS_CONTEXT     *esysContext,
              TPMS_AC_OUTPUT  **acDataOut) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_AC_Send_Async(esysContext, sendObject, nvAuthHandle, optionalSession1,
                            optionalSession2, optionalSession3, ac, acDataIn);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -90,6 +92,7 @@ Esys_AC_Send(ESYS_CONTEXT     *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return r;
@@ -265,7 +268,7 @@ Esys_AC_Send_Finish(ESYS_CONTEXT *esysContext, TPMS_AC_OUTPUT **acDataOut) {
 
     /* Allocate memory for response parameters */
     if (acDataOut != NULL) {
-        *acDataOut = calloc(1, sizeof(TPMS_AC_OUTPUT));
+        *acDataOut = iesys_output_calloc(esysContext, sizeof(TPMS_AC_OUTPUT));
         if (*acDataOut == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -333,7 +336,7 @@ Esys_AC_Send_Finish(ESYS_CONTEXT *esysContext, TPMS_AC_OUTPUT **acDataOut) {
 
 error_cleanup:
     if (acDataOut != NULL)
-        SAFE_FREE(*acDataOut);
+        ESYS_OUTPUT_FREE(esysContext, *acDataOut);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -77,8 +77,10 @@ Esys_ActivateCredential(ESYS_CONTEXT                 *esysContext,
                         TPM2B_DIGEST                **certInfo) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ActivateCredential_Async(esysContext, activateHandle, keyHandle, shandle1, shandle2,
                                       shandle3, credentialBlob, secret);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -101,6 +103,7 @@ Esys_ActivateCredential(ESYS_CONTEXT                 *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -268,7 +271,7 @@ Esys_ActivateCredential_Finish(ESYS_CONTEXT *esysContext, TPM2B_DIGEST **certInf
 
     /* Allocate memory for response parameters */
     if (certInfo != NULL) {
-        *certInfo = calloc(1, sizeof(TPM2B_DIGEST));
+        *certInfo = iesys_output_calloc(esysContext, sizeof(TPM2B_DIGEST));
         if (*certInfo == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -337,7 +340,7 @@ Esys_ActivateCredential_Finish(ESYS_CONTEXT *esysContext, TPM2B_DIGEST **certInf
 
 error_cleanup:
     if (certInfo != NULL)
-        SAFE_FREE(*certInfo);
+        ESYS_OUTPUT_FREE(esysContext, *certInfo);
 
     return r;
 }
@@ -10,7 +10,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -84,8 +84,10 @@ Esys_CertifyX509(ESYS_CONTEXT           *esysContext,
                  TPMT_SIGNATURE        **signature) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_CertifyX509_Async(esysContext, objectHandle, signHandle, shandle1, shandle2, shandle3,
                                reserved, inScheme, partialCertificate);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -108,6 +110,7 @@ Esys_CertifyX509(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -283,19 +286,19 @@ Esys_CertifyX509_Finish(ESYS_CONTEXT      *esysContext,
 
     /* Allocate memory for response parameters */
     if (addedToCertificate != NULL) {
-        *addedToCertificate = calloc(1, sizeof(TPM2B_MAX_BUFFER));
+        *addedToCertificate = iesys_output_calloc(esysContext, sizeof(TPM2B_MAX_BUFFER));
         if (*addedToCertificate == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (tbsDigest != NULL) {
-        *tbsDigest = calloc(1, sizeof(TPM2B_DIGEST));
+        *tbsDigest = iesys_output_calloc(esysContext, sizeof(TPM2B_DIGEST));
         if (*tbsDigest == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
     }
     if (signature != NULL) {
-        *signature = calloc(1, sizeof(TPMT_SIGNATURE));
+        *signature = iesys_output_calloc(esysContext, sizeof(TPMT_SIGNATURE));
         if (*signature == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -365,11 +368,11 @@ Esys_CertifyX509_Finish(ESYS_CONTEXT      *esysContext,
 
 error_cleanup:
     if (addedToCertificate != NULL)
-        SAFE_FREE(*addedToCertificate);
+        ESYS_OUTPUT_FREE(esysContext, *addedToCertificate);
     if (tbsDigest != NULL)
-        SAFE_FREE(*tbsDigest);
+        ESYS_OUTPUT_FREE(esysContext, *tbsDigest);
     if (signature != NULL)
-        SAFE_FREE(*signature);
+        ESYS_OUTPUT_FREE(esysContext, *signature);
 
     return r;
 }
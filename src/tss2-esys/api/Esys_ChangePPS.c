@@ -71,7 +71,9 @@ Esys_ChangePPS(ESYS_CONTEXT *esysContext,
                ESYS_TR       shandle3) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ChangePPS_Async(esysContext, authHandle, shandle1, shandle2, shandle3);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -94,6 +96,7 @@ Esys_ChangePPS(ESYS_CONTEXT *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -74,7 +74,9 @@ Esys_ClearControl(ESYS_CONTEXT *esysContext,
                   TPMI_YES_NO   disable) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ClearControl_Async(esysContext, auth, shandle1, shandle2, shandle3, disable);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -97,6 +99,7 @@ Esys_ClearControl(ESYS_CONTEXT *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -73,7 +73,9 @@ Esys_ClockSet(ESYS_CONTEXT *esysContext,
               UINT64        newTime) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ClockSet_Async(esysContext, auth, shandle1, shandle2, shandle3, newTime);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -96,6 +98,7 @@ Esys_ClockSet(ESYS_CONTEXT *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
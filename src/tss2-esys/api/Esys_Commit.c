@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -83,7 +83,9 @@ Esys_Commit(ESYS_CONTEXT               *esysContext,
             UINT16                     *counter) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Commit_Async(esysContext, signHandle, shandle1, shandle2, shandle3, P1, s2, y2);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -106,6 +108,7 @@ Esys_Commit(ESYS_CONTEXT               *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -277,19 +280,19 @@ Esys_Commit_Finish(ESYS_CONTEXT     *esysContext,
 
     /* Allocate memory for response parameters */
     if (K != NULL) {
-        *K = calloc(1, sizeof(TPM2B_ECC_POINT));
+        *K = iesys_output_calloc(esysContext, sizeof(TPM2B_ECC_POINT));
         if (*K == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (L != NULL) {
-        *L = calloc(1, sizeof(TPM2B_ECC_POINT));
+        *L = iesys_output_calloc(esysContext, sizeof(TPM2B_ECC_POINT));
         if (*L == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
     }
     if (E != NULL) {
-        *E = calloc(1, sizeof(TPM2B_ECC_POINT));
+        *E = iesys_output_calloc(esysContext, sizeof(TPM2B_ECC_POINT));
         if (*E == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -358,11 +361,11 @@ Esys_Commit_Finish(ESYS_CONTEXT     *esysContext,
 
 error_cleanup:
     if (K != NULL)
-        SAFE_FREE(*K);
+        ESYS_OUTPUT_FREE(esysContext, *K);
     if (L != NULL)
-        SAFE_FREE(*L);
+        ESYS_OUTPUT_FREE(esysContext, *L);
     if (E != NULL)
-        SAFE_FREE(*E);
+        ESYS_OUTPUT_FREE(esysContext, *E);
 
     return r;
 }
@@ -64,7 +64,9 @@ TSS2_RC
 Esys_ContextLoad(ESYS_CONTEXT *esysContext, const TPMS_CONTEXT *context, ESYS_TR *loadedHandle) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ContextLoad_Async(esysContext, context);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -87,6 +89,7 @@ Esys_ContextLoad(ESYS_CONTEXT *esysContext, const TPMS_CONTEXT *context, ESYS_TR
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -157,6 +160,11 @@ Esys_ContextLoad_Async(ESYS_CONTEXT *esysContext, const TPMS_CONTEXT *context) {
     /* Initial invocation of SAPI to prepare the command buffer with parameters */
     r = Tss2_Sys_ContextLoad_Prepare(esysContext->sys, context);
     return_state_if_error(r, ESYS_STATE_INIT, "SAPI Prepare returned error.");
+
+    /* Make room in the TPM for the new object or session */
+    r = iesys_rm_reserve(esysContext, iesys_get_handle_type(context->savedHandle));
+    return_state_if_error(r, ESYS_STATE_INIT, "Resource manager");
+
     /* Trigger execution and finish the async invocation */
     r = Tss2_Sys_ExecuteAsync(esysContext->sys);
     return_state_if_error(r, ESYS_STATE_INTERNALERROR, "Finish (Execute Async)");
@@ -229,7 +237,8 @@ Esys_ContextLoad_Finish(ESYS_CONTEXT *esysContext, ESYS_TR *loadedHandle) {
         &offset, &esyscontextData);
     goto_if_error(r, "while unmarshaling context ", error_cleanup);
 
-    loadedHandleNode->rsrc = esyscontextData.esysMetadata.data;
+    r = iesys_rsrc_set(esysContext, loadedHandleNode, &esyscontextData.esysMetadata.data);
+    goto_if_error(r, "Store resource", error_cleanup);
 
     /*Receive the TPM response and handle resubmissions if necessary. */
     r = Tss2_Sys_ExecuteFinish(esysContext->sys, esysContext->timeout);
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc, size_t
+#include <stdlib.h>   // for NULL, size_t
 #include <string.h>   // for memcpy
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
@@ -64,7 +64,9 @@ TSS2_RC
 Esys_ContextSave(ESYS_CONTEXT *esysContext, ESYS_TR saveHandle, TPMS_CONTEXT **context) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ContextSave_Async(esysContext, saveHandle);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -87,6 +89,7 @@ Esys_ContextSave(ESYS_CONTEXT *esysContext, ESYS_TR saveHandle, TPMS_CONTEXT **c
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -195,7 +198,7 @@ Esys_ContextSave_Finish(ESYS_CONTEXT *esysContext, TPMS_CONTEXT **context) {
     esysContext->state = ESYS_STATE_INTERNALERROR;
 
     /* Allocate memory for response parameters */
-    lcontext = calloc(1, sizeof(TPMS_CONTEXT));
+    lcontext = iesys_output_calloc(esysContext, sizeof(TPMS_CONTEXT));
     if (lcontext == NULL) {
         return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
     }
@@ -256,7 +259,8 @@ Esys_ContextSave_Finish(ESYS_CONTEXT *esysContext, TPMS_CONTEXT **context) {
     goto_if_error(r, "Error GetResourceObjectn", error_cleanup);
 
     esyscontextData.esysMetadata.size = 0;
-    esyscontextData.esysMetadata.data = esys_object->rsrc;
+    r = iesys_rsrc_get(esys_object, &esyscontextData.esysMetadata.data);
+    goto_if_error(r, "Get resource", error_cleanup);
     offset = 0;
     r = iesys_MU_IESYS_CONTEXT_DATA_Marshal(&esyscontextData, &(lcontext)->contextBlob.buffer[0],
                                             sizeof(TPMS_CONTEXT_DATA), &offset);
@@ -274,14 +278,14 @@ Esys_ContextSave_Finish(ESYS_CONTEXT *esysContext, TPMS_CONTEXT **context) {
     if (context != NULL)
         *context = lcontext;
     else
-        SAFE_FREE(lcontext);
+        ESYS_OUTPUT_FREE(esysContext, lcontext);
 
     esysContext->state = ESYS_STATE_INIT;
 
     return TSS2_RC_SUCCESS;
 
 error_cleanup:
-    SAFE_FREE(lcontext);
+    ESYS_OUTPUT_FREE(esysContext, lcontext);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -102,8 +102,10 @@ Esys_Create(ESYS_CONTEXT                 *esysContext,
             TPMT_TK_CREATION            **creationTicket) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Create_Async(esysContext, parentHandle, shandle1, shandle2, shandle3, inSensitive,
                           inPublic, outsideInfo, creationPCR);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -127,6 +129,7 @@ Esys_Create(ESYS_CONTEXT                 *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -319,31 +322,31 @@ Esys_Create_Finish(ESYS_CONTEXT         *esysContext,
 
     /* Allocate memory for response parameters */
     if (outPrivate != NULL) {
-        *outPrivate = calloc(1, sizeof(TPM2B_PRIVATE));
+        *outPrivate = iesys_output_calloc(esysContext, sizeof(TPM2B_PRIVATE));
         if (*outPrivate == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (outPublic != NULL) {
-        *outPublic = calloc(1, sizeof(TPM2B_PUBLIC));
+        *outPublic = iesys_output_calloc(esysContext, sizeof(TPM2B_PUBLIC));
         if (*outPublic == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
     }
     if (creationData != NULL) {
-        *creationData = calloc(1, sizeof(TPM2B_CREATION_DATA));
+        *creationData = iesys_output_calloc(esysContext, sizeof(TPM2B_CREATION_DATA));
         if (*creationData == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
     }
     if (creationHash != NULL) {
-        *creationHash = calloc(1, sizeof(TPM2B_DIGEST));
+        *creationHash = iesys_output_calloc(esysContext, sizeof(TPM2B_DIGEST));
         if (*creationHash == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
     }
     if (creationTicket != NULL) {
-        *creationTicket = calloc(1, sizeof(TPMT_TK_CREATION));
+        *creationTicket = iesys_output_calloc(esysContext, sizeof(TPMT_TK_CREATION));
         if (*creationTicket == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -415,15 +418,15 @@ Esys_Create_Finish(ESYS_CONTEXT         *esysContext,
 
 error_cleanup:
     if (outPrivate != NULL)
-        SAFE_FREE(*outPrivate);
+        ESYS_OUTPUT_FREE(esysContext, *outPrivate);
     if (outPublic != NULL)
-        SAFE_FREE(*outPublic);
+        ESYS_OUTPUT_FREE(esysContext, *outPublic);
     if (creationData != NULL)
-        SAFE_FREE(*creationData);
+        ESYS_OUTPUT_FREE(esysContext, *creationData);
     if (creationHash != NULL)
-        SAFE_FREE(*creationHash);
+        ESYS_OUTPUT_FREE(esysContext, *creationHash);
     if (creationTicket != NULL)
-        SAFE_FREE(*creationTicket);
+        ESYS_OUTPUT_FREE(esysContext, *creationTicket);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc, size_t
+#include <stdlib.h>   // for NULL, size_t
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, CreateLoaded_IN
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -100,8 +100,10 @@ Esys_CreateLoaded(ESYS_CONTEXT                 *esysContext,
                   TPM2B_PUBLIC                **outPublic) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_CreateLoaded_Async(esysContext, parentHandle, shandle1, shandle2, shandle3,
                                 inSensitive, inPublic);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -124,6 +126,7 @@ Esys_CreateLoaded(ESYS_CONTEXT                 *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -237,6 +240,10 @@ Esys_CreateLoaded_Async(ESYS_CONTEXT                 *esysContext,
         return_state_if_error(r, ESYS_STATE_INIT, "SAPI error on SetCmdAuths");
     }
 
+    /* Make room in the TPM for the new object */
+    r = iesys_rm_reserve(esysContext, TPM2_HT_TRANSIENT);
+    return_state_if_error(r, ESYS_STATE_INIT, "Resource manager");
+
     /* Trigger execution and finish the async invocation */
     r = Tss2_Sys_ExecuteAsync(esysContext->sys);
     return_state_if_error(r, ESYS_STATE_INTERNALERROR, "Finish (Execute Async)");
@@ -314,12 +321,12 @@ Esys_CreateLoaded_Finish(ESYS_CONTEXT   *esysContext,
         return r;
 
     if (outPrivate != NULL) {
-        *outPrivate = calloc(1, sizeof(TPM2B_PRIVATE));
+        *outPrivate = iesys_output_calloc(esysContext, sizeof(TPM2B_PRIVATE));
         if (*outPrivate == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
     }
-    loutPublic = calloc(1, sizeof(TPM2B_PUBLIC));
+    loutPublic = iesys_output_calloc(esysContext, sizeof(TPM2B_PUBLIC));
     if (loutPublic == NULL) {
         goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
     }
@@ -383,12 +390,11 @@ Esys_CreateLoaded_Finish(ESYS_CONTEXT   *esysContext,
                         error_cleanup);
 
     /* Update the meta data of the ESYS_TR object */
-    objectHandleNode->rsrc.rsrcType = IESYSC_KEY_RSRC;
-    objectHandleNode->rsrc.misc.rsrc_key_pub = *loutPublic;
+    r = iesys_rsrc_set_key_public(esysContext, objectHandleNode, loutPublic);
+    goto_state_if_error(r, ESYS_STATE_INTERNALERROR, "Store public area", error_cleanup);
 
     /* Check name and outPublic for consistency */
-    if (!iesys_compare_name(&esysContext->crypto_backend, &objectHandleNode->rsrc.misc.rsrc_key_pub,
-                            &name))
+    if (!iesys_compare_name(&esysContext->crypto_backend, loutPublic, &name))
         goto_error(r, TSS2_ESYS_RC_MALFORMED_RESPONSE, "in Public name not equal name in response",
                    error_cleanup);
 
@@ -398,7 +404,7 @@ Esys_CreateLoaded_Finish(ESYS_CONTEXT   *esysContext,
     if (outPublic != NULL)
         *outPublic = loutPublic;
     else
-        SAFE_FREE(loutPublic);
+        ESYS_OUTPUT_FREE(esysContext, loutPublic);
 
     esysContext->state = ESYS_STATE_INIT;
 
@@ -407,8 +413,8 @@ Esys_CreateLoaded_Finish(ESYS_CONTEXT   *esysContext,
 error_cleanup:
     Esys_TR_Close(esysContext, objectHandle);
     if (outPrivate != NULL)
-        SAFE_FREE(*outPrivate);
-    SAFE_FREE(loutPublic);
+        ESYS_OUTPUT_FREE(esysContext, *outPrivate);
+    ESYS_OUTPUT_FREE(esysContext, loutPublic);
 
     return r;
 }
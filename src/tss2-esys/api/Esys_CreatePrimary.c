@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -103,8 +103,10 @@ Esys_CreatePrimary(ESYS_CONTEXT                 *esysContext,
                    TPMT_TK_CREATION            **creationTicket) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_CreatePrimary_Async(esysContext, primaryHandle, shandle1, shandle2, shandle3,
                                  inSensitive, inPublic, outsideInfo, creationPCR);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -128,6 +130,7 @@ Esys_CreatePrimary(ESYS_CONTEXT                 *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -240,6 +243,10 @@ Esys_CreatePrimary_Async(ESYS_CONTEXT                 *esysContext,
         return_state_if_error(r, ESYS_STATE_INIT, "SAPI error on SetCmdAuths");
     }
 
+    /* Make room in the TPM for the new object */
+    r = iesys_rm_reserve(esysContext, TPM2_HT_TRANSIENT);
+    return_state_if_error(r, ESYS_STATE_INIT, "Resource manager");
+
     /* Trigger execution and finish the async invocation */
     r = Tss2_Sys_ExecuteAsync(esysContext->sys);
     return_state_if_error(r, ESYS_STATE_INTERNALERROR, "Finish (Execute Async)");
@@ -329,24 +336,24 @@ Esys_CreatePrimary_Finish(ESYS_CONTEXT         *esysContext,
     if (r != TSS2_RC_SUCCESS)
         return r;
 
-    loutPublic = calloc(1, sizeof(TPM2B_PUBLIC));
+    loutPublic = iesys_output_calloc(esysContext, sizeof(TPM2B_PUBLIC));
     if (loutPublic == NULL) {
         goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
     }
     if (creationData != NULL) {
-        *creationData = calloc(1, sizeof(TPM2B_CREATION_DATA));
+        *creationData = iesys_output_calloc(esysContext, sizeof(TPM2B_CREATION_DATA));
         if (*creationData == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
     }
     if (creationHash != NULL) {
-        *creationHash = calloc(1, sizeof(TPM2B_DIGEST));
+        *creationHash = iesys_output_calloc(esysContext, sizeof(TPM2B_DIGEST));
         if (*creationHash == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
     }
     if (creationTicket != NULL) {
-        *creationTicket = calloc(1, sizeof(TPMT_TK_CREATION));
+        *creationTicket = iesys_output_calloc(esysContext, sizeof(TPMT_TK_CREATION));
         if (*creationTicket == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -419,12 +426,12 @@ Esys_CreatePrimary_Finish(ESYS_CONTEXT         *esysContext,
     /* Update the meta data of the ESYS_TR object */
     objectHandleNode->auth = (*esysContext->in.CreatePrimary.inSensitive).sensitive.userAuth;
     objectHandleNode->rsrc.name = name;
-    objectHandleNode->rsrc.rsrcType = IESYSC_KEY_RSRC;
-    objectHandleNode->rsrc.misc.rsrc_key_pub = *loutPublic;
+    r = iesys_rsrc_set_key_public(esysContext, objectHandleNode, loutPublic);
+    goto_state_if_error(r, ESYS_STATE_INTERNALERROR, "Store public area", error_cleanup);
     if (outPublic != NULL)
         *outPublic = loutPublic;
     else
-        SAFE_FREE(loutPublic);
+        ESYS_OUTPUT_FREE(esysContext, loutPublic);
 
     esysContext->state = ESYS_STATE_INIT;
 
@@ -432,13 +439,13 @@ Esys_CreatePrimary_Finish(ESYS_CONTEXT         *esysContext,
 
 error_cleanup:
     Esys_TR_Close(esysContext, objectHandle);
-    SAFE_FREE(loutPublic);
+    ESYS_OUTPUT_FREE(esysContext, loutPublic);
     if (creationData != NULL)
-        SAFE_FREE(*creationData);
+        ESYS_OUTPUT_FREE(esysContext, *creationData);
     if (creationHash != NULL)
-        SAFE_FREE(*creationHash);
+        ESYS_OUTPUT_FREE(esysContext, *creationHash);
     if (creationTicket != NULL)
-        SAFE_FREE(*creationTicket);
+        ESYS_OUTPUT_FREE(esysContext, *creationTicket);
 
     return r;
 }
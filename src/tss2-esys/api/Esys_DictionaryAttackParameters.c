@@ -80,8 +80,10 @@ Esys_DictionaryAttackParameters(ESYS_CONTEXT *esysContext,
                                 UINT32        lockoutRecovery) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_DictionaryAttackParameters_Async(esysContext, lockHandle, shandle1, shandle2, shandle3,
                                               newMaxTries, newRecoveryTime, lockoutRecovery);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -104,6 +106,7 @@ Esys_DictionaryAttackParameters(ESYS_CONTEXT *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -87,8 +87,10 @@ Esys_Duplicate(ESYS_CONTEXT              *esysContext,
                TPM2B_ENCRYPTED_SECRET   **outSymSeed) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Duplicate_Async(esysContext, objectHandle, newParentHandle, shandle1, shandle2,
                              shandle3, encryptionKeyIn, symmetricAlg);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -111,6 +113,7 @@ Esys_Duplicate(ESYS_CONTEXT              *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -290,19 +293,19 @@ Esys_Duplicate_Finish(ESYS_CONTEXT            *esysContext,
 
     /* Allocate memory for response parameters */
     if (encryptionKeyOut != NULL) {
-        *encryptionKeyOut = calloc(1, sizeof(TPM2B_DATA));
+        *encryptionKeyOut = iesys_output_calloc(esysContext, sizeof(TPM2B_DATA));
         if (*encryptionKeyOut == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (duplicate != NULL) {
-        *duplicate = calloc(1, sizeof(TPM2B_PRIVATE));
+        *duplicate = iesys_output_calloc(esysContext, sizeof(TPM2B_PRIVATE));
         if (*duplicate == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
     }
     if (outSymSeed != NULL) {
-        *outSymSeed = calloc(1, sizeof(TPM2B_ENCRYPTED_SECRET));
+        *outSymSeed = iesys_output_calloc(esysContext, sizeof(TPM2B_ENCRYPTED_SECRET));
         if (*outSymSeed == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -372,11 +375,11 @@ Esys_Duplicate_Finish(ESYS_CONTEXT            *esysContext,
 
 error_cleanup:
     if (encryptionKeyOut != NULL)
-        SAFE_FREE(*encryptionKeyOut);
+        ESYS_OUTPUT_FREE(esysContext, *encryptionKeyOut);
     if (duplicate != NULL)
-        SAFE_FREE(*duplicate);
+        ESYS_OUTPUT_FREE(esysContext, *duplicate);
     if (outSymSeed != NULL)
-        SAFE_FREE(*outSymSeed);
+        ESYS_OUTPUT_FREE(esysContext, *outSymSeed);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -76,8 +76,10 @@ Esys_ECC_Decrypt(ESYS_CONTEXT           *esysContext,
                  TPM2B_MAX_BUFFER      **plainText) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ECC_Decrypt_Async(esysContext, keyHandle, shandle1, shandle2, shandle3, c1, c2, c3,
                                inScheme);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -100,6 +102,7 @@ Esys_ECC_Decrypt(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -257,7 +260,7 @@ Esys_ECC_Decrypt_Finish(ESYS_CONTEXT *esysContext, TPM2B_MAX_BUFFER **plainText)
 
     /* Allocate memory for response parameters */
     if (plainText != NULL) {
-        *plainText = calloc(1, sizeof(TPM2B_MAX_BUFFER));
+        *plainText = iesys_output_calloc(esysContext, sizeof(TPM2B_MAX_BUFFER));
         if (*plainText == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -325,7 +328,7 @@ Esys_ECC_Decrypt_Finish(ESYS_CONTEXT *esysContext, TPM2B_MAX_BUFFER **plainText)
 
 error_cleanup:
     if (plainText != NULL)
-        SAFE_FREE(*plainText);
+        ESYS_OUTPUT_FREE(esysContext, *plainText);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -79,8 +79,10 @@ Esys_ECC_Encrypt(ESYS_CONTEXT           *esysContext,
                  TPM2B_DIGEST          **c3) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ECC_Encrypt_Async(esysContext, keyHandle, shandle1, shandle2, shandle3, plainText,
                                inScheme);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -103,6 +105,7 @@ Esys_ECC_Encrypt(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -259,19 +262,19 @@ Esys_ECC_Encrypt_Finish(ESYS_CONTEXT      *esysContext,
 
     /* Allocate memory for response parameters */
     if (c1 != NULL) {
-        *c1 = calloc(1, sizeof(TPM2B_ECC_POINT));
+        *c1 = iesys_output_calloc(esysContext, sizeof(TPM2B_ECC_POINT));
         if (*c1 == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (c2 != NULL) {
-        *c2 = calloc(1, sizeof(TPM2B_MAX_BUFFER));
+        *c2 = iesys_output_calloc(esysContext, sizeof(TPM2B_MAX_BUFFER));
         if (*c2 == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (c3 != NULL) {
-        *c3 = calloc(1, sizeof(TPM2B_DIGEST));
+        *c3 = iesys_output_calloc(esysContext, sizeof(TPM2B_DIGEST));
         if (*c3 == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -340,11 +343,11 @@ Esys_ECC_Encrypt_Finish(ESYS_CONTEXT      *esysContext,
 
 error_cleanup:
     if (c1 != NULL)
-        SAFE_FREE(*c1);
+        ESYS_OUTPUT_FREE(esysContext, *c1);
     if (c2 != NULL)
-        SAFE_FREE(*c2);
+        ESYS_OUTPUT_FREE(esysContext, *c2);
     if (c3 != NULL)
-        SAFE_FREE(*c3);
+        ESYS_OUTPUT_FREE(esysContext, *c3);
 
     return r;
 }
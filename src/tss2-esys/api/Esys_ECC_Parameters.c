@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, PRIx16, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -70,7 +70,9 @@ Esys_ECC_Parameters(ESYS_CONTEXT               *esysContext,
                     TPMS_ALGORITHM_DETAIL_ECC **parameters) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ECC_Parameters_Async(esysContext, shandle1, shandle2, shandle3, curveID);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -93,6 +95,7 @@ Esys_ECC_Parameters(ESYS_CONTEXT               *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -231,7 +234,7 @@ Esys_ECC_Parameters_Finish(ESYS_CONTEXT *esysContext, TPMS_ALGORITHM_DETAIL_ECC
 
     /* Allocate memory for response parameters */
     if (parameters != NULL) {
-        *parameters = calloc(1, sizeof(TPMS_ALGORITHM_DETAIL_ECC));
+        *parameters = iesys_output_calloc(esysContext, sizeof(TPMS_ALGORITHM_DETAIL_ECC));
         if (*parameters == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -300,7 +303,7 @@ Esys_ECC_Parameters_Finish(ESYS_CONTEXT *esysContext, TPMS_ALGORITHM_DETAIL_ECC
 
 error_cleanup:
     if (parameters != NULL)
-        SAFE_FREE(*parameters);
+        ESYS_OUTPUT_FREE(esysContext, *parameters);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -74,7 +74,9 @@ Esys_ECDH_KeyGen(ESYS_CONTEXT     *esysContext,
                  TPM2B_ECC_POINT **pubPoint) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ECDH_KeyGen_Async(esysContext, keyHandle, shandle1, shandle2, shandle3);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -97,6 +99,7 @@ Esys_ECDH_KeyGen(ESYS_CONTEXT     *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -245,13 +248,13 @@ Esys_ECDH_KeyGen_Finish(ESYS_CONTEXT     *esysContext,
 
     /* Allocate memory for response parameters */
     if (zPoint != NULL) {
-        *zPoint = calloc(1, sizeof(TPM2B_ECC_POINT));
+        *zPoint = iesys_output_calloc(esysContext, sizeof(TPM2B_ECC_POINT));
         if (*zPoint == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (pubPoint != NULL) {
-        *pubPoint = calloc(1, sizeof(TPM2B_ECC_POINT));
+        *pubPoint = iesys_output_calloc(esysContext, sizeof(TPM2B_ECC_POINT));
         if (*pubPoint == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -320,9 +323,9 @@ Esys_ECDH_KeyGen_Finish(ESYS_CONTEXT     *esysContext,
 
 error_cleanup:
     if (zPoint != NULL)
-        SAFE_FREE(*zPoint);
+        ESYS_OUTPUT_FREE(esysContext, *zPoint);
     if (pubPoint != NULL)
-        SAFE_FREE(*pubPoint);
+        ESYS_OUTPUT_FREE(esysContext, *pubPoint);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -71,7 +71,9 @@ Esys_ECDH_ZGen(ESYS_CONTEXT          *esysContext,
                TPM2B_ECC_POINT      **outPoint) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ECDH_ZGen_Async(esysContext, keyHandle, shandle1, shandle2, shandle3, inPoint);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -94,6 +96,7 @@ Esys_ECDH_ZGen(ESYS_CONTEXT          *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -244,7 +247,7 @@ Esys_ECDH_ZGen_Finish(ESYS_CONTEXT *esysContext, TPM2B_ECC_POINT **outPoint) {
 
     /* Allocate memory for response parameters */
     if (outPoint != NULL) {
-        *outPoint = calloc(1, sizeof(TPM2B_ECC_POINT));
+        *outPoint = iesys_output_calloc(esysContext, sizeof(TPM2B_ECC_POINT));
         if (*outPoint == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -312,7 +315,7 @@ Esys_ECDH_ZGen_Finish(ESYS_CONTEXT *esysContext, TPM2B_ECC_POINT **outPoint) {
 
 error_cleanup:
     if (outPoint != NULL)
-        SAFE_FREE(*outPoint);
+        ESYS_OUTPUT_FREE(esysContext, *outPoint);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, PRIx16, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -69,7 +69,9 @@ Esys_EC_Ephemeral(ESYS_CONTEXT     *esysContext,
                   UINT16           *counter) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_EC_Ephemeral_Async(esysContext, shandle1, shandle2, shandle3, curveID);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -92,6 +94,7 @@ Esys_EC_Ephemeral(ESYS_CONTEXT     *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -228,7 +231,7 @@ Esys_EC_Ephemeral_Finish(ESYS_CONTEXT *esysContext, TPM2B_ECC_POINT **Q, UINT16
 
     /* Allocate memory for response parameters */
     if (Q != NULL) {
-        *Q = calloc(1, sizeof(TPM2B_ECC_POINT));
+        *Q = iesys_output_calloc(esysContext, sizeof(TPM2B_ECC_POINT));
         if (*Q == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -296,7 +299,7 @@ Esys_EC_Ephemeral_Finish(ESYS_CONTEXT *esysContext, TPM2B_ECC_POINT **Q, UINT16
 
 error_cleanup:
     if (Q != NULL)
-        SAFE_FREE(*Q);
+        ESYS_OUTPUT_FREE(esysContext, *Q);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, PRIx16, PRIx8, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -83,8 +83,10 @@ Esys_EncryptDecrypt(ESYS_CONTEXT           *esysContext,
                     TPM2B_IV              **ivOut) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_EncryptDecrypt_Async(esysContext, keyHandle, shandle1, shandle2, shandle3, decrypt,
                                   mode, ivIn, inData);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -107,6 +109,7 @@ Esys_EncryptDecrypt(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -272,13 +275,13 @@ Esys_EncryptDecrypt_Finish(ESYS_CONTEXT      *esysContext,
 
     /* Allocate memory for response parameters */
     if (outData != NULL) {
-        *outData = calloc(1, sizeof(TPM2B_MAX_BUFFER));
+        *outData = iesys_output_calloc(esysContext, sizeof(TPM2B_MAX_BUFFER));
         if (*outData == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (ivOut != NULL) {
-        *ivOut = calloc(1, sizeof(TPM2B_IV));
+        *ivOut = iesys_output_calloc(esysContext, sizeof(TPM2B_IV));
         if (*ivOut == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -347,9 +350,9 @@ Esys_EncryptDecrypt_Finish(ESYS_CONTEXT      *esysContext,
 
 error_cleanup:
     if (outData != NULL)
-        SAFE_FREE(*outData);
+        ESYS_OUTPUT_FREE(esysContext, *outData);
     if (ivOut != NULL)
-        SAFE_FREE(*ivOut);
+        ESYS_OUTPUT_FREE(esysContext, *ivOut);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -75,8 +75,10 @@ Esys_EventSequenceComplete(ESYS_CONTEXT           *esysContext,
                            TPML_DIGEST_VALUES    **results) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_EventSequenceComplete_Async(esysContext, pcrHandle, sequenceHandle, shandle1, shandle2,
                                          shandle3, buffer);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -99,6 +101,7 @@ Esys_EventSequenceComplete(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -263,7 +266,7 @@ Esys_EventSequenceComplete_Finish(ESYS_CONTEXT *esysContext, TPML_DIGEST_VALUES
 
     /* Allocate memory for response parameters */
     if (results != NULL) {
-        *results = calloc(1, sizeof(TPML_DIGEST_VALUES));
+        *results = iesys_output_calloc(esysContext, sizeof(TPML_DIGEST_VALUES));
         if (*results == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -332,7 +335,7 @@ Esys_EventSequenceComplete_Finish(ESYS_CONTEXT *esysContext, TPML_DIGEST_VALUES
 
 error_cleanup:
     if (results != NULL)
-        SAFE_FREE(*results);
+        ESYS_OUTPUT_FREE(esysContext, *results);
 
     return r;
 }
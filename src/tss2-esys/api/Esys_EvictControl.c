@@ -87,8 +87,10 @@ Esys_EvictControl(ESYS_CONTEXT      *esysContext,
                   ESYS_TR           *newObjectHandle) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_EvictControl_Async(esysContext, auth, objectHandle, shandle1, shandle2, shandle3,
                                 persistentHandle);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -111,6 +113,7 @@ Esys_EvictControl(ESYS_CONTEXT      *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -360,8 +363,12 @@ Esys_EvictControl_Finish(ESYS_CONTEXT *esysContext, ESYS_TR *newObjectHandle) {
         r = esys_CreateResourceObject(esysContext, *newObjectHandle, &newObjectHandleNode);
         if (r != TSS2_RC_SUCCESS)
             return r;
-        newObjectHandleNode->rsrc = objectHandleNode->rsrc;
-        newObjectHandleNode->rsrc.handle = esysContext->in.EvictControl.persistentHandle;
+        IESYS_RESOURCE rsrc;
+        r = iesys_rsrc_get(objectHandleNode, &rsrc);
+        goto_if_error(r, "Get resource", error_cleanup);
+        rsrc.handle = esysContext->in.EvictControl.persistentHandle;
+        r = iesys_rsrc_set(esysContext, newObjectHandleNode, &rsrc);
+        goto_if_error(r, "Store resource", error_cleanup);
     }
     esysContext->state = ESYS_STATE_INIT;
 
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -70,7 +70,9 @@ Esys_FieldUpgradeData(ESYS_CONTEXT           *esysContext,
                       TPMT_HA               **firstDigest) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_FieldUpgradeData_Async(esysContext, shandle1, shandle2, shandle3, fuData);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -93,6 +95,7 @@ Esys_FieldUpgradeData(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -232,13 +235,13 @@ Esys_FieldUpgradeData_Finish(ESYS_CONTEXT *esysContext,
 
     /* Allocate memory for response parameters */
     if (nextDigest != NULL) {
-        *nextDigest = calloc(1, sizeof(TPMT_HA));
+        *nextDigest = iesys_output_calloc(esysContext, sizeof(TPMT_HA));
         if (*nextDigest == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (firstDigest != NULL) {
-        *firstDigest = calloc(1, sizeof(TPMT_HA));
+        *firstDigest = iesys_output_calloc(esysContext, sizeof(TPMT_HA));
         if (*firstDigest == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -308,9 +311,9 @@ Esys_FieldUpgradeData_Finish(ESYS_CONTEXT *esysContext,
 
 error_cleanup:
     if (nextDigest != NULL)
-        SAFE_FREE(*nextDigest);
+        ESYS_OUTPUT_FREE(esysContext, *nextDigest);
     if (firstDigest != NULL)
-        SAFE_FREE(*firstDigest);
+        ESYS_OUTPUT_FREE(esysContext, *firstDigest);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -68,7 +68,9 @@ Esys_FirmwareRead(ESYS_CONTEXT      *esysContext,
                   TPM2B_MAX_BUFFER **fuData) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_FirmwareRead_Async(esysContext, shandle1, shandle2, shandle3, sequenceNumber);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -91,6 +93,7 @@ Esys_FirmwareRead(ESYS_CONTEXT      *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -227,7 +230,7 @@ Esys_FirmwareRead_Finish(ESYS_CONTEXT *esysContext, TPM2B_MAX_BUFFER **fuData) {
 
     /* Allocate memory for response parameters */
     if (fuData != NULL) {
-        *fuData = calloc(1, sizeof(TPM2B_MAX_BUFFER));
+        *fuData = iesys_output_calloc(esysContext, sizeof(TPM2B_MAX_BUFFER));
         if (*fuData == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -295,7 +298,7 @@ Esys_FirmwareRead_Finish(ESYS_CONTEXT *esysContext, TPM2B_MAX_BUFFER **fuData) {
 
 error_cleanup:
     if (fuData != NULL)
-        SAFE_FREE(*fuData);
+        ESYS_OUTPUT_FREE(esysContext, *fuData);
 
     return r;
 }
@@ -60,7 +60,9 @@ TSS2_RC
 Esys_FlushContext(ESYS_CONTEXT *esysContext, ESYS_TR flushHandle) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_FlushContext_Async(esysContext, flushHandle);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -83,6 +85,7 @@ Esys_FlushContext(ESYS_CONTEXT *esysContext, ESYS_TR flushHandle) {
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -9,10 +9,10 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
-#include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
+#include "esys_iutil.h"      // for iesys_compute_session_value, iesys_cap_...
 #include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, UINT32, TSS2_...
 #include "tss2_esys.h"       // for ESYS_CONTEXT, ESYS_TR, Esys_GetCapability
 #include "tss2_sys.h"        // for Tss2_Sys_ExecuteAsync, TSS2L_SYS_AUTH_C...
@@ -78,8 +78,20 @@ Esys_GetCapability(ESYS_CONTEXT          *esysContext,
                    TPMS_CAPABILITY_DATA **capabilityData) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
+
+    /* Queries answered by the capability cache are not sent to the TPM */
+    if (esysContext != NULL && esysContext->state == ESYS_STATE_INIT
+        && iesys_cap_cache_lookup(esysContext, shandle1, shandle2, shandle3, capability, property,
+                                  propertyCount)) {
+        r = iesys_cap_cache_get(esysContext, moreData, capabilityData);
+        iesys_thread_leave(esysContext);
+        return r;
+    }
+
     r = Esys_GetCapability_Async(esysContext, shandle1, shandle2, shandle3, capability, property,
                                  propertyCount);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -102,6 +114,7 @@ Esys_GetCapability(ESYS_CONTEXT          *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -170,6 +183,13 @@ Esys_GetCapability_Async(ESYS_CONTEXT *esysContext,
     r = check_session_feasibility(shandle1, shandle2, shandle3, 0);
     return_state_if_error(r, ESYS_STATE_INIT, "Check session usage");
 
+    /*
+     * The command is always sent, so the TCTI signals its completion; the
+     * response is merged into the capability cache if it continues it.
+     */
+    iesys_cap_cache_lookup(esysContext, shandle1, shandle2, shandle3, capability, property,
+                           propertyCount);
+
     /* Initial invocation of SAPI to prepare the command buffer with parameters */
     r = Tss2_Sys_GetCapability_Prepare(esysContext->sys, capability, property, propertyCount);
     return_state_if_error(r, ESYS_STATE_INIT, "SAPI Prepare returned error.");
@@ -251,7 +271,7 @@ Esys_GetCapability_Finish(ESYS_CONTEXT          *esysContext,
 
     /* Allocate memory for response parameters */
     if (capabilityData != NULL) {
-        *capabilityData = calloc(1, sizeof(TPMS_CAPABILITY_DATA));
+        *capabilityData = iesys_output_calloc(esysContext, sizeof(TPMS_CAPABILITY_DATA));
         if (*capabilityData == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -313,6 +333,8 @@ Esys_GetCapability_Finish(ESYS_CONTEXT          *esysContext,
                                         (capabilityData != NULL) ? *capabilityData : NULL);
     goto_state_if_error(r, ESYS_STATE_INTERNALERROR, "Received error from SAPI unmarshaling",
                         error_cleanup);
+    if (moreData != NULL && capabilityData != NULL)
+        iesys_cap_cache_store(esysContext, *moreData, *capabilityData);
 
     esysContext->state = ESYS_STATE_INIT;
 
@@ -320,7 +342,7 @@ Esys_GetCapability_Finish(ESYS_CONTEXT          *esysContext,
 
 error_cleanup:
     if (capabilityData != NULL)
-        SAFE_FREE(*capabilityData);
+        ESYS_OUTPUT_FREE(esysContext, *capabilityData);
 
     return r;
 }
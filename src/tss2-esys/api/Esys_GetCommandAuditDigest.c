@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -79,8 +79,10 @@ Esys_GetCommandAuditDigest(ESYS_CONTEXT          *esysContext,
                            TPMT_SIGNATURE       **signature) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_GetCommandAuditDigest_Async(esysContext, privacyHandle, signHandle, shandle1, shandle2,
                                          shandle3, qualifyingData, inScheme);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -103,6 +105,7 @@ Esys_GetCommandAuditDigest(ESYS_CONTEXT          *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -270,13 +273,13 @@ Esys_GetCommandAuditDigest_Finish(ESYS_CONTEXT    *esysContext,
 
     /* Allocate memory for response parameters */
     if (auditInfo != NULL) {
-        *auditInfo = calloc(1, sizeof(TPM2B_ATTEST));
+        *auditInfo = iesys_output_calloc(esysContext, sizeof(TPM2B_ATTEST));
         if (*auditInfo == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (signature != NULL) {
-        *signature = calloc(1, sizeof(TPMT_SIGNATURE));
+        *signature = iesys_output_calloc(esysContext, sizeof(TPMT_SIGNATURE));
         if (*signature == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -346,9 +349,9 @@ Esys_GetCommandAuditDigest_Finish(ESYS_CONTEXT    *esysContext,
 
 error_cleanup:
     if (auditInfo != NULL)
-        SAFE_FREE(*auditInfo);
+        ESYS_OUTPUT_FREE(esysContext, *auditInfo);
     if (signature != NULL)
-        SAFE_FREE(*signature);
+        ESYS_OUTPUT_FREE(esysContext, *signature);
 
     return r;
 }
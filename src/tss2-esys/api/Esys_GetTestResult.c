@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -67,7 +67,9 @@ Esys_GetTestResult(ESYS_CONTEXT      *esysContext,
                    TPM2_RC           *testResult) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_GetTestResult_Async(esysContext, shandle1, shandle2, shandle3);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -90,6 +92,7 @@ Esys_GetTestResult(ESYS_CONTEXT      *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -226,7 +229,7 @@ Esys_GetTestResult_Finish(ESYS_CONTEXT      *esysContext,
 
     /* Allocate memory for response parameters */
     if (outData != NULL) {
-        *outData = calloc(1, sizeof(TPM2B_MAX_BUFFER));
+        *outData = iesys_output_calloc(esysContext, sizeof(TPM2B_MAX_BUFFER));
         if (*outData == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -295,7 +298,7 @@ Esys_GetTestResult_Finish(ESYS_CONTEXT      *esysContext,
 
 error_cleanup:
     if (outData != NULL)
-        SAFE_FREE(*outData);
+        ESYS_OUTPUT_FREE(esysContext, *outData);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -80,8 +80,10 @@ Esys_GetTime(ESYS_CONTEXT          *esysContext,
              TPMT_SIGNATURE       **signature) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_GetTime_Async(esysContext, privacyAdminHandle, signHandle, shandle1, shandle2,
                            shandle3, qualifyingData, inScheme);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -104,6 +106,7 @@ Esys_GetTime(ESYS_CONTEXT          *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -272,13 +275,13 @@ Esys_GetTime_Finish(ESYS_CONTEXT    *esysContext,
 
     /* Allocate memory for response parameters */
     if (timeInfo != NULL) {
-        *timeInfo = calloc(1, sizeof(TPM2B_ATTEST));
+        *timeInfo = iesys_output_calloc(esysContext, sizeof(TPM2B_ATTEST));
         if (*timeInfo == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (signature != NULL) {
-        *signature = calloc(1, sizeof(TPMT_SIGNATURE));
+        *signature = iesys_output_calloc(esysContext, sizeof(TPMT_SIGNATURE));
         if (*signature == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -347,9 +350,9 @@ Esys_GetTime_Finish(ESYS_CONTEXT    *esysContext,
 
 error_cleanup:
     if (timeInfo != NULL)
-        SAFE_FREE(*timeInfo);
+        ESYS_OUTPUT_FREE(esysContext, *timeInfo);
     if (signature != NULL)
-        SAFE_FREE(*signature);
+        ESYS_OUTPUT_FREE(esysContext, *signature);
 
     return r;
 }
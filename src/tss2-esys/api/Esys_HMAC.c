@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, PRIx16, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -73,7 +73,9 @@ Esys_HMAC(ESYS_CONTEXT           *esysContext,
           TPM2B_DIGEST          **outHMAC) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_HMAC_Async(esysContext, handle, shandle1, shandle2, shandle3, buffer, hashAlg);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -96,6 +98,7 @@ Esys_HMAC(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -250,7 +253,7 @@ Esys_HMAC_Finish(ESYS_CONTEXT *esysContext, TPM2B_DIGEST **outHMAC) {
 
     /* Allocate memory for response parameters */
     if (outHMAC != NULL) {
-        *outHMAC = calloc(1, sizeof(TPM2B_DIGEST));
+        *outHMAC = iesys_output_calloc(esysContext, sizeof(TPM2B_DIGEST));
         if (*outHMAC == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -318,7 +321,7 @@ Esys_HMAC_Finish(ESYS_CONTEXT *esysContext, TPM2B_DIGEST **outHMAC) {
 
 error_cleanup:
     if (outHMAC != NULL)
-        SAFE_FREE(*outHMAC);
+        ESYS_OUTPUT_FREE(esysContext, *outHMAC);
 
     return r;
 }
@@ -84,7 +84,9 @@ Esys_HMAC_Start(ESYS_CONTEXT     *esysContext,
                 ESYS_TR          *sequenceHandle) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_HMAC_Start_Async(esysContext, handle, shandle1, shandle2, shandle3, auth, hashAlg);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -107,6 +109,7 @@ Esys_HMAC_Start(ESYS_CONTEXT     *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -207,6 +210,10 @@ Esys_HMAC_Start_Async(ESYS_CONTEXT     *esysContext,
         return_state_if_error(r, ESYS_STATE_INIT, "SAPI error on SetCmdAuths");
     }
 
+    /* Make room in the TPM for the new object */
+    r = iesys_rm_reserve(esysContext, TPM2_HT_TRANSIENT);
+    return_state_if_error(r, ESYS_STATE_INIT, "Resource manager");
+
     /* Trigger execution and finish the async invocation */
     r = Tss2_Sys_ExecuteAsync(esysContext->sys);
     return_state_if_error(r, ESYS_STATE_INTERNALERROR, "Finish (Execute Async)");
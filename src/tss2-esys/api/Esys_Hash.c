@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, PRIx16, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -73,7 +73,9 @@ Esys_Hash(ESYS_CONTEXT           *esysContext,
           TPMT_TK_HASHCHECK     **validation) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Hash_Async(esysContext, shandle1, shandle2, shandle3, data, hashAlg, hierarchy);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -96,6 +98,7 @@ Esys_Hash(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -250,13 +253,13 @@ Esys_Hash_Finish(ESYS_CONTEXT       *esysContext,
 
     /* Allocate memory for response parameters */
     if (outHash != NULL) {
-        *outHash = calloc(1, sizeof(TPM2B_DIGEST));
+        *outHash = iesys_output_calloc(esysContext, sizeof(TPM2B_DIGEST));
         if (*outHash == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (validation != NULL) {
-        *validation = calloc(1, sizeof(TPMT_TK_HASHCHECK));
+        *validation = iesys_output_calloc(esysContext, sizeof(TPMT_TK_HASHCHECK));
         if (*validation == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -325,9 +328,9 @@ Esys_Hash_Finish(ESYS_CONTEXT       *esysContext,
 
 error_cleanup:
     if (outHash != NULL)
-        SAFE_FREE(*outHash);
+        ESYS_OUTPUT_FREE(esysContext, *outHash);
     if (validation != NULL)
-        SAFE_FREE(*validation);
+        ESYS_OUTPUT_FREE(esysContext, *validation);
 
     return r;
 }
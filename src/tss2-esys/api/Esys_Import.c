@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -82,8 +82,10 @@ Esys_Import(ESYS_CONTEXT                 *esysContext,
             TPM2B_PRIVATE               **outPrivate) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Import_Async(esysContext, parentHandle, shandle1, shandle2, shandle3, encryptionKey,
                           objectPublic, duplicate, inSymSeed, symmetricAlg);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -106,6 +108,7 @@ Esys_Import(ESYS_CONTEXT                 *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -271,7 +274,7 @@ Esys_Import_Finish(ESYS_CONTEXT *esysContext, TPM2B_PRIVATE **outPrivate) {
 
     /* Allocate memory for response parameters */
     if (outPrivate != NULL) {
-        *outPrivate = calloc(1, sizeof(TPM2B_PRIVATE));
+        *outPrivate = iesys_output_calloc(esysContext, sizeof(TPM2B_PRIVATE));
         if (*outPrivate == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -339,7 +342,7 @@ Esys_Import_Finish(ESYS_CONTEXT *esysContext, TPM2B_PRIVATE **outPrivate) {
 
 error_cleanup:
     if (outPrivate != NULL)
-        SAFE_FREE(*outPrivate);
+        ESYS_OUTPUT_FREE(esysContext, *outPrivate);
 
     return r;
 }
@@ -83,8 +83,10 @@ Esys_Load(ESYS_CONTEXT        *esysContext,
           ESYS_TR             *objectHandle) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Load_Async(esysContext, parentHandle, shandle1, shandle2, shandle3, inPrivate,
                         inPublic);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -107,6 +109,7 @@ Esys_Load(ESYS_CONTEXT        *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -205,6 +208,10 @@ Esys_Load_Async(ESYS_CONTEXT        *esysContext,
         return_state_if_error(r, ESYS_STATE_INIT, "SAPI error on SetCmdAuths");
     }
 
+    /* Make room in the TPM for the new object */
+    r = iesys_rm_reserve(esysContext, TPM2_HT_TRANSIENT);
+    return_state_if_error(r, ESYS_STATE_INIT, "Resource manager");
+
     /* Trigger execution and finish the async invocation */
     r = Tss2_Sys_ExecuteAsync(esysContext->sys);
     return_state_if_error(r, ESYS_STATE_INTERNALERROR, "Finish (Execute Async)");
@@ -273,10 +280,9 @@ Esys_Load_Finish(ESYS_CONTEXT *esysContext, ESYS_TR *objectHandle) {
 
     if (esysContext->in.Load.inPublic) {
         /* Update the meta data of the ESYS_TR object */
-        objectHandleNode->rsrc.rsrcType = IESYSC_KEY_RSRC;
-        objectHandleNode->rsrc.misc.rsrc_key_pub = *esysContext->in.Load.inPublic;
-    } else {
-        objectHandleNode->rsrc.misc.rsrc_key_pub.size = 0;
+        r = iesys_rsrc_set_key_public(esysContext, objectHandleNode,
+                                      esysContext->in.Load.inPublic);
+        goto_if_error(r, "Store public area", error_cleanup);
     }
 
     /*Receive the TPM response and handle resubmissions if necessary. */
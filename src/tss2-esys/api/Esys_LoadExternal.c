@@ -79,8 +79,10 @@ Esys_LoadExternal(ESYS_CONTEXT          *esysContext,
                   ESYS_TR               *objectHandle) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_LoadExternal_Async(esysContext, shandle1, shandle2, shandle3, inPrivate, inPublic,
                                 hierarchy);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -103,6 +105,7 @@ Esys_LoadExternal(ESYS_CONTEXT          *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -195,6 +198,10 @@ Esys_LoadExternal_Async(ESYS_CONTEXT          *esysContext,
         return_state_if_error(r, ESYS_STATE_INIT, "SAPI error on SetCmdAuths");
     }
 
+    /* Make room in the TPM for the new object */
+    r = iesys_rm_reserve(esysContext, TPM2_HT_TRANSIENT);
+    return_state_if_error(r, ESYS_STATE_INIT, "Resource manager");
+
     /* Trigger execution and finish the async invocation */
     r = Tss2_Sys_ExecuteAsync(esysContext->sys);
     return_state_if_error(r, ESYS_STATE_INTERNALERROR, "Finish (Execute Async)");
@@ -262,10 +269,9 @@ Esys_LoadExternal_Finish(ESYS_CONTEXT *esysContext, ESYS_TR *objectHandle) {
         return r;
 
     if (esysContext->in.LoadExternal.inPublic) {
-        objectHandleNode->rsrc.rsrcType = IESYSC_KEY_RSRC;
-        objectHandleNode->rsrc.misc.rsrc_key_pub = *esysContext->in.LoadExternal.inPublic;
-    } else {
-        objectHandleNode->rsrc.misc.rsrc_key_pub.size = 0;
+        r = iesys_rsrc_set_key_public(esysContext, objectHandleNode,
+                                      esysContext->in.LoadExternal.inPublic);
+        goto_if_error(r, "Store public area", error_cleanup);
     }
 
     /*Receive the TPM response and handle resubmissions if necessary. */
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, PRIx16, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -74,8 +74,10 @@ Esys_MAC(ESYS_CONTEXT           *esysContext,
          TPM2B_DIGEST          **outMAC) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_MAC_Async(esysContext, handle, handleSession1, optionalSession2, optionalSession3,
                        buffer, inScheme);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -98,6 +100,7 @@ Esys_MAC(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -252,7 +255,7 @@ Esys_MAC_Finish(ESYS_CONTEXT *esysContext, TPM2B_DIGEST **outMAC) {
 
     /* Allocate memory for response parameters */
     if (outMAC != NULL) {
-        *outMAC = calloc(1, sizeof(TPM2B_DIGEST));
+        *outMAC = iesys_output_calloc(esysContext, sizeof(TPM2B_DIGEST));
         if (*outMAC == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -320,7 +323,7 @@ Esys_MAC_Finish(ESYS_CONTEXT *esysContext, TPM2B_DIGEST **outMAC) {
 
 error_cleanup:
     if (outMAC != NULL)
-        SAFE_FREE(*outMAC);
+        ESYS_OUTPUT_FREE(esysContext, *outMAC);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -77,8 +77,10 @@ Esys_MakeCredential(ESYS_CONTEXT            *esysContext,
                     TPM2B_ENCRYPTED_SECRET **secret) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_MakeCredential_Async(esysContext, handle, shandle1, shandle2, shandle3, credential,
                                   objectName);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -101,6 +103,7 @@ Esys_MakeCredential(ESYS_CONTEXT            *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -255,13 +258,13 @@ Esys_MakeCredential_Finish(ESYS_CONTEXT            *esysContext,
 
     /* Allocate memory for response parameters */
     if (credentialBlob != NULL) {
-        *credentialBlob = calloc(1, sizeof(TPM2B_ID_OBJECT));
+        *credentialBlob = iesys_output_calloc(esysContext, sizeof(TPM2B_ID_OBJECT));
         if (*credentialBlob == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (secret != NULL) {
-        *secret = calloc(1, sizeof(TPM2B_ENCRYPTED_SECRET));
+        *secret = iesys_output_calloc(esysContext, sizeof(TPM2B_ENCRYPTED_SECRET));
         if (*secret == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -331,9 +334,9 @@ Esys_MakeCredential_Finish(ESYS_CONTEXT            *esysContext,
 
 error_cleanup:
     if (credentialBlob != NULL)
-        SAFE_FREE(*credentialBlob);
+        ESYS_OUTPUT_FREE(esysContext, *credentialBlob);
     if (secret != NULL)
-        SAFE_FREE(*secret);
+        ESYS_OUTPUT_FREE(esysContext, *secret);
 
     return r;
 }
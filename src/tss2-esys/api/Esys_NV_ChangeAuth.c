@@ -80,7 +80,9 @@ Esys_NV_ChangeAuth(ESYS_CONTEXT     *esysContext,
                    const TPM2B_AUTH *newAuth) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_NV_ChangeAuth_Async(esysContext, nvIndex, shandle1, shandle2, shandle3, newAuth);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -103,6 +105,7 @@ Esys_NV_ChangeAuth(ESYS_CONTEXT     *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -152,7 +155,7 @@ Esys_NV_ChangeAuth_Async(ESYS_CONTEXT     *esysContext,
     TSS2L_SYS_AUTH_COMMAND auths;
     RSRC_NODE_T           *nvIndexNode;
     TPM2B_AUTH            *authCopy;
-    TPMI_ALG_HASH          hashAlg;
+    TPMI_ALG_HASH          hashAlg = 0;
 
     /* Check context, sequence correctness and set state to error for now */
     if (esysContext == NULL) {
@@ -180,7 +183,8 @@ Esys_NV_ChangeAuth_Async(ESYS_CONTEXT     *esysContext,
         return TSS2_FAPI_RC_BAD_VALUE;
     }
 
-    hashAlg = nvIndexNode->rsrc.misc.rsrc_nv_pub.nvPublic.nameAlg;
+    if (nvIndexNode->rsrc.rsrcType == IESYSC_NV_RSRC)
+        hashAlg = nvIndexNode->rsrc.misc.rsrc_nv_pub.entry->nvPublic.nameAlg;
     r = iesys_adapt_auth_value(&esysContext->crypto_backend, authCopy, hashAlg);
     return_state_if_error(r, ESYS_STATE_INIT, "Adapt auth value");
 
@@ -92,8 +92,10 @@ Esys_NV_DefineSpace(ESYS_CONTEXT          *esysContext,
                     ESYS_TR               *nvHandle) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_NV_DefineSpace_Async(esysContext, authHandle, shandle1, shandle2, shandle3, auth,
                                   publicInfo);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -116,6 +118,7 @@ Esys_NV_DefineSpace(ESYS_CONTEXT          *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -354,7 +357,6 @@ Esys_NV_DefineSpace_Finish(ESYS_CONTEXT *esysContext, ESYS_TR *nvHandle) {
                         error_cleanup);
 
     /* Update the meta data of the ESYS_TR object */
-    nvHandleNode->rsrc.rsrcType = IESYSC_NV_RSRC;
     r = iesys_nv_get_name(&esysContext->crypto_backend, esysContext->in.NV.publicInfo,
                           &nvHandleNode->rsrc.name);
     if (r != TSS2_RC_SUCCESS) {
@@ -363,7 +365,8 @@ Esys_NV_DefineSpace_Finish(ESYS_CONTEXT *esysContext, ESYS_TR *nvHandle) {
         goto error_cleanup;
     }
     nvHandleNode->rsrc.handle = esysContext->in.NV.publicInfo->nvPublic.nvIndex;
-    nvHandleNode->rsrc.misc.rsrc_nv_pub = *esysContext->in.NV.publicInfo;
+    r = iesys_rsrc_set_nv_public(esysContext, nvHandleNode, esysContext->in.NV.publicInfo);
+    goto_state_if_error(r, ESYS_STATE_INTERNALERROR, "Store NV public area", error_cleanup);
     nvHandleNode->auth = esysContext->in.NV.authData;
 
     esysContext->state = ESYS_STATE_INIT;
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, PRIx16, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -78,8 +78,10 @@ Esys_NV_Read(ESYS_CONTEXT         *esysContext,
              TPM2B_MAX_NV_BUFFER **data) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_NV_Read_Async(esysContext, authHandle, nvIndex, shandle1, shandle2, shandle3, size,
                            offset);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -102,6 +104,7 @@ Esys_NV_Read(ESYS_CONTEXT         *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -264,7 +267,7 @@ Esys_NV_Read_Finish(ESYS_CONTEXT *esysContext, TPM2B_MAX_NV_BUFFER **data) {
 
     /* Allocate memory for response parameters */
     if (data != NULL) {
-        *data = calloc(1, sizeof(TPM2B_MAX_NV_BUFFER));
+        *data = iesys_output_calloc(esysContext, sizeof(TPM2B_MAX_NV_BUFFER));
         if (*data == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -332,7 +335,55 @@ Esys_NV_Read_Finish(ESYS_CONTEXT *esysContext, TPM2B_MAX_NV_BUFFER **data) {
 
 error_cleanup:
     if (data != NULL)
-        SAFE_FREE(*data);
+        ESYS_OUTPUT_FREE(esysContext, *data);
 
     return r;
 }
+
+/** Asynchronous finish function for TPM2_NV_Read without copying the output
+ *
+ * Like Esys_NV_Read_Finish but instead of allocating the output it returns a
+ * pointer to the (decrypted) data inside the response buffer of the context.
+ * The pointer is only valid until the next command is issued on esysContext.
+ *
+ * @param[in,out] esysContext The ESYS_CONTEXT.
+ * @param[out] data Pointer to the data read.
+ * @param[out] dataSize The number of bytes read.
+ * @retval TSS2_RC_SUCCESS on success
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if the esysContext or required output
+ *         pointers are NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE: if the context has no asynchronous
+ *         operation pending.
+ * @retval TSS2_ESYS_RC_TRY_AGAIN: if the timeout counter expires before the
+ *         TPM response is received.
+ * @retval TSS2_ESYS_RC_RSP_AUTH_FAILED: if the response HMAC from the TPM did
+ *         not verify.
+ * @retval TSS2_ESYS_RC_MALFORMED_RESPONSE: if the TPM's response is corrupted.
+ * @retval TSS2_RCs produced by lower layers of the software stack may be
+ *         returned to the caller unaltered unless handled internally.
+ */
+TSS2_RC
+Esys_NV_Read_FinishView(ESYS_CONTEXT *esysContext, const uint8_t **data, UINT16 *dataSize) {
+    TSS2_RC r;
+    LOG_TRACE("context=%p, data=%p, dataSize=%p", esysContext, data, dataSize);
+
+    if (esysContext == NULL) {
+        LOG_ERROR("esyscontext is NULL.");
+        return TSS2_ESYS_RC_BAD_REFERENCE;
+    }
+    if (data == NULL || dataSize == NULL) {
+        LOG_ERROR("Output reference is NULL.");
+        return TSS2_ESYS_RC_BAD_REFERENCE;
+    }
+
+    r = iesys_finish_response(esysContext);
+    if (r != TSS2_RC_SUCCESS)
+        return r;
+
+    r = Tss2_Sys_NV_Read_CompleteView(esysContext->sys, data, dataSize);
+    return_state_if_error(r, ESYS_STATE_INTERNALERROR, "Received error from SAPI unmarshaling");
+
+    esysContext->state = ESYS_STATE_INIT;
+
+    return TSS2_RC_SUCCESS;
+}
@@ -80,7 +80,9 @@ Esys_NV_ReadLock(ESYS_CONTEXT *esysContext,
                  ESYS_TR       shandle3) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_NV_ReadLock_Async(esysContext, authHandle, nvIndex, shandle1, shandle2, shandle3);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -103,6 +105,7 @@ Esys_NV_ReadLock(ESYS_CONTEXT *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -322,9 +325,7 @@ Esys_NV_ReadLock_Finish(ESYS_CONTEXT *esysContext) {
 
     /* Update name in meta data because of possibly changed attributes */
     if (nvIndexNode != NULL) {
-        nvIndexNode->rsrc.misc.rsrc_nv_pub.nvPublic.attributes |= TPMA_NV_READLOCKED;
-        r = iesys_nv_get_name(&esysContext->crypto_backend, &nvIndexNode->rsrc.misc.rsrc_nv_pub,
-                              &nvIndexNode->rsrc.name);
+        r = iesys_rsrc_nv_add_attributes(esysContext, nvIndexNode, TPMA_NV_READLOCKED);
         return_if_error(r, "Error get nvname")
     }
     esysContext->state = ESYS_STATE_INIT;
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -80,7 +80,9 @@ Esys_NV_ReadPublic(ESYS_CONTEXT     *esysContext,
                    TPM2B_NAME      **nvName) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_NV_ReadPublic_Async(esysContext, nvIndex, shandle1, shandle2, shandle3);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -103,6 +105,7 @@ Esys_NV_ReadPublic(ESYS_CONTEXT     *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -253,11 +256,11 @@ Esys_NV_ReadPublic_Finish(ESYS_CONTEXT     *esysContext,
     esysContext->state = ESYS_STATE_INTERNALERROR;
 
     /* Allocate memory for response parameters */
-    lnvPublic = calloc(1, sizeof(TPM2B_NV_PUBLIC));
+    lnvPublic = iesys_output_calloc(esysContext, sizeof(TPM2B_NV_PUBLIC));
     if (lnvPublic == NULL) {
         return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
     }
-    lnvName = calloc(1, sizeof(TPM2B_NAME));
+    lnvName = iesys_output_calloc(esysContext, sizeof(TPM2B_NAME));
     if (lnvName == NULL) {
         goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
     }
@@ -325,27 +328,27 @@ Esys_NV_ReadPublic_Finish(ESYS_CONTEXT     *esysContext,
     goto_if_error(r, "get resource", error_cleanup);
 
     if (nvIndexNode != NULL) {
-        nvIndexNode->rsrc.rsrcType = IESYSC_NV_RSRC;
+        r = iesys_rsrc_set_nv_public(esysContext, nvIndexNode, lnvPublic);
+        goto_if_error(r, "Store NV public area", error_cleanup);
         nvIndexNode->rsrc.name = *lnvName;
-        nvIndexNode->rsrc.misc.rsrc_nv_pub = *lnvPublic;
     }
     if (nvPublic != NULL)
         *nvPublic = lnvPublic;
     else
-        SAFE_FREE(lnvPublic);
+        ESYS_OUTPUT_FREE(esysContext, lnvPublic);
 
     if (nvName != NULL)
         *nvName = lnvName;
     else
-        SAFE_FREE(lnvName);
+        ESYS_OUTPUT_FREE(esysContext, lnvName);
 
     esysContext->state = ESYS_STATE_INIT;
 
     return TSS2_RC_SUCCESS;
 
 error_cleanup:
-    SAFE_FREE(lnvPublic);
-    SAFE_FREE(lnvName);
+    ESYS_OUTPUT_FREE(esysContext, lnvPublic);
+    ESYS_OUTPUT_FREE(esysContext, lnvName);
 
     return r;
 }
@@ -79,8 +79,10 @@ Esys_NV_UndefineSpaceSpecial(ESYS_CONTEXT *esysContext,
                              ESYS_TR       shandle3) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_NV_UndefineSpaceSpecial_Async(esysContext, nvIndex, platform, shandle1, shandle2,
                                            shandle3);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -103,6 +105,7 @@ Esys_NV_UndefineSpaceSpecial(ESYS_CONTEXT *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -319,7 +322,8 @@ Esys_NV_UndefineSpaceSpecial_Finish(ESYS_CONTEXT *esysContext) {
     r = esys_GetResourceObject(esysContext, esysContext->session_type[0], &session);
     return_if_error(r, "get resource");
 
-    session->rsrc.misc.rsrc_session.sizeHmacValue -= nvIndexNode->auth.size;
+    if (session != NULL && session->rsrc.rsrcType == IESYSC_SESSION_RSRC)
+        session->rsrc.misc.rsrc_session->sizeHmacValue -= nvIndexNode->auth.size;
 
     /* The ESYS_TR object (nvIndex) has to be invalidated */
     r = Esys_TR_Close(esysContext, &esysContext->in.NV.nvIndex);
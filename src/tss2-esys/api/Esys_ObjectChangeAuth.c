@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -72,8 +72,10 @@ Esys_ObjectChangeAuth(ESYS_CONTEXT     *esysContext,
                       TPM2B_PRIVATE   **outPrivate) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ObjectChangeAuth_Async(esysContext, objectHandle, parentHandle, shandle1, shandle2,
                                     shandle3, newAuth);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -96,6 +98,7 @@ Esys_ObjectChangeAuth(ESYS_CONTEXT     *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -177,7 +180,10 @@ Esys_ObjectChangeAuth_Async(ESYS_CONTEXT     *esysContext,
     return_state_if_error(r, ESYS_STATE_INIT, "parentHandle unknown.");
 
     if (objectHandleNode->rsrc.rsrcType == IESYSC_KEY_RSRC) {
-        hashAlg = objectHandleNode->rsrc.misc.rsrc_key_pub.publicArea.nameAlg;
+        TPM2B_PUBLIC public;
+        r = iesys_rsrc_key_public(objectHandleNode, &public);
+        return_state_if_error(r, ESYS_STATE_INIT, "Get public area");
+        hashAlg = public.publicArea.nameAlg;
     }
 
     if (newAuth) {
@@ -269,7 +275,7 @@ Esys_ObjectChangeAuth_Finish(ESYS_CONTEXT *esysContext, TPM2B_PRIVATE **outPriva
 
     /* Allocate memory for response parameters */
     if (outPrivate != NULL) {
-        *outPrivate = calloc(1, sizeof(TPM2B_PRIVATE));
+        *outPrivate = iesys_output_calloc(esysContext, sizeof(TPM2B_PRIVATE));
         if (*outPrivate == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -338,7 +344,7 @@ Esys_ObjectChangeAuth_Finish(ESYS_CONTEXT *esysContext, TPM2B_PRIVATE **outPriva
 
 error_cleanup:
     if (outPrivate != NULL)
-        SAFE_FREE(*outPrivate);
+        ESYS_OUTPUT_FREE(esysContext, *outPrivate);
 
     return r;
 }
@@ -82,8 +82,10 @@ Esys_PCR_Allocate(ESYS_CONTEXT             *esysContext,
                   UINT32                   *sizeAvailable) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PCR_Allocate_Async(esysContext, authHandle, shandle1, shandle2, shandle3,
                                 pcrAllocation);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -107,6 +109,7 @@ Esys_PCR_Allocate(ESYS_CONTEXT             *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -73,7 +73,9 @@ Esys_PCR_Event(ESYS_CONTEXT        *esysContext,
                TPML_DIGEST_VALUES **digests) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PCR_Event_Async(esysContext, pcrHandle, shandle1, shandle2, shandle3, eventData);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -96,6 +98,7 @@ Esys_PCR_Event(ESYS_CONTEXT        *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -248,7 +251,7 @@ Esys_PCR_Event_Finish(ESYS_CONTEXT *esysContext, TPML_DIGEST_VALUES **digests) {
 
     /* Allocate memory for response parameters */
     if (digests != NULL) {
-        *digests = calloc(1, sizeof(TPML_DIGEST_VALUES));
+        *digests = iesys_output_calloc(esysContext, sizeof(TPML_DIGEST_VALUES));
         if (*digests == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -316,7 +319,7 @@ Esys_PCR_Event_Finish(ESYS_CONTEXT *esysContext, TPML_DIGEST_VALUES **digests) {
 
 error_cleanup:
     if (digests != NULL)
-        SAFE_FREE(*digests);
+        ESYS_OUTPUT_FREE(esysContext, *digests);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -76,7 +76,9 @@ Esys_PCR_Read(ESYS_CONTEXT             *esysContext,
               TPML_DIGEST             **pcrValues) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PCR_Read_Async(esysContext, shandle1, shandle2, shandle3, pcrSelectionIn);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -99,6 +101,7 @@ Esys_PCR_Read(ESYS_CONTEXT             *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -246,13 +249,13 @@ Esys_PCR_Read_Finish(ESYS_CONTEXT        *esysContext,
 
     /* Allocate memory for response parameters */
     if (pcrSelectionOut != NULL) {
-        *pcrSelectionOut = calloc(1, sizeof(TPML_PCR_SELECTION));
+        *pcrSelectionOut = iesys_output_calloc(esysContext, sizeof(TPML_PCR_SELECTION));
         if (*pcrSelectionOut == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (pcrValues != NULL) {
-        *pcrValues = calloc(1, sizeof(TPML_DIGEST));
+        *pcrValues = iesys_output_calloc(esysContext, sizeof(TPML_DIGEST));
         if (*pcrValues == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -322,9 +325,9 @@ Esys_PCR_Read_Finish(ESYS_CONTEXT        *esysContext,
 
 error_cleanup:
     if (pcrSelectionOut != NULL)
-        SAFE_FREE(*pcrSelectionOut);
+        ESYS_OUTPUT_FREE(esysContext, *pcrSelectionOut);
     if (pcrValues != NULL)
-        SAFE_FREE(*pcrValues);
+        ESYS_OUTPUT_FREE(esysContext, *pcrValues);
 
     return r;
 }
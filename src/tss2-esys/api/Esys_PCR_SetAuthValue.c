@@ -82,7 +82,9 @@ Esys_PCR_SetAuthValue(ESYS_CONTEXT       *esysContext,
                       const TPM2B_DIGEST *auth) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PCR_SetAuthValue_Async(esysContext, pcrHandle, shandle1, shandle2, shandle3, auth);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -105,6 +107,7 @@ Esys_PCR_SetAuthValue(ESYS_CONTEXT       *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
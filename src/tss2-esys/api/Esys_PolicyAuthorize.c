@@ -80,8 +80,10 @@ Esys_PolicyAuthorize(ESYS_CONTEXT           *esysContext,
                      const TPMT_TK_VERIFIED *checkTicket) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PolicyAuthorize_Async(esysContext, policySession, shandle1, shandle2, shandle3,
                                    approvedPolicy, policyRef, keySign, checkTicket);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -104,6 +106,7 @@ Esys_PolicyAuthorize(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
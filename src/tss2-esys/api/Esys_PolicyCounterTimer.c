@@ -75,8 +75,10 @@ Esys_PolicyCounterTimer(ESYS_CONTEXT        *esysContext,
                         TPM2_EO              operation) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PolicyCounterTimer_Async(esysContext, policySession, shandle1, shandle2, shandle3,
                                       operandB, offset, operation);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -99,6 +101,7 @@ Esys_PolicyCounterTimer(ESYS_CONTEXT        *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
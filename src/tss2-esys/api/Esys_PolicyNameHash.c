@@ -73,8 +73,10 @@ Esys_PolicyNameHash(ESYS_CONTEXT       *esysContext,
                     const TPM2B_DIGEST *nameHash) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PolicyNameHash_Async(esysContext, policySession, shandle1, shandle2, shandle3,
                                   nameHash);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -97,6 +99,7 @@ Esys_PolicyNameHash(ESYS_CONTEXT       *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -73,7 +73,9 @@ Esys_PolicyOR(ESYS_CONTEXT      *esysContext,
               const TPML_DIGEST *pHashList) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PolicyOR_Async(esysContext, policySession, shandle1, shandle2, shandle3, pHashList);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -96,6 +98,7 @@ Esys_PolicyOR(ESYS_CONTEXT      *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -77,7 +77,9 @@ Esys_PolicyPassword(ESYS_CONTEXT *esysContext,
                     ESYS_TR       shandle3) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PolicyPassword_Async(esysContext, policySession, shandle1, shandle2, shandle3);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -100,6 +102,7 @@ Esys_PolicyPassword(ESYS_CONTEXT *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -305,9 +308,9 @@ Esys_PolicyPassword_Finish(ESYS_CONTEXT *esysContext) {
     r = esys_GetResourceObject(esysContext, policySession, &policySessionNode);
     return_if_error(r, "get resource");
 
-    if (policySessionNode != NULL)
+    if (policySessionNode != NULL && policySessionNode->rsrc.rsrcType == IESYSC_SESSION_RSRC)
         /* Indicate that the authValue of authorized object will be checked */
-        policySessionNode->rsrc.misc.rsrc_session.type_policy_session = POLICY_PASSWORD;
+        policySessionNode->rsrc.misc.rsrc_session->type_policy_session = POLICY_PASSWORD;
     esysContext->state = ESYS_STATE_INIT;
 
     return TSS2_RC_SUCCESS;
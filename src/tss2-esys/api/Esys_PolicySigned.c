@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, PRIi32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -89,8 +89,10 @@ Esys_PolicySigned(ESYS_CONTEXT         *esysContext,
                   TPMT_TK_AUTH        **policyTicket) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PolicySigned_Async(esysContext, authObject, policySession, shandle1, shandle2,
                                 shandle3, nonceTPM, cpHashA, policyRef, expiration, auth);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -113,6 +115,7 @@ Esys_PolicySigned(ESYS_CONTEXT         *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -285,13 +288,13 @@ Esys_PolicySigned_Finish(ESYS_CONTEXT   *esysContext,
 
     /* Allocate memory for response parameters */
     if (timeout != NULL) {
-        *timeout = calloc(1, sizeof(TPM2B_TIMEOUT));
+        *timeout = iesys_output_calloc(esysContext, sizeof(TPM2B_TIMEOUT));
         if (*timeout == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (policyTicket != NULL) {
-        *policyTicket = calloc(1, sizeof(TPMT_TK_AUTH));
+        *policyTicket = iesys_output_calloc(esysContext, sizeof(TPMT_TK_AUTH));
         if (*policyTicket == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -360,9 +363,9 @@ Esys_PolicySigned_Finish(ESYS_CONTEXT   *esysContext,
 
 error_cleanup:
     if (timeout != NULL)
-        SAFE_FREE(*timeout);
+        ESYS_OUTPUT_FREE(esysContext, *timeout);
     if (policyTicket != NULL)
-        SAFE_FREE(*policyTicket);
+        ESYS_OUTPUT_FREE(esysContext, *policyTicket);
 
     return r;
 }
@@ -81,8 +81,10 @@ Esys_PolicyTicket(ESYS_CONTEXT        *esysContext,
                   const TPMT_TK_AUTH  *ticket) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_PolicyTicket_Async(esysContext, policySession, shandle1, shandle2, shandle3, timeout,
                                 cpHashA, policyRef, authName, ticket);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -105,6 +107,7 @@ Esys_PolicyTicket(ESYS_CONTEXT        *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
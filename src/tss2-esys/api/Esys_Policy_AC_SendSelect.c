@@ -69,9 +69,11 @@ Esys_Policy_AC_SendSelect(ESYS_CONTEXT *esysContext,
                           TPM2B_NAME   *acName,
                           TPMI_YES_NO   includeObject) {
     TSS2_RC r;
+    iesys_thread_enter(esysContext);
     r = Esys_Policy_AC_SendSelect_Async(esysContext, policySession1, optionalSession2,
                                         optionalSession3, objectName, authHandleName, acName,
                                         includeObject);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -95,6 +97,7 @@ Esys_Policy_AC_SendSelect(ESYS_CONTEXT *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return r;
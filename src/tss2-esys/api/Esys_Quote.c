@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -78,8 +78,10 @@ Esys_Quote(ESYS_CONTEXT             *esysContext,
            TPMT_SIGNATURE          **signature) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Quote_Async(esysContext, signHandle, shandle1, shandle2, shandle3, qualifyingData,
                          inScheme, PCRselect);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -102,6 +104,7 @@ Esys_Quote(ESYS_CONTEXT             *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -260,13 +263,13 @@ Esys_Quote_Finish(ESYS_CONTEXT *esysContext, TPM2B_ATTEST **quoted, TPMT_SIGNATU
 
     /* Allocate memory for response parameters */
     if (quoted != NULL) {
-        *quoted = calloc(1, sizeof(TPM2B_ATTEST));
+        *quoted = iesys_output_calloc(esysContext, sizeof(TPM2B_ATTEST));
         if (*quoted == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (signature != NULL) {
-        *signature = calloc(1, sizeof(TPMT_SIGNATURE));
+        *signature = iesys_output_calloc(esysContext, sizeof(TPMT_SIGNATURE));
         if (*signature == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -335,9 +338,9 @@ Esys_Quote_Finish(ESYS_CONTEXT *esysContext, TPM2B_ATTEST **quoted, TPMT_SIGNATU
 
 error_cleanup:
     if (quoted != NULL)
-        SAFE_FREE(*quoted);
+        ESYS_OUTPUT_FREE(esysContext, *quoted);
     if (signature != NULL)
-        SAFE_FREE(*signature);
+        ESYS_OUTPUT_FREE(esysContext, *signature);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -75,8 +75,10 @@ Esys_RSA_Decrypt(ESYS_CONTEXT               *esysContext,
                  TPM2B_PUBLIC_KEY_RSA      **message) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_RSA_Decrypt_Async(esysContext, keyHandle, shandle1, shandle2, shandle3, cipherText,
                                inScheme, label);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -99,6 +101,7 @@ Esys_RSA_Decrypt(ESYS_CONTEXT               *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -255,7 +258,7 @@ Esys_RSA_Decrypt_Finish(ESYS_CONTEXT *esysContext, TPM2B_PUBLIC_KEY_RSA **messag
 
     /* Allocate memory for response parameters */
     if (message != NULL) {
-        *message = calloc(1, sizeof(TPM2B_PUBLIC_KEY_RSA));
+        *message = iesys_output_calloc(esysContext, sizeof(TPM2B_PUBLIC_KEY_RSA));
         if (*message == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -323,7 +326,7 @@ Esys_RSA_Decrypt_Finish(ESYS_CONTEXT *esysContext, TPM2B_PUBLIC_KEY_RSA **messag
 
 error_cleanup:
     if (message != NULL)
-        SAFE_FREE(*message);
+        ESYS_OUTPUT_FREE(esysContext, *message);
 
     return r;
 }
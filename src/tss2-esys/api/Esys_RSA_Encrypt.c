@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -76,8 +76,10 @@ Esys_RSA_Encrypt(ESYS_CONTEXT               *esysContext,
                  TPM2B_PUBLIC_KEY_RSA      **outData) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_RSA_Encrypt_Async(esysContext, keyHandle, shandle1, shandle2, shandle3, message,
                                inScheme, label);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -100,6 +102,7 @@ Esys_RSA_Encrypt(ESYS_CONTEXT               *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -252,7 +255,7 @@ Esys_RSA_Encrypt_Finish(ESYS_CONTEXT *esysContext, TPM2B_PUBLIC_KEY_RSA **outDat
 
     /* Allocate memory for response parameters */
     if (outData != NULL) {
-        *outData = calloc(1, sizeof(TPM2B_PUBLIC_KEY_RSA));
+        *outData = iesys_output_calloc(esysContext, sizeof(TPM2B_PUBLIC_KEY_RSA));
         if (*outData == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -320,7 +323,7 @@ Esys_RSA_Encrypt_Finish(ESYS_CONTEXT *esysContext, TPM2B_PUBLIC_KEY_RSA **outDat
 
 error_cleanup:
     if (outData != NULL)
-        SAFE_FREE(*outData);
+        ESYS_OUTPUT_FREE(esysContext, *outData);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -77,7 +77,9 @@ Esys_ReadPublic(ESYS_CONTEXT  *esysContext,
                 TPM2B_NAME   **qualifiedName) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ReadPublic_Async(esysContext, objectHandle, shandle1, shandle2, shandle3);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -100,6 +102,7 @@ Esys_ReadPublic(ESYS_CONTEXT  *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -258,19 +261,19 @@ Esys_ReadPublic_Finish(ESYS_CONTEXT  *esysContext,
 
     /* Allocate memory for response parameters */
     if (outPublic != NULL) {
-        *outPublic = calloc(1, sizeof(TPM2B_PUBLIC));
+        *outPublic = iesys_output_calloc(esysContext, sizeof(TPM2B_PUBLIC));
         if (*outPublic == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (name != NULL) {
-        *name = calloc(1, sizeof(TPM2B_NAME));
+        *name = iesys_output_calloc(esysContext, sizeof(TPM2B_NAME));
         if (*name == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
     }
     if (qualifiedName != NULL) {
-        *qualifiedName = calloc(1, sizeof(TPM2B_NAME));
+        *qualifiedName = iesys_output_calloc(esysContext, sizeof(TPM2B_NAME));
         if (*qualifiedName == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -340,11 +343,11 @@ Esys_ReadPublic_Finish(ESYS_CONTEXT  *esysContext,
 
 error_cleanup:
     if (outPublic != NULL)
-        SAFE_FREE(*outPublic);
+        ESYS_OUTPUT_FREE(esysContext, *outPublic);
     if (name != NULL)
-        SAFE_FREE(*name);
+        ESYS_OUTPUT_FREE(esysContext, *name);
     if (qualifiedName != NULL)
-        SAFE_FREE(*qualifiedName);
+        ESYS_OUTPUT_FREE(esysContext, *qualifiedName);
 
     return r;
 }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, _ESYS_STATE_...
 #include "esys_iutil.h"      // for iesys_compute_session_value, esys_GetRe...
@@ -82,8 +82,10 @@ Esys_Rewrap(ESYS_CONTEXT                 *esysContext,
             TPM2B_ENCRYPTED_SECRET      **outSymSeed) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Rewrap_Async(esysContext, oldParent, newParent, shandle1, shandle2, shandle3,
                           inDuplicate, name, inSymSeed);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -106,6 +108,7 @@ Esys_Rewrap(ESYS_CONTEXT                 *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -274,13 +277,13 @@ Esys_Rewrap_Finish(ESYS_CONTEXT            *esysContext,
 
     /* Allocate memory for response parameters */
     if (outDuplicate != NULL) {
-        *outDuplicate = calloc(1, sizeof(TPM2B_PRIVATE));
+        *outDuplicate = iesys_output_calloc(esysContext, sizeof(TPM2B_PRIVATE));
         if (*outDuplicate == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (outSymSeed != NULL) {
-        *outSymSeed = calloc(1, sizeof(TPM2B_ENCRYPTED_SECRET));
+        *outSymSeed = iesys_output_calloc(esysContext, sizeof(TPM2B_ENCRYPTED_SECRET));
         if (*outSymSeed == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -349,9 +352,9 @@ Esys_Rewrap_Finish(ESYS_CONTEXT            *esysContext,
 
 error_cleanup:
     if (outDuplicate != NULL)
-        SAFE_FREE(*outDuplicate);
+        ESYS_OUTPUT_FREE(esysContext, *outDuplicate);
     if (outSymSeed != NULL)
-        SAFE_FREE(*outSymSeed);
+        ESYS_OUTPUT_FREE(esysContext, *outSymSeed);
 
     return r;
 }
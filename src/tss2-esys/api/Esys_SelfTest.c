@@ -67,7 +67,9 @@ Esys_SelfTest(ESYS_CONTEXT *esysContext,
               TPMI_YES_NO   fullTest) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_SelfTest_Async(esysContext, shandle1, shandle2, shandle3, fullTest);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -90,6 +92,7 @@ Esys_SelfTest(ESYS_CONTEXT *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -82,8 +82,10 @@ Esys_SequenceComplete(ESYS_CONTEXT           *esysContext,
                       TPMT_TK_HASHCHECK     **validation) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_SequenceComplete_Async(esysContext, sequenceHandle, shandle1, shandle2, shandle3,
                                     buffer, hierarchy);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -106,6 +108,7 @@ Esys_SequenceComplete(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -276,13 +279,13 @@ Esys_SequenceComplete_Finish(ESYS_CONTEXT       *esysContext,
 
     /* Allocate memory for response parameters */
     if (result != NULL) {
-        *result = calloc(1, sizeof(TPM2B_DIGEST));
+        *result = iesys_output_calloc(esysContext, sizeof(TPM2B_DIGEST));
         if (*result == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (validation != NULL) {
-        *validation = calloc(1, sizeof(TPMT_TK_HASHCHECK));
+        *validation = iesys_output_calloc(esysContext, sizeof(TPMT_TK_HASHCHECK));
         if (*validation == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -355,9 +358,9 @@ Esys_SequenceComplete_Finish(ESYS_CONTEXT       *esysContext,
 
 error_cleanup:
     if (result != NULL)
-        SAFE_FREE(*result);
+        ESYS_OUTPUT_FREE(esysContext, *result);
     if (validation != NULL)
-        SAFE_FREE(*validation);
+        ESYS_OUTPUT_FREE(esysContext, *validation);
 
     return r;
 }
@@ -70,8 +70,10 @@ Esys_SequenceUpdate(ESYS_CONTEXT           *esysContext,
                     const TPM2B_MAX_BUFFER *buffer) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_SequenceUpdate_Async(esysContext, sequenceHandle, shandle1, shandle2, shandle3,
                                   buffer);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -94,6 +96,7 @@ Esys_SequenceUpdate(ESYS_CONTEXT           *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
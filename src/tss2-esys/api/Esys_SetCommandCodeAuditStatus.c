@@ -79,8 +79,10 @@ Esys_SetCommandCodeAuditStatus(ESYS_CONTEXT  *esysContext,
                                const TPML_CC *clearList) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_SetCommandCodeAuditStatus_Async(esysContext, auth, shandle1, shandle2, shandle3,
                                              auditAlg, setList, clearList);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -103,6 +105,7 @@ Esys_SetCommandCodeAuditStatus(ESYS_CONTEXT  *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -74,8 +74,10 @@ Esys_SetPrimaryPolicy(ESYS_CONTEXT       *esysContext,
                       TPMI_ALG_HASH       hashAlg) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_SetPrimaryPolicy_Async(esysContext, authHandle, shandle1, shandle2, shandle3,
                                     authPolicy, hashAlg);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -98,6 +100,7 @@ Esys_SetPrimaryPolicy(ESYS_CONTEXT       *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -78,8 +78,10 @@ Esys_Sign(ESYS_CONTEXT            *esysContext,
           TPMT_SIGNATURE         **signature) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Sign_Async(esysContext, keyHandle, shandle1, shandle2, shandle3, digest, inScheme,
                         validation);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -102,6 +104,7 @@ Esys_Sign(ESYS_CONTEXT            *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -261,7 +264,7 @@ Esys_Sign_Finish(ESYS_CONTEXT *esysContext, TPMT_SIGNATURE **signature) {
 
     /* Allocate memory for response parameters */
     if (signature != NULL) {
-        *signature = calloc(1, sizeof(TPMT_SIGNATURE));
+        *signature = iesys_output_calloc(esysContext, sizeof(TPMT_SIGNATURE));
         if (*signature == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -329,7 +332,7 @@ Esys_Sign_Finish(ESYS_CONTEXT *esysContext, TPMT_SIGNATURE **signature) {
 
 error_cleanup:
     if (signature != NULL)
-        SAFE_FREE(*signature);
+        ESYS_OUTPUT_FREE(esysContext, *signature);
 
     return r;
 }
@@ -112,8 +112,10 @@ Esys_StartAuthSession(ESYS_CONTEXT       *esysContext,
                       ESYS_TR            *sessionHandle) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_StartAuthSession_Async(esysContext, tpmKey, bind, shandle1, shandle2, shandle3,
                                     nonceCaller, sessionType, symmetric, authHash);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -136,6 +138,7 @@ Esys_StartAuthSession(ESYS_CONTEXT       *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -228,9 +231,10 @@ Esys_StartAuthSession_Async(ESYS_CONTEXT       *esysContext,
         r2 = iesys_crypto_hash_get_digest_size(authHash, &authHash_size);
         return_state_if_error(r2, ESYS_STATE_INIT, "Error in hash_get_digest_size.");
 
-        r2 = iesys_crypto_get_random2b(&esysContext->crypto_backend,
-                                       &esysContext->in.StartAuthSession.nonceCallerData,
-                                       authHash_size);
+        r2 = iesys_crypto_get_random2b_pooled(&esysContext->crypto_backend,
+                                              &esysContext->random_pool,
+                                              &esysContext->in.StartAuthSession.nonceCallerData,
+                                              authHash_size);
         return_state_if_error(r2, ESYS_STATE_INIT, "Error in crypto_random2b.");
         esysContext->in.StartAuthSession.nonceCaller
             = &esysContext->in.StartAuthSession.nonceCallerData;
@@ -271,6 +275,10 @@ Esys_StartAuthSession_Async(ESYS_CONTEXT       *esysContext,
         return_state_if_error(r, ESYS_STATE_INIT, "SAPI error on SetCmdAuths");
     }
 
+    /* Make room in the TPM for the new session */
+    r = iesys_rm_reserve(esysContext, TPM2_HT_HMAC_SESSION);
+    return_state_if_error(r, ESYS_STATE_INIT, "Resource manager");
+
     /* Trigger execution and finish the async invocation */
     r = Tss2_Sys_ExecuteAsync(esysContext->sys);
     return_state_if_error(r, ESYS_STATE_INTERNALERROR, "Finish (Execute Async)");
@@ -337,13 +345,16 @@ Esys_StartAuthSession_Finish(ESYS_CONTEXT *esysContext, ESYS_TR *sessionHandle)
     if (r != TSS2_RC_SUCCESS)
         return r;
 
-    IESYS_RESOURCE *rsrc = &sessionHandleNode->rsrc;
-    rsrc->handle = ESYS_TR_NONE;
-    rsrc->misc.rsrc_session.sessionAttributes = TPMA_SESSION_CONTINUESESSION;
-    rsrc->misc.rsrc_session.sessionType = esysContext->in.StartAuthSession.sessionType;
-    rsrc->misc.rsrc_session.authHash = esysContext->in.StartAuthSession.authHash;
-    rsrc->misc.rsrc_session.symmetric = *esysContext->in.StartAuthSession.symmetric;
-    rsrc->misc.rsrc_session.nonceCaller = esysContext->in.StartAuthSession.nonceCallerData;
+    sessionHandleNode->rsrc.handle = ESYS_TR_NONE;
+    r = iesys_rsrc_set_session(esysContext, sessionHandleNode, NULL);
+    goto_if_error(r, "Allocate session", error_cleanup);
+
+    IESYS_SESSION *session = sessionHandleNode->rsrc.misc.rsrc_session;
+    session->sessionAttributes = TPMA_SESSION_CONTINUESESSION;
+    session->sessionType = esysContext->in.StartAuthSession.sessionType;
+    session->authHash = esysContext->in.StartAuthSession.authHash;
+    session->symmetric = *esysContext->in.StartAuthSession.symmetric;
+    session->nonceCaller = esysContext->in.StartAuthSession.nonceCallerData;
 
     /* Receive the TPM response and handle resubmissions if necessary. */
     r = Tss2_Sys_ExecuteFinish(esysContext->sys, esysContext->timeout);
@@ -402,8 +413,7 @@ Esys_StartAuthSession_Finish(ESYS_CONTEXT *esysContext, ESYS_TR *sessionHandle)
     goto_state_if_error(r, ESYS_STATE_INTERNALERROR, "Received error from SAPI unmarshaling",
                         error_cleanup);
 
-    sessionHandleNode->rsrc.misc.rsrc_session.nonceTPM = lnonceTPM;
-    sessionHandleNode->rsrc.rsrcType = IESYSC_SESSION_RSRC;
+    session->nonceTPM = lnonceTPM;
     if (esysContext->in.StartAuthSession.bind != ESYS_TR_NONE || esysContext->salt.size > 0) {
         ESYS_TR      bind = esysContext->in.StartAuthSession.bind;
         ESYS_TR      tpmKey = esysContext->in.StartAuthSession.tpmKey;
@@ -418,8 +428,10 @@ Esys_StartAuthSession_Finish(ESYS_CONTEXT *esysContext, ESYS_TR *sessionHandle)
         size_t keyHash_size = 0;
         size_t authHash_size = 0;
         if (tpmKeyNode != NULL) {
-            r = iesys_crypto_hash_get_digest_size(
-                tpmKeyNode->rsrc.misc.rsrc_key_pub.publicArea.nameAlg, &keyHash_size);
+            TPM2B_PUBLIC tpmKeyPublic;
+            r = iesys_rsrc_key_public(tpmKeyNode, &tpmKeyPublic);
+            goto_if_error(r, "Get public area", error_cleanup);
+            r = iesys_crypto_hash_get_digest_size(tpmKeyPublic.publicArea.nameAlg, &keyHash_size);
             if (r != TSS2_RC_SUCCESS) {
                 LOG_ERROR("Error: initialize auth session (0x%08" PRIx32 ").", r);
                 return r;
@@ -455,19 +467,17 @@ Esys_StartAuthSession_Finish(ESYS_CONTEXT *esysContext, ESYS_TR *sessionHandle)
                     &esysContext->salt.buffer[0], keyHash_size);
             if (bind != ESYS_TR_NONE && bindNode != NULL)
                 iesys_compute_bound_entity(&bindNode->rsrc.name, &bindNode->auth,
-                                           &sessionHandleNode->rsrc.misc.rsrc_session.bound_entity);
+                                           &session->bound_entity);
             LOGBLOB_DEBUG(secret, secret_size, "ESYS Session Secret");
-            r = iesys_crypto_KDFa(
-                &esysContext->crypto_backend, esysContext->in.StartAuthSession.authHash, secret,
-                secret_size, "ATH", &lnonceTPM, esysContext->in.StartAuthSession.nonceCaller,
-                authHash_size * 8, NULL,
-                &sessionHandleNode->rsrc.misc.rsrc_session.sessionKey.buffer[0], FALSE);
+            r = iesys_crypto_KDFa(&esysContext->crypto_backend, NULL,
+                                  esysContext->in.StartAuthSession.authHash, secret, secret_size,
+                                  "ATH", &lnonceTPM, esysContext->in.StartAuthSession.nonceCaller,
+                                  authHash_size * 8, NULL, &session->sessionKey.buffer[0], FALSE);
             free(secret);
             return_if_error(r, "Error in KDFa computation.");
 
-            sessionHandleNode->rsrc.misc.rsrc_session.sessionKey.size = authHash_size;
-            LOGBLOB_DEBUG(&sessionHandleNode->rsrc.misc.rsrc_session.sessionKey.buffer[0],
-                          authHash_size, "Session Key");
+            session->sessionKey.size = authHash_size;
+            LOGBLOB_DEBUG(&session->sessionKey.buffer[0], authHash_size, "Session Key");
             return_if_error(r, "Error KDFa");
         }
     }
@@ -50,7 +50,9 @@ TSS2_RC
 Esys_Startup(ESYS_CONTEXT *esysContext, TPM2_SU startupType) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Startup_Async(esysContext, startupType);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -73,6 +75,7 @@ Esys_Startup(ESYS_CONTEXT *esysContext, TPM2_SU startupType) {
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
 
     /* Handle TPM upgrade case explicitly */
     if (r == TPM2_RC_UPGRADE) {
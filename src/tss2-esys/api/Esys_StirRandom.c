@@ -64,7 +64,9 @@ Esys_StirRandom(ESYS_CONTEXT               *esysContext,
                 const TPM2B_SENSITIVE_DATA *inData) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_StirRandom_Async(esysContext, shandle1, shandle2, shandle3, inData);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -87,6 +89,7 @@ Esys_StirRandom(ESYS_CONTEXT               *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
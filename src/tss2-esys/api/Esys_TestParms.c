@@ -67,7 +67,9 @@ Esys_TestParms(ESYS_CONTEXT            *esysContext,
                const TPMT_PUBLIC_PARMS *parameters) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_TestParms_Async(esysContext, shandle1, shandle2, shandle3, parameters);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -90,6 +92,7 @@ Esys_TestParms(ESYS_CONTEXT            *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     if (!tss2_is_expected_error(r)) {
         return_if_error(r, "Esys Finish");
     }
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -71,7 +71,9 @@ Esys_Unseal(ESYS_CONTEXT          *esysContext,
             TPM2B_SENSITIVE_DATA **outData) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Unseal_Async(esysContext, itemHandle, shandle1, shandle2, shandle3);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -94,6 +96,7 @@ Esys_Unseal(ESYS_CONTEXT          *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -243,7 +246,7 @@ Esys_Unseal_Finish(ESYS_CONTEXT *esysContext, TPM2B_SENSITIVE_DATA **outData) {
 
     /* Allocate memory for response parameters */
     if (outData != NULL) {
-        *outData = calloc(1, sizeof(TPM2B_SENSITIVE_DATA));
+        *outData = iesys_output_calloc(esysContext, sizeof(TPM2B_SENSITIVE_DATA));
         if (*outData == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -311,7 +314,55 @@ Esys_Unseal_Finish(ESYS_CONTEXT *esysContext, TPM2B_SENSITIVE_DATA **outData) {
 
 error_cleanup:
     if (outData != NULL)
-        SAFE_FREE(*outData);
+        ESYS_OUTPUT_FREE(esysContext, *outData);
 
     return r;
 }
+
+/** Asynchronous finish function for TPM2_Unseal without copying the output
+ *
+ * Like Esys_Unseal_Finish but instead of allocating the output it returns a
+ * pointer to the (decrypted) data inside the response buffer of the context.
+ * The pointer is only valid until the next command is issued on esysContext.
+ *
+ * @param[in,out] esysContext The ESYS_CONTEXT.
+ * @param[out] outData Pointer to the unsealed data.
+ * @param[out] outDataSize The size of the unsealed data.
+ * @retval TSS2_RC_SUCCESS on success
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if the esysContext or required output
+ *         pointers are NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE: if the context has no asynchronous
+ *         operation pending.
+ * @retval TSS2_ESYS_RC_TRY_AGAIN: if the timeout counter expires before the
+ *         TPM response is received.
+ * @retval TSS2_ESYS_RC_RSP_AUTH_FAILED: if the response HMAC from the TPM did
+ *         not verify.
+ * @retval TSS2_ESYS_RC_MALFORMED_RESPONSE: if the TPM's response is corrupted.
+ * @retval TSS2_RCs produced by lower layers of the software stack may be
+ *         returned to the caller unaltered unless handled internally.
+ */
+TSS2_RC
+Esys_Unseal_FinishView(ESYS_CONTEXT *esysContext, const uint8_t **outData, UINT16 *outDataSize) {
+    TSS2_RC r;
+    LOG_TRACE("context=%p, outData=%p, outDataSize=%p", esysContext, outData, outDataSize);
+
+    if (esysContext == NULL) {
+        LOG_ERROR("esyscontext is NULL.");
+        return TSS2_ESYS_RC_BAD_REFERENCE;
+    }
+    if (outData == NULL || outDataSize == NULL) {
+        LOG_ERROR("Output reference is NULL.");
+        return TSS2_ESYS_RC_BAD_REFERENCE;
+    }
+
+    r = iesys_finish_response(esysContext);
+    if (r != TSS2_RC_SUCCESS)
+        return r;
+
+    r = Tss2_Sys_Unseal_CompleteView(esysContext->sys, outData, outDataSize);
+    return_state_if_error(r, ESYS_STATE_INTERNALERROR, "Received error from SAPI unmarshaling");
+
+    esysContext->state = ESYS_STATE_INIT;
+
+    return TSS2_RC_SUCCESS;
+}
@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -64,7 +64,9 @@ Esys_Vendor_TCG_Test(ESYS_CONTEXT     *esysContext,
                      TPM2B_DATA      **outputData) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_Vendor_TCG_Test_Async(esysContext, shandle1, shandle2, shandle3, inputData);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -87,6 +89,7 @@ Esys_Vendor_TCG_Test(ESYS_CONTEXT     *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -219,7 +222,7 @@ Esys_Vendor_TCG_Test_Finish(ESYS_CONTEXT *esysContext, TPM2B_DATA **outputData)
 
     /* Allocate memory for response parameters */
     if (outputData != NULL) {
-        *outputData = calloc(1, sizeof(TPM2B_DATA));
+        *outputData = iesys_output_calloc(esysContext, sizeof(TPM2B_DATA));
         if (*outputData == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -288,7 +291,7 @@ Esys_Vendor_TCG_Test_Finish(ESYS_CONTEXT *esysContext, TPM2B_DATA **outputData)
 
 error_cleanup:
     if (outputData != NULL)
-        SAFE_FREE(*outputData);
+        ESYS_OUTPUT_FREE(esysContext, *outputData);
 
     return r;
 }
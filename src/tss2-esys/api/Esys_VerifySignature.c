@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, _ESYS_S...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -76,8 +76,10 @@ Esys_VerifySignature(ESYS_CONTEXT         *esysContext,
                      TPMT_TK_VERIFIED    **validation) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_VerifySignature_Async(esysContext, keyHandle, shandle1, shandle2, shandle3, digest,
                                    signature);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -100,6 +102,7 @@ Esys_VerifySignature(ESYS_CONTEXT         *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -252,7 +255,7 @@ Esys_VerifySignature_Finish(ESYS_CONTEXT *esysContext, TPMT_TK_VERIFIED **valida
 
     /* Allocate memory for response parameters */
     if (validation != NULL) {
-        *validation = calloc(1, sizeof(TPMT_TK_VERIFIED));
+        *validation = iesys_output_calloc(esysContext, sizeof(TPMT_TK_VERIFIED));
         if (*validation == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
@@ -321,7 +324,7 @@ Esys_VerifySignature_Finish(ESYS_CONTEXT *esysContext, TPMT_TK_VERIFIED **valida
 
 error_cleanup:
     if (validation != NULL)
-        SAFE_FREE(*validation);
+        ESYS_OUTPUT_FREE(esysContext, *validation);
 
     return r;
 }
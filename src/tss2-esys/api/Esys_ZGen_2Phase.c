@@ -9,7 +9,7 @@
 #endif
 
 #include <inttypes.h> // for PRIx32, PRIx16, int32_t
-#include <stdlib.h>   // for NULL, calloc
+#include <stdlib.h>   // for NULL
 
 #include "esys_int.h"        // for ESYS_CONTEXT, _ESYS_STATE_INIT, RSRC_NO...
 #include "esys_iutil.h"      // for iesys_compute_session_value, check_sess...
@@ -81,8 +81,10 @@ Esys_ZGen_2Phase(ESYS_CONTEXT          *esysContext,
                  TPM2B_ECC_POINT      **outZ2) {
     TSS2_RC r;
 
+    iesys_thread_enter(esysContext);
     r = Esys_ZGen_2Phase_Async(esysContext, keyA, shandle1, shandle2, shandle3, inQsB, inQeB,
                                inScheme, counter);
+    iesys_thread_leave_if_error(esysContext, r);
     return_if_error(r, "Error in async function");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -105,6 +107,7 @@ Esys_ZGen_2Phase(ESYS_CONTEXT          *esysContext,
 
     /* Restore the timeout value to the original value */
     esysContext->timeout = timeouttmp;
+    iesys_thread_leave(esysContext);
     return_if_error(r, "Esys Finish");
 
     return TSS2_RC_SUCCESS;
@@ -268,13 +271,13 @@ Esys_ZGen_2Phase_Finish(ESYS_CONTEXT     *esysContext,
 
     /* Allocate memory for response parameters */
     if (outZ1 != NULL) {
-        *outZ1 = calloc(1, sizeof(TPM2B_ECC_POINT));
+        *outZ1 = iesys_output_calloc(esysContext, sizeof(TPM2B_ECC_POINT));
         if (*outZ1 == NULL) {
             return_error(TSS2_ESYS_RC_MEMORY, "Out of memory");
         }
     }
     if (outZ2 != NULL) {
-        *outZ2 = calloc(1, sizeof(TPM2B_ECC_POINT));
+        *outZ2 = iesys_output_calloc(esysContext, sizeof(TPM2B_ECC_POINT));
         if (*outZ2 == NULL) {
             goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of memory", error_cleanup);
         }
@@ -343,9 +346,9 @@ Esys_ZGen_2Phase_Finish(ESYS_CONTEXT     *esysContext,
 
 error_cleanup:
     if (outZ1 != NULL)
-        SAFE_FREE(*outZ1);
+        ESYS_OUTPUT_FREE(esysContext, *outZ1);
     if (outZ2 != NULL)
-        SAFE_FREE(*outZ2);
+        ESYS_OUTPUT_FREE(esysContext, *outZ2);
 
     return r;
 }
@@ -0,0 +1,231 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <stdbool.h> // for bool, false, true
+#include <stdint.h>  // for SIZE_MAX
+#include <stdlib.h>  // for NULL, size_t, calloc, free, malloc
+#include <string.h>  // for memset
+
+#include "esys_int.h"    // for ESYS_CONTEXT, IESYS_ARENA, ESYS_ASSERT_NON_NULL
+#include "esys_iutil.h"  // for iesys_output_calloc, iesys_output_free
+#include "tss2_common.h" // for TSS2_RC, TSS2_RC_SUCCESS
+#include "tss2_esys.h"   // for Esys_ArenaEnable, Esys_ArenaReset
+
+#define LOGMODULE esys
+#include "util/log.h" // for LOG_TRACE, return_if_null
+
+/** Alignment of the allocations of the arena */
+#define IESYS_ARENA_ALIGN    16
+#define IESYS_ARENA_ROUND(x) (((x) + IESYS_ARENA_ALIGN - 1) & ~(size_t)(IESYS_ARENA_ALIGN - 1))
+
+/** A block of memory of the arena.
+ *
+ * The data of the block follows the structure. The allocations of a block
+ * form a stack; each allocation is preceded by an IESYS_ARENA_HEADER.
+ */
+struct IESYS_ARENA_BLOCK {
+    IESYS_ARENA_BLOCK *prev; /**< The previous block */
+    IESYS_ARENA_BLOCK *next; /**< The next block, always unused */
+    size_t             size; /**< The size of the data of the block */
+    size_t             used; /**< The number of bytes in use */
+    size_t             last; /**< Offset of the topmost header, SIZE_MAX if none */
+};
+
+/** The header of an allocation of the arena */
+typedef struct {
+    size_t size;  /**< The size of the allocation including the header */
+    size_t prev;  /**< Offset of the header below, SIZE_MAX if none */
+    bool   freed; /**< The allocation was freed but is not the topmost one */
+} IESYS_ARENA_HEADER;
+
+#define IESYS_ARENA_BLOCK_SIZE  IESYS_ARENA_ROUND(sizeof(IESYS_ARENA_BLOCK))
+#define IESYS_ARENA_HEADER_SIZE IESYS_ARENA_ROUND(sizeof(IESYS_ARENA_HEADER))
+
+static unsigned char *
+arena_data(IESYS_ARENA_BLOCK *block) {
+    return (unsigned char *)block + IESYS_ARENA_BLOCK_SIZE;
+}
+
+static IESYS_ARENA_HEADER *
+arena_header(IESYS_ARENA_BLOCK *block, size_t offset) {
+    return (IESYS_ARENA_HEADER *)(arena_data(block) + offset);
+}
+
+static IESYS_ARENA_BLOCK *
+arena_block_new(size_t size) {
+    if (size > SIZE_MAX - IESYS_ARENA_BLOCK_SIZE)
+        return NULL;
+
+    IESYS_ARENA_BLOCK *block = malloc(IESYS_ARENA_BLOCK_SIZE + size);
+    if (block == NULL)
+        return NULL;
+
+    block->prev = NULL;
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    block->last = SIZE_MAX;
+    return block;
+}
+
+/** Release all blocks of the arena of a context and disable it.
+ *
+ * All outputs taken from the arena become invalid.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ */
+void
+iesys_arena_release(ESYS_CONTEXT *esys_context) {
+    IESYS_ARENA_BLOCK *block = esys_context->arena.first;
+    while (block != NULL) {
+        IESYS_ARENA_BLOCK *next = block->next;
+        free(block);
+        block = next;
+    }
+    esys_context->arena.block_size = 0;
+    esys_context->arena.first = NULL;
+    esys_context->arena.current = NULL;
+}
+
+/** Allocate zeroed memory for an output of a _Finish function.
+ *
+ * If the arena of the context is enabled the memory is taken from it,
+ * otherwise it is allocated with calloc().
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] size The number of bytes to allocate.
+ * @retval The allocated memory or NULL if no memory is available.
+ */
+void *
+iesys_output_calloc(ESYS_CONTEXT *esys_context, size_t size) {
+    IESYS_ARENA *arena = &esys_context->arena;
+
+    if (arena->block_size == 0)
+        return calloc(1, size);
+
+    if (size > SIZE_MAX - IESYS_ARENA_HEADER_SIZE - IESYS_ARENA_ALIGN)
+        return NULL;
+    size_t need = IESYS_ARENA_HEADER_SIZE + IESYS_ARENA_ROUND(size);
+
+    /* The blocks after the current one are unused, so the next one fits if it
+       is large enough. Otherwise a new block is inserted. */
+    IESYS_ARENA_BLOCK *block = arena->current;
+    while (block->size - block->used < need) {
+        if (block->next == NULL || block->next->size < need) {
+            IESYS_ARENA_BLOCK *new_block
+                = arena_block_new(need > arena->block_size ? need : arena->block_size);
+            if (new_block == NULL)
+                return NULL;
+            new_block->prev = block;
+            new_block->next = block->next;
+            if (block->next != NULL)
+                block->next->prev = new_block;
+            block->next = new_block;
+        }
+        block = block->next;
+    }
+    arena->current = block;
+
+    IESYS_ARENA_HEADER *header = arena_header(block, block->used);
+    header->size = need;
+    header->prev = block->last;
+    header->freed = false;
+    block->last = block->used;
+    block->used += need;
+
+    void *ptr = (unsigned char *)header + IESYS_ARENA_HEADER_SIZE;
+    memset(ptr, 0, need - IESYS_ARENA_HEADER_SIZE);
+    return ptr;
+}
+
+/** Free an output allocated by iesys_output_calloc().
+ *
+ * In arena mode the memory is returned to the arena if it is the topmost
+ * allocation, together with all freed allocations below it. Other
+ * allocations are reclaimed by Esys_ArenaReset().
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] ptr The memory to be freed.
+ */
+void
+iesys_output_free(ESYS_CONTEXT *esys_context, void *ptr) {
+    IESYS_ARENA *arena = &esys_context->arena;
+
+    if (ptr == NULL)
+        return;
+    if (arena->block_size == 0) {
+        free(ptr);
+        return;
+    }
+
+    IESYS_ARENA_HEADER *header
+        = (IESYS_ARENA_HEADER *)((unsigned char *)ptr - IESYS_ARENA_HEADER_SIZE);
+    header->freed = true;
+
+    IESYS_ARENA_BLOCK *block = arena->current;
+    for (;;) {
+        while (block->last != SIZE_MAX && arena_header(block, block->last)->freed) {
+            block->used = block->last;
+            block->last = arena_header(block, block->last)->prev;
+        }
+        if (block->used != 0 || block->prev == NULL)
+            break;
+        block = block->prev;
+    }
+    arena->current = block;
+}
+
+/** Enable or disable the arena mode of an ESYS context.
+ *
+ * In arena mode the outputs of the _Finish functions (and thus of the
+ * synchronous calls) are taken from blocks of memory owned by the context.
+ * They must not be freed by the application; they stay valid until
+ * Esys_ArenaReset() or Esys_Finalize() is called or the arena is disabled.
+ * Memory returned by other functions, e.g. Esys_TR_GetName(), still has to be
+ * freed with Esys_Free().
+ * Calling this function while the arena is enabled discards all outputs taken
+ * from it.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] size The size of the blocks of the arena; outputs larger than
+ *            this get a block of their own. 0 disables the arena mode.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL.
+ * @retval TSS2_ESYS_RC_MEMORY if the first block cannot be allocated.
+ */
+TSS2_RC
+Esys_ArenaEnable(ESYS_CONTEXT *esys_context, size_t size) {
+    ESYS_ASSERT_NON_NULL(esys_context);
+    LOG_TRACE("context=%p, size=%zu", (void *)esys_context, size);
+
+    iesys_arena_release(esys_context);
+    if (size == 0)
+        return TSS2_RC_SUCCESS;
+
+    esys_context->arena.first = arena_block_new(size);
+    return_if_null(esys_context->arena.first, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+    esys_context->arena.current = esys_context->arena.first;
+    esys_context->arena.block_size = size;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Release all outputs taken from the arena of an ESYS context.
+ *
+ * The memory of the arena is kept for reuse. All outputs returned since the
+ * last reset become invalid. Does nothing if the arena mode is disabled.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL.
+ */
+TSS2_RC
+Esys_ArenaReset(ESYS_CONTEXT *esys_context) {
+    ESYS_ASSERT_NON_NULL(esys_context);
+
+    for (IESYS_ARENA_BLOCK *block = esys_context->arena.first; block != NULL;
+         block = block->next) {
+        block->used = 0;
+        block->last = SIZE_MAX;
+    }
+    esys_context->arena.current = esys_context->arena.first;
+    return TSS2_RC_SUCCESS;
+}
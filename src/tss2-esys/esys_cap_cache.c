@@ -0,0 +1,329 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for PRIx32
+#include <stdbool.h>  // for bool, false, true
+#include <stdlib.h>   // for NULL, calloc, free
+#include <string.h>   // for memset
+
+#include "esys_int.h"        // for ESYS_CONTEXT, IESYS_CAP_CACHE, IESYS_CAP...
+#include "esys_iutil.h"      // for iesys_cap_cache_get, iesys_cap_cache_lookup
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_RC_...
+#include "tss2_esys.h"       // for Esys_CapabilityCacheEnable, ESYS_TR_NONE
+#include "tss2_tpm2_types.h" // for TPMS_CAPABILITY_DATA, TPM2_CAP_ALGS, TPM...
+
+#define LOGMODULE esys
+#include "util/log.h" // for LOG_DEBUG, LOG_ERROR, return_if_null
+
+/** The cached capabilities, in the order of IESYS_CAP_CACHE.entries. */
+static const struct {
+    TPM2_CAP capability;
+    UINT32   first; /**< The lowest property of the capability */
+    UINT32   max;   /**< The number of entries fitting into TPMS_CAPABILITY_DATA */
+} cap_cache_caps[IESYS_CAP_CACHE_ENTRIES] = {
+    { TPM2_CAP_ALGS, TPM2_ALG_FIRST, TPM2_MAX_CAP_ALGS },
+    { TPM2_CAP_COMMANDS, TPM2_CC_FIRST, TPM2_MAX_CAP_CC },
+    { TPM2_CAP_TPM_PROPERTIES, TPM2_PT_FIXED, TPM2_MAX_TPM_PROPERTIES },
+    { TPM2_CAP_ECC_CURVES, TPM2_ECC_NIST_P192, TPM2_MAX_ECC_CURVES },
+};
+
+static UINT32
+cap_count(const TPMS_CAPABILITY_DATA *data) {
+    switch (data->capability) {
+    case TPM2_CAP_ALGS:
+        return data->data.algorithms.count;
+    case TPM2_CAP_COMMANDS:
+        return data->data.command.count;
+    case TPM2_CAP_TPM_PROPERTIES:
+        return data->data.tpmProperties.count;
+    default:
+        return data->data.eccCurves.count;
+    }
+}
+
+/** Get the property an entry is sorted by, e.g. the command code of a TPMA_CC. */
+static UINT32
+cap_key(const TPMS_CAPABILITY_DATA *data, UINT32 i) {
+    TPMA_CC cc;
+
+    switch (data->capability) {
+    case TPM2_CAP_ALGS:
+        return data->data.algorithms.algProperties[i].alg;
+    case TPM2_CAP_COMMANDS:
+        cc = data->data.command.commandAttributes[i];
+        return (cc & TPMA_CC_COMMANDINDEX_MASK)
+               | ((cc & TPMA_CC_V) ? TPM2_CC_Vendor_TCG_Test : 0);
+    case TPM2_CAP_TPM_PROPERTIES:
+        return data->data.tpmProperties.tpmProperty[i].property;
+    default:
+        return data->data.eccCurves.eccCurves[i];
+    }
+}
+
+/** Append entry i of src to dst, which must have room for it. */
+static void
+cap_append(TPMS_CAPABILITY_DATA *dst, const TPMS_CAPABILITY_DATA *src, UINT32 i) {
+    switch (src->capability) {
+    case TPM2_CAP_ALGS:
+        dst->data.algorithms.algProperties[dst->data.algorithms.count++]
+            = src->data.algorithms.algProperties[i];
+        break;
+    case TPM2_CAP_COMMANDS:
+        dst->data.command.commandAttributes[dst->data.command.count++]
+            = src->data.command.commandAttributes[i];
+        break;
+    case TPM2_CAP_TPM_PROPERTIES:
+        dst->data.tpmProperties.tpmProperty[dst->data.tpmProperties.count++]
+            = src->data.tpmProperties.tpmProperty[i];
+        break;
+    default:
+        dst->data.eccCurves.eccCurves[dst->data.eccCurves.count++]
+            = src->data.eccCurves.eccCurves[i];
+        break;
+    }
+}
+
+static void
+cap_cache_reset(IESYS_CAP_CACHE *cache) {
+    memset(cache->entries, 0, IESYS_CAP_CACHE_ENTRIES * sizeof(*cache->entries));
+    for (size_t i = 0; i < IESYS_CAP_CACHE_ENTRIES; i++) {
+        cache->entries[i].data.capability = cap_cache_caps[i].capability;
+        cache->entries[i].next = cap_cache_caps[i].first;
+    }
+    cache->pending = NULL;
+}
+
+/** Check whether a TPM2_GetCapability query can be answered by the cache.
+ *
+ * Called by Esys_GetCapability before sending the query and by
+ * Esys_GetCapability_Async, which always sends it. Queries with sessions,
+ * e.g. for audit, and of variable capabilities are not cached. If the
+ * capability is not completely cached yet, but the response would continue
+ * the cached entries, it is recorded for iesys_cap_cache_store.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] shandle1 First session handle.
+ * @param[in] shandle2 Second session handle.
+ * @param[in] shandle3 Third session handle.
+ * @param[in] capability The capability of the query.
+ * @param[in] property The first property of the query.
+ * @param[in] propertyCount The number of properties of the query.
+ * @retval true if iesys_cap_cache_get answers the query.
+ * @retval false if the query has to be sent to the TPM.
+ */
+bool
+iesys_cap_cache_lookup(ESYS_CONTEXT *esys_context,
+                       ESYS_TR       shandle1,
+                       ESYS_TR       shandle2,
+                       ESYS_TR       shandle3,
+                       TPM2_CAP      capability,
+                       UINT32        property,
+                       UINT32        propertyCount) {
+    IESYS_CAP_CACHE       *cache = &esys_context->cap_cache;
+    IESYS_CAP_CACHE_ENTRY *entry;
+    UINT32                 count;
+    size_t                 i;
+
+    cache->pending = NULL;
+    if (cache->entries == NULL || shandle1 != ESYS_TR_NONE || shandle2 != ESYS_TR_NONE
+        || shandle3 != ESYS_TR_NONE || propertyCount == 0)
+        return false;
+    if (capability == TPM2_CAP_TPM_PROPERTIES && property >= TPM2_PT_VAR)
+        return false;
+    for (i = 0; i < IESYS_CAP_CACHE_ENTRIES; i++)
+        if (cap_cache_caps[i].capability == capability)
+            break;
+    if (i == IESYS_CAP_CACHE_ENTRIES || cache->entries[i].overflow)
+        return false;
+
+    entry = &cache->entries[i];
+    cache->property = property;
+    cache->count = propertyCount;
+    if (!entry->complete) {
+        if (property <= entry->next)
+            cache->pending = entry;
+        return false;
+    }
+
+    /* The variable properties following the fixed ones come from the TPM */
+    count = cap_count(&entry->data);
+    if (capability == TPM2_CAP_TPM_PROPERTIES
+        && (count == 0 || cap_key(&entry->data, count - 1) < property))
+        return false;
+
+    LOG_DEBUG("Capability 0x%" PRIx32 " from property 0x%" PRIx32 " is cached", capability,
+              property);
+    cache->pending = entry;
+    return true;
+}
+
+/** Answer the pending TPM2_GetCapability query from the cache.
+ *
+ * Called by Esys_GetCapability if iesys_cap_cache_lookup returned true. The
+ * answer holds the cached entries from the queried property on, so responses
+ * split by the TPM are returned at once. For TPM2_CAP_TPM_PROPERTIES moreData
+ * is always set, since the variable properties follow.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[out] moreData Set if more entries follow (may be NULL).
+ * @param[out] data The answer (callee-allocated, may be NULL).
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_MEMORY if the answer cannot be allocated.
+ */
+TSS2_RC
+iesys_cap_cache_get(ESYS_CONTEXT          *esys_context,
+                    TPMI_YES_NO           *moreData,
+                    TPMS_CAPABILITY_DATA **data) {
+    IESYS_CAP_CACHE            *cache = &esys_context->cap_cache;
+    const TPMS_CAPABILITY_DATA *cached = &cache->pending->data;
+    TPMS_CAPABILITY_DATA       *answer = NULL;
+    UINT32                      i, n, count = cap_count(cached);
+
+    cache->pending = NULL;
+    if (data != NULL) {
+        answer = iesys_output_calloc(esys_context, sizeof(*answer));
+        return_if_null(answer, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+        answer->capability = cached->capability;
+    }
+    for (i = 0; i < count && cap_key(cached, i) < cache->property; i++)
+        ;
+    for (n = 0; i < count && n < cache->count; i++, n++)
+        if (answer != NULL)
+            cap_append(answer, cached, i);
+    if (moreData != NULL)
+        *moreData = (i < count || cached->capability == TPM2_CAP_TPM_PROPERTIES) ? TPM2_YES
+                                                                                 : TPM2_NO;
+    if (data != NULL)
+        *data = answer;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Merge the response of a TPM2_GetCapability query into the cache.
+ *
+ * Called by Esys_GetCapability_Finish on success. Only responses recorded by
+ * iesys_cap_cache_lookup are merged. The capability is complete once the TPM
+ * reports no more data or, for TPM2_CAP_TPM_PROPERTIES, the first variable
+ * property.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] moreData The moreData of the response.
+ * @param[in] data The capability data of the response.
+ */
+void
+iesys_cap_cache_store(ESYS_CONTEXT               *esys_context,
+                      TPMI_YES_NO                 moreData,
+                      const TPMS_CAPABILITY_DATA *data) {
+    IESYS_CAP_CACHE       *cache = &esys_context->cap_cache;
+    IESYS_CAP_CACHE_ENTRY *entry = cache->pending;
+    UINT32                 i, key, max;
+
+    cache->pending = NULL;
+    if (entry == NULL || data->capability != entry->data.capability)
+        return;
+    max = cap_cache_caps[entry - cache->entries].max;
+
+    for (i = 0; i < cap_count(data); i++) {
+        key = cap_key(data, i);
+        if (key < entry->next)
+            continue;
+        if (data->capability == TPM2_CAP_TPM_PROPERTIES && key >= TPM2_PT_VAR) {
+            entry->complete = true;
+            break;
+        }
+        if (cap_count(&entry->data) == max) {
+            LOG_DEBUG("Capability 0x%" PRIx32 " exceeds the cache", data->capability);
+            entry->overflow = true;
+            return;
+        }
+        cap_append(&entry->data, data, i);
+        entry->next = key + 1;
+    }
+    if (moreData == TPM2_NO)
+        entry->complete = true;
+}
+
+/** Release the capability cache of an ESYS context. */
+void
+iesys_cap_cache_release(ESYS_CONTEXT *esys_context) {
+    free(esys_context->cap_cache.entries);
+    memset(&esys_context->cap_cache, 0, sizeof(esys_context->cap_cache));
+}
+
+/** Enable the capability cache of an ESYS context.
+ *
+ * The algorithms, commands and ECC curves implemented by the TPM and its
+ * TPM2_PT_FIXED properties do not change while the TPM is powered. With the
+ * cache enabled, the responses of Esys_GetCapability and
+ * Esys_GetCapability_Async/_Finish for these are kept in the context. Once a
+ * capability has been read completely, possibly with several queries
+ * continuing each other, further queries of Esys_GetCapability are answered
+ * without a TPM command and without splitting the answer.
+ * Esys_GetCapability_Async always sends the query, so the TCTI signals its
+ * completion to callers waiting on Esys_GetPollHandles. Queries with sessions
+ * and of other capabilities or properties are always sent to the TPM.
+ * Calling this function again has no effect.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE if a command of the context is pending.
+ * @retval TSS2_ESYS_RC_MEMORY if the cache cannot be allocated.
+ */
+TSS2_RC
+Esys_CapabilityCacheEnable(ESYS_CONTEXT *esys_context) {
+    ESYS_ASSERT_NON_NULL(esys_context);
+    if (esys_context->state != ESYS_STATE_INIT) {
+        LOG_ERROR("Esys called in bad sequence.");
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+
+    if (esys_context->cap_cache.entries == NULL) {
+        esys_context->cap_cache.entries
+            = calloc(IESYS_CAP_CACHE_ENTRIES, sizeof(IESYS_CAP_CACHE_ENTRY));
+        return_if_null(esys_context->cap_cache.entries, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+        cap_cache_reset(&esys_context->cap_cache);
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+/** Disable the capability cache of an ESYS context and free it.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE if a command of the context is pending.
+ */
+TSS2_RC
+Esys_CapabilityCacheDisable(ESYS_CONTEXT *esys_context) {
+    ESYS_ASSERT_NON_NULL(esys_context);
+    if (esys_context->state != ESYS_STATE_INIT) {
+        LOG_ERROR("Esys called in bad sequence.");
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+
+    iesys_cap_cache_release(esys_context);
+    return TSS2_RC_SUCCESS;
+}
+
+/** Drop the cached capabilities of an ESYS context.
+ *
+ * To be called when the fixed capabilities of the TPM may have changed, e.g.
+ * after a firmware update. Also drops the TPM2_PT_NV_BUFFER_MAX used by
+ * Esys_NV_ReadAll and Esys_NV_WriteAll, which is kept even without the cache.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE if a command of the context is pending.
+ */
+TSS2_RC
+Esys_CapabilityCacheInvalidate(ESYS_CONTEXT *esys_context) {
+    ESYS_ASSERT_NON_NULL(esys_context);
+    if (esys_context->state != ESYS_STATE_INIT) {
+        LOG_ERROR("Esys called in bad sequence.");
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+
+    if (esys_context->cap_cache.entries != NULL)
+        cap_cache_reset(&esys_context->cap_cache);
+    esys_context->nv_buffer_max = 0;
+    return TSS2_RC_SUCCESS;
+}
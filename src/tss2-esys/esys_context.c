@@ -10,7 +10,7 @@
 #include <stdint.h> // for int32_t
 #include <stdlib.h> // for NULL, free, calloc, rand, size_t
 
-#include "esys_crypto.h"  // for iesys_initialize_crypto_backend
+#include "esys_crypto.h"  // for iesys_initialize_crypto_backend, iesys_cryp...
 #include "esys_int.h"     // for ESYS_CONTEXT, _ESYS_ASSERT_NON_NULL
 #include "esys_iutil.h"   // for iesys_DeleteAllResourceObjects, ESYS_TR_MI...
 #include "tss2_common.h"  // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_RC_BAD...
@@ -147,6 +147,13 @@ Esys_Finalize(ESYS_CONTEXT **esys_context) {
     }
 
     /* Free esys_context */
+    iesys_crypto_random_pool_clear(&(*esys_context)->random_pool);
+    iesys_crypto_pkey_cache_clear(&(*esys_context)->pkey_cache);
+    iesys_arena_release(*esys_context);
+    iesys_rm_release(*esys_context);
+    iesys_cap_cache_release(*esys_context);
+    iesys_thread_release(*esys_context);
+    free((*esys_context)->name_cache_dir);
     free(*esys_context);
     *esys_context = NULL;
 }
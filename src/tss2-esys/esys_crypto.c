@@ -9,7 +9,10 @@
 #endif
 
 #include <inttypes.h> // for uint8_t, uint32_t, PRIu16
-#include <string.h>   // for strlen
+#include <string.h>   // for strlen, memcpy
+#ifndef _WIN32
+#include <unistd.h> // for getpid
+#endif
 
 #include "esys_crypto.h"
 #include "esys_mu.h"   // for TRUE
@@ -176,11 +179,151 @@ iesys_crypto_hmac_abort(ESYS_CRYPTO_CALLBACKS *crypto_cb, ESYS_CRYPTO_CONTEXT_BL
     return TSS2_RC_SUCCESS;
 }
 
+/** Provide an HMAC context from the keyed state cached for a key.
+ *
+ * Keying an HMAC derives the inner and outer pad state from the key, which
+ * for the OpenSSL backend also means creating a library context and a key
+ * object. A session key is used for several HMACs per command, so the keyed
+ * context is kept in keyCache and every call returns a copy of it. The cache
+ * is only bound to hashAlg and size; the caller has to invalidate it whenever
+ * the bytes of the key change. User supplied callbacks and backends which
+ * cannot copy a keyed context fall back to iesys_crypto_hmac_start.
+ * @param[in,out] keyCache The cache for the key (NULL to disable caching).
+ * @param[out] context The created context (callee-allocated).
+ * @param[in] hashAlg The hash algorithm for the HMAC computation.
+ * @param[in] key The byte buffer of the HMAC key.
+ * @param[in] size The size of the HMAC key.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_MEMORY Memory cannot be allocated.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE for errors of the crypto library.
+ */
+TSS2_RC
+iesys_crypto_hmac_start_cached(ESYS_CRYPTO_CALLBACKS     *crypto_cb,
+                               IESYS_HMAC_KEY_CACHE      *keyCache,
+                               ESYS_CRYPTO_CONTEXT_BLOB **context,
+                               TPM2_ALG_ID                hashAlg,
+                               const uint8_t             *key,
+                               size_t                     size) {
+#ifdef iesys_crypto_hmac_dup_internal
+    if (keyCache != NULL && context != NULL
+        && crypto_cb->hmac_start == iesys_crypto_hmac_start_internal) {
+        if (keyCache->hashAlg != hashAlg || keyCache->size != size)
+            iesys_crypto_hmac_cache_clear(crypto_cb, keyCache);
+
+        if (keyCache->context == NULL) {
+            TSS2_RC r = iesys_crypto_hmac_start(crypto_cb, &keyCache->context, hashAlg, key, size);
+            return_if_error(r, "Keying HMAC");
+            keyCache->hashAlg = hashAlg;
+            keyCache->size = (UINT16)size;
+        }
+        return iesys_crypto_hmac_dup_internal(keyCache->context, context);
+    }
+#else
+    UNUSED(keyCache);
+#endif
+    return iesys_crypto_hmac_start(crypto_cb, context, hashAlg, key, size);
+}
+
+/** Mark the keyed HMAC state of a cache as outdated.
+ *
+ * Has to be called when the key the cache is used for changes. The context is
+ * released by the next use or clearing of the cache.
+ * @param[in,out] keyCache The cache to invalidate.
+ */
+void
+iesys_crypto_hmac_cache_invalidate(IESYS_HMAC_KEY_CACHE *keyCache) {
+    keyCache->hashAlg = TPM2_ALG_ERROR;
+}
+
+/** Release the keyed HMAC state of a cache.
+ *
+ * @param[in,out] keyCache The cache to clear.
+ */
+void
+iesys_crypto_hmac_cache_clear(ESYS_CRYPTO_CALLBACKS *crypto_cb, IESYS_HMAC_KEY_CACHE *keyCache) {
+    if (keyCache->context != NULL)
+        iesys_crypto_hmac_abort(crypto_cb, &keyCache->context);
+    keyCache->context = NULL;
+    keyCache->hashAlg = TPM2_ALG_ERROR;
+    keyCache->size = 0;
+}
+
 TSS2_RC
 iesys_crypto_get_random2b(ESYS_CRYPTO_CALLBACKS *crypto_cb, TPM2B_NONCE *nonce, size_t num_bytes) {
     DO_CALLBACK(get_random2b, nonce, num_bytes);
 }
 
+/** Overwrite a buffer with zeros in a way the compiler cannot drop. */
+static void
+wipe(BYTE *buffer, size_t size) {
+    volatile BYTE *p = buffer;
+    while (size--)
+        *p++ = 0;
+}
+
+/** Provide random TPM2B data from a pool of random bytes.
+ *
+ * Getting random data from the crypto backend is expensive per call, the
+ * OpenSSL backend for instance sets up a library context every time. With the
+ * built-in backends the random bytes for nonces and salts are therefore drawn
+ * in blocks of IESYS_RANDOM_POOL_SIZE bytes. Bytes handed out are wiped from
+ * the pool, and a process forked after the pool was filled draws a new block
+ * instead of returning the same bytes as its parent. User supplied callbacks
+ * are called directly.
+ * @param[in,out] pool The pool of random bytes.
+ * @param[out] nonce The TPM2B structure for the random data (caller-allocated).
+ * @param[in] num_bytes The number of bytes to be generated (0 for the size of
+ *            the nonce buffer).
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_VALUE if num_bytes exceeds the nonce buffer.
+ * @retval TSS2_ESYS_RC_MEMORY Memory cannot be allocated.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE for errors of the random number generator.
+ */
+TSS2_RC
+iesys_crypto_get_random2b_pooled(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                                 IESYS_RANDOM_POOL     *pool,
+                                 TPM2B_NONCE           *nonce,
+                                 size_t                 num_bytes) {
+#ifdef iesys_crypto_get_random_internal
+    if (pool != NULL && crypto_cb->get_random2b == iesys_crypto_get_random2b_internal) {
+        size_t size = (num_bytes == 0) ? sizeof(nonce->buffer) : num_bytes;
+        if (size > sizeof(nonce->buffer)) {
+            return_error(TSS2_ESYS_RC_BAD_VALUE, "Too many random bytes requested");
+        }
+#ifndef _WIN32
+        if (pool->pid != (long)getpid()) {
+            iesys_crypto_random_pool_clear(pool);
+            pool->pid = (long)getpid();
+        }
+#endif
+        if (pool->available < size) {
+            TSS2_RC r = iesys_crypto_get_random_internal(&pool->buffer[0], sizeof(pool->buffer));
+            return_if_error(r, "Refilling random pool");
+            pool->available = sizeof(pool->buffer);
+        }
+
+        pool->available -= (UINT16)size;
+        memcpy(&nonce->buffer[0], &pool->buffer[pool->available], size);
+        wipe(&pool->buffer[pool->available], size);
+        nonce->size = (UINT16)size;
+        return TSS2_RC_SUCCESS;
+    }
+#else
+    UNUSED(pool);
+#endif
+    return iesys_crypto_get_random2b(crypto_cb, nonce, num_bytes);
+}
+
+/** Wipe and empty a pool of random bytes.
+ *
+ * @param[in,out] pool The pool of random bytes.
+ */
+void
+iesys_crypto_random_pool_clear(IESYS_RANDOM_POOL *pool) {
+    wipe(&pool->buffer[0], sizeof(pool->buffer));
+    pool->available = 0;
+}
+
 TSS2_RC
 iesys_crypto_get_ecdh_point(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                             TPM2B_PUBLIC          *key,
@@ -192,6 +335,160 @@ iesys_crypto_get_ecdh_point(ESYS_CRYPTO_CALLBACKS *crypto_cb,
     DO_CALLBACK(get_ecdh_point, key, max_out_size, Z, Q, out_buffer, out_size);
 }
 
+#ifdef iesys_crypto_pkey_load_internal
+/** Look up the converted public key of a tpmKey in a cache.
+ *
+ * If the key is not cached yet it is converted and stored in an unused entry
+ * or in place of the least recently used one.
+ * @param[in,out] cache The cache of converted keys.
+ * @param[in] name The name of the key.
+ * @param[in] key The public area of the key.
+ * @param[out] pkey The converted key. It is owned by the cache.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_NOT_IMPLEMENTED The key type or the curve is not implemented.
+ * @retval TSS2_ESYS_RC_MEMORY Memory cannot be allocated.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE for errors of the crypto library.
+ */
+static TSS2_RC
+pkey_cache_lookup(IESYS_PKEY_CACHE        *cache,
+                  const TPM2B_NAME        *name,
+                  TPM2B_PUBLIC            *key,
+                  IESYS_CRYPTO_PKEY_BLOB **pkey) {
+    TSS2_RC r;
+    size_t  i, victim = 0;
+
+    cache->clock += 1;
+    for (i = 0; i < IESYS_PKEY_CACHE_SIZE; i++) {
+        if (cache->entry[i].pkey != NULL && cache->entry[i].name.size == name->size
+            && memcmp(&cache->entry[i].name.name[0], &name->name[0], name->size) == 0) {
+            cache->entry[i].lastUse = cache->clock;
+            *pkey = cache->entry[i].pkey;
+            return TSS2_RC_SUCCESS;
+        }
+        if (cache->entry[victim].pkey != NULL
+            && (cache->entry[i].pkey == NULL
+                || cache->entry[i].lastUse < cache->entry[victim].lastUse)) {
+            victim = i;
+        }
+    }
+
+    r = iesys_crypto_pkey_load_internal(key, pkey);
+    return_if_error(r, "Convert public key");
+
+    iesys_crypto_pkey_free_internal(&cache->entry[victim].pkey);
+    cache->entry[victim].name = *name;
+    cache->entry[victim].pkey = *pkey;
+    cache->entry[victim].lastUse = cache->clock;
+    return TSS2_RC_SUCCESS;
+}
+#endif /* iesys_crypto_pkey_load_internal */
+
+/** Encryption of a buffer using a public (RSA) key with a key cache.
+ *
+ * Converting the public key of the tpmKey for the crypto library is a
+ * considerable part of the cost of a salted session. With the built-in
+ * backends the converted keys are therefore kept in a cache, identified by the
+ * name of the key. User supplied callbacks are called directly.
+ * @param[in,out] cache The cache of converted keys.
+ * @param[in] name The name of the key (a name of size 0 bypasses the cache).
+ * @param[in] pub_tpm_key The key to be used for encryption.
+ * @param[in] in_size The size of the buffer to be encrypted.
+ * @param[in] in_buffer The data buffer to be encrypted.
+ * @param[in] max_out_size The maximum size for the output encrypted buffer.
+ * @param[out] out_buffer The encrypted buffer.
+ * @param[out] out_size The size of the encrypted output.
+ * @param[in] label The label used in the encryption scheme.
+ * @retval TSS2_RC_SUCCESS on success
+ * @retval TSS2_ESYS_RC_BAD_VALUE The algorithm of key is not implemented.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE The internal crypto engine failed.
+ */
+TSS2_RC
+iesys_crypto_rsa_pk_encrypt_cached(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                                   IESYS_PKEY_CACHE      *cache,
+                                   const TPM2B_NAME      *name,
+                                   TPM2B_PUBLIC          *pub_tpm_key,
+                                   size_t                 in_size,
+                                   BYTE                  *in_buffer,
+                                   size_t                 max_out_size,
+                                   BYTE                  *out_buffer,
+                                   size_t                *out_size,
+                                   const char            *label) {
+#ifdef iesys_crypto_pkey_load_internal
+    if (cache != NULL && name != NULL && name->size > 0
+        && crypto_cb->rsa_pk_encrypt == iesys_crypto_rsa_pk_encrypt_internal) {
+        IESYS_CRYPTO_PKEY_BLOB *pkey;
+        TSS2_RC                 r = pkey_cache_lookup(cache, name, pub_tpm_key, &pkey);
+        return_if_error(r, "Get public key");
+
+        return iesys_crypto_pk_encrypt_pkey_internal(pkey, pub_tpm_key, in_size, in_buffer,
+                                                     max_out_size, out_buffer, out_size, label);
+    }
+#else
+    UNUSED(cache);
+    UNUSED(name);
+#endif
+    return iesys_crypto_rsa_pk_encrypt(crypto_cb, pub_tpm_key, in_size, in_buffer, max_out_size,
+                                       out_buffer, out_size, label);
+}
+
+/** Computation of ephemeral ECC key and shared secret Z with a key cache.
+ *
+ * The converted public key of the tpmKey is taken from a cache like in
+ * iesys_crypto_rsa_pk_encrypt_cached().
+ * @param[in,out] cache The cache of converted keys.
+ * @param[in] name The name of the key (a name of size 0 bypasses the cache).
+ * @param[in] key The key to be used for ECDH key exchange.
+ * @param[in] max_out_size the max size for the output of the public key of the
+ *            computed ephemeral key.
+ * @param[out] Z The computed shared secret.
+ * @param[out] Q The public part of the ephemeral key in TPM format.
+ * @param[out] out_buffer The public part of the ephemeral key will be marshaled
+ *             to this buffer.
+ * @param[out] out_size The size of the marshaled output.
+ * @retval TSS2_RC_SUCCESS on success
+ * @retval TSS2_ESYS_RC_NOT_IMPLEMENTED The curve of key is not implemented.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE The internal crypto engine failed.
+ */
+TSS2_RC
+iesys_crypto_get_ecdh_point_cached(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                                   IESYS_PKEY_CACHE      *cache,
+                                   const TPM2B_NAME      *name,
+                                   TPM2B_PUBLIC          *key,
+                                   size_t                 max_out_size,
+                                   TPM2B_ECC_PARAMETER   *Z,
+                                   TPMS_ECC_POINT        *Q,
+                                   BYTE                  *out_buffer,
+                                   size_t                *out_size) {
+#ifdef iesys_crypto_pkey_load_internal
+    if (cache != NULL && name != NULL && name->size > 0
+        && crypto_cb->get_ecdh_point == iesys_crypto_get_ecdh_point_internal) {
+        IESYS_CRYPTO_PKEY_BLOB *pkey;
+        TSS2_RC                 r = pkey_cache_lookup(cache, name, key, &pkey);
+        return_if_error(r, "Get public key");
+
+        return iesys_crypto_get_ecdh_point_pkey_internal(pkey, max_out_size, Z, Q, out_buffer,
+                                                         out_size);
+    }
+#else
+    UNUSED(cache);
+    UNUSED(name);
+#endif
+    return iesys_crypto_get_ecdh_point(crypto_cb, key, max_out_size, Z, Q, out_buffer, out_size);
+}
+
+/** Release all converted public keys of a cache.
+ *
+ * @param[in,out] cache The cache of converted keys.
+ */
+void
+iesys_crypto_pkey_cache_clear(IESYS_PKEY_CACHE *cache) {
+#ifdef iesys_crypto_pkey_free_internal
+    for (size_t i = 0; i < IESYS_PKEY_CACHE_SIZE; i++)
+        iesys_crypto_pkey_free_internal(&cache->entry[i].pkey);
+#endif
+    memset(cache, 0, sizeof(*cache));
+}
+
 TSS2_RC
 iesys_crypto_aes_encrypt(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                          uint8_t               *key,
@@ -324,6 +621,7 @@ error:
  * decryption nonce, the command parameter hash, and the session attributes the
  * HMAC used for authorization is computed.
  * @param[in] alg The hash algorithm used for HMAC computation.
+ * @param[in,out] keyCache Cache of the keyed HMAC state for hmacKey (may be NULL).
  * @param[in] hmacKey The HMAC key byte buffer.
  * @param[in] hmacKeySize The size of the HMAC key byte buffer.
  * @param[in] pHash The command parameter hash byte buffer.
@@ -340,6 +638,7 @@ error:
  */
 TSS2_RC
 iesys_crypto_authHmac(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                      IESYS_HMAC_KEY_CACHE  *keyCache,
                       TPM2_ALG_ID            alg,
                       uint8_t               *hmacKey,
                       size_t                 hmacKeySize,
@@ -363,7 +662,8 @@ iesys_crypto_authHmac(ESYS_CRYPTO_CALLBACKS *crypto_cb,
 
     ESYS_CRYPTO_CONTEXT_BLOB *cryptoContext;
 
-    TSS2_RC r = iesys_crypto_hmac_start(crypto_cb, &cryptoContext, alg, hmacKey, hmacKeySize);
+    TSS2_RC r = iesys_crypto_hmac_start_cached(crypto_cb, keyCache, &cryptoContext, alg, hmacKey,
+                                               hmacKeySize);
     return_if_error(r, "Error");
 
     r = iesys_crypto_hmac_update(crypto_cb, cryptoContext, pHash, pHash_size);
@@ -407,6 +707,7 @@ error:
  *
  * Except of ECDH this function is used for key derivation.
  * @param[in] alg The algorithm used for the HMAC.
+ * @param[in,out] keyCache Cache of the keyed HMAC state for hmacKey (may be NULL).
  * @param[in] hmacKey The hmacKey used in KDFa.
  * @param[in] hmacKeySize The size of the HMAC key.
  * @param[in] counter The curren iteration step.
@@ -421,6 +722,7 @@ error:
  */
 TSS2_RC
 iesys_crypto_KDFaHmac(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                      IESYS_HMAC_KEY_CACHE  *keyCache,
                       TPM2_ALG_ID            alg,
                       uint8_t               *hmacKey,
                       size_t                 hmacKeySize,
@@ -442,7 +744,8 @@ iesys_crypto_KDFaHmac(ESYS_CRYPTO_CALLBACKS *crypto_cb,
 
     ESYS_CRYPTO_CONTEXT_BLOB *cryptoContext;
 
-    TSS2_RC r = iesys_crypto_hmac_start(crypto_cb, &cryptoContext, alg, hmacKey, hmacKeySize);
+    TSS2_RC r = iesys_crypto_hmac_start_cached(crypto_cb, keyCache, &cryptoContext, alg, hmacKey,
+                                               hmacKeySize);
     return_if_error(r, "Error");
 
     r = Tss2_MU_UINT32_Marshal(counter, &buffer32[0], sizeof(UINT32), &buffer32_size);
@@ -483,6 +786,7 @@ error:
  *
  * Except of ECDH this function is used for key derivation.
  * @param[in] hashAlg The hash algorithm to use.
+ * @param[in,out] keyCache Cache of the keyed HMAC state for hmacKey (may be NULL).
  * @param[in] hmacKey The hmacKey used in KDFa.
  * @param[in] hmacKeySize The size of the HMAC key.
  * @param[in] label Indicates the use of the produced key.
@@ -501,6 +805,7 @@ error:
  */
 TSS2_RC
 iesys_crypto_KDFa(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                  IESYS_HMAC_KEY_CACHE  *keyCache,
                   TPM2_ALG_ID            hashAlg,
                   uint8_t               *hmacKey,
                   size_t                 hmacKeySize,
@@ -533,8 +838,8 @@ iesys_crypto_KDFa(ESYS_CRYPTO_CALLBACKS *crypto_cb,
     for (;; subKey = &subKey[hlen], bytes = bytes - hlen) {
         LOG_TRACE("IESYS KDFa hmac key bytes: %zu", bytes);
         counter++;
-        r = iesys_crypto_KDFaHmac(crypto_cb, hashAlg, hmacKey, hmacKeySize, counter, label,
-                                  contextU, contextV, bitLength, &subKey[0], &hlen);
+        r = iesys_crypto_KDFaHmac(crypto_cb, keyCache, hashAlg, hmacKey, hmacKeySize, counter,
+                                  label, contextU, contextV, bitLength, &subKey[0], &hlen);
         return_if_error(r, "Error");
 
         if (bytes <= hlen) {
@@ -646,12 +951,150 @@ error:
     return r;
 }
 
+/** Start a KDFa key stream.
+ *
+ * Prepares the computation of the KDFa blocks K(i) for the counter values
+ * i = 1, 2, ... with the same key, label, contexts and bit length. The HMAC
+ * key is only applied once; every block starts from a copy of the keyed state
+ * if the backend supports it.
+ * @param[out] stream The stream to initialize.
+ * @param[in] keyCache Cache of the keyed HMAC state for key (may be NULL).
+ * @param[in] hashAlg The hash algorithm to use.
+ * @param[in] key The HMAC key; has to stay valid until the stream is done.
+ * @param[in] keySize The size of the HMAC key.
+ * @param[in] label Indicates the use of the produced key.
+ * @param[in] contextU, contextV are used for construction of a binary string
+ *            containing information related to the derived key.
+ * @param[in] bitLength The size of the generated key stream in bits.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE for invalid parameters.
+ * @retval TSS2_ESYS_RC_BAD_VALUE if hashAlg is unknown or label or a context is
+ *         too long.
+ */
+TSS2_RC
+iesys_crypto_KDFa_stream_init(IESYS_KDFA_STREAM     *stream,
+                              ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                              IESYS_HMAC_KEY_CACHE  *keyCache,
+                              TPM2_ALG_ID            hashAlg,
+                              const uint8_t         *key,
+                              size_t                 keySize,
+                              const char            *label,
+                              const TPM2B_NONCE     *contextU,
+                              const TPM2B_NONCE     *contextV,
+                              uint32_t               bitLength) {
+    TSS2_RC r;
+    size_t  labelSize = label != NULL ? strlen(label) + 1 : 0;
+
+    if (key == NULL || contextU == NULL || contextV == NULL) {
+        LOG_ERROR("Null-Pointer passed");
+        return TSS2_ESYS_RC_BAD_REFERENCE;
+    }
+    if (labelSize > IESYS_KDFA_LABEL_MAX || contextU->size > sizeof(TPMU_HA)
+        || contextV->size > sizeof(TPMU_HA)) {
+        LOG_ERROR("KDFa label or context too long");
+        return TSS2_ESYS_RC_BAD_VALUE;
+    }
+
+    r = iesys_crypto_hash_get_digest_size(hashAlg, &stream->digestSize);
+    return_if_error(r, "Hash alg not supported");
+
+    stream->crypto_cb = crypto_cb;
+    stream->localCache.context = NULL;
+    stream->localCache.hashAlg = TPM2_ALG_ERROR;
+    stream->localCache.size = 0;
+    stream->keyCache = keyCache != NULL ? keyCache : &stream->localCache;
+    stream->hashAlg = hashAlg;
+    stream->key = key;
+    stream->keySize = keySize;
+    stream->counter = 0;
+
+    stream->fixedSize = 0;
+    if (labelSize > 0)
+        memcpy(&stream->fixed[0], label, labelSize);
+    stream->fixedSize += labelSize;
+    memcpy(&stream->fixed[stream->fixedSize], &contextU->buffer[0], contextU->size);
+    stream->fixedSize += contextU->size;
+    memcpy(&stream->fixed[stream->fixedSize], &contextV->buffer[0], contextV->size);
+    stream->fixedSize += contextV->size;
+    r = Tss2_MU_UINT32_Marshal(bitLength, &stream->fixed[0], sizeof(stream->fixed),
+                               &stream->fixedSize);
+    return_if_error(r, "Marshaling");
+
+    return TSS2_RC_SUCCESS;
+}
+
+/** Compute the next block of a KDFa key stream.
+ *
+ * @param[in,out] stream The key stream.
+ * @param[out] out Buffer for stream->digestSize bytes (caller-allocated).
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE for errors of the crypto library.
+ */
+TSS2_RC
+iesys_crypto_KDFa_stream_next(IESYS_KDFA_STREAM *stream, BYTE *out) {
+    ESYS_CRYPTO_CONTEXT_BLOB *cryptoContext;
+    uint8_t                   buffer32[sizeof(uint32_t)];
+    size_t                    buffer32_size = 0;
+    size_t                    size = stream->digestSize;
+    TSS2_RC                   r;
+
+    r = iesys_crypto_hmac_start_cached(stream->crypto_cb, stream->keyCache, &cryptoContext,
+                                       stream->hashAlg, stream->key, stream->keySize);
+    return_if_error(r, "Error");
+
+    stream->counter++;
+    r = Tss2_MU_UINT32_Marshal(stream->counter, &buffer32[0], sizeof(buffer32), &buffer32_size);
+    goto_if_error(r, "Marshaling", error);
+    r = iesys_crypto_hmac_update(stream->crypto_cb, cryptoContext, &buffer32[0], buffer32_size);
+    goto_if_error(r, "HMAC-Update", error);
+    r = iesys_crypto_hmac_update(stream->crypto_cb, cryptoContext, &stream->fixed[0],
+                                 stream->fixedSize);
+    goto_if_error(r, "HMAC-Update", error);
+
+    r = iesys_crypto_hmac_finish(stream->crypto_cb, &cryptoContext, out, &size);
+    goto_if_error(r, "HMAC-Finish", error);
+    return TSS2_RC_SUCCESS;
+
+error:
+    iesys_crypto_hmac_abort(stream->crypto_cb, &cryptoContext);
+    return r;
+}
+
+/** Release a KDFa key stream.
+ *
+ * Releases the keyed HMAC state unless it belongs to the cache of the caller.
+ * @param[in,out] stream The key stream.
+ */
+void
+iesys_crypto_KDFa_stream_done(IESYS_KDFA_STREAM *stream) {
+    iesys_crypto_hmac_cache_clear(stream->crypto_cb, &stream->localCache);
+    wipe(&stream->fixed[0], sizeof(stream->fixed));
+}
+
+/** XOR a block of data with a block of key stream. */
+static void
+xor_block(BYTE *data, const BYTE *stream, size_t size) {
+    size_t i = 0;
+
+    /* Word-wide, the compiler may use vector instructions */
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t d, s;
+        memcpy(&d, &data[i], sizeof(d));
+        memcpy(&s, &stream[i], sizeof(s));
+        d ^= s;
+        memcpy(&data[i], &d, sizeof(d));
+    }
+    for (; i < size; i++)
+        data[i] ^= stream[i];
+}
+
 /** Encryption/Decryption using XOR obfuscation.
  *
  * The application of this function to data encrypted with this function will
  * produce the origin data. The key for XOR obfuscation will be derived with
  * KDFa form the passed key the session nonces, and the hash algorithm.
  * @param[in] hash_alg The algorithm used for key derivation.
+ * @param[in,out] keyCache Cache of the keyed HMAC state for key (may be NULL).
  * @param[in] key key used for obfuscation
  * @param[in] key_size Key size in bits.
  * @param[in] contextU, contextV are used for construction of a binary string
@@ -664,6 +1107,7 @@ error:
  */
 TSS2_RC
 iesys_xor_parameter_obfuscation(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                                IESYS_HMAC_KEY_CACHE  *keyCache,
                                 TPM2_ALG_ID            hash_alg,
                                 uint8_t               *key,
                                 size_t                 key_size,
@@ -671,35 +1115,33 @@ iesys_xor_parameter_obfuscation(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                                 TPM2B_NONCE           *contextV,
                                 BYTE                  *data,
                                 size_t                 data_size) {
-    TSS2_RC          r;
-    uint32_t         counter = 0;
-    BYTE             kdfa_result[TPM2_MAX_DIGEST_BUFFER];
-    size_t           digest_size;
-    size_t           data_size_bits = data_size * 8;
-    size_t           rest_size = data_size;
-    BYTE            *kdfa_byte_ptr;
-    BYTE *data_start MAYBE_UNUSED = data;
+    TSS2_RC           r;
+    IESYS_KDFA_STREAM stream;
+    BYTE              kdfa_result[TPM2_MAX_DIGEST_BUFFER];
+    size_t            offset, size;
 
     if (key == NULL || data == NULL) {
         LOG_ERROR("Bad reference");
         return TSS2_ESYS_RC_BAD_REFERENCE;
     }
 
-    r = iesys_crypto_hash_get_digest_size(hash_alg, &digest_size);
-    return_if_error(r, "Hash alg not supported");
-    while (rest_size > 0) {
-        r = iesys_crypto_KDFa(crypto_cb, hash_alg, key, key_size, "XOR", contextU, contextV,
-                              data_size_bits, &counter, kdfa_result, TRUE);
-        return_if_error(r, "iesys_crypto_KDFa failed");
-        /* XOR next data sub block with KDFa result  */
-        kdfa_byte_ptr = kdfa_result;
-        LOGBLOB_TRACE(data_start, data_size, "Parameter data before XOR");
-        for (size_t i = digest_size < rest_size ? digest_size : rest_size; i > 0; i--)
-            *data++ ^= *kdfa_byte_ptr++;
-        LOGBLOB_TRACE(data_start, data_size, "Parameter data after XOR");
-        rest_size = rest_size < digest_size ? 0 : rest_size - digest_size;
+    r = iesys_crypto_KDFa_stream_init(&stream, crypto_cb, keyCache, hash_alg, key, key_size,
+                                      "XOR", contextU, contextV, (uint32_t)(data_size * 8));
+    return_if_error(r, "KDFa stream");
+
+    LOGBLOB_TRACE(data, data_size, "Parameter data before XOR");
+    for (offset = 0; offset < data_size; offset += size) {
+        r = iesys_crypto_KDFa_stream_next(&stream, &kdfa_result[0]);
+        goto_if_error(r, "KDFa stream", cleanup);
+        size = data_size - offset < stream.digestSize ? data_size - offset : stream.digestSize;
+        xor_block(&data[offset], &kdfa_result[0], size);
     }
-    return TSS2_RC_SUCCESS;
+    LOGBLOB_TRACE(data, data_size, "Parameter data after XOR");
+
+cleanup:
+    wipe(&kdfa_result[0], sizeof(kdfa_result));
+    iesys_crypto_KDFa_stream_done(&stream);
+    return r;
 }
 
 #define TEST_AND_SET_CALLBACK(crypto_cb, callbacks, fn)                                            \
@@ -787,3 +1229,21 @@ iesys_initialize_crypto_backend(ESYS_CRYPTO_CALLBACKS *crypto_cb, ESYS_CRYPTO_CA
 
     return crypto_cb->init ? crypto_cb->init(crypto_cb->userdata) : TSS2_RC_SUCCESS;
 }
+
+/** Determine the crypto backend used by a set of callbacks.
+ *
+ * @param[in] crypto_cb The callbacks of an ESYS context.
+ * @retval The backend.
+ */
+IESYS_CRYPTO_BACKEND
+iesys_crypto_backend(const ESYS_CRYPTO_CALLBACKS *crypto_cb) {
+#if defined(OSSL)
+    if (crypto_cb->hash_start == iesys_crypto_hash_start_internal)
+        return IESYS_CRYPTO_BACKEND_OSSL;
+#elif defined(MBED)
+    if (crypto_cb->hash_start == iesys_crypto_hash_start_internal)
+        return IESYS_CRYPTO_BACKEND_MBED;
+#endif
+    return crypto_cb->hash_start != NULL ? IESYS_CRYPTO_BACKEND_CALLBACKS
+                                         : IESYS_CRYPTO_BACKEND_NONE;
+}
@@ -13,6 +13,7 @@
 #include <stddef.h> // for size_t, NULL
 #include <stdint.h> // for uint8_t, uint32_t
 
+#include "esys_types.h"      // for IESYS_HMAC_KEY_CACHE, IESYS_RANDOM_POOL
 #include "tss2_common.h"     // for TSS2_RC, BYTE, BOOL, UINT32
 #include "tss2_esys.h"       // for ESYS_CRYPTO_CALLBACKS, ESYS_CRYPTO_CONT...
 #include "tss2_tpm2_types.h" // for TPM2_ALG_ID, TPM2B_NONCE, TPM2B_ECC_PAR...
@@ -127,9 +128,28 @@ TSS2_RC iesys_crypto_hmac_finish(ESYS_CRYPTO_CALLBACKS     *crypto_cb,
 TSS2_RC iesys_crypto_hmac_abort(ESYS_CRYPTO_CALLBACKS     *crypto_cb,
                                 ESYS_CRYPTO_CONTEXT_BLOB **context);
 
+TSS2_RC iesys_crypto_hmac_start_cached(ESYS_CRYPTO_CALLBACKS     *crypto_cb,
+                                       IESYS_HMAC_KEY_CACHE      *keyCache,
+                                       ESYS_CRYPTO_CONTEXT_BLOB **context,
+                                       TPM2_ALG_ID                hashAlg,
+                                       const uint8_t             *key,
+                                       size_t                     size);
+
+void iesys_crypto_hmac_cache_invalidate(IESYS_HMAC_KEY_CACHE *keyCache);
+
+void iesys_crypto_hmac_cache_clear(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                                   IESYS_HMAC_KEY_CACHE  *keyCache);
+
 TSS2_RC
 iesys_crypto_get_random2b(ESYS_CRYPTO_CALLBACKS *crypto_cb, TPM2B_NONCE *nonce, size_t num_bytes);
 
+TSS2_RC iesys_crypto_get_random2b_pooled(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                                         IESYS_RANDOM_POOL     *pool,
+                                         TPM2B_NONCE           *nonce,
+                                         size_t                 num_bytes);
+
+void iesys_crypto_random_pool_clear(IESYS_RANDOM_POOL *pool);
+
 TSS2_RC iesys_crypto_get_ecdh_point(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                                     TPM2B_PUBLIC          *key,
                                     size_t                 max_out_size,
@@ -138,6 +158,29 @@ TSS2_RC iesys_crypto_get_ecdh_point(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                                     BYTE                  *out_buffer,
                                     size_t                *out_size);
 
+TSS2_RC iesys_crypto_rsa_pk_encrypt_cached(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                                           IESYS_PKEY_CACHE      *cache,
+                                           const TPM2B_NAME      *name,
+                                           TPM2B_PUBLIC          *pub_tpm_key,
+                                           size_t                 in_size,
+                                           BYTE                  *in_buffer,
+                                           size_t                 max_out_size,
+                                           BYTE                  *out_buffer,
+                                           size_t                *out_size,
+                                           const char            *label);
+
+TSS2_RC iesys_crypto_get_ecdh_point_cached(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                                           IESYS_PKEY_CACHE      *cache,
+                                           const TPM2B_NAME      *name,
+                                           TPM2B_PUBLIC          *key,
+                                           size_t                 max_out_size,
+                                           TPM2B_ECC_PARAMETER   *Z,
+                                           TPMS_ECC_POINT        *Q,
+                                           BYTE                  *out_buffer,
+                                           size_t                *out_size);
+
+void iesys_crypto_pkey_cache_clear(IESYS_PKEY_CACHE *cache);
+
 TSS2_RC iesys_crypto_aes_encrypt(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                                  uint8_t               *key,
                                  TPM2_ALG_ID            tpm_sym_alg,
@@ -175,6 +218,7 @@ TSS2_RC iesys_crypto_sm4_decrypt(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                                  uint8_t               *iv);
 
 TSS2_RC iesys_crypto_authHmac(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                              IESYS_HMAC_KEY_CACHE  *keyCache,
                               TPM2_ALG_ID            alg,
                               uint8_t               *hmacKey,
                               size_t                 hmacKeySize,
@@ -188,6 +232,7 @@ TSS2_RC iesys_crypto_authHmac(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                               TPM2B_AUTH            *hmac);
 
 TSS2_RC iesys_crypto_KDFaHmac(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                              IESYS_HMAC_KEY_CACHE  *keyCache,
                               TPM2_ALG_ID            alg,
                               uint8_t               *hmacKey,
                               size_t                 hmacKeySize,
@@ -200,6 +245,7 @@ TSS2_RC iesys_crypto_KDFaHmac(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                               size_t                *hmacSize);
 
 TSS2_RC iesys_crypto_KDFa(ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                          IESYS_HMAC_KEY_CACHE  *keyCache,
                           TPM2_ALG_ID            hashAlg,
                           uint8_t               *hmacKey,
                           size_t                 hmacKeySize,
@@ -211,7 +257,46 @@ TSS2_RC iesys_crypto_KDFa(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                           BYTE                  *outKey,
                           BOOL                   use_digest_size);
 
+/** Maximum length of a KDFa label including the terminating zero */
+#define IESYS_KDFA_LABEL_MAX 32
+/** Maximum size of the part of the KDFa HMAC input following the counter */
+#define IESYS_KDFA_FIXED_MAX (IESYS_KDFA_LABEL_MAX + 2 * sizeof(TPMU_HA) + sizeof(UINT32))
+
+/** State of a KDFa key stream
+ *
+ * The label, contexts and bit length are marshaled once and the keyed HMAC
+ * state is reused for every counter value.
+ */
+typedef struct {
+    ESYS_CRYPTO_CALLBACKS *crypto_cb;                   /**< The crypto backend */
+    IESYS_HMAC_KEY_CACHE  *keyCache;                    /**< Keyed HMAC state for key */
+    IESYS_HMAC_KEY_CACHE   localCache;                  /**< Used if the caller has no cache */
+    TPM2_ALG_ID            hashAlg;                     /**< The hash algorithm of the HMAC */
+    const uint8_t         *key;                         /**< The HMAC key */
+    size_t                 keySize;                     /**< The size of key */
+    size_t                 digestSize;                  /**< Bytes produced per counter value */
+    uint32_t               counter;                     /**< The last counter value used */
+    BYTE                   fixed[IESYS_KDFA_FIXED_MAX]; /**< label, contextU, contextV, bitLength */
+    size_t                 fixedSize;                   /**< Bytes used in fixed */
+} IESYS_KDFA_STREAM;
+
+TSS2_RC iesys_crypto_KDFa_stream_init(IESYS_KDFA_STREAM     *stream,
+                                      ESYS_CRYPTO_CALLBACKS *crypto_cb,
+                                      IESYS_HMAC_KEY_CACHE  *keyCache,
+                                      TPM2_ALG_ID            hashAlg,
+                                      const uint8_t         *key,
+                                      size_t                 keySize,
+                                      const char            *label,
+                                      const TPM2B_NONCE     *contextU,
+                                      const TPM2B_NONCE     *contextV,
+                                      uint32_t               bitLength);
+
+TSS2_RC iesys_crypto_KDFa_stream_next(IESYS_KDFA_STREAM *stream, BYTE *out);
+
+void iesys_crypto_KDFa_stream_done(IESYS_KDFA_STREAM *stream);
+
 TSS2_RC iesys_xor_parameter_obfuscation(ESYS_CRYPTO_CALLBACKS *cryto_cb,
+                                        IESYS_HMAC_KEY_CACHE  *keyCache,
                                         TPM2_ALG_ID            hash_alg,
                                         uint8_t               *key,
                                         size_t                 key_size,
@@ -232,6 +317,16 @@ TSS2_RC iesys_crypto_KDFe(ESYS_CRYPTO_CALLBACKS *crypto_cb,
 TSS2_RC iesys_initialize_crypto_backend(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                                         ESYS_CRYPTO_CALLBACKS *user_cb);
 
+/** The crypto backend of an ESYS context */
+typedef enum {
+    IESYS_CRYPTO_BACKEND_NONE = 0,     /**< No backend, built without crypto library */
+    IESYS_CRYPTO_BACKEND_OSSL = 1,     /**< The built-in OpenSSL backend */
+    IESYS_CRYPTO_BACKEND_MBED = 2,     /**< The built-in mbed TLS backend */
+    IESYS_CRYPTO_BACKEND_CALLBACKS = 3 /**< Set with Esys_SetCryptoCallbacks() */
+} IESYS_CRYPTO_BACKEND;
+
+IESYS_CRYPTO_BACKEND iesys_crypto_backend(const ESYS_CRYPTO_CALLBACKS *crypto_cb);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
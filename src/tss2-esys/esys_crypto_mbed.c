@@ -447,8 +447,21 @@ iesys_cryptmbed_random2b(TPM2B_NONCE *nonce, size_t num_bytes, void *userdata) {
         nonce->size = num_bytes;
     }
 
-    if (get_random(NULL, &nonce->buffer[0], nonce->size) != 0) {
-        return_error(TSS2_ESYS_RC_GENERAL_FAILURE, "Hash algorithm not supported");
+    return iesys_cryptmbed_random(&nonce->buffer[0], nonce->size);
+}
+
+/** Fill a buffer with random data.
+ *
+ * @param[out] buffer The buffer for the random data (caller-allocated).
+ * @param[in] size The number of bytes to be generated (at most
+ *            MBEDTLS_CTR_DRBG_MAX_REQUEST).
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE for errors of the random number generator.
+ */
+TSS2_RC
+iesys_cryptmbed_random(uint8_t *buffer, size_t size) {
+    if (get_random(NULL, &buffer[0], size) != 0) {
+        return_error(TSS2_ESYS_RC_GENERAL_FAILURE, "Failure in random number generator.");
     }
 
     return TSS2_RC_SUCCESS;
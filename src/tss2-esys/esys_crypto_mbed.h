@@ -58,6 +58,8 @@ void iesys_cryptmbed_hmac_abort(ESYS_CRYPTO_CONTEXT_BLOB **context, void *userda
 
 TSS2_RC iesys_cryptmbed_random2b(TPM2B_NONCE *nonce, size_t num_bytes, void *userdata);
 
+TSS2_RC iesys_cryptmbed_random(uint8_t *buffer, size_t size);
+
 TSS2_RC iesys_cryptmbed_pk_encrypt(TPM2B_PUBLIC *key,
                                    size_t        in_size,
                                    BYTE         *in_buffer,
@@ -96,6 +98,7 @@ TSS2_RC iesys_cryptmbed_get_ecdh_point(TPM2B_PUBLIC        *key,
 TSS2_RC iesys_cryptmbed_init(void *userdata);
 
 #define iesys_crypto_get_random2b_internal   iesys_cryptmbed_random2b
+#define iesys_crypto_get_random_internal     iesys_cryptmbed_random
 #define iesys_crypto_get_ecdh_point_internal iesys_cryptmbed_get_ecdh_point
 #define iesys_crypto_aes_encrypt_internal    iesys_cryptmbed_sym_aes_encrypt
 #define iesys_crypto_aes_decrypt_internal    iesys_cryptmbed_sym_aes_decrypt
@@ -524,6 +524,61 @@ iesys_cryptossl_hmac_abort(ESYS_CRYPTO_CONTEXT_BLOB **context, void *userdata) {
     }
 }
 
+/** Copy a keyed HMAC object.
+ *
+ * The copy continues from the state of context, so a context which was only
+ * keyed yields a fresh HMAC computation without repeating the key setup. With
+ * OpenSSL 3 the copy uses the library context of context, so it has to be
+ * released before context.
+ * @param[in] context The context of the HMAC object to copy.
+ * @param[out] copy The created context (callee-allocated).
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE for invalid parameters.
+ * @retval TSS2_ESYS_RC_MEMORY Memory cannot be allocated.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE for errors of the crypto library.
+ */
+TSS2_RC
+iesys_cryptossl_hmac_dup(ESYS_CRYPTO_CONTEXT_BLOB *context, ESYS_CRYPTO_CONTEXT_BLOB **copy) {
+    TSS2_RC r = TSS2_RC_SUCCESS;
+
+    LOG_TRACE("called for context %p and copy-pointer %p", context, copy);
+    if (context == NULL || copy == NULL) {
+        return_error(TSS2_ESYS_RC_BAD_REFERENCE, "Null-Pointer passed");
+    }
+    IESYS_CRYPTOSSL_CONTEXT *mycontext = (IESYS_CRYPTOSSL_CONTEXT *)context;
+    if (mycontext->type != IESYS_CRYPTOSSL_TYPE_HMAC) {
+        return_error(TSS2_ESYS_RC_BAD_REFERENCE, "bad context");
+    }
+
+    /* Not iesys_cryptossl_context_new(), the copy needs no library context of its own */
+    IESYS_CRYPTOSSL_CONTEXT *mycopy = calloc(1, sizeof(IESYS_CRYPTOSSL_CONTEXT));
+    return_if_null(mycopy, "Out of Memory", TSS2_ESYS_RC_MEMORY);
+
+    mycopy->type = IESYS_CRYPTOSSL_TYPE_HMAC;
+    mycopy->hash.hash_len = mycontext->hash.hash_len;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    if (!EVP_MD_up_ref(mycontext->hash.ossl_hash_alg)) {
+        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "EVP_MD_up_ref", cleanup);
+    }
+#endif
+    mycopy->hash.ossl_hash_alg = mycontext->hash.ossl_hash_alg;
+
+    if (!(mycopy->hash.ossl_context = EVP_MD_CTX_new())) {
+        goto_error(r, TSS2_ESYS_RC_MEMORY, "Out of Memory", cleanup);
+    }
+
+    if (1 != EVP_MD_CTX_copy_ex(mycopy->hash.ossl_context, mycontext->hash.ossl_context)) {
+        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "EVP_MD_CTX_copy_ex", cleanup);
+    }
+
+    *copy = (ESYS_CRYPTO_CONTEXT_BLOB *)mycopy;
+    return TSS2_RC_SUCCESS;
+
+cleanup:
+    iesys_cryptossl_context_free(mycopy);
+    return r;
+}
+
 /** Compute random TPM2B data.
  *
  * The random data will be generated and written to a passed TPM2B structure.
@@ -537,6 +592,27 @@ TSS2_RC
 iesys_cryptossl_random2b(TPM2B_NONCE *nonce, size_t num_bytes, void *userdata) {
     UNUSED(userdata);
 
+    if (num_bytes == 0) {
+        nonce->size = sizeof(nonce->buffer);
+    } else {
+        nonce->size = num_bytes;
+    }
+
+    return iesys_cryptossl_random(&nonce->buffer[0], nonce->size);
+}
+
+/** Fill a buffer with random data.
+ *
+ * @param[out] buffer The buffer for the random data (caller-allocated).
+ * @param[in] size The number of bytes to be generated.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_MEMORY Memory cannot be allocated.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE for errors of the random number generator.
+ *
+ * NOTE: the TPM should not be used to obtain the random data
+ */
+TSS2_RC
+iesys_cryptossl_random(uint8_t *buffer, size_t size) {
     int rc;
 #if OPENSSL_VERSION_NUMBER < 0x30000000L
     const RAND_METHOD *rand_save = RAND_get_rand_method();
@@ -547,17 +623,11 @@ iesys_cryptossl_random2b(TPM2B_NONCE *nonce, size_t num_bytes, void *userdata) {
         return TSS2_ESYS_RC_MEMORY;
 #endif
 
-    if (num_bytes == 0) {
-        nonce->size = sizeof(nonce->buffer);
-    } else {
-        nonce->size = num_bytes;
-    }
-
 #if OPENSSL_VERSION_NUMBER < 0x30000000L
-    rc = RAND_bytes(&nonce->buffer[0], nonce->size);
+    rc = RAND_bytes(&buffer[0], size);
     RAND_set_rand_method(rand_save);
 #else
-    rc = RAND_bytes_ex(libctx, &nonce->buffer[0], nonce->size, 0);
+    rc = RAND_bytes_ex(libctx, &buffer[0], size, 0);
     OSSL_LIB_CTX_free(libctx);
 #endif
     if (rc != 1)
@@ -565,80 +635,38 @@ iesys_cryptossl_random2b(TPM2B_NONCE *nonce, size_t num_bytes, void *userdata) {
     return TSS2_RC_SUCCESS;
 }
 
-/** Encryption of a buffer using a public (RSA) key.
+/** Public key of a TPM key converted for use with OpenSSL */
+typedef struct IESYS_CRYPTO_PKEY_BLOB {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    OSSL_LIB_CTX *libctx; /**< Own library context of the key */
+#endif
+    EVP_PKEY *rsa_key;   /**< The key (RSA keys) */
+    EC_GROUP *group;     /**< The curve of the key (ECC keys) */
+    EC_POINT *ecc_point; /**< The public point of the key (ECC keys) */
+    int       curveId;   /**< OpenSSL NID of the curve (ECC keys) */
+    size_t    key_size;  /**< Size of a coordinate of the curve (ECC keys) */
+} IESYS_CRYPTOSSL_PKEY;
+
+/** Computation of an OSSL RSA key from a TPM public key.
  *
- * Encrypting a buffer using a public key is used for example during
- * Esys_StartAuthSession in order to encrypt the salt value.
- * @param[in] pub_tpm_key The key to be used for encryption.
- * @param[in] in_size The size of the buffer to be encrypted.
- * @param[in] in_buffer The data buffer to be encrypted.
- * @param[in] max_out_size The maximum size for the output encrypted buffer.
- * @param[out] out_buffer The encrypted buffer.
- * @param[out] out_size The size of the encrypted output.
- * @param[in] label The label used in the encryption scheme.
- * @retval TSS2_RC_SUCCESS on success
- * @retval TSS2_ESYS_RC_BAD_VALUE The algorithm of key is not implemented.
+ * @param[in,out] pkey The converted key receiving the RSA key.
+ * @param[in] pub_tpm_key The TPM public key.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_MEMORY Memory cannot be allocated.
  * @retval TSS2_ESYS_RC_GENERAL_FAILURE The internal crypto engine failed.
  */
-TSS2_RC
-iesys_cryptossl_pk_encrypt(TPM2B_PUBLIC *pub_tpm_key,
-                           size_t        in_size,
-                           BYTE         *in_buffer,
-                           size_t        max_out_size,
-                           BYTE         *out_buffer,
-                           size_t       *out_size,
-                           const char   *label,
-                           void         *userdata) {
-    UNUSED(userdata);
-
+static TSS2_RC
+tpm_pub_to_ossl_rsa(IESYS_CRYPTOSSL_PKEY *pkey, TPM2B_PUBLIC *pub_tpm_key) {
 #if OPENSSL_VERSION_NUMBER < 0x30000000L
-    RSA               *rsa_key = NULL;
-    const EVP_MD      *hashAlg = NULL;
-    const RAND_METHOD *rand_save = RAND_get_rand_method();
-
-    RAND_set_rand_method(RAND_OpenSSL());
+    RSA *rsa_key = NULL;
 #else
-    OSSL_LIB_CTX   *libctx = NULL;
-    EVP_MD         *hashAlg = NULL;
     OSSL_PARAM     *params = NULL;
     OSSL_PARAM_BLD *build = NULL;
 #endif
 
     TSS2_RC       r = TSS2_RC_SUCCESS;
-    EVP_PKEY     *evp_rsa_key = NULL;
-    EVP_PKEY_CTX *genctx = NULL, *ctx = NULL;
+    EVP_PKEY_CTX *genctx = NULL;
     BIGNUM       *bne = NULL, *n = NULL;
-    int           padding;
-    char         *label_copy = NULL;
-
-#if OPENSSL_VERSION_NUMBER < 0x30000000L
-    if (!(hashAlg = get_ossl_hash_md(pub_tpm_key->publicArea.nameAlg))) {
-        RAND_set_rand_method(rand_save);
-#else
-    if (!(libctx = OSSL_LIB_CTX_new()))
-        return TSS2_ESYS_RC_MEMORY;
-
-    if (!(hashAlg
-          = EVP_MD_fetch(libctx, get_ossl_hash_md(pub_tpm_key->publicArea.nameAlg), NULL))) {
-        OSSL_LIB_CTX_free(libctx);
-#endif
-        LOG_ERROR("Unsupported hash algorithm (%" PRIu16 ")", pub_tpm_key->publicArea.nameAlg);
-        return TSS2_ESYS_RC_NOT_IMPLEMENTED;
-    }
-
-    switch (pub_tpm_key->publicArea.parameters.rsaDetail.scheme.scheme) {
-    case TPM2_ALG_NULL:
-        padding = RSA_NO_PADDING;
-        break;
-    case TPM2_ALG_RSAES:
-        padding = RSA_PKCS1_PADDING;
-        break;
-    case TPM2_ALG_OAEP:
-        padding = RSA_PKCS1_OAEP_PADDING;
-        break;
-    default:
-        goto_error(r, TSS2_ESYS_RC_BAD_VALUE, "Illegal RSA scheme", cleanup);
-    }
 
     UINT32 exp;
     if (pub_tpm_key->publicArea.parameters.rsaDetail.exponent == 0)
@@ -670,11 +698,11 @@ iesys_cryptossl_pk_encrypt(TPM2B_PUBLIC *pub_tpm_key,
     n = NULL;
     bne = NULL;
 
-    if (!(evp_rsa_key = EVP_PKEY_new())) {
+    if (!(pkey->rsa_key = EVP_PKEY_new())) {
         goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not create evp key.", cleanup);
     }
 
-    if (1 != EVP_PKEY_assign_RSA(evp_rsa_key, rsa_key)) {
+    if (1 != EVP_PKEY_assign_RSA(pkey->rsa_key, rsa_key)) {
         goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not set rsa key.", cleanup);
     }
     /* ownership got transferred */
@@ -687,69 +715,22 @@ iesys_cryptossl_pk_encrypt(TPM2B_PUBLIC *pub_tpm_key,
         goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not create rsa parameters.", cleanup);
     }
 
-    if ((genctx = EVP_PKEY_CTX_new_from_name(libctx, "RSA", NULL)) == NULL
+    if ((genctx = EVP_PKEY_CTX_new_from_name(pkey->libctx, "RSA", NULL)) == NULL
         || EVP_PKEY_fromdata_init(genctx) <= 0
-        || EVP_PKEY_fromdata(genctx, &evp_rsa_key, EVP_PKEY_PUBLIC_KEY, params) <= 0) {
+        || EVP_PKEY_fromdata(genctx, &pkey->rsa_key, EVP_PKEY_PUBLIC_KEY, params) <= 0) {
         goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not create rsa key.", cleanup);
     }
 #endif /* OPENSSL_VERSION_NUMBER < 0x30000000L */
 
-    if (!(ctx = EVP_PKEY_CTX_new(evp_rsa_key, NULL))) {
-        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not create evp context.", cleanup);
-    }
-
-    if (1 != EVP_PKEY_encrypt_init(ctx)) {
-        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not init encrypt context.", cleanup);
-    }
-
-    if (1 != EVP_PKEY_CTX_set_rsa_padding(ctx, padding)) {
-        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not set RSA passing.", cleanup);
-    }
-
-    label_copy = OPENSSL_strdup(label);
-    if (!label_copy) {
-        goto_error(r, TSS2_ESYS_RC_MEMORY, "Could not duplicate OAEP label", cleanup);
-    }
-
-    if (1 != EVP_PKEY_CTX_set0_rsa_oaep_label(ctx, label_copy, (int)strlen(label_copy) + 1)) {
-        OPENSSL_free(label_copy);
-        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not set RSA label.", cleanup);
-    }
-
-    if (1 != EVP_PKEY_CTX_set_rsa_oaep_md(ctx, hashAlg)) {
-        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not set hash algorithm.", cleanup);
-    }
-
-    /* Determine out size */
-    if (1 != EVP_PKEY_encrypt(ctx, NULL, out_size, in_buffer, in_size)) {
-        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not determine ciper size.", cleanup);
-    }
-
-    if ((size_t)*out_size > max_out_size) {
-        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Encrypted data too big", cleanup);
-    }
-
-    /* Encrypt data */
-    if (1 != EVP_PKEY_encrypt(ctx, out_buffer, out_size, in_buffer, in_size)) {
-        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not encrypt data.", cleanup);
-    }
-
-    r = TSS2_RC_SUCCESS;
-
 cleanup:
     OSSL_FREE(genctx, EVP_PKEY_CTX);
-    OSSL_FREE(ctx, EVP_PKEY_CTX);
-    OSSL_FREE(evp_rsa_key, EVP_PKEY);
     OSSL_FREE(bne, BN);
     OSSL_FREE(n, BN);
 #if OPENSSL_VERSION_NUMBER < 0x30000000L
     OSSL_FREE(rsa_key, RSA);
-    RAND_set_rand_method(rand_save);
 #else
     OSSL_FREE(params, OSSL_PARAM);
     OSSL_FREE(build, OSSL_PARAM_BLD);
-    OSSL_FREE(hashAlg, EVP_MD);
-    OSSL_FREE(libctx, OSSL_LIB_CTX);
 #endif
     return r;
 }
@@ -801,12 +782,268 @@ cleanup:
     return r;
 }
 
-/** Computation of ephemeral ECC key and shared secret Z.
+/** Conversion of a TPM public key for repeated use with OpenSSL.
  *
- * According to the description in  TPM spec part 1 C 6.1 a shared secret
- * between application and TPM is computed (ECDH). An ephemeral ECC key and a
- * TPM keyare used for the ECDH key exchange.
- * @param[in] key The key to be used for ECDH key exchange.
+ * Building the OpenSSL objects of a key is a considerable part of encrypting
+ * a salt. The converted key can be kept and passed to
+ * iesys_cryptossl_pk_encrypt_pkey() or iesys_cryptossl_get_ecdh_point_pkey()
+ * for every session salted with the same key.
+ * @param[in] key The TPM public key (RSA or ECC).
+ * @param[out] pkey The converted key (callee-allocated).
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_NOT_IMPLEMENTED The key type or the curve is not implemented.
+ * @retval TSS2_ESYS_RC_MEMORY Memory cannot be allocated.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE The internal crypto engine failed.
+ */
+TSS2_RC
+iesys_cryptossl_pkey_load(TPM2B_PUBLIC *key, IESYS_CRYPTO_PKEY_BLOB **pkey) {
+    TSS2_RC               r = TSS2_RC_SUCCESS;
+    IESYS_CRYPTOSSL_PKEY *new_pkey;
+
+    if (!(new_pkey = calloc(1, sizeof(IESYS_CRYPTOSSL_PKEY))))
+        return_error(TSS2_ESYS_RC_MEMORY, "Out of memory.");
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    if (!(new_pkey->libctx = OSSL_LIB_CTX_new()))
+        goto_error(r, TSS2_ESYS_RC_MEMORY, "Create libctx for public key", error);
+#endif
+
+    switch (key->publicArea.type) {
+    case TPM2_ALG_RSA:
+        r = tpm_pub_to_ossl_rsa(new_pkey, key);
+        goto_if_error(r, "Convert TPM RSA key to ossl key", error);
+        break;
+    case TPM2_ALG_ECC:
+        /* Set ossl constant for curve type and create group for curve */
+        switch (key->publicArea.parameters.eccDetail.curveID) {
+        case TPM2_ECC_NIST_P192:
+            new_pkey->curveId = NID_X9_62_prime192v1;
+            new_pkey->key_size = 24;
+            break;
+        case TPM2_ECC_NIST_P224:
+            new_pkey->curveId = NID_secp224r1;
+            new_pkey->key_size = 28;
+            break;
+        case TPM2_ECC_NIST_P256:
+            new_pkey->curveId = NID_X9_62_prime256v1;
+            new_pkey->key_size = 32;
+            break;
+        case TPM2_ECC_NIST_P384:
+            new_pkey->curveId = NID_secp384r1;
+            new_pkey->key_size = 48;
+            break;
+        case TPM2_ECC_NIST_P521:
+            new_pkey->curveId = NID_secp521r1;
+            new_pkey->key_size = 66;
+            break;
+#ifdef NID_sm2
+        case TPM2_ECC_SM2_P256:
+            new_pkey->curveId = NID_sm2;
+            new_pkey->key_size = 32;
+            break;
+#endif
+        default:
+            goto_error(r, TSS2_ESYS_RC_NOT_IMPLEMENTED, "ECC curve not implemented.", error);
+        }
+
+        if (!(new_pkey->group = EC_GROUP_new_by_curve_name(new_pkey->curveId))) {
+            goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Create group for curve", error);
+        }
+
+        /* Create an OSSL EC point from the TPM public point */
+        r = tpm_pub_to_ossl_pub(new_pkey->group, key, &new_pkey->ecc_point);
+        goto_if_error(r, "Convert TPM pub point to ossl pub point", error);
+        break;
+    default:
+        goto_error(r, TSS2_ESYS_RC_NOT_IMPLEMENTED, "Key type not implemented.", error);
+    }
+
+    *pkey = new_pkey;
+    return TSS2_RC_SUCCESS;
+
+error:
+    iesys_cryptossl_pkey_free(&new_pkey);
+    return r;
+}
+
+/** Release a converted public key.
+ *
+ * @param[in,out] pkey The converted key. Will be set to NULL.
+ */
+void
+iesys_cryptossl_pkey_free(IESYS_CRYPTO_PKEY_BLOB **pkey) {
+    if (pkey == NULL || *pkey == NULL)
+        return;
+
+    OSSL_FREE((*pkey)->rsa_key, EVP_PKEY);
+    OSSL_FREE((*pkey)->ecc_point, EC_POINT);
+    OSSL_FREE((*pkey)->group, EC_GROUP);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    OSSL_FREE((*pkey)->libctx, OSSL_LIB_CTX);
+#endif
+    SAFE_FREE(*pkey);
+}
+
+/** Encryption of a buffer using a converted public (RSA) key.
+ *
+ * @param[in] pkey The key converted by iesys_cryptossl_pkey_load().
+ * @param[in] pub_tpm_key The TPM public key pkey was converted from. Its
+ *            nameAlg and scheme determine the encryption scheme.
+ * @param[in] in_size The size of the buffer to be encrypted.
+ * @param[in] in_buffer The data buffer to be encrypted.
+ * @param[in] max_out_size The maximum size for the output encrypted buffer.
+ * @param[out] out_buffer The encrypted buffer.
+ * @param[out] out_size The size of the encrypted output.
+ * @param[in] label The label used in the encryption scheme.
+ * @retval TSS2_RC_SUCCESS on success
+ * @retval TSS2_ESYS_RC_BAD_VALUE The algorithm of key is not implemented.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE The internal crypto engine failed.
+ */
+TSS2_RC
+iesys_cryptossl_pk_encrypt_pkey(IESYS_CRYPTO_PKEY_BLOB *pkey,
+                                TPM2B_PUBLIC           *pub_tpm_key,
+                                size_t                  in_size,
+                                BYTE                   *in_buffer,
+                                size_t                  max_out_size,
+                                BYTE                   *out_buffer,
+                                size_t                 *out_size,
+                                const char             *label) {
+#if OPENSSL_VERSION_NUMBER < 0x30000000L
+    const EVP_MD      *hashAlg = NULL;
+    const RAND_METHOD *rand_save = RAND_get_rand_method();
+
+    RAND_set_rand_method(RAND_OpenSSL());
+#else
+    EVP_MD *hashAlg = NULL;
+#endif
+
+    TSS2_RC       r = TSS2_RC_SUCCESS;
+    EVP_PKEY_CTX *ctx = NULL;
+    int           padding;
+    char         *label_copy = NULL;
+
+#if OPENSSL_VERSION_NUMBER < 0x30000000L
+    if (!(hashAlg = get_ossl_hash_md(pub_tpm_key->publicArea.nameAlg))) {
+        RAND_set_rand_method(rand_save);
+#else
+    if (!(hashAlg = EVP_MD_fetch(pkey->libctx, get_ossl_hash_md(pub_tpm_key->publicArea.nameAlg),
+                                 NULL))) {
+#endif
+        LOG_ERROR("Unsupported hash algorithm (%" PRIu16 ")", pub_tpm_key->publicArea.nameAlg);
+        return TSS2_ESYS_RC_NOT_IMPLEMENTED;
+    }
+
+    switch (pub_tpm_key->publicArea.parameters.rsaDetail.scheme.scheme) {
+    case TPM2_ALG_NULL:
+        padding = RSA_NO_PADDING;
+        break;
+    case TPM2_ALG_RSAES:
+        padding = RSA_PKCS1_PADDING;
+        break;
+    case TPM2_ALG_OAEP:
+        padding = RSA_PKCS1_OAEP_PADDING;
+        break;
+    default:
+        goto_error(r, TSS2_ESYS_RC_BAD_VALUE, "Illegal RSA scheme", cleanup);
+    }
+
+    if (!pkey->rsa_key) {
+        goto_error(r, TSS2_ESYS_RC_BAD_VALUE, "Key is not an RSA key.", cleanup);
+    }
+
+    if (!(ctx = EVP_PKEY_CTX_new(pkey->rsa_key, NULL))) {
+        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not create evp context.", cleanup);
+    }
+
+    if (1 != EVP_PKEY_encrypt_init(ctx)) {
+        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not init encrypt context.", cleanup);
+    }
+
+    if (1 != EVP_PKEY_CTX_set_rsa_padding(ctx, padding)) {
+        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not set RSA passing.", cleanup);
+    }
+
+    label_copy = OPENSSL_strdup(label);
+    if (!label_copy) {
+        goto_error(r, TSS2_ESYS_RC_MEMORY, "Could not duplicate OAEP label", cleanup);
+    }
+
+    if (1 != EVP_PKEY_CTX_set0_rsa_oaep_label(ctx, label_copy, (int)strlen(label_copy) + 1)) {
+        OPENSSL_free(label_copy);
+        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not set RSA label.", cleanup);
+    }
+
+    if (1 != EVP_PKEY_CTX_set_rsa_oaep_md(ctx, hashAlg)) {
+        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not set hash algorithm.", cleanup);
+    }
+
+    /* Determine out size */
+    if (1 != EVP_PKEY_encrypt(ctx, NULL, out_size, in_buffer, in_size)) {
+        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not determine ciper size.", cleanup);
+    }
+
+    if ((size_t)*out_size > max_out_size) {
+        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Encrypted data too big", cleanup);
+    }
+
+    /* Encrypt data */
+    if (1 != EVP_PKEY_encrypt(ctx, out_buffer, out_size, in_buffer, in_size)) {
+        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Could not encrypt data.", cleanup);
+    }
+
+    r = TSS2_RC_SUCCESS;
+
+cleanup:
+    OSSL_FREE(ctx, EVP_PKEY_CTX);
+#if OPENSSL_VERSION_NUMBER < 0x30000000L
+    RAND_set_rand_method(rand_save);
+#else
+    OSSL_FREE(hashAlg, EVP_MD);
+#endif
+    return r;
+}
+
+/** Encryption of a buffer using a public (RSA) key.
+ *
+ * Encrypting a buffer using a public key is used for example during
+ * Esys_StartAuthSession in order to encrypt the salt value.
+ * @param[in] pub_tpm_key The key to be used for encryption.
+ * @param[in] in_size The size of the buffer to be encrypted.
+ * @param[in] in_buffer The data buffer to be encrypted.
+ * @param[in] max_out_size The maximum size for the output encrypted buffer.
+ * @param[out] out_buffer The encrypted buffer.
+ * @param[out] out_size The size of the encrypted output.
+ * @param[in] label The label used in the encryption scheme.
+ * @retval TSS2_RC_SUCCESS on success
+ * @retval TSS2_ESYS_RC_BAD_VALUE The algorithm of key is not implemented.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE The internal crypto engine failed.
+ */
+TSS2_RC
+iesys_cryptossl_pk_encrypt(TPM2B_PUBLIC *pub_tpm_key,
+                           size_t        in_size,
+                           BYTE         *in_buffer,
+                           size_t        max_out_size,
+                           BYTE         *out_buffer,
+                           size_t       *out_size,
+                           const char   *label,
+                           void         *userdata) {
+    UNUSED(userdata);
+
+    TSS2_RC                 r;
+    IESYS_CRYPTO_PKEY_BLOB *pkey = NULL;
+
+    r = iesys_cryptossl_pkey_load(pub_tpm_key, &pkey);
+    return_if_error(r, "Convert TPM public key");
+
+    r = iesys_cryptossl_pk_encrypt_pkey(pkey, pub_tpm_key, in_size, in_buffer, max_out_size,
+                                        out_buffer, out_size, label);
+    iesys_cryptossl_pkey_free(&pkey);
+    return r;
+}
+
+/** Computation of ephemeral ECC key and shared secret Z with a converted key.
+ *
+ * @param[in] pkey The key converted by iesys_cryptossl_pkey_load().
  * @param[in] max_out_size the max size for the output of the public key of the
  *            computed ephemeral key.
  * @param[out] Z The computed shared secret.
@@ -815,87 +1052,47 @@ cleanup:
  *             to this buffer.
  * @param[out] out_size The size of the marshaled output.
  * @retval TSS2_RC_SUCCESS on success
- * @retval TSS2_ESYS_RC_BAD_VALUE The algorithm of key is not implemented.
+ * @retval TSS2_ESYS_RC_BAD_VALUE The key is not an ECC key.
  * @retval TSS2_ESYS_RC_GENERAL_FAILURE The internal crypto engine failed.
  */
 TSS2_RC
-iesys_cryptossl_get_ecdh_point(TPM2B_PUBLIC        *key,
-                               size_t               max_out_size,
-                               TPM2B_ECC_PARAMETER *Z,
-                               TPMS_ECC_POINT      *Q,
-                               BYTE                *out_buffer,
-                               size_t              *out_size,
-                               void                *userdata) {
-    UNUSED(userdata);
-
+iesys_cryptossl_get_ecdh_point_pkey(IESYS_CRYPTO_PKEY_BLOB *pkey,
+                                    size_t                  max_out_size,
+                                    TPM2B_ECC_PARAMETER    *Z,
+                                    TPMS_ECC_POINT         *Q,
+                                    BYTE                   *out_buffer,
+                                    size_t                 *out_size) {
     TSS2_RC       r = TSS2_RC_SUCCESS;
-    EC_GROUP     *group = NULL; /* Group defines the used curve */
+    EC_GROUP     *group = pkey->group; /* Group defines the used curve */
     EVP_PKEY_CTX *ctx = NULL;
     EVP_PKEY     *eph_pkey = NULL;
 #if OPENSSL_VERSION_NUMBER < 0x30000000L
     const EC_POINT *eph_pub_key = NULL; /* Public part of ephemeral key */
     const BIGNUM   *eph_priv_key = NULL;
 #else
-    OSSL_LIB_CTX *libctx = NULL;
-    BIGNUM       *eph_priv_key = NULL;
+    BIGNUM *eph_priv_key = NULL;
 #endif
-    EC_POINT *tpm_pub_key = NULL; /* Public part of TPM key */
     EC_POINT *mul_eph_tpm = NULL;
     BIGNUM   *bn_x = NULL;
     BIGNUM   *bn_y = NULL;
-    size_t    key_size;
-    int       curveId;
+    size_t    key_size = pkey->key_size;
     size_t    offset;
 
-    /* Set ossl constant for curve type and create group for curve */
-    switch (key->publicArea.parameters.eccDetail.curveID) {
-    case TPM2_ECC_NIST_P192:
-        curveId = NID_X9_62_prime192v1;
-        key_size = 24;
-        break;
-    case TPM2_ECC_NIST_P224:
-        curveId = NID_secp224r1;
-        key_size = 28;
-        break;
-    case TPM2_ECC_NIST_P256:
-        curveId = NID_X9_62_prime256v1;
-        key_size = 32;
-        break;
-    case TPM2_ECC_NIST_P384:
-        curveId = NID_secp384r1;
-        key_size = 48;
-        break;
-    case TPM2_ECC_NIST_P521:
-        curveId = NID_secp521r1;
-        key_size = 66;
-        break;
-#ifdef NID_sm2
-    case TPM2_ECC_SM2_P256:
-        curveId = NID_sm2;
-        key_size = 32;
-        break;
-#endif
-    default:
-        return_error(TSS2_ESYS_RC_NOT_IMPLEMENTED, "ECC curve not implemented.");
-    }
-
-    if (!(group = EC_GROUP_new_by_curve_name(curveId))) {
-        goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Create group for curve", cleanup);
+    if (!group || !pkey->ecc_point) {
+        return_error(TSS2_ESYS_RC_BAD_VALUE, "Key is not an ECC key.");
     }
 
     /* Create ephemeral key */
 #if OPENSSL_VERSION_NUMBER < 0x30000000L
     if ((ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL)) == NULL || EVP_PKEY_keygen_init(ctx) <= 0) {
 #else
-    if (!(libctx = OSSL_LIB_CTX_new()))
-        goto_error(r, TSS2_ESYS_RC_MEMORY, "Create libctx for ec key generation", cleanup);
-    if ((ctx = EVP_PKEY_CTX_new_from_name(libctx, "EC", NULL)) == NULL
+    if ((ctx = EVP_PKEY_CTX_new_from_name(pkey->libctx, "EC", NULL)) == NULL
         || EVP_PKEY_keygen_init(ctx) <= 0) {
 #endif
         goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Initialize ec key generation", cleanup);
     }
 
-    if (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, curveId) <= 0
+    if (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, pkey->curveId) <= 0
         || EVP_PKEY_keygen(ctx, &eph_pkey) <= 0) {
         goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Generate ec key", cleanup);
     }
@@ -943,16 +1140,12 @@ iesys_cryptossl_get_ecdh_point(TPM2B_PUBLIC        *key,
     Q->x.size = key_size;
     Q->y.size = key_size;
 
-    /* Create an OSSL EC point from the TPM public point */
-    r = tpm_pub_to_ossl_pub(group, key, &tpm_pub_key);
-    goto_if_error(r, "Convert TPM pub point to ossl pub point", cleanup);
-
     if (!(mul_eph_tpm = EC_POINT_new(group))) {
         goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "Create point.", cleanup);
     }
 
     /* Multiply the ephemeral private key with TPM public key */
-    if (1 != EC_POINT_mul(group, mul_eph_tpm, NULL, tpm_pub_key, eph_priv_key, NULL)) {
+    if (1 != EC_POINT_mul(group, mul_eph_tpm, NULL, pkey->ecc_point, eph_priv_key, NULL)) {
         goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE, "ec point multiplication", cleanup);
     }
 
@@ -975,14 +1168,11 @@ iesys_cryptossl_get_ecdh_point(TPM2B_PUBLIC        *key,
 
 cleanup:
     OSSL_FREE(mul_eph_tpm, EC_POINT);
-    OSSL_FREE(tpm_pub_key, EC_POINT);
-    OSSL_FREE(group, EC_GROUP);
     OSSL_FREE(ctx, EVP_PKEY_CTX);
     OSSL_FREE(eph_pkey, EVP_PKEY);
 #if OPENSSL_VERSION_NUMBER < 0x30000000L
     /* Note: free of eph_pub_key already done by free of eph_ec_key */
 #else
-    OSSL_FREE(libctx, OSSL_LIB_CTX);
     OSSL_FREE(eph_priv_key, BN);
 #endif
     OSSL_FREE(bn_x, BN);
@@ -990,6 +1180,44 @@ cleanup:
     return r;
 }
 
+/** Computation of ephemeral ECC key and shared secret Z.
+ *
+ * According to the description in  TPM spec part 1 C 6.1 a shared secret
+ * between application and TPM is computed (ECDH). An ephemeral ECC key and a
+ * TPM keyare used for the ECDH key exchange.
+ * @param[in] key The key to be used for ECDH key exchange.
+ * @param[in] max_out_size the max size for the output of the public key of the
+ *            computed ephemeral key.
+ * @param[out] Z The computed shared secret.
+ * @param[out] Q The public part of the ephemeral key in TPM format.
+ * @param[out] out_buffer The public part of the ephemeral key will be marshaled
+ *             to this buffer.
+ * @param[out] out_size The size of the marshaled output.
+ * @retval TSS2_RC_SUCCESS on success
+ * @retval TSS2_ESYS_RC_BAD_VALUE The algorithm of key is not implemented.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE The internal crypto engine failed.
+ */
+TSS2_RC
+iesys_cryptossl_get_ecdh_point(TPM2B_PUBLIC        *key,
+                               size_t               max_out_size,
+                               TPM2B_ECC_PARAMETER *Z,
+                               TPMS_ECC_POINT      *Q,
+                               BYTE                *out_buffer,
+                               size_t              *out_size,
+                               void                *userdata) {
+    UNUSED(userdata);
+
+    TSS2_RC                 r;
+    IESYS_CRYPTO_PKEY_BLOB *pkey = NULL;
+
+    r = iesys_cryptossl_pkey_load(key, &pkey);
+    return_if_error(r, "Convert TPM public key");
+
+    r = iesys_cryptossl_get_ecdh_point_pkey(pkey, max_out_size, Z, Q, out_buffer, out_size);
+    iesys_cryptossl_pkey_free(&pkey);
+    return r;
+}
+
 /** Encrypt data with AES.
  *
  * @param[in] key key used for AES.
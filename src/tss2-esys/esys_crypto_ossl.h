@@ -13,6 +13,7 @@
 #include <stddef.h> // for NULL, size_t
 #include <stdint.h> // for uint8_t
 
+#include "esys_types.h"      // for IESYS_CRYPTO_PKEY_BLOB
 #include "tss2_common.h"     // for TSS2_RC, BYTE
 #include "tss2_esys.h"       // for ESYS_CRYPTO_CONTEXT_BLOB
 #include "tss2_tpm2_types.h" // for TPM2_ALG_ID, TPM2B_PUBLIC, TPMI_AES_KEY...
@@ -66,6 +67,9 @@ TSS2_RC iesys_cryptossl_hmac_finish(ESYS_CRYPTO_CONTEXT_BLOB **context,
 
 void iesys_cryptossl_hmac_abort(ESYS_CRYPTO_CONTEXT_BLOB **context, void *userdata);
 
+TSS2_RC iesys_cryptossl_hmac_dup(ESYS_CRYPTO_CONTEXT_BLOB  *context,
+                                 ESYS_CRYPTO_CONTEXT_BLOB **copy);
+
 #define iesys_crypto_hmac_start_internal    iesys_cryptossl_hmac_start
 #define iesys_crypto_hmac_start2b_internal  iesys_cryptossl_hmac_start2b
 #define iesys_crypto_hmac_update_internal   iesys_cryptossl_hmac_update
@@ -73,9 +77,12 @@ void iesys_cryptossl_hmac_abort(ESYS_CRYPTO_CONTEXT_BLOB **context, void *userda
 #define iesys_crypto_hmac_finish_internal   iesys_cryptossl_hmac_finish
 #define iesys_crypto_hmac_finish2b_internal iesys_cryptossl_hmac_finish2b
 #define iesys_crypto_hmac_abort_internal    iesys_cryptossl_hmac_abort
+#define iesys_crypto_hmac_dup_internal      iesys_cryptossl_hmac_dup
 
 TSS2_RC iesys_cryptossl_random2b(TPM2B_NONCE *nonce, size_t num_bytes, void *userdata);
 
+TSS2_RC iesys_cryptossl_random(uint8_t *buffer, size_t size);
+
 TSS2_RC iesys_cryptossl_pk_encrypt(TPM2B_PUBLIC *key,
                                    size_t        in_size,
                                    BYTE         *in_buffer,
@@ -85,6 +92,31 @@ TSS2_RC iesys_cryptossl_pk_encrypt(TPM2B_PUBLIC *key,
                                    const char   *label,
                                    void         *userdata);
 
+TSS2_RC iesys_cryptossl_pkey_load(TPM2B_PUBLIC *key, IESYS_CRYPTO_PKEY_BLOB **pkey);
+
+void iesys_cryptossl_pkey_free(IESYS_CRYPTO_PKEY_BLOB **pkey);
+
+TSS2_RC iesys_cryptossl_pk_encrypt_pkey(IESYS_CRYPTO_PKEY_BLOB *pkey,
+                                        TPM2B_PUBLIC           *pub_tpm_key,
+                                        size_t                  in_size,
+                                        BYTE                   *in_buffer,
+                                        size_t                  max_out_size,
+                                        BYTE                   *out_buffer,
+                                        size_t                 *out_size,
+                                        const char             *label);
+
+TSS2_RC iesys_cryptossl_get_ecdh_point_pkey(IESYS_CRYPTO_PKEY_BLOB *pkey,
+                                            size_t                  max_out_size,
+                                            TPM2B_ECC_PARAMETER    *Z,
+                                            TPMS_ECC_POINT         *Q,
+                                            BYTE                   *out_buffer,
+                                            size_t                 *out_size);
+
+#define iesys_crypto_pkey_load_internal           iesys_cryptossl_pkey_load
+#define iesys_crypto_pkey_free_internal           iesys_cryptossl_pkey_free
+#define iesys_crypto_pk_encrypt_pkey_internal     iesys_cryptossl_pk_encrypt_pkey
+#define iesys_crypto_get_ecdh_point_pkey_internal iesys_cryptossl_get_ecdh_point_pkey
+
 TSS2_RC iesys_cryptossl_sym_aes_encrypt(uint8_t          *key,
                                         TPM2_ALG_ID       tpm_sym_alg,
                                         TPMI_AES_KEY_BITS key_bits,
@@ -132,6 +164,7 @@ TSS2_RC iesys_cryptossl_get_ecdh_point(TPM2B_PUBLIC        *key,
                                        void                *userdata);
 
 #define iesys_crypto_get_random2b_internal   iesys_cryptossl_random2b
+#define iesys_crypto_get_random_internal     iesys_cryptossl_random
 #define iesys_crypto_get_ecdh_point_internal iesys_cryptossl_get_ecdh_point
 #define iesys_crypto_aes_encrypt_internal    iesys_cryptossl_sym_aes_encrypt
 #define iesys_crypto_aes_decrypt_internal    iesys_cryptossl_sym_aes_decrypt
@@ -0,0 +1,606 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for PRIx32, int32_t, int64_t
+#include <stdbool.h>  // for bool, false, true
+#include <stdlib.h>   // for NULL, size_t, free, calloc, realloc
+
+#ifndef _WIN32
+#include <errno.h>  // for EAGAIN, EINTR, errno
+#include <fcntl.h>  // for fcntl, FD_CLOEXEC, F_GETFL, F_SETFD, F_SETFL
+#include <poll.h>   // for pollfd, poll, POLLIN
+#include <time.h>   // for timespec, clock_gettime, CLOCK_MONOTONIC
+#include <unistd.h> // for close, pipe, read, write
+#ifdef HAVE_PTHREAD
+#include <pthread.h> // for pthread_mutex_lock, pthread_mutex_unlock, pth...
+#endif
+#endif
+
+#include "esys_int.h"      // for ESYS_CONTEXT, ESYS_ASSERT_NON_NULL
+#include "tss2_common.h"   // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_RC_...
+#include "tss2_esys.h"     // for ESYS_EXECUTOR, Esys_Executor_New, Esys_...
+#include "tss2_tcti.h"     // for TSS2_TCTI_POLL_HANDLE
+#include "util/aux_util.h" // for base_rc
+
+#define LOGMODULE esys
+#include "util/log.h" // for return_if_null, goto_if_error, LOG_ERROR
+
+#ifndef _WIN32
+
+/** Poll interval in ms for contexts whose TCTI provides no poll handles. */
+#define IESYS_EXECUTOR_POLL_INTERVAL 1
+
+typedef enum {
+    IESYS_EXECUTOR_IDLE = 0, /**< No submission of the context is in flight. */
+    IESYS_EXECUTOR_SENT,     /**< The command of the head submission was sent. */
+    IESYS_EXECUTOR_DONE,     /**< The head submission is being delivered. */
+} IESYS_EXECUTOR_STATE;
+
+typedef struct IESYS_EXECUTOR_SLOT IESYS_EXECUTOR_SLOT;
+typedef struct IESYS_EXECUTOR_JOB  IESYS_EXECUTOR_JOB;
+
+/** A submission: one asynchronous ESYS command and its completion. */
+struct IESYS_EXECUTOR_JOB {
+    ESYS_EXECUTOR_ASYNC_FCN  async;
+    ESYS_EXECUTOR_FINISH_FCN finish;
+    ESYS_EXECUTOR_DONE_FCN   done;
+    void                    *userdata;
+    TSS2_RC                  rc;        /**< Result of the finished submission. */
+    IESYS_EXECUTOR_SLOT     *slot;      /**< The context the job was submitted to. */
+    IESYS_EXECUTOR_JOB      *next;      /**< Next submission of the same context. */
+    IESYS_EXECUTOR_JOB      *done_next; /**< Next job waiting for a worker thread. */
+};
+
+/** The submissions of one ESYS context, executed in order one at a time. */
+struct IESYS_EXECUTOR_SLOT {
+    ESYS_CONTEXT          *esys_context;
+    IESYS_EXECUTOR_STATE   state;
+    TSS2_TCTI_POLL_HANDLE *handles;     /**< Poll handles of the TCTI, may be NULL. */
+    size_t                 num_handles;
+    size_t                 fds_index;   /**< Position of the handles in the poll set. */
+    IESYS_EXECUTOR_JOB    *head;        /**< The submission in flight or next. */
+    IESYS_EXECUTOR_JOB    *tail;
+    IESYS_EXECUTOR_SLOT   *next;
+};
+
+struct ESYS_EXECUTOR {
+    IESYS_EXECUTOR_SLOT *slots;      /**< Contexts ever submitted to, never removed. */
+    size_t               pending;    /**< Submissions not yet delivered. */
+    struct pollfd       *fds;        /**< The poll set, owned by Esys_Executor_Run. */
+    size_t               fds_size;
+    int                  wakeup[2];  /**< Pipe that interrupts the poll of Run. */
+#ifdef HAVE_PTHREAD
+    pthread_mutex_t      lock;
+    pthread_cond_t       wake;       /**< Signals the worker threads. */
+    pthread_t           *threads;
+    size_t               num_threads;
+    IESYS_EXECUTOR_JOB  *done_head;  /**< Finished jobs waiting for a worker. */
+    IESYS_EXECUTOR_JOB  *done_tail;
+    bool                 stop;
+#endif
+};
+
+#ifdef HAVE_PTHREAD
+#define executor_lock(executor)   pthread_mutex_lock(&(executor)->lock)
+#define executor_unlock(executor) pthread_mutex_unlock(&(executor)->lock)
+#else
+#define executor_lock(executor)   (void)(executor)
+#define executor_unlock(executor) (void)(executor)
+#endif
+
+/** Interrupt a running Esys_Executor_Run. */
+static void
+executor_wakeup(ESYS_EXECUTOR *executor) {
+    /* A full pipe already guarantees a wakeup */
+    if (write(executor->wakeup[1], "", 1) < 0 && errno != EAGAIN)
+        LOG_WARNING("Could not wake up the executor.");
+}
+
+static void
+executor_drain(ESYS_EXECUTOR *executor) {
+    char buffer[64];
+
+    while (read(executor->wakeup[0], &buffer[0], sizeof(buffer)) > 0)
+        ;
+}
+
+static void
+executor_deadline(struct timespec *deadline, int32_t timeout) {
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += timeout / 1000;
+    deadline->tv_nsec += (long)(timeout % 1000) * 1000000;
+    if (deadline->tv_nsec >= 1000000000) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+/** Milliseconds left until the deadline, -1 without deadline. */
+static int
+executor_remaining(const struct timespec *deadline, int32_t timeout) {
+    struct timespec now;
+    int64_t         ms;
+
+    if (timeout < 0)
+        return -1;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    ms = (int64_t)(deadline->tv_sec - now.tv_sec) * 1000
+         + (deadline->tv_nsec - now.tv_nsec + 999999) / 1000000;
+    return ms > 0 ? (int)ms : 0;
+}
+
+/** Fetch the poll handles of the TCTI of an idle context. */
+static void
+executor_poll_handles(IESYS_EXECUTOR_SLOT *slot) {
+    TSS2_RC                r;
+    TSS2_TCTI_POLL_HANDLE *handles = NULL;
+    size_t                 count = 0;
+
+    free(slot->handles);
+    slot->handles = NULL;
+    slot->num_handles = 0;
+
+    r = Esys_GetPollHandles(slot->esys_context, &handles, &count);
+    if (r != TSS2_RC_SUCCESS) {
+        LOG_DEBUG("No poll handles for the TCTI (0x%" PRIx32 "), polling by interval.", r);
+        free(handles);
+        return;
+    }
+    slot->handles = handles;
+    slot->num_handles = count;
+}
+
+/** Retire the head submission of a context. Called with the lock held. */
+static void
+executor_complete(ESYS_EXECUTOR *executor, IESYS_EXECUTOR_SLOT *slot) {
+    IESYS_EXECUTOR_JOB *job = slot->head;
+
+    slot->head = job->next;
+    if (slot->head == NULL)
+        slot->tail = NULL;
+    slot->state = IESYS_EXECUTOR_IDLE;
+    executor->pending--;
+    free(job);
+}
+
+/** Deliver the result of the head submission. Called with the lock held. */
+static void
+executor_deliver(ESYS_EXECUTOR *executor, IESYS_EXECUTOR_SLOT *slot) {
+    IESYS_EXECUTOR_JOB *job = slot->head;
+
+    slot->state = IESYS_EXECUTOR_DONE;
+#ifdef HAVE_PTHREAD
+    if (executor->num_threads > 0) {
+        job->done_next = NULL;
+        if (executor->done_tail == NULL)
+            executor->done_head = job;
+        else
+            executor->done_tail->done_next = job;
+        executor->done_tail = job;
+        pthread_cond_signal(&executor->wake);
+        return;
+    }
+#endif
+    executor_unlock(executor);
+    if (job->done != NULL)
+        job->done(slot->esys_context, job->rc, job->userdata);
+    executor_lock(executor);
+    executor_complete(executor, slot);
+}
+
+#ifdef HAVE_PTHREAD
+static void *
+executor_worker(void *arg) {
+    ESYS_EXECUTOR      *executor = arg;
+    IESYS_EXECUTOR_JOB *job;
+
+    pthread_mutex_lock(&executor->lock);
+    for (;;) {
+        while (!executor->stop && executor->done_head == NULL)
+            pthread_cond_wait(&executor->wake, &executor->lock);
+        if (executor->stop)
+            break;
+
+        job = executor->done_head;
+        executor->done_head = job->done_next;
+        if (executor->done_head == NULL)
+            executor->done_tail = NULL;
+
+        pthread_mutex_unlock(&executor->lock);
+        if (job->done != NULL)
+            job->done(job->slot->esys_context, job->rc, job->userdata);
+        pthread_mutex_lock(&executor->lock);
+
+        executor_complete(executor, job->slot);
+        executor_wakeup(executor);
+    }
+    pthread_mutex_unlock(&executor->lock);
+    return NULL;
+}
+#endif
+
+/** Try to receive the response of the head submission. Called with the lock held. */
+static void
+executor_finish(ESYS_EXECUTOR *executor, IESYS_EXECUTOR_SLOT *slot) {
+    TSS2_RC             r;
+    IESYS_EXECUTOR_JOB *job = slot->head;
+    ESYS_CONTEXT       *esys_context = slot->esys_context;
+    int32_t             timeout = esys_context->timeout;
+
+    executor_unlock(executor);
+    /* Readiness was signaled, so the response must not be waited for */
+    esys_context->timeout = 0;
+    r = job->finish(esys_context, job->userdata);
+    esys_context->timeout = timeout;
+    executor_lock(executor);
+
+    if (base_rc(r) == TSS2_BASE_RC_TRY_AGAIN)
+        return;
+    job->rc = r;
+    executor_deliver(executor, slot);
+}
+
+/** Send the command of the head submission. Called with the lock held. */
+static void
+executor_start(ESYS_EXECUTOR *executor, IESYS_EXECUTOR_SLOT *slot) {
+    TSS2_RC             r;
+    IESYS_EXECUTOR_JOB *job = slot->head;
+
+    slot->state = IESYS_EXECUTOR_SENT;
+    executor_unlock(executor);
+    r = job->async(slot->esys_context, job->userdata);
+    executor_lock(executor);
+    if (r != TSS2_RC_SUCCESS) {
+        LOG_DEBUG("Submission failed to start: 0x%" PRIx32, r);
+        job->rc = r;
+        executor_deliver(executor, slot);
+    }
+}
+
+/** Collect the wakeup pipe and the poll handles of all sent commands. */
+static TSS2_RC
+executor_poll_set(ESYS_EXECUTOR *executor, size_t *nfds, bool *interval) {
+    IESYS_EXECUTOR_SLOT *slot;
+    struct pollfd       *fds;
+    size_t               count = 1;
+
+    *interval = false;
+    for (slot = executor->slots; slot != NULL; slot = slot->next)
+        if (slot->state == IESYS_EXECUTOR_SENT)
+            count += slot->num_handles;
+
+    if (count > executor->fds_size) {
+        fds = realloc(executor->fds, count * sizeof(*fds));
+        return_if_null(fds, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+        executor->fds = fds;
+        executor->fds_size = count;
+    }
+
+    executor->fds[0].fd = executor->wakeup[0];
+    executor->fds[0].events = POLLIN;
+    executor->fds[0].revents = 0;
+    *nfds = 1;
+    for (slot = executor->slots; slot != NULL; slot = slot->next) {
+        if (slot->state != IESYS_EXECUTOR_SENT)
+            continue;
+        if (slot->num_handles == 0)
+            *interval = true;
+        slot->fds_index = *nfds;
+        for (size_t i = 0; i < slot->num_handles; i++) {
+            executor->fds[*nfds] = slot->handles[i];
+            executor->fds[*nfds].revents = 0;
+            *nfds += 1;
+        }
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+static bool
+executor_ready(ESYS_EXECUTOR *executor, IESYS_EXECUTOR_SLOT *slot) {
+    if (slot->num_handles == 0)
+        return true;
+    for (size_t i = 0; i < slot->num_handles; i++)
+        if (executor->fds[slot->fds_index + i].revents != 0)
+            return true;
+    return false;
+}
+
+/** Create an executor for asynchronous ESYS commands.
+ *
+ * The executor sends the commands submitted for any number of ESYS contexts,
+ * waits for the poll handles of their TCTIs and calls the _Finish functions once
+ * a response is ready. Results are delivered from Esys_Executor_Run or, if
+ * threads is not 0, from a pool of worker threads.
+ * @param[out] executor The created executor. Free with Esys_Executor_Free.
+ * @param[in] threads The number of threads delivering results or 0.
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if executor is NULL.
+ * @retval TSS2_ESYS_RC_MEMORY if memory cannot be allocated.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE if the wakeup pipe or a thread cannot be
+ *         created.
+ * @retval TSS2_ESYS_RC_NOT_IMPLEMENTED if threads is not 0 and the library was
+ *         built without thread support.
+ */
+TSS2_RC
+Esys_Executor_New(ESYS_EXECUTOR **executor, size_t threads) {
+    ESYS_EXECUTOR *ex;
+
+    ESYS_ASSERT_NON_NULL(executor);
+    *executor = NULL;
+#ifndef HAVE_PTHREAD
+    if (threads > 0) {
+        LOG_ERROR("Built without thread support.");
+        return TSS2_ESYS_RC_NOT_IMPLEMENTED;
+    }
+#endif
+
+    ex = calloc(1, sizeof(*ex));
+    return_if_null(ex, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+#ifdef HAVE_PTHREAD
+    pthread_mutex_init(&ex->lock, NULL);
+    pthread_cond_init(&ex->wake, NULL);
+#endif
+
+    ex->wakeup[0] = ex->wakeup[1] = -1;
+    if (pipe(ex->wakeup) != 0) {
+        LOG_ERROR("Could not create the wakeup pipe.");
+        Esys_Executor_Free(&ex);
+        return TSS2_ESYS_RC_GENERAL_FAILURE;
+    }
+    for (size_t i = 0; i < 2; i++) {
+        fcntl(ex->wakeup[i], F_SETFL, fcntl(ex->wakeup[i], F_GETFL) | O_NONBLOCK);
+        fcntl(ex->wakeup[i], F_SETFD, FD_CLOEXEC);
+    }
+
+#ifdef HAVE_PTHREAD
+    if (threads > 0) {
+        ex->threads = calloc(threads, sizeof(pthread_t));
+        if (ex->threads == NULL) {
+            LOG_ERROR("Out of memory.");
+            Esys_Executor_Free(&ex);
+            return TSS2_ESYS_RC_MEMORY;
+        }
+    }
+    for (; ex->num_threads < threads; ex->num_threads++) {
+        if (pthread_create(&ex->threads[ex->num_threads], NULL, executor_worker, ex) != 0) {
+            LOG_ERROR("Could not create a worker thread.");
+            Esys_Executor_Free(&ex);
+            return TSS2_ESYS_RC_GENERAL_FAILURE;
+        }
+    }
+#endif
+
+    *executor = ex;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Free an executor.
+ *
+ * Stops the worker threads. Submissions that were not delivered yet are
+ * discarded without calling their callbacks; commands in flight are not
+ * finished, so the affected ESYS contexts should be finalized as well.
+ * @param[in,out] executor The executor to free. Set to NULL.
+ */
+void
+Esys_Executor_Free(ESYS_EXECUTOR **executor) {
+    ESYS_EXECUTOR       *ex;
+    IESYS_EXECUTOR_SLOT *slot;
+    IESYS_EXECUTOR_JOB  *job;
+
+    if (executor == NULL || *executor == NULL)
+        return;
+    ex = *executor;
+
+#ifdef HAVE_PTHREAD
+    pthread_mutex_lock(&ex->lock);
+    ex->stop = true;
+    pthread_cond_broadcast(&ex->wake);
+    pthread_mutex_unlock(&ex->lock);
+    for (size_t i = 0; i < ex->num_threads; i++)
+        pthread_join(ex->threads[i], NULL);
+    free(ex->threads);
+    pthread_cond_destroy(&ex->wake);
+    pthread_mutex_destroy(&ex->lock);
+#endif
+
+    while ((slot = ex->slots) != NULL) {
+        ex->slots = slot->next;
+        while ((job = slot->head) != NULL) {
+            slot->head = job->next;
+            free(job);
+        }
+        free(slot->handles);
+        free(slot);
+    }
+    for (size_t i = 0; i < 2; i++)
+        if (ex->wakeup[i] >= 0)
+            close(ex->wakeup[i]);
+    free(ex->fds);
+    free(ex);
+    *executor = NULL;
+}
+
+/** Submit an asynchronous ESYS command to an executor.
+ *
+ * The submissions of one ESYS context are executed in order, one at a time;
+ * the context must not be used otherwise until the last of them is delivered.
+ * Esys_Executor_Run calls async to send the command, finish whenever the TCTI
+ * signals readiness until it no longer returns TSS2_BASE_RC_TRY_AGAIN and done
+ * with the result of finish, or of async if that failed.
+ * May be called from any thread, including from within the callbacks.
+ * @param[in] executor The executor.
+ * @param[in] esys_context The ESYS context to execute the command on.
+ * @param[in] async The function calling the _Async function of the command.
+ * @param[in] finish The function calling the _Finish function of the command.
+ * @param[in] done The function receiving the result (optional).
+ * @param[in] userdata Passed to async, finish and done.
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if a mandatory parameter is NULL.
+ * @retval TSS2_ESYS_RC_MEMORY if memory cannot be allocated.
+ */
+TSS2_RC
+Esys_Executor_Submit(ESYS_EXECUTOR           *executor,
+                     ESYS_CONTEXT            *esys_context,
+                     ESYS_EXECUTOR_ASYNC_FCN  async,
+                     ESYS_EXECUTOR_FINISH_FCN finish,
+                     ESYS_EXECUTOR_DONE_FCN   done,
+                     void                    *userdata) {
+    IESYS_EXECUTOR_SLOT *slot;
+    IESYS_EXECUTOR_JOB  *job;
+
+    ESYS_ASSERT_NON_NULL(executor);
+    ESYS_ASSERT_NON_NULL(esys_context);
+    ESYS_ASSERT_NON_NULL(async);
+    ESYS_ASSERT_NON_NULL(finish);
+
+    job = calloc(1, sizeof(*job));
+    return_if_null(job, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+    job->async = async;
+    job->finish = finish;
+    job->done = done;
+    job->userdata = userdata;
+
+    executor_lock(executor);
+    for (slot = executor->slots; slot != NULL; slot = slot->next)
+        if (slot->esys_context == esys_context)
+            break;
+    if (slot == NULL) {
+        slot = calloc(1, sizeof(*slot));
+        if (slot == NULL) {
+            executor_unlock(executor);
+            free(job);
+            LOG_ERROR("Out of memory.");
+            return TSS2_ESYS_RC_MEMORY;
+        }
+        slot->esys_context = esys_context;
+        slot->next = executor->slots;
+        executor->slots = slot;
+    }
+
+    /* The context may have been finalized and its memory reused meanwhile */
+    if (slot->head == NULL)
+        executor_poll_handles(slot);
+
+    job->slot = slot;
+    if (slot->tail == NULL)
+        slot->head = job;
+    else
+        slot->tail->next = job;
+    slot->tail = job;
+    executor->pending++;
+    executor_wakeup(executor);
+    executor_unlock(executor);
+    return TSS2_RC_SUCCESS;
+}
+
+/** Execute the submissions of an executor.
+ *
+ * Drives all submitted commands until every submission, including the ones
+ * submitted meanwhile, has been delivered or the timeout expires. Must not be
+ * called concurrently for the same executor.
+ * @param[in] executor The executor.
+ * @param[in] timeout The timeout in ms or -1 to block until all are delivered.
+ * @retval TSS2_RC_SUCCESS if all submissions were delivered.
+ * @retval TSS2_ESYS_RC_TRY_AGAIN if the timeout expired first.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if executor is NULL.
+ * @retval TSS2_ESYS_RC_MEMORY if memory cannot be allocated.
+ * @retval TSS2_ESYS_RC_IO_ERROR if polling failed.
+ */
+TSS2_RC
+Esys_Executor_Run(ESYS_EXECUTOR *executor, int32_t timeout) {
+    TSS2_RC              r = TSS2_RC_SUCCESS;
+    IESYS_EXECUTOR_SLOT *slot;
+    struct timespec      deadline = { 0 };
+    size_t               nfds;
+    bool                 interval;
+    int                  wait;
+
+    ESYS_ASSERT_NON_NULL(executor);
+
+    if (timeout >= 0)
+        executor_deadline(&deadline, timeout);
+
+    executor_lock(executor);
+    while (executor->pending > 0) {
+        for (slot = executor->slots; slot != NULL; slot = slot->next)
+            if (slot->state == IESYS_EXECUTOR_IDLE && slot->head != NULL)
+                executor_start(executor, slot);
+
+        r = executor_poll_set(executor, &nfds, &interval);
+        goto_if_error(r, "Build poll set", out);
+
+        wait = executor_remaining(&deadline, timeout);
+        if (interval && (wait < 0 || wait > IESYS_EXECUTOR_POLL_INTERVAL))
+            wait = IESYS_EXECUTOR_POLL_INTERVAL;
+
+        executor_unlock(executor);
+        if (poll(executor->fds, nfds, wait) < 0 && errno != EINTR) {
+            executor_lock(executor);
+            LOG_ERROR("Poll failed: errno %d", errno);
+            r = TSS2_ESYS_RC_IO_ERROR;
+            goto out;
+        }
+        executor_lock(executor);
+
+        if (executor->fds[0].revents != 0)
+            executor_drain(executor);
+        for (slot = executor->slots; slot != NULL; slot = slot->next)
+            if (slot->state == IESYS_EXECUTOR_SENT && executor_ready(executor, slot))
+                executor_finish(executor, slot);
+
+        if (executor->pending > 0 && executor_remaining(&deadline, timeout) == 0) {
+            r = TSS2_ESYS_RC_TRY_AGAIN;
+            break;
+        }
+    }
+
+out:
+    executor_unlock(executor);
+    return r;
+}
+
+#else /* _WIN32 */
+
+/* The poll handles of the TCTIs are HANDLEs that poll() cannot wait for */
+
+TSS2_RC
+Esys_Executor_New(ESYS_EXECUTOR **executor, size_t threads) {
+    (void)threads;
+    ESYS_ASSERT_NON_NULL(executor);
+    *executor = NULL;
+    return TSS2_ESYS_RC_NOT_IMPLEMENTED;
+}
+
+void
+Esys_Executor_Free(ESYS_EXECUTOR **executor) {
+    (void)executor;
+}
+
+TSS2_RC
+Esys_Executor_Submit(ESYS_EXECUTOR           *executor,
+                     ESYS_CONTEXT            *esys_context,
+                     ESYS_EXECUTOR_ASYNC_FCN  async,
+                     ESYS_EXECUTOR_FINISH_FCN finish,
+                     ESYS_EXECUTOR_DONE_FCN   done,
+                     void                    *userdata) {
+    (void)executor;
+    (void)esys_context;
+    (void)async;
+    (void)finish;
+    (void)done;
+    (void)userdata;
+    return TSS2_ESYS_RC_NOT_IMPLEMENTED;
+}
+
+TSS2_RC
+Esys_Executor_Run(ESYS_EXECUTOR *executor, int32_t timeout) {
+    (void)executor;
+    (void)timeout;
+    return TSS2_ESYS_RC_NOT_IMPLEMENTED;
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,239 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t
+#include <stdbool.h>  // for bool, false, true
+#include <stddef.h>   // for NULL, size_t
+#include <string.h>   // for memcpy
+
+#include "esys_int.h"        // for ESYS_CONTEXT, ESYS_ASSERT_NON_NULL
+#include "esys_iutil.h"      // for iesys_thread_enter, iesys_thread_leave
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_BASE_RC_...
+#include "tss2_esys.h"       // for Esys_HashStream, Esys_SequenceUpdate_Async
+#include "tss2_tpm2_types.h" // for TPM2B_MAX_BUFFER, TPM2B_DIGEST, TPMT_TK_...
+#include "util/aux_util.h"   // for base_rc
+
+#define LOGMODULE esys
+#include "util/log.h" // for return_if_error, goto_if_error, LOG_WARNING
+
+/** The input of a hash stream, either a read callback or a memory buffer. */
+typedef struct {
+    ESYS_HASH_STREAM_READ_FCN read;
+    void                     *userdata;
+    const uint8_t            *data; /**< Remaining input if read is NULL. */
+    size_t                    size;
+    bool                      eof;
+} IESYS_HASH_SOURCE;
+
+/** Fill a chunk with the next input, leaving it short only at the end of the input. */
+static TSS2_RC
+hash_fill(IESYS_HASH_SOURCE *source, TPM2B_MAX_BUFFER *chunk) {
+    TSS2_RC r;
+    size_t  size;
+
+    chunk->size = 0;
+    if (source->read == NULL) {
+        size = source->size < sizeof(chunk->buffer) ? source->size : sizeof(chunk->buffer);
+        if (size > 0) {
+            memcpy(&chunk->buffer[0], source->data, size);
+            source->data += size;
+            source->size -= size;
+        }
+        chunk->size = (UINT16)size;
+        return TSS2_RC_SUCCESS;
+    }
+
+    while (!source->eof && chunk->size < sizeof(chunk->buffer)) {
+        size = sizeof(chunk->buffer) - chunk->size;
+        r = source->read(&chunk->buffer[chunk->size], &size, source->userdata);
+        return_if_error(r, "Read callback");
+        if (size > sizeof(chunk->buffer) - chunk->size) {
+            LOG_ERROR("Read callback returned more data than requested.");
+            return TSS2_ESYS_RC_BAD_VALUE;
+        }
+        source->eof = size == 0;
+        chunk->size += (UINT16)size;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+/** Feed the input to a new hash or HMAC sequence and complete it.
+ *
+ * Each chunk is sent with Esys_SequenceUpdate_Async and the next one is read
+ * while the TPM works on it. The last chunk is sent with the
+ * SequenceComplete, which needs a lookahead of one chunk.
+ */
+static TSS2_RC
+hash_stream(ESYS_CONTEXT       *esys_context,
+            ESYS_TR             key,
+            ESYS_TR             shandle1,
+            ESYS_TR             shandle2,
+            ESYS_TR             shandle3,
+            TPMI_ALG_HASH       hashAlg,
+            ESYS_TR             hierarchy,
+            IESYS_HASH_SOURCE  *source,
+            TPM2B_DIGEST      **result,
+            TPMT_TK_HASHCHECK **validation) {
+    TSS2_RC           r, r_read;
+    TPM2B_AUTH        auth = { 0 };
+    TPM2B_MAX_BUFFER  chunks[2];
+    TPM2B_MAX_BUFFER *current = &chunks[0], *next = &chunks[1], *tmp;
+    ESYS_TR           sequence = ESYS_TR_NONE;
+    int32_t           timeouttmp = esys_context->timeout;
+
+    r = hash_fill(source, current);
+    return_if_error(r, "Read first chunk");
+    r = hash_fill(source, next);
+    return_if_error(r, "Read second chunk");
+
+    if (key == ESYS_TR_NONE)
+        r = Esys_HashSequenceStart(esys_context, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &auth,
+                                   hashAlg, &sequence);
+    else
+        r = Esys_HMAC_Start(esys_context, key, shandle1, shandle2, shandle3, &auth, hashAlg,
+                            &sequence);
+    return_if_error(r, "Start sequence");
+
+    /* Set the timeout to indefinite, since the updates are completed in turn */
+    esys_context->timeout = -1;
+    while (next->size > 0) {
+        r = Esys_SequenceUpdate_Async(esys_context, sequence, shandle1, shandle2, shandle3,
+                                      current);
+        goto_if_error(r, "Sequence update", error_cleanup);
+
+        /* The chunk is marshaled, so it can be reused for the lookahead */
+        tmp = current;
+        current = next;
+        next = tmp;
+        r_read = hash_fill(source, next);
+
+        do {
+            r = Esys_SequenceUpdate_Finish(esys_context);
+        } while (base_rc(r) == TSS2_BASE_RC_TRY_AGAIN);
+        goto_if_error(r, "Sequence update", error_cleanup);
+        r = r_read;
+        goto_if_error(r, "Read chunk", error_cleanup);
+    }
+    esys_context->timeout = timeouttmp;
+
+    r = Esys_SequenceComplete(esys_context, sequence, shandle1, shandle2, shandle3, current,
+                              hierarchy, result, validation);
+    goto_if_error(r, "Sequence complete", error_cleanup);
+    return TSS2_RC_SUCCESS;
+
+error_cleanup:
+    esys_context->timeout = timeouttmp;
+    if (Esys_FlushContext(esys_context, sequence) != TSS2_RC_SUCCESS) {
+        LOG_WARNING("Flushing the sequence failed, closing it.");
+        Esys_TR_Close(esys_context, &sequence);
+    }
+    return r;
+}
+
+/** Hash or HMAC a stream of data with a TPM sequence.
+ *
+ * Starts a hash sequence, or an HMAC sequence if key is given, feeds it the
+ * data returned by the read callback in chunks of TPM2_MAX_DIGEST_BUFFER and
+ * completes it. The next chunk is read while the TPM processes the current
+ * one. The sequence is started with an empty authValue; the sessions are used
+ * for the key authorization of TPM2_HMAC_Start and for all sequence commands,
+ * ESYS_TR_PASSWORD suffices for both if the key has no authValue.
+ * @param esys_context [in,out] The ESYS_CONTEXT.
+ * @param key [in] The HMAC key or ESYS_TR_NONE to compute a hash.
+ * @param shandle1 [in] First session handle.
+ * @param shandle2 [in] Second session handle.
+ * @param shandle3 [in] Third session handle.
+ * @param hashAlg [in] The hash algorithm, TPM2_ALG_NULL for the scheme of key.
+ * @param hierarchy [in] The hierarchy of the ticket for a hash, e.g.
+ *        ESYS_TR_RH_OWNER or ESYS_TR_RH_NULL.
+ * @param read [in] The callback reading the data. It fills up to *size bytes
+ *        of the buffer and sets *size to the number of bytes read, 0 at the
+ *        end of the data.
+ * @param userdata [in] Passed to read.
+ * @param result [out] The digest (callee-allocated).
+ * @param validation [out] The ticket, a NULL ticket for HMACs (callee-allocated).
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context or read is NULL.
+ * @retval TSS2_ESYS_RC_BAD_VALUE if read returns more data than requested.
+ * @retval TSS2_RCs produced by read, Esys_HashSequenceStart, Esys_HMAC_Start,
+ *         Esys_SequenceUpdate and Esys_SequenceComplete.
+ */
+TSS2_RC
+Esys_HashStream(ESYS_CONTEXT             *esys_context,
+                ESYS_TR                   key,
+                ESYS_TR                   shandle1,
+                ESYS_TR                   shandle2,
+                ESYS_TR                   shandle3,
+                TPMI_ALG_HASH             hashAlg,
+                ESYS_TR                   hierarchy,
+                ESYS_HASH_STREAM_READ_FCN read,
+                void                     *userdata,
+                TPM2B_DIGEST            **result,
+                TPMT_TK_HASHCHECK       **validation) {
+    IESYS_HASH_SOURCE source = { .read = read, .userdata = userdata };
+    TSS2_RC           r;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    ESYS_ASSERT_NON_NULL(read);
+
+    iesys_thread_enter(esys_context);
+    r = hash_stream(esys_context, key, shandle1, shandle2, shandle3, hashAlg, hierarchy, &source,
+                    result, validation);
+    iesys_thread_leave(esys_context);
+    return r;
+}
+
+/** Hash or HMAC data in memory with a TPM sequence.
+ *
+ * Like Esys_HashStream, but takes the data from memory, e.g. a mapped file.
+ * The chunks are copied from the buffer into the commands without going
+ * through a read callback.
+ * @param esys_context [in,out] The ESYS_CONTEXT.
+ * @param key [in] The HMAC key or ESYS_TR_NONE to compute a hash.
+ * @param shandle1 [in] First session handle.
+ * @param shandle2 [in] Second session handle.
+ * @param shandle3 [in] Third session handle.
+ * @param hashAlg [in] The hash algorithm, TPM2_ALG_NULL for the scheme of key.
+ * @param hierarchy [in] The hierarchy of the ticket for a hash, e.g.
+ *        ESYS_TR_RH_OWNER or ESYS_TR_RH_NULL.
+ * @param buffer [in] The data, may be NULL if size is 0.
+ * @param size [in] The size of the data.
+ * @param result [out] The digest (callee-allocated).
+ * @param validation [out] The ticket, a NULL ticket for HMACs (callee-allocated).
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL or buffer is NULL
+ *         while size is not 0.
+ * @retval TSS2_RCs produced by Esys_HashSequenceStart, Esys_HMAC_Start,
+ *         Esys_SequenceUpdate and Esys_SequenceComplete.
+ */
+TSS2_RC
+Esys_HashBuffer(ESYS_CONTEXT       *esys_context,
+                ESYS_TR             key,
+                ESYS_TR             shandle1,
+                ESYS_TR             shandle2,
+                ESYS_TR             shandle3,
+                TPMI_ALG_HASH       hashAlg,
+                ESYS_TR             hierarchy,
+                const uint8_t      *buffer,
+                size_t              size,
+                TPM2B_DIGEST      **result,
+                TPMT_TK_HASHCHECK **validation) {
+    IESYS_HASH_SOURCE source = { .data = buffer, .size = size };
+    TSS2_RC           r;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    if (buffer == NULL && size > 0) {
+        LOG_ERROR("buffer == NULL.");
+        return TSS2_ESYS_RC_BAD_REFERENCE;
+    }
+
+    iesys_thread_enter(esys_context);
+    r = hash_stream(esys_context, key, shandle1, shandle2, shandle3, hashAlg, hierarchy, &source,
+                    result, validation);
+    iesys_thread_leave(esys_context);
+    return r;
+}
@@ -6,8 +6,9 @@
 #ifndef ESYS_INT_H
 #define ESYS_INT_H
 
-#include <stddef.h> // for NULL, size_t
-#include <stdint.h> // for int32_t
+#include <stdbool.h> // for bool
+#include <stddef.h>  // for NULL, size_t
+#include <stdint.h>  // for int32_t, uint8_t
 
 #include "esys_types.h"      // for IESYS_RESOURCE, IESYS_SESSION
 #include "tss2_common.h"     // for TSS2_ESYS_RC_BAD_REFERENCE
@@ -20,6 +21,51 @@
 extern "C" {
 #endif
 
+/** Public area of a key in TPM wire format
+ *
+ * Allocated with the size of the marshaled TPM2B_PUBLIC and unmarshaled on
+ * demand by iesys_rsrc_key_public().
+ */
+typedef struct {
+    UINT16 size;     /**< The size of buffer */
+    BYTE   buffer[]; /**< The marshaled TPM2B_PUBLIC */
+} IESYS_KEY_PUBLIC_BLOB;
+
+/** Public area of NV indices shared by the objects of an ESYS context
+ *
+ * The nvIndex field is always zero, so that all indices with the same
+ * attributes, policy and size use the same entry.
+ */
+typedef struct IESYS_NV_PUBLIC_ENTRY {
+    TPMS_NV_PUBLIC                nvPublic; /**< The public area without the index */
+    size_t                        refCount; /**< The number of objects using the entry */
+    struct IESYS_NV_PUBLIC_ENTRY *next;     /**< The next entry of the hash bucket */
+} IESYS_NV_PUBLIC_ENTRY;
+
+/** Number of hash buckets for the NV public areas of an ESYS context */
+#define IESYS_NV_PUBLIC_BUCKETS 64
+
+/** Meta data of an ESYS_TR object
+ *
+ * The compact in-memory form of IESYS_RESOURCE: the resource specific
+ * information is kept out of line, so that objects only pay for what their
+ * type needs. Use iesys_rsrc_get() and iesys_rsrc_set() to convert between
+ * both forms.
+ */
+typedef struct {
+    TPM2_HANDLE          handle;   /**< Handle used by TPM */
+    TPM2B_NAME           name;     /**< TPM name of the object */
+    IESYSC_RESOURCE_TYPE rsrcType; /**< Selector for resource type */
+    union {
+        IESYS_KEY_PUBLIC_BLOB *rsrc_key_pub; /**< Public area of keys, may be NULL */
+        struct {
+            IESYS_NV_PUBLIC_ENTRY *entry;   /**< Shared public area, may be NULL */
+            TPMI_RH_NV_INDEX       nvIndex; /**< The index of the public area */
+        } rsrc_nv_pub;                      /**< Public area of NV indices */
+        IESYS_SESSION *rsrc_session;        /**< Session state, allocated for sessions */
+    } misc;                                 /**< Resource specific information */
+} IESYS_NODE_RSRC;
+
 /** Linked list type for object meta data.
  *
  * This structure represents a linked list to store meta data information of
@@ -29,8 +75,11 @@ typedef struct RSRC_NODE_T {
     ESYS_TR esys_handle;                 /**< The ESYS_TR handle used by the application
                                               to reference this entry. */
     TPM2B_AUTH          auth;            /**< The authValue for this resource object. */
-    IESYS_RESOURCE      rsrc;            /**< The meta data for this resource object. */
+    IESYS_NODE_RSRC     rsrc;            /**< The meta data for this resource object. */
     size_t              reference_count; /**< Reference Count for Esys_TR_FromTPMPublic */
+    UINT32              rm_command;      /**< Last command using the object, see IESYS_RM */
+    UINT16              rm_context_size; /**< The size of rm_context */
+    uint8_t            *rm_context;      /**< Marshaled TPMS_CONTEXT if swapped out */
     struct RSRC_NODE_T *next;            /**< The next object in the linked list. */
 } RSRC_NODE_T;
 
@@ -159,6 +208,69 @@ enum ESYS_STATE {
                                    ESAPI code. */
 };
 
+/** A memory block of the output arena, defined in esys_arena.c. */
+typedef struct IESYS_ARENA_BLOCK IESYS_ARENA_BLOCK;
+
+/** Bump allocator for the outputs of the _Finish functions.
+ *
+ * Enabled by Esys_ArenaEnable(). The blocks are kept across Esys_ArenaReset()
+ * and only released by Esys_Finalize() or when the arena is disabled.
+ */
+typedef struct {
+    size_t             block_size; /**< Size of new blocks, 0 if disabled */
+    IESYS_ARENA_BLOCK *first;      /**< The first block of the list */
+    IESYS_ARENA_BLOCK *current;    /**< The block allocations are taken from */
+} IESYS_ARENA;
+
+/** State of the embedded resource manager.
+ *
+ * Enabled by Esys_ResourceManagerEnable(). Transient objects and sessions
+ * beyond the limits are swapped out with TPM2_ContextSave. The swapping uses
+ * a SYS context of its own, so that it can happen while the command of the
+ * ESYS context is being prepared.
+ */
+typedef struct {
+    TSS2_SYS_CONTEXT *sys;          /**< SYS context for swapping, NULL if disabled */
+    UINT32            max_objects;  /**< Number of transient objects kept loaded */
+    UINT32            max_sessions; /**< Number of sessions kept loaded */
+    UINT32            command;      /**< Counter of the commands of the context */
+} IESYS_RM;
+
+/** Use of the name cache by the pending Esys_TR_FromTPMPublic */
+typedef enum {
+    IESYS_NAME_CACHE_NONE = 0, /**< The metadata is not related to the cache */
+    IESYS_NAME_CACHE_HIT,      /**< Taken from the cache, no command was sent */
+    IESYS_NAME_CACHE_VERIFY,   /**< Taken from the cache, verified by the TPM */
+    IESYS_NAME_CACHE_STORE     /**< Read from the TPM, to be stored on success */
+} IESYS_NAME_CACHE_STATE;
+
+/** A capability of the capability cache, merged from consecutive responses. */
+typedef struct {
+    TPMS_CAPABILITY_DATA data;     /**< The cached entries in ascending order */
+    UINT32               next;     /**< The first property not covered by data */
+    bool                 complete; /**< All invariant entries are cached */
+    bool                 overflow; /**< The entries do not fit, nothing is cached */
+} IESYS_CAP_CACHE_ENTRY;
+
+/** The number of capabilities held by the capability cache. */
+#define IESYS_CAP_CACHE_ENTRIES 4
+
+/** State of the capability cache.
+ *
+ * Enabled by Esys_CapabilityCacheEnable(). Caches the capabilities that do not
+ * change while the TPM is powered: the algorithms, commands, ECC curves and
+ * the TPM2_PT_FIXED properties.
+ */
+typedef struct {
+    IESYS_CAP_CACHE_ENTRY *entries;  /**< The cached capabilities, NULL if disabled */
+    IESYS_CAP_CACHE_ENTRY *pending;  /**< Entry of the pending query or NULL */
+    UINT32                 property; /**< The property of the pending query */
+    UINT32                 count;    /**< The propertyCount of the pending query */
+} IESYS_CAP_CACHE;
+
+/** State of the serialized mode, see Esys_SerializedModeEnable(). */
+typedef struct IESYS_THREADS IESYS_THREADS;
+
 /** The data structure holding internal state information.
  *
  * Each ESYS_CONTEXT respresents a logically independent connection to the TPM.
@@ -203,8 +315,20 @@ struct ESYS_CONTEXT {
     ESYS_TR sav_session2;
     ESYS_TR sav_session3;
 
-    ESYS_CRYPTO_CALLBACKS crypto_backend; /**< The backend function pointers to use
-                                              for crypto operations */
+    ESYS_CRYPTO_CALLBACKS  crypto_backend;   /**< The backend function pointers to use
+                                                 for crypto operations */
+    IESYS_RANDOM_POOL      random_pool;      /**< Random bytes for nonces and salts */
+    IESYS_PKEY_CACHE       pkey_cache;       /**< Converted public keys of tpmKeys */
+    IESYS_ARENA            arena;            /**< Storage for outputs in arena mode */
+    IESYS_RM               rm;               /**< The embedded resource manager */
+    char                  *name_cache_dir;   /**< Directory of the name cache or NULL */
+    uint32_t               name_cache_flags; /**< ESYS_NAME_CACHE_* flags */
+    IESYS_NAME_CACHE_STATE name_cache_state; /**< Name cache use of Esys_TR_FromTPMPublic */
+    UINT32                 nv_buffer_max;    /**< TPM2_PT_NV_BUFFER_MAX, 0 if not queried */
+    IESYS_CAP_CACHE        cap_cache;        /**< The capability cache */
+    IESYS_THREADS         *threads;          /**< Serialized mode, NULL if disabled */
+
+    IESYS_NV_PUBLIC_ENTRY *nv_publics[IESYS_NV_PUBLIC_BUCKETS]; /**< Interned NV public areas */
 };
 
 /** The number of authomatic resubmissions.
@@ -13,10 +13,12 @@
 #include "esys_crypto.h" // for iesys_crypto_hash_get_digest_size, iesys_cr...
 #include "esys_int.h"    // for RSRC_NODE_T, ESYS_CONTEXT, _ESYS_STATE_INIT
 #include "esys_iutil.h"
-#include "esys_mu.h"    // for FALSE
-#include "esys_types.h" // for IESYS_SESSION, IESYS_RESOURCE, IESYS_RSRC_U...
-#include "tss2_esys.h"  // for ESYS_CONTEXT, ESYS_TR, ESYS_TR_NONE, ESYS_C...
-#include "tss2_mu.h"    // for Tss2_MU_TPMI_ALG_HASH_Marshal, Tss2_MU_TPM2...
+#include "esys_mu.h"           // for FALSE
+#include "esys_types.h"        // for IESYS_SESSION, IESYS_RESOURCE, IESYS_RSRC_U...
+#include "tss2_esys.h"         // for ESYS_CONTEXT, ESYS_TR, ESYS_TR_NONE, ESYS_C...
+#include "tss2_mu.h"           // for Tss2_MU_TPMI_ALG_HASH_Marshal, Tss2_MU_TPM2...
+#include "util/probe.h"        // for TSS2_PROBE1, TSS2_PROBE2
+#include "util/tpm2_cc_info.h" // for tpm2_cc_info_get, TPM2_CC_INFO
 
 #define LOGMODULE esys
 #include "util/log.h" // for return_if_error, LOG_ERROR, LOG_TRACE, goto...
@@ -124,6 +126,20 @@ init_session_tab(ESYS_CONTEXT *esys_context, ESYS_TR shandle1, ESYS_TR shandle2,
     return r;
 }
 
+/** Delete a resource object.
+ *
+ * The crypto state cached for a session is released and the object is freed.
+ * The object has to be removed from the linked list of the esys context before.
+ * @param[in,out] esys_context The ESYS_CONTEXT
+ * @param[in] node The resource object to delete.
+ */
+void
+iesys_DeleteResourceObject(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node) {
+    iesys_rsrc_clear(esys_context, node);
+    free(node->rm_context);
+    free(node);
+}
+
 /** Delete all resource objects stored in the esys context.
  *
  * All resource objects stored in a linked list of the esys context are deleted.
@@ -135,7 +151,7 @@ iesys_DeleteAllResourceObjects(ESYS_CONTEXT *esys_context) {
     RSRC_NODE_T *next_node_rsrc;
     for (node_rsrc = esys_context->rsrc_list; node_rsrc != NULL; node_rsrc = next_node_rsrc) {
         next_node_rsrc = node_rsrc->next;
-        free(node_rsrc);
+        iesys_DeleteResourceObject(esys_context, node_rsrc);
     }
     esys_context->rsrc_list = NULL;
 }
@@ -157,14 +173,14 @@ iesys_compute_encrypt_nonce(ESYS_CONTEXT *esys_context,
     for (int i = 0; i < 3; i++) {
         RSRC_NODE_T *session = esys_context->session_tab[i];
         if (session != NULL) {
-            if (session->rsrc.misc.rsrc_session.sessionAttributes & TPMA_SESSION_ENCRYPT) {
+            if (session->rsrc.misc.rsrc_session->sessionAttributes & TPMA_SESSION_ENCRYPT) {
                 if (*encryptNonce != NULL) {
                     /* Encrypt nonce already found */
                     return_error(TSS2_ESYS_RC_MULTIPLE_ENCRYPT_SESSIONS,
                                  "More than one encrypt session");
                 }
                 *encryptNonceIdx = i;
-                *encryptNonce = &session->rsrc.misc.rsrc_session.nonceTPM;
+                *encryptNonce = &session->rsrc.misc.rsrc_session->nonceTPM;
             }
         }
     }
@@ -199,6 +215,7 @@ esys_CreateResourceObject(ESYS_CONTEXT *esys_context,
     }
     *esys_object = new_esys_object;
     new_esys_object->esys_handle = esys_handle;
+    new_esys_object->rm_command = esys_context->rm.command;
     return TSS2_RC_SUCCESS;
 }
 
@@ -381,42 +398,44 @@ iesys_compute_encrypted_salt(ESYS_CONTEXT           *esys_context,
         return TSS2_RC_SUCCESS;
     }
 
-    TPM2B_PUBLIC pub = tpmKeyNode->rsrc.misc.rsrc_key_pub;
+    TPM2B_PUBLIC pub;
     if (tpmKeyNode->rsrc.rsrcType != IESYSC_KEY_RSRC) {
         LOG_TRACE("Public info needed.");
         return TSS2_ESYS_RC_BAD_VALUE;
     }
-    r = iesys_crypto_hash_get_digest_size(tpmKeyNode->rsrc.misc.rsrc_key_pub.publicArea.nameAlg,
-                                          &keyHash_size);
+    r = iesys_rsrc_key_public(tpmKeyNode, &pub);
+    return_if_error(r, "Get public area.");
+    r = iesys_crypto_hash_get_digest_size(pub.publicArea.nameAlg, &keyHash_size);
     return_if_error(r, "Hash algorithm not supported.");
 
     switch (pub.publicArea.type) {
     case TPM2_ALG_RSA:
 
-        r = iesys_crypto_get_random2b(&esys_context->crypto_backend,
-                                      (TPM2B_NONCE *)&esys_context->salt, keyHash_size);
+        r = iesys_crypto_get_random2b_pooled(&esys_context->crypto_backend,
+                                             &esys_context->random_pool,
+                                             (TPM2B_NONCE *)&esys_context->salt, keyHash_size);
         return_if_error(r, "During getrandom.");
 
         /* When encrypting salts, the encryption scheme of a key is ignored and
            TPM2_ALG_OAEP is always used. */
         pub.publicArea.parameters.rsaDetail.scheme.scheme = TPM2_ALG_OAEP;
-        r = iesys_crypto_rsa_pk_encrypt(
-            &esys_context->crypto_backend, &pub, keyHash_size, &esys_context->salt.buffer[0],
-            sizeof(TPMU_ENCRYPTED_SECRET), (BYTE *)&encryptedSalt->secret[0], &cSize, "SECRET");
+        r = iesys_crypto_rsa_pk_encrypt_cached(
+            &esys_context->crypto_backend, &esys_context->pkey_cache, &tpmKeyNode->rsrc.name, &pub,
+            keyHash_size, &esys_context->salt.buffer[0], sizeof(TPMU_ENCRYPTED_SECRET),
+            (BYTE *)&encryptedSalt->secret[0], &cSize, "SECRET");
         return_if_error(r, "During encryption.");
         LOGBLOB_DEBUG(&encryptedSalt->secret[0], cSize, "IESYS encrypted salt");
         encryptedSalt->size = cSize;
         break;
     case TPM2_ALG_ECC:
-        r = iesys_crypto_get_ecdh_point(&esys_context->crypto_backend, &pub,
-                                        sizeof(TPMU_ENCRYPTED_SECRET), &Z, &Q,
-                                        (BYTE *)&encryptedSalt->secret[0], &cSize);
+        r = iesys_crypto_get_ecdh_point_cached(
+            &esys_context->crypto_backend, &esys_context->pkey_cache, &tpmKeyNode->rsrc.name, &pub,
+            sizeof(TPMU_ENCRYPTED_SECRET), &Z, &Q, (BYTE *)&encryptedSalt->secret[0], &cSize);
         return_if_error(r, "During computation of ECC public key.");
         encryptedSalt->size = cSize;
 
         /* Compute salt from Z with KDFe */
-        r = iesys_crypto_KDFe(&esys_context->crypto_backend,
-                              tpmKeyNode->rsrc.misc.rsrc_key_pub.publicArea.nameAlg, &Z, "SECRET",
+        r = iesys_crypto_KDFe(&esys_context->crypto_backend, pub.publicArea.nameAlg, &Z, "SECRET",
                               &Q.x, &pub.publicArea.unique.ecc.x, keyHash_size * 8,
                               &esys_context->salt.buffer[0]);
         return_if_error(r, "During KDFe computation.");
@@ -448,9 +467,10 @@ iesys_gen_caller_nonces(ESYS_CONTEXT *esys_context) {
         if (session == NULL)
             continue;
 
-        r = iesys_crypto_get_random2b(&esys_context->crypto_backend,
-                                      &session->rsrc.misc.rsrc_session.nonceCaller,
-                                      session->rsrc.misc.rsrc_session.nonceCaller.size);
+        r = iesys_crypto_get_random2b_pooled(&esys_context->crypto_backend,
+                                             &esys_context->random_pool,
+                                             &session->rsrc.misc.rsrc_session->nonceCaller,
+                                             session->rsrc.misc.rsrc_session->nonceCaller.size);
         return_if_error(r, "Error: computing caller nonce.");
     }
     return TSS2_RC_SUCCESS;
@@ -465,22 +485,39 @@ iesys_gen_caller_nonces(ESYS_CONTEXT *esys_context) {
  */
 static void
 iesys_update_session_flags(ESYS_CONTEXT *esys_context, IESYS_SESSION *rsrc_session) {
-    TSS2_RC        r = TSS2_RC_SUCCESS;
-    size_t         param_size;
-    const uint8_t *param_buffer;
+    TSS2_RC             r = TSS2_RC_SUCCESS;
+    size_t              param_size;
+    const uint8_t      *param_buffer;
+    uint8_t             ccBuffer[4];
+    const TPM2_CC_INFO *info = NULL;
+    bool                decrypt_allowed, encrypt_allowed;
 
     LOG_DEBUG("Checking if command supports enc/dec");
 
     rsrc_session->origSessionAttributes = rsrc_session->sessionAttributes;
 
-    r = Tss2_Sys_GetDecryptParam(esys_context->sys, &param_size, &param_buffer);
-    if (r == TSS2_SYS_RC_NO_DECRYPT_PARAM) {
+    r = Tss2_Sys_GetCommandCode(esys_context->sys, &ccBuffer[0]);
+    if (r == TSS2_RC_SUCCESS)
+        info = tpm2_cc_info_get((TPM2_CC)ccBuffer[0] << 24 | (TPM2_CC)ccBuffer[1] << 16
+                                | (TPM2_CC)ccBuffer[2] << 8 | ccBuffer[3]);
+
+    if (info) {
+        decrypt_allowed = info->decryptAllowed;
+        encrypt_allowed = info->encryptAllowed;
+    } else {
+        /* Vendor commands are not part of the command table, ask SAPI. */
+        r = Tss2_Sys_GetDecryptParam(esys_context->sys, &param_size, &param_buffer);
+        decrypt_allowed = (r != TSS2_SYS_RC_NO_DECRYPT_PARAM);
+        r = Tss2_Sys_GetEncryptParam(esys_context->sys, &param_size, &param_buffer);
+        encrypt_allowed = (r != TSS2_SYS_RC_NO_ENCRYPT_PARAM);
+    }
+
+    if (!decrypt_allowed) {
         LOG_DEBUG("clear TPMA_SESSION_DECRYPT flag");
         rsrc_session->sessionAttributes &= ~(TPMA_SESSION_DECRYPT);
     }
 
-    r = Tss2_Sys_GetEncryptParam(esys_context->sys, &param_size, &param_buffer);
-    if (r == TSS2_SYS_RC_NO_ENCRYPT_PARAM) {
+    if (!encrypt_allowed) {
         LOG_DEBUG("clear TPMA_SESSION_ENCRYPT flag");
         rsrc_session->sessionAttributes &= ~(TPMA_SESSION_ENCRYPT);
     }
@@ -503,7 +540,7 @@ iesys_restore_session_flags(ESYS_CONTEXT *esys_context) {
         RSRC_NODE_T *session = esys_context->session_tab[i];
         if (session == NULL)
             continue;
-        IESYS_SESSION *rsrc_session = &session->rsrc.misc.rsrc_session;
+        IESYS_SESSION *rsrc_session = session->rsrc.misc.rsrc_session;
         LOG_DEBUG("Orig Session %i Attrs 0x%" PRIx8 ", altered Attrs x%" PRIx8, i,
                   rsrc_session->origSessionAttributes, rsrc_session->sessionAttributes);
 
@@ -538,7 +575,7 @@ iesys_encrypt_param(ESYS_CONTEXT *esys_context, TPM2B_NONCE **decryptNonce, int
         RSRC_NODE_T *session = esys_context->session_tab[i];
         if (session == NULL)
             continue;
-        IESYS_SESSION *rsrc_session = &session->rsrc.misc.rsrc_session;
+        IESYS_SESSION *rsrc_session = session->rsrc.misc.rsrc_session;
         if (rsrc_session->sessionAttributes & TPMA_SESSION_ENCRYPT)
             return_if_notnull(encryptNonce, "More than one encrypt session",
                               TSS2_ESYS_RC_MULTIPLE_ENCRYPT_SESSIONS);
@@ -553,7 +590,7 @@ iesys_encrypt_param(ESYS_CONTEXT *esys_context, TPM2B_NONCE **decryptNonce, int
         RSRC_NODE_T *session = esys_context->session_tab[i];
         if (session == NULL)
             continue;
-        IESYS_SESSION *rsrc_session = &session->rsrc.misc.rsrc_session;
+        IESYS_SESSION *rsrc_session = session->rsrc.misc.rsrc_session;
         TPMT_SYM_DEF  *symDef = &rsrc_session->symmetric;
 
         if (rsrc_session->sessionAttributes & TPMA_SESSION_ENCRYPT) {
@@ -573,18 +610,17 @@ iesys_encrypt_param(ESYS_CONTEXT *esys_context, TPM2B_NONCE **decryptNonce, int
             size_t key_len = TPM2_MAX_SYM_KEY_BYTES + TPM2_MAX_SYM_BLOCK_SIZE;
             if (key_len % hlen > 0)
                 key_len = key_len + hlen - (key_len % hlen);
-            uint8_t        symKey[key_len];
-            size_t         paramSize = 0;
-            const uint8_t *paramBuffer;
+            uint8_t  symKey[key_len];
+            size_t   paramSize = 0;
+            uint8_t *paramBuffer;
 
-            r = Tss2_Sys_GetDecryptParam(esys_context->sys, &paramSize, &paramBuffer);
+            /* The parameter is encrypted in place in the command buffer */
+            r = Tss2_Sys_GetDecryptParamMutable(esys_context->sys, &paramSize, &paramBuffer);
             return_if_error(r, "Encryption not possible");
 
             if (paramSize == 0)
                 continue;
 
-            BYTE encrypt_buffer[paramSize];
-            memcpy(&encrypt_buffer[0], paramBuffer, paramSize);
             LOGBLOB_DEBUG(paramBuffer, paramSize, "param to encrypt");
 
             /* AES encryption with key derived with KDFa */
@@ -593,16 +629,17 @@ iesys_encrypt_param(ESYS_CONTEXT *esys_context, TPM2B_NONCE **decryptNonce, int
                     return_error(TSS2_ESYS_RC_BAD_VALUE, "Invalid symmetric mode (must be CFB)");
                 }
                 r = iesys_crypto_KDFa(
-                    &esys_context->crypto_backend, rsrc_session->authHash,
-                    &rsrc_session->sessionValue[0], rsrc_session->sizeSessionValue, "CFB",
-                    &rsrc_session->nonceCaller, &rsrc_session->nonceTPM,
-                    symDef->keyBits.aes + AES_BLOCK_SIZE_IN_BYTES * 8, NULL, &symKey[0], FALSE);
+                    &esys_context->crypto_backend, &rsrc_session->kdfKeyCache,
+                    rsrc_session->authHash, &rsrc_session->sessionValue[0],
+                    rsrc_session->sizeSessionValue, "CFB", &rsrc_session->nonceCaller,
+                    &rsrc_session->nonceTPM, symDef->keyBits.aes + AES_BLOCK_SIZE_IN_BYTES * 8,
+                    NULL, &symKey[0], FALSE);
                 return_if_error(r, "while computing KDFa");
 
                 size_t aes_off = (symDef->keyBits.aes + 7) / 8;
                 r = iesys_crypto_aes_encrypt(&esys_context->crypto_backend, &symKey[0],
                                              symDef->algorithm, symDef->keyBits.aes,
-                                             symDef->mode.aes, &encrypt_buffer[0], paramSize,
+                                             symDef->mode.aes, paramBuffer, paramSize,
                                              &symKey[aes_off]);
                 return_if_error(r, "AES encryption not possible");
             } else if (symDef->algorithm == TPM2_ALG_SM4) {
@@ -611,34 +648,33 @@ iesys_encrypt_param(ESYS_CONTEXT *esys_context, TPM2B_NONCE **decryptNonce, int
                     return_error(TSS2_ESYS_RC_BAD_VALUE, "Invalid symmetric mode (must be CFB)");
                 }
                 r = iesys_crypto_KDFa(
-                    &esys_context->crypto_backend, rsrc_session->authHash,
-                    &rsrc_session->sessionValue[0], rsrc_session->sizeSessionValue, "CFB",
-                    &rsrc_session->nonceCaller, &rsrc_session->nonceTPM,
-                    symDef->keyBits.sm4 + SM4_BLOCK_SIZE_IN_BYTES * 8, NULL, &symKey[0], FALSE);
+                    &esys_context->crypto_backend, &rsrc_session->kdfKeyCache,
+                    rsrc_session->authHash, &rsrc_session->sessionValue[0],
+                    rsrc_session->sizeSessionValue, "CFB", &rsrc_session->nonceCaller,
+                    &rsrc_session->nonceTPM, symDef->keyBits.sm4 + SM4_BLOCK_SIZE_IN_BYTES * 8,
+                    NULL, &symKey[0], FALSE);
                 return_if_error(r, "while computing KDFa");
 
                 size_t sm4_off = (symDef->keyBits.sm4 + 7) / 8;
                 r = iesys_crypto_sm4_encrypt(&esys_context->crypto_backend, &symKey[0],
                                              symDef->algorithm, symDef->keyBits.sm4,
-                                             symDef->mode.sm4, &encrypt_buffer[0], paramSize,
+                                             symDef->mode.sm4, paramBuffer, paramSize,
                                              &symKey[sm4_off]);
                 return_if_error(r, "SM4 encryption not possible");
             }
             /* XOR obfuscation of parameter */
             else if (symDef->algorithm == TPM2_ALG_XOR) {
                 r = iesys_xor_parameter_obfuscation(
-                    &esys_context->crypto_backend, rsrc_session->authHash,
-                    &rsrc_session->sessionValue[0], rsrc_session->sizeSessionValue,
-                    &rsrc_session->nonceCaller, &rsrc_session->nonceTPM, &encrypt_buffer[0],
-                    paramSize);
+                    &esys_context->crypto_backend, &rsrc_session->kdfKeyCache,
+                    rsrc_session->authHash, &rsrc_session->sessionValue[0],
+                    rsrc_session->sizeSessionValue,
+                    &rsrc_session->nonceCaller, &rsrc_session->nonceTPM, paramBuffer, paramSize);
                 return_if_error(r, "XOR obfuscation not possible.");
 
             } else {
                 return_error(TSS2_ESYS_RC_BAD_VALUE,
                              "Invalid symmetric algorithm (should be XOR, AES, or SM4)");
             }
-            r = Tss2_Sys_SetDecryptParam(esys_context->sys, paramSize, &encrypt_buffer[0]);
-            return_if_error(r, "Set encrypt parameter not possible");
         }
     }
     return r;
@@ -660,7 +696,7 @@ iesys_encrypt_param(ESYS_CONTEXT *esys_context, TPM2B_NONCE **decryptNonce, int
 TSS2_RC
 iesys_decrypt_param(ESYS_CONTEXT *esys_context) {
     TSS2_RC        r;
-    const uint8_t *ciphertext;
+    uint8_t       *param;
     size_t         p2BSize;
     size_t         hlen;
     RSRC_NODE_T   *session;
@@ -669,7 +705,7 @@ iesys_decrypt_param(ESYS_CONTEXT *esys_context) {
     size_t         key_len = TPM2_MAX_SYM_KEY_BYTES + TPM2_MAX_SYM_BLOCK_SIZE;
 
     session = esys_context->session_tab[esys_context->encryptNonceIdx];
-    rsrc_session = &session->rsrc.misc.rsrc_session;
+    rsrc_session = session->rsrc.misc.rsrc_session;
     symDef = &rsrc_session->symmetric;
 
     r = iesys_crypto_hash_get_digest_size(rsrc_session->authHash, &hlen);
@@ -679,12 +715,10 @@ iesys_decrypt_param(ESYS_CONTEXT *esys_context) {
 
     uint8_t symKey[key_len];
 
-    r = Tss2_Sys_GetEncryptParam(esys_context->sys, &p2BSize, &ciphertext);
+    /* The parameter is decrypted in place in the response buffer */
+    r = Tss2_Sys_GetEncryptParamMutable(esys_context->sys, &p2BSize, &param);
     return_if_error(r, "Getting encrypt param");
 
-    UINT8 plaintext[p2BSize];
-    memcpy(&plaintext[0], ciphertext, p2BSize);
-
     if (symDef->algorithm == TPM2_ALG_AES) {
         /* Parameter decryption with a symmetric AES key derived by KDFa */
         if (symDef->mode.aes != TPM2_ALG_CFB) {
@@ -693,9 +727,10 @@ iesys_decrypt_param(ESYS_CONTEXT *esys_context) {
         LOGBLOB_DEBUG(&rsrc_session->sessionKey.buffer[0], rsrc_session->sessionKey.size,
                       "IESYS encrypt session key");
 
-        r = iesys_crypto_KDFa(&esys_context->crypto_backend, rsrc_session->authHash,
-                              &rsrc_session->sessionValue[0], rsrc_session->sizeSessionValue, "CFB",
-                              &rsrc_session->nonceTPM, &rsrc_session->nonceCaller,
+        r = iesys_crypto_KDFa(&esys_context->crypto_backend, &rsrc_session->kdfKeyCache,
+                              rsrc_session->authHash, &rsrc_session->sessionValue[0],
+                              rsrc_session->sizeSessionValue, "CFB", &rsrc_session->nonceTPM,
+                              &rsrc_session->nonceCaller,
                               symDef->keyBits.aes + AES_BLOCK_SIZE_IN_BYTES * 8, NULL, &symKey[0],
                               FALSE);
         return_if_error(r, "KDFa error");
@@ -704,12 +739,9 @@ iesys_decrypt_param(ESYS_CONTEXT *esys_context) {
 
         size_t aes_off = (symDef->keyBits.aes + 7) / 8;
         r = iesys_crypto_aes_decrypt(&esys_context->crypto_backend, &symKey[0], symDef->algorithm,
-                                     symDef->keyBits.aes, symDef->mode.aes, &plaintext[0], p2BSize,
+                                     symDef->keyBits.aes, symDef->mode.aes, param, p2BSize,
                                      &symKey[aes_off]);
         return_if_error(r, "Decryption error");
-
-        r = Tss2_Sys_SetEncryptParam(esys_context->sys, p2BSize, &plaintext[0]);
-        return_if_error(r, "Setting plaintext");
     } else if (symDef->algorithm == TPM2_ALG_SM4) {
         /* Parameter decryption with a symmetric SM4 key derived by KDFa */
         if (symDef->mode.sm4 != TPM2_ALG_CFB) {
@@ -718,9 +750,10 @@ iesys_decrypt_param(ESYS_CONTEXT *esys_context) {
         LOGBLOB_DEBUG(&rsrc_session->sessionKey.buffer[0], rsrc_session->sessionKey.size,
                       "IESYS encrypt session key");
 
-        r = iesys_crypto_KDFa(&esys_context->crypto_backend, rsrc_session->authHash,
-                              &rsrc_session->sessionValue[0], rsrc_session->sizeSessionValue, "CFB",
-                              &rsrc_session->nonceTPM, &rsrc_session->nonceCaller,
+        r = iesys_crypto_KDFa(&esys_context->crypto_backend, &rsrc_session->kdfKeyCache,
+                              rsrc_session->authHash, &rsrc_session->sessionValue[0],
+                              rsrc_session->sizeSessionValue, "CFB", &rsrc_session->nonceTPM,
+                              &rsrc_session->nonceCaller,
                               symDef->keyBits.sm4 + SM4_BLOCK_SIZE_IN_BYTES * 8, NULL, &symKey[0],
                               FALSE);
         return_if_error(r, "KDFa error");
@@ -729,22 +762,16 @@ iesys_decrypt_param(ESYS_CONTEXT *esys_context) {
 
         size_t sm4_off = (symDef->keyBits.sm4 + 7) / 8;
         r = iesys_crypto_sm4_decrypt(&esys_context->crypto_backend, &symKey[0], symDef->algorithm,
-                                     symDef->keyBits.sm4, symDef->mode.sm4, &plaintext[0], p2BSize,
+                                     symDef->keyBits.sm4, symDef->mode.sm4, param, p2BSize,
                                      &symKey[sm4_off]);
         return_if_error(r, "Decryption error");
-
-        r = Tss2_Sys_SetEncryptParam(esys_context->sys, p2BSize, &plaintext[0]);
-        return_if_error(r, "Setting plaintext");
     } else if (symDef->algorithm == TPM2_ALG_XOR) {
         /* Parameter decryption with XOR obfuscation */
-        r = iesys_xor_parameter_obfuscation(&esys_context->crypto_backend, rsrc_session->authHash,
-                                            &rsrc_session->sessionValue[0],
-                                            rsrc_session->sizeSessionValue, &rsrc_session->nonceTPM,
-                                            &rsrc_session->nonceCaller, &plaintext[0], p2BSize);
+        r = iesys_xor_parameter_obfuscation(
+            &esys_context->crypto_backend, &rsrc_session->kdfKeyCache, rsrc_session->authHash,
+            &rsrc_session->sessionValue[0], rsrc_session->sizeSessionValue,
+            &rsrc_session->nonceTPM, &rsrc_session->nonceCaller, param, p2BSize);
         return_if_error(r, "XOR obfuscation not possible.");
-
-        r = Tss2_Sys_SetEncryptParam(esys_context->sys, p2BSize, &plaintext[0]);
-        return_if_error(r, "Setting plaintext");
     } else {
         return_error(TSS2_ESYS_RC_BAD_VALUE,
                      "Invalid symmetric algorithm (should be XOR, AES, or SM4)");
@@ -815,7 +842,7 @@ iesys_check_rp_hmacs(ESYS_CONTEXT *esys_context, TSS2L_SYS_AUTH_RESPONSE *rspAut
         if (session == NULL)
             continue;
 
-        IESYS_SESSION *rsrc_session = &session->rsrc.misc.rsrc_session;
+        IESYS_SESSION *rsrc_session = session->rsrc.misc.rsrc_session;
         if (rsrc_session->type_policy_session == POLICY_PASSWORD) {
             /* A policy password session has no auth value */
             if (rspAuths->auths[i].hmac.size != 0) {
@@ -826,7 +853,7 @@ iesys_check_rp_hmacs(ESYS_CONTEXT *esys_context, TSS2L_SYS_AUTH_RESPONSE *rspAut
         }
 
         rp_digest_size = sizeof(TPMU_HA);
-        r = iesys_compute_rp_hash(esys_context, session->rsrc.misc.rsrc_session.authHash,
+        r = iesys_compute_rp_hash(esys_context, session->rsrc.misc.rsrc_session->authHash,
                                   &rp_digest[0], &rp_digest_size);
         return_if_error(r, "crypto rpHash");
 
@@ -835,9 +862,10 @@ iesys_check_rp_hmacs(ESYS_CONTEXT *esys_context, TSS2L_SYS_AUTH_RESPONSE *rspAut
         rsrc_session->nonceTPM = rspAuths->auths[i].nonce;
         rsrc_session->sessionAttributes = rspAuths->auths[i].sessionAttributes;
         r = iesys_crypto_authHmac(
-            &esys_context->crypto_backend, rsrc_session->authHash, &rsrc_session->sessionValue[0],
-            rsrc_session->sizeHmacValue, &rp_digest[0], rp_digest_size, &rsrc_session->nonceTPM,
-            &rsrc_session->nonceCaller, NULL, NULL, rspAuths->auths[i].sessionAttributes, &rp_hmac);
+            &esys_context->crypto_backend, &rsrc_session->hmacKeyCache, rsrc_session->authHash,
+            &rsrc_session->sessionValue[0], rsrc_session->sizeHmacValue, &rp_digest[0],
+            rp_digest_size, &rsrc_session->nonceTPM, &rsrc_session->nonceCaller, NULL, NULL,
+            rspAuths->auths[i].sessionAttributes, &rp_hmac);
         return_if_error(r, "HMAC error");
 
         if (!cmp_TPM2B_AUTH(&rspAuths->auths[i].hmac, &rp_hmac)) {
@@ -880,11 +908,50 @@ iesys_compute_bound_entity(const TPM2B_NAME *name,
 bool
 iesys_is_object_bound(const TPM2B_NAME *name, const TPM2B_AUTH *auth, RSRC_NODE_T *session) {
     TPM2B_NAME tmp;
-    if (session->rsrc.misc.rsrc_session.bound_entity.size == 0)
+    if (session->rsrc.misc.rsrc_session->bound_entity.size == 0)
         /* No bind session */
         return false;
     iesys_compute_bound_entity(name, auth, &tmp);
-    return cmp_TPM2B_NAME(&session->rsrc.misc.rsrc_session.bound_entity, &tmp);
+    return cmp_TPM2B_NAME(&session->rsrc.misc.rsrc_session->bound_entity, &tmp);
+}
+
+static void
+compute_session_value(RSRC_NODE_T      *session,
+                      const TPM2B_NAME *name,
+                      const TPM2B_AUTH *auth_value) {
+    IESYS_SESSION *rsrc_session = session->rsrc.misc.rsrc_session;
+
+    /* First the session Key is copied into the sessionValue */
+    rsrc_session->sizeSessionValue = rsrc_session->sessionKey.size;
+    memcpy(&rsrc_session->sessionValue[0], &rsrc_session->sessionKey.buffer[0],
+           rsrc_session->sessionKey.size);
+
+    /* This requires an HMAC Session and not a password session */
+    if (rsrc_session->sessionType != TPM2_SE_HMAC && rsrc_session->sessionType != TPM2_SE_POLICY)
+        return;
+
+    rsrc_session->sizeHmacValue = rsrc_session->sizeSessionValue;
+
+    if (name == NULL || auth_value == NULL)
+        return;
+
+    /* The auth value is appended to the session key */
+    memcpy(&rsrc_session->sessionValue[rsrc_session->sessionKey.size], &auth_value->buffer[0],
+           auth_value->size);
+    rsrc_session->sizeSessionValue += auth_value->size;
+
+    /* Then if we are a bound session, the auth value is not appended to the end
+       of the session value for HMAC computation. The size of the key will not be
+       increased.*/
+    if (iesys_is_object_bound(name, auth_value, session))
+        return;
+
+    /* type_policy_session set to POLICY_AUTH by command PolicyAuthValue */
+    if (rsrc_session->sessionType == TPM2_SE_POLICY
+        && rsrc_session->type_policy_session != POLICY_AUTH)
+        return;
+
+    rsrc_session->sizeHmacValue += auth_value->size;
 }
 
 /**
@@ -914,42 +981,21 @@ iesys_compute_session_value(RSRC_NODE_T      *session,
     if (session == NULL)
         return;
 
-    /* First the session Key is copied into the sessionValue */
-    session->rsrc.misc.rsrc_session.sizeSessionValue
-        = session->rsrc.misc.rsrc_session.sessionKey.size;
-    memcpy(&session->rsrc.misc.rsrc_session.sessionValue[0],
-           &session->rsrc.misc.rsrc_session.sessionKey.buffer[0],
-           session->rsrc.misc.rsrc_session.sessionKey.size);
-
-    /* This requires an HMAC Session and not a password session */
-    if (session->rsrc.misc.rsrc_session.sessionType != TPM2_SE_HMAC
-        && session->rsrc.misc.rsrc_session.sessionType != TPM2_SE_POLICY)
-        return;
-
-    session->rsrc.misc.rsrc_session.sizeHmacValue
-        = session->rsrc.misc.rsrc_session.sizeSessionValue;
-
-    if (name == NULL || auth_value == NULL)
-        return;
-
-    /* The auth value is appended to the session key */
-    memcpy(&session->rsrc.misc.rsrc_session
-                .sessionValue[session->rsrc.misc.rsrc_session.sessionKey.size],
-           &auth_value->buffer[0], auth_value->size);
-    session->rsrc.misc.rsrc_session.sizeSessionValue += auth_value->size;
-
-    /* Then if we are a bound session, the auth value is not appended to the end
-       of the session value for HMAC computation. The size of the key will not be
-       increased.*/
-    if (iesys_is_object_bound(name, auth_value, session))
-        return;
-
-    /* type_policy_session set to POLICY_AUTH by command PolicyAuthValue */
-    if (session->rsrc.misc.rsrc_session.sessionType == TPM2_SE_POLICY
-        && session->rsrc.misc.rsrc_session.type_policy_session != POLICY_AUTH)
-        return;
-
-    session->rsrc.misc.rsrc_session.sizeHmacValue += auth_value->size;
+    IESYS_SESSION *rsrc_session = session->rsrc.misc.rsrc_session;
+    UINT16         sizeSessionValue = rsrc_session->sizeSessionValue;
+    UINT16         sizeHmacValue = rsrc_session->sizeHmacValue;
+    BYTE           sessionValue[sizeof(rsrc_session->sessionValue)];
+
+    memcpy(&sessionValue[0], &rsrc_session->sessionValue[0], sizeof(sessionValue));
+    compute_session_value(session, name, auth_value);
+
+    /* The keyed HMAC states cached for the session are only valid for the old value */
+    if (sizeHmacValue != rsrc_session->sizeHmacValue
+        || memcmp(&sessionValue[0], &rsrc_session->sessionValue[0], sizeHmacValue) != 0)
+        iesys_crypto_hmac_cache_invalidate(&rsrc_session->hmacKeyCache);
+    if (sizeSessionValue != rsrc_session->sizeSessionValue
+        || memcmp(&sessionValue[0], &rsrc_session->sessionValue[0], sizeSessionValue) != 0)
+        iesys_crypto_hmac_cache_invalidate(&rsrc_session->kdfKeyCache);
 }
 
 /**
@@ -995,7 +1041,7 @@ esys_GetResourceObject(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, RSRC_NOD
          esys_object_aux = esys_object_aux->next) {
         if (esys_object_aux->esys_handle == esys_handle) {
             *esys_object = esys_object_aux;
-            return TPM2_RC_SUCCESS;
+            return iesys_rm_use(esys_context, esys_object_aux);
         }
     }
 
@@ -1033,7 +1079,8 @@ esys_GetResourceObject(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, RSRC_NOD
  * This function will check that the sequence of invocations to the esys context
  * was such that an _async function can be called. This means that the internal
  * @state field is either @ESYS_STATE_INIT, @_ESYS_STATE_ERRORRESPONSE,
- * @_ESYS_STATE_FINISHED.
+ * @_ESYS_STATE_FINISHED. In serialized mode the calling thread must hold the
+ * command slot of the context.
  * @param[in,out] esys_context The esys context to issue the command on.
  * @retval TSS2_RC_SUCCESS on success.
  * @retval TSS2_RC_BAD_SEQUENCE if context is not ready for this function.
@@ -1045,11 +1092,17 @@ iesys_check_sequence_async(ESYS_CONTEXT *esys_context) {
         return TSS2_ESYS_RC_BAD_REFERENCE;
     }
 
+    if (!iesys_thread_owned(esys_context)) {
+        LOG_ERROR("Only synchronous calls are allowed in serialized mode.");
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+
     if (esys_context->state != ESYS_STATE_INIT && esys_context->state != ESYS_STATE_RESUBMISSION) {
         LOG_ERROR("Esys called in bad sequence.");
         return TSS2_ESYS_RC_BAD_SEQUENCE;
     }
     esys_context->submissionCount = 1;
+    esys_context->rm.command++;
     return TSS2_RC_SUCCESS;
 }
 
@@ -1164,7 +1217,7 @@ iesys_compute_hmac(ESYS_CONTEXT      *esys_context,
     size_t  cp_hash_size;
 
     if (session != NULL) {
-        IESYS_SESSION *rsrc_session = &session->rsrc.misc.rsrc_session;
+        IESYS_SESSION *rsrc_session = session->rsrc.misc.rsrc_session;
         r = iesys_crypto_hash_get_digest_size(rsrc_session->authHash, &authHash_size);
         return_if_error(r, "Initializing auth session");
 
@@ -1175,11 +1228,11 @@ iesys_compute_hmac(ESYS_CONTEXT      *esys_context,
         /* if other than first session is used for for parameter encryption
            the corresponding nonces have to be included into the hmac
            computation of the first session */
-        r = iesys_crypto_authHmac(&esys_context->crypto_backend, rsrc_session->authHash,
-                                  &rsrc_session->sessionValue[0], rsrc_session->sizeHmacValue,
-                                  &cp_hash[0], cp_hash_size, &rsrc_session->nonceCaller,
-                                  &rsrc_session->nonceTPM, decryptNonce, encryptNonce,
-                                  rsrc_session->sessionAttributes, &auth->hmac);
+        r = iesys_crypto_authHmac(&esys_context->crypto_backend, &rsrc_session->hmacKeyCache,
+                                  rsrc_session->authHash, &rsrc_session->sessionValue[0],
+                                  rsrc_session->sizeHmacValue, &cp_hash[0], cp_hash_size,
+                                  &rsrc_session->nonceCaller, &rsrc_session->nonceTPM, decryptNonce,
+                                  encryptNonce, rsrc_session->sessionAttributes, &auth->hmac);
         return_if_error(r, "HMAC error");
         auth->sessionHandle = session->rsrc.handle;
         auth->nonce = rsrc_session->nonceCaller;
@@ -1204,12 +1257,12 @@ iesys_compute_hmac(ESYS_CONTEXT      *esys_context,
  * @retval TSS2_ESYS_RC_NOT_IMPLEMENTED if hash algorithm is not implemented.
  * @retval TSS2_SYS_RC_* for SAPI errors.
  */
-TSS2_RC
-iesys_gen_auths(ESYS_CONTEXT           *esys_context,
-                RSRC_NODE_T            *h1,
-                RSRC_NODE_T            *h2,
-                RSRC_NODE_T            *h3,
-                TSS2L_SYS_AUTH_COMMAND *auths) {
+static TSS2_RC
+gen_auths(ESYS_CONTEXT           *esys_context,
+          RSRC_NODE_T            *h1,
+          RSRC_NODE_T            *h2,
+          RSRC_NODE_T            *h3,
+          TSS2L_SYS_AUTH_COMMAND *auths) {
     TSS2_RC      r;
     TPM2B_NONCE *decryptNonce = NULL;
     int          decryptNonceIdx = 0;
@@ -1255,7 +1308,7 @@ iesys_gen_auths(ESYS_CONTEXT           *esys_context,
         }
         RSRC_NODE_T *session = esys_context->session_tab[session_idx];
         if (session != NULL) {
-            IESYS_SESSION *rsrc_session = &session->rsrc.misc.rsrc_session;
+            IESYS_SESSION *rsrc_session = session->rsrc.misc.rsrc_session;
             if (rsrc_session->type_policy_session == POLICY_PASSWORD) {
                 auths->auths[auths->count].sessionHandle = session->rsrc.handle;
                 if (esys_context->auth_objects[session_idx] == NULL) {
@@ -1264,7 +1317,7 @@ iesys_gen_auths(ESYS_CONTEXT           *esys_context,
                     auths->auths[auths->count].hmac = esys_context->auth_objects[session_idx]->auth;
                 }
                 auths->auths[auths->count].sessionAttributes
-                    = session->rsrc.misc.rsrc_session.sessionAttributes;
+                    = session->rsrc.misc.rsrc_session->sessionAttributes;
                 auths->count += 1;
                 continue;
             }
@@ -1286,6 +1339,22 @@ iesys_gen_auths(ESYS_CONTEXT           *esys_context,
     return TSS2_RC_SUCCESS;
 }
 
+/* gen_auths() framed by static tracepoints for profiling the HMAC computation. */
+TSS2_RC
+iesys_gen_auths(ESYS_CONTEXT           *esys_context,
+                RSRC_NODE_T            *h1,
+                RSRC_NODE_T            *h2,
+                RSRC_NODE_T            *h3,
+                TSS2L_SYS_AUTH_COMMAND *auths) {
+    TSS2_RC r;
+
+    TSS2_PROBE1(esys_gen_auths_entry, esys_context);
+    r = gen_auths(esys_context, h1, h2, h3, auths);
+    TSS2_PROBE2(esys_gen_auths_return, esys_context, r);
+
+    return r;
+}
+
 /** Check the response HMACs for all sessions.
  *
  * The response HMAC values are computed. Based on these values the HMACs for
@@ -1301,8 +1370,8 @@ iesys_gen_auths(ESYS_CONTEXT           *esys_context,
  * @retval TSS2_ESYS_RC_NOT_IMPLEMENTED if hash algorithm is not implemented.
  * @retval TSS2_SYS_RC_* for SAPI errors.
  */
-TSS2_RC
-iesys_check_response(ESYS_CONTEXT *esys_context) {
+static TSS2_RC
+check_response(ESYS_CONTEXT *esys_context) {
     TSS2_RC                 r;
     const uint8_t          *rpBuffer;
     size_t                  rpBuffer_size;
@@ -1347,6 +1416,18 @@ iesys_check_response(ESYS_CONTEXT *esys_context) {
     return TSS2_RC_SUCCESS;
 }
 
+/* check_response() framed by static tracepoints for profiling the HMAC check. */
+TSS2_RC
+iesys_check_response(ESYS_CONTEXT *esys_context) {
+    TSS2_RC r;
+
+    TSS2_PROBE1(esys_check_response_entry, esys_context);
+    r = check_response(esys_context);
+    TSS2_PROBE2(esys_check_response_return, esys_context, r);
+
+    return r;
+}
+
 /** Compute the name from the public data of a NV index.
  *
  * The name of a NV index is computed as follows:
@@ -1475,6 +1556,80 @@ iesys_tpm_error(TSS2_RC r) {
                 || (r & TSS2_RC_LAYER_MASK) == TSS2_RESMGR_RC_LAYER));
 }
 
+/** Receive and verify the response of the command sent by an _Async call.
+ *
+ * This performs the common part of the _Finish functions: the response is
+ * received, the command is resubmitted if the TPM asks for it and the
+ * response HMACs are checked and the response parameter is decrypted.
+ * On success the response is ready to be unmarshaled by the command's SAPI
+ * _Complete function, and the context state must be set to ESYS_STATE_INIT by
+ * the caller afterwards.
+ * @param[in,out] esysContext The ESYS_CONTEXT.
+ * @retval TSS2_RC_SUCCESS if the response was received and verified.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE if no command is pending.
+ * @retval TSS2_ESYS_RC_TRY_AGAIN if the response is not yet available or the
+ *         command was resubmitted.
+ * @retval TSS2_RCs produced by the TPM or lower layers of the software stack.
+ */
+TSS2_RC
+iesys_finish_response(ESYS_CONTEXT *esysContext) {
+    TSS2_RC r;
+
+    /* Check for correct sequence and set sequence to irregular for now */
+    if (esysContext->state != ESYS_STATE_SENT && esysContext->state != ESYS_STATE_RESUBMISSION) {
+        LOG_ERROR("Esys called in bad sequence.");
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+    esysContext->state = ESYS_STATE_INTERNALERROR;
+
+    /*Receive the TPM response and handle resubmissions if necessary. */
+    r = Tss2_Sys_ExecuteFinish(esysContext->sys, esysContext->timeout);
+    if (base_rc(r) == TSS2_BASE_RC_TRY_AGAIN) {
+        LOG_DEBUG("A layer below returned TRY_AGAIN: %" PRIx32, r);
+        esysContext->state = ESYS_STATE_SENT;
+        return r;
+    }
+    /* This block handle the resubmission of TPM commands given a certain set of
+     * TPM response codes. */
+    if (r == TPM2_RC_RETRY || r == TPM2_RC_TESTING || r == TPM2_RC_YIELDED) {
+        LOG_DEBUG("TPM returned RETRY, TESTING or YIELDED, which triggers a "
+                  "resubmission: %" PRIx32,
+                  r);
+        if (esysContext->submissionCount++ >= ESYS_MAX_SUBMISSIONS) {
+            LOG_WARNING("Maximum number of (re)submissions has been reached.");
+            esysContext->state = ESYS_STATE_INIT;
+            return r;
+        }
+        esysContext->state = ESYS_STATE_RESUBMISSION;
+        r = Tss2_Sys_ExecuteAsync(esysContext->sys);
+        if (r != TSS2_RC_SUCCESS) {
+            LOG_WARNING("Error attempting to resubmit");
+            return r;
+        }
+        LOG_DEBUG("Resubmission initiated and returning RC_TRY_AGAIN.");
+        return TSS2_ESYS_RC_TRY_AGAIN;
+    }
+    /* The following is the "regular error" handling. */
+    if (iesys_tpm_error(r)) {
+        LOG_WARNING("Received TPM Error");
+        esysContext->state = ESYS_STATE_INIT;
+        return r;
+    } else if (r != TSS2_RC_SUCCESS) {
+        LOG_ERROR("Received a non-TPM Error");
+        esysContext->state = ESYS_STATE_INTERNALERROR;
+        return r;
+    }
+
+    /*
+     * Now the verification of the response (hmac check) and if necessary the
+     * parameter decryption have to be done.
+     */
+    r = iesys_check_response(esysContext);
+    return_state_if_error(r, ESYS_STATE_INTERNALERROR, "Error: check response");
+
+    return TSS2_RC_SUCCESS;
+}
+
 /** Remove trailing spaces includes auth value.
  *
  * Trailing zeros will be removed.
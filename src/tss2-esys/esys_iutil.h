@@ -36,6 +36,8 @@ extern "C" {
 TSS2_RC
 init_session_tab(ESYS_CONTEXT *esysContext, ESYS_TR shandle1, ESYS_TR shandle2, ESYS_TR shandle3);
 
+void iesys_DeleteResourceObject(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node);
+
 void iesys_DeleteAllResourceObjects(ESYS_CONTEXT *esys_context);
 
 TSS2_RC iesys_compute_encrypt_nonce(ESYS_CONTEXT *esysContext,
@@ -108,6 +110,8 @@ iesys_get_name(ESYS_CRYPTO_CALLBACKS *crypto_cb, TPM2B_PUBLIC *publicInfo, TPM2B
 
 bool iesys_tpm_error(TSS2_RC r);
 
+TSS2_RC iesys_finish_response(ESYS_CONTEXT *esysContext);
+
 TSS2_RC iesys_adapt_auth_value(ESYS_CRYPTO_CALLBACKS *crypto_cb,
                                TPM2B_AUTH            *auth_value,
                                TPMI_ALG_HASH          hash_alg);
@@ -124,6 +128,89 @@ TSS2_RC iesys_compute_rp_hash(ESYS_CONTEXT *esys_context,
                               uint8_t      *rp_hash,
                               size_t       *rp_hash_size);
 
+void *iesys_output_calloc(ESYS_CONTEXT *esys_context, size_t size);
+
+void iesys_output_free(ESYS_CONTEXT *esys_context, void *ptr);
+
+void iesys_arena_release(ESYS_CONTEXT *esys_context);
+
+bool iesys_name_cache_handle(TPM2_HANDLE tpm_handle);
+
+bool iesys_name_cache_load(ESYS_CONTEXT   *esys_context,
+                           TPM2_HANDLE     tpm_handle,
+                           IESYS_RESOURCE *rsrc);
+
+void iesys_name_cache_store(ESYS_CONTEXT *esys_context, const RSRC_NODE_T *node);
+
+TSS2_RC iesys_rm_use(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node);
+
+TSS2_RC iesys_rm_reserve(ESYS_CONTEXT *esys_context, TPM2_HT handle_type);
+
+void iesys_rm_release(ESYS_CONTEXT *esys_context);
+
+bool iesys_cap_cache_lookup(ESYS_CONTEXT *esys_context,
+                            ESYS_TR       shandle1,
+                            ESYS_TR       shandle2,
+                            ESYS_TR       shandle3,
+                            TPM2_CAP      capability,
+                            UINT32        property,
+                            UINT32        propertyCount);
+
+TSS2_RC iesys_cap_cache_get(ESYS_CONTEXT          *esys_context,
+                            TPMI_YES_NO           *moreData,
+                            TPMS_CAPABILITY_DATA **data);
+
+void iesys_cap_cache_store(ESYS_CONTEXT               *esys_context,
+                           TPMI_YES_NO                 moreData,
+                           const TPMS_CAPABILITY_DATA *data);
+
+void iesys_cap_cache_release(ESYS_CONTEXT *esys_context);
+
+void iesys_thread_enter(ESYS_CONTEXT *esys_context);
+
+void iesys_thread_leave(ESYS_CONTEXT *esys_context);
+
+void iesys_thread_leave_if_error(ESYS_CONTEXT *esys_context, TSS2_RC r);
+
+bool iesys_thread_owned(ESYS_CONTEXT *esys_context);
+
+void iesys_thread_read_lock(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle);
+
+void iesys_thread_read_unlock(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle);
+
+void iesys_thread_release(ESYS_CONTEXT *esys_context);
+
+void iesys_rsrc_clear(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node);
+
+TSS2_RC iesys_rsrc_set_key_public(ESYS_CONTEXT       *esys_context,
+                                  RSRC_NODE_T        *node,
+                                  const TPM2B_PUBLIC *public);
+
+TSS2_RC iesys_rsrc_key_public(const RSRC_NODE_T *node, TPM2B_PUBLIC *public);
+
+TSS2_RC iesys_rsrc_set_nv_public(ESYS_CONTEXT          *esys_context,
+                                 RSRC_NODE_T           *node,
+                                 const TPM2B_NV_PUBLIC *nvPublic);
+
+void iesys_rsrc_nv_public(const RSRC_NODE_T *node, TPM2B_NV_PUBLIC *nvPublic);
+
+TSS2_RC
+iesys_rsrc_nv_add_attributes(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node, TPMA_NV attributes);
+
+TSS2_RC
+iesys_rsrc_set_session(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node, const IESYS_SESSION *session);
+
+TSS2_RC iesys_rsrc_set(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node, const IESYS_RESOURCE *rsrc);
+
+TSS2_RC iesys_rsrc_get(const RSRC_NODE_T *node, IESYS_RESOURCE *rsrc);
+
+/** Free an output of a _Finish function and set the pointer to NULL. */
+#define ESYS_OUTPUT_FREE(C, S)                                                                     \
+    if ((S) != NULL) {                                                                             \
+        iesys_output_free((C), (void *)(S));                                                       \
+        (S) = NULL;                                                                                \
+    }
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
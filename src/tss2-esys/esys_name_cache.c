@@ -0,0 +1,204 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for PRIx32, uint8_t
+#include <stdbool.h>  // for bool, false, true
+#include <stdio.h>    // for fclose, ferror, fopen, fread, fwrite, rem...
+#include <stdlib.h>   // for NULL, free, malloc, size_t
+#include <string.h>   // for memcpy, strlen
+#ifdef _WIN32
+#include <process.h> // for _getpid
+#define getpid _getpid
+#else
+#include <unistd.h> // for getpid
+#endif
+
+#include "esys_int.h"        // for ESYS_CONTEXT, ESYS_ASSERT_NON_NULL
+#include "esys_iutil.h"      // for iesys_name_cache_handle, iesys_name_cac...
+#include "esys_mu.h"         // for iesys_MU_IESYS_RESOURCE_Marshal, iesys_...
+#include "esys_types.h"      // for IESYS_RESOURCE, IESYSC_KEY_RSRC, IESYSC...
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_RC_...
+#include "tss2_esys.h"       // for Esys_SetNameCache, ESYS_NAME_CACHE_NO_V...
+#include "tss2_tpm2_types.h" // for TPM2_HANDLE, TPMA_NV_WRITTEN, TPM2_HR_S...
+
+#define LOGMODULE esys
+#include "util/log.h" // for LOG_DEBUG, LOG_WARNING, LOG_ERROR, return_if_null
+
+/** Check whether the metadata of a TPM handle may be cached.
+ *
+ * Only persistent objects and NV indices keep their handle across
+ * processes and reboots.
+ * @param[in] tpm_handle The TPM handle.
+ * @retval true if the handle may be cached.
+ */
+bool
+iesys_name_cache_handle(TPM2_HANDLE tpm_handle) {
+    return (tpm_handle >= TPM2_NV_INDEX_FIRST && tpm_handle <= TPM2_NV_INDEX_LAST)
+           || tpm_handle >> TPM2_HR_SHIFT == TPM2_HT_PERSISTENT;
+}
+
+static char *
+name_cache_path(ESYS_CONTEXT *esys_context, TPM2_HANDLE tpm_handle, const char *suffix) {
+    /* directory, '/', 8 hex digits, '.', pid, suffix */
+    size_t size = strlen(esys_context->name_cache_dir) + strlen(suffix) + 32;
+    char  *path = malloc(size);
+
+    if (path == NULL)
+        return NULL;
+    if (suffix[0] == '\0')
+        snprintf(path, size, "%s/%08" PRIx32 ".tr", esys_context->name_cache_dir, tpm_handle);
+    else
+        snprintf(path, size, "%s/%08" PRIx32 ".%ld%s", esys_context->name_cache_dir, tpm_handle,
+                 (long)getpid(), suffix);
+    return path;
+}
+
+/** Read the metadata of a TPM handle from the name cache.
+ *
+ * Entries that cannot be parsed or belong to a different handle are ignored.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] tpm_handle The TPM handle of the object or NV index.
+ * @param[out] rsrc The metadata of the cache entry.
+ * @retval true if a valid entry was found.
+ */
+bool
+iesys_name_cache_load(ESYS_CONTEXT *esys_context, TPM2_HANDLE tpm_handle, IESYS_RESOURCE *rsrc) {
+    uint8_t buffer[sizeof(IESYS_RESOURCE)];
+    size_t  size, offset = 0;
+    char   *path;
+    FILE   *file;
+
+    if (esys_context->name_cache_dir == NULL || !iesys_name_cache_handle(tpm_handle))
+        return false;
+
+    path = name_cache_path(esys_context, tpm_handle, "");
+    if (path == NULL)
+        return false;
+    file = fopen(path, "rb");
+    free(path);
+    if (file == NULL)
+        return false;
+    size = fread(&buffer[0], 1, sizeof(buffer), file);
+    /* An entry filling the whole buffer is too large */
+    if (size == sizeof(buffer) || ferror(file)) {
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+
+    if (iesys_MU_IESYS_RESOURCE_Unmarshal(&buffer[0], size, &offset, rsrc) != TSS2_RC_SUCCESS
+        || offset != size || rsrc->handle != tpm_handle) {
+        LOG_DEBUG("Ignoring invalid name cache entry of 0x%08" PRIx32, tpm_handle);
+        return false;
+    }
+
+    if (tpm_handle >= TPM2_NV_INDEX_FIRST && tpm_handle <= TPM2_NV_INDEX_LAST)
+        return rsrc->rsrcType == IESYSC_NV_RSRC;
+    return rsrc->rsrcType == IESYSC_KEY_RSRC;
+}
+
+/** Write the metadata of an object or NV index to the name cache.
+ *
+ * The entry is written to a temporary file first and then renamed, so that
+ * concurrent readers never see a partial entry. Failures are only logged.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] node The object whose metadata is to be stored.
+ */
+void
+iesys_name_cache_store(ESYS_CONTEXT *esys_context, const RSRC_NODE_T *node) {
+    uint8_t        buffer[sizeof(IESYS_RESOURCE)];
+    IESYS_RESOURCE rsrc;
+    size_t         size = 0;
+    char          *path, *tmp_path;
+    FILE          *file;
+
+    if (esys_context->name_cache_dir == NULL || !iesys_name_cache_handle(node->rsrc.handle))
+        return;
+    /* The name of an NV index changes when it is written the first time */
+    if (node->rsrc.rsrcType == IESYSC_NV_RSRC
+        && !(node->rsrc.misc.rsrc_nv_pub.entry->nvPublic.attributes & TPMA_NV_WRITTEN))
+        return;
+
+    if (iesys_rsrc_get(node, &rsrc) != TSS2_RC_SUCCESS
+        || iesys_MU_IESYS_RESOURCE_Marshal(&rsrc, &buffer[0], sizeof(buffer), &size)
+               != TSS2_RC_SUCCESS)
+        return;
+
+    path = name_cache_path(esys_context, rsrc.handle, "");
+    tmp_path = name_cache_path(esys_context, rsrc.handle, ".tmp");
+    if (path == NULL || tmp_path == NULL)
+        goto cleanup;
+
+    file = fopen(tmp_path, "wb");
+    if (file == NULL) {
+        LOG_WARNING("Cannot write name cache entry %s", tmp_path);
+        goto cleanup;
+    }
+    if (fwrite(&buffer[0], 1, size, file) != size) {
+        fclose(file);
+        remove(tmp_path);
+        LOG_WARNING("Cannot write name cache entry %s", tmp_path);
+        goto cleanup;
+    }
+    if (fclose(file) != 0 || rename(tmp_path, path) != 0) {
+        remove(tmp_path);
+        LOG_WARNING("Cannot write name cache entry %s", path);
+        goto cleanup;
+    }
+    LOG_DEBUG("Stored name cache entry %s", path);
+
+cleanup:
+    free(path);
+    free(tmp_path);
+}
+
+/** Configure the name cache of an ESYS context.
+ *
+ * With the name cache enabled, Esys_TR_FromTPMPublic() stores the metadata of
+ * persistent objects and NV indices as serialized ESYS_TR objects (see
+ * Esys_TR_Serialize()) in the given directory, one file per TPM handle, and
+ * uses them in later calls, also from other processes.
+ * By default the cached name is verified by a single ReadPublic or
+ * NV_ReadPublic command using the sessions passed to Esys_TR_FromTPMPublic().
+ * Without the cache, two commands are needed if sessions are passed. If the
+ * TPM reports a different name, the metadata of the TPM is used and the entry
+ * is replaced.
+ * With ESYS_NAME_CACHE_NO_VERIFY a cached entry is used without any TPM
+ * command. The application then relies on the HMAC sessions used with the
+ * object, which are bound to the cached name, to detect an outdated entry.
+ * NV indices are only cached after they were written, since their name
+ * changes with the first write. The directory must only be writable by
+ * trusted users.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] path The directory of the cache, NULL to disable the cache.
+ * @param[in] flags 0 or ESYS_NAME_CACHE_NO_VERIFY.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL.
+ * @retval TSS2_ESYS_RC_BAD_VALUE if flags contains an unknown flag.
+ * @retval TSS2_ESYS_RC_MEMORY if the path cannot be copied.
+ */
+TSS2_RC
+Esys_SetNameCache(ESYS_CONTEXT *esys_context, const char *path, uint32_t flags) {
+    ESYS_ASSERT_NON_NULL(esys_context);
+
+    if (flags & ~ESYS_NAME_CACHE_NO_VERIFY) {
+        LOG_ERROR("Unknown flags 0x%08" PRIx32, flags);
+        return TSS2_ESYS_RC_BAD_VALUE;
+    }
+
+    free(esys_context->name_cache_dir);
+    esys_context->name_cache_dir = NULL;
+    esys_context->name_cache_flags = 0;
+    if (path == NULL)
+        return TSS2_RC_SUCCESS;
+
+    esys_context->name_cache_dir = malloc(strlen(path) + 1);
+    return_if_null(esys_context->name_cache_dir, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+    memcpy(esys_context->name_cache_dir, path, strlen(path) + 1);
+    esys_context->name_cache_flags = flags;
+    return TSS2_RC_SUCCESS;
+}
@@ -0,0 +1,224 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for PRIu16, uint8_t, int32_t, UINT16_MAX
+#include <stddef.h>   // for NULL, size_t
+#include <string.h>   // for memcpy
+
+#include "esys_int.h"        // for ESYS_CONTEXT, ESYS_ASSERT_NON_NULL
+#include "esys_iutil.h"      // for ESYS_OUTPUT_FREE, iesys_thread_enter, iesys_...
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_BASE_RC_...
+#include "tss2_esys.h"       // for Esys_NV_ReadAll, Esys_NV_WriteAll, Esys_...
+#include "tss2_tpm2_types.h" // for TPM2B_MAX_NV_BUFFER, TPM2_PT_NV_BUFFER_MAX
+#include "util/aux_util.h"   // for base_rc
+
+#define LOGMODULE esys
+#include "util/log.h" // for return_if_error, LOG_ERROR
+
+/** Get the chunk size for NV accesses, querying TPM2_PT_NV_BUFFER_MAX once. */
+static TSS2_RC
+nv_chunk_size(ESYS_CONTEXT *esys_context, size_t *chunk_size) {
+    TSS2_RC               r;
+    TPMI_YES_NO           more_data;
+    TPMS_CAPABILITY_DATA *capability_data = NULL;
+    TPMS_TAGGED_PROPERTY *property;
+
+    if (esys_context->nv_buffer_max == 0) {
+        r = Esys_GetCapability(esys_context, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                               TPM2_CAP_TPM_PROPERTIES, TPM2_PT_NV_BUFFER_MAX, 1, &more_data,
+                               &capability_data);
+        return_if_error(r, "Get TPM2_PT_NV_BUFFER_MAX");
+
+        property = &capability_data->data.tpmProperties.tpmProperty[0];
+        if (capability_data->data.tpmProperties.count == 1
+            && property->property == TPM2_PT_NV_BUFFER_MAX)
+            esys_context->nv_buffer_max = property->value;
+        ESYS_OUTPUT_FREE(esys_context, capability_data);
+        if (esys_context->nv_buffer_max == 0) {
+            LOG_ERROR("TPM does not report TPM2_PT_NV_BUFFER_MAX.");
+            return TSS2_ESYS_RC_GENERAL_FAILURE;
+        }
+    }
+
+    *chunk_size = esys_context->nv_buffer_max;
+    if (*chunk_size > TPM2_MAX_NV_BUFFER_SIZE)
+        *chunk_size = TPM2_MAX_NV_BUFFER_SIZE;
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+nv_check_range(UINT16 offset, size_t size) {
+    if (size > (size_t)(UINT16_MAX - offset)) {
+        LOG_ERROR("NV range %" PRIu16 "+%zu exceeds the maximum NV index size.", offset, size);
+        return TSS2_ESYS_RC_BAD_VALUE;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+/** Read an NV index of any size in chunks of TPM2_PT_NV_BUFFER_MAX.
+ *
+ * Issues as many TPM2_NV_Read commands as needed and copies the data of each
+ * response directly into the caller's buffer. TPM2_PT_NV_BUFFER_MAX is queried
+ * at the first call and cached in the context. The sessions are used for all
+ * chunks; parameter encryption and response HMACs are handled per chunk as by
+ * Esys_NV_Read.
+ * @param esys_context [in,out] The ESYS_CONTEXT.
+ * @param authHandle [in] Handle indicating the source of the authorization value.
+ * @param nvIndex [in] The NV index to be read.
+ * @param shandle1 [in] Session handle for authorization of authHandle.
+ * @param shandle2 [in] Second session handle.
+ * @param shandle3 [in] Third session handle.
+ * @param offset [in] Octet offset into the NV area.
+ * @param data [out] The buffer for the data (caller-allocated).
+ * @param size [in] Number of octets to read.
+ * @param progress [in] Called after each chunk with the octets read so far and
+ *        size (optional).
+ * @param userdata [in] Passed to progress.
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context or data is NULL.
+ * @retval TSS2_ESYS_RC_BAD_VALUE if the range exceeds the maximum NV size.
+ * @retval TSS2_ESYS_RC_MALFORMED_RESPONSE if the TPM returned less data than
+ *         requested.
+ * @retval TSS2_RCs produced by Esys_GetCapability and Esys_NV_Read.
+ */
+TSS2_RC
+Esys_NV_ReadAll(ESYS_CONTEXT        *esys_context,
+                ESYS_TR              authHandle,
+                ESYS_TR              nvIndex,
+                ESYS_TR              shandle1,
+                ESYS_TR              shandle2,
+                ESYS_TR              shandle3,
+                UINT16               offset,
+                uint8_t             *data,
+                size_t               size,
+                ESYS_NV_PROGRESS_FCN progress,
+                void                *userdata) {
+    TSS2_RC        r;
+    size_t         chunk_size, done = 0;
+    UINT16         chunk, chunk_read;
+    const uint8_t *view;
+    int32_t        timeouttmp;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    ESYS_ASSERT_NON_NULL(data);
+    r = nv_check_range(offset, size);
+    return_if_error(r, "Check NV range");
+    r = nv_chunk_size(esys_context, &chunk_size);
+    return_if_error(r, "Get NV chunk size");
+
+    timeouttmp = esys_context->timeout;
+    while (done < size) {
+        chunk = (UINT16)(size - done < chunk_size ? size - done : chunk_size);
+        iesys_thread_enter(esys_context);
+        r = Esys_NV_Read_Async(esys_context, authHandle, nvIndex, shandle1, shandle2, shandle3,
+                               chunk, (UINT16)(offset + done));
+        iesys_thread_leave_if_error(esys_context, r);
+        return_if_error(r, "NV read");
+
+        esys_context->timeout = -1;
+        do {
+            r = Esys_NV_Read_FinishView(esys_context, &view, &chunk_read);
+        } while (base_rc(r) == TSS2_BASE_RC_TRY_AGAIN);
+        esys_context->timeout = timeouttmp;
+        iesys_thread_leave(esys_context);
+        return_if_error(r, "NV read");
+        if (chunk_read != chunk) {
+            LOG_ERROR("TPM returned %" PRIu16 " instead of %" PRIu16 " octets.", chunk_read,
+                      chunk);
+            return TSS2_ESYS_RC_MALFORMED_RESPONSE;
+        }
+
+        /* The view is only valid until the next command */
+        memcpy(&data[done], view, chunk);
+        done += chunk;
+        if (progress != NULL)
+            progress(done, size, userdata);
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+/** Write an NV index of any size in chunks of TPM2_PT_NV_BUFFER_MAX.
+ *
+ * Issues as many TPM2_NV_Write commands as needed. The next chunk is copied
+ * out of the caller's buffer while the TPM executes the current one.
+ * TPM2_PT_NV_BUFFER_MAX is queried at the first call and cached in the
+ * context. The sessions are used for all chunks. If a chunk fails, the chunks
+ * before it remain written.
+ * @param esys_context [in,out] The ESYS_CONTEXT.
+ * @param authHandle [in] Handle indicating the source of the authorization value.
+ * @param nvIndex [in] The NV index to be written.
+ * @param shandle1 [in] Session handle for authorization of authHandle.
+ * @param shandle2 [in] Second session handle.
+ * @param shandle3 [in] Third session handle.
+ * @param offset [in] Octet offset into the NV area.
+ * @param data [in] The data to write.
+ * @param size [in] Number of octets to write.
+ * @param progress [in] Called after each chunk with the octets written so far
+ *        and size (optional).
+ * @param userdata [in] Passed to progress.
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context or data is NULL.
+ * @retval TSS2_ESYS_RC_BAD_VALUE if the range exceeds the maximum NV size.
+ * @retval TSS2_RCs produced by Esys_GetCapability and Esys_NV_Write.
+ */
+TSS2_RC
+Esys_NV_WriteAll(ESYS_CONTEXT        *esys_context,
+                 ESYS_TR              authHandle,
+                 ESYS_TR              nvIndex,
+                 ESYS_TR              shandle1,
+                 ESYS_TR              shandle2,
+                 ESYS_TR              shandle3,
+                 UINT16               offset,
+                 const uint8_t       *data,
+                 size_t               size,
+                 ESYS_NV_PROGRESS_FCN progress,
+                 void                *userdata) {
+    TSS2_RC              r;
+    size_t               chunk_size, done = 0;
+    TPM2B_MAX_NV_BUFFER  chunks[2];
+    TPM2B_MAX_NV_BUFFER *current = &chunks[0], *next = &chunks[1], *tmp;
+    int32_t              timeouttmp;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    ESYS_ASSERT_NON_NULL(data);
+    r = nv_check_range(offset, size);
+    return_if_error(r, "Check NV range");
+    r = nv_chunk_size(esys_context, &chunk_size);
+    return_if_error(r, "Get NV chunk size");
+
+    current->size = (UINT16)(size < chunk_size ? size : chunk_size);
+    memcpy(&current->buffer[0], data, current->size);
+
+    timeouttmp = esys_context->timeout;
+    while (done < size) {
+        iesys_thread_enter(esys_context);
+        r = Esys_NV_Write_Async(esys_context, authHandle, nvIndex, shandle1, shandle2, shandle3,
+                                current, (UINT16)(offset + done));
+        iesys_thread_leave_if_error(esys_context, r);
+        return_if_error(r, "NV write");
+
+        /* The chunk is marshaled, so the next one is prepared meanwhile */
+        done += current->size;
+        next->size = (UINT16)(size - done < chunk_size ? size - done : chunk_size);
+        memcpy(&next->buffer[0], &data[done], next->size);
+        tmp = current;
+        current = next;
+        next = tmp;
+
+        esys_context->timeout = -1;
+        do {
+            r = Esys_NV_Write_Finish(esys_context);
+        } while (base_rc(r) == TSS2_BASE_RC_TRY_AGAIN);
+        esys_context->timeout = timeouttmp;
+        iesys_thread_leave(esys_context);
+        return_if_error(r, "NV write");
+
+        if (progress != NULL)
+            progress(done, size, userdata);
+    }
+    return TSS2_RC_SUCCESS;
+}
@@ -0,0 +1,318 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for PRIx32, uint8_t, uint32_t
+#include <stdbool.h>  // for bool, false, true
+#include <stdlib.h>   // for NULL, size_t, free, calloc, malloc, realloc
+
+#include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, IESYS_RM, ESYS...
+#include "esys_iutil.h"      // for iesys_get_handle_type, iesys_rm_use, ies...
+#include "esys_types.h"      // for IESYSC_SESSION_RSRC
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_RC_...
+#include "tss2_esys.h"       // for Esys_ResourceManagerEnable, Esys_Resourc...
+#include "tss2_mu.h"         // for Tss2_MU_TPMS_CONTEXT_Marshal, Tss2_MU_TP...
+#include "tss2_sys.h"        // for Tss2_Sys_ContextSave, Tss2_Sys_ContextLoad
+#include "tss2_tcti.h"       // for TSS2_TCTI_CONTEXT
+#include "tss2_tpm2_types.h" // for TPMS_CONTEXT, TPM2_HT_TRANSIENT, TPM2_PT_...
+
+#define LOGMODULE esys
+#include "util/log.h" // for return_if_error, LOG_DEBUG, LOG_ERROR
+
+static bool
+rm_session(const RSRC_NODE_T *node) {
+    return node->rsrc.rsrcType == IESYSC_SESSION_RSRC;
+}
+
+/** Check whether an object occupies a slot of the TPM that can be swapped. */
+static bool
+rm_managed(const RSRC_NODE_T *node) {
+    return rm_session(node) || iesys_get_handle_type(node->rsrc.handle) == TPM2_HT_TRANSIENT;
+}
+
+static size_t
+rm_loaded(ESYS_CONTEXT *esys_context, bool sessions) {
+    size_t count = 0;
+
+    for (RSRC_NODE_T *node = esys_context->rsrc_list; node != NULL; node = node->next)
+        if (rm_managed(node) && node->rm_context == NULL && rm_session(node) == sessions)
+            count++;
+    return count;
+}
+
+/** Save an object or session and free its slot in the TPM. */
+static TSS2_RC
+rm_swap_out(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node) {
+    TSS2_RC      r;
+    TPMS_CONTEXT context;
+    uint8_t     *data, *shrunk;
+    size_t       offset = 0;
+
+    /* Allocated first, since a saved session is only usable with its context */
+    data = malloc(sizeof(TPMS_CONTEXT));
+    return_if_null(data, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+
+    r = Tss2_Sys_ContextSave(esys_context->rm.sys, node->rsrc.handle, &context);
+    goto_if_error(r, "Save context", error_cleanup);
+    r = Tss2_MU_TPMS_CONTEXT_Marshal(&context, data, sizeof(TPMS_CONTEXT), &offset);
+    goto_if_error(r, "Marshal context", error_cleanup);
+
+    /* Saving a session unloads it, objects have to be flushed */
+    if (!rm_session(node)) {
+        r = Tss2_Sys_FlushContext(esys_context->rm.sys, node->rsrc.handle);
+        goto_if_error(r, "Flush context", error_cleanup);
+    }
+
+    shrunk = realloc(data, offset);
+    node->rm_context = (shrunk != NULL) ? shrunk : data;
+    node->rm_context_size = (UINT16)offset;
+    LOG_DEBUG("Swapped out ESYS_TR 0x%" PRIx32, node->esys_handle);
+    return TSS2_RC_SUCCESS;
+
+error_cleanup:
+    free(data);
+    return r;
+}
+
+/** Load a swapped out object or session again.
+ *
+ * The TPM handle of objects may change; sessions keep their handle.
+ */
+static TSS2_RC
+rm_swap_in(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node) {
+    TSS2_RC         r;
+    TPMS_CONTEXT    context;
+    TPMI_DH_CONTEXT tpm_handle;
+    size_t          offset = 0;
+
+    r = Tss2_MU_TPMS_CONTEXT_Unmarshal(node->rm_context, node->rm_context_size, &offset,
+                                       &context);
+    return_if_error(r, "Unmarshal context");
+    r = Tss2_Sys_ContextLoad(esys_context->rm.sys, &context, &tpm_handle);
+    return_if_error(r, "Load context");
+
+    node->rsrc.handle = tpm_handle;
+    free(node->rm_context);
+    node->rm_context = NULL;
+    node->rm_context_size = 0;
+    LOG_DEBUG("Swapped in ESYS_TR 0x%" PRIx32, node->esys_handle);
+    return TSS2_RC_SUCCESS;
+}
+
+/** Swap out the least recently used objects or sessions until one more fits.
+ *
+ * Objects used by the current command are never swapped out. If all of them
+ * are in use, the limit is exceeded and the TPM decides.
+ */
+static TSS2_RC
+rm_make_room(ESYS_CONTEXT *esys_context, bool sessions) {
+    IESYS_RM    *rm = &esys_context->rm;
+    UINT32       max = sessions ? rm->max_sessions : rm->max_objects;
+    RSRC_NODE_T *victim;
+    TSS2_RC      r;
+
+    while (rm_loaded(esys_context, sessions) >= max) {
+        victim = NULL;
+        for (RSRC_NODE_T *node = esys_context->rsrc_list; node != NULL; node = node->next) {
+            if (!rm_managed(node) || node->rm_context != NULL || rm_session(node) != sessions
+                || node->rm_command == rm->command)
+                continue;
+            if (victim == NULL || (INT32)(node->rm_command - victim->rm_command) < 0)
+                victim = node;
+        }
+        if (victim == NULL)
+            break;
+        r = rm_swap_out(esys_context, victim);
+        return_if_error(r, "Swap out");
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+/** Make an object or session used by the current command available in the TPM.
+ *
+ * Called for every object looked up while a command is prepared; outside of a
+ * command the metadata of swapped out objects is used without loading them.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in,out] node The object.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_RCs produced by TPM2_ContextSave, TPM2_FlushContext or
+ *         TPM2_ContextLoad.
+ */
+TSS2_RC
+iesys_rm_use(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node) {
+    TSS2_RC r;
+
+    if (esys_context->rm.sys == NULL || esys_context->state != ESYS_STATE_INTERNALERROR
+        || !rm_managed(node))
+        return TSS2_RC_SUCCESS;
+
+    node->rm_command = esys_context->rm.command;
+    if (node->rm_context == NULL)
+        return TSS2_RC_SUCCESS;
+
+    r = rm_make_room(esys_context, rm_session(node));
+    return_if_error(r, "Make room");
+    return rm_swap_in(esys_context, node);
+}
+
+/** Make room for an object or session created by the current command.
+ *
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] handle_type The handle type of the new object or session.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_RCs produced by TPM2_ContextSave or TPM2_FlushContext.
+ */
+TSS2_RC
+iesys_rm_reserve(ESYS_CONTEXT *esys_context, TPM2_HT handle_type) {
+    if (esys_context->rm.sys == NULL)
+        return TSS2_RC_SUCCESS;
+    return rm_make_room(esys_context, handle_type == TPM2_HT_HMAC_SESSION
+                                          || handle_type == TPM2_HT_POLICY_SESSION);
+}
+
+/** Release the resource manager of an ESYS context.
+ *
+ * Objects that are swapped out keep their saved contexts.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ */
+void
+iesys_rm_release(ESYS_CONTEXT *esys_context) {
+    if (esys_context->rm.sys == NULL)
+        return;
+    Tss2_Sys_Finalize(esys_context->rm.sys);
+    free(esys_context->rm.sys);
+    esys_context->rm.sys = NULL;
+}
+
+static TSS2_RC
+rm_tpm_limits(TSS2_SYS_CONTEXT *sys, UINT32 *max_objects, UINT32 *max_sessions) {
+    TSS2_RC                   r;
+    TPMI_YES_NO               more_data;
+    TPMS_CAPABILITY_DATA      capability_data;
+    TPML_TAGGED_TPM_PROPERTY *properties = &capability_data.data.tpmProperties;
+
+    r = Tss2_Sys_GetCapability(sys, NULL, TPM2_CAP_TPM_PROPERTIES, TPM2_PT_HR_TRANSIENT_MIN,
+                               TPM2_PT_HR_LOADED_MIN - TPM2_PT_HR_TRANSIENT_MIN + 1, &more_data,
+                               &capability_data, NULL);
+    return_if_error(r, "Get TPM properties");
+
+    for (UINT32 i = 0; i < properties->count; i++) {
+        if (properties->tpmProperty[i].property == TPM2_PT_HR_TRANSIENT_MIN && *max_objects == 0)
+            *max_objects = properties->tpmProperty[i].value;
+        else if (properties->tpmProperty[i].property == TPM2_PT_HR_LOADED_MIN
+                 && *max_sessions == 0)
+            *max_sessions = properties->tpmProperty[i].value;
+    }
+    if (*max_objects == 0 || *max_sessions == 0) {
+        LOG_ERROR("TPM does not report its number of object and session slots.");
+        return TSS2_ESYS_RC_GENERAL_FAILURE;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+/** Enable the embedded resource manager of an ESYS context.
+ *
+ * Without a resource manager such as the one of the kernel (/dev/tpmrm0),
+ * only a few transient objects and sessions can be loaded at the same time.
+ * With the embedded resource manager, ESYS keeps at most max_objects
+ * transient objects and max_sessions sessions loaded; before a command that
+ * needs a slot, the least recently used ones are swapped out with
+ * TPM2_ContextSave and they are loaded again when a command uses them. The
+ * ESYS_TR objects stay valid, and changes of the TPM handle of reloaded
+ * objects are hidden from the application.
+ * Only objects and sessions of this context are managed, so the TPM must not
+ * be shared with other applications. The context of a swapped out session
+ * counts towards the context gap of the TPM like one saved by the
+ * application.
+ * Calling this function again changes the limits.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] max_objects The number of transient objects kept loaded, 0 for
+ *            the guaranteed minimum of the TPM (TPM2_PT_HR_TRANSIENT_MIN).
+ * @param[in] max_sessions The number of sessions kept loaded, 0 for the
+ *            guaranteed minimum of the TPM (TPM2_PT_HR_LOADED_MIN).
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE if a command of the context is pending.
+ * @retval TSS2_ESYS_RC_MEMORY if the SYS context cannot be allocated.
+ * @retval TSS2_RCs produced by TPM2_GetCapability.
+ */
+TSS2_RC
+Esys_ResourceManagerEnable(ESYS_CONTEXT *esys_context,
+                           uint32_t      max_objects,
+                           uint32_t      max_sessions) {
+    TSS2_RC            r;
+    TSS2_TCTI_CONTEXT *tcti;
+    TSS2_SYS_CONTEXT  *sys = NULL;
+    size_t             size;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    if (esys_context->state != ESYS_STATE_INIT) {
+        LOG_ERROR("Esys called in bad sequence.");
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+
+    if (esys_context->rm.sys == NULL) {
+        r = Tss2_Sys_GetTctiContext(esys_context->sys, &tcti);
+        return_if_error(r, "Get TCTI context");
+        size = Tss2_Sys_GetContextSize(0);
+        sys = calloc(1, size);
+        return_if_null(sys, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+        r = Tss2_Sys_Initialize(sys, size, tcti, NULL);
+        goto_if_error(r, "Initialize SYS context", error_cleanup);
+    }
+
+    if (max_objects == 0 || max_sessions == 0) {
+        r = rm_tpm_limits(sys ? sys : esys_context->rm.sys, &max_objects, &max_sessions);
+        goto_if_error(r, "Get TPM limits", error_cleanup);
+    }
+
+    if (sys != NULL)
+        esys_context->rm.sys = sys;
+    esys_context->rm.max_objects = max_objects;
+    esys_context->rm.max_sessions = max_sessions;
+    LOG_DEBUG("Resource manager keeps %" PRIu32 " objects and %" PRIu32 " sessions loaded",
+              max_objects, max_sessions);
+    return TSS2_RC_SUCCESS;
+
+error_cleanup:
+    if (sys != NULL) {
+        Tss2_Sys_Finalize(sys);
+        free(sys);
+    }
+    return r;
+}
+
+/** Disable the embedded resource manager of an ESYS context.
+ *
+ * All swapped out transient objects and sessions are loaded again.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE if a command of the context is pending.
+ * @retval TSS2_RCs produced by TPM2_ContextLoad, e.g. if the objects do not
+ *         fit into the TPM. The resource manager stays enabled in this case.
+ */
+TSS2_RC
+Esys_ResourceManagerDisable(ESYS_CONTEXT *esys_context) {
+    TSS2_RC r;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    if (esys_context->state != ESYS_STATE_INIT) {
+        LOG_ERROR("Esys called in bad sequence.");
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+    if (esys_context->rm.sys == NULL)
+        return TSS2_RC_SUCCESS;
+
+    for (RSRC_NODE_T *node = esys_context->rsrc_list; node != NULL; node = node->next) {
+        if (node->rm_context == NULL)
+            continue;
+        r = rm_swap_in(esys_context, node);
+        return_if_error(r, "Swap in");
+    }
+    iesys_rm_release(esys_context);
+    return TSS2_RC_SUCCESS;
+}
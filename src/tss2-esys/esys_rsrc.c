@@ -0,0 +1,340 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for PRIu32, uint32_t, uint8_t
+#include <stdlib.h>   // for free, calloc, malloc, NULL, size_t
+#include <string.h>   // for memcpy, memset, memcmp
+
+#include "esys_crypto.h"     // for iesys_crypto_hmac_cache_clear
+#include "esys_int.h"        // for RSRC_NODE_T, ESYS_CONTEXT, IESYS_NODE_RSRC
+#include "esys_iutil.h"      // for iesys_rsrc_clear, iesys_rsrc_get, iesys_rsr...
+#include "esys_types.h"      // for IESYS_RESOURCE, IESYS_SESSION, IESYSC_KEY...
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_RC_MEMORY
+#include "tss2_mu.h"         // for Tss2_MU_TPM2B_PUBLIC_Marshal, Tss2_MU_TPM...
+#include "tss2_tpm2_types.h" // for TPM2B_PUBLIC, TPM2B_NV_PUBLIC, TPMS_NV_P...
+
+#define LOGMODULE esys
+#include "util/log.h" // for return_if_error, return_if_null, LOG_ERROR
+
+/*
+ * The meta data of ESYS_TR objects is kept in the compact form IESYS_NODE_RSRC.
+ * Keys store their public area marshaled in an allocation of its own size,
+ * NV indices reference an entry shared by all indices of the context with the
+ * same public area apart from the index, and only sessions carry the full
+ * IESYS_SESSION state.
+ */
+
+static size_t
+nv_public_bucket(const TPMS_NV_PUBLIC *nvPublic) {
+    const uint8_t *bytes = (const uint8_t *)nvPublic;
+    uint32_t       hash = 2166136261U; /* FNV-1a */
+
+    for (size_t i = 0; i < sizeof(*nvPublic); i++)
+        hash = (hash ^ bytes[i]) * 16777619U;
+    return hash % IESYS_NV_PUBLIC_BUCKETS;
+}
+
+static void
+nv_public_release(ESYS_CONTEXT *esys_context, IESYS_NV_PUBLIC_ENTRY *entry) {
+    IESYS_NV_PUBLIC_ENTRY **link;
+
+    if (entry == NULL || --entry->refCount > 0)
+        return;
+
+    link = &esys_context->nv_publics[nv_public_bucket(&entry->nvPublic)];
+    while (*link != entry)
+        link = &(*link)->next;
+    *link = entry->next;
+    free(entry);
+}
+
+/** Release the resource specific information of an object.
+ *
+ * The crypto state cached for a session is released as well. The object
+ * becomes an object without specific information.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in,out] node The object.
+ */
+void
+iesys_rsrc_clear(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node) {
+    switch (node->rsrc.rsrcType) {
+    case IESYSC_KEY_RSRC:
+        free(node->rsrc.misc.rsrc_key_pub);
+        break;
+    case IESYSC_NV_RSRC:
+        nv_public_release(esys_context, node->rsrc.misc.rsrc_nv_pub.entry);
+        break;
+    case IESYSC_SESSION_RSRC:
+        if (node->rsrc.misc.rsrc_session != NULL) {
+            iesys_crypto_hmac_cache_clear(&esys_context->crypto_backend,
+                                          &node->rsrc.misc.rsrc_session->hmacKeyCache);
+            iesys_crypto_hmac_cache_clear(&esys_context->crypto_backend,
+                                          &node->rsrc.misc.rsrc_session->kdfKeyCache);
+            free(node->rsrc.misc.rsrc_session);
+        }
+        break;
+    default:
+        break;
+    }
+    memset(&node->rsrc.misc, 0, sizeof(node->rsrc.misc));
+    node->rsrc.rsrcType = IESYSC_WITHOUT_MISC_RSRC;
+}
+
+/** Make an object a key with the given public area.
+ *
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in,out] node The object.
+ * @param[in] public The public area of the key.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_MEMORY if the public area cannot be stored.
+ * @retval TSS2_MU_RC_* if the public area cannot be marshaled.
+ */
+TSS2_RC
+iesys_rsrc_set_key_public(ESYS_CONTEXT       *esys_context,
+                          RSRC_NODE_T        *node,
+                          const TPM2B_PUBLIC *public) {
+    IESYS_KEY_PUBLIC_BLOB *blob;
+    uint8_t                buffer[sizeof(TPM2B_PUBLIC)];
+    size_t                 size = 0;
+    TSS2_RC                r;
+
+    r = Tss2_MU_TPM2B_PUBLIC_Marshal(public, &buffer[0], sizeof(buffer), &size);
+    return_if_error(r, "Marshaling public area");
+
+    blob = malloc(sizeof(*blob) + size);
+    return_if_null(blob, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+    blob->size = (UINT16)size;
+    memcpy(&blob->buffer[0], &buffer[0], size);
+
+    iesys_rsrc_clear(esys_context, node);
+    node->rsrc.rsrcType = IESYSC_KEY_RSRC;
+    node->rsrc.misc.rsrc_key_pub = blob;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Get the public area of a key.
+ *
+ * The public area is unmarshaled from the stored copy. For objects without a
+ * public area, the result is zeroed.
+ * @param[in] node The object.
+ * @param[out] public The public area.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_MU_RC_* if the stored public area is corrupted.
+ */
+TSS2_RC
+iesys_rsrc_key_public(const RSRC_NODE_T *node, TPM2B_PUBLIC *public) {
+    const IESYS_KEY_PUBLIC_BLOB *blob = node->rsrc.misc.rsrc_key_pub;
+
+    if (node->rsrc.rsrcType != IESYSC_KEY_RSRC || blob == NULL) {
+        memset(public, 0, sizeof(*public));
+        return TSS2_RC_SUCCESS;
+    }
+    return Tss2_MU_TPM2B_PUBLIC_Unmarshal(&blob->buffer[0], blob->size, NULL, public);
+}
+
+/** Make an object an NV index with the given public area.
+ *
+ * The public area apart from the index is shared with the other NV indices of
+ * the context.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in,out] node The object.
+ * @param[in] nvPublic The public area of the NV index.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_MEMORY if the public area cannot be stored.
+ */
+TSS2_RC
+iesys_rsrc_set_nv_public(ESYS_CONTEXT          *esys_context,
+                         RSRC_NODE_T           *node,
+                         const TPM2B_NV_PUBLIC *nvPublic) {
+    IESYS_NV_PUBLIC_ENTRY *entry;
+    TPMS_NV_PUBLIC         key;
+    size_t                 bucket;
+
+    /* Zero the padding, the entries are compared bytewise */
+    memset(&key, 0, sizeof(key));
+    key.nameAlg = nvPublic->nvPublic.nameAlg;
+    key.attributes = nvPublic->nvPublic.attributes;
+    key.authPolicy.size = nvPublic->nvPublic.authPolicy.size;
+    if (key.authPolicy.size > sizeof(key.authPolicy.buffer)) {
+        LOG_ERROR("Invalid NV public area");
+        return TSS2_ESYS_RC_BAD_VALUE;
+    }
+    memcpy(&key.authPolicy.buffer[0], &nvPublic->nvPublic.authPolicy.buffer[0],
+           key.authPolicy.size);
+    key.dataSize = nvPublic->nvPublic.dataSize;
+
+    bucket = nv_public_bucket(&key);
+    for (entry = esys_context->nv_publics[bucket]; entry != NULL; entry = entry->next) {
+        if (memcmp(&entry->nvPublic, &key, sizeof(key)) == 0)
+            break;
+    }
+    if (entry == NULL) {
+        entry = calloc(1, sizeof(*entry));
+        return_if_null(entry, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+        memcpy(&entry->nvPublic, &key, sizeof(key));
+        entry->next = esys_context->nv_publics[bucket];
+        esys_context->nv_publics[bucket] = entry;
+    }
+    /* Referenced before the old entry is released, which may be the same */
+    entry->refCount++;
+
+    iesys_rsrc_clear(esys_context, node);
+    node->rsrc.rsrcType = IESYSC_NV_RSRC;
+    node->rsrc.misc.rsrc_nv_pub.entry = entry;
+    node->rsrc.misc.rsrc_nv_pub.nvIndex = nvPublic->nvPublic.nvIndex;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Get the public area of an NV index.
+ *
+ * For objects without a public area, the result is zeroed.
+ * @param[in] node The object.
+ * @param[out] nvPublic The public area.
+ */
+void
+iesys_rsrc_nv_public(const RSRC_NODE_T *node, TPM2B_NV_PUBLIC *nvPublic) {
+    memset(nvPublic, 0, sizeof(*nvPublic));
+    if (node->rsrc.rsrcType != IESYSC_NV_RSRC || node->rsrc.misc.rsrc_nv_pub.entry == NULL)
+        return;
+
+    nvPublic->nvPublic = node->rsrc.misc.rsrc_nv_pub.entry->nvPublic;
+    nvPublic->nvPublic.nvIndex = node->rsrc.misc.rsrc_nv_pub.nvIndex;
+    /* nvIndex, nameAlg, attributes, authPolicy and dataSize */
+    nvPublic->size = sizeof(TPMI_RH_NV_INDEX) + sizeof(TPMI_ALG_HASH) + sizeof(TPMA_NV)
+                     + sizeof(UINT16) + nvPublic->nvPublic.authPolicy.size + sizeof(UINT16);
+}
+
+/** Add attributes to the public area of an NV index and update its name.
+ *
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in,out] node The NV index.
+ * @param[in] attributes The attributes set by the TPM.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_MEMORY if the public area cannot be stored.
+ * @retval TSS2_RCs produced by the computation of the name.
+ */
+TSS2_RC
+iesys_rsrc_nv_add_attributes(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node, TPMA_NV attributes) {
+    TPM2B_NV_PUBLIC nvPublic;
+    TSS2_RC         r;
+
+    iesys_rsrc_nv_public(node, &nvPublic);
+    nvPublic.nvPublic.attributes |= attributes;
+    if (node->rsrc.rsrcType == IESYSC_NV_RSRC) {
+        r = iesys_rsrc_set_nv_public(esys_context, node, &nvPublic);
+        return_if_error(r, "Store public area");
+    }
+    return iesys_nv_get_name(&esys_context->crypto_backend, &nvPublic, &node->rsrc.name);
+}
+
+/** Make an object a session.
+ *
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in,out] node The object.
+ * @param[in] session The session state to copy, NULL for an empty session.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_MEMORY if the session state cannot be allocated.
+ */
+TSS2_RC
+iesys_rsrc_set_session(ESYS_CONTEXT        *esys_context,
+                       RSRC_NODE_T         *node,
+                       const IESYS_SESSION *session) {
+    IESYS_SESSION *copy = calloc(1, sizeof(*copy));
+
+    return_if_null(copy, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+    if (session != NULL) {
+        *copy = *session;
+        /* The crypto state is owned by the object it was created for */
+        memset(&copy->hmacKeyCache, 0, sizeof(copy->hmacKeyCache));
+        memset(&copy->kdfKeyCache, 0, sizeof(copy->kdfKeyCache));
+    }
+    copy->hmacKeyCache.hashAlg = TPM2_ALG_ERROR;
+    copy->kdfKeyCache.hashAlg = TPM2_ALG_ERROR;
+
+    iesys_rsrc_clear(esys_context, node);
+    node->rsrc.rsrcType = IESYSC_SESSION_RSRC;
+    node->rsrc.misc.rsrc_session = copy;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Set the meta data of an object.
+ *
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in,out] node The object.
+ * @param[in] rsrc The meta data in the form used for serialization.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_MEMORY if the meta data cannot be stored.
+ * @retval TSS2_ESYS_RC_BAD_VALUE for an unknown resource type.
+ * @retval TSS2_MU_RC_* if the public area of a key cannot be marshaled.
+ */
+TSS2_RC
+iesys_rsrc_set(ESYS_CONTEXT *esys_context, RSRC_NODE_T *node, const IESYS_RESOURCE *rsrc) {
+    TSS2_RC r = TSS2_RC_SUCCESS;
+
+    switch (rsrc->rsrcType) {
+    case IESYSC_KEY_RSRC:
+        r = iesys_rsrc_set_key_public(esys_context, node, &rsrc->misc.rsrc_key_pub);
+        break;
+    case IESYSC_NV_RSRC:
+        r = iesys_rsrc_set_nv_public(esys_context, node, &rsrc->misc.rsrc_nv_pub);
+        break;
+    case IESYSC_SESSION_RSRC:
+        r = iesys_rsrc_set_session(esys_context, node, &rsrc->misc.rsrc_session);
+        break;
+    case IESYSC_WITHOUT_MISC_RSRC:
+    case IESYSC_DEGRADED_SESSION_RSRC:
+        iesys_rsrc_clear(esys_context, node);
+        node->rsrc.rsrcType = rsrc->rsrcType;
+        break;
+    default:
+        LOG_ERROR("Unknown resource type %" PRIu32, rsrc->rsrcType);
+        return TSS2_ESYS_RC_BAD_VALUE;
+    }
+    return_if_error(r, "Store meta data");
+
+    node->rsrc.handle = rsrc->handle;
+    node->rsrc.name = rsrc->name;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Get the meta data of an object.
+ *
+ * @param[in] node The object.
+ * @param[out] rsrc The meta data in the form used for serialization.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_MU_RC_* if the stored public area of a key is corrupted.
+ */
+TSS2_RC
+iesys_rsrc_get(const RSRC_NODE_T *node, IESYS_RESOURCE *rsrc) {
+    TSS2_RC r = TSS2_RC_SUCCESS;
+
+    memset(rsrc, 0, sizeof(*rsrc));
+    rsrc->handle = node->rsrc.handle;
+    rsrc->name = node->rsrc.name;
+    rsrc->rsrcType = node->rsrc.rsrcType;
+
+    switch (node->rsrc.rsrcType) {
+    case IESYSC_KEY_RSRC:
+        r = iesys_rsrc_key_public(node, &rsrc->misc.rsrc_key_pub);
+        break;
+    case IESYSC_NV_RSRC:
+        iesys_rsrc_nv_public(node, &rsrc->misc.rsrc_nv_pub);
+        break;
+    case IESYSC_SESSION_RSRC:
+        if (node->rsrc.misc.rsrc_session != NULL) {
+            rsrc->misc.rsrc_session = *node->rsrc.misc.rsrc_session;
+            memset(&rsrc->misc.rsrc_session.hmacKeyCache, 0,
+                   sizeof(rsrc->misc.rsrc_session.hmacKeyCache));
+            memset(&rsrc->misc.rsrc_session.kdfKeyCache, 0,
+                   sizeof(rsrc->misc.rsrc_session.kdfKeyCache));
+        }
+        break;
+    default:
+        break;
+    }
+    return r;
+}
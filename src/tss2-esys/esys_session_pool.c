@@ -0,0 +1,408 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for PRIx32, int32_t
+#include <stdbool.h>  // for bool, false, true
+#include <stdlib.h>   // for NULL, size_t, calloc, free
+
+#include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, ESYS_ASSERT_N...
+#include "esys_iutil.h"      // for iesys_thread_enter, iesys_thread_leave
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_RC_...
+#include "tss2_esys.h"       // for ESYS_SESSION_POOL, ESYS_TR, Esys_StartA...
+#include "tss2_tpm2_types.h" // for TPMT_SYM_DEF, TPM2_SE_HMAC, TPMA_SESSION...
+
+#define LOGMODULE esys
+#include "util/log.h" // for return_if_error, LOG_ERROR, SAFE_FREE
+
+/** A session started by a session pool */
+typedef struct {
+    ESYS_TR session; /**< The session */
+    UINT32  uses;    /**< Number of times the session was lent out */
+    bool    lent;    /**< The session is currently lent out */
+} IESYS_POOL_SESSION;
+
+/** A pool of HMAC sessions started ahead of demand
+ *
+ * In serialized mode the pool is guarded by the command slot of its context.
+ */
+struct ESYS_SESSION_POOL {
+    ESYS_CONTEXT       *esys_context; /**< The context the sessions belong to */
+    ESYS_TR             tpmKey;       /**< Key to salt the sessions with */
+    ESYS_TR             bind;         /**< Entity to bind the sessions to */
+    TPM2_SE             sessionType;  /**< Type of the sessions */
+    TPMT_SYM_DEF        symmetric;    /**< Parameter encryption of the sessions */
+    TPMI_ALG_HASH       authHash;     /**< Hash algorithm of the sessions */
+    size_t              min;          /**< Number of idle sessions to keep */
+    size_t              max;          /**< Maximum number of sessions */
+    UINT32              maxUses;      /**< Times a session is lent out, 0 for no limit */
+    bool                pending;      /**< A StartAuthSession is in flight */
+    size_t              count;        /**< Number of used entries of sessions */
+    IESYS_POOL_SESSION *sessions;     /**< The sessions of the pool */
+};
+
+/** Number of idle sessions of a pool. */
+static size_t
+pool_idle(ESYS_SESSION_POOL *pool) {
+    size_t idle = 0;
+    for (size_t i = 0; i < pool->count; i++)
+        if (!pool->sessions[i].lent)
+            idle++;
+    return idle;
+}
+
+/** Check whether a session still exists in the ESYS_CONTEXT.
+ *
+ * ESYS deletes a session after a command that did not continue it.
+ */
+static bool
+pool_session_exists(ESYS_SESSION_POOL *pool, ESYS_TR session) {
+    for (RSRC_NODE_T *node = pool->esys_context->rsrc_list; node != NULL; node = node->next)
+        if (node->esys_handle == session)
+            return true;
+    return false;
+}
+
+/** Remove a session from a pool and from the TPM.
+ *
+ * If the TPM cannot flush the session, e.g. because it was already flushed,
+ * only the ESYS_TR is closed.
+ */
+static void
+pool_retire(ESYS_SESSION_POOL *pool, size_t i) {
+    ESYS_TR session = pool->sessions[i].session;
+
+    if (pool_session_exists(pool, session)
+        && Esys_FlushContext(pool->esys_context, session) != TSS2_RC_SUCCESS) {
+        LOG_WARNING("Flushing pooled session failed, closing it.");
+        Esys_TR_Close(pool->esys_context, &session);
+    }
+
+    pool->sessions[i] = pool->sessions[pool->count - 1];
+    pool->count--;
+}
+
+/** Complete the StartAuthSession in flight of a pool.
+ *
+ * @param[in,out] pool The session pool.
+ * @param[in] timeout The timeout for the TPM response in ms (-1 to block).
+ * @retval TSS2_RC_SUCCESS if no command is in flight (anymore).
+ * @retval TSS2_ESYS_RC_TRY_AGAIN if the TPM did not respond within timeout.
+ * @retval TSS2_RCs produced by Esys_StartAuthSession_Finish.
+ */
+static TSS2_RC
+pool_finish(ESYS_SESSION_POOL *pool, int32_t timeout) {
+    TSS2_RC r;
+    ESYS_TR session = ESYS_TR_NONE;
+    int32_t timeouttmp = pool->esys_context->timeout;
+
+    if (!pool->pending)
+        return TSS2_RC_SUCCESS;
+
+    pool->esys_context->timeout = timeout;
+    do {
+        r = Esys_StartAuthSession_Finish(pool->esys_context, &session);
+    } while (timeout < 0 && base_rc(r) == TSS2_BASE_RC_TRY_AGAIN);
+    pool->esys_context->timeout = timeouttmp;
+
+    if (base_rc(r) == TSS2_BASE_RC_TRY_AGAIN)
+        return TSS2_ESYS_RC_TRY_AGAIN;
+    pool->pending = false;
+    return_if_error(r, "Start pooled session");
+
+    pool->sessions[pool->count].session = session;
+    pool->sessions[pool->count].uses = 0;
+    pool->sessions[pool->count].lent = false;
+    pool->count++;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Start sessions until the pool holds min idle sessions. */
+static TSS2_RC
+pool_refill(ESYS_SESSION_POOL *pool, int32_t timeout) {
+    TSS2_RC r;
+
+    for (;;) {
+        r = pool_finish(pool, timeout);
+        if (r == TSS2_ESYS_RC_TRY_AGAIN)
+            return r;
+        return_if_error(r, "Start pooled session");
+
+        if (pool_idle(pool) >= pool->min || pool->count >= pool->max)
+            return TSS2_RC_SUCCESS;
+
+        r = Esys_StartAuthSession_Async(pool->esys_context, pool->tpmKey, pool->bind, ESYS_TR_NONE,
+                                        ESYS_TR_NONE, ESYS_TR_NONE, NULL, pool->sessionType,
+                                        &pool->symmetric, pool->authHash);
+        return_if_error(r, "Start pooled session");
+        pool->pending = true;
+    }
+}
+
+/** Create a pool of HMAC sessions.
+ *
+ * The pool starts sessions with the given parameters ahead of demand and lends
+ * them out via Esys_SessionPool_Get(), taking away the round trip to the TPM
+ * and the salt encryption of Esys_StartAuthSession from the request path.
+ * Before returning, min sessions are started. Sessions consumed later on are
+ * replaced by Esys_SessionPool_Refill().
+ * The tpmKey and bind objects have to stay loaded as long as the pool exists.
+ * If the context is in serialized mode, its threads may share the pool.
+ * @param esys_context [in,out] The ESYS_CONTEXT the sessions are started in.
+ * @param tpmKey [in] Key to salt the sessions with (or ESYS_TR_NONE).
+ * @param bind [in] Entity to bind the sessions to (or ESYS_TR_NONE).
+ * @param sessionType [in] Type of the sessions, has to be TPM2_SE_HMAC.
+ * @param symmetric [in] Parameter encryption of the sessions.
+ * @param authHash [in] Hash algorithm of the sessions.
+ * @param min [in] Number of idle sessions to keep in the pool.
+ * @param max [in] Maximum number of idle and lent out sessions.
+ * @param pool [out] The session pool. Has to be freed with
+ *        Esys_SessionPool_Free().
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context, symmetric or pool is NULL.
+ * @retval TSS2_ESYS_RC_BAD_VALUE if sessionType is no HMAC session, max is 0
+ *         or min exceeds max.
+ * @retval TSS2_ESYS_RC_MEMORY if memory cannot be allocated.
+ * @retval TSS2_RCs produced by Esys_StartAuthSession.
+ */
+TSS2_RC
+Esys_SessionPool_New(ESYS_CONTEXT       *esys_context,
+                     ESYS_TR             tpmKey,
+                     ESYS_TR             bind,
+                     TPM2_SE             sessionType,
+                     const TPMT_SYM_DEF *symmetric,
+                     TPMI_ALG_HASH       authHash,
+                     size_t              min,
+                     size_t              max,
+                     ESYS_SESSION_POOL **pool) {
+    TSS2_RC            r;
+    ESYS_SESSION_POOL *new_pool;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    ESYS_ASSERT_NON_NULL(symmetric);
+    ESYS_ASSERT_NON_NULL(pool);
+    if (sessionType != TPM2_SE_HMAC) {
+        return_error(TSS2_ESYS_RC_BAD_VALUE, "Only HMAC sessions can be pooled.");
+    }
+    if (max == 0 || min > max) {
+        return_error(TSS2_ESYS_RC_BAD_VALUE, "Bad pool size.");
+    }
+
+    new_pool = calloc(1, sizeof(*new_pool));
+    return_if_null(new_pool, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+    new_pool->sessions = calloc(max, sizeof(new_pool->sessions[0]));
+    if (new_pool->sessions == NULL) {
+        free(new_pool);
+        return_error(TSS2_ESYS_RC_MEMORY, "Out of memory.");
+    }
+
+    new_pool->esys_context = esys_context;
+    new_pool->tpmKey = tpmKey;
+    new_pool->bind = bind;
+    new_pool->sessionType = sessionType;
+    new_pool->symmetric = *symmetric;
+    new_pool->authHash = authHash;
+    new_pool->min = min;
+    new_pool->max = max;
+
+    r = Esys_SessionPool_Refill(new_pool, -1);
+    if (r != TSS2_RC_SUCCESS) {
+        Esys_SessionPool_Free(&new_pool);
+        return_error(r, "Start pooled sessions");
+    }
+
+    *pool = new_pool;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Limit the number of times a pooled session is lent out.
+ *
+ * A session that reached the limit is flushed when it is returned, and the
+ * pool starts a new one instead.
+ * @param pool [in,out] The session pool.
+ * @param maxUses [in] The limit, 0 for no limit (default).
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if pool is NULL.
+ */
+TSS2_RC
+Esys_SessionPool_SetMaxUses(ESYS_SESSION_POOL *pool, UINT32 maxUses) {
+    ESYS_ASSERT_NON_NULL(pool);
+    iesys_thread_enter(pool->esys_context);
+    pool->maxUses = maxUses;
+    iesys_thread_leave(pool->esys_context);
+    return TSS2_RC_SUCCESS;
+}
+
+/** Start sessions for a pool until it holds min idle sessions.
+ *
+ * The sessions are started with Esys_StartAuthSession_Async() and
+ * _Finish(), so that an event loop can refill the pool while it is idle:
+ * called with a timeout of 0 the function returns TSS2_ESYS_RC_TRY_AGAIN as
+ * long as a session is being started, and can be called again once the poll
+ * handles of the ESYS_CONTEXT (see Esys_GetPollHandles()) are readable.
+ * While the function returns TSS2_ESYS_RC_TRY_AGAIN, the ESYS_CONTEXT must not
+ * be used for any other command. Esys_SessionPool_Get(),
+ * Esys_SessionPool_Put() and Esys_SessionPool_Free() complete the pending
+ * start themselves.
+ * In serialized mode (see Esys_SerializedModeEnable()) the function always blocks
+ * until the pool is filled, since the context cannot be kept busy between
+ * calls.
+ * @param pool [in,out] The session pool.
+ * @param timeout [in] The time to wait for a TPM response in ms (-1 to block
+ *        until the pool is filled).
+ * @retval TSS2_RC_SUCCESS if the pool holds min idle sessions or max sessions.
+ * @retval TSS2_ESYS_RC_TRY_AGAIN if a session is still being started.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if pool is NULL.
+ * @retval TSS2_RCs produced by Esys_StartAuthSession_Async or _Finish.
+ */
+TSS2_RC
+Esys_SessionPool_Refill(ESYS_SESSION_POOL *pool, int32_t timeout) {
+    TSS2_RC r;
+
+    ESYS_ASSERT_NON_NULL(pool);
+    if (pool->esys_context->threads != NULL)
+        timeout = -1;
+
+    iesys_thread_enter(pool->esys_context);
+    r = pool_refill(pool, timeout);
+    iesys_thread_leave(pool->esys_context);
+    return r;
+}
+
+/** Lend out an idle session or start a new one. */
+static TSS2_RC
+pool_get(ESYS_SESSION_POOL *pool, ESYS_TR *session) {
+    TSS2_RC r;
+    size_t  i;
+
+    r = pool_finish(pool, -1);
+    return_if_error(r, "Start pooled session");
+
+    for (i = 0; i < pool->count && pool->sessions[i].lent; i++)
+        ;
+    if (i == pool->count) {
+        if (pool->count >= pool->max) {
+            LOG_DEBUG("All %zu pooled sessions are lent out.", pool->count);
+            return TSS2_ESYS_RC_TRY_AGAIN;
+        }
+        r = Esys_StartAuthSession(pool->esys_context, pool->tpmKey, pool->bind, ESYS_TR_NONE,
+                                  ESYS_TR_NONE, ESYS_TR_NONE, NULL, pool->sessionType,
+                                  &pool->symmetric, pool->authHash, &pool->sessions[i].session);
+        return_if_error(r, "Start pooled session");
+        pool->sessions[i].uses = 0;
+        pool->count++;
+    }
+
+    r = Esys_TRSess_SetAttributes(pool->esys_context, pool->sessions[i].session,
+                                  TPMA_SESSION_CONTINUESESSION, 0xff);
+    return_if_error(r, "Set session attributes");
+
+    pool->sessions[i].lent = true;
+    pool->sessions[i].uses++;
+    *session = pool->sessions[i].session;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Lend out a session of a pool.
+ *
+ * The session has only the continueSession attribute set. It has to be given
+ * back with Esys_SessionPool_Put(). If no idle session is available, a new
+ * one is started, unless the pool already holds max sessions.
+ * @param pool [in,out] The session pool.
+ * @param session [out] The session.
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if pool or session is NULL.
+ * @retval TSS2_ESYS_RC_TRY_AGAIN if all max sessions are lent out.
+ * @retval TSS2_RCs produced by Esys_StartAuthSession.
+ */
+TSS2_RC
+Esys_SessionPool_Get(ESYS_SESSION_POOL *pool, ESYS_TR *session) {
+    TSS2_RC r;
+
+    ESYS_ASSERT_NON_NULL(pool);
+    ESYS_ASSERT_NON_NULL(session);
+
+    iesys_thread_enter(pool->esys_context);
+    r = pool_get(pool, session);
+    iesys_thread_leave(pool->esys_context);
+    return r;
+}
+
+/** Take a session back and retire it if needed. */
+static TSS2_RC
+pool_put(ESYS_SESSION_POOL *pool, ESYS_TR session, TSS2_RC rc) {
+    size_t i;
+
+    for (i = 0; i < pool->count; i++)
+        if (pool->sessions[i].session == session && pool->sessions[i].lent)
+            break;
+    if (i == pool->count) {
+        LOG_ERROR("Session 0x%08" PRIx32 " is not lent out by the pool.", session);
+        return TSS2_ESYS_RC_BAD_TR;
+    }
+
+    pool->sessions[i].lent = false;
+    if (!pool_session_exists(pool, session)) {
+        LOG_DEBUG("Pooled session was flushed.");
+        pool->sessions[i] = pool->sessions[pool->count - 1];
+        pool->count--;
+        return TSS2_RC_SUCCESS;
+    }
+
+    if (rc != TSS2_RC_SUCCESS || (pool->maxUses != 0 && pool->sessions[i].uses >= pool->maxUses)) {
+        /* The context has to be idle to flush the session */
+        if (pool_finish(pool, -1) != TSS2_RC_SUCCESS)
+            LOG_WARNING("Starting pooled session failed.");
+        pool_retire(pool, i);
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+/** Give a lent out session back to its pool.
+ *
+ * The session is flushed instead of being lent out again if the command it
+ * was used for failed, since its state may be out of sync with the TPM, or if
+ * it reached the limit set with Esys_SessionPool_SetMaxUses(). A session the
+ * TPM already flushed because continueSession was cleared is dropped.
+ * @param pool [in,out] The session pool.
+ * @param session [in] The session.
+ * @param rc [in] The return code of the last command the session was used for.
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if pool is NULL.
+ * @retval TSS2_ESYS_RC_BAD_TR if session is not lent out by the pool.
+ */
+TSS2_RC
+Esys_SessionPool_Put(ESYS_SESSION_POOL *pool, ESYS_TR session, TSS2_RC rc) {
+    TSS2_RC r;
+
+    ESYS_ASSERT_NON_NULL(pool);
+
+    iesys_thread_enter(pool->esys_context);
+    r = pool_put(pool, session, rc);
+    iesys_thread_leave(pool->esys_context);
+    return r;
+}
+
+/** Flush all sessions of a pool and free it.
+ *
+ * This includes sessions that are still lent out.
+ * @param pool [in,out] The session pool. Will be set to NULL.
+ */
+void
+Esys_SessionPool_Free(ESYS_SESSION_POOL **pool) {
+    if (pool == NULL || *pool == NULL)
+        return;
+
+    iesys_thread_enter((*pool)->esys_context);
+    if (pool_finish(*pool, -1) != TSS2_RC_SUCCESS)
+        LOG_WARNING("Starting pooled session failed.");
+    while ((*pool)->count > 0)
+        pool_retire(*pool, (*pool)->count - 1);
+    iesys_thread_leave((*pool)->esys_context);
+
+    SAFE_FREE((*pool)->sessions);
+    SAFE_FREE(*pool);
+}
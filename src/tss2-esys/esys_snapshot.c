@@ -0,0 +1,388 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for PRIx32, uint8_t, uint32_t
+#include <stdbool.h>  // for bool, false, true
+#include <stdlib.h>   // for NULL, size_t, free, malloc, calloc, realloc
+
+#include "esys_crypto.h"     // for iesys_crypto_backend, IESYS_CRYPTO_BACKEND
+#include "esys_int.h"        // for ESYS_CONTEXT, RSRC_NODE_T, ESYS_STATE_INIT
+#include "esys_iutil.h"      // for esys_CreateResourceObject, iesys_rsrc_get...
+#include "esys_mu.h"         // for iesys_MU_IESYS_RESOURCE_Marshal, iesys_...
+#include "esys_types.h"      // for IESYS_RESOURCE, IESYSC_SESSION_RSRC
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_RC_...
+#include "tss2_esys.h"       // for Esys_Context_Save, Esys_Context_Restore
+#include "tss2_mu.h"         // for Tss2_MU_UINT32_Marshal, Tss2_MU_TPMS_CO...
+#include "tss2_tpm2_types.h" // for TPMS_CONTEXT, TPM2B_AUTH, TPM2_HT_TRANS...
+
+#define LOGMODULE esys
+#include "util/log.h" // for return_if_error, goto_if_error, LOG_ERROR
+
+/*
+ * Layout of a snapshot, all integers in TPM byte order:
+ *   UINT32 magic, UINT16 version, UINT8 crypto backend,
+ *   UINT32 next free ESYS_TR, UINT32 number of objects,
+ * followed for each object by
+ *   UINT32 ESYS_TR, UINT8 kind, TPM2B_AUTH auth value,
+ *   IESYS_RESOURCE (IESYS_SNAPSHOT_METADATA) or
+ *   TPMS_CONTEXT (IESYS_SNAPSHOT_TPM_CONTEXT).
+ */
+#define IESYS_SNAPSHOT_MAGIC       0x45535953 /* 'ESYS' */
+#define IESYS_SNAPSHOT_VERSION     1
+#define IESYS_SNAPSHOT_HEADER_SIZE (4 + 2 + 1 + 4 + 4)
+#define IESYS_SNAPSHOT_ENTRY_SIZE                                                                  \
+    (4 + 1 + sizeof(TPM2B_AUTH)                                                                    \
+     + (sizeof(IESYS_RESOURCE) > sizeof(TPMS_CONTEXT) ? sizeof(IESYS_RESOURCE)                     \
+                                                      : sizeof(TPMS_CONTEXT)))
+
+#define IESYS_SNAPSHOT_METADATA    0 /**< The object is restored from its metadata */
+#define IESYS_SNAPSHOT_TPM_CONTEXT 1 /**< The object is restored with TPM2_ContextLoad */
+
+/** An object of a snapshot */
+typedef struct {
+    ESYS_TR    esys_handle; /**< The ESYS_TR of the object */
+    UINT8      kind;        /**< IESYS_SNAPSHOT_METADATA or IESYS_SNAPSHOT_TPM_CONTEXT */
+    TPM2B_AUTH auth;        /**< The auth value of the object */
+    union {
+        IESYS_RESOURCE rsrc;    /**< The metadata of the object */
+        TPMS_CONTEXT   context; /**< The saved TPM context of the object */
+    } data;
+} IESYS_SNAPSHOT_ENTRY;
+
+/** Check whether an object is saved with TPM2_ContextSave.
+ *
+ * Sessions and transient objects do not survive the connection to the TPM
+ * if a resource manager is used.
+ */
+static bool
+snapshot_is_tpm_context(const RSRC_NODE_T *node) {
+    return node->rsrc.rsrcType == IESYSC_SESSION_RSRC
+           || iesys_get_handle_type(node->rsrc.handle) == TPM2_HT_TRANSIENT;
+}
+
+static RSRC_NODE_T *
+snapshot_find(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle) {
+    for (RSRC_NODE_T *node = esys_context->rsrc_list; node != NULL; node = node->next)
+        if (node->esys_handle == esys_handle)
+            return node;
+    return NULL;
+}
+
+static TSS2_RC
+snapshot_read_entry(const uint8_t        *buffer,
+                    size_t                buffer_size,
+                    size_t               *offset,
+                    IESYS_SNAPSHOT_ENTRY *entry) {
+    TSS2_RC r;
+
+    r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset, &entry->esys_handle);
+    return_if_error(r, "Unmarshal ESYS_TR");
+    r = Tss2_MU_UINT8_Unmarshal(buffer, buffer_size, offset, &entry->kind);
+    return_if_error(r, "Unmarshal object kind");
+    r = Tss2_MU_TPM2B_AUTH_Unmarshal(buffer, buffer_size, offset, &entry->auth);
+    return_if_error(r, "Unmarshal auth value");
+
+    switch (entry->kind) {
+    case IESYS_SNAPSHOT_METADATA:
+        r = iesys_MU_IESYS_RESOURCE_Unmarshal(buffer, buffer_size, offset, &entry->data.rsrc);
+        return_if_error(r, "Unmarshal resource object");
+        break;
+    case IESYS_SNAPSHOT_TPM_CONTEXT:
+        r = Tss2_MU_TPMS_CONTEXT_Unmarshal(buffer, buffer_size, offset, &entry->data.context);
+        return_if_error(r, "Unmarshal TPM context");
+        break;
+    default:
+        LOG_ERROR("Unknown object kind %" PRIu8, entry->kind);
+        return TSS2_ESYS_RC_BAD_VALUE;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+/** Recreate an object of a snapshot with its original ESYS_TR. */
+static TSS2_RC
+snapshot_restore_entry(ESYS_CONTEXT *esys_context, const IESYS_SNAPSHOT_ENTRY *entry) {
+    RSRC_NODE_T *node;
+    ESYS_TR      esys_handle;
+    TSS2_RC      r;
+
+    if (entry->esys_handle == ESYS_TR_NONE || snapshot_find(esys_context, entry->esys_handle)) {
+        LOG_ERROR("Invalid or duplicate ESYS_TR 0x%" PRIx32, entry->esys_handle);
+        return TSS2_ESYS_RC_BAD_VALUE;
+    }
+
+    if (entry->kind == IESYS_SNAPSHOT_METADATA) {
+        r = esys_CreateResourceObject(esys_context, entry->esys_handle, &node);
+        return_if_error(r, "Create resource object");
+        r = iesys_rsrc_set(esys_context, node, &entry->data.rsrc);
+        return_if_error(r, "Store resource object");
+    } else {
+        /* Esys_ContextLoad() hands out the next free ESYS_TR */
+        esys_context->esys_handle_cnt = entry->esys_handle;
+        r = Esys_ContextLoad(esys_context, &entry->data.context, &esys_handle);
+        return_if_error(r, "Load TPM context");
+        node = snapshot_find(esys_context, esys_handle);
+        return_if_null(node, "Loaded object not found", TSS2_ESYS_RC_GENERAL_FAILURE);
+    }
+    node->auth = entry->auth;
+    return TSS2_RC_SUCCESS;
+}
+
+/** Load the sessions of a partial snapshot again after Esys_Context_Save() failed. */
+static void
+snapshot_reload_sessions(ESYS_CONTEXT *esys_context, const uint8_t *buffer, size_t size) {
+    IESYS_SNAPSHOT_ENTRY entry;
+    ESYS_TR              esys_handle_cnt = esys_context->esys_handle_cnt;
+    size_t               offset = IESYS_SNAPSHOT_HEADER_SIZE;
+
+    while (offset < size && snapshot_read_entry(buffer, size, &offset, &entry) == TSS2_RC_SUCCESS) {
+        if (entry.kind != IESYS_SNAPSHOT_TPM_CONTEXT
+            || snapshot_find(esys_context, entry.esys_handle) != NULL)
+            continue;
+        if (snapshot_restore_entry(esys_context, &entry) != TSS2_RC_SUCCESS)
+            LOG_WARNING("Session 0x%" PRIx32 " could not be loaded again.", entry.esys_handle);
+    }
+    esys_context->esys_handle_cnt = esys_handle_cnt;
+}
+
+/** Discard the objects of a partially restored snapshot. */
+static void
+snapshot_discard(ESYS_CONTEXT *esys_context) {
+    RSRC_NODE_T *node = esys_context->rsrc_list;
+
+    while (node != NULL) {
+        ESYS_TR esys_handle = node->esys_handle;
+        bool    flush = snapshot_is_tpm_context(node);
+
+        /* Flushing closes the ESYS_TR, the list is continued after it */
+        node = node->next;
+        if (flush && Esys_FlushContext(esys_context, esys_handle) != TSS2_RC_SUCCESS)
+            LOG_WARNING("Flushing restored object 0x%" PRIx32 " failed.", esys_handle);
+    }
+    iesys_DeleteAllResourceObjects(esys_context);
+}
+
+static TSS2_RC
+snapshot_save_entry(ESYS_CONTEXT *esys_context,
+                    RSRC_NODE_T  *node,
+                    uint8_t      *buffer,
+                    size_t        buffer_size,
+                    size_t       *offset) {
+    TSS2_RC        r;
+    ESYS_TR        esys_handle = node->esys_handle;
+    TPM2B_AUTH     auth = node->auth;
+    UINT8          kind = snapshot_is_tpm_context(node) ? IESYS_SNAPSHOT_TPM_CONTEXT
+                                                        : IESYS_SNAPSHOT_METADATA;
+    IESYS_RESOURCE rsrc;
+    TPMS_CONTEXT  *context = NULL;
+
+    if (kind == IESYS_SNAPSHOT_METADATA) {
+        r = iesys_rsrc_get(node, &rsrc);
+        return_if_error(r, "Get resource object");
+    } else {
+        /* Sessions are closed by Esys_ContextSave() */
+        r = Esys_ContextSave(esys_context, esys_handle, &context);
+        return_if_error(r, "Save TPM context");
+    }
+
+    r = Tss2_MU_UINT32_Marshal(esys_handle, buffer, buffer_size, offset);
+    goto_if_error(r, "Marshal ESYS_TR", cleanup);
+    r = Tss2_MU_UINT8_Marshal(kind, buffer, buffer_size, offset);
+    goto_if_error(r, "Marshal object kind", cleanup);
+    r = Tss2_MU_TPM2B_AUTH_Marshal(&auth, buffer, buffer_size, offset);
+    goto_if_error(r, "Marshal auth value", cleanup);
+    if (kind == IESYS_SNAPSHOT_METADATA)
+        r = iesys_MU_IESYS_RESOURCE_Marshal(&rsrc, buffer, buffer_size, offset);
+    else
+        r = Tss2_MU_TPMS_CONTEXT_Marshal(context, buffer, buffer_size, offset);
+    goto_if_error(r, "Marshal object", cleanup);
+
+cleanup:
+    ESYS_OUTPUT_FREE(esys_context, context);
+    return r;
+}
+
+/** Save all ESYS_TR objects of an ESYS context into one buffer.
+ *
+ * The snapshot contains the metadata and auth values of all ESYS_TR objects,
+ * the state of all sessions and the crypto backend of the context, so that a
+ * new process can continue with Esys_Context_Restore() where this one stopped
+ * without reading public areas or starting sessions again.
+ * Sessions and transient objects are saved with TPM2_ContextSave, since they
+ * do not outlive the connection to a resource manager. Like with
+ * Esys_ContextSave(), the ESYS_TR objects of sessions are closed; all other
+ * objects remain usable.
+ * The snapshot contains auth values and session keys and must be protected
+ * accordingly.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[out] buffer The snapshot. Shall be freed using Esys_Free().
+ * @param[out] buffer_size The size of the snapshot.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if a pointer is NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE if a command of the context is pending.
+ * @retval TSS2_ESYS_RC_MEMORY if the snapshot cannot be allocated.
+ * @retval TSS2_RCs produced by Esys_ContextSave(). Sessions saved before the
+ *         error are loaded again.
+ */
+TSS2_RC
+Esys_Context_Save(ESYS_CONTEXT *esys_context, uint8_t **buffer, size_t *buffer_size) {
+    TSS2_RC      r;
+    RSRC_NODE_T *node;
+    ESYS_TR     *handles = NULL;
+    uint8_t     *data = NULL, *shrunk;
+    size_t       count = 0, size, offset = 0, i;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    ESYS_ASSERT_NON_NULL(buffer);
+    ESYS_ASSERT_NON_NULL(buffer_size);
+    iesys_thread_enter(esys_context);
+    if (esys_context->state != ESYS_STATE_INIT) {
+        LOG_ERROR("Esys called in bad sequence.");
+        iesys_thread_leave(esys_context);
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+
+    for (node = esys_context->rsrc_list; node != NULL; node = node->next)
+        count++;
+    /* Saving sessions modifies the list of objects */
+    handles = calloc(count + 1, sizeof(*handles));
+    goto_if_null(handles, "Out of memory.", TSS2_ESYS_RC_MEMORY, error_cleanup);
+    for (node = esys_context->rsrc_list, i = 0; node != NULL; node = node->next)
+        handles[i++] = node->esys_handle;
+
+    size = IESYS_SNAPSHOT_HEADER_SIZE + count * IESYS_SNAPSHOT_ENTRY_SIZE;
+    data = malloc(size);
+    goto_if_null(data, "Out of memory.", TSS2_ESYS_RC_MEMORY, error_cleanup);
+
+    r = Tss2_MU_UINT32_Marshal(IESYS_SNAPSHOT_MAGIC, data, size, &offset);
+    goto_if_error(r, "Marshal header", error_cleanup);
+    r = Tss2_MU_UINT16_Marshal(IESYS_SNAPSHOT_VERSION, data, size, &offset);
+    goto_if_error(r, "Marshal header", error_cleanup);
+    r = Tss2_MU_UINT8_Marshal(iesys_crypto_backend(&esys_context->crypto_backend), data, size,
+                              &offset);
+    goto_if_error(r, "Marshal header", error_cleanup);
+    r = Tss2_MU_UINT32_Marshal(esys_context->esys_handle_cnt, data, size, &offset);
+    goto_if_error(r, "Marshal header", error_cleanup);
+    r = Tss2_MU_UINT32_Marshal((UINT32)count, data, size, &offset);
+    goto_if_error(r, "Marshal header", error_cleanup);
+
+    /* The metadata first, so that an error does not leave sessions saved */
+    for (int pass = 0; pass < 2; pass++) {
+        for (i = 0; i < count; i++) {
+            node = snapshot_find(esys_context, handles[i]);
+            if (node == NULL || snapshot_is_tpm_context(node) != (pass == 1))
+                continue;
+            r = snapshot_save_entry(esys_context, node, data, size, &offset);
+            goto_if_error(r, "Save object", error_cleanup);
+        }
+    }
+
+    shrunk = realloc(data, offset);
+    *buffer = (shrunk != NULL) ? shrunk : data;
+    *buffer_size = offset;
+    free(handles);
+    iesys_thread_leave(esys_context);
+    return TSS2_RC_SUCCESS;
+
+error_cleanup:
+    if (data != NULL)
+        snapshot_reload_sessions(esys_context, data, offset);
+    free(data);
+    free(handles);
+    iesys_thread_leave(esys_context);
+    return r;
+}
+
+/** Restore the ESYS_TR objects of a snapshot into an ESYS context.
+ *
+ * The objects keep the ESYS_TR values they had in the context that was saved
+ * with Esys_Context_Save(). The context must not contain any ESYS_TR objects
+ * and must use the same crypto backend; Esys_SetCryptoCallbacks() has to be
+ * called before. Only sessions and transient objects need a TPM command
+ * (TPM2_ContextLoad), all other objects are restored from the snapshot alone.
+ * The buffer is only read, so a pre-forked worker pool can read the snapshot
+ * once in the parent and restore it in each child into a context with its own
+ * TCTI. Since a saved session can be loaded only once, a snapshot restored by
+ * several processes should be taken without sessions.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] buffer The snapshot.
+ * @param[in] buffer_size The size of the snapshot.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if a pointer is NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE if a command of the context is pending or
+ *         the context already contains ESYS_TR objects.
+ * @retval TSS2_ESYS_RC_BAD_VALUE if the snapshot is invalid, of an unknown
+ *         version or was taken with a different crypto backend.
+ * @retval TSS2_ESYS_RC_MEMORY if an object cannot be allocated.
+ * @retval TSS2_RCs produced by Esys_ContextLoad(). All objects restored before
+ *         the error are flushed and closed.
+ */
+TSS2_RC
+Esys_Context_Restore(ESYS_CONTEXT *esys_context, const uint8_t *buffer, size_t buffer_size) {
+    TSS2_RC               r;
+    IESYS_SNAPSHOT_ENTRY *entry = NULL;
+    ESYS_TR               old_handle_cnt;
+    UINT32                magic, esys_handle_cnt, count;
+    UINT16                version;
+    UINT8                 backend;
+    size_t                offset = 0;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    ESYS_ASSERT_NON_NULL(buffer);
+
+    r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, &offset, &magic);
+    return_if_error(r, "Unmarshal header");
+    r = Tss2_MU_UINT16_Unmarshal(buffer, buffer_size, &offset, &version);
+    return_if_error(r, "Unmarshal header");
+    if (magic != IESYS_SNAPSHOT_MAGIC || version != IESYS_SNAPSHOT_VERSION) {
+        LOG_ERROR("Not a snapshot of version %i.", IESYS_SNAPSHOT_VERSION);
+        return TSS2_ESYS_RC_BAD_VALUE;
+    }
+    r = Tss2_MU_UINT8_Unmarshal(buffer, buffer_size, &offset, &backend);
+    return_if_error(r, "Unmarshal header");
+    if (backend != iesys_crypto_backend(&esys_context->crypto_backend)) {
+        LOG_ERROR("Snapshot was taken with a different crypto backend.");
+        return TSS2_ESYS_RC_BAD_VALUE;
+    }
+    r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, &offset, &esys_handle_cnt);
+    return_if_error(r, "Unmarshal header");
+    r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, &offset, &count);
+    return_if_error(r, "Unmarshal header");
+
+    iesys_thread_enter(esys_context);
+    if (esys_context->state != ESYS_STATE_INIT || esys_context->rsrc_list != NULL) {
+        LOG_ERROR("Snapshots can only be restored into an idle context without objects.");
+        iesys_thread_leave(esys_context);
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+    old_handle_cnt = esys_context->esys_handle_cnt;
+    entry = malloc(sizeof(*entry));
+    goto_if_null(entry, "Out of memory.", TSS2_ESYS_RC_MEMORY, error_cleanup);
+
+    for (UINT32 i = 0; i < count; i++) {
+        r = snapshot_read_entry(buffer, buffer_size, &offset, entry);
+        goto_if_error(r, "Read object", error_cleanup);
+        r = snapshot_restore_entry(esys_context, entry);
+        goto_if_error(r, "Restore object", error_cleanup);
+    }
+    if (offset != buffer_size) {
+        LOG_ERROR("Trailing data after the snapshot.");
+        r = TSS2_ESYS_RC_BAD_VALUE;
+        goto error_cleanup;
+    }
+
+    esys_context->esys_handle_cnt = esys_handle_cnt;
+    free(entry);
+    iesys_thread_leave(esys_context);
+    return TSS2_RC_SUCCESS;
+
+error_cleanup:
+    snapshot_discard(esys_context);
+    esys_context->esys_handle_cnt = old_handle_cnt;
+    free(entry);
+    iesys_thread_leave(esys_context);
+    return r;
+}
@@ -0,0 +1,295 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <stdbool.h> // for bool, true
+#include <stdlib.h>  // for NULL, calloc, free, size_t
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h> // for pthread_mutex_lock, pthread_mutex_unlock, pth...
+#endif
+
+#include "esys_int.h"    // for ESYS_CONTEXT, IESYS_THREADS, ESYS_ASSERT_NO...
+#include "esys_iutil.h"  // for iesys_thread_enter, iesys_thread_leave, ESYS...
+#include "tss2_common.h" // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_RC_BAD_...
+#include "tss2_esys.h"   // for Esys_SerializedModeDisable, Esys_SerializedModeEnable
+
+#define LOGMODULE esys
+#include "util/log.h" // for LOG_ERROR, return_if_null
+
+#ifdef HAVE_PTHREAD
+
+/*
+ * In serialized mode the commands of a context run one at a time, each in a
+ * command slot handed on in the order it was requested. The slot covers the
+ * whole command, from the preparation in _Async, which works on the single
+ * command buffer and session state of the context, to the response
+ * processing in _Finish. The thread holding the slot
+ * may enter it again, e.g. for the commands sent by Esys_HashStream or for
+ * Esys_TR_Close called while a command finishes. While the slot is held, the
+ * resource objects of the context are locked for writing. The functions that
+ * only read resource objects share the lock with each other instead of
+ * waiting for the slot.
+ */
+struct IESYS_THREADS {
+    pthread_mutex_t  lock;
+    pthread_cond_t   turn;    /**< Signals that the command slot was handed on. */
+    pthread_rwlock_t tr_lock; /**< Guards the resource objects of the context. */
+    unsigned long    next;    /**< Next ticket of the command queue. */
+    unsigned long    serving; /**< The ticket holding the command slot. */
+    pthread_t        owner;   /**< The thread holding the command slot. */
+    size_t           depth;   /**< Nesting of the owner, 0 if the slot is free. */
+};
+
+static bool
+thread_is_owner(IESYS_THREADS *threads) {
+    return threads->depth > 0 && pthread_equal(threads->owner, pthread_self());
+}
+
+/** Acquire the command slot of a context in serialized mode.
+ *
+ * Called by the functions that send commands or change resource objects
+ * before they touch the context. Waits until the commands requested earlier
+ * by other threads have finished. Does nothing if the serialized mode is
+ * disabled.
+ * @param[in,out] esys_context The ESYS_CONTEXT, may be NULL.
+ */
+void
+iesys_thread_enter(ESYS_CONTEXT *esys_context) {
+    IESYS_THREADS *threads;
+    unsigned long  ticket;
+
+    if (esys_context == NULL || esys_context->threads == NULL)
+        return;
+    threads = esys_context->threads;
+
+    pthread_mutex_lock(&threads->lock);
+    if (thread_is_owner(threads)) {
+        threads->depth++;
+        pthread_mutex_unlock(&threads->lock);
+        return;
+    }
+    ticket = threads->next++;
+    while (ticket != threads->serving)
+        pthread_cond_wait(&threads->turn, &threads->lock);
+    threads->owner = pthread_self();
+    threads->depth = 1;
+    pthread_mutex_unlock(&threads->lock);
+
+    pthread_rwlock_wrlock(&threads->tr_lock);
+}
+
+/** Release the command slot acquired by iesys_thread_enter.
+ *
+ * @param[in,out] esys_context The ESYS_CONTEXT, may be NULL.
+ */
+void
+iesys_thread_leave(ESYS_CONTEXT *esys_context) {
+    IESYS_THREADS *threads;
+
+    if (esys_context == NULL || esys_context->threads == NULL)
+        return;
+    threads = esys_context->threads;
+
+    pthread_mutex_lock(&threads->lock);
+    if (!thread_is_owner(threads)) {
+        LOG_ERROR("Command slot released by a thread not holding it.");
+    } else if (--threads->depth == 0) {
+        pthread_rwlock_unlock(&threads->tr_lock);
+        threads->serving++;
+        pthread_cond_broadcast(&threads->turn);
+    }
+    pthread_mutex_unlock(&threads->lock);
+}
+
+/** Check whether the calling thread may use the context for a command.
+ *
+ * @param[in] esys_context The ESYS_CONTEXT.
+ * @retval true if the serialized mode is disabled or the calling thread holds
+ *         the command slot.
+ */
+bool
+iesys_thread_owned(ESYS_CONTEXT *esys_context) {
+    IESYS_THREADS *threads = esys_context->threads;
+    bool           owned;
+
+    if (threads == NULL)
+        return true;
+    pthread_mutex_lock(&threads->lock);
+    owned = thread_is_owner(threads);
+    pthread_mutex_unlock(&threads->lock);
+    return owned;
+}
+
+/** Lock the resource objects of a context for reading in serialized mode.
+ *
+ * Objects of TPM handles, such as hierarchies and PCRs, are created on first
+ * use, so lookups of those take the command slot instead. A thread holding
+ * the command slot does not lock again.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] esys_handle The ESYS_TR that will be looked up.
+ */
+void
+iesys_thread_read_lock(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle) {
+    if (esys_context->threads == NULL)
+        return;
+    if (esys_handle < ESYS_TR_MIN_OBJECT)
+        iesys_thread_enter(esys_context);
+    else if (!iesys_thread_owned(esys_context))
+        pthread_rwlock_rdlock(&esys_context->threads->tr_lock);
+}
+
+/** Unlock the resource objects locked by iesys_thread_read_lock.
+ *
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @param[in] esys_handle The ESYS_TR passed to iesys_thread_read_lock.
+ */
+void
+iesys_thread_read_unlock(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle) {
+    if (esys_context->threads == NULL)
+        return;
+    if (esys_handle < ESYS_TR_MIN_OBJECT)
+        iesys_thread_leave(esys_context);
+    else if (!iesys_thread_owned(esys_context))
+        pthread_rwlock_unlock(&esys_context->threads->tr_lock);
+}
+
+/** Release the serialized mode state of an ESYS context. */
+void
+iesys_thread_release(ESYS_CONTEXT *esys_context) {
+    IESYS_THREADS *threads = esys_context->threads;
+
+    if (threads == NULL)
+        return;
+    pthread_rwlock_destroy(&threads->tr_lock);
+    pthread_cond_destroy(&threads->turn);
+    pthread_mutex_destroy(&threads->lock);
+    free(threads);
+    esys_context->threads = NULL;
+}
+
+#else /* HAVE_PTHREAD */
+
+/* Without thread support the serialized mode cannot be enabled */
+
+void
+iesys_thread_enter(ESYS_CONTEXT *esys_context) {
+    (void)esys_context;
+}
+
+void
+iesys_thread_leave(ESYS_CONTEXT *esys_context) {
+    (void)esys_context;
+}
+
+bool
+iesys_thread_owned(ESYS_CONTEXT *esys_context) {
+    (void)esys_context;
+    return true;
+}
+
+void
+iesys_thread_read_lock(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle) {
+    (void)esys_context;
+    (void)esys_handle;
+}
+
+void
+iesys_thread_read_unlock(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle) {
+    (void)esys_context;
+    (void)esys_handle;
+}
+
+void
+iesys_thread_release(ESYS_CONTEXT *esys_context) {
+    (void)esys_context;
+}
+
+#endif /* HAVE_PTHREAD */
+
+/** Release the command slot if the command could not be started.
+ *
+ * @param[in,out] esys_context The ESYS_CONTEXT, may be NULL.
+ * @param[in] r The result of the _Async function.
+ */
+void
+iesys_thread_leave_if_error(ESYS_CONTEXT *esys_context, TSS2_RC r) {
+    if (r != TSS2_RC_SUCCESS)
+        iesys_thread_leave(esys_context);
+}
+
+/** Enable the serialized mode of an ESYS context.
+ *
+ * Afterwards many threads may share the context and its TCTI without locking
+ * of their own. The mode makes sharing safe, it does not make the commands
+ * concurrent: each command runs as a whole, including the marshaling, the
+ * session HMACs and parameter encryption before it is sent and the checks
+ * of its response, while the commands of the other threads wait in the order
+ * they were called. Threads that need their commands prepared in parallel
+ * use one context each. Esys_TR_GetName, Esys_TR_GetTpmHandle,
+ * Esys_TR_Serialize and the Esys_TRSess getters of objects and sessions only
+ * read the context and run concurrently with each other.
+ * Only the synchronous functions may be called in this mode. The _Async
+ * functions fail with TSS2_ESYS_RC_BAD_SEQUENCE, since the _Finish call that
+ * ends the command could come from any thread. The functions changing the
+ * context as a whole, e.g. Esys_Finalize, Esys_SetTimeout or
+ * Esys_SerializedModeDisable, must not run concurrently with other calls.
+ * Calling this function again has no effect.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE if a command of the context is pending.
+ * @retval TSS2_ESYS_RC_MEMORY if the state cannot be allocated.
+ * @retval TSS2_ESYS_RC_NOT_IMPLEMENTED if the library was built without thread
+ *         support.
+ */
+TSS2_RC
+Esys_SerializedModeEnable(ESYS_CONTEXT *esys_context) {
+    ESYS_ASSERT_NON_NULL(esys_context);
+    if (esys_context->state != ESYS_STATE_INIT) {
+        LOG_ERROR("Esys called in bad sequence.");
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+
+#ifdef HAVE_PTHREAD
+    IESYS_THREADS *threads;
+
+    if (esys_context->threads != NULL)
+        return TSS2_RC_SUCCESS;
+
+    threads = calloc(1, sizeof(*threads));
+    return_if_null(threads, "Out of memory.", TSS2_ESYS_RC_MEMORY);
+    pthread_mutex_init(&threads->lock, NULL);
+    pthread_cond_init(&threads->turn, NULL);
+    pthread_rwlock_init(&threads->tr_lock, NULL);
+    esys_context->threads = threads;
+    return TSS2_RC_SUCCESS;
+#else
+    LOG_ERROR("Built without thread support.");
+    return TSS2_ESYS_RC_NOT_IMPLEMENTED;
+#endif
+}
+
+/** Disable the serialized mode of an ESYS context.
+ *
+ * Must only be called once the other threads stopped using the context.
+ * Calling this function if the mode is disabled has no effect.
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @retval TSS2_RC_SUCCESS on success.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if esys_context is NULL.
+ * @retval TSS2_ESYS_RC_BAD_SEQUENCE if a command of the context is pending.
+ */
+TSS2_RC
+Esys_SerializedModeDisable(ESYS_CONTEXT *esys_context) {
+    ESYS_ASSERT_NON_NULL(esys_context);
+    if (esys_context->state != ESYS_STATE_INIT) {
+        LOG_ERROR("Esys called in bad sequence.");
+        return TSS2_ESYS_RC_BAD_SEQUENCE;
+    }
+
+    iesys_thread_release(esys_context);
+    return TSS2_RC_SUCCESS;
+}
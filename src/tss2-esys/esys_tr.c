@@ -14,7 +14,7 @@
 #include <string.h>   // for memcmp
 
 #include "esys_int.h"        // for RSRC_NODE_T, ESYS_CONTEXT, _ESYS_ASSERT...
-#include "esys_iutil.h"      // for esys_GetResourceObject, iesys_compute_s...
+#include "esys_iutil.h"      // for esys_GetResourceObject, iesys_name_cach...
 #include "esys_mu.h"         // for iesys_MU_IESYS_RESOURCE_Marshal, iesys_...
 #include "esys_types.h"      // for IESYS_RESOURCE, IESYS_RSRC_UNION, IESYS...
 #include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_RC_...
@@ -25,6 +25,36 @@
 #define LOGMODULE esys
 #include "util/log.h" // for return_if_error, SAFE_FREE, goto_if_error
 
+static TSS2_RC
+tr_serialize(ESYS_CONTEXT *esys_context,
+             ESYS_TR       esys_handle,
+             uint8_t     **buffer,
+             size_t       *buffer_size) {
+    TSS2_RC        r = TSS2_RC_SUCCESS;
+    RSRC_NODE_T   *esys_object;
+    IESYS_RESOURCE rsrc;
+    size_t         offset = 0;
+    *buffer_size = 0;
+
+    r = esys_GetResourceObject(esys_context, esys_handle, &esys_object);
+    return_if_error(r, "Get resource object");
+    return_if_null(esys_object, "Esys object not found", TSS2_ESYS_RC_BAD_VALUE);
+
+    r = iesys_rsrc_get(esys_object, &rsrc);
+    return_if_error(r, "Get resource object");
+
+    r = iesys_MU_IESYS_RESOURCE_Marshal(&rsrc, NULL, SIZE_MAX, buffer_size);
+    return_if_error(r, "Marshal resource object");
+
+    *buffer = malloc(*buffer_size);
+    return_if_null(*buffer, "Buffer could not be allocated", TSS2_ESYS_RC_MEMORY);
+
+    r = iesys_MU_IESYS_RESOURCE_Marshal(&rsrc, *buffer, *buffer_size, &offset);
+    return_if_error(r, "Marshal resource object");
+
+    return TSS2_RC_SUCCESS;
+}
+
 /** Serialization of an ESYS_TR into a byte buffer.
  *
  * Serialize the metadata of an ESYS_TR object into a byte buffer such that it
@@ -48,26 +78,38 @@ Esys_TR_Serialize(ESYS_CONTEXT *esys_context,
                   ESYS_TR       esys_handle,
                   uint8_t     **buffer,
                   size_t       *buffer_size) {
-    TSS2_RC      r = TSS2_RC_SUCCESS;
-    RSRC_NODE_T *esys_object;
-    size_t       offset = 0;
-    *buffer_size = 0;
+    TSS2_RC r;
 
-    r = esys_GetResourceObject(esys_context, esys_handle, &esys_object);
-    return_if_error(r, "Get resource object");
-    return_if_null(esys_object, "Esys object not found", TSS2_ESYS_RC_BAD_VALUE);
+    ESYS_ASSERT_NON_NULL(esys_context);
+    iesys_thread_read_lock(esys_context, esys_handle);
+    r = tr_serialize(esys_context, esys_handle, buffer, buffer_size);
+    iesys_thread_read_unlock(esys_context, esys_handle);
+    return r;
+}
 
-    r = iesys_MU_IESYS_RESOURCE_Marshal(&esys_object->rsrc, NULL, SIZE_MAX, buffer_size);
-    return_if_error(r, "Marshal resource object");
+static TSS2_RC
+tr_deserialize(ESYS_CONTEXT  *esys_context,
+               uint8_t const *buffer,
+               size_t         buffer_size,
+               ESYS_TR       *esys_handle) {
+    TSS2_RC r;
 
-    *buffer = malloc(*buffer_size);
-    return_if_null(*buffer, "Buffer could not be allocated", TSS2_ESYS_RC_MEMORY);
+    RSRC_NODE_T   *esys_object;
+    IESYS_RESOURCE rsrc;
+    size_t         offset = 0;
 
-    r = iesys_MU_IESYS_RESOURCE_Marshal(&esys_object->rsrc, *buffer, *buffer_size, &offset);
-    return_if_error(r, "Marshal resource object");
+    *esys_handle = esys_context->esys_handle_cnt++;
+    r = esys_CreateResourceObject(esys_context, *esys_handle, &esys_object);
+    return_if_error(r, "Get resource object");
+
+    r = iesys_MU_IESYS_RESOURCE_Unmarshal(buffer, buffer_size, &offset, &rsrc);
+    return_if_error(r, "Unmarshal resource object");
+
+    r = iesys_rsrc_set(esys_context, esys_object, &rsrc);
+    return_if_error(r, "Store resource object");
 
     return TSS2_RC_SUCCESS;
-};
+}
 
 /** Deserialization of an ESYS_TR from a byte buffer.
  *
@@ -91,18 +133,11 @@ Esys_TR_Deserialize(ESYS_CONTEXT  *esys_context,
                     ESYS_TR       *esys_handle) {
     TSS2_RC r;
 
-    RSRC_NODE_T *esys_object;
-    size_t       offset = 0;
-
     ESYS_ASSERT_NON_NULL(esys_context);
-    *esys_handle = esys_context->esys_handle_cnt++;
-    r = esys_CreateResourceObject(esys_context, *esys_handle, &esys_object);
-    return_if_error(r, "Get resource object");
-
-    r = iesys_MU_IESYS_RESOURCE_Unmarshal(buffer, buffer_size, &offset, &esys_object->rsrc);
-    return_if_error(r, "Unmarshal resource object");
-
-    return TSS2_RC_SUCCESS;
+    iesys_thread_enter(esys_context);
+    r = tr_deserialize(esys_context, buffer, buffer_size, esys_handle);
+    iesys_thread_leave(esys_context);
+    return r;
 }
 
 /** Start synchronous creation of an ESYS_TR object from TPM metadata.
@@ -138,10 +173,11 @@ Esys_TR_FromTPMPublic_Async(ESYS_CONTEXT *esys_context,
                             ESYS_TR       shandle3) {
     TSS2_RC r;
     ESYS_ASSERT_NON_NULL(esys_context);
-    ESYS_TR      esys_handle = esys_context->esys_handle_cnt++;
-    RSRC_NODE_T *esysHandleNode = NULL;
-    RSRC_NODE_T *node_rsrc = NULL;
-    RSRC_NODE_T *next_node_rsrc;
+    ESYS_TR        esys_handle = esys_context->esys_handle_cnt++;
+    RSRC_NODE_T   *esysHandleNode = NULL;
+    RSRC_NODE_T   *node_rsrc = NULL;
+    RSRC_NODE_T   *next_node_rsrc;
+    IESYS_RESOURCE cached;
 
     for (node_rsrc = esys_context->rsrc_list; node_rsrc != NULL; node_rsrc = next_node_rsrc) {
         if (node_rsrc->rsrc.handle == tpm_handle) {
@@ -158,6 +194,20 @@ Esys_TR_FromTPMPublic_Async(ESYS_CONTEXT *esys_context,
         r = esys_CreateResourceObject(esys_context, esys_handle, &esysHandleNode);
         goto_if_error(r, "Error create resource", error_cleanup);
 
+        esys_context->name_cache_state = IESYS_NAME_CACHE_NONE;
+        if (iesys_name_cache_load(esys_context, tpm_handle, &cached)) {
+            r = iesys_rsrc_set(esys_context, esysHandleNode, &cached);
+            goto_if_error(r, "Error store cached resource", error_cleanup);
+            esys_context->esys_handle = esys_handle;
+            if (esys_context->name_cache_flags & ESYS_NAME_CACHE_NO_VERIFY) {
+                esys_context->name_cache_state = IESYS_NAME_CACHE_HIT;
+                return TSS2_RC_SUCCESS;
+            }
+            /* The cached name is verified by a single query with the sessions */
+            esys_context->name_cache_state = IESYS_NAME_CACHE_VERIFY;
+            goto read_public;
+        }
+
         /* In the first trial no session will be used to determine the object name. */
         esys_context->sav_session1 = shandle1;
         esys_context->sav_session2 = shandle2;
@@ -175,6 +225,7 @@ Esys_TR_FromTPMPublic_Async(ESYS_CONTEXT *esys_context,
         esys_context->esys_handle = esys_handle;
     }
 
+read_public:
     if (tpm_handle >= TPM2_NV_INDEX_FIRST && tpm_handle <= TPM2_NV_INDEX_LAST) {
         r = Esys_NV_ReadPublic_Async(esys_context, esys_handle, shandle1, shandle2, shandle3);
         goto_if_error(r, "Error NV_ReadPublic", error_cleanup);
@@ -234,6 +285,13 @@ Esys_TR_FromTPMPublic_Finish(ESYS_CONTEXT *esys_context, ESYS_TR *object) {
     /* Check whether the object was already initialized. */
     first_call = !objectHandleNode->rsrc.rsrcType;
 
+    if (esys_context->name_cache_state == IESYS_NAME_CACHE_HIT) {
+        esys_context->name_cache_state = IESYS_NAME_CACHE_NONE;
+        objectHandleNode->reference_count++;
+        *object = objectHandle;
+        return TSS2_RC_SUCCESS;
+    }
+
     if (objectHandleNode->rsrc.handle >= TPM2_NV_INDEX_FIRST
         && objectHandleNode->rsrc.handle <= TPM2_NV_INDEX_LAST) {
         TPM2B_NV_PUBLIC *nvPublic;
@@ -247,24 +305,33 @@ Esys_TR_FromTPMPublic_Finish(ESYS_CONTEXT *esys_context, ESYS_TR *object) {
 
         bool is_nvname_mismatch = false;
         if (first_call) {
-            objectHandleNode->rsrc.rsrcType = IESYSC_NV_RSRC;
+            r = iesys_rsrc_set_nv_public(esys_context, objectHandleNode, nvPublic);
             objectHandleNode->rsrc.name = *nvName;
-            objectHandleNode->rsrc.misc.rsrc_nv_pub = *nvPublic;
+            esys_context->name_cache_state = IESYS_NAME_CACHE_STORE;
         } else {
             if (objectHandleNode->rsrc.name.size != nvName->size
                 || memcmp(&objectHandleNode->rsrc.name.name[0], &nvName->name[0], nvName->size)
                        != 0) {
-                is_nvname_mismatch = true;
+                if (esys_context->name_cache_state == IESYS_NAME_CACHE_VERIFY) {
+                    LOG_DEBUG("Replacing outdated name cache entry");
+                    r = iesys_rsrc_set_nv_public(esys_context, objectHandleNode, nvPublic);
+                    objectHandleNode->rsrc.name = *nvName;
+                    esys_context->name_cache_state = IESYS_NAME_CACHE_STORE;
+                } else {
+                    is_nvname_mismatch = true;
+                }
             }
         }
-        SAFE_FREE(nvPublic);
-        SAFE_FREE(nvName);
+        ESYS_OUTPUT_FREE(esys_context, nvPublic);
+        ESYS_OUTPUT_FREE(esys_context, nvName);
+        goto_if_error(r, "Error store NV public area", error_cleanup);
         if (is_nvname_mismatch) {
             goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE,
                        "Name mismatch between two calls of Esys_TR_FromTPMPublic", error_cleanup);
         }
     } else if (objectHandleNode->rsrc.handle >> TPM2_HR_SHIFT == TPM2_HT_LOADED_SESSION
                || objectHandleNode->rsrc.handle >> TPM2_HR_SHIFT == TPM2_HT_SAVED_SESSION) {
+        iesys_rsrc_clear(esys_context, objectHandleNode);
         objectHandleNode->rsrc.rsrcType = IESYSC_DEGRADED_SESSION_RSRC;
     } else {
         TPM2B_PUBLIC *public;
@@ -278,23 +345,30 @@ Esys_TR_FromTPMPublic_Finish(ESYS_CONTEXT *esys_context, ESYS_TR *object) {
         goto_if_error(r, "Error ReadPublic", error_cleanup);
 
         if (first_call) {
-            objectHandleNode->rsrc.rsrcType = IESYSC_KEY_RSRC;
+            r = iesys_rsrc_set_key_public(esys_context, objectHandleNode, public);
             objectHandleNode->rsrc.name = *name;
-            objectHandleNode->rsrc.misc.rsrc_key_pub = *public;
-        } else {
-            if (objectHandleNode->rsrc.name.size != name->size
-                || memcmp(&objectHandleNode->rsrc.name.name[0], &name->name[0], name->size) != 0) {
-                SAFE_FREE(public);
-                SAFE_FREE(name);
-                SAFE_FREE(qualifiedName);
+            esys_context->name_cache_state = IESYS_NAME_CACHE_STORE;
+        } else if (objectHandleNode->rsrc.name.size != name->size
+                   || memcmp(&objectHandleNode->rsrc.name.name[0], &name->name[0], name->size)
+                          != 0) {
+            if (esys_context->name_cache_state == IESYS_NAME_CACHE_VERIFY) {
+                LOG_DEBUG("Replacing outdated name cache entry");
+                r = iesys_rsrc_set_key_public(esys_context, objectHandleNode, public);
+                objectHandleNode->rsrc.name = *name;
+                esys_context->name_cache_state = IESYS_NAME_CACHE_STORE;
+            } else {
+                ESYS_OUTPUT_FREE(esys_context, public);
+                ESYS_OUTPUT_FREE(esys_context, name);
+                ESYS_OUTPUT_FREE(esys_context, qualifiedName);
                 goto_error(r, TSS2_ESYS_RC_GENERAL_FAILURE,
                            "Name mismatch between two calls of Esys_TR_FromTPMPublic",
                            error_cleanup);
             }
         }
-        SAFE_FREE(public);
-        SAFE_FREE(name);
-        SAFE_FREE(qualifiedName);
+        ESYS_OUTPUT_FREE(esys_context, public);
+        ESYS_OUTPUT_FREE(esys_context, name);
+        ESYS_OUTPUT_FREE(esys_context, qualifiedName);
+        goto_if_error(r, "Error store public area", error_cleanup);
     }
 
     if (esys_context->sav_session1 != ESYS_TR_NONE && first_call) {
@@ -317,12 +391,16 @@ Esys_TR_FromTPMPublic_Finish(ESYS_CONTEXT *esys_context, ESYS_TR *object) {
         return_if_error(r, "Error TR FromTPMPublic");
         return TSS2_ESYS_RC_TRY_AGAIN;
     } else {
+        if (esys_context->name_cache_state == IESYS_NAME_CACHE_STORE)
+            iesys_name_cache_store(esys_context, objectHandleNode);
+        esys_context->name_cache_state = IESYS_NAME_CACHE_NONE;
         objectHandleNode->reference_count++;
         *object = objectHandle;
         return TSS2_RC_SUCCESS;
     }
 
 error_cleanup:
+    esys_context->name_cache_state = IESYS_NAME_CACHE_NONE;
     Esys_TR_Close(esys_context, &objectHandle);
     return r;
 }
@@ -378,7 +456,9 @@ Esys_TR_FromTPMPublic(ESYS_CONTEXT *esys_context,
     TSS2_RC r;
 
     ESYS_ASSERT_NON_NULL(esys_context);
+    iesys_thread_enter(esys_context);
     r = Esys_TR_FromTPMPublic_Async(esys_context, tpm_handle, shandle1, shandle2, shandle3);
+    iesys_thread_leave_if_error(esys_context, r);
     return_if_error(r, "Error TR FromTPMPublic");
 
     /* Set the timeout to indefinite for now, since we want _Finish to block */
@@ -399,30 +479,17 @@ Esys_TR_FromTPMPublic(ESYS_CONTEXT *esys_context,
 
     /* Restore the timeout value to the original value */
     esys_context->timeout = timeouttmp;
+    iesys_thread_leave(esys_context);
     return_if_error(r, "Error TR FromTPMPublic");
 
     return r;
 }
 
-/** Close an ESYS_TR without removing it from the TPM.
- *
- * This function deletes an ESYS_TR object from an ESYS_CONTEXT without deleting
- * it from the TPM. This is useful for NV-Indices or persistent keys, after
- * Esys_TR_Serialize has been called. Transient objects should be deleted using
- * Esys_FlushContext.
- * @param esys_context [in,out] The ESYS_CONTEXT
- * @param object [out] ESYS_TR metadata object to be deleted from ESYS_CONTEXT.
- * @retval TSS2_RC_SUCCESS on Success.
- * @retval TSS2_ESYS_RC_BAD_REFERENCE if the esysContext is NULL.
- * @retval TSS2_ESYS_RC_BAD_TR if the ESYS_TR object is unknown to the
- *         ESYS_CONTEXT.
- */
-TSS2_RC
-Esys_TR_Close(ESYS_CONTEXT *esys_context, ESYS_TR *object) {
+static TSS2_RC
+tr_close(ESYS_CONTEXT *esys_context, ESYS_TR *object) {
     RSRC_NODE_T  *node;
     RSRC_NODE_T **update_ptr;
 
-    ESYS_ASSERT_NON_NULL(esys_context);
     for (node = esys_context->rsrc_list, update_ptr = &esys_context->rsrc_list; node != NULL;
          update_ptr = &node->next, node = node->next) {
         if (node->esys_handle == *object) {
@@ -431,7 +498,7 @@ Esys_TR_Close(ESYS_CONTEXT *esys_context, ESYS_TR *object) {
                 return TSS2_RC_SUCCESS;
             }
             *update_ptr = node->next;
-            free(node);
+            iesys_DeleteResourceObject(esys_context, node);
             *object = ESYS_TR_NONE;
             return TSS2_RC_SUCCESS;
         }
@@ -440,30 +507,36 @@ Esys_TR_Close(ESYS_CONTEXT *esys_context, ESYS_TR *object) {
     return TSS2_ESYS_RC_BAD_TR;
 }
 
-/** Set the authorization value of an ESYS_TR.
- *
- * Authorization values are associated with ESYS_TR Tpm Resource object. They
- * are then picked up whenever an authorization is needed.
+/** Close an ESYS_TR without removing it from the TPM.
  *
- * Note: The authorization value is not stored in the metadata during
- * Esys_TR_Serialize. Therefor Esys_TR_SetAuth needs to be called again after
- * every Esys_TR_Deserialize.
- * @param esys_context [in,out] The ESYS_CONTEXT.
- * @param esys_handle [in,out] The ESYS_TR for which to set the auth value.
- * @param authValue [in] The auth value to set for the ESYS_TR or NULL to zero
- *        the auth.
+ * This function deletes an ESYS_TR object from an ESYS_CONTEXT without deleting
+ * it from the TPM. This is useful for NV-Indices or persistent keys, after
+ * Esys_TR_Serialize has been called. Transient objects should be deleted using
+ * Esys_FlushContext.
+ * @param esys_context [in,out] The ESYS_CONTEXT
+ * @param object [out] ESYS_TR metadata object to be deleted from ESYS_CONTEXT.
  * @retval TSS2_RC_SUCCESS on Success.
  * @retval TSS2_ESYS_RC_BAD_REFERENCE if the esysContext is NULL.
  * @retval TSS2_ESYS_RC_BAD_TR if the ESYS_TR object is unknown to the
- *         ESYS_CONTEXT or it equals ESYS_TR_NONE.
+ *         ESYS_CONTEXT.
  */
 TSS2_RC
-Esys_TR_SetAuth(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_AUTH const *authValue) {
+Esys_TR_Close(ESYS_CONTEXT *esys_context, ESYS_TR *object) {
+    TSS2_RC r;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    iesys_thread_enter(esys_context);
+    r = tr_close(esys_context, object);
+    iesys_thread_leave(esys_context);
+    return r;
+}
+
+static TSS2_RC
+tr_set_auth(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_AUTH const *authValue) {
     RSRC_NODE_T  *esys_object;
     TSS2_RC       r;
     TPMI_ALG_HASH name_alg = TPM2_ALG_NULL;
 
-    ESYS_ASSERT_NON_NULL(esys_context);
     if (esys_handle == ESYS_TR_NONE) {
         return_error(TSS2_ESYS_RC_BAD_TR, "esys_handle can't be ESYS_TR_NONE.");
     }
@@ -480,9 +553,12 @@ Esys_TR_SetAuth(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_AUTH cons
         }
         /* Determine name alg of resource */
         if (esys_object->rsrc.rsrcType == IESYSC_KEY_RSRC) {
-            name_alg = esys_object->rsrc.misc.rsrc_key_pub.publicArea.nameAlg;
+            TPM2B_PUBLIC public;
+            r = iesys_rsrc_key_public(esys_object, &public);
+            return_if_error(r, "Get public area.");
+            name_alg = public.publicArea.nameAlg;
         } else if (esys_object->rsrc.rsrcType == IESYSC_NV_RSRC) {
-            name_alg = esys_object->rsrc.misc.rsrc_nv_pub.nvPublic.nameAlg;
+            name_alg = esys_object->rsrc.misc.rsrc_nv_pub.entry->nvPublic.nameAlg;
         } else {
             name_alg = TPM2_ALG_NULL;
         }
@@ -499,25 +575,38 @@ Esys_TR_SetAuth(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_AUTH cons
     return TSS2_RC_SUCCESS;
 }
 
-/** Retrieve the TPM public name of an Esys_TR object.
+/** Set the authorization value of an ESYS_TR.
  *
- * Some operations (i.e. Esys_PolicyNameHash) require the name of a TPM object
- * to be passed. Esys_TR_GetName provides this name to the caller.
+ * Authorization values are associated with ESYS_TR Tpm Resource object. They
+ * are then picked up whenever an authorization is needed.
+ *
+ * Note: The authorization value is not stored in the metadata during
+ * Esys_TR_Serialize. Therefor Esys_TR_SetAuth needs to be called again after
+ * every Esys_TR_Deserialize.
  * @param esys_context [in,out] The ESYS_CONTEXT.
- * @param esys_handle [in,out] The ESYS_TR for which to retrieve the name.
- * @param name [out] The name of the object (caller-allocated; use free()).
+ * @param esys_handle [in,out] The ESYS_TR for which to set the auth value.
+ * @param authValue [in] The auth value to set for the ESYS_TR or NULL to zero
+ *        the auth.
  * @retval TSS2_RC_SUCCESS on Success.
- * @retval TSS2_ESYS_RC_MEMORY if needed memory can't be allocated.
- * @retval TSS2_ESYS_RC_GENERAL_FAILURE for errors of the crypto library.
  * @retval TSS2_ESYS_RC_BAD_REFERENCE if the esysContext is NULL.
- * @retval TSS2_ESYS_RC_BAD_TR if the handle is invalid.
- * @retval TSS2_SYS_RC_* for SAPI errors.
+ * @retval TSS2_ESYS_RC_BAD_TR if the ESYS_TR object is unknown to the
+ *         ESYS_CONTEXT or it equals ESYS_TR_NONE.
  */
 TSS2_RC
-Esys_TR_GetName(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_NAME **name) {
+Esys_TR_SetAuth(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_AUTH const *authValue) {
+    TSS2_RC r;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    iesys_thread_enter(esys_context);
+    r = tr_set_auth(esys_context, esys_handle, authValue);
+    iesys_thread_leave(esys_context);
+    return r;
+}
+
+static TSS2_RC
+tr_get_name(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_NAME **name) {
     RSRC_NODE_T *esys_object;
     TSS2_RC      r;
-    ESYS_ASSERT_NON_NULL(esys_context);
 
     if (esys_handle == ESYS_TR_NONE) {
         return_error(TSS2_ESYS_RC_BAD_TR, "Name for ESYS_TR_NONE can't be determined.");
@@ -533,14 +622,17 @@ Esys_TR_GetName(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_NAME **na
         return TSS2_ESYS_RC_MEMORY;
     }
     if (esys_object->rsrc.rsrcType == IESYSC_KEY_RSRC) {
-        r = iesys_get_name(&esys_context->crypto_backend, &esys_object->rsrc.misc.rsrc_key_pub,
-                           *name);
+        TPM2B_PUBLIC public;
+        r = iesys_rsrc_key_public(esys_object, &public);
+        goto_if_error(r, "Error get public area", error_cleanup);
+        r = iesys_get_name(&esys_context->crypto_backend, &public, *name);
         goto_if_error(r, "Error get name", error_cleanup);
 
     } else {
         if (esys_object->rsrc.rsrcType == IESYSC_NV_RSRC) {
-            r = iesys_nv_get_name(&esys_context->crypto_backend,
-                                  &esys_object->rsrc.misc.rsrc_nv_pub, *name);
+            TPM2B_NV_PUBLIC nvPublic;
+            iesys_rsrc_nv_public(esys_object, &nvPublic);
+            r = iesys_nv_get_name(&esys_context->crypto_backend, &nvPublic, *name);
             goto_if_error(r, "Error get name", error_cleanup);
 
         } else {
@@ -557,6 +649,45 @@ error_cleanup:
     return r;
 }
 
+/** Retrieve the TPM public name of an Esys_TR object.
+ *
+ * Some operations (i.e. Esys_PolicyNameHash) require the name of a TPM object
+ * to be passed. Esys_TR_GetName provides this name to the caller.
+ * @param esys_context [in,out] The ESYS_CONTEXT.
+ * @param esys_handle [in,out] The ESYS_TR for which to retrieve the name.
+ * @param name [out] The name of the object (caller-allocated; use free()).
+ * @retval TSS2_RC_SUCCESS on Success.
+ * @retval TSS2_ESYS_RC_MEMORY if needed memory can't be allocated.
+ * @retval TSS2_ESYS_RC_GENERAL_FAILURE for errors of the crypto library.
+ * @retval TSS2_ESYS_RC_BAD_REFERENCE if the esysContext is NULL.
+ * @retval TSS2_ESYS_RC_BAD_TR if the handle is invalid.
+ * @retval TSS2_SYS_RC_* for SAPI errors.
+ */
+TSS2_RC
+Esys_TR_GetName(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_NAME **name) {
+    TSS2_RC r;
+
+    ESYS_ASSERT_NON_NULL(esys_context);
+    iesys_thread_read_lock(esys_context, esys_handle);
+    r = tr_get_name(esys_context, esys_handle, name);
+    iesys_thread_read_unlock(esys_context, esys_handle);
+    return r;
+}
+
+static TSS2_RC
+trsess_get_attributes(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPMA_SESSION *flags) {
+    RSRC_NODE_T *esys_object;
+
+    TSS2_RC r = esys_GetResourceObject(esys_context, esys_handle, &esys_object);
+    return_if_error(r, "Object not found");
+    return_if_null(esys_object, "Esys object not found", TSS2_ESYS_RC_BAD_VALUE);
+
+    if (esys_object->rsrc.rsrcType != IESYSC_SESSION_RSRC)
+        return_error(TSS2_ESYS_RC_BAD_TR, "Object is not a session object");
+    *flags = esys_object->rsrc.misc.rsrc_session->sessionAttributes;
+    return TSS2_RC_SUCCESS;
+}
+
 /** Retrieve the Session Attributes of the ESYS_TR session.
  *
  * Sessions possess attributes, such as whether they shall continue of be
@@ -572,16 +703,33 @@ error_cleanup:
  */
 TSS2_RC
 Esys_TRSess_GetAttributes(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPMA_SESSION *flags) {
-    RSRC_NODE_T *esys_object;
+    TSS2_RC r;
 
     ESYS_ASSERT_NON_NULL(esys_context);
+    iesys_thread_read_lock(esys_context, esys_handle);
+    r = trsess_get_attributes(esys_context, esys_handle, flags);
+    iesys_thread_read_unlock(esys_context, esys_handle);
+    return r;
+}
+
+static TSS2_RC
+trsess_set_attributes(ESYS_CONTEXT *esys_context,
+                      ESYS_TR       esys_handle,
+                      TPMA_SESSION  flags,
+                      TPMA_SESSION  mask) {
+    RSRC_NODE_T *esys_object;
+
     TSS2_RC r = esys_GetResourceObject(esys_context, esys_handle, &esys_object);
     return_if_error(r, "Object not found");
-    return_if_null(esys_object, "Esys object not found", TSS2_ESYS_RC_BAD_VALUE);
+
+    return_if_null(esys_object, "Object not found", TSS2_ESYS_RC_BAD_VALUE);
 
     if (esys_object->rsrc.rsrcType != IESYSC_SESSION_RSRC)
         return_error(TSS2_ESYS_RC_BAD_TR, "Object is not a session object");
-    *flags = esys_object->rsrc.misc.rsrc_session.sessionAttributes;
+    esys_object->rsrc.misc.rsrc_session->sessionAttributes
+        = (esys_object->rsrc.misc.rsrc_session->sessionAttributes & ~mask) | (flags & mask);
+    if (esys_object->rsrc.misc.rsrc_session->sessionAttributes & TPMA_SESSION_AUDIT)
+        esys_object->rsrc.misc.rsrc_session->bound_entity.size = 0;
     return TSS2_RC_SUCCESS;
 }
 
@@ -604,21 +752,40 @@ Esys_TRSess_SetAttributes(ESYS_CONTEXT *esys_context,
                           ESYS_TR       esys_handle,
                           TPMA_SESSION  flags,
                           TPMA_SESSION  mask) {
-    RSRC_NODE_T *esys_object;
+    TSS2_RC r;
 
     ESYS_ASSERT_NON_NULL(esys_context);
-    TSS2_RC r = esys_GetResourceObject(esys_context, esys_handle, &esys_object);
-    return_if_error(r, "Object not found");
+    iesys_thread_enter(esys_context);
+    r = trsess_set_attributes(esys_context, esys_handle, flags, mask);
+    iesys_thread_leave(esys_context);
+    return r;
+}
+
+static TSS2_RC
+trsess_get_nonce_tpm(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_NONCE **nonceTPM) {
+    RSRC_NODE_T *esys_object;
+    TSS2_RC      r;
+    ESYS_ASSERT_NON_NULL(nonceTPM);
 
+    r = esys_GetResourceObject(esys_context, esys_handle, &esys_object);
+    return_if_error(r, "Object not found");
     return_if_null(esys_object, "Object not found", TSS2_ESYS_RC_BAD_VALUE);
 
-    if (esys_object->rsrc.rsrcType != IESYSC_SESSION_RSRC)
-        return_error(TSS2_ESYS_RC_BAD_TR, "Object is not a session object");
-    esys_object->rsrc.misc.rsrc_session.sessionAttributes
-        = (esys_object->rsrc.misc.rsrc_session.sessionAttributes & ~mask) | (flags & mask);
-    if (esys_object->rsrc.misc.rsrc_session.sessionAttributes & TPMA_SESSION_AUDIT)
-        esys_object->rsrc.misc.rsrc_session.bound_entity.size = 0;
-    return TSS2_RC_SUCCESS;
+    *nonceTPM = calloc(1, sizeof(**nonceTPM));
+    if (*nonceTPM == NULL) {
+        LOG_ERROR("Error: out of memory");
+        return TSS2_ESYS_RC_MEMORY;
+    }
+    if (esys_object->rsrc.rsrcType != IESYSC_SESSION_RSRC) {
+        goto_error(r, TSS2_ESYS_RC_BAD_TR, "NonceTPM for non-session object requested.",
+                   error_cleanup);
+    }
+    **nonceTPM = esys_object->rsrc.misc.rsrc_session->nonceTPM;
+
+    return r;
+error_cleanup:
+    SAFE_FREE(*nonceTPM);
+    return r;
 }
 
 /** Retrieve the TPM nonce of an Esys_TR session object.
@@ -637,30 +804,33 @@ Esys_TRSess_SetAttributes(ESYS_CONTEXT *esys_context,
  */
 TSS2_RC
 Esys_TRSess_GetNonceTPM(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2B_NONCE **nonceTPM) {
-    RSRC_NODE_T *esys_object;
-    TSS2_RC      r;
+    TSS2_RC r;
+
     ESYS_ASSERT_NON_NULL(esys_context);
-    ESYS_ASSERT_NON_NULL(nonceTPM);
+    iesys_thread_read_lock(esys_context, esys_handle);
+    r = trsess_get_nonce_tpm(esys_context, esys_handle, nonceTPM);
+    iesys_thread_read_unlock(esys_context, esys_handle);
+    return r;
+}
 
-    r = esys_GetResourceObject(esys_context, esys_handle, &esys_object);
-    return_if_error(r, "Object not found");
-    return_if_null(esys_object, "Object not found", TSS2_ESYS_RC_BAD_VALUE);
+static TSS2_RC
+tr_get_tpm_handle(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2_HANDLE *tpm_handle) {
+    TSS2_RC      r = TSS2_RC_SUCCESS;
+    RSRC_NODE_T *esys_object;
 
-    *nonceTPM = calloc(1, sizeof(**nonceTPM));
-    if (*nonceTPM == NULL) {
-        LOG_ERROR("Error: out of memory");
-        return TSS2_ESYS_RC_MEMORY;
-    }
-    if (esys_object->rsrc.rsrcType != IESYSC_SESSION_RSRC) {
-        goto_error(r, TSS2_ESYS_RC_BAD_TR, "NonceTPM for non-session object requested.",
-                   error_cleanup);
+    ESYS_ASSERT_NON_NULL(tpm_handle);
+
+    if (esys_handle == ESYS_TR_NONE) {
+        return TSS2_ESYS_RC_BAD_TR;
     }
-    **nonceTPM = esys_object->rsrc.misc.rsrc_session.nonceTPM;
 
-    return r;
-error_cleanup:
-    SAFE_FREE(*nonceTPM);
-    return r;
+    r = esys_GetResourceObject(esys_context, esys_handle, &esys_object);
+    return_if_error(r, "Get resource object");
+    return_if_null(esys_object, "Esys object not found", TSS2_ESYS_RC_BAD_VALUE);
+
+    *tpm_handle = esys_object->rsrc.handle;
+
+    return TSS2_RC_SUCCESS;
 }
 
 /** Retrieves the associated TPM2_HANDLE from an ESYS_TR object.
@@ -682,24 +852,37 @@ error_cleanup:
  */
 TSS2_RC
 Esys_TR_GetTpmHandle(ESYS_CONTEXT *esys_context, ESYS_TR esys_handle, TPM2_HANDLE *tpm_handle) {
-    TSS2_RC      r = TSS2_RC_SUCCESS;
-    RSRC_NODE_T *esys_object;
+    TSS2_RC r;
 
     ESYS_ASSERT_NON_NULL(esys_context);
-    ESYS_ASSERT_NON_NULL(tpm_handle);
+    iesys_thread_read_lock(esys_context, esys_handle);
+    r = tr_get_tpm_handle(esys_context, esys_handle, tpm_handle);
+    iesys_thread_read_unlock(esys_context, esys_handle);
+    return r;
+}
 
-    if (esys_handle == ESYS_TR_NONE) {
-        return TSS2_ESYS_RC_BAD_TR;
-    }
+static TSS2_RC
+trsess_get_auth_required(ESYS_CONTEXT *esys_context,
+                         ESYS_TR       esys_handle,
+                         TPMI_YES_NO  *auth_needed) {
+    RSRC_NODE_T *esys_object;
+    TSS2_RC      r;
 
     r = esys_GetResourceObject(esys_context, esys_handle, &esys_object);
-    return_if_error(r, "Get resource object");
+    return_if_error(r, "Object not found");
     return_if_null(esys_object, "Esys object not found", TSS2_ESYS_RC_BAD_VALUE);
 
-    *tpm_handle = esys_object->rsrc.handle;
+    if (esys_object->rsrc.rsrcType != IESYSC_SESSION_RSRC) {
+        return_if_error(TSS2_ESYS_RC_BAD_TR, "Auth value needed for non-session object requested.");
+    }
 
+    if (esys_object->rsrc.misc.rsrc_session->type_policy_session == POLICY_AUTH
+        || esys_object->rsrc.misc.rsrc_session->type_policy_session == POLICY_PASSWORD)
+        *auth_needed = TPM2_YES;
+    else
+        *auth_needed = TPM2_NO;
     return TSS2_RC_SUCCESS;
-};
+}
 
 /** Retrieve whether auth value is required from a Esys_TR session object.
  *
@@ -718,22 +901,11 @@ TSS2_RC
 Esys_TRSess_GetAuthRequired(ESYS_CONTEXT *esys_context,
                             ESYS_TR       esys_handle,
                             TPMI_YES_NO  *auth_needed) {
-    RSRC_NODE_T *esys_object;
-    TSS2_RC      r;
-    ESYS_ASSERT_NON_NULL(esys_context);
-
-    r = esys_GetResourceObject(esys_context, esys_handle, &esys_object);
-    return_if_error(r, "Object not found");
-    return_if_null(esys_object, "Esys object not found", TSS2_ESYS_RC_BAD_VALUE);
-
-    if (esys_object->rsrc.rsrcType != IESYSC_SESSION_RSRC) {
-        return_if_error(TSS2_ESYS_RC_BAD_TR, "Auth value needed for non-session object requested.");
-    }
+    TSS2_RC r;
 
-    if (esys_object->rsrc.misc.rsrc_session.type_policy_session == POLICY_AUTH
-        || esys_object->rsrc.misc.rsrc_session.type_policy_session == POLICY_PASSWORD)
-        *auth_needed = TPM2_YES;
-    else
-        *auth_needed = TPM2_NO;
-    return TSS2_RC_SUCCESS;
+    ESYS_ASSERT_NON_NULL(esys_context);
+    iesys_thread_read_lock(esys_context, esys_handle);
+    r = trsess_get_auth_required(esys_context, esys_handle, auth_needed);
+    iesys_thread_read_unlock(esys_context, esys_handle);
+    return r;
 }
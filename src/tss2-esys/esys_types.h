@@ -46,6 +46,52 @@ typedef UINT32 IESYSC_TYPE_POLICY_AUTH;
 #define POLICY_AUTH     1 /**< Marker to include the auth value in the HMAC key */
 #define NO_POLICY_AUTH  0 /**< no special handling */
 
+/** Keyed HMAC state cached for a session key
+ *
+ * Never serialized. The context is duplicated for every HMAC computed with
+ * the key and released once the key changed.
+ */
+typedef struct {
+    struct ESYS_CRYPTO_CONTEXT_BLOB *context; /**< Keyed HMAC context of the crypto backend */
+    TPMI_ALG_HASH                    hashAlg; /**< Hash algorithm of context */
+    UINT16                           size;    /**< Key size of context */
+} IESYS_HMAC_KEY_CACHE;
+
+/** Number of random bytes drawn from the crypto backend at once */
+#define IESYS_RANDOM_POOL_SIZE 1024
+
+/** Random bytes drawn in advance for caller nonces and salts
+ *
+ * Never serialized. The bytes are handed out from the end of buffer and wiped
+ * afterwards.
+ */
+typedef struct {
+    long   pid;                            /**< Process the bytes were drawn in */
+    UINT16 available;                      /**< Number of unused bytes in buffer */
+    BYTE   buffer[IESYS_RANDOM_POOL_SIZE]; /**< Random bytes */
+} IESYS_RANDOM_POOL;
+
+/** Public key of a TPM key converted by the crypto backend */
+typedef struct IESYS_CRYPTO_PKEY_BLOB IESYS_CRYPTO_PKEY_BLOB;
+
+/** Number of converted tpmKey public keys kept per ESYS context */
+#define IESYS_PKEY_CACHE_SIZE 4
+
+/** Converted public keys of the tpmKeys of salted sessions
+ *
+ * Never serialized. The entries are identified by the name of the key, which
+ * covers its public area. The least recently used entry is replaced if all
+ * entries are in use.
+ */
+typedef struct {
+    struct {
+        TPM2B_NAME              name;    /**< Name of the key */
+        IESYS_CRYPTO_PKEY_BLOB *pkey;    /**< Converted public key, NULL if unused */
+        UINT32                  lastUse; /**< Value of clock at the last lookup */
+    } entry[IESYS_PKEY_CACHE_SIZE];
+    UINT32 clock; /**< Number of lookups */
+} IESYS_PKEY_CACHE;
+
 /** Type for representing TPM-Session
  */
 typedef struct {
@@ -67,6 +113,8 @@ typedef struct {
     UINT16                  sizeSessionValue; /**< Size of sessionKey plus optionally authValue */
     BYTE                    sessionValue[2 * sizeof(TPMU_HA)]; /**< sessionKey || AuthValue */
     UINT16                  sizeHmacValue; /**< Size of sessionKey plus optionally authValue */
+    IESYS_HMAC_KEY_CACHE    hmacKeyCache;  /**< Keyed HMAC of the sizeHmacValue key */
+    IESYS_HMAC_KEY_CACHE    kdfKeyCache;   /**< Keyed HMAC of the sizeSessionValue key */
 } IESYS_SESSION;
 
 /** Selector type for esys resources
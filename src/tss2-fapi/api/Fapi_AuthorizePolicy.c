@@ -31,6 +31,12 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, goto_if_error
 
+static TSS2_RC fapi_authorize_policy(FAPI_CONTEXT  *context,
+                                     char const    *policyPath,
+                                     char const    *keyPath,
+                                     uint8_t const *policyRef,
+                                     size_t         policyRefSize);
+
 /** One-Call function for Fapi_AuthorizePolicy
  *
  * If a current policy happens to be a PolicyAuthorize, then for it to be used,
@@ -80,6 +86,20 @@ Fapi_AuthorizePolicy(FAPI_CONTEXT  *context,
                      char const    *keyPath,
                      uint8_t const *policyRef,
                      size_t         policyRefSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_authorize_policy(context, policyPath, keyPath, policyRef, policyRefSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_authorize_policy(FAPI_CONTEXT  *context,
+                      char const    *policyPath,
+                      char const    *keyPath,
+                      uint8_t const *policyRef,
+                      size_t         policyRefSize) {
     TSS2_RC r, r2;
 
     LOG_TRACE("called for context:%p", context);
@@ -126,6 +146,12 @@ Fapi_AuthorizePolicy(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_authorize_policy_async(FAPI_CONTEXT  *context,
+                                           char const    *policyPath,
+                                           char const    *keyPath,
+                                           uint8_t const *policyRef,
+                                           size_t         policyRefSize);
+
 /** Asynchronous function for Fapi_AuthorizePolicy
  *
  * If a current policy happens to be a PolicyAuthorize, then for it to be used,
@@ -164,6 +190,20 @@ Fapi_AuthorizePolicy_Async(FAPI_CONTEXT  *context,
                            char const    *keyPath,
                            uint8_t const *policyRef,
                            size_t         policyRefSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_authorize_policy_async(context, policyPath, keyPath, policyRef, policyRefSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_authorize_policy_async(FAPI_CONTEXT  *context,
+                            char const    *policyPath,
+                            char const    *keyPath,
+                            uint8_t const *policyRef,
+                            size_t         policyRefSize) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("policyPath: %s", policyPath);
     LOG_TRACE("keyPath: %s", keyPath);
@@ -219,6 +259,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_authorize_policy_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_AuthorizePolicy
  *
  * This function should be called after a previous Fapi_AuthorizePolicy_Async.
@@ -253,6 +295,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_AuthorizePolicy_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_authorize_policy_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_authorize_policy_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC                    r;
@@ -29,6 +29,10 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for goto_if_error, LOG_TRACE, SAFE_FREE
 
+static TSS2_RC fapi_change_auth(FAPI_CONTEXT *context,
+                                char const   *entityPath,
+                                char const   *authValue);
+
 /** One-Call function for Fapi_ChangeAuth
  *
  * Changes the Authorization data of an entity found at keyPath. The parameter
@@ -70,6 +74,16 @@
  */
 TSS2_RC
 Fapi_ChangeAuth(FAPI_CONTEXT *context, char const *entityPath, char const *authValue) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_change_auth(context, entityPath, authValue);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_change_auth(FAPI_CONTEXT *context, char const *entityPath, char const *authValue) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -116,6 +130,10 @@ Fapi_ChangeAuth(FAPI_CONTEXT *context, char const *entityPath, char const *authV
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_change_auth_async(FAPI_CONTEXT *context,
+                                      char const   *entityPath,
+                                      char const   *authValue);
+
 /** Asynchronous function for Fapi_ChangeAuth
  *
  * Changes the Authorization data of an entity found at keyPath. The parameter
@@ -150,6 +168,16 @@ Fapi_ChangeAuth(FAPI_CONTEXT *context, char const *entityPath, char const *authV
  */
 TSS2_RC
 Fapi_ChangeAuth_Async(FAPI_CONTEXT *context, char const *entityPath, char const *authValue) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_change_auth_async(context, entityPath, authValue);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_change_auth_async(FAPI_CONTEXT *context, char const *entityPath, char const *authValue) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("entityPath: %s", entityPath);
     LOG_TRACE("authValue: %s", authValue);
@@ -219,6 +247,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_change_auth_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_ChangeAuth
  *
  * This function should be called after a previous Fapi_ChangeAuth_Async.
@@ -253,6 +283,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_ChangeAuth_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_change_auth_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_change_auth_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
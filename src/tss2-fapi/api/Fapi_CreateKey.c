@@ -26,6 +26,12 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, goto_if_error, return_if_error
 
+static TSS2_RC fapi_create_key(FAPI_CONTEXT *context,
+                               char const   *path,
+                               char const   *type,
+                               char const   *policyPath,
+                               char const   *authValue);
+
 /** One-Call function for Fapi_CreateKey
  *
  * Creates a key inside the TPM based on the Key type, using the supplied
@@ -74,6 +80,20 @@ Fapi_CreateKey(FAPI_CONTEXT *context,
                char const   *type,
                char const   *policyPath,
                char const   *authValue) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_create_key(context, path, type, policyPath, authValue);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_create_key(FAPI_CONTEXT *context,
+                char const   *path,
+                char const   *type,
+                char const   *policyPath,
+                char const   *authValue) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -119,6 +139,12 @@ Fapi_CreateKey(FAPI_CONTEXT *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_create_key_async(FAPI_CONTEXT *context,
+                                     char const   *path,
+                                     char const   *type,
+                                     char const   *policyPath,
+                                     char const   *authValue);
+
 /** Asynchronous function for Fapi_CreateKey
  *
  * Creates a key inside the TPM based on the Key type, using the supplied
@@ -159,6 +185,20 @@ Fapi_CreateKey_Async(FAPI_CONTEXT *context,
                      char const   *type,
                      char const   *policyPath,
                      char const   *authValue) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_create_key_async(context, path, type, policyPath, authValue);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_create_key_async(FAPI_CONTEXT *context,
+                      char const   *path,
+                      char const   *type,
+                      char const   *policyPath,
+                      char const   *authValue) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
     LOG_TRACE("type: %s", type);
@@ -228,6 +268,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_create_key_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_CreateKey
  *
  * This function should be called after a previous Fapi_CreateKey_Async.
@@ -263,6 +305,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_CreateKey_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_create_key_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_create_key_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
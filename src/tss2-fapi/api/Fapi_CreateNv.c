@@ -32,6 +32,13 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, goto_if_error
 
+static TSS2_RC fapi_create_nv(FAPI_CONTEXT *context,
+                              char const   *path,
+                              char const   *type,
+                              size_t        size,
+                              char const   *policyPath,
+                              char const   *authValue);
+
 /** One-Call function for Fapi_CreateNv
  *
  * This command creates an NV index in the TPM using a given path and type.
@@ -84,6 +91,21 @@ Fapi_CreateNv(FAPI_CONTEXT *context,
               size_t        size,
               char const   *policyPath,
               char const   *authValue) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_create_nv(context, path, type, size, policyPath, authValue);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_create_nv(FAPI_CONTEXT *context,
+               char const   *path,
+               char const   *type,
+               size_t        size,
+               char const   *policyPath,
+               char const   *authValue) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -129,6 +151,13 @@ Fapi_CreateNv(FAPI_CONTEXT *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_create_nv_async(FAPI_CONTEXT *context,
+                                    char const   *path,
+                                    char const   *type,
+                                    size_t        size,
+                                    char const   *policyPath,
+                                    char const   *authValue);
+
 /** Asynchronous function for Fapi_CreateNv
  *
  * This command creates an NV index in the TPM using a given path and type.
@@ -171,6 +200,21 @@ Fapi_CreateNv_Async(FAPI_CONTEXT *context,
                     size_t        size,
                     char const   *policyPath,
                     char const   *authValue) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_create_nv_async(context, path, type, size, policyPath, authValue);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_create_nv_async(FAPI_CONTEXT *context,
+                     char const   *path,
+                     char const   *type,
+                     size_t        size,
+                     char const   *policyPath,
+                     char const   *authValue) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
     LOG_TRACE("type: %s", type);
@@ -241,6 +285,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_create_nv_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_CreateNv
  *
  * This function should be called after a previous Fapi_CreateNv_Async.
@@ -277,6 +323,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_CreateNv_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_create_nv_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_create_nv_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
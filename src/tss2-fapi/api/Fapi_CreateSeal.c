@@ -28,6 +28,14 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, return_if_error, base_rc
 
+static TSS2_RC fapi_create_seal(FAPI_CONTEXT  *context,
+                                char const    *path,
+                                char const    *type,
+                                size_t         size,
+                                char const    *policyPath,
+                                char const    *authValue,
+                                uint8_t const *data);
+
 /** One-Call function for Fapi_CreateSeal
  *
  * Creates a sealed object and stores it in the FAPI metadata store. If no data
@@ -82,6 +90,22 @@ Fapi_CreateSeal(FAPI_CONTEXT  *context,
                 char const    *policyPath,
                 char const    *authValue,
                 uint8_t const *data) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_create_seal(context, path, type, size, policyPath, authValue, data);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_create_seal(FAPI_CONTEXT  *context,
+                 char const    *path,
+                 char const    *type,
+                 size_t         size,
+                 char const    *policyPath,
+                 char const    *authValue,
+                 uint8_t const *data) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -128,6 +152,14 @@ Fapi_CreateSeal(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_create_seal_async(FAPI_CONTEXT  *context,
+                                      char const    *path,
+                                      char const    *type,
+                                      size_t         size,
+                                      char const    *policyPath,
+                                      char const    *authValue,
+                                      uint8_t const *data);
+
 /** Asynchronous function for Fapi_CreateSeal
  *
  * Creates a sealed object and stores it in the FAPI metadata store. If no data
@@ -174,6 +206,22 @@ Fapi_CreateSeal_Async(FAPI_CONTEXT  *context,
                       char const    *policyPath,
                       char const    *authValue,
                       uint8_t const *data) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_create_seal_async(context, path, type, size, policyPath, authValue, data);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_create_seal_async(FAPI_CONTEXT  *context,
+                       char const    *path,
+                       char const    *type,
+                       size_t         size,
+                       char const    *policyPath,
+                       char const    *authValue,
+                       uint8_t const *data) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
     LOG_TRACE("type: %s", type);
@@ -216,6 +264,8 @@ Fapi_CreateSeal_Async(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_create_seal_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_CreateSeal
  *
  * This function should be called after a previous Fapi_CreateSeal.
@@ -251,6 +301,16 @@ Fapi_CreateSeal_Async(FAPI_CONTEXT  *context,
  */
 TSS2_RC
 Fapi_CreateSeal_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_create_seal_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_create_seal_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
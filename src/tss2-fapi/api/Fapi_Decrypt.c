@@ -27,6 +27,13 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for SAFE_FREE, LOG_TRACE, goto_if_error
 
+static TSS2_RC fapi_decrypt(FAPI_CONTEXT  *context,
+                            char const    *keyPath,
+                            uint8_t const *cipherText,
+                            size_t         cipherTextSize,
+                            uint8_t      **plainText,
+                            size_t        *plainTextSize);
+
 /** One-Call function for Fapi_Decrypt
  *
  * Decrypts data that was previously encrypted with Fapi_Encrypt.
@@ -79,6 +86,21 @@ Fapi_Decrypt(FAPI_CONTEXT  *context,
              size_t         cipherTextSize,
              uint8_t      **plainText,
              size_t        *plainTextSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_decrypt(context, keyPath, cipherText, cipherTextSize, plainText, plainTextSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_decrypt(FAPI_CONTEXT  *context,
+             char const    *keyPath,
+             uint8_t const *cipherText,
+             size_t         cipherTextSize,
+             uint8_t      **plainText,
+             size_t        *plainTextSize) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -127,6 +149,11 @@ Fapi_Decrypt(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_decrypt_async(FAPI_CONTEXT  *context,
+                                  char const    *keyPath,
+                                  uint8_t const *cipherText,
+                                  size_t         cipherTextSize);
+
 /** Asynchronous function for Fapi_Decrypt
  *
  * Decrypts data that was previously encrypted with Fapi_Encrypt.
@@ -162,6 +189,19 @@ Fapi_Decrypt_Async(FAPI_CONTEXT  *context,
                    char const    *keyPath,
                    uint8_t const *cipherText,
                    size_t         cipherTextSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_decrypt_async(context, keyPath, cipherText, cipherTextSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_decrypt_async(FAPI_CONTEXT  *context,
+                   char const    *keyPath,
+                   uint8_t const *cipherText,
+                   size_t         cipherTextSize) {
     LOG_TRACE("called for context:%p", context);
     LOGBLOB_TRACE(cipherText, cipherTextSize, "cipherText");
 
@@ -208,6 +248,10 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_decrypt_finish(FAPI_CONTEXT *context,
+                                   uint8_t     **plainText,
+                                   size_t       *plainTextSize);
+
 /** Asynchronous finish function for Fapi_Decrypt
  *
  * This function should be called after a previous Fapi_Decrypt.
@@ -246,6 +290,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_Decrypt_Finish(FAPI_CONTEXT *context, uint8_t **plainText, size_t *plainTextSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_decrypt_finish(context, plainText, plainTextSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_decrypt_finish(FAPI_CONTEXT *context, uint8_t **plainText, size_t *plainTextSize) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC               r;
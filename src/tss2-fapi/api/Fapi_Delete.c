@@ -237,6 +237,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_delete(FAPI_CONTEXT *context, char const *path);
+
 /** One-Call function for Fapi_Delete
  *
  * Deletes a given key, policy or NV index from the system.
@@ -275,6 +277,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_Delete(FAPI_CONTEXT *context, char const *path) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_delete(context, path);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_delete(FAPI_CONTEXT *context, char const *path) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -302,6 +314,8 @@ Fapi_Delete(FAPI_CONTEXT *context, char const *path) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_delete_async(FAPI_CONTEXT *context, char const *path);
+
 /** Asynchronous function for Fapi_Delete
  *
  * Deletes a given key, policy or NV index from the system.
@@ -335,6 +349,16 @@ Fapi_Delete(FAPI_CONTEXT *context, char const *path) {
  */
 TSS2_RC
 Fapi_Delete_Async(FAPI_CONTEXT *context, char const *path) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_delete_async(context, path);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_delete_async(FAPI_CONTEXT *context, char const *path) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
 
@@ -437,6 +461,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_delete_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_Delete
  *
  * This function should be called after a previous Fapi_Delete_Async.
@@ -471,6 +497,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_Delete_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_delete_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_delete_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -29,6 +29,16 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, goto_if_error
 
+static TSS2_RC fapi_digest_and_sign(FAPI_CONTEXT  *context,
+                                    char const    *keyPath,
+                                    char const    *padding,
+                                    uint8_t const *digest,
+                                    size_t         digestSize,
+                                    uint8_t      **signature,
+                                    size_t        *signatureSize,
+                                    char         **publicKey,
+                                    char         **certificate);
+
 /** One-Call function for Fapi_DigestAndSign
  *
  * Uses a key, identified by its path, to sign a digest and puts the result in a
@@ -87,6 +97,25 @@ Fapi_DigestAndSign(FAPI_CONTEXT  *context,
                    size_t        *signatureSize,
                    char         **publicKey,
                    char         **certificate) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_digest_and_sign(context, keyPath, padding, digest, digestSize, signature,
+                             signatureSize, publicKey, certificate);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_digest_and_sign(FAPI_CONTEXT  *context,
+                     char const    *keyPath,
+                     char const    *padding,
+                     uint8_t const *digest,
+                     size_t         digestSize,
+                     uint8_t      **signature,
+                     size_t        *signatureSize,
+                     char         **publicKey,
+                     char         **certificate) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -135,6 +164,12 @@ Fapi_DigestAndSign(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_digest_and_sign_async(FAPI_CONTEXT  *context,
+                                          char const    *keyPath,
+                                          char const    *padding,
+                                          uint8_t const *data,
+                                          size_t         dataSize);
+
 /** Asynchronous function for Fapi_DigestAndSign
  *
  * Uses a key, identified by its path, to sign a digest and puts the result in a
@@ -172,6 +207,20 @@ Fapi_DigestAndSign_Async(FAPI_CONTEXT  *context,
                          char const    *padding,
                          uint8_t const *data,
                          size_t         dataSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_digest_and_sign_async(context, keyPath, padding, data, dataSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_digest_and_sign_async(FAPI_CONTEXT  *context,
+                           char const    *keyPath,
+                           char const    *padding,
+                           uint8_t const *data,
+                           size_t         dataSize) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("keyPath: %s", keyPath);
     LOG_TRACE("padding: %s", padding);
@@ -228,6 +277,12 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_digest_and_sign_finish(FAPI_CONTEXT *context,
+                                           uint8_t     **signature,
+                                           size_t       *signatureSize,
+                                           char        **publicKey,
+                                           char        **certificate);
+
 /** Asynchronous finish function for Fapi_DigestAndSign
  *
  * This function should be called after a previous Fapi_DigestAndSign_Async.
@@ -272,6 +327,20 @@ Fapi_DigestAndSign_Finish(FAPI_CONTEXT *context,
                           size_t       *signatureSize,
                           char        **publicKey,
                           char        **certificate) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_digest_and_sign_finish(context, signature, signatureSize, publicKey, certificate);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_digest_and_sign_finish(FAPI_CONTEXT *context,
+                            uint8_t     **signature,
+                            size_t       *signatureSize,
+                            char        **publicKey,
+                            char        **certificate) {
     TPM2B_AUTH nullAuth = { .size = 0 };
 
     LOG_TRACE("called for context:%p", context);
@@ -30,6 +30,13 @@
 
 #define IV_SIZE 16
 
+static TSS2_RC fapi_encrypt(FAPI_CONTEXT  *context,
+                            char const    *keyPath,
+                            uint8_t const *plainText,
+                            size_t         plainTextSize,
+                            uint8_t      **cipherText,
+                            size_t        *cipherTextSize);
+
 /** One-Call function for Fapi_Encrypt
  *
  * Encrypt the provided data for the target key using the TPM encryption
@@ -84,6 +91,21 @@ Fapi_Encrypt(FAPI_CONTEXT  *context,
              size_t         plainTextSize,
              uint8_t      **cipherText,
              size_t        *cipherTextSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_encrypt(context, keyPath, plainText, plainTextSize, cipherText, cipherTextSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_encrypt(FAPI_CONTEXT  *context,
+             char const    *keyPath,
+             uint8_t const *plainText,
+             size_t         plainTextSize,
+             uint8_t      **cipherText,
+             size_t        *cipherTextSize) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -133,6 +155,11 @@ Fapi_Encrypt(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_encrypt_async(FAPI_CONTEXT  *context,
+                                  char const    *keyPath,
+                                  uint8_t const *plainText,
+                                  size_t         plainTextSize);
+
 /** Asynchronous function for Fapi_Encrypt
  *
  * Encrypt the provided data for the target key using the TPM encryption
@@ -169,6 +196,19 @@ Fapi_Encrypt_Async(FAPI_CONTEXT  *context,
                    char const    *keyPath,
                    uint8_t const *plainText,
                    size_t         plainTextSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_encrypt_async(context, keyPath, plainText, plainTextSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_encrypt_async(FAPI_CONTEXT  *context,
+                   char const    *keyPath,
+                   uint8_t const *plainText,
+                   size_t         plainTextSize) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("keyPath: %s", keyPath);
     if (plainText) {
@@ -222,6 +262,10 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_encrypt_finish(FAPI_CONTEXT *context,
+                                   uint8_t     **cipherText,
+                                   size_t       *cipherTextSize);
+
 /** Asynchronous finish function for Fapi_Encrypt
  *
  * This function should be called after a previous Fapi_Encrypt_Async.
@@ -259,6 +303,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_Encrypt_Finish(FAPI_CONTEXT *context, uint8_t **cipherText, size_t *cipherTextSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_encrypt_finish(context, cipherText, cipherTextSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_encrypt_finish(FAPI_CONTEXT *context, uint8_t **cipherText, size_t *cipherTextSize) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -29,6 +29,11 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for SAFE_FREE, LOG_TRACE, goto_if_error
 
+static TSS2_RC fapi_export_key(FAPI_CONTEXT *context,
+                               char const   *pathOfKeyToDuplicate,
+                               char const   *pathToPublicKeyOfNewParent,
+                               char        **exportedData);
+
 /** One-Call function for Fapi_ExportKey
  *
  * Given a key it will (if the key is a storage key) duplicate the key and
@@ -80,6 +85,19 @@ Fapi_ExportKey(FAPI_CONTEXT *context,
                char const   *pathOfKeyToDuplicate,
                char const   *pathToPublicKeyOfNewParent,
                char        **exportedData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_export_key(context, pathOfKeyToDuplicate, pathToPublicKeyOfNewParent, exportedData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_export_key(FAPI_CONTEXT *context,
+                char const   *pathOfKeyToDuplicate,
+                char const   *pathToPublicKeyOfNewParent,
+                char        **exportedData) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -127,6 +145,10 @@ Fapi_ExportKey(FAPI_CONTEXT *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_export_key_async(FAPI_CONTEXT *context,
+                                     char const   *pathOfKeyToDuplicate,
+                                     char const   *pathToPublicKeyOfNewParent);
+
 /** Asynchronous function for Fapi_ExportKey
  *
  * Given a key it will (if the key is a storage key) duplicate the key and
@@ -169,6 +191,18 @@ TSS2_RC
 Fapi_ExportKey_Async(FAPI_CONTEXT *context,
                      char const   *pathOfKeyToDuplicate,
                      char const   *pathToPublicKeyOfNewParent) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_export_key_async(context, pathOfKeyToDuplicate, pathToPublicKeyOfNewParent);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_export_key_async(FAPI_CONTEXT *context,
+                      char const   *pathOfKeyToDuplicate,
+                      char const   *pathToPublicKeyOfNewParent) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("pathOfKeyToDuplicate: %s", pathOfKeyToDuplicate);
     LOG_TRACE("pathToPublicKeyOfNewParent: %s", pathToPublicKeyOfNewParent);
@@ -221,6 +255,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_export_key_finish(FAPI_CONTEXT *context, char **exportedData);
+
 /** Asynchronous finish function for Fapi_ExportKey
  *
  * This function should be called after a previous Fapi_ExportKey_Async.
@@ -258,6 +294,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_ExportKey_Finish(FAPI_CONTEXT *context, char **exportedData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_export_key_finish(context, exportedData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_export_key_finish(FAPI_CONTEXT *context, char **exportedData) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC                 r;
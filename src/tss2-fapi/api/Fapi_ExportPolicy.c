@@ -34,6 +34,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, goto_...
 
+static TSS2_RC fapi_export_policy(FAPI_CONTEXT *context, char const *path, char **jsonPolicy);
+
 /** One-Call function for Fapi_ExportPolicy
  *
  * Exports a policy to a JSON encoded byte buffer.
@@ -66,6 +68,16 @@
  */
 TSS2_RC
 Fapi_ExportPolicy(FAPI_CONTEXT *context, char const *path, char **jsonPolicy) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_export_policy(context, path, jsonPolicy);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_export_policy(FAPI_CONTEXT *context, char const *path, char **jsonPolicy) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -112,6 +124,8 @@ Fapi_ExportPolicy(FAPI_CONTEXT *context, char const *path, char **jsonPolicy) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_export_policy_async(FAPI_CONTEXT *context, char const *path);
+
 /** Asynchronous function for Fapi_ExportPolicy
  *
  * Exports a policy to a JSON encoded byte buffer.
@@ -135,6 +149,16 @@ Fapi_ExportPolicy(FAPI_CONTEXT *context, char const *path, char **jsonPolicy) {
  */
 TSS2_RC
 Fapi_ExportPolicy_Async(FAPI_CONTEXT *context, char const *path) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_export_policy_async(context, path);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_export_policy_async(FAPI_CONTEXT *context, char const *path) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
 
@@ -175,6 +199,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_export_policy_finish(FAPI_CONTEXT *context, char **jsonPolicy);
+
 /** Asynchronous finish function for Fapi_ExportPolicy
  *
  * This function should be called after a previous Fapi_ExportPolicy_Async.
@@ -204,6 +230,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_ExportPolicy_Finish(FAPI_CONTEXT *context, char **jsonPolicy) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_export_policy_finish(context, jsonPolicy);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_export_policy_finish(FAPI_CONTEXT *context, char **jsonPolicy) {
     LOG_TRACE("called for context:%p", context);
 
     json_object *jso = NULL;
@@ -24,6 +24,11 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, return_if_error, base_rc, got...
 
+static TSS2_RC fapi_get_app_data(FAPI_CONTEXT *context,
+                                 char const   *path,
+                                 uint8_t     **appData,
+                                 size_t       *appDataSize);
+
 /** One-Call function for Fapi_GetAppData
  *
  * Every object has a description field that can be retrieved in order to obtain
@@ -57,6 +62,16 @@
  */
 TSS2_RC
 Fapi_GetAppData(FAPI_CONTEXT *context, char const *path, uint8_t **appData, size_t *appDataSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_app_data(context, path, appData, appDataSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_app_data(FAPI_CONTEXT *context, char const *path, uint8_t **appData, size_t *appDataSize) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -85,6 +100,8 @@ Fapi_GetAppData(FAPI_CONTEXT *context, char const *path, uint8_t **appData, size
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_app_data_async(FAPI_CONTEXT *context, char const *path);
+
 /** Asynchronous function for Fapi_GetAppData
  *
  * Every object has a description field that can be retrieved in order to obtain
@@ -115,6 +132,16 @@ Fapi_GetAppData(FAPI_CONTEXT *context, char const *path, uint8_t **appData, size
  */
 TSS2_RC
 Fapi_GetAppData_Async(FAPI_CONTEXT *context, char const *path) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_app_data_async(context, path);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_app_data_async(FAPI_CONTEXT *context, char const *path) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
 
@@ -140,6 +167,10 @@ Fapi_GetAppData_Async(FAPI_CONTEXT *context, char const *path) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_app_data_finish(FAPI_CONTEXT *context,
+                                        uint8_t     **appData,
+                                        size_t       *appDataSize);
+
 /** Asynchronous finish function for Fapi_GetAppData
  *
  * This function should be called after a previous Fapi_GetAppData_Async.
@@ -166,6 +197,16 @@ Fapi_GetAppData_Async(FAPI_CONTEXT *context, char const *path) {
  */
 TSS2_RC
 Fapi_GetAppData_Finish(FAPI_CONTEXT *context, uint8_t **appData, size_t *appDataSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_app_data_finish(context, appData, appDataSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_app_data_finish(FAPI_CONTEXT *context, uint8_t **appData, size_t *appDataSize) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC      r;
@@ -21,6 +21,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, return_if_error, base_rc, ret...
 
+static TSS2_RC fapi_get_certificate(FAPI_CONTEXT *context, char const *path, char **x509certData);
+
 /** One-Call function for Fapi_GetCertificate
  *
  * Gets an x.509 certificate for the key at a given path.
@@ -55,6 +57,16 @@
  */
 TSS2_RC
 Fapi_GetCertificate(FAPI_CONTEXT *context, char const *path, char **x509certData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_certificate(context, path, x509certData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_certificate(FAPI_CONTEXT *context, char const *path, char **x509certData) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -84,6 +96,8 @@ Fapi_GetCertificate(FAPI_CONTEXT *context, char const *path, char **x509certData
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_certificate_async(FAPI_CONTEXT *context, char const *path);
+
 /** Asynchronous function for Fapi_GetCertificate
  *
  * Gets an x.509 certificate for the key at a given path.
@@ -114,9 +128,17 @@ Fapi_GetCertificate(FAPI_CONTEXT *context, char const *path, char **x509certData
  *         or contains illegal characters.
  */
 TSS2_RC
-Fapi_GetCertificate_Async(FAPI_CONTEXT *context, char const *path)
+Fapi_GetCertificate_Async(FAPI_CONTEXT *context, char const *path) {
+    TSS2_RC r;
 
-{
+    fapi_probe_entry();
+    r = fapi_get_certificate_async(context, path);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_certificate_async(FAPI_CONTEXT *context, char const *path) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
 
@@ -144,6 +166,8 @@ Fapi_GetCertificate_Async(FAPI_CONTEXT *context, char const *path)
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_certificate_finish(FAPI_CONTEXT *context, char **x509certData);
+
 /** Asynchronous finish function for Fapi_GetCertificate
  *
  * This function should be called after a previous Fapi_GetCertificate_Async.
@@ -167,6 +191,16 @@ Fapi_GetCertificate_Async(FAPI_CONTEXT *context, char const *path)
  */
 TSS2_RC
 Fapi_GetCertificate_Finish(FAPI_CONTEXT *context, char **x509certData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_certificate_finish(context, x509certData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_certificate_finish(FAPI_CONTEXT *context, char **x509certData) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
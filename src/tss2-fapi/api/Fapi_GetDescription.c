@@ -19,6 +19,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, base_rc, return_error, return...
 
+static TSS2_RC fapi_get_description(FAPI_CONTEXT *context, char const *path, char **description);
+
 /** One-Call function for Fapi_GetDescription
  *
  * Returns the description of a previously stored object.
@@ -48,6 +50,16 @@
  */
 TSS2_RC
 Fapi_GetDescription(FAPI_CONTEXT *context, char const *path, char **description) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_description(context, path, description);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_description(FAPI_CONTEXT *context, char const *path, char **description) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -77,6 +89,8 @@ Fapi_GetDescription(FAPI_CONTEXT *context, char const *path, char **description)
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_description_async(FAPI_CONTEXT *context, char const *path);
+
 /** Asynchronous function for Fapi_GetDescription
  *
  * Returns the description of a previously stored object.
@@ -104,6 +118,16 @@ Fapi_GetDescription(FAPI_CONTEXT *context, char const *path, char **description)
  */
 TSS2_RC
 Fapi_GetDescription_Async(FAPI_CONTEXT *context, char const *path) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_description_async(context, path);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_description_async(FAPI_CONTEXT *context, char const *path) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
 
@@ -128,6 +152,8 @@ Fapi_GetDescription_Async(FAPI_CONTEXT *context, char const *path) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_description_finish(FAPI_CONTEXT *context, char **description);
+
 /** Asynchronous finish function for Fapi_GetDescription
  *
  * This function should be called after a previous Fapi_GetDescription_Async.
@@ -151,6 +177,16 @@ Fapi_GetDescription_Async(FAPI_CONTEXT *context, char const *path) {
  */
 TSS2_RC
 Fapi_GetDescription_Finish(FAPI_CONTEXT *context, char **description) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_description_finish(context, description);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_description_finish(FAPI_CONTEXT *context, char **description) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC      r;
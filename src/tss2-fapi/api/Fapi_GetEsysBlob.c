@@ -29,6 +29,12 @@
 #include "tss2_mu.h"  // for Tss2_MU_TPMS_CONTEXT_Marshal
 #include "util/log.h" // for goto_if_error, LOG_TRACE, SAFE_FREE
 
+static TSS2_RC fapi_get_esys_blob(FAPI_CONTEXT *context,
+                                  char const   *path,
+                                  uint8_t      *type,
+                                  uint8_t     **data,
+                                  size_t       *length);
+
 /** One-Call function for Fapi_GetEsysBlob
  *
  * Gets blobs of FAPI objects which can be used to create ESAPI objects.
@@ -79,6 +85,20 @@ Fapi_GetEsysBlob(FAPI_CONTEXT *context,
                  uint8_t      *type,
                  uint8_t     **data,
                  size_t       *length) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_esys_blob(context, path, type, data, length);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_esys_blob(FAPI_CONTEXT *context,
+                   char const   *path,
+                   uint8_t      *type,
+                   uint8_t     **data,
+                   size_t       *length) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -106,6 +126,8 @@ Fapi_GetEsysBlob(FAPI_CONTEXT *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_esys_blob_async(FAPI_CONTEXT *context, char const *path);
+
 /** Asynchronous function for Fapi_GetEsysBlob
  *
  * Prepares the reading of the blobs from keystore or TPM.
@@ -136,6 +158,16 @@ Fapi_GetEsysBlob(FAPI_CONTEXT *context,
  */
 TSS2_RC
 Fapi_GetEsysBlob_Async(FAPI_CONTEXT *context, char const *path) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_esys_blob_async(context, path);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_esys_blob_async(FAPI_CONTEXT *context, char const *path) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
 
@@ -191,6 +223,11 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_get_esys_blob_finish(FAPI_CONTEXT *context,
+                                         uint8_t      *type,
+                                         uint8_t     **data,
+                                         size_t       *length);
+
 /** Asynchronous finish function for Fapi_GetEsysBlob
  *
  * This function should be called after a previous Fapi_GetEsysBlob_Async.
@@ -229,6 +266,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_GetEsysBlob_Finish(FAPI_CONTEXT *context, uint8_t *type, uint8_t **data, size_t *length) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_esys_blob_finish(context, type, data, length);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_esys_blob_finish(FAPI_CONTEXT *context, uint8_t *type, uint8_t **data, size_t *length) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC       r;
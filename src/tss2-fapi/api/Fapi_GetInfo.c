@@ -55,6 +55,8 @@ static IFAPI_INFO_CAP info_cap_tab[] = {
     { "ecc-curves", TPM2_CAP_ECC_CURVES, 0, TPM2_MAX_ECC_CURVES },
 };
 
+static TSS2_RC fapi_get_info(FAPI_CONTEXT *context, char **info);
+
 /** One-Call function for Fapi_GetInfo
  *
  * Returns a UTF-8 encoded string that identifies the versions of FAPI, TPM,
@@ -82,6 +84,16 @@ static IFAPI_INFO_CAP info_cap_tab[] = {
  */
 TSS2_RC
 Fapi_GetInfo(FAPI_CONTEXT *context, char **info) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_info(context, info);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_info(FAPI_CONTEXT *context, char **info) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -128,6 +140,8 @@ Fapi_GetInfo(FAPI_CONTEXT *context, char **info) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_info_async(FAPI_CONTEXT *context);
+
 /** Asynchronous function for Fapi_GetInfo
  *
  * Returns a UTF-8 encoded string that identifies the versions of FAPI, TPM,
@@ -150,6 +164,16 @@ Fapi_GetInfo(FAPI_CONTEXT *context, char **info) {
  */
 TSS2_RC
 Fapi_GetInfo_Async(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_info_async(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_info_async(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -179,6 +203,8 @@ Fapi_GetInfo_Async(FAPI_CONTEXT *context) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_info_finish(FAPI_CONTEXT *context, char **info);
+
 /** Asynchronous finish function for Fapi_GetInfo
  *
  * This function should be called after a previous Fapi_GetInfo_Async.
@@ -203,6 +229,16 @@ Fapi_GetInfo_Async(FAPI_CONTEXT *context) {
  */
 TSS2_RC
 Fapi_GetInfo_Finish(FAPI_CONTEXT *context, char **info) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_info_finish(context, info);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_info_finish(FAPI_CONTEXT *context, char **info) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC      r;
@@ -26,6 +26,10 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, return_if_error
 
+static TSS2_RC fapi_get_platform_certificates(FAPI_CONTEXT *context,
+                                              uint8_t     **certificates,
+                                              size_t       *certificatesSize);
+
 /** One-Call function for Fapi_GetPlatformCertificates
  *
  * Platform certificates for TPM 2.0 can consist not only of a single certificate
@@ -71,6 +75,18 @@ TSS2_RC
 Fapi_GetPlatformCertificates(FAPI_CONTEXT *context,
                              uint8_t     **certificates,
                              size_t       *certificatesSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_platform_certificates(context, certificates, certificatesSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_platform_certificates(FAPI_CONTEXT *context,
+                               uint8_t     **certificates,
+                               size_t       *certificatesSize) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -117,6 +133,8 @@ Fapi_GetPlatformCertificates(FAPI_CONTEXT *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_platform_certificates_async(FAPI_CONTEXT *context);
+
 /** Asynchronous function for Fapi_GetPlatformCertificates
  *
  * Platform certificates for TPM 2.0 can consist not only of a single certificate
@@ -142,6 +160,16 @@ Fapi_GetPlatformCertificates(FAPI_CONTEXT *context,
  */
 TSS2_RC
 Fapi_GetPlatformCertificates_Async(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_platform_certificates_async(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_platform_certificates_async(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -164,6 +192,10 @@ Fapi_GetPlatformCertificates_Async(FAPI_CONTEXT *context) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_platform_certificates_finish(FAPI_CONTEXT *context,
+                                                     uint8_t     **certificates,
+                                                     size_t       *certificatesSize);
+
 /** Asynchronous finish function for Fapi_GetPlatformCertificates
  *
  * This function should be called after a previous
@@ -205,6 +237,18 @@ TSS2_RC
 Fapi_GetPlatformCertificates_Finish(FAPI_CONTEXT *context,
                                     uint8_t     **certificates,
                                     size_t       *certificatesSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_platform_certificates_finish(context, certificates, certificatesSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_platform_certificates_finish(FAPI_CONTEXT *context,
+                                      uint8_t     **certificates,
+                                      size_t       *certificatesSize) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -20,6 +20,10 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_DEBUG, LOG_TRACE, LOG_ERROR, return_if...
 
+static TSS2_RC fapi_get_poll_handles(FAPI_CONTEXT      *context,
+                                     FAPI_POLL_HANDLE **handles,
+                                     size_t            *num_handles);
+
 /** Retrieve handles for polling
  *
  * Returns an array of handles that can be polled on to get notified when
@@ -45,6 +49,16 @@
  */
 TSS2_RC
 Fapi_GetPollHandles(FAPI_CONTEXT *context, FAPI_POLL_HANDLE **handles, size_t *num_handles) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_poll_handles(context, handles, num_handles);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_poll_handles(FAPI_CONTEXT *context, FAPI_POLL_HANDLE **handles, size_t *num_handles) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
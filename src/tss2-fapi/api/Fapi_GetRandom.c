@@ -27,6 +27,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, return_if_error, SAFE_FREE
 
+static TSS2_RC fapi_get_random(FAPI_CONTEXT *context, size_t numBytes, uint8_t **data);
+
 /** One-Call function for Fapi_GetRandom
  *
  * Creates an array with a specified number of bytes. May execute the underlying
@@ -65,6 +67,16 @@
  */
 TSS2_RC
 Fapi_GetRandom(FAPI_CONTEXT *context, size_t numBytes, uint8_t **data) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_random(context, numBytes, data);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_random(FAPI_CONTEXT *context, size_t numBytes, uint8_t **data) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -111,6 +123,8 @@ Fapi_GetRandom(FAPI_CONTEXT *context, size_t numBytes, uint8_t **data) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_random_async(FAPI_CONTEXT *context, size_t numBytes);
+
 /** Asynchronous function for Fapi_GetRandom
  *
  * Creates an array with a specified number of bytes. May execute the underlying
@@ -141,6 +155,16 @@ Fapi_GetRandom(FAPI_CONTEXT *context, size_t numBytes, uint8_t **data) {
  */
 TSS2_RC
 Fapi_GetRandom_Async(FAPI_CONTEXT *context, size_t numBytes) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_random_async(context, numBytes);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_random_async(FAPI_CONTEXT *context, size_t numBytes) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("numBytes: %zu", numBytes);
 
@@ -175,6 +199,8 @@ Fapi_GetRandom_Async(FAPI_CONTEXT *context, size_t numBytes) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_random_finish(FAPI_CONTEXT *context, uint8_t **data);
+
 /** Asynchronous finish function for Fapi_GetRandom
  *
  * This function should be called after a previous Fapi_GetRandom_Async.
@@ -210,6 +236,16 @@ Fapi_GetRandom_Async(FAPI_CONTEXT *context, size_t numBytes) {
  */
 TSS2_RC
 Fapi_GetRandom_Finish(FAPI_CONTEXT *context, uint8_t **data) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_random_finish(context, data);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_random_finish(FAPI_CONTEXT *context, uint8_t **data) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
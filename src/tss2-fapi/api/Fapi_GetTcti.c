@@ -18,6 +18,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_DEBUG, LOG_TRACE, return_error, return...
 
+static TSS2_RC fapi_get_tcti(FAPI_CONTEXT *context, TSS2_TCTI_CONTEXT **tcti);
+
 /** One-Call function for Fapi_GetTcti
  *
  * Fapi_GetTcti returns the TSS2_TCTI_CONTEXT currently used by the provided FAPI_CONTEXT.
@@ -37,6 +39,16 @@
  */
 TSS2_RC
 Fapi_GetTcti(FAPI_CONTEXT *context, TSS2_TCTI_CONTEXT **tcti) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_tcti(context, tcti);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_tcti(FAPI_CONTEXT *context, TSS2_TCTI_CONTEXT **tcti) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
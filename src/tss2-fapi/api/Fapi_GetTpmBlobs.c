@@ -27,6 +27,14 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, goto_if_error
 
+static TSS2_RC fapi_get_tpm_blobs(FAPI_CONTEXT *context,
+                                  char const   *path,
+                                  uint8_t     **tpm2bPublic,
+                                  size_t       *tpm2bPublicSize,
+                                  uint8_t     **tpm2bPrivate,
+                                  size_t       *tpm2bPrivateSize,
+                                  char        **policy);
+
 /** One-Call function for Fapi_GetTpmBlobs
  *
  * Get the public and private blobs of a TPM object. They can be loaded with a
@@ -69,6 +77,23 @@ Fapi_GetTpmBlobs(FAPI_CONTEXT *context,
                  uint8_t     **tpm2bPrivate,
                  size_t       *tpm2bPrivateSize,
                  char        **policy) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_tpm_blobs(context, path, tpm2bPublic, tpm2bPublicSize, tpm2bPrivate,
+                           tpm2bPrivateSize, policy);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_tpm_blobs(FAPI_CONTEXT *context,
+                   char const   *path,
+                   uint8_t     **tpm2bPublic,
+                   size_t       *tpm2bPublicSize,
+                   uint8_t     **tpm2bPrivate,
+                   size_t       *tpm2bPrivateSize,
+                   char        **policy) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -98,6 +123,8 @@ Fapi_GetTpmBlobs(FAPI_CONTEXT *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_tpm_blobs_async(FAPI_CONTEXT *context, char const *path);
+
 /** Asynchronous function for Fapi_GetTpmBlobs
  *
  * Get the public and private blobs of a TPM object. They can be loaded with a
@@ -126,6 +153,16 @@ Fapi_GetTpmBlobs(FAPI_CONTEXT *context,
  */
 TSS2_RC
 Fapi_GetTpmBlobs_Async(FAPI_CONTEXT *context, char const *path) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_tpm_blobs_async(context, path);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_tpm_blobs_async(FAPI_CONTEXT *context, char const *path) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
 
@@ -152,6 +189,13 @@ Fapi_GetTpmBlobs_Async(FAPI_CONTEXT *context, char const *path) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_get_tpm_blobs_finish(FAPI_CONTEXT *context,
+                                         uint8_t     **tpm2bPublic,
+                                         size_t       *tpm2bPublicSize,
+                                         uint8_t     **tpm2bPrivate,
+                                         size_t       *tpm2bPrivateSize,
+                                         char        **policy);
+
 /** Asynchronous finish function for Fapi_GetTpmBlobs
  *
  * This function should be called after a previous Fapi_GetTpmBlobs_Async.
@@ -188,6 +232,22 @@ Fapi_GetTpmBlobs_Finish(FAPI_CONTEXT *context,
                         uint8_t     **tpm2bPrivate,
                         size_t       *tpm2bPrivateSize,
                         char        **policy) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_get_tpm_blobs_finish(context, tpm2bPublic, tpm2bPublicSize, tpm2bPrivate,
+                                  tpm2bPrivateSize, policy);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_get_tpm_blobs_finish(FAPI_CONTEXT *context,
+                          uint8_t     **tpm2bPublic,
+                          size_t       *tpm2bPublicSize,
+                          uint8_t     **tpm2bPrivate,
+                          size_t       *tpm2bPrivateSize,
+                          char        **policy) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC      r;
@@ -38,6 +38,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for goto_if_error, SAFE_FREE
 
+static TSS2_RC fapi_import(FAPI_CONTEXT *context, char const *path, char const *importData);
+
 /** One-Call function for Fapi_Import
  *
  * Imports a JSON encoded policy, policy template or key and stores it at the
@@ -78,6 +80,16 @@
  */
 TSS2_RC
 Fapi_Import(FAPI_CONTEXT *context, char const *path, char const *importData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_import(context, path, importData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_import(FAPI_CONTEXT *context, char const *path, char const *importData) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -107,6 +119,8 @@ Fapi_Import(FAPI_CONTEXT *context, char const *path, char const *importData) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_import_async(FAPI_CONTEXT *context, char const *path, char const *importData);
+
 /** Asynchronous function for Fapi_Import
  *
  * Imports a JSON encoded policy, policy template or key and stores it at the
@@ -142,6 +156,16 @@ Fapi_Import(FAPI_CONTEXT *context, char const *path, char const *importData) {
  */
 TSS2_RC
 Fapi_Import_Async(FAPI_CONTEXT *context, char const *path, char const *importData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_import_async(context, path, importData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_import_async(FAPI_CONTEXT *context, char const *path, char const *importData) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
     LOG_TRACE("importData: %s", importData);
@@ -363,6 +387,8 @@ cleanup_error:
     return r;
 }
 
+static TSS2_RC fapi_import_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_Import
  *
  * This function should be called after a previous Fapi_Import_Async.
@@ -398,6 +424,16 @@ cleanup_error:
  */
 TSS2_RC
 Fapi_Import_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_import_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_import_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
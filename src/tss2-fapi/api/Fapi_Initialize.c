@@ -33,6 +33,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for goto_if_error, LOG_TRACE, SAFE_FREE
 
+static TSS2_RC fapi_initialize(FAPI_CONTEXT **context, char const *uri);
+
 /** One-Call function for Fapi_Initialize
  *
  * Initializes a FAPI_CONTEXT that holds all the state and metadata information
@@ -58,6 +60,16 @@
  */
 TSS2_RC
 Fapi_Initialize(FAPI_CONTEXT **context, char const *uri) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_initialize(context, uri);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_initialize(FAPI_CONTEXT **context, char const *uri) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r = TSS2_RC_SUCCESS;
@@ -88,6 +100,8 @@ Fapi_Initialize(FAPI_CONTEXT **context, char const *uri) {
     return r;
 }
 
+static TSS2_RC fapi_initialize_async(FAPI_CONTEXT **context, char const *uri);
+
 /** Asynchronous function for Fapi_Initialize
  *
  * Initializes a FAPI_CONTEXT that holds all the state and metadata information
@@ -107,6 +121,16 @@ Fapi_Initialize(FAPI_CONTEXT **context, char const *uri) {
  */
 TSS2_RC
 Fapi_Initialize_Async(FAPI_CONTEXT **context, char const *uri) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_initialize_async(context, uri);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_initialize_async(FAPI_CONTEXT **context, char const *uri) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("uri: %s", uri);
 
@@ -145,6 +169,8 @@ cleanup_return:
     return r;
 }
 
+static TSS2_RC fapi_initialize_finish(FAPI_CONTEXT **context);
+
 /** Asynchronous finish function for Fapi_Initialize
  *
  * This function should be called after a previous Fapi_Initialize_Async.
@@ -170,6 +196,16 @@ cleanup_return:
  */
 TSS2_RC
 Fapi_Initialize_Finish(FAPI_CONTEXT **context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_initialize_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_initialize_finish(FAPI_CONTEXT **context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC            r;
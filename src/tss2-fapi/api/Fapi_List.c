@@ -23,6 +23,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, LOG_WARNING, goto_...
 
+static TSS2_RC fapi_list(FAPI_CONTEXT *context, char const *searchPath, char **pathList);
+
 /** One-Call function for Fapi_List
  *
  * Enumerates all objects in the metadatastore in a fiven path and returns them
@@ -51,6 +53,16 @@
  */
 TSS2_RC
 Fapi_List(FAPI_CONTEXT *context, char const *searchPath, char **pathList) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_list(context, searchPath, pathList);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_list(FAPI_CONTEXT *context, char const *searchPath, char **pathList) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -80,6 +92,8 @@ Fapi_List(FAPI_CONTEXT *context, char const *searchPath, char **pathList) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_list_async(FAPI_CONTEXT *context, char const *searchPath);
+
 /** Asynchronous function for Fapi_List
  *
  * Enumerates all objects in the metadatastore in a fiven path and returns them
@@ -104,6 +118,16 @@ Fapi_List(FAPI_CONTEXT *context, char const *searchPath, char **pathList) {
  */
 TSS2_RC
 Fapi_List_Async(FAPI_CONTEXT *context, char const *searchPath) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_list_async(context, searchPath);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_list_async(FAPI_CONTEXT *context, char const *searchPath) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("searchPath: %s", searchPath);
 
@@ -131,6 +155,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_list_finish(FAPI_CONTEXT *context, char **pathList);
+
 /** Asynchronous finish function for Fapi_List
  *
  * This function should be called after a previous Fapi_List_Async.
@@ -158,6 +184,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_List_Finish(FAPI_CONTEXT *context, char **pathList) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_list_finish(context, pathList);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_list_finish(FAPI_CONTEXT *context, char **pathList) {
     LOG_TRACE("called for context:%p", context);
     bool provision_check_ok;
 
@@ -33,6 +33,12 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, goto_if_error
 
+static TSS2_RC fapi_nv_extend(FAPI_CONTEXT  *context,
+                              char const    *nvPath,
+                              uint8_t const *data,
+                              size_t         dataSize,
+                              char const    *logData);
+
 /** One-Call function for Fapi_NvExtend
  *
  * Performs an extend operation on an NV index with the type extend.
@@ -78,6 +84,20 @@ Fapi_NvExtend(FAPI_CONTEXT  *context,
               uint8_t const *data,
               size_t         dataSize,
               char const    *logData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_extend(context, nvPath, data, dataSize, logData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_extend(FAPI_CONTEXT  *context,
+               char const    *nvPath,
+               uint8_t const *data,
+               size_t         dataSize,
+               char const    *logData) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -125,6 +145,12 @@ Fapi_NvExtend(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_nv_extend_async(FAPI_CONTEXT  *context,
+                                    char const    *nvPath,
+                                    uint8_t const *data,
+                                    size_t         dataSize,
+                                    char const    *logData);
+
 /** Asynchronous function for Fapi_NvExtend
  *
  * Performs an extend operation on an NV index with the type extend.
@@ -164,6 +190,20 @@ Fapi_NvExtend_Async(FAPI_CONTEXT  *context,
                     uint8_t const *data,
                     size_t         dataSize,
                     char const    *logData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_extend_async(context, nvPath, data, dataSize, logData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_extend_async(FAPI_CONTEXT  *context,
+                     char const    *nvPath,
+                     uint8_t const *data,
+                     size_t         dataSize,
+                     char const    *logData) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("nvPath: %s", nvPath);
     if (data) {
@@ -224,6 +264,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_nv_extend_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_NvExtend
  *
  * This function should be called after a previous Fapi_NvExtend.
@@ -258,6 +300,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_NvExtend_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_extend_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_extend_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC                    r;
@@ -29,6 +29,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, return_if_error
 
+static TSS2_RC fapi_nv_increment(FAPI_CONTEXT *context, char const *nvPath);
+
 /** One-Call function for Fapi_NvIncrement
  *
  * Increments an NV index that is a counter by 1.
@@ -67,6 +69,16 @@
  */
 TSS2_RC
 Fapi_NvIncrement(FAPI_CONTEXT *context, char const *nvPath) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_increment(context, nvPath);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_increment(FAPI_CONTEXT *context, char const *nvPath) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -113,6 +125,8 @@ Fapi_NvIncrement(FAPI_CONTEXT *context, char const *nvPath) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_nv_increment_async(FAPI_CONTEXT *context, char const *nvPath);
+
 /** Asynchronous function for Fapi_NvIncrement
  *
  * Increments an NV index that is a counter by 1.
@@ -146,6 +160,16 @@ Fapi_NvIncrement(FAPI_CONTEXT *context, char const *nvPath) {
  */
 TSS2_RC
 Fapi_NvIncrement_Async(FAPI_CONTEXT *context, char const *nvPath) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_increment_async(context, nvPath);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_increment_async(FAPI_CONTEXT *context, char const *nvPath) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("nvPath: %s", nvPath);
 
@@ -186,6 +210,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_nv_increment_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_NvIncrement
  *
  * This function should be called after a previous Fapi_NvIncrement_Async.
@@ -220,6 +246,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_NvIncrement_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_increment_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_increment_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC      r;
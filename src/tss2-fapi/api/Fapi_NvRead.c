@@ -29,6 +29,12 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, return_if_error, SAFE_FREE
 
+static TSS2_RC fapi_nv_read(FAPI_CONTEXT *context,
+                            char const   *nvPath,
+                            uint8_t     **data,
+                            size_t       *size,
+                            char        **logData);
+
 /** One-Call function for Fapi_NvRead
  *
  * Reads data from an NV index within the TPM.
@@ -75,6 +81,20 @@ Fapi_NvRead(FAPI_CONTEXT *context,
             uint8_t     **data,
             size_t       *size,
             char        **logData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_read(context, nvPath, data, size, logData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_read(FAPI_CONTEXT *context,
+             char const   *nvPath,
+             uint8_t     **data,
+             size_t       *size,
+             char        **logData) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -122,6 +142,8 @@ Fapi_NvRead(FAPI_CONTEXT *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_nv_read_async(FAPI_CONTEXT *context, char const *nvPath);
+
 /** Asynchronous function for Fapi_NvRead
  *
  * Reads data from an NV index within the TPM.
@@ -156,6 +178,16 @@ Fapi_NvRead(FAPI_CONTEXT *context,
  */
 TSS2_RC
 Fapi_NvRead_Async(FAPI_CONTEXT *context, char const *nvPath) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_read_async(context, nvPath);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_read_async(FAPI_CONTEXT *context, char const *nvPath) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("nvPath: %s", nvPath);
 
@@ -195,6 +227,11 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_nv_read_finish(FAPI_CONTEXT *context,
+                                   uint8_t     **data,
+                                   size_t       *size,
+                                   char        **logData);
+
 /** Asynchronous finish function for Fapi_NvRead
  *
  * This function should be called after a previous Fapi_NvRead_Async.
@@ -233,6 +270,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_NvRead_Finish(FAPI_CONTEXT *context, uint8_t **data, size_t *size, char **logData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_read_finish(context, data, size, logData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_read_finish(FAPI_CONTEXT *context, uint8_t **data, size_t *size, char **logData) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -30,6 +30,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, goto_if_error
 
+static TSS2_RC fapi_nv_set_bits(FAPI_CONTEXT *context, char const *nvPath, uint64_t bitmap);
+
 /** One-Call function for Fapi_NvSetBits
  *
  * Sets bits in an NV index that was created as a bit field. Any number of bits
@@ -70,6 +72,16 @@
  */
 TSS2_RC
 Fapi_NvSetBits(FAPI_CONTEXT *context, char const *nvPath, uint64_t bitmap) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_set_bits(context, nvPath, bitmap);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_set_bits(FAPI_CONTEXT *context, char const *nvPath, uint64_t bitmap) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -116,6 +128,8 @@ Fapi_NvSetBits(FAPI_CONTEXT *context, char const *nvPath, uint64_t bitmap) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_nv_set_bits_async(FAPI_CONTEXT *context, char const *nvPath, uint64_t bitmap);
+
 /** Asynchronous function for Fapi_NvSetBits
  *
  * Sets bits in an NV index that was created as a bit field. Any number of bits
@@ -151,6 +165,16 @@ Fapi_NvSetBits(FAPI_CONTEXT *context, char const *nvPath, uint64_t bitmap) {
  */
 TSS2_RC
 Fapi_NvSetBits_Async(FAPI_CONTEXT *context, char const *nvPath, uint64_t bitmap) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_set_bits_async(context, nvPath, bitmap);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_set_bits_async(FAPI_CONTEXT *context, char const *nvPath, uint64_t bitmap) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("nvPath: %s", nvPath);
     LOG_TRACE("bitmap: 0x%" PRIx64, bitmap);
@@ -193,6 +217,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_nv_set_bits_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_NnSetBits
  *
  * This function should be called after a previous Fapi_NvSetBIts_Async.
@@ -227,6 +253,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_NvSetBits_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_set_bits_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_set_bits_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC      r;
@@ -26,6 +26,11 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, return_if_error
 
+static TSS2_RC fapi_nv_write(FAPI_CONTEXT  *context,
+                             char const    *nvPath,
+                             uint8_t const *data,
+                             size_t         size);
+
 /** One-Call function for Fapi_NvWrite
  *
  * Writes data to a "regular" (not pin, extend or counter) NV index.
@@ -67,6 +72,16 @@
  */
 TSS2_RC
 Fapi_NvWrite(FAPI_CONTEXT *context, char const *nvPath, uint8_t const *data, size_t size) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_write(context, nvPath, data, size);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_write(FAPI_CONTEXT *context, char const *nvPath, uint8_t const *data, size_t size) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -114,6 +129,11 @@ Fapi_NvWrite(FAPI_CONTEXT *context, char const *nvPath, uint8_t const *data, siz
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_nv_write_async(FAPI_CONTEXT  *context,
+                                   char const    *nvPath,
+                                   uint8_t const *data,
+                                   size_t         size);
+
 /** Asynchronous function for Fapi_NvWrite
  *
  * Writes data to a "regular" (not pin, extend or counter) NV index.
@@ -144,6 +164,16 @@ Fapi_NvWrite(FAPI_CONTEXT *context, char const *nvPath, uint8_t const *data, siz
  */
 TSS2_RC
 Fapi_NvWrite_Async(FAPI_CONTEXT *context, char const *nvPath, uint8_t const *data, size_t size) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_write_async(context, nvPath, data, size);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_write_async(FAPI_CONTEXT *context, char const *nvPath, uint8_t const *data, size_t size) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("nvPath: %s", nvPath);
     if (data) {
@@ -198,6 +228,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_nv_write_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_NvWrite
  *
  * This function should be called after a previous Fapi_NvWrite.
@@ -232,6 +264,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_NvWrite_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_nv_write_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_nv_write_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC      r;
@@ -28,6 +28,12 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, goto_if_error
 
+static TSS2_RC fapi_pcr_extend(FAPI_CONTEXT  *context,
+                               uint32_t       pcr,
+                               uint8_t const *data,
+                               size_t         dataSize,
+                               char const    *logData);
+
 /** One-Call function for Fapi_PcrExtend
  *
  * Performs an extend operation on a given PCR.
@@ -74,6 +80,20 @@ Fapi_PcrExtend(FAPI_CONTEXT  *context,
                uint8_t const *data,
                size_t         dataSize,
                char const    *logData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_pcr_extend(context, pcr, data, dataSize, logData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_pcr_extend(FAPI_CONTEXT  *context,
+                uint32_t       pcr,
+                uint8_t const *data,
+                size_t         dataSize,
+                char const    *logData) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -120,6 +140,12 @@ Fapi_PcrExtend(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_pcr_extend_async(FAPI_CONTEXT  *context,
+                                     uint32_t       pcr,
+                                     uint8_t const *data,
+                                     size_t         dataSize,
+                                     char const    *logData);
+
 /** Asynchronous function for Fapi_PcrExtend
  *
  * Performs an extend operation on a given PCR.
@@ -154,6 +180,20 @@ Fapi_PcrExtend_Async(FAPI_CONTEXT  *context,
                      uint8_t const *data,
                      size_t         dataSize,
                      char const    *logData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_pcr_extend_async(context, pcr, data, dataSize, logData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_pcr_extend_async(FAPI_CONTEXT  *context,
+                      uint32_t       pcr,
+                      uint8_t const *data,
+                      size_t         dataSize,
+                      char const    *logData) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("pcr: %u", pcr);
     if (data) {
@@ -205,6 +245,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_pcr_extend_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_PcrExtend
  *
  * This function should be called after a previous Fapi_PcrExtend_Async.
@@ -239,6 +281,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_PcrExtend_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_pcr_extend_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_pcr_extend_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC     r;
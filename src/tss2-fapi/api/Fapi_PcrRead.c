@@ -29,6 +29,12 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, return_if_error, SAFE_FREE
 
+static TSS2_RC fapi_pcr_read(FAPI_CONTEXT *context,
+                             uint32_t      pcrIndex,
+                             uint8_t     **pcrValue,
+                             size_t       *pcrValueSize,
+                             char        **pcrLog);
+
 /** One-Call function for Fapi_PcrRead
  *
  * Reads from a given PCR and returns the value and the event log.
@@ -71,6 +77,20 @@ Fapi_PcrRead(FAPI_CONTEXT *context,
              uint8_t     **pcrValue,
              size_t       *pcrValueSize,
              char        **pcrLog) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_pcr_read(context, pcrIndex, pcrValue, pcrValueSize, pcrLog);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_pcr_read(FAPI_CONTEXT *context,
+              uint32_t      pcrIndex,
+              uint8_t     **pcrValue,
+              size_t       *pcrValueSize,
+              char        **pcrLog) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -116,6 +136,8 @@ Fapi_PcrRead(FAPI_CONTEXT *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_pcr_read_async(FAPI_CONTEXT *context, uint32_t pcrIndex);
+
 /** Asynchronous function for Fapi_PcrRead
  *
  * Reads from a given PCR and returns the value and the event log.
@@ -140,6 +162,16 @@ Fapi_PcrRead(FAPI_CONTEXT *context,
  */
 TSS2_RC
 Fapi_PcrRead_Async(FAPI_CONTEXT *context, uint32_t pcrIndex) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_pcr_read_async(context, pcrIndex);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_pcr_read_async(FAPI_CONTEXT *context, uint32_t pcrIndex) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("pcrIndex: %" PRIu32, pcrIndex);
 
@@ -181,6 +213,11 @@ Fapi_PcrRead_Async(FAPI_CONTEXT *context, uint32_t pcrIndex) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_pcr_read_finish(FAPI_CONTEXT *context,
+                                    uint8_t     **pcrValue,
+                                    size_t       *pcrValueSize,
+                                    char        **pcrLog);
+
 /** Asynchronous finish function for Fapi_PcrRead
  *
  * This function should be called after a previous Fapi_PcrRead_Async.
@@ -210,6 +247,19 @@ Fapi_PcrRead_Finish(FAPI_CONTEXT *context,
                     uint8_t     **pcrValue,
                     size_t       *pcrValueSize,
                     char        **pcrLog) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_pcr_read_finish(context, pcrValue, pcrValueSize, pcrLog);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_pcr_read_finish(FAPI_CONTEXT *context,
+                     uint8_t     **pcrValue,
+                     size_t       *pcrValueSize,
+                     char        **pcrLog) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
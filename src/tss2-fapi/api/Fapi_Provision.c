@@ -87,6 +87,11 @@ error_cleanup_provisioning(FAPI_CONTEXT *context) {
     }
 }
 
+static TSS2_RC fapi_provision(FAPI_CONTEXT *context,
+                              char const   *authValueEh,
+                              char const   *authValueSh,
+                              char const   *authValueLockout);
+
 /** One-Call function for the initial FAPI provisioning.
  *
  * Provisions a TSS with its TPM. This includes the setting of important passwords
@@ -138,6 +143,19 @@ Fapi_Provision(FAPI_CONTEXT *context,
                char const   *authValueEh,
                char const   *authValueSh,
                char const   *authValueLockout) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_provision(context, authValueEh, authValueSh, authValueLockout);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_provision(FAPI_CONTEXT *context,
+               char const   *authValueEh,
+               char const   *authValueSh,
+               char const   *authValueLockout) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -183,6 +201,11 @@ Fapi_Provision(FAPI_CONTEXT *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_provision_async(FAPI_CONTEXT *context,
+                                    char const   *authValueEh,
+                                    char const   *authValueSh,
+                                    char const   *authValueLockout);
+
 /** Asynchronous function for the initial FAPI provisioning.
  *
  * Provisions a TSS with its TPM. This includes the setting of important passwords
@@ -220,6 +243,19 @@ Fapi_Provision_Async(FAPI_CONTEXT *context,
                      char const   *authValueEh,
                      char const   *authValueSh,
                      char const   *authValueLockout) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_provision_async(context, authValueEh, authValueSh, authValueLockout);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_provision_async(FAPI_CONTEXT *context,
+                     char const   *authValueEh,
+                     char const   *authValueSh,
+                     char const   *authValueLockout) {
     char  *profile_dir = NULL;
     size_t i;
 
@@ -296,6 +332,8 @@ end:
     return r;
 }
 
+static TSS2_RC fapi_provision_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_Provision
  *
  * This function should be called after a previous Fapi_Provision_Async.
@@ -335,6 +373,16 @@ end:
  */
 TSS2_RC
 Fapi_Provision_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_provision_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_provision_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC          r = TSS2_RC_SUCCESS;
@@ -30,6 +30,19 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for SAFE_FREE, LOG_TRACE, goto_if_error
 
+static TSS2_RC fapi_quote(FAPI_CONTEXT  *context,
+                          uint32_t      *pcrList,
+                          size_t         pcrListSize,
+                          char const    *keyPath,
+                          char const    *quoteType,
+                          uint8_t const *qualifyingData,
+                          size_t         qualifyingDataSize,
+                          char         **quoteInfo,
+                          uint8_t      **signature,
+                          size_t        *signatureSize,
+                          char         **pcrLog,
+                          char         **certificate);
+
 /** One-Call function for Fapi_Quote
  *
  * Given a set of PCRs and a restricted signing key, it will sign those PCRs and
@@ -95,6 +108,28 @@ Fapi_Quote(FAPI_CONTEXT  *context,
            size_t        *signatureSize,
            char         **pcrLog,
            char         **certificate) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_quote(context, pcrList, pcrListSize, keyPath, quoteType, qualifyingData,
+                   qualifyingDataSize, quoteInfo, signature, signatureSize, pcrLog, certificate);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_quote(FAPI_CONTEXT  *context,
+           uint32_t      *pcrList,
+           size_t         pcrListSize,
+           char const    *keyPath,
+           char const    *quoteType,
+           uint8_t const *qualifyingData,
+           size_t         qualifyingDataSize,
+           char         **quoteInfo,
+           uint8_t      **signature,
+           size_t        *signatureSize,
+           char         **pcrLog,
+           char         **certificate) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -145,6 +180,14 @@ Fapi_Quote(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_quote_async(FAPI_CONTEXT  *context,
+                                uint32_t      *pcrList,
+                                size_t         pcrListSize,
+                                char const    *keyPath,
+                                char const    *quoteType,
+                                uint8_t const *qualifyingData,
+                                size_t         qualifyingDataSize);
+
 /** Asynchronous function for Fapi_Quote
  *
  * Given a set of PCRs and a restricted signing key, it will sign those PCRs and
@@ -186,6 +229,23 @@ Fapi_Quote_Async(FAPI_CONTEXT  *context,
                  char const    *quoteType,
                  uint8_t const *qualifyingData,
                  size_t         qualifyingDataSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_quote_async(context, pcrList, pcrListSize, keyPath, quoteType, qualifyingData,
+                         qualifyingDataSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_quote_async(FAPI_CONTEXT  *context,
+                 uint32_t      *pcrList,
+                 size_t         pcrListSize,
+                 char const    *keyPath,
+                 char const    *quoteType,
+                 uint8_t const *qualifyingData,
+                 size_t         qualifyingDataSize) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("pcrListSize: %zi", pcrListSize);
     for (size_t i = 0; i < pcrListSize; i++) {
@@ -264,6 +324,13 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_quote_finish(FAPI_CONTEXT *context,
+                                 char        **quoteInfo,
+                                 uint8_t     **signature,
+                                 size_t       *signatureSize,
+                                 char        **pcrLog,
+                                 char        **certificate);
+
 /** Asynchronous finish function for Fapi_Quote
  *
  * This function should be called after a previous Fapi_Quote_Async.
@@ -311,6 +378,21 @@ Fapi_Quote_Finish(FAPI_CONTEXT *context,
                   size_t       *signatureSize,
                   char        **pcrLog,
                   char        **certificate) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_quote_finish(context, quoteInfo, signature, signatureSize, pcrLog, certificate);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_quote_finish(FAPI_CONTEXT *context,
+                  char        **quoteInfo,
+                  uint8_t     **signature,
+                  size_t       *signatureSize,
+                  char        **pcrLog,
+                  char        **certificate) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC              r;
@@ -26,6 +26,11 @@
 
 #define FAPI_MAX_APP_DATA_SIZE (10 * 1024 * 1024)
 
+static TSS2_RC fapi_set_app_data(FAPI_CONTEXT  *context,
+                                 char const    *path,
+                                 uint8_t const *appData,
+                                 size_t         appDataSize);
+
 /** One-Call function for Fapi_SetAppData
  *
  * Associates an arbitrary data blob with a given object.
@@ -61,6 +66,19 @@ Fapi_SetAppData(FAPI_CONTEXT  *context,
                 char const    *path,
                 uint8_t const *appData,
                 size_t         appDataSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_app_data(context, path, appData, appDataSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_app_data(FAPI_CONTEXT  *context,
+                  char const    *path,
+                  uint8_t const *appData,
+                  size_t         appDataSize) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -89,6 +107,11 @@ Fapi_SetAppData(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_set_app_data_async(FAPI_CONTEXT  *context,
+                                       char const    *path,
+                                       uint8_t const *appData,
+                                       size_t         appDataSize);
+
 /** One-Call function for Fapi_SetAppData
  *
  * Associates an arbitrary data blob with a given object.
@@ -123,6 +146,19 @@ Fapi_SetAppData_Async(FAPI_CONTEXT  *context,
                       char const    *path,
                       uint8_t const *appData,
                       size_t         appDataSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_app_data_async(context, path, appData, appDataSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_app_data_async(FAPI_CONTEXT  *context,
+                        char const    *path,
+                        uint8_t const *appData,
+                        size_t         appDataSize) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
     if (appData) {
@@ -189,6 +225,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_set_app_data_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_SetAppData
  *
  * This function should be called after a previous Fapi_SetAppData_Async.
@@ -215,6 +253,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_SetAppData_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_app_data_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_app_data_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -22,6 +22,10 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, goto_if_error, bas...
 
+static TSS2_RC fapi_set_certificate(FAPI_CONTEXT *context,
+                                    char const   *path,
+                                    char const   *x509certData);
+
 /** One-Call function for Fapi_SetCertificate
  *
  * Sets an x509 cert into the path of a key.
@@ -57,6 +61,16 @@
  */
 TSS2_RC
 Fapi_SetCertificate(FAPI_CONTEXT *context, char const *path, char const *x509certData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_certificate(context, path, x509certData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_certificate(FAPI_CONTEXT *context, char const *path, char const *x509certData) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -85,6 +99,10 @@ Fapi_SetCertificate(FAPI_CONTEXT *context, char const *path, char const *x509cer
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_set_certificate_async(FAPI_CONTEXT *context,
+                                          char const   *path,
+                                          char const   *x509certData);
+
 /** Asynchronous function for Fapi_SetCertificate
  *
  * Sets an x509 cert into the path of a key.
@@ -118,6 +136,16 @@ Fapi_SetCertificate(FAPI_CONTEXT *context, char const *path, char const *x509cer
  */
 TSS2_RC
 Fapi_SetCertificate_Async(FAPI_CONTEXT *context, char const *path, char const *x509certData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_certificate_async(context, path, x509certData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_certificate_async(FAPI_CONTEXT *context, char const *path, char const *x509certData) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
     LOG_TRACE("x509certData: %s", x509certData);
@@ -165,6 +193,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_set_certificate_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_SetCertificate
  *
  * This function should be called after a previous Fapi_SetCertificate_Async.
@@ -192,6 +222,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_SetCertificate_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_certificate_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_certificate_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
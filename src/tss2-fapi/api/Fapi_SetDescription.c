@@ -22,6 +22,10 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, return_error, base_rc
 
+static TSS2_RC fapi_set_description(FAPI_CONTEXT *context,
+                                    char const   *path,
+                                    char const   *description);
+
 /** One-Call function for Fapi_SetDescription
  *
  * Associates a human readable description with an object in the metadata store.
@@ -52,6 +56,16 @@
  */
 TSS2_RC
 Fapi_SetDescription(FAPI_CONTEXT *context, char const *path, char const *description) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_description(context, path, description);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_description(FAPI_CONTEXT *context, char const *path, char const *description) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -80,6 +94,10 @@ Fapi_SetDescription(FAPI_CONTEXT *context, char const *path, char const *descrip
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_set_description_async(FAPI_CONTEXT *context,
+                                          char const   *path,
+                                          char const   *description);
+
 /** Asynchronous function for Fapi_SetDescription
  *
  * Associates a human readable description with an object in the metadata store.
@@ -109,6 +127,16 @@ Fapi_SetDescription(FAPI_CONTEXT *context, char const *path, char const *descrip
  */
 TSS2_RC
 Fapi_SetDescription_Async(FAPI_CONTEXT *context, char const *path, char const *description) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_description_async(context, path, description);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_description_async(FAPI_CONTEXT *context, char const *path, char const *description) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
     LOG_TRACE("description: %s", description);
@@ -159,6 +187,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_set_description_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_SetDescription
  *
  * This function should be called after a previous Fapi_SetDescription_Async.
@@ -184,6 +214,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_SetDescription_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_description_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_description_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
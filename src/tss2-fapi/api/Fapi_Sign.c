@@ -29,6 +29,16 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, goto_if_error
 
+static TSS2_RC fapi_sign(FAPI_CONTEXT  *context,
+                         char const    *keyPath,
+                         char const    *padding,
+                         uint8_t const *digest,
+                         size_t         digestSize,
+                         uint8_t      **signature,
+                         size_t        *signatureSize,
+                         char         **publicKey,
+                         char         **certificate);
+
 /** One-Call function for Fapi_Sign
  *
  * Uses a key, identified by its path, to sign a digest and puts the result in a
@@ -87,6 +97,25 @@ Fapi_Sign(FAPI_CONTEXT  *context,
           size_t        *signatureSize,
           char         **publicKey,
           char         **certificate) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_sign(context, keyPath, padding, digest, digestSize, signature, signatureSize,
+                  publicKey, certificate);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_sign(FAPI_CONTEXT  *context,
+          char const    *keyPath,
+          char const    *padding,
+          uint8_t const *digest,
+          size_t         digestSize,
+          uint8_t      **signature,
+          size_t        *signatureSize,
+          char         **publicKey,
+          char         **certificate) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -135,6 +164,12 @@ Fapi_Sign(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_sign_async(FAPI_CONTEXT  *context,
+                               char const    *keyPath,
+                               char const    *padding,
+                               uint8_t const *digest,
+                               size_t         digestSize);
+
 /** Asynchronous function for Fapi_Sign
  *
  * Uses a key, identified by its path, to sign a digest and puts the result in a
@@ -171,6 +206,20 @@ Fapi_Sign_Async(FAPI_CONTEXT  *context,
                 char const    *padding,
                 uint8_t const *digest,
                 size_t         digestSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_sign_async(context, keyPath, padding, digest, digestSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_sign_async(FAPI_CONTEXT  *context,
+                char const    *keyPath,
+                char const    *padding,
+                uint8_t const *digest,
+                size_t         digestSize) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("keyPath: %s", keyPath);
     LOG_TRACE("padding: %s", padding);
@@ -221,6 +270,12 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_sign_finish(FAPI_CONTEXT *context,
+                                uint8_t     **signature,
+                                size_t       *signatureSize,
+                                char        **publicKey,
+                                char        **certificate);
+
 /** Asynchronous finish function for Fapi_Sign
  *
  * This function should be called after a previous Fapi_Sign_Async.
@@ -265,6 +320,20 @@ Fapi_Sign_Finish(FAPI_CONTEXT *context,
                  size_t       *signatureSize,
                  char        **publicKey,
                  char        **certificate) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_sign_finish(context, signature, signatureSize, publicKey, certificate);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_sign_finish(FAPI_CONTEXT *context,
+                 uint8_t     **signature,
+                 size_t       *signatureSize,
+                 char        **publicKey,
+                 char        **certificate) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -27,6 +27,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, goto_if_error, SAFE_FREE
 
+static TSS2_RC fapi_unseal(FAPI_CONTEXT *context, char const *path, uint8_t **data, size_t *size);
+
 /** One-Call function for Fapi_Unseal
  *
  * Unseals data from a seal in the FAPI metadata store.
@@ -66,6 +68,16 @@
  */
 TSS2_RC
 Fapi_Unseal(FAPI_CONTEXT *context, char const *path, uint8_t **data, size_t *size) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_unseal(context, path, data, size);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_unseal(FAPI_CONTEXT *context, char const *path, uint8_t **data, size_t *size) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -115,6 +127,8 @@ Fapi_Unseal(FAPI_CONTEXT *context, char const *path, uint8_t **data, size_t *siz
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_unseal_async(FAPI_CONTEXT *context, char const *path);
+
 /** Asynchronous function for Fapi_Unseal
  *
  * Unseals data from a seal in the FAPI metadata store.
@@ -139,6 +153,16 @@ Fapi_Unseal(FAPI_CONTEXT *context, char const *path, uint8_t **data, size_t *siz
  */
 TSS2_RC
 Fapi_Unseal_Async(FAPI_CONTEXT *context, char const *path) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_unseal_async(context, path);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_unseal_async(FAPI_CONTEXT *context, char const *path) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("path: %s", path);
 
@@ -170,6 +194,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_unseal_finish(FAPI_CONTEXT *context, uint8_t **data, size_t *size);
+
 /** Asynchronous finish function for Fapi_Unseal
  *
  * This function should be called after a previous Fapi_Unseal_Async.
@@ -208,6 +234,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_Unseal_Finish(FAPI_CONTEXT *context, uint8_t **data, size_t *size) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_unseal_finish(context, data, size);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_unseal_finish(FAPI_CONTEXT *context, uint8_t **data, size_t *size) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -28,6 +28,15 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, goto_if_error
 
+static TSS2_RC fapi_verify_quote(FAPI_CONTEXT  *context,
+                                 char const    *publicKeyPath,
+                                 uint8_t const *qualifyingData,
+                                 size_t         qualifyingDataSize,
+                                 char const    *quoteInfo,
+                                 uint8_t const *signature,
+                                 size_t         signatureSize,
+                                 char const    *pcrLog);
+
 /** One-Call function for Fapi_VerifyQuote
  *
  * Verifies that the data returned by a quote is valid.
@@ -76,6 +85,24 @@ Fapi_VerifyQuote(FAPI_CONTEXT  *context,
                  uint8_t const *signature,
                  size_t         signatureSize,
                  char const    *pcrLog) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_verify_quote(context, publicKeyPath, qualifyingData, qualifyingDataSize, quoteInfo,
+                          signature, signatureSize, pcrLog);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_verify_quote(FAPI_CONTEXT  *context,
+                  char const    *publicKeyPath,
+                  uint8_t const *qualifyingData,
+                  size_t         qualifyingDataSize,
+                  char const    *quoteInfo,
+                  uint8_t const *signature,
+                  size_t         signatureSize,
+                  char const    *pcrLog) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -107,6 +134,15 @@ Fapi_VerifyQuote(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_verify_quote_async(FAPI_CONTEXT  *context,
+                                       char const    *publicKeyPath,
+                                       uint8_t const *qualifyingData,
+                                       size_t         qualifyingDataSize,
+                                       char const    *quoteInfo,
+                                       uint8_t const *signature,
+                                       size_t         signatureSize,
+                                       char const    *pcrLog);
+
 /** Asynchronous function for Fapi_VerifyQuote
  *
  * Verifies that the data returned by a quote is valid.
@@ -151,6 +187,24 @@ Fapi_VerifyQuote_Async(FAPI_CONTEXT  *context,
                        uint8_t const *signature,
                        size_t         signatureSize,
                        char const    *pcrLog) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_verify_quote_async(context, publicKeyPath, qualifyingData, qualifyingDataSize,
+                                quoteInfo, signature, signatureSize, pcrLog);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_verify_quote_async(FAPI_CONTEXT  *context,
+                        char const    *publicKeyPath,
+                        uint8_t const *qualifyingData,
+                        size_t         qualifyingDataSize,
+                        char const    *quoteInfo,
+                        uint8_t const *signature,
+                        size_t         signatureSize,
+                        char const    *pcrLog) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("publicKeyPath: %s", publicKeyPath);
     if (qualifyingData) {
@@ -235,6 +289,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_verify_quote_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_VerifyQuote
  *
  * This function should be called after a previous Fapi_VerifyQuote_Async.
@@ -259,6 +315,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_VerifyQuote_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_verify_quote_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_verify_quote_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC      r;
@@ -24,6 +24,13 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, LOGBLOB_TRACE, ret...
 
+static TSS2_RC fapi_verify_signature(FAPI_CONTEXT  *context,
+                                     char const    *keyPath,
+                                     uint8_t const *digest,
+                                     size_t         digestSize,
+                                     uint8_t const *signature,
+                                     size_t         signatureSize);
+
 /** One-Call function for Fapi_VerifySignature
  *
  * Verifies a signature using a public key found in a keyPath.
@@ -67,6 +74,21 @@ Fapi_VerifySignature(FAPI_CONTEXT  *context,
                      size_t         digestSize,
                      uint8_t const *signature,
                      size_t         signatureSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_verify_signature(context, keyPath, digest, digestSize, signature, signatureSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_verify_signature(FAPI_CONTEXT  *context,
+                      char const    *keyPath,
+                      uint8_t const *digest,
+                      size_t         digestSize,
+                      uint8_t const *signature,
+                      size_t         signatureSize) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
@@ -97,6 +119,13 @@ Fapi_VerifySignature(FAPI_CONTEXT  *context,
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_verify_signature_async(FAPI_CONTEXT  *context,
+                                           char const    *keyPath,
+                                           uint8_t const *digest,
+                                           size_t         digestSize,
+                                           uint8_t const *signature,
+                                           size_t         signatureSize);
+
 /** Asynchronous function for Fapi_VerifySignature
  *
  * Verifies a signature using a public key found in a keyPath.
@@ -139,6 +168,21 @@ Fapi_VerifySignature_Async(FAPI_CONTEXT  *context,
                            size_t         digestSize,
                            uint8_t const *signature,
                            size_t         signatureSize) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_verify_signature_async(context, keyPath, digest, digestSize, signature, signatureSize);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_verify_signature_async(FAPI_CONTEXT  *context,
+                            char const    *keyPath,
+                            uint8_t const *digest,
+                            size_t         digestSize,
+                            uint8_t const *signature,
+                            size_t         signatureSize) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("keyPath: %s", keyPath);
     if (digest) {
@@ -199,6 +243,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_verify_signature_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_VerifySignature
  *
  * This function should be called after a previous Fapi_VerifySignature_Async.
@@ -223,6 +269,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_VerifySignature_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_verify_signature_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_verify_signature_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r;
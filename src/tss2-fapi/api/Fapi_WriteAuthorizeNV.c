@@ -29,6 +29,10 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE, SAFE_FREE, return_if_error
 
+static TSS2_RC fapi_write_authorize_nv(FAPI_CONTEXT *context,
+                                       char const   *nvPath,
+                                       char const   *policyPath);
+
 /** One-Call function for Fapi_WriteAuthorizeNv
  *
  * Write the policyDigest of a policy to an NV index so it can be used in policies
@@ -68,6 +72,16 @@
  */
 TSS2_RC
 Fapi_WriteAuthorizeNv(FAPI_CONTEXT *context, char const *nvPath, char const *policyPath) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_write_authorize_nv(context, nvPath, policyPath);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_write_authorize_nv(FAPI_CONTEXT *context, char const *nvPath, char const *policyPath) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC r, r2;
@@ -115,6 +129,10 @@ Fapi_WriteAuthorizeNv(FAPI_CONTEXT *context, char const *nvPath, char const *pol
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_write_authorize_nv_async(FAPI_CONTEXT *context,
+                                             char const   *nvPath,
+                                             char const   *policyPath);
+
 /** Asynchronous function for Fapi_WriteAuthorizeNv
  *
  * Write the policyDigest of a policy to an NV index so it can be used in policies
@@ -147,6 +165,16 @@ Fapi_WriteAuthorizeNv(FAPI_CONTEXT *context, char const *nvPath, char const *pol
  */
 TSS2_RC
 Fapi_WriteAuthorizeNv_Async(FAPI_CONTEXT *context, char const *nvPath, char const *policyPath) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_write_authorize_nv_async(context, nvPath, policyPath);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_write_authorize_nv_async(FAPI_CONTEXT *context, char const *nvPath, char const *policyPath) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("nvPath: %s", nvPath);
     LOG_TRACE("policyPath: %s", policyPath);
@@ -189,6 +217,8 @@ error_cleanup:
     return r;
 }
 
+static TSS2_RC fapi_write_authorize_nv_finish(FAPI_CONTEXT *context);
+
 /** Asynchronous finish function for Fapi_WriteAuthorizeNv
  *
  * This function should be called after a previous Fapi_WriteAuthorizeNv_Async.
@@ -223,6 +253,16 @@ error_cleanup:
  */
 TSS2_RC
 Fapi_WriteAuthorizeNv_Finish(FAPI_CONTEXT *context) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_write_authorize_nv_finish(context);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_write_authorize_nv_finish(FAPI_CONTEXT *context) {
     LOG_TRACE("called for context:%p", context);
 
     TSS2_RC      r;
@@ -15,6 +15,8 @@
 #define LOGMODULE fapi
 #include "util/log.h" // for LOG_TRACE
 
+static TSS2_RC fapi_set_branch_cb(FAPI_CONTEXT *context, Fapi_CB_Branch callback, void *userData);
+
 /**
  * This function registers a callback that will be invoked whenever the FAPI has
  * to decide which branch of a Policy-OR policy to use to authorize a particular
@@ -37,6 +39,16 @@
  */
 TSS2_RC
 Fapi_SetBranchCB(FAPI_CONTEXT *context, Fapi_CB_Branch callback, void *userData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_branch_cb(context, callback, userData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_branch_cb(FAPI_CONTEXT *context, Fapi_CB_Branch callback, void *userData) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("Callback %p Userdata %p", callback, userData);
 
@@ -51,6 +63,8 @@ Fapi_SetBranchCB(FAPI_CONTEXT *context, Fapi_CB_Branch callback, void *userData)
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_set_auth_cb(FAPI_CONTEXT *context, Fapi_CB_Auth callback, void *userData);
+
 /**
  * This function registers an application-defined function as a callback to
  * allow the TSS to get authorization values from the application.
@@ -72,6 +86,16 @@ Fapi_SetBranchCB(FAPI_CONTEXT *context, Fapi_CB_Branch callback, void *userData)
  */
 TSS2_RC
 Fapi_SetAuthCB(FAPI_CONTEXT *context, Fapi_CB_Auth callback, void *userData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_auth_cb(context, callback, userData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_auth_cb(FAPI_CONTEXT *context, Fapi_CB_Auth callback, void *userData) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("Callback %p Userdata %p", callback, userData);
 
@@ -86,6 +110,8 @@ Fapi_SetAuthCB(FAPI_CONTEXT *context, Fapi_CB_Auth callback, void *userData) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_set_sign_cb(FAPI_CONTEXT *context, Fapi_CB_Sign callback, void *userData);
+
 /**
  * Fapi_SetSignCB() registers an application-defined function as a callback to
  * allow the FAPI to get signatures authorizing use of TPM objects.
@@ -107,6 +133,16 @@ Fapi_SetAuthCB(FAPI_CONTEXT *context, Fapi_CB_Auth callback, void *userData) {
  */
 TSS2_RC
 Fapi_SetSignCB(FAPI_CONTEXT *context, Fapi_CB_Sign callback, void *userData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_sign_cb(context, callback, userData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_sign_cb(FAPI_CONTEXT *context, Fapi_CB_Sign callback, void *userData) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("Callback %p Userdata %p", callback, userData);
 
@@ -121,6 +157,10 @@ Fapi_SetSignCB(FAPI_CONTEXT *context, Fapi_CB_Sign callback, void *userData) {
     return TSS2_RC_SUCCESS;
 }
 
+static TSS2_RC fapi_set_policy_action_cb(FAPI_CONTEXT        *context,
+                                         Fapi_CB_PolicyAction callback,
+                                         void                *userData);
+
 /**
  * Fapi_SetActionCB() registers an application-defined function as a callback
  * that shall be called back upon encountering a policy action element.
@@ -142,6 +182,16 @@ Fapi_SetSignCB(FAPI_CONTEXT *context, Fapi_CB_Sign callback, void *userData) {
  */
 TSS2_RC
 Fapi_SetPolicyActionCB(FAPI_CONTEXT *context, Fapi_CB_PolicyAction callback, void *userData) {
+    TSS2_RC r;
+
+    fapi_probe_entry();
+    r = fapi_set_policy_action_cb(context, callback, userData);
+    fapi_probe_exit(r);
+    return r;
+}
+
+static TSS2_RC
+fapi_set_policy_action_cb(FAPI_CONTEXT *context, Fapi_CB_PolicyAction callback, void *userData) {
     LOG_TRACE("called for context:%p", context);
     LOG_TRACE("Callback %p Userdata %p", callback, userData);
 
@@ -8,6 +8,8 @@
 
 #include <string.h> // IWYU pragma: keep
 
+#include "util/probe.h" // for TSS2_PROBE2, TSS2_PROBE3
+
 #define strdup_check(dest, str, r, label)                                                          \
     if (str) {                                                                                     \
         (dest) = strdup(str);                                                                      \
@@ -139,8 +141,17 @@
 #define statecase(VAR, STATE)                                                                      \
     case STATE:                                                                                    \
         LOG_TRACE("State " str(VAR) " reached " str(STATE));                                       \
+        TSS2_PROBE2(fapi_state, (const char *)str(VAR), (const char *)str(STATE));                 \
         (VAR) = STATE;
 
+/*
+ * Static tracepoints for the entry into and the exit from the FAPI functions.
+ * Each API function is a wrapper firing both around a static function with
+ * the actual implementation, so that every return fires fapi_exit.
+ */
+#define fapi_probe_entry() TSS2_PROBE2(fapi_entry, (const char *)__func__, context)
+#define fapi_probe_exit(r) TSS2_PROBE3(fapi_exit, (const char *)__func__, context, (r))
+
 #define general_failure(VAR)                                                                       \
     default:                                                                                       \
         LOG_ERROR("Bad state for " str(VAR));                                                      \
@@ -10,12 +10,12 @@
 #endif
 
 #include <inttypes.h> // for PRIxPTR, uint8_t, uintptr_t
-#include <string.h>   // for NULL, memcpy, size_t
+#include <string.h>   // for NULL, size_t
 
-#include "tss2_common.h"      // for TSS2_RC_SUCCESS, UINT16, UINT32, UINT64
-#include "tss2_mu.h"          // for Tss2_MU_BYTE_Marshal, Tss2_MU_BYTE_Unm...
-#include "tss2_tpm2_types.h"  // for TPM2_CC, TPM2_HANDLE, TPM2_NT, TPM2_SE
-#include "util/tss2_endian.h" // for BE_TO_HOST_16, BE_TO_HOST_32, BE_TO_HO...
+#include "base-types.h"      // for mu_BYTE_Marshal, mu_BYTE_Unmarshal, ...
+#include "tss2_common.h"     // for TSS2_RC_SUCCESS, TSS2_RC, TSS2_MU_RC_BA...
+#include "tss2_mu.h"         // for Tss2_MU_BYTE_Marshal, Tss2_MU_BYTE_Unm...
+#include "tss2_tpm2_types.h" // for TPM2_CC, TPM2_HANDLE, TPM2_NT, TPM2_SE
 
 #define LOGMODULE marshal
 #include "util/log.h" // for LOG_DEBUG, LOG_TRACE, LOG_ERROR
@@ -23,117 +23,43 @@
 #define BASE_MARSHAL(type)                                                                         \
     TSS2_RC                                                                                        \
     Tss2_MU_##type##_Marshal(type src, uint8_t buffer[], size_t buffer_size, size_t *offset) {     \
-        size_t local_offset = 0;                                                                   \
+        TSS2_RC rc;                                                                                \
                                                                                                    \
-        if (offset != NULL) {                                                                      \
-            LOG_TRACE("offset non-NULL, initial value: %zu", *offset);                             \
-            local_offset = *offset;                                                                \
-        }                                                                                          \
+        LOG_TRACE("Marshalling " #type " to buffer 0x%" PRIxPTR " at offset %zu",                  \
+                  (uintptr_t)buffer, offset ? *offset : 0);                                        \
                                                                                                    \
-        if (buffer == NULL && offset == NULL) {                                                    \
+        rc = mu_##type##_Marshal(src, buffer, buffer_size, offset);                                \
+        if (rc == TSS2_MU_RC_BAD_REFERENCE) {                                                      \
             LOG_ERROR("buffer and offset parameter are NULL");                                     \
-            return TSS2_MU_RC_BAD_REFERENCE;                                                       \
-        } else if (buffer == NULL && offset != NULL) {                                             \
-            *offset += sizeof(src);                                                                \
-            LOG_TRACE("buffer NULL and offset non-NULL, updating offset to %zu", *offset);         \
-            return TSS2_RC_SUCCESS;                                                                \
-        } else if (buffer_size < local_offset || buffer_size - local_offset < sizeof(src)) {       \
+        } else if (rc != TSS2_RC_SUCCESS) {                                                        \
             LOG_DEBUG("buffer_size: %zu with offset: %zu are insufficient for object "             \
                       "of size %zu",                                                               \
-                      buffer_size, local_offset, sizeof(src));                                     \
-            return TSS2_MU_RC_INSUFFICIENT_BUFFER;                                                 \
+                      buffer_size, offset ? *offset : 0, sizeof(src));                             \
         }                                                                                          \
                                                                                                    \
-        LOG_DEBUG("Marshalling " #type " from 0x%" PRIxPTR " to buffer 0x%" PRIxPTR                \
-                  " at index 0x%zx",                                                               \
-                  (uintptr_t) & src, (uintptr_t)buffer, local_offset);                             \
-                                                                                                   \
-        switch (sizeof(type)) {                                                                    \
-        case 1:                                                                                    \
-            break;                                                                                 \
-        case 2:                                                                                    \
-            src = (type)HOST_TO_BE_16((UINT16)src);                                                \
-            break;                                                                                 \
-        case 4:                                                                                    \
-            src = (type)HOST_TO_BE_32((UINT32)src);                                                \
-            break;                                                                                 \
-        case 8:                                                                                    \
-            src = (type)HOST_TO_BE_64((UINT64)src);                                                \
-            break;                                                                                 \
-        default:                                                                                   \
-            LOG_ERROR("Unknown size for type " #type);                                             \
-            return TSS2_MU_RC_BAD_SIZE;                                                            \
-        }                                                                                          \
-        memcpy(&buffer[local_offset], &src, sizeof(src));                                          \
-        if (offset != NULL) {                                                                      \
-            *offset = local_offset + sizeof(src);                                                  \
-            LOG_DEBUG("offset parameter non-NULL, updated to %zu", *offset);                       \
-        }                                                                                          \
-                                                                                                   \
-        return TSS2_RC_SUCCESS;                                                                    \
+        return rc;                                                                                 \
     }
 
-// NOLINTBEGIN(bugprone-macro-parentheses)
 #define BASE_UNMARSHAL(type)                                                                       \
     TSS2_RC                                                                                        \
     Tss2_MU_##type##_Unmarshal(uint8_t const buffer[], size_t buffer_size, size_t *offset,         \
                                type *dest) {                                                       \
-        size_t local_offset = 0;                                                                   \
-        type   tmp = 0;                                                                            \
+        TSS2_RC rc;                                                                                \
                                                                                                    \
-        if (offset != NULL) {                                                                      \
-            LOG_TRACE("offset non-NULL, initial value: %zu", *offset);                             \
-            local_offset = *offset;                                                                \
-        }                                                                                          \
+        LOG_TRACE("Unmarshaling " #type " from buffer 0x%" PRIxPTR " at offset %zu",               \
+                  (uintptr_t)buffer, offset ? *offset : 0);                                        \
                                                                                                    \
-        if (buffer == NULL || (dest == NULL && offset == NULL)) {                                  \
+        rc = mu_##type##_Unmarshal(buffer, buffer_size, offset, dest);                             \
+        if (rc == TSS2_MU_RC_BAD_REFERENCE) {                                                      \
             LOG_ERROR("buffer or dest and offset parameter are NULL");                             \
-            return TSS2_MU_RC_BAD_REFERENCE;                                                       \
-        }                                                                                          \
-        if (buffer_size < local_offset || sizeof(*dest) > buffer_size - local_offset) {            \
+        } else if (rc != TSS2_RC_SUCCESS) {                                                        \
             LOG_DEBUG("buffer_size: %zu with offset: %zu are insufficient for object "             \
                       "of size %zu",                                                               \
-                      buffer_size, local_offset, sizeof(*dest));                                   \
-            return TSS2_MU_RC_INSUFFICIENT_BUFFER;                                                 \
-        }                                                                                          \
-        if (dest == NULL && offset != NULL) {                                                      \
-            *offset += sizeof(type);                                                               \
-            LOG_TRACE("buffer NULL and offset non-NULL, updating offset to %zu", *offset);         \
-            return TSS2_RC_SUCCESS;                                                                \
-        }                                                                                          \
-                                                                                                   \
-        LOG_DEBUG("Unmarshaling " #type " from 0x%" PRIxPTR " to buffer 0x%" PRIxPTR               \
-                  " at index 0x%zx",                                                               \
-                  (uintptr_t)buffer, (uintptr_t)dest, local_offset);                               \
-                                                                                                   \
-        memcpy(&tmp, &buffer[local_offset], sizeof(tmp));                                          \
-                                                                                                   \
-        switch (sizeof(type)) {                                                                    \
-        case 1:                                                                                    \
-            *dest = (type)tmp;                                                                     \
-            break;                                                                                 \
-        case 2:                                                                                    \
-            *dest = (type)BE_TO_HOST_16((UINT16)tmp);                                              \
-            break;                                                                                 \
-        case 4:                                                                                    \
-            *dest = (type)BE_TO_HOST_32((UINT32)tmp);                                              \
-            break;                                                                                 \
-        case 8:                                                                                    \
-            *dest = (type)BE_TO_HOST_64((UINT64)tmp);                                              \
-            break;                                                                                 \
-        default:                                                                                   \
-            LOG_ERROR("Unknown size for type " #type);                                             \
-            return TSS2_MU_RC_BAD_SIZE;                                                            \
-        }                                                                                          \
-                                                                                                   \
-        if (offset != NULL) {                                                                      \
-            *offset = local_offset + sizeof(*dest);                                                \
-            LOG_DEBUG("offset parameter non-NULL, updated to %zu", *offset);                       \
+                      buffer_size, offset ? *offset : 0, sizeof(type));                            \
         }                                                                                          \
                                                                                                    \
-        return TSS2_RC_SUCCESS;                                                                    \
+        return rc;                                                                                 \
     }
-// NOLINTEND(bugprone-macro-parentheses)
 
 /*
  * These macros expand to (un)marshal functions for each of the base types
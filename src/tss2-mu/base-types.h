@@ -0,0 +1,84 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+#ifndef MU_BASE_TYPES_H
+#define MU_BASE_TYPES_H
+
+#include <stddef.h> // for size_t, NULL
+#include <stdint.h> // for uint8_t
+#include <string.h> // for memcpy
+
+#include "tss2_common.h"      // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_MU_RC_BA...
+#include "tss2_tpm2_types.h"  // for TPM2_CC, TPM2_HANDLE, TPM2_NT, TPM2_SE
+#include "util/tss2_endian.h" // for BE_TO_HOST_16, BE_TO_HOST_32, BE_TO_HO...
+
+/*
+ * Non-logging (un)marshal primitives for the base types. They have the exact
+ * semantics and return codes of the exported Tss2_MU_<type>_(Un)Marshal
+ * functions, which wrap them and add the logging. The structure marshalers of
+ * this library call these directly, so that a single field costs neither a
+ * call through the PLT nor the evaluation of any log statements.
+ */
+// NOLINTBEGIN(bugprone-macro-parentheses)
+#define MU_BASE_INLINE(type, int_type, to_be, to_host)                                             \
+    static inline TSS2_RC mu_##type##_Marshal(type src, uint8_t buffer[], size_t buffer_size,      \
+                                              size_t *offset) {                                    \
+        size_t   local_offset = offset ? *offset : 0;                                              \
+        int_type tmp;                                                                              \
+                                                                                                   \
+        if (buffer == NULL) {                                                                      \
+            if (offset == NULL)                                                                    \
+                return TSS2_MU_RC_BAD_REFERENCE;                                                   \
+            *offset += sizeof(src);                                                                \
+            return TSS2_RC_SUCCESS;                                                                \
+        }                                                                                          \
+        if (buffer_size < local_offset || buffer_size - local_offset < sizeof(src))                \
+            return TSS2_MU_RC_INSUFFICIENT_BUFFER;                                                 \
+                                                                                                   \
+        tmp = to_be((int_type)src);                                                                \
+        memcpy(&buffer[local_offset], &tmp, sizeof(tmp));                                          \
+        if (offset != NULL)                                                                        \
+            *offset = local_offset + sizeof(src);                                                  \
+                                                                                                   \
+        return TSS2_RC_SUCCESS;                                                                    \
+    }                                                                                              \
+                                                                                                   \
+    static inline TSS2_RC mu_##type##_Unmarshal(uint8_t const buffer[], size_t buffer_size,        \
+                                                size_t *offset, type *dest) {                      \
+        size_t   local_offset = offset ? *offset : 0;                                              \
+        int_type tmp;                                                                              \
+                                                                                                   \
+        if (buffer == NULL || (dest == NULL && offset == NULL))                                    \
+            return TSS2_MU_RC_BAD_REFERENCE;                                                       \
+        if (buffer_size < local_offset || sizeof(*dest) > buffer_size - local_offset)              \
+            return TSS2_MU_RC_INSUFFICIENT_BUFFER;                                                 \
+        if (dest == NULL) {                                                                        \
+            *offset += sizeof(type);                                                               \
+            return TSS2_RC_SUCCESS;                                                                \
+        }                                                                                          \
+                                                                                                   \
+        memcpy(&tmp, &buffer[local_offset], sizeof(tmp));                                          \
+        *dest = (type)to_host(tmp);                                                                \
+        if (offset != NULL)                                                                        \
+            *offset = local_offset + sizeof(*dest);                                                \
+                                                                                                   \
+        return TSS2_RC_SUCCESS;                                                                    \
+    }
+// NOLINTEND(bugprone-macro-parentheses)
+
+MU_BASE_INLINE(BYTE, UINT8, , )
+MU_BASE_INLINE(INT8, UINT8, , )
+MU_BASE_INLINE(INT16, UINT16, HOST_TO_BE_16, BE_TO_HOST_16)
+MU_BASE_INLINE(INT32, UINT32, HOST_TO_BE_32, BE_TO_HOST_32)
+MU_BASE_INLINE(INT64, UINT64, HOST_TO_BE_64, BE_TO_HOST_64)
+MU_BASE_INLINE(UINT8, UINT8, , )
+MU_BASE_INLINE(UINT16, UINT16, HOST_TO_BE_16, BE_TO_HOST_16)
+MU_BASE_INLINE(UINT32, UINT32, HOST_TO_BE_32, BE_TO_HOST_32)
+MU_BASE_INLINE(UINT64, UINT64, HOST_TO_BE_64, BE_TO_HOST_64)
+MU_BASE_INLINE(TPM2_CC, UINT32, HOST_TO_BE_32, BE_TO_HOST_32)
+MU_BASE_INLINE(TPM2_ST, UINT16, HOST_TO_BE_16, BE_TO_HOST_16)
+MU_BASE_INLINE(TPM2_SE, UINT8, , )
+MU_BASE_INLINE(TPM2_NT, UINT8, , )
+MU_BASE_INLINE(TPM2_HANDLE, UINT32, HOST_TO_BE_32, BE_TO_HOST_32)
+MU_BASE_INLINE(TPMI_ALG_HASH, UINT16, HOST_TO_BE_16, BE_TO_HOST_16)
+
+#endif /* MU_BASE_TYPES_H */
@@ -0,0 +1,384 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <stddef.h> // for offsetof, size_t, NULL
+#include <string.h> // for memcpy
+
+#include "fixed-types.h"      // for MU_LAYOUT, MU_FIELD, mu_layout_marshal
+#include "tss2_common.h"      // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_MU_RC_BA...
+#include "tss2_tpm2_types.h"  // for TPMS_ACT_DATA, TPMS_AC_OUTPUT, TPMS_AL...
+#include "util/tss2_endian.h" // for HOST_TO_BE_16, HOST_TO_BE_32, HOST_TO_BE_64
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))                               \
+    && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <immintrin.h> // for _mm256_shuffle_epi8, _mm_shuffle_epi8
+#define MU_SWAP_X86
+#elif defined(__ARM_NEON) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <arm_neon.h> // for vrev16q_u8, vrev32q_u8, vrev64q_u8
+#define MU_SWAP_NEON
+#endif
+
+#define TAB_SIZE(tab) (sizeof(tab) / sizeof((tab)[0]))
+
+#define FIELD(type, member) { offsetof(type, member), sizeof(((type *)NULL)->member) }
+
+#define LAYOUT(type, ...)                                                                          \
+    static const MU_FIELD type##_fields[] = { __VA_ARGS__ };                                       \
+    const MU_LAYOUT       mu_layout_##type                                                         \
+        = { type##_fields, TAB_SIZE(type##_fields), sizeof(type) }
+
+#define LAYOUT_BASE(type)                                                                          \
+    static const MU_FIELD type##_fields[] = { { 0, sizeof(type) } };                               \
+    const MU_LAYOUT       mu_layout_##type = { type##_fields, 1, sizeof(type) }
+
+/*
+ * The layouts of the structures in the specification part 2 that only
+ * consist of integers. Nested structures are flattened into their fields.
+ */
+LAYOUT_BASE(UINT16);
+LAYOUT_BASE(UINT32);
+
+LAYOUT(TPMS_ALG_PROPERTY, FIELD(TPMS_ALG_PROPERTY, alg), FIELD(TPMS_ALG_PROPERTY, algProperties));
+
+LAYOUT(TPMS_TAGGED_PROPERTY,
+       FIELD(TPMS_TAGGED_PROPERTY, property),
+       FIELD(TPMS_TAGGED_PROPERTY, value));
+
+LAYOUT(TPMS_CLOCK_INFO,
+       FIELD(TPMS_CLOCK_INFO, clock),
+       FIELD(TPMS_CLOCK_INFO, resetCount),
+       FIELD(TPMS_CLOCK_INFO, restartCount),
+       FIELD(TPMS_CLOCK_INFO, safe));
+
+LAYOUT(TPMS_TIME_INFO,
+       FIELD(TPMS_TIME_INFO, time),
+       FIELD(TPMS_TIME_INFO, clockInfo.clock),
+       FIELD(TPMS_TIME_INFO, clockInfo.resetCount),
+       FIELD(TPMS_TIME_INFO, clockInfo.restartCount),
+       FIELD(TPMS_TIME_INFO, clockInfo.safe));
+
+LAYOUT(TPMS_TIME_ATTEST_INFO,
+       FIELD(TPMS_TIME_ATTEST_INFO, time.time),
+       FIELD(TPMS_TIME_ATTEST_INFO, time.clockInfo.clock),
+       FIELD(TPMS_TIME_ATTEST_INFO, time.clockInfo.resetCount),
+       FIELD(TPMS_TIME_ATTEST_INFO, time.clockInfo.restartCount),
+       FIELD(TPMS_TIME_ATTEST_INFO, time.clockInfo.safe),
+       FIELD(TPMS_TIME_ATTEST_INFO, firmwareVersion));
+
+LAYOUT(TPMS_SCHEME_ECDAA, FIELD(TPMS_SCHEME_ECDAA, hashAlg), FIELD(TPMS_SCHEME_ECDAA, count));
+
+LAYOUT(TPMS_SCHEME_XOR, FIELD(TPMS_SCHEME_XOR, hashAlg), FIELD(TPMS_SCHEME_XOR, kdf));
+
+LAYOUT(TPMS_NV_PIN_COUNTER_PARAMETERS,
+       FIELD(TPMS_NV_PIN_COUNTER_PARAMETERS, pinCount),
+       FIELD(TPMS_NV_PIN_COUNTER_PARAMETERS, pinLimit));
+
+LAYOUT(TPMS_AC_OUTPUT, FIELD(TPMS_AC_OUTPUT, tag), FIELD(TPMS_AC_OUTPUT, data));
+
+LAYOUT(TPMS_ACT_DATA,
+       FIELD(TPMS_ACT_DATA, handle),
+       FIELD(TPMS_ACT_DATA, timeout),
+       FIELD(TPMS_ACT_DATA, attributes));
+
+#if defined(MU_SWAP_X86)
+/* pshufb masks reversing the bytes of each 2, 4 and 8 byte integer */
+static const uint8_t swap_masks[3][32] = {
+    { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+      1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+    { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+    { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 },
+};
+
+__attribute__((target("avx2"))) static size_t
+swap_avx2(uint8_t *dst, uint8_t const *src, const uint8_t *mask, size_t bytes) {
+    __m256i m = _mm256_loadu_si256((const __m256i *)mask);
+    size_t  i;
+
+    for (i = 0; i + sizeof(__m256i) <= bytes; i += sizeof(__m256i)) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)&src[i]);
+        _mm256_storeu_si256((__m256i *)&dst[i], _mm256_shuffle_epi8(v, m));
+    }
+    return i;
+}
+
+__attribute__((target("ssse3"))) static size_t
+swap_ssse3(uint8_t *dst, uint8_t const *src, const uint8_t *mask, size_t bytes) {
+    __m128i m = _mm_loadu_si128((const __m128i *)mask);
+    size_t  i;
+
+    for (i = 0; i + sizeof(__m128i) <= bytes; i += sizeof(__m128i)) {
+        __m128i v = _mm_loadu_si128((const __m128i *)&src[i]);
+        _mm_storeu_si128((__m128i *)&dst[i], _mm_shuffle_epi8(v, m));
+    }
+    return i;
+}
+#endif /* MU_SWAP_X86 */
+
+/*
+ * Convert the leading full vectors of an array of 2, 4 or 8 byte integers
+ * with the widest instructions available on this CPU. Returns the number of
+ * bytes converted, the rest is left to the scalar loop.
+ */
+static size_t
+swap_vectors(uint8_t *dst, uint8_t const *src, size_t size, size_t bytes) {
+#if defined(MU_SWAP_X86)
+    const uint8_t *mask = swap_masks[size == 2 ? 0 : size == 4 ? 1 : 2];
+
+    if (__builtin_cpu_supports("avx2"))
+        return swap_avx2(dst, src, mask, bytes);
+    if (__builtin_cpu_supports("ssse3"))
+        return swap_ssse3(dst, src, mask, bytes);
+    return 0;
+#elif defined(MU_SWAP_NEON)
+    size_t i;
+
+    for (i = 0; i + 16 <= bytes; i += 16) {
+        uint8x16_t v = vld1q_u8(&src[i]);
+        v = size == 2 ? vrev16q_u8(v) : size == 4 ? vrev32q_u8(v) : vrev64q_u8(v);
+        vst1q_u8(&dst[i], v);
+    }
+    return i;
+#else
+    (void)dst;
+    (void)src;
+    (void)size;
+    (void)bytes;
+    return 0;
+#endif
+}
+
+/*
+ * Copy count integers of the given size, converting between host and big
+ * endian byte order. The conversion is its own inverse, so this serves both
+ * directions. Arrays are converted with SIMD instructions where available
+ * and one scalar loop per integer size for the remainder.
+ */
+static void
+copy_swapped(uint8_t *dst, uint8_t const *src, size_t size, size_t count) {
+    UINT16 v16;
+    UINT32 v32;
+    UINT64 v64;
+    size_t i, done;
+
+    if (size > 1 && count > 1) {
+        done = swap_vectors(dst, src, size, size * count);
+        dst += done;
+        src += done;
+        count -= done / size;
+    }
+
+    switch (size) {
+    case 1:
+        memcpy(dst, src, count);
+        break;
+    case 2:
+        for (i = 0; i < count; i++) {
+            memcpy(&v16, &src[i * sizeof(v16)], sizeof(v16));
+            v16 = HOST_TO_BE_16(v16);
+            memcpy(&dst[i * sizeof(v16)], &v16, sizeof(v16));
+        }
+        break;
+    case 4:
+        for (i = 0; i < count; i++) {
+            memcpy(&v32, &src[i * sizeof(v32)], sizeof(v32));
+            v32 = HOST_TO_BE_32(v32);
+            memcpy(&dst[i * sizeof(v32)], &v32, sizeof(v32));
+        }
+        break;
+    case 8:
+        for (i = 0; i < count; i++) {
+            memcpy(&v64, &src[i * sizeof(v64)], sizeof(v64));
+            v64 = HOST_TO_BE_64(v64);
+            memcpy(&dst[i * sizeof(v64)], &v64, sizeof(v64));
+        }
+        break;
+    }
+}
+
+/* Copy a single integer, see copy_swapped */
+static inline void
+copy_one(uint8_t *dst, uint8_t const *src, size_t size) {
+    UINT16 v16;
+    UINT32 v32;
+    UINT64 v64;
+
+    switch (size) {
+    case 1:
+        *dst = *src;
+        break;
+    case 2:
+        memcpy(&v16, src, sizeof(v16));
+        v16 = HOST_TO_BE_16(v16);
+        memcpy(dst, &v16, sizeof(v16));
+        break;
+    case 4:
+        memcpy(&v32, src, sizeof(v32));
+        v32 = HOST_TO_BE_32(v32);
+        memcpy(dst, &v32, sizeof(v32));
+        break;
+    case 8:
+        memcpy(&v64, src, sizeof(v64));
+        v64 = HOST_TO_BE_64(v64);
+        memcpy(dst, &v64, sizeof(v64));
+        break;
+    }
+}
+
+/*
+ * Copy one field of count structures, converting the byte order like
+ * copy_swapped. The structures are dst_stride and src_stride bytes apart.
+ * Going through one field of all structures at a time keeps the field in
+ * registers; the byte stores could alias the layout otherwise.
+ */
+static void
+copy_field(uint8_t       *dst,
+           size_t         dst_stride,
+           uint8_t const *src,
+           size_t         src_stride,
+           size_t         size,
+           size_t         count) {
+    size_t i;
+
+    switch (size) {
+    case 1:
+        for (i = 0; i < count; i++)
+            copy_one(&dst[i * dst_stride], &src[i * src_stride], 1);
+        break;
+    case 2:
+        for (i = 0; i < count; i++)
+            copy_one(&dst[i * dst_stride], &src[i * src_stride], 2);
+        break;
+    case 4:
+        for (i = 0; i < count; i++)
+            copy_one(&dst[i * dst_stride], &src[i * src_stride], 4);
+        break;
+    case 8:
+        for (i = 0; i < count; i++)
+            copy_one(&dst[i * dst_stride], &src[i * src_stride], 8);
+        break;
+    }
+}
+
+static size_t
+wire_size(const MU_LAYOUT *layout, size_t count) {
+    size_t size = 0;
+    UINT8  i;
+
+    for (i = 0; i < layout->num_fields; i++)
+        size += layout->fields[i].size;
+
+    return size * count;
+}
+
+/* A layout of a single integer is an array on the wire as well as in memory */
+static int
+is_array(const MU_LAYOUT *layout) {
+    return layout->num_fields == 1 && layout->fields[0].size == layout->host_size;
+}
+
+/*
+ * Marshal count structures of the given layout stored back to back at src.
+ * NULL buffer and offset parameters are treated as for the base types.
+ */
+TSS2_RC
+mu_layout_marshal(const MU_LAYOUT *layout,
+                  void const      *src,
+                  size_t           count,
+                  uint8_t          buffer[],
+                  size_t           buffer_size,
+                  size_t          *offset) {
+    uint8_t const *host = src;
+    size_t         local_offset = offset ? *offset : 0;
+    size_t         stride = wire_size(layout, 1);
+    size_t         size = stride * count;
+    size_t         field_offset = 0;
+    UINT8          j;
+
+    if (buffer == NULL) {
+        if (offset == NULL)
+            return TSS2_MU_RC_BAD_REFERENCE;
+        *offset += size;
+        return TSS2_RC_SUCCESS;
+    }
+    if (buffer_size < local_offset || buffer_size - local_offset < size)
+        return TSS2_MU_RC_INSUFFICIENT_BUFFER;
+
+    if (is_array(layout)) {
+        copy_swapped(&buffer[local_offset], host, layout->host_size, count);
+        local_offset += size;
+    } else {
+        for (j = 0; j < layout->num_fields; j++) {
+            if (count == 1)
+                copy_one(&buffer[local_offset + field_offset], &host[layout->fields[j].offset],
+                         layout->fields[j].size);
+            else
+                copy_field(&buffer[local_offset + field_offset], stride,
+                           &host[layout->fields[j].offset], layout->host_size,
+                           layout->fields[j].size, count);
+            field_offset += layout->fields[j].size;
+        }
+        local_offset += size;
+    }
+
+    if (offset != NULL)
+        *offset = local_offset;
+
+    return TSS2_RC_SUCCESS;
+}
+
+/*
+ * Unmarshal count structures of the given layout to dest. If dest is NULL
+ * the structures are only skipped. Padding in dest is left untouched.
+ */
+TSS2_RC
+mu_layout_unmarshal(const MU_LAYOUT *layout,
+                    uint8_t const    buffer[],
+                    size_t           buffer_size,
+                    size_t          *offset,
+                    void            *dest,
+                    size_t           count) {
+    uint8_t *host = dest;
+    size_t   local_offset = offset ? *offset : 0;
+    size_t   stride = wire_size(layout, 1);
+    size_t   size = stride * count;
+    size_t   field_offset = 0;
+    UINT8    j;
+
+    if (buffer == NULL || (dest == NULL && offset == NULL))
+        return TSS2_MU_RC_BAD_REFERENCE;
+    if (buffer_size < local_offset || buffer_size - local_offset < size)
+        return TSS2_MU_RC_INSUFFICIENT_BUFFER;
+
+    if (dest == NULL) {
+        *offset += size;
+        return TSS2_RC_SUCCESS;
+    }
+
+    if (is_array(layout)) {
+        copy_swapped(host, &buffer[local_offset], layout->host_size, count);
+        local_offset += size;
+    } else {
+        for (j = 0; j < layout->num_fields; j++) {
+            if (count == 1)
+                copy_one(&host[layout->fields[j].offset], &buffer[local_offset + field_offset],
+                         layout->fields[j].size);
+            else
+                copy_field(&host[layout->fields[j].offset], layout->host_size,
+                           &buffer[local_offset + field_offset], stride,
+                           layout->fields[j].size, count);
+            field_offset += layout->fields[j].size;
+        }
+        local_offset += size;
+    }
+
+    if (offset != NULL)
+        *offset = local_offset;
+
+    return TSS2_RC_SUCCESS;
+}
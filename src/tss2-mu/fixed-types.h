@@ -0,0 +1,57 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+#ifndef MU_FIXED_TYPES_H
+#define MU_FIXED_TYPES_H
+
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint8_t
+
+#include "tss2_common.h" // for TSS2_RC, UINT16, UINT8
+
+/*
+ * Layout of a TPM structure that consists only of integer fields (including
+ * nested structures of such fields). Structures with such a layout and lists
+ * of them are (un)marshaled by a single interpreter, which checks the buffer
+ * once for the whole run instead of once per field.
+ */
+typedef struct {
+    UINT16 offset; /* offsetof() the field in the host structure */
+    UINT8  size;   /* 1, 2, 4 or 8 byte big endian integer on the wire */
+} MU_FIELD;
+
+typedef struct {
+    const MU_FIELD *fields;
+    UINT8           num_fields;
+    UINT16          host_size; /* sizeof() the host structure */
+} MU_LAYOUT;
+
+extern const MU_LAYOUT mu_layout_UINT16;
+extern const MU_LAYOUT mu_layout_UINT32;
+extern const MU_LAYOUT mu_layout_TPMS_ALG_PROPERTY;
+extern const MU_LAYOUT mu_layout_TPMS_TAGGED_PROPERTY;
+extern const MU_LAYOUT mu_layout_TPMS_CLOCK_INFO;
+extern const MU_LAYOUT mu_layout_TPMS_TIME_INFO;
+extern const MU_LAYOUT mu_layout_TPMS_TIME_ATTEST_INFO;
+extern const MU_LAYOUT mu_layout_TPMS_SCHEME_ECDAA;
+extern const MU_LAYOUT mu_layout_TPMS_SCHEME_XOR;
+extern const MU_LAYOUT mu_layout_TPMS_NV_PIN_COUNTER_PARAMETERS;
+extern const MU_LAYOUT mu_layout_TPMS_AC_OUTPUT;
+extern const MU_LAYOUT mu_layout_TPMS_ACT_DATA;
+
+TSS2_RC
+mu_layout_marshal(const MU_LAYOUT *layout,
+                  void const      *src,
+                  size_t           count,
+                  uint8_t          buffer[],
+                  size_t           buffer_size,
+                  size_t          *offset);
+
+TSS2_RC
+mu_layout_unmarshal(const MU_LAYOUT *layout,
+                    uint8_t const    buffer[],
+                    size_t           buffer_size,
+                    size_t          *offset,
+                    void            *dest,
+                    size_t           count);
+
+#endif /* MU_FIXED_TYPES_H */
@@ -12,6 +12,7 @@
 #include <inttypes.h> // for PRIxPTR, uintptr_t, uint8_t
 #include <string.h>   // for NULL, size_t, memcpy
 
+#include "base-types.h"       // for mu_UINT16_Marshal, mu_UINT16_Unmarshal
 #include "tss2_common.h"      // for UINT16, TSS2_MU_RC_INSUFFICIENT_BUFFER
 #include "tss2_mu.h"          // for Tss2_MU_UINT16_Marshal, Tss2_MU_UINT16...
 #include "tss2_tpm2_types.h"  // for TPM2B_ATTEST, TPM2B_AUTH, TPM2B_CONTEX...
@@ -59,7 +60,7 @@
                   " at index 0x%zx, buffer size %zu, object size %u",                              \
                   (uintptr_t) & src, (uintptr_t)buffer, local_offset, buffer_size, src->size);     \
                                                                                                    \
-        rc = Tss2_MU_UINT16_Marshal(src->size, buffer, buffer_size, &local_offset);                \
+        rc = mu_UINT16_Marshal(src->size, buffer, buffer_size, &local_offset);                     \
         if (rc)                                                                                    \
             return rc;                                                                             \
                                                                                                    \
@@ -99,7 +100,7 @@
             return TSS2_MU_RC_INSUFFICIENT_BUFFER;                                                 \
         }                                                                                          \
                                                                                                    \
-        rc = Tss2_MU_UINT16_Unmarshal(buffer, buffer_size, &local_offset, &size);                  \
+        rc = mu_UINT16_Unmarshal(buffer, buffer_size, &local_offset, &size);                       \
         if (rc)                                                                                    \
             return rc;                                                                             \
                                                                                                    \
@@ -167,7 +168,7 @@
                   " at index 0x%zx, buffer size %zu, object size %u",                              \
                   (uintptr_t) & src, (uintptr_t)buffer, local_offset, buffer_size, src->size);     \
                                                                                                    \
-        rc = Tss2_MU_UINT16_Marshal(src->size, buffer, buffer_size, &local_offset);                \
+        rc = mu_UINT16_Marshal(src->size, buffer, buffer_size, &local_offset);                     \
         if (rc)                                                                                    \
             return rc;                                                                             \
                                                                                                    \
@@ -212,7 +213,7 @@
             return TSS2_MU_RC_INSUFFICIENT_BUFFER;                                                 \
         }                                                                                          \
                                                                                                    \
-        rc = Tss2_MU_UINT16_Unmarshal(buffer, buffer_size, &local_offset, &size);                  \
+        rc = mu_UINT16_Unmarshal(buffer, buffer_size, &local_offset, &size);                       \
         if (rc)                                                                                    \
             return rc;                                                                             \
         LOG_DEBUG("Unmarshaling " #type " from 0x%" PRIxPTR " to buffer 0x%" PRIxPTR               \
@@ -249,6 +250,55 @@
     }
 // NOLINTEND(bugprone-macro-parentheses)
 
+/*
+ * Unmarshal a TPM2B without copying its payload: data points into the
+ * unmarshaled buffer and is only valid as long as that buffer is.
+ */
+#define TPM2B_UNMARSHAL_VIEW(type, buf_name)                                                       \
+    TSS2_RC Tss2_MU_##type##_UnmarshalView(uint8_t const buffer[], size_t buffer_size,             \
+                                           size_t *offset, uint8_t const **data,                   \
+                                           UINT16 *data_size) {                                    \
+        size_t  local_offset = 0;                                                                  \
+        UINT16  size = 0;                                                                          \
+        TSS2_RC rc;                                                                                \
+                                                                                                   \
+        if (offset != NULL) {                                                                      \
+            local_offset = *offset;                                                                \
+        }                                                                                          \
+                                                                                                   \
+        if (buffer == NULL || ((data == NULL || data_size == NULL) && offset == NULL)) {           \
+            LOG_WARNING("buffer or data and offset parameter are NULL");                           \
+            return TSS2_MU_RC_BAD_REFERENCE;                                                       \
+        }                                                                                          \
+                                                                                                   \
+        rc = mu_UINT16_Unmarshal(buffer, buffer_size, &local_offset, &size);                       \
+        if (rc)                                                                                    \
+            return rc;                                                                             \
+                                                                                                   \
+        if (size > buffer_size - local_offset) {                                                   \
+            LOG_DEBUG("buffer_size: %zu with offset: %zu are insufficient for object "             \
+                      "of size %zu",                                                               \
+                      buffer_size, local_offset, (size_t)size);                                    \
+            return TSS2_MU_RC_INSUFFICIENT_BUFFER;                                                 \
+        }                                                                                          \
+        if (sizeof(((type *)NULL)->buf_name) < size) {                                             \
+            LOG_DEBUG("The " #type " size of %zu is too small to view %d bytes",                   \
+                      sizeof(((type *)NULL)->buf_name), size);                                     \
+            return TSS2_MU_RC_INSUFFICIENT_BUFFER;                                                 \
+        }                                                                                          \
+                                                                                                   \
+        if (data != NULL)                                                                          \
+            *data = &buffer[local_offset];                                                         \
+        if (data_size != NULL)                                                                     \
+            *data_size = size;                                                                     \
+        local_offset += size;                                                                      \
+        if (offset != NULL) {                                                                      \
+            *offset = local_offset;                                                                \
+        }                                                                                          \
+                                                                                                   \
+        return TSS2_RC_SUCCESS;                                                                    \
+    }
+
 /*
  * These macros expand to (un)marshal functions for each of the TPM2B types
  * the specification part 2.
@@ -315,3 +365,12 @@ TPM2B_MARSHAL_SUBTYPE(TPM2B_CREATION_DATA, TPMS_CREATION_DATA, creationData);
 TPM2B_UNMARSHAL_SUBTYPE(TPM2B_CREATION_DATA, TPMS_CREATION_DATA, creationData);
 TPM2B_MARSHAL_SUBTYPE(TPM2B_PUBLIC, TPMT_PUBLIC, publicArea);
 TPM2B_UNMARSHAL_SUBTYPE(TPM2B_PUBLIC, TPMT_PUBLIC, publicArea);
+
+/*
+ * View variants for the bulk data types that are typically returned by
+ * NV_Read, EncryptDecrypt(2), Unseal and the key creation commands.
+ */
+TPM2B_UNMARSHAL_VIEW(TPM2B_MAX_BUFFER, buffer);
+TPM2B_UNMARSHAL_VIEW(TPM2B_MAX_NV_BUFFER, buffer);
+TPM2B_UNMARSHAL_VIEW(TPM2B_SENSITIVE_DATA, buffer);
+TPM2B_UNMARSHAL_VIEW(TPM2B_PRIVATE, buffer);
@@ -4,9 +4,16 @@
  *
  * All rights reserved.
  ***********************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
 #include <inttypes.h> // for PRIxPTR, uintptr_t, uint8_t, PRIu8
 #include <string.h>   // for size_t, NULL, memset
 
+#include "base-types.h"      // for mu_UINT32_Marshal, mu_UINT32_Unmarshal
+#include "fixed-types.h"     // for mu_layout_marshal, mu_layout_unmarshal
 #include "tss2_common.h"     // for TSS2_RC_SUCCESS, TSS2_RC, TSS2_MU_RC_BA...
 #include "tss2_mu.h"         // for Tss2_MU_UINT32_Marshal, Tss2_MU_UINT32_...
 #include "tss2_tpm2_types.h" // for TPMS_ALGORITHM_DETAIL_ECC, TPMS_PCR_SEL...
@@ -25,7 +32,7 @@ TPM2_GENERATED_Unmarshal(uint8_t const   buffer[],
                          size_t         *offset,
                          TPM2_GENERATED *magic) {
     TPM2_GENERATED mymagic = 0;
-    TSS2_RC        rc = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset, &mymagic);
+    TSS2_RC        rc = mu_UINT32_Unmarshal(buffer, buffer_size, offset, &mymagic);
     if (rc != TSS2_RC_SUCCESS) {
         return rc;
     }
@@ -71,12 +78,12 @@ TPM2_GENERATED_Unmarshal(uint8_t const   buffer[],
         if (ret != TSS2_RC_SUCCESS)                                                                \
             return ret;                                                                            \
                                                                                                    \
-        ret = Tss2_MU_UINT8_Marshal(src->sizeofSelect, buffer, buffer_size, &local_offset);        \
+        ret = mu_UINT8_Marshal(src->sizeofSelect, buffer, buffer_size, &local_offset);             \
         if (ret != TSS2_RC_SUCCESS)                                                                \
             return ret;                                                                            \
                                                                                                    \
         for (i = 0; i < src->sizeofSelect; i++) {                                                  \
-            ret = Tss2_MU_BYTE_Marshal(src->pcrSelect[i], buffer, buffer_size, &local_offset);     \
+            ret = mu_BYTE_Marshal(src->pcrSelect[i], buffer, buffer_size, &local_offset);          \
             if (ret != TSS2_RC_SUCCESS)                                                            \
                 return ret;                                                                        \
         }                                                                                          \
@@ -91,10 +98,10 @@ TPM2_GENERATED_Unmarshal(uint8_t const   buffer[],
 TPMS_PCR_MARSHAL(TPMS_PCR_SELECT, TSS2_RC_SUCCESS)
 
 TPMS_PCR_MARSHAL(TPMS_PCR_SELECTION,
-                 Tss2_MU_TPMI_ALG_HASH_Marshal(src->hash, buffer, buffer_size, &local_offset))
+                 mu_TPMI_ALG_HASH_Marshal(src->hash, buffer, buffer_size, &local_offset))
 
 TPMS_PCR_MARSHAL(TPMS_TAGGED_PCR_SELECT,
-                 Tss2_MU_UINT32_Marshal(src->tag, buffer, buffer_size, &local_offset))
+                 mu_UINT32_Marshal(src->tag, buffer, buffer_size, &local_offset))
 
 // NOLINTBEGIN(bugprone-macro-parentheses)
 #define TPMS_PCR_UNMARSHAL(type, firstFieldUnmarshal)                                              \
@@ -104,7 +111,7 @@ TPMS_PCR_MARSHAL(TPMS_TAGGED_PCR_SELECT,
         TSS2_RC ret = TSS2_RC_SUCCESS;                                                             \
         size_t  local_offset = 0;                                                                  \
         size_t  i;                                                                                 \
-        UINT8   tmp;                                                                               \
+        UINT8   tmp = 0;                                                                           \
                                                                                                    \
         LOG_DEBUG("Unmarshaling " #type " from 0x%" PRIxPTR " to buffer 0x%" PRIxPTR               \
                   " at index 0x%zx",                                                               \
@@ -123,8 +130,8 @@ TPMS_PCR_MARSHAL(TPMS_TAGGED_PCR_SELECT,
         if (ret != TSS2_RC_SUCCESS)                                                                \
             return ret;                                                                            \
                                                                                                    \
-        ret = Tss2_MU_UINT8_Unmarshal(buffer, buffer_size, &local_offset,                          \
-                                      dest ? &dest->sizeofSelect : &tmp);                          \
+        ret = mu_UINT8_Unmarshal(buffer, buffer_size, &local_offset,                               \
+                                 dest ? &dest->sizeofSelect : &tmp);                               \
         if (ret)                                                                                   \
             return ret;                                                                            \
                                                                                                    \
@@ -135,8 +142,8 @@ TPMS_PCR_MARSHAL(TPMS_TAGGED_PCR_SELECT,
         }                                                                                          \
                                                                                                    \
         for (i = 0; i < (dest ? dest->sizeofSelect : tmp); i++) {                                  \
-            ret = Tss2_MU_UINT8_Unmarshal(buffer, buffer_size, &local_offset,                      \
-                                          dest ? &dest->pcrSelect[i] : NULL);                      \
+            ret = mu_UINT8_Unmarshal(buffer, buffer_size, &local_offset,                           \
+                                     dest ? &dest->pcrSelect[i] : NULL);                           \
             if (ret != TSS2_RC_SUCCESS)                                                            \
                 return ret;                                                                        \
         }                                                                                          \
@@ -153,11 +160,11 @@ TPMS_PCR_UNMARSHAL(TPMS_PCR_SELECT, TSS2_RC_SUCCESS)
 
 TPMS_PCR_UNMARSHAL(
     TPMS_PCR_SELECTION,
-    Tss2_MU_TPMI_ALG_HASH_Unmarshal(buffer, buffer_size, &local_offset, dest ? &dest->hash : NULL))
+    mu_TPMI_ALG_HASH_Unmarshal(buffer, buffer_size, &local_offset, dest ? &dest->hash : NULL))
 
 TPMS_PCR_UNMARSHAL(
     TPMS_TAGGED_PCR_SELECT,
-    Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, &local_offset, dest ? &dest->tag : NULL))
+    mu_UINT32_Unmarshal(buffer, buffer_size, &local_offset, dest ? &dest->tag : NULL))
 
 #define TPMS_MARSHAL_0(type)                                                                       \
     TSS2_RC Tss2_MU_##type##_Marshal(type const *src, uint8_t buffer[], size_t buffer_size,        \
@@ -198,6 +205,38 @@ TPMS_PCR_UNMARSHAL(
     }
 // NOLINTEND(bugprone-macro-parentheses)
 
+/*
+ * Structures that only consist of integers are (un)marshaled in one pass
+ * from their layout in fixed-types.c.
+ */
+#define TPMS_MARSHAL_FIXED(type)                                                                   \
+    TSS2_RC Tss2_MU_##type##_Marshal(type const *src, uint8_t buffer[], size_t buffer_size,        \
+                                     size_t *offset) {                                             \
+        if (!src) {                                                                                \
+            LOG_WARNING("src param is NULL");                                                      \
+            return TSS2_MU_RC_BAD_REFERENCE;                                                       \
+        }                                                                                          \
+                                                                                                   \
+        LOG_DEBUG("Marshalling " #type " from 0x%" PRIxPTR " to buffer 0x%" PRIxPTR                \
+                  " at index 0x%zx",                                                               \
+                  (uintptr_t)src, (uintptr_t)buffer, offset ? *offset : 0xffff);                   \
+                                                                                                   \
+        return mu_layout_marshal(&mu_layout_##type, src, 1, buffer, buffer_size, offset);          \
+    }
+
+#define TPMS_UNMARSHAL_FIXED(type)                                                                 \
+    TSS2_RC Tss2_MU_##type##_Unmarshal(uint8_t const buffer[], size_t buffer_size, size_t *offset, \
+                                       type *dest) {                                               \
+        LOG_DEBUG("Unmarshaling " #type " from 0x%" PRIxPTR " to buffer 0x%" PRIxPTR               \
+                  " at index 0x%zx",                                                               \
+                  (uintptr_t)dest, (uintptr_t)buffer, offset ? *offset : 0xffff);                  \
+                                                                                                   \
+        if (dest)                                                                                  \
+            memset(dest, 0, sizeof(*dest));                                                        \
+                                                                                                   \
+        return mu_layout_unmarshal(&mu_layout_##type, buffer, buffer_size, offset, dest, 1);       \
+    }
+
 #define TPMS_MARSHAL_1(type, m, op, fn)                                                            \
     TSS2_RC Tss2_MU_##type##_Marshal(type const *src, uint8_t buffer[], size_t buffer_size,        \
                                      size_t *offset) {                                             \
@@ -965,99 +1004,39 @@ TPMS_PCR_UNMARSHAL(
  * These macros expand to (un)marshal functions for each of the TPMS types
  * the specification part 2.
  */
-TPMS_MARSHAL_2(TPMS_ALG_PROPERTY,
-               alg,
-               VAL,
-               Tss2_MU_UINT16_Marshal,
-               algProperties,
-               VAL,
-               Tss2_MU_TPMA_ALGORITHM_Marshal)
+TPMS_MARSHAL_FIXED(TPMS_ALG_PROPERTY)
 
-TPMS_UNMARSHAL_2(TPMS_ALG_PROPERTY,
-                 alg,
-                 Tss2_MU_UINT16_Unmarshal,
-                 algProperties,
-                 Tss2_MU_TPMA_ALGORITHM_Unmarshal)
+TPMS_UNMARSHAL_FIXED(TPMS_ALG_PROPERTY)
 
-TPMS_MARSHAL_2(TPMS_TAGGED_PROPERTY,
-               property,
-               VAL,
-               Tss2_MU_UINT32_Marshal,
-               value,
-               VAL,
-               Tss2_MU_UINT32_Marshal)
+TPMS_MARSHAL_FIXED(TPMS_TAGGED_PROPERTY)
 
-TPMS_UNMARSHAL_2(TPMS_TAGGED_PROPERTY,
-                 property,
-                 Tss2_MU_UINT32_Unmarshal,
-                 value,
-                 Tss2_MU_UINT32_Unmarshal)
+TPMS_UNMARSHAL_FIXED(TPMS_TAGGED_PROPERTY)
 
 TPMS_MARSHAL_2(TPMS_TAGGED_POLICY,
                handle,
                VAL,
-               Tss2_MU_UINT32_Marshal,
+               mu_UINT32_Marshal,
                policyHash,
                ADDR,
                Tss2_MU_TPMT_HA_Marshal)
 
 TPMS_UNMARSHAL_2(TPMS_TAGGED_POLICY,
                  handle,
-                 Tss2_MU_UINT32_Unmarshal,
+                 mu_UINT32_Unmarshal,
                  policyHash,
                  Tss2_MU_TPMT_HA_Unmarshal)
 
-TPMS_MARSHAL_4(TPMS_CLOCK_INFO,
-               clock,
-               VAL,
-               Tss2_MU_UINT64_Marshal,
-               resetCount,
-               VAL,
-               Tss2_MU_UINT32_Marshal,
-               restartCount,
-               VAL,
-               Tss2_MU_UINT32_Marshal,
-               safe,
-               VAL,
-               Tss2_MU_UINT8_Marshal)
-
-TPMS_UNMARSHAL_4(TPMS_CLOCK_INFO,
-                 clock,
-                 Tss2_MU_UINT64_Unmarshal,
-                 resetCount,
-                 Tss2_MU_UINT32_Unmarshal,
-                 restartCount,
-                 Tss2_MU_UINT32_Unmarshal,
-                 safe,
-                 Tss2_MU_UINT8_Unmarshal)
-
-TPMS_MARSHAL_2(TPMS_TIME_INFO,
-               time,
-               VAL,
-               Tss2_MU_UINT64_Marshal,
-               clockInfo,
-               ADDR,
-               Tss2_MU_TPMS_CLOCK_INFO_Marshal)
+TPMS_MARSHAL_FIXED(TPMS_CLOCK_INFO)
 
-TPMS_UNMARSHAL_2(TPMS_TIME_INFO,
-                 time,
-                 Tss2_MU_UINT64_Unmarshal,
-                 clockInfo,
-                 Tss2_MU_TPMS_CLOCK_INFO_Unmarshal)
+TPMS_UNMARSHAL_FIXED(TPMS_CLOCK_INFO)
 
-TPMS_MARSHAL_2(TPMS_TIME_ATTEST_INFO,
-               time,
-               ADDR,
-               Tss2_MU_TPMS_TIME_INFO_Marshal,
-               firmwareVersion,
-               VAL,
-               Tss2_MU_UINT64_Marshal)
+TPMS_MARSHAL_FIXED(TPMS_TIME_INFO)
 
-TPMS_UNMARSHAL_2(TPMS_TIME_ATTEST_INFO,
-                 time,
-                 Tss2_MU_TPMS_TIME_INFO_Unmarshal,
-                 firmwareVersion,
-                 Tss2_MU_UINT64_Unmarshal)
+TPMS_UNMARSHAL_FIXED(TPMS_TIME_INFO)
+
+TPMS_MARSHAL_FIXED(TPMS_TIME_ATTEST_INFO)
+
+TPMS_UNMARSHAL_FIXED(TPMS_TIME_ATTEST_INFO)
 
 TPMS_MARSHAL_2(TPMS_CERTIFY_INFO,
                name,
@@ -1076,10 +1055,10 @@ TPMS_UNMARSHAL_2(TPMS_CERTIFY_INFO,
 TPMS_MARSHAL_4(TPMS_COMMAND_AUDIT_INFO,
                auditCounter,
                VAL,
-               Tss2_MU_UINT64_Marshal,
+               mu_UINT64_Marshal,
                digestAlg,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                auditDigest,
                ADDR,
                Tss2_MU_TPM2B_DIGEST_Marshal,
@@ -1089,9 +1068,9 @@ TPMS_MARSHAL_4(TPMS_COMMAND_AUDIT_INFO,
 
 TPMS_UNMARSHAL_4(TPMS_COMMAND_AUDIT_INFO,
                  auditCounter,
-                 Tss2_MU_UINT64_Unmarshal,
+                 mu_UINT64_Unmarshal,
                  digestAlg,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  auditDigest,
                  Tss2_MU_TPM2B_DIGEST_Unmarshal,
                  commandDigest,
@@ -1100,14 +1079,14 @@ TPMS_UNMARSHAL_4(TPMS_COMMAND_AUDIT_INFO,
 TPMS_MARSHAL_2(TPMS_SESSION_AUDIT_INFO,
                exclusiveSession,
                VAL,
-               Tss2_MU_UINT8_Marshal,
+               mu_UINT8_Marshal,
                sessionDigest,
                ADDR,
                Tss2_MU_TPM2B_DIGEST_Marshal)
 
 TPMS_UNMARSHAL_2(TPMS_SESSION_AUDIT_INFO,
                  exclusiveSession,
-                 Tss2_MU_UINT8_Unmarshal,
+                 mu_UINT8_Unmarshal,
                  sessionDigest,
                  Tss2_MU_TPM2B_DIGEST_Unmarshal)
 
@@ -1131,7 +1110,7 @@ TPMS_MARSHAL_3(TPMS_NV_CERTIFY_INFO,
                Tss2_MU_TPM2B_NAME_Marshal,
                offset,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                nvContents,
                ADDR,
                Tss2_MU_TPM2B_MAX_NV_BUFFER_Marshal)
@@ -1140,14 +1119,14 @@ TPMS_UNMARSHAL_3(TPMS_NV_CERTIFY_INFO,
                  indexName,
                  Tss2_MU_TPM2B_NAME_Unmarshal,
                  offset,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  nvContents,
                  Tss2_MU_TPM2B_MAX_NV_BUFFER_Unmarshal)
 
 TPMS_MARSHAL_4(TPMS_AUTH_COMMAND,
                sessionHandle,
                VAL,
-               Tss2_MU_UINT32_Marshal,
+               mu_UINT32_Marshal,
                nonce,
                ADDR,
                Tss2_MU_TPM2B_DIGEST_Marshal,
@@ -1160,7 +1139,7 @@ TPMS_MARSHAL_4(TPMS_AUTH_COMMAND,
 
 TPMS_UNMARSHAL_4(TPMS_AUTH_COMMAND,
                  sessionHandle,
-                 Tss2_MU_UINT32_Unmarshal,
+                 mu_UINT32_Unmarshal,
                  nonce,
                  Tss2_MU_TPM2B_DIGEST_Unmarshal,
                  sessionAttributes,
@@ -1201,33 +1180,17 @@ TPMS_UNMARSHAL_2(TPMS_SENSITIVE_CREATE,
                  data,
                  Tss2_MU_TPM2B_SENSITIVE_DATA_Unmarshal)
 
-TPMS_MARSHAL_1(TPMS_SCHEME_HASH, hashAlg, VAL, Tss2_MU_UINT16_Marshal)
+TPMS_MARSHAL_1(TPMS_SCHEME_HASH, hashAlg, VAL, mu_UINT16_Marshal)
 
-TPMS_UNMARSHAL_1(TPMS_SCHEME_HASH, hashAlg, Tss2_MU_UINT16_Unmarshal)
+TPMS_UNMARSHAL_1(TPMS_SCHEME_HASH, hashAlg, mu_UINT16_Unmarshal)
 
-TPMS_MARSHAL_2(TPMS_SCHEME_ECDAA,
-               hashAlg,
-               VAL,
-               Tss2_MU_UINT16_Marshal,
-               count,
-               VAL,
-               Tss2_MU_UINT16_Marshal)
+TPMS_MARSHAL_FIXED(TPMS_SCHEME_ECDAA)
 
-TPMS_UNMARSHAL_2(TPMS_SCHEME_ECDAA,
-                 hashAlg,
-                 Tss2_MU_UINT16_Unmarshal,
-                 count,
-                 Tss2_MU_UINT16_Unmarshal)
+TPMS_UNMARSHAL_FIXED(TPMS_SCHEME_ECDAA)
 
-TPMS_MARSHAL_2(TPMS_SCHEME_XOR,
-               hashAlg,
-               VAL,
-               Tss2_MU_UINT16_Marshal,
-               kdf,
-               VAL,
-               Tss2_MU_UINT16_Marshal)
+TPMS_MARSHAL_FIXED(TPMS_SCHEME_XOR)
 
-TPMS_UNMARSHAL_2(TPMS_SCHEME_XOR, hashAlg, Tss2_MU_UINT16_Unmarshal, kdf, Tss2_MU_UINT16_Unmarshal)
+TPMS_UNMARSHAL_FIXED(TPMS_SCHEME_XOR)
 
 TPMS_MARSHAL_2(TPMS_ECC_POINT,
                x,
@@ -1246,21 +1209,21 @@ TPMS_UNMARSHAL_2(TPMS_ECC_POINT,
 TPMS_MARSHAL_2(TPMS_SIGNATURE_RSA,
                hash,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                sig,
                ADDR,
                Tss2_MU_TPM2B_PUBLIC_KEY_RSA_Marshal)
 
 TPMS_UNMARSHAL_2(TPMS_SIGNATURE_RSA,
                  hash,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  sig,
                  Tss2_MU_TPM2B_PUBLIC_KEY_RSA_Unmarshal)
 
 TPMS_MARSHAL_3(TPMS_SIGNATURE_ECC,
                hash,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                signatureR,
                ADDR,
                Tss2_MU_TPM2B_ECC_PARAMETER_Marshal,
@@ -1270,33 +1233,23 @@ TPMS_MARSHAL_3(TPMS_SIGNATURE_ECC,
 
 TPMS_UNMARSHAL_3(TPMS_SIGNATURE_ECC,
                  hash,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  signatureR,
                  Tss2_MU_TPM2B_ECC_PARAMETER_Unmarshal,
                  signatureS,
                  Tss2_MU_TPM2B_ECC_PARAMETER_Unmarshal)
 
-TPMS_MARSHAL_2(TPMS_NV_PIN_COUNTER_PARAMETERS,
-               pinCount,
-               VAL,
-               Tss2_MU_UINT32_Marshal,
-               pinLimit,
-               VAL,
-               Tss2_MU_UINT32_Marshal)
+TPMS_MARSHAL_FIXED(TPMS_NV_PIN_COUNTER_PARAMETERS)
 
-TPMS_UNMARSHAL_2(TPMS_NV_PIN_COUNTER_PARAMETERS,
-                 pinCount,
-                 Tss2_MU_UINT32_Unmarshal,
-                 pinLimit,
-                 Tss2_MU_UINT32_Unmarshal)
+TPMS_UNMARSHAL_FIXED(TPMS_NV_PIN_COUNTER_PARAMETERS)
 
 TPMS_MARSHAL_5(TPMS_NV_PUBLIC,
                nvIndex,
                VAL,
-               Tss2_MU_UINT32_Marshal,
+               mu_UINT32_Marshal,
                nameAlg,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                attributes,
                VAL,
                Tss2_MU_TPMA_NV_Marshal,
@@ -1305,19 +1258,19 @@ TPMS_MARSHAL_5(TPMS_NV_PUBLIC,
                Tss2_MU_TPM2B_DIGEST_Marshal,
                dataSize,
                VAL,
-               Tss2_MU_UINT16_Marshal)
+               mu_UINT16_Marshal)
 
 TPMS_UNMARSHAL_5(TPMS_NV_PUBLIC,
                  nvIndex,
-                 Tss2_MU_UINT32_Unmarshal,
+                 mu_UINT32_Unmarshal,
                  nameAlg,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  attributes,
                  Tss2_MU_TPMA_NV_Unmarshal,
                  authPolicy,
                  Tss2_MU_TPM2B_DIGEST_Unmarshal,
                  dataSize,
-                 Tss2_MU_UINT16_Unmarshal)
+                 mu_UINT16_Unmarshal)
 
 TPMS_MARSHAL_2(TPMS_CONTEXT_DATA,
                integrity,
@@ -1336,24 +1289,24 @@ TPMS_UNMARSHAL_2(TPMS_CONTEXT_DATA,
 TPMS_MARSHAL_4(TPMS_CONTEXT,
                sequence,
                VAL,
-               Tss2_MU_UINT64_Marshal,
+               mu_UINT64_Marshal,
                savedHandle,
                VAL,
-               Tss2_MU_UINT32_Marshal,
+               mu_UINT32_Marshal,
                hierarchy,
                VAL,
-               Tss2_MU_UINT32_Marshal,
+               mu_UINT32_Marshal,
                contextBlob,
                ADDR,
                Tss2_MU_TPM2B_CONTEXT_DATA_Marshal)
 
 TPMS_UNMARSHAL_4(TPMS_CONTEXT,
                  sequence,
-                 Tss2_MU_UINT64_Unmarshal,
+                 mu_UINT64_Unmarshal,
                  savedHandle,
-                 Tss2_MU_UINT32_Unmarshal,
+                 mu_UINT32_Unmarshal,
                  hierarchy,
-                 Tss2_MU_UINT32_Unmarshal,
+                 mu_UINT32_Unmarshal,
                  contextBlob,
                  Tss2_MU_TPM2B_CONTEXT_DATA_Unmarshal)
 
@@ -1383,7 +1336,7 @@ TPMS_MARSHAL_7(TPMS_CREATION_DATA,
                Tss2_MU_TPMA_LOCALITY_Marshal,
                parentNameAlg,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                parentName,
                ADDR,
                Tss2_MU_TPM2B_NAME_Marshal,
@@ -1402,7 +1355,7 @@ TPMS_UNMARSHAL_7(TPMS_CREATION_DATA,
                  locality,
                  Tss2_MU_TPMA_LOCALITY_Unmarshal,
                  parentNameAlg,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  parentName,
                  Tss2_MU_TPM2B_NAME_Unmarshal,
                  parentQualifiedName,
@@ -1419,7 +1372,7 @@ TPMS_MARSHAL_4(TPMS_ECC_PARMS,
                Tss2_MU_TPMT_ECC_SCHEME_Marshal,
                curveID,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                kdf,
                ADDR,
                Tss2_MU_TPMT_KDF_SCHEME_Marshal)
@@ -1430,17 +1383,17 @@ TPMS_UNMARSHAL_4(TPMS_ECC_PARMS,
                  scheme,
                  Tss2_MU_TPMT_ECC_SCHEME_Unmarshal,
                  curveID,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  kdf,
                  Tss2_MU_TPMT_KDF_SCHEME_Unmarshal)
 
 TPMS_MARSHAL_7_U(TPMS_ATTEST,
                  magic,
                  VAL,
-                 Tss2_MU_UINT32_Marshal,
+                 mu_UINT32_Marshal,
                  type,
                  VAL,
-                 Tss2_MU_TPM2_ST_Marshal,
+                 mu_TPM2_ST_Marshal,
                  qualifiedSigner,
                  ADDR,
                  Tss2_MU_TPM2B_NAME_Marshal,
@@ -1452,7 +1405,7 @@ TPMS_MARSHAL_7_U(TPMS_ATTEST,
                  Tss2_MU_TPMS_CLOCK_INFO_Marshal,
                  firmwareVersion,
                  VAL,
-                 Tss2_MU_UINT64_Marshal,
+                 mu_UINT64_Marshal,
                  attested,
                  ADDR,
                  Tss2_MU_TPMU_ATTEST_Marshal)
@@ -1461,7 +1414,7 @@ TPMS_UNMARSHAL_7_U(TPMS_ATTEST,
                    magic,
                    TPM2_GENERATED_Unmarshal,
                    type,
-                   Tss2_MU_TPM2_ST_Unmarshal,
+                   mu_TPM2_ST_Unmarshal,
                    qualifiedSigner,
                    Tss2_MU_TPM2B_NAME_Unmarshal,
                    extraData,
@@ -1469,17 +1422,17 @@ TPMS_UNMARSHAL_7_U(TPMS_ATTEST,
                    clockInfo,
                    Tss2_MU_TPMS_CLOCK_INFO_Unmarshal,
                    firmwareVersion,
-                   Tss2_MU_UINT64_Unmarshal,
+                   mu_UINT64_Unmarshal,
                    attested,
                    Tss2_MU_TPMU_ATTEST_Unmarshal)
 
 TPMS_MARSHAL_11(TPMS_ALGORITHM_DETAIL_ECC,
                 curveID,
                 VAL,
-                Tss2_MU_UINT16_Marshal,
+                mu_UINT16_Marshal,
                 keySize,
                 VAL,
-                Tss2_MU_UINT16_Marshal,
+                mu_UINT16_Marshal,
                 kdf,
                 ADDR,
                 Tss2_MU_TPMT_KDF_SCHEME_Marshal,
@@ -1510,9 +1463,9 @@ TPMS_MARSHAL_11(TPMS_ALGORITHM_DETAIL_ECC,
 
 TPMS_UNMARSHAL_11(TPMS_ALGORITHM_DETAIL_ECC,
                   curveID,
-                  Tss2_MU_UINT16_Unmarshal,
+                  mu_UINT16_Unmarshal,
                   keySize,
-                  Tss2_MU_UINT16_Unmarshal,
+                  mu_UINT16_Unmarshal,
                   kdf,
                   Tss2_MU_TPMT_KDF_SCHEME_Unmarshal,
                   sign,
@@ -1535,14 +1488,14 @@ TPMS_UNMARSHAL_11(TPMS_ALGORITHM_DETAIL_ECC,
 TPMS_MARSHAL_2_U(TPMS_CAPABILITY_DATA,
                  capability,
                  VAL,
-                 Tss2_MU_UINT32_Marshal,
+                 mu_UINT32_Marshal,
                  data,
                  ADDR,
                  Tss2_MU_TPMU_CAPABILITIES_Marshal)
 
 TPMS_UNMARSHAL_2_U(TPMS_CAPABILITY_DATA,
                    capability,
-                   Tss2_MU_UINT32_Unmarshal,
+                   mu_UINT32_Unmarshal,
                    data,
                    Tss2_MU_TPMU_CAPABILITIES_Unmarshal)
 
@@ -1559,10 +1512,10 @@ TPMS_MARSHAL_4(TPMS_RSA_PARMS,
                Tss2_MU_TPMT_RSA_SCHEME_Marshal,
                keyBits,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                exponent,
                VAL,
-               Tss2_MU_UINT32_Marshal)
+               mu_UINT32_Marshal)
 
 TPMS_UNMARSHAL_4(TPMS_RSA_PARMS,
                  symmetric,
@@ -1570,9 +1523,9 @@ TPMS_UNMARSHAL_4(TPMS_RSA_PARMS,
                  scheme,
                  Tss2_MU_TPMT_RSA_SCHEME_Unmarshal,
                  keyBits,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  exponent,
-                 Tss2_MU_UINT32_Unmarshal)
+                 mu_UINT32_Unmarshal)
 
 TPMS_MARSHAL_1(TPMS_SYMCIPHER_PARMS, sym, ADDR, Tss2_MU_TPMT_SYM_DEF_OBJECT_Marshal)
 
@@ -1582,9 +1535,9 @@ TPMS_MARSHAL_0(TPMS_EMPTY);
 
 TPMS_UNMARSHAL_0(TPMS_EMPTY);
 
-TPMS_MARSHAL_2(TPMS_AC_OUTPUT, tag, VAL, Tss2_MU_UINT32_Marshal, data, VAL, Tss2_MU_UINT32_Marshal)
+TPMS_MARSHAL_FIXED(TPMS_AC_OUTPUT)
 
-TPMS_UNMARSHAL_2(TPMS_AC_OUTPUT, tag, Tss2_MU_UINT32_Unmarshal, data, Tss2_MU_UINT32_Unmarshal)
+TPMS_UNMARSHAL_FIXED(TPMS_AC_OUTPUT)
 
 TPMS_MARSHAL_2(TPMS_ID_OBJECT,
                integrityHMAC,
@@ -1614,21 +1567,6 @@ TPMS_UNMARSHAL_2(TPMS_NV_DIGEST_CERTIFY_INFO,
                  nvDigest,
                  Tss2_MU_TPM2B_DIGEST_Unmarshal)
 
-TPMS_MARSHAL_3(TPMS_ACT_DATA,
-               handle,
-               VAL,
-               Tss2_MU_TPM2_HANDLE_Marshal,
-               timeout,
-               VAL,
-               Tss2_MU_UINT32_Marshal,
-               attributes,
-               VAL,
-               Tss2_MU_UINT32_Marshal)
+TPMS_MARSHAL_FIXED(TPMS_ACT_DATA)
 
-TPMS_UNMARSHAL_3(TPMS_ACT_DATA,
-                 handle,
-                 Tss2_MU_TPM2_HANDLE_Unmarshal,
-                 timeout,
-                 Tss2_MU_UINT32_Unmarshal,
-                 attributes,
-                 Tss2_MU_UINT32_Unmarshal)
+TPMS_UNMARSHAL_FIXED(TPMS_ACT_DATA)
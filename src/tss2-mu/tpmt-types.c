@@ -12,6 +12,7 @@
 #include <inttypes.h> // for PRIxPTR, uintptr_t, uint8_t
 #include <string.h>   // for size_t, NULL, memset
 
+#include "base-types.h"      // for mu_UINT16_Marshal, mu_UINT16_Unmarshal
 #include "tss2_common.h"     // for TSS2_RC_SUCCESS, TSS2_RC, TSS2_MU_RC_BA...
 #include "tss2_mu.h"         // for Tss2_MU_UINT16_Marshal, Tss2_MU_UINT16_...
 #include "tss2_tpm2_types.h" // for TPMT_PUBLIC, TPMT_SENSITIVE, TPMT_SYM_DEF
@@ -70,7 +71,8 @@
                   " at index 0x%zx",                                                               \
                   (uintptr_t)dest, (uintptr_t)buffer, local_offset);                               \
                                                                                                    \
-        memset(&tmp, '\0', sizeof(tmp));                                                           \
+        if (!dest)                                                                                 \
+            memset(&tmp, '\0', sizeof(tmp));                                                       \
                                                                                                    \
         ret = fn1(buffer, buffer_size, &local_offset, dest ? &dest->m1 : &tmp.m1);                 \
         if (ret != TSS2_RC_SUCCESS)                                                                \
@@ -135,7 +137,8 @@
         else if (!dest)                                                                            \
             return TSS2_MU_RC_BAD_REFERENCE;                                                       \
                                                                                                    \
-        memset(&tmp, '\0', sizeof(tmp));                                                           \
+        if (!dest)                                                                                 \
+            memset(&tmp, '\0', sizeof(tmp));                                                       \
                                                                                                    \
         LOG_DEBUG("Unmarshaling " #type " from 0x%" PRIxPTR " to buffer 0x%" PRIxPTR               \
                   " at index 0x%zx",                                                               \
@@ -282,7 +285,8 @@
         else if (!dest)                                                                            \
             return TSS2_MU_RC_BAD_REFERENCE;                                                       \
                                                                                                    \
-        memset(&tmp, '\0', sizeof(tmp));                                                           \
+        if (!dest)                                                                                 \
+            memset(&tmp, '\0', sizeof(tmp));                                                       \
                                                                                                    \
         LOG_DEBUG("Unmarshaling " #type " from 0x%" PRIxPTR " to buffer 0x%" PRIxPTR               \
                   " at index 0x%zx",                                                               \
@@ -457,7 +461,8 @@
         else if (!dest)                                                                            \
             return TSS2_MU_RC_BAD_REFERENCE;                                                       \
                                                                                                    \
-        memset(&tmp, '\0', sizeof(tmp));                                                           \
+        if (!dest)                                                                                 \
+            memset(&tmp, '\0', sizeof(tmp));                                                       \
                                                                                                    \
         LOG_DEBUG("Unmarshaling " #type " from 0x%" PRIxPTR " to buffer 0x%" PRIxPTR               \
                   " at index 0x%zx",                                                               \
@@ -502,7 +507,7 @@
 TPMT_MARSHAL_2(TPMT_HA,
                hashAlg,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                digest,
                ADDR,
                hashAlg,
@@ -510,7 +515,7 @@ TPMT_MARSHAL_2(TPMT_HA,
 
 TPMT_UNMARSHAL_2(TPMT_HA,
                  hashAlg,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  digest,
                  hashAlg,
                  Tss2_MU_TPMU_HA_Unmarshal)
@@ -518,7 +523,7 @@ TPMT_UNMARSHAL_2(TPMT_HA,
 TPMT_MARSHAL_3(TPMT_SYM_DEF,
                algorithm,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                keyBits,
                ADDR,
                algorithm,
@@ -530,7 +535,7 @@ TPMT_MARSHAL_3(TPMT_SYM_DEF,
 
 TPMT_UNMARSHAL_3(TPMT_SYM_DEF,
                  algorithm,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  keyBits,
                  algorithm,
                  Tss2_MU_TPMU_SYM_KEY_BITS_Unmarshal,
@@ -541,7 +546,7 @@ TPMT_UNMARSHAL_3(TPMT_SYM_DEF,
 TPMT_MARSHAL_3(TPMT_SYM_DEF_OBJECT,
                algorithm,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                keyBits,
                ADDR,
                algorithm,
@@ -553,7 +558,7 @@ TPMT_MARSHAL_3(TPMT_SYM_DEF_OBJECT,
 
 TPMT_UNMARSHAL_3(TPMT_SYM_DEF_OBJECT,
                  algorithm,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  keyBits,
                  algorithm,
                  Tss2_MU_TPMU_SYM_KEY_BITS_Unmarshal,
@@ -564,7 +569,7 @@ TPMT_UNMARSHAL_3(TPMT_SYM_DEF_OBJECT,
 TPMT_MARSHAL_2(TPMT_KEYEDHASH_SCHEME,
                scheme,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                details,
                ADDR,
                scheme,
@@ -572,7 +577,7 @@ TPMT_MARSHAL_2(TPMT_KEYEDHASH_SCHEME,
 
 TPMT_UNMARSHAL_2(TPMT_KEYEDHASH_SCHEME,
                  scheme,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  details,
                  scheme,
                  Tss2_MU_TPMU_SCHEME_KEYEDHASH_Unmarshal)
@@ -580,7 +585,7 @@ TPMT_UNMARSHAL_2(TPMT_KEYEDHASH_SCHEME,
 TPMT_MARSHAL_2(TPMT_SIG_SCHEME,
                scheme,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                details,
                ADDR,
                scheme,
@@ -588,7 +593,7 @@ TPMT_MARSHAL_2(TPMT_SIG_SCHEME,
 
 TPMT_UNMARSHAL_2(TPMT_SIG_SCHEME,
                  scheme,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  details,
                  scheme,
                  Tss2_MU_TPMU_SIG_SCHEME_Unmarshal)
@@ -596,7 +601,7 @@ TPMT_UNMARSHAL_2(TPMT_SIG_SCHEME,
 TPMT_MARSHAL_2(TPMT_KDF_SCHEME,
                scheme,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                details,
                ADDR,
                scheme,
@@ -604,7 +609,7 @@ TPMT_MARSHAL_2(TPMT_KDF_SCHEME,
 
 TPMT_UNMARSHAL_2(TPMT_KDF_SCHEME,
                  scheme,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  details,
                  scheme,
                  Tss2_MU_TPMU_KDF_SCHEME_Unmarshal)
@@ -612,7 +617,7 @@ TPMT_UNMARSHAL_2(TPMT_KDF_SCHEME,
 TPMT_MARSHAL_2(TPMT_ASYM_SCHEME,
                scheme,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                details,
                ADDR,
                scheme,
@@ -620,7 +625,7 @@ TPMT_MARSHAL_2(TPMT_ASYM_SCHEME,
 
 TPMT_UNMARSHAL_2(TPMT_ASYM_SCHEME,
                  scheme,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  details,
                  scheme,
                  Tss2_MU_TPMU_ASYM_SCHEME_Unmarshal)
@@ -628,7 +633,7 @@ TPMT_UNMARSHAL_2(TPMT_ASYM_SCHEME,
 TPMT_MARSHAL_2(TPMT_RSA_SCHEME,
                scheme,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                details,
                ADDR,
                scheme,
@@ -636,7 +641,7 @@ TPMT_MARSHAL_2(TPMT_RSA_SCHEME,
 
 TPMT_UNMARSHAL_2(TPMT_RSA_SCHEME,
                  scheme,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  details,
                  scheme,
                  Tss2_MU_TPMU_ASYM_SCHEME_Unmarshal)
@@ -644,7 +649,7 @@ TPMT_UNMARSHAL_2(TPMT_RSA_SCHEME,
 TPMT_MARSHAL_2(TPMT_RSA_DECRYPT,
                scheme,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                details,
                ADDR,
                scheme,
@@ -652,7 +657,7 @@ TPMT_MARSHAL_2(TPMT_RSA_DECRYPT,
 
 TPMT_UNMARSHAL_2(TPMT_RSA_DECRYPT,
                  scheme,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  details,
                  scheme,
                  Tss2_MU_TPMU_ASYM_SCHEME_Unmarshal)
@@ -660,7 +665,7 @@ TPMT_UNMARSHAL_2(TPMT_RSA_DECRYPT,
 TPMT_MARSHAL_2(TPMT_ECC_SCHEME,
                scheme,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                details,
                ADDR,
                scheme,
@@ -668,7 +673,7 @@ TPMT_MARSHAL_2(TPMT_ECC_SCHEME,
 
 TPMT_UNMARSHAL_2(TPMT_ECC_SCHEME,
                  scheme,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  details,
                  scheme,
                  Tss2_MU_TPMU_ASYM_SCHEME_Unmarshal)
@@ -676,7 +681,7 @@ TPMT_UNMARSHAL_2(TPMT_ECC_SCHEME,
 TPMT_MARSHAL_2(TPMT_SIGNATURE,
                sigAlg,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                signature,
                ADDR,
                sigAlg,
@@ -684,7 +689,7 @@ TPMT_MARSHAL_2(TPMT_SIGNATURE,
 
 TPMT_UNMARSHAL_2(TPMT_SIGNATURE,
                  sigAlg,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  signature,
                  sigAlg,
                  Tss2_MU_TPMU_SIGNATURE_Unmarshal)
@@ -692,7 +697,7 @@ TPMT_UNMARSHAL_2(TPMT_SIGNATURE,
 TPMT_MARSHAL_4(TPMT_SENSITIVE,
                sensitiveType,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                authValue,
                ADDR,
                Tss2_MU_TPM2B_DIGEST_Marshal,
@@ -706,7 +711,7 @@ TPMT_MARSHAL_4(TPMT_SENSITIVE,
 
 TPMT_UNMARSHAL_4(TPMT_SENSITIVE,
                  sensitiveType,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  authValue,
                  Tss2_MU_TPM2B_DIGEST_Unmarshal,
                  seedValue,
@@ -718,10 +723,10 @@ TPMT_UNMARSHAL_4(TPMT_SENSITIVE,
 TPMT_MARSHAL_6(TPMT_PUBLIC,
                type,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                nameAlg,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                objectAttributes,
                VAL,
                Tss2_MU_TPMA_OBJECT_Marshal,
@@ -739,9 +744,9 @@ TPMT_MARSHAL_6(TPMT_PUBLIC,
 
 TPMT_UNMARSHAL_6(TPMT_PUBLIC,
                  type,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  nameAlg,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  objectAttributes,
                  Tss2_MU_TPMA_OBJECT_Unmarshal,
                  authPolicy,
@@ -756,7 +761,7 @@ TPMT_UNMARSHAL_6(TPMT_PUBLIC,
 TPMT_MARSHAL_2(TPMT_PUBLIC_PARMS,
                type,
                VAL,
-               Tss2_MU_UINT16_Marshal,
+               mu_UINT16_Marshal,
                parameters,
                ADDR,
                type,
@@ -764,71 +769,71 @@ TPMT_MARSHAL_2(TPMT_PUBLIC_PARMS,
 
 TPMT_UNMARSHAL_2(TPMT_PUBLIC_PARMS,
                  type,
-                 Tss2_MU_UINT16_Unmarshal,
+                 mu_UINT16_Unmarshal,
                  parameters,
                  type,
                  Tss2_MU_TPMU_PUBLIC_PARMS_Unmarshal)
 
 TPMT_MARSHAL_TK(TPMT_TK_CREATION,
                 tag,
-                Tss2_MU_UINT16_Marshal,
+                mu_UINT16_Marshal,
                 hierarchy,
-                Tss2_MU_UINT32_Marshal,
+                mu_UINT32_Marshal,
                 digest,
                 Tss2_MU_TPM2B_DIGEST_Marshal)
 
 TPMT_UNMARSHAL_TK(TPMT_TK_CREATION,
                   tag,
-                  Tss2_MU_UINT16_Unmarshal,
+                  mu_UINT16_Unmarshal,
                   hierarchy,
-                  Tss2_MU_UINT32_Unmarshal,
+                  mu_UINT32_Unmarshal,
                   digest,
                   Tss2_MU_TPM2B_DIGEST_Unmarshal)
 
 TPMT_MARSHAL_TK(TPMT_TK_VERIFIED,
                 tag,
-                Tss2_MU_UINT16_Marshal,
+                mu_UINT16_Marshal,
                 hierarchy,
-                Tss2_MU_UINT32_Marshal,
+                mu_UINT32_Marshal,
                 digest,
                 Tss2_MU_TPM2B_DIGEST_Marshal)
 
 TPMT_UNMARSHAL_TK(TPMT_TK_VERIFIED,
                   tag,
-                  Tss2_MU_UINT16_Unmarshal,
+                  mu_UINT16_Unmarshal,
                   hierarchy,
-                  Tss2_MU_UINT32_Unmarshal,
+                  mu_UINT32_Unmarshal,
                   digest,
                   Tss2_MU_TPM2B_DIGEST_Unmarshal)
 
 TPMT_MARSHAL_TK(TPMT_TK_AUTH,
                 tag,
-                Tss2_MU_UINT16_Marshal,
+                mu_UINT16_Marshal,
                 hierarchy,
-                Tss2_MU_UINT32_Marshal,
+                mu_UINT32_Marshal,
                 digest,
                 Tss2_MU_TPM2B_DIGEST_Marshal)
 
 TPMT_UNMARSHAL_TK(TPMT_TK_AUTH,
                   tag,
-                  Tss2_MU_UINT16_Unmarshal,
+                  mu_UINT16_Unmarshal,
                   hierarchy,
-                  Tss2_MU_UINT32_Unmarshal,
+                  mu_UINT32_Unmarshal,
                   digest,
                   Tss2_MU_TPM2B_DIGEST_Unmarshal)
 
 TPMT_MARSHAL_TK(TPMT_TK_HASHCHECK,
                 tag,
-                Tss2_MU_UINT16_Marshal,
+                mu_UINT16_Marshal,
                 hierarchy,
-                Tss2_MU_UINT32_Marshal,
+                mu_UINT32_Marshal,
                 digest,
                 Tss2_MU_TPM2B_DIGEST_Marshal)
 
 TPMT_UNMARSHAL_TK(TPMT_TK_HASHCHECK,
                   tag,
-                  Tss2_MU_UINT16_Unmarshal,
+                  mu_UINT16_Unmarshal,
                   hierarchy,
-                  Tss2_MU_UINT32_Unmarshal,
+                  mu_UINT32_Unmarshal,
                   digest,
                   Tss2_MU_TPM2B_DIGEST_Unmarshal)
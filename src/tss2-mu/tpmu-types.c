@@ -12,6 +12,7 @@
 #include <inttypes.h> // for PRIx32, uint8_t, uint32_t, PRIxPTR, uin...
 #include <string.h>   // for NULL, size_t, memcpy
 
+#include "base-types.h"      // for mu_UINT16_Marshal, mu_UINT16_Unmarshal
 #include "tss2_common.h"     // for TSS2_RC, BYTE, TSS2_RC_SUCCESS, TSS2_MU...
 #include "tss2_mu.h"         // for Tss2_MU_TPMS_SCHEME_HASH_Marshal, Tss2_...
 #include "tss2_tpm2_types.h" // for TPM2_ALG_NULL, TPMU_ASYM_SCHEME, TPMU_A...
@@ -614,53 +615,53 @@ TPMU_MARSHAL2(TPMU_SYM_KEY_BITS,
               TPM2_ALG_AES,
               VAL,
               aes,
-              Tss2_MU_UINT16_Marshal,
+              mu_UINT16_Marshal,
               TPM2_ALG_SM4,
               VAL,
               sm4,
-              Tss2_MU_UINT16_Marshal,
+              mu_UINT16_Marshal,
               TPM2_ALG_CAMELLIA,
               VAL,
               camellia,
-              Tss2_MU_UINT16_Marshal,
+              mu_UINT16_Marshal,
               TPM2_ALG_XOR,
               VAL,
               exclusiveOr,
-              Tss2_MU_UINT16_Marshal,
+              mu_UINT16_Marshal,
               TPM2_ALG_SYMCIPHER,
               VAL,
               sym,
-              Tss2_MU_UINT16_Marshal)
+              mu_UINT16_Marshal)
 TPMU_UNMARSHAL2(TPMU_SYM_KEY_BITS,
                 TPM2_ALG_AES,
                 aes,
-                Tss2_MU_UINT16_Unmarshal,
+                mu_UINT16_Unmarshal,
                 TPM2_ALG_SM4,
                 sm4,
-                Tss2_MU_UINT16_Unmarshal,
+                mu_UINT16_Unmarshal,
                 TPM2_ALG_CAMELLIA,
                 camellia,
-                Tss2_MU_UINT16_Unmarshal,
+                mu_UINT16_Unmarshal,
                 TPM2_ALG_XOR,
                 exclusiveOr,
-                Tss2_MU_UINT16_Unmarshal,
+                mu_UINT16_Unmarshal,
                 TPM2_ALG_SYMCIPHER,
                 sym,
-                Tss2_MU_UINT16_Unmarshal)
+                mu_UINT16_Unmarshal)
 
 TPMU_MARSHAL2(TPMU_SYM_MODE,
               TPM2_ALG_AES,
               VAL,
               aes,
-              Tss2_MU_UINT16_Marshal,
+              mu_UINT16_Marshal,
               TPM2_ALG_SM4,
               VAL,
               sm4,
-              Tss2_MU_UINT16_Marshal,
+              mu_UINT16_Marshal,
               TPM2_ALG_CAMELLIA,
               VAL,
               camellia,
-              Tss2_MU_UINT16_Marshal,
+              mu_UINT16_Marshal,
               TPM2_ALG_XOR,
               ADDR,
               sym,
@@ -668,23 +669,23 @@ TPMU_MARSHAL2(TPMU_SYM_MODE,
               TPM2_ALG_SYMCIPHER,
               VAL,
               sym,
-              Tss2_MU_UINT16_Marshal)
+              mu_UINT16_Marshal)
 TPMU_UNMARSHAL2(TPMU_SYM_MODE,
                 TPM2_ALG_AES,
                 aes,
-                Tss2_MU_UINT16_Unmarshal,
+                mu_UINT16_Unmarshal,
                 TPM2_ALG_SM4,
                 sm4,
-                Tss2_MU_UINT16_Unmarshal,
+                mu_UINT16_Unmarshal,
                 TPM2_ALG_CAMELLIA,
                 camellia,
-                Tss2_MU_UINT16_Unmarshal,
+                mu_UINT16_Unmarshal,
                 TPM2_ALG_XOR,
                 sym,
                 unmarshal_null,
                 TPM2_ALG_SYMCIPHER,
                 sym,
-                Tss2_MU_UINT16_Unmarshal)
+                mu_UINT16_Unmarshal)
 
 TPMU_MARSHAL2(TPMU_SIG_SCHEME,
               TPM2_ALG_RSASSA,
@@ -1039,7 +1040,7 @@ TPMU_MARSHAL2(TPMU_NAME,
               sizeof(TPM2_HANDLE),
               VAL,
               handle,
-              Tss2_MU_UINT32_Marshal,
+              mu_UINT32_Marshal,
               sizeof(TPM2_ALG_ID) + TPM2_SHA1_DIGEST_SIZE,
               ADDR,
               digest,
@@ -1059,7 +1060,7 @@ TPMU_MARSHAL2(TPMU_NAME,
 TPMU_UNMARSHAL2(TPMU_NAME,
                 sizeof(TPM2_HANDLE),
                 handle,
-                Tss2_MU_UINT32_Unmarshal,
+                mu_UINT32_Unmarshal,
                 sizeof(TPM2_ALG_ID) + TPM2_SHA1_DIGEST_SIZE,
                 digest,
                 Tss2_MU_TPMT_HA_Unmarshal,
@@ -41,10 +41,6 @@ Tss2_Sys_AC_GetCapability_Prepare(TSS2_SYS_CONTEXT *sysContext,
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -33,10 +33,6 @@ Tss2_Sys_ClockSet_Prepare(TSS2_SYS_CONTEXT *sysContext, TPMI_RH_PROVISION auth,
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
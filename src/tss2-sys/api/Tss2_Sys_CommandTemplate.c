@@ -0,0 +1,134 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <stddef.h> // for offsetof, size_t
+#include <stdint.h> // for uint8_t
+#include <string.h> // for memcpy
+
+#include "sysapi_util.h"      // for _TSS2_SYS_CONTEXT_BLOB, TSS2_SYS_CMD_T...
+#include "tss2_common.h"      // for TSS2_RC, TSS2_SYS_RC_BAD_REFERENCE
+#include "tss2_sys.h"         // for TSS2_SYS_CONTEXT, Tss2_Sys_SaveCommand...
+#include "tss2_tpm2_types.h"  // for TPM2_ST_NO_SESSIONS
+#include "util/tss2_endian.h" // for BE_TO_HOST_16, BE_TO_HOST_32, HOST_TO_...
+
+/*
+ * Copy the currently prepared command into a caller provided template.
+ * The template must be captured before Tss2_Sys_SetCmdAuths() since the
+ * authorization area changes with every execution. If cmdTemplate is NULL
+ * only the required size is returned in cmdTemplateSize.
+ */
+TSS2_RC
+Tss2_Sys_SaveCommandTemplate(TSS2_SYS_CONTEXT      *sysContext,
+                             TSS2_SYS_CMD_TEMPLATE *cmdTemplate,
+                             size_t                *cmdTemplateSize) {
+    TSS2_SYS_CONTEXT_BLOB *ctx = syscontext_cast(sysContext);
+    UINT32                 commandSize;
+    size_t                 size;
+
+    if (!ctx || !cmdTemplateSize)
+        return TSS2_SYS_RC_BAD_REFERENCE;
+
+    if (ctx->previousStage != CMD_STAGE_PREPARE)
+        return TSS2_SYS_RC_BAD_SEQUENCE;
+
+    if (BE_TO_HOST_16(req_header_from_cxt(ctx)->tag) != TPM2_ST_NO_SESSIONS)
+        return TSS2_SYS_RC_BAD_SEQUENCE;
+
+    commandSize = BE_TO_HOST_32(req_header_from_cxt(ctx)->commandSize);
+    size = offsetof(TSS2_SYS_CMD_TEMPLATE, buffer) + commandSize;
+
+    if (!cmdTemplate) {
+        *cmdTemplateSize = size;
+        return TSS2_RC_SUCCESS;
+    }
+
+    if (*cmdTemplateSize < size)
+        return TSS2_SYS_RC_INSUFFICIENT_BUFFER;
+
+    cmdTemplate->commandCode = ctx->commandCode;
+    cmdTemplate->commandSize = commandSize;
+    cmdTemplate->cpBufferStart = ctx->cpBuffer - ctx->cmdBuffer;
+    cmdTemplate->numResponseHandles = ctx->numResponseHandles;
+    cmdTemplate->decryptAllowed = ctx->decryptAllowed;
+    cmdTemplate->encryptAllowed = ctx->encryptAllowed;
+    cmdTemplate->decryptNull = ctx->decryptNull;
+    cmdTemplate->authAllowed = ctx->authAllowed;
+    memcpy(cmdTemplate->buffer, ctx->cmdBuffer, commandSize);
+
+    *cmdTemplateSize = size;
+    return TSS2_RC_SUCCESS;
+}
+
+/*
+ * Restore a command from a template as if its _Prepare function had just
+ * been called. The command parameters are not marshaled or validated again.
+ */
+TSS2_RC
+Tss2_Sys_LoadCommandTemplate(TSS2_SYS_CONTEXT *sysContext, const TSS2_SYS_CMD_TEMPLATE *cmdTemplate) {
+    TSS2_SYS_CONTEXT_BLOB *ctx = syscontext_cast(sysContext);
+
+    if (!ctx || !cmdTemplate)
+        return TSS2_SYS_RC_BAD_REFERENCE;
+
+    if (ctx->previousStage != CMD_STAGE_INITIALIZE
+        && ctx->previousStage != CMD_STAGE_RECEIVE_RESPONSE
+        && ctx->previousStage != CMD_STAGE_PREPARE)
+        return TSS2_SYS_RC_BAD_SEQUENCE;
+
+    if (cmdTemplate->commandSize < sizeof(TPM20_Header_In)
+        || cmdTemplate->cpBufferStart < sizeof(TPM20_Header_In)
+        || cmdTemplate->cpBufferStart > cmdTemplate->commandSize)
+        return TSS2_SYS_RC_BAD_VALUE;
+
+    if (cmdTemplate->commandSize > ctx->maxCmdSize)
+        return TSS2_SYS_RC_INSUFFICIENT_CONTEXT;
+
+    memcpy(ctx->cmdBuffer, cmdTemplate->buffer, cmdTemplate->commandSize);
+
+    ctx->commandCode = cmdTemplate->commandCode;
+    ctx->numResponseHandles = cmdTemplate->numResponseHandles;
+    ctx->decryptAllowed = cmdTemplate->decryptAllowed;
+    ctx->encryptAllowed = cmdTemplate->encryptAllowed;
+    ctx->decryptNull = cmdTemplate->decryptNull;
+    ctx->authAllowed = cmdTemplate->authAllowed;
+    ctx->authsCount = 0;
+
+    ctx->rspParamsSize = (UINT32 *)(ctx->cmdBuffer + sizeof(TPM20_Header_Out)
+                                    + (ctx->numResponseHandles * sizeof(UINT32)));
+    ctx->cpBuffer = ctx->cmdBuffer + cmdTemplate->cpBufferStart;
+    ctx->cpBufferUsedSize = cmdTemplate->commandSize - cmdTemplate->cpBufferStart;
+    ctx->nextData = cmdTemplate->commandSize;
+    ctx->previousStage = CMD_STAGE_PREPARE;
+
+    return TSS2_RC_SUCCESS;
+}
+
+/*
+ * Overwrite fixed size fields of the prepared command parameters in place,
+ * e.g. the digest of a PCR_Extend or Sign loaded from a template. Patching
+ * must happen before the cpHash for the authorizations is computed.
+ */
+TSS2_RC
+Tss2_Sys_PatchCpBuffer(TSS2_SYS_CONTEXT *sysContext,
+                       size_t            offset,
+                       size_t            size,
+                       const uint8_t    *buffer) {
+    TSS2_SYS_CONTEXT_BLOB *ctx = syscontext_cast(sysContext);
+
+    if (!ctx || !buffer)
+        return TSS2_SYS_RC_BAD_REFERENCE;
+
+    if (ctx->previousStage != CMD_STAGE_PREPARE)
+        return TSS2_SYS_RC_BAD_SEQUENCE;
+
+    if (offset > ctx->cpBufferUsedSize || size > ctx->cpBufferUsedSize - offset)
+        return TSS2_SYS_RC_BAD_SIZE;
+
+    memcpy(ctx->cpBuffer + offset, buffer, size);
+
+    return TSS2_RC_SUCCESS;
+}
@@ -30,10 +30,6 @@ Tss2_Sys_ContextLoad_Prepare(TSS2_SYS_CONTEXT *sysContext, const TPMS_CONTEXT *c
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 0;
-
     return CommonPrepareEpilogue(ctx);
 }
 
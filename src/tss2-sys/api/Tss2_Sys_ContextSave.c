@@ -30,10 +30,6 @@ Tss2_Sys_ContextSave_Prepare(TSS2_SYS_CONTEXT *sysContext, TPMI_DH_CONTEXT saveH
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 0;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -83,10 +83,6 @@ Tss2_Sys_CreatePrimary_Prepare(TSS2_SYS_CONTEXT             *sysContext,
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 1;
-    ctx->encryptAllowed = 1;
-    ctx->authAllowed = 1;
-
     rval = CommonPrepareEpilogue(ctx);
     return rval;
 }
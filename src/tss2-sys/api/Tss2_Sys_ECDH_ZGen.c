@@ -44,10 +44,6 @@ Tss2_Sys_ECDH_ZGen_Prepare(TSS2_SYS_CONTEXT      *sysContext,
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 1;
-    ctx->encryptAllowed = 1;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
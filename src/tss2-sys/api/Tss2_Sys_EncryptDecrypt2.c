@@ -66,10 +66,6 @@ Tss2_Sys_EncryptDecrypt2_Prepare(TSS2_SYS_CONTEXT       *sysContext,
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 1;
-    ctx->encryptAllowed = 1;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -95,6 +91,29 @@ Tss2_Sys_EncryptDecrypt2_Complete(TSS2_SYS_CONTEXT *sysContext,
     return Tss2_MU_TPM2B_IV_Unmarshal(ctx->cmdBuffer, ctx->maxCmdSize, &ctx->nextData, ivOut);
 }
 
+TSS2_RC
+Tss2_Sys_EncryptDecrypt2_CompleteView(TSS2_SYS_CONTEXT *sysContext,
+                                      const uint8_t   **outData,
+                                      UINT16           *outDataSize,
+                                      TPM2B_IV         *ivOut) {
+    TSS2_SYS_CONTEXT_BLOB *ctx = syscontext_cast(sysContext);
+    TSS2_RC                rval;
+
+    if (!ctx || !outData || !outDataSize)
+        return TSS2_SYS_RC_BAD_REFERENCE;
+
+    rval = CommonComplete(ctx);
+    if (rval)
+        return rval;
+
+    rval = Tss2_MU_TPM2B_MAX_BUFFER_UnmarshalView(ctx->cmdBuffer, ctx->maxCmdSize, &ctx->nextData,
+                                                  outData, outDataSize);
+    if (rval)
+        return rval;
+
+    return Tss2_MU_TPM2B_IV_Unmarshal(ctx->cmdBuffer, ctx->maxCmdSize, &ctx->nextData, ivOut);
+}
+
 TSS2_RC
 Tss2_Sys_EncryptDecrypt2(TSS2_SYS_CONTEXT             *sysContext,
                          TPMI_DH_OBJECT                keyHandle,
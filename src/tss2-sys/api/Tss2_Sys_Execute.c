@@ -17,6 +17,7 @@
 #include "tss2_sys.h"         // for TSS2_SYS_CONTEXT, Tss2_Sys_Execute
 #include "tss2_tcti.h"        // for Tss2_Tcti_Receive, TSS2_TCTI_TIMEOUT_B...
 #include "tss2_tpm2_types.h"  // for TPM2_RC_INITIALIZE, TPM2_ST_NO_SESSIONS
+#include "util/probe.h"       // for TSS2_PROBE3, TSS2_PROBE4
 #include "util/tss2_endian.h" // for HOST_TO_BE_32
 
 #define LOGMODULE sys
@@ -33,6 +34,9 @@ Tss2_Sys_ExecuteAsync(TSS2_SYS_CONTEXT *sysContext) {
     if (ctx->previousStage != CMD_STAGE_PREPARE)
         return TSS2_SYS_RC_BAD_SEQUENCE;
 
+    TSS2_PROBE3(sys_execute_async, sysContext, ctx->commandCode,
+                HOST_TO_BE_32(req_header_from_cxt(ctx)->commandSize));
+
     rval = Tss2_Tcti_Transmit(ctx->tctiContext,
                               HOST_TO_BE_32(req_header_from_cxt(ctx)->commandSize), ctx->cmdBuffer);
     if (rval)
@@ -48,14 +52,10 @@ Tss2_Sys_ExecuteAsync(TSS2_SYS_CONTEXT *sysContext) {
     return rval;
 }
 
-TSS2_RC
-Tss2_Sys_ExecuteFinish(TSS2_SYS_CONTEXT *sysContext, int32_t timeout) {
-    TSS2_SYS_CONTEXT_BLOB *ctx = syscontext_cast(sysContext);
-    TSS2_RC                rval;
-    size_t                 response_size = 0;
-
-    if (!ctx)
-        return TSS2_SYS_RC_BAD_REFERENCE;
+static TSS2_RC
+execute_finish(TSS2_SYS_CONTEXT_BLOB *ctx, int32_t timeout) {
+    TSS2_RC rval;
+    size_t  response_size = 0;
 
     if (ctx->previousStage != CMD_STAGE_SEND_COMMAND)
         return TSS2_SYS_RC_BAD_SEQUENCE;
@@ -155,6 +155,21 @@ Tss2_Sys_ExecuteFinish(TSS2_SYS_CONTEXT *sysContext, int32_t timeout) {
     return rval;
 }
 
+TSS2_RC
+Tss2_Sys_ExecuteFinish(TSS2_SYS_CONTEXT *sysContext, int32_t timeout) {
+    TSS2_SYS_CONTEXT_BLOB *ctx = syscontext_cast(sysContext);
+    TSS2_RC                rval;
+
+    if (!ctx)
+        return TSS2_SYS_RC_BAD_REFERENCE;
+
+    rval = execute_finish(ctx, timeout);
+    TSS2_PROBE4(sys_execute_finish, sysContext, ctx->commandCode, ctx->rsp_header.responseSize,
+                rval);
+
+    return rval;
+}
+
 TSS2_RC
 Tss2_Sys_Execute(TSS2_SYS_CONTEXT *sysContext) {
     TSS2_RC rval;
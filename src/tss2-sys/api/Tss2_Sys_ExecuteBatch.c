@@ -0,0 +1,133 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for PRIx32
+#include <stddef.h>   // for size_t, NULL
+
+#include "sysapi_util.h"     // for _TSS2_SYS_CONTEXT_BLOB, syscontext_cast
+#include "tss2_common.h"     // for TSS2_RC, TSS2_SYS_RC_BAD_REFERENCE
+#include "tss2_sys.h"        // for TSS2_SYS_CONTEXT, Tss2_Sys_ExecuteBatch
+#include "tss2_tcti.h"       // for TSS2_TCTI_TIMEOUT_BLOCK
+#include "tss2_tpm2_types.h" // for TPM2_RC_RETRY, TPM2_RC_TESTING, TPM2_...
+
+#define LOGMODULE sys
+#include "util/log.h" // for LOG_DEBUG, LOG_ERROR, LOG_WARNING
+
+/* Number of submissions of a command answered with RETRY, TESTING or YIELDED */
+#define SYS_BATCH_MAX_SUBMISSIONS 5
+
+/* Resubmit a command as long as the TPM asks for it. TSS level errors are
+ * returned as is, TPM response codes are left for the completion callback. */
+static TSS2_RC
+resubmit(TSS2_SYS_CONTEXT *sysContext, TSS2_RC *responseCode) {
+    TSS2_RC rval;
+    int     submissions = 1;
+
+    while ((*responseCode == TPM2_RC_RETRY || *responseCode == TPM2_RC_TESTING
+            || *responseCode == TPM2_RC_YIELDED)
+           && submissions++ < SYS_BATCH_MAX_SUBMISSIONS) {
+        LOG_DEBUG("TPM returned %" PRIx32 ", resubmitting command", *responseCode);
+
+        rval = Tss2_Sys_ExecuteAsync(sysContext);
+        if (rval)
+            return rval;
+
+        rval = Tss2_Sys_ExecuteFinish(sysContext, TSS2_TCTI_TIMEOUT_BLOCK);
+        if (rval && (rval & TSS2_RC_LAYER_MASK) != TSS2_TPM_RC_LAYER)
+            return rval;
+
+        *responseCode = rval;
+    }
+
+    return TSS2_RC_SUCCESS;
+}
+
+/*
+ * Execute numCommands commands back to back over one TCTI. The commands are
+ * prepared by the prepare callback into the given SYS contexts in round robin
+ * order, so with two or more contexts the next command is marshaled while the
+ * TPM executes the current one. The response of each command is handed to the
+ * complete callback together with the TPM response code before the context is
+ * reused. All contexts must use the same TCTI, and since the next command is
+ * prepared before the previous response is processed, commands in a batch
+ * must not depend on each other's responses (e.g. rolling session nonces).
+ */
+TSS2_RC
+Tss2_Sys_ExecuteBatch(TSS2_SYS_CONTEXT *const   *sysContexts,
+                      size_t                     numContexts,
+                      size_t                     numCommands,
+                      TSS2_SYS_BATCH_PREPARE_FN  prepare,
+                      TSS2_SYS_BATCH_COMPLETE_FN complete,
+                      void                      *userData) {
+    TSS2_SYS_CONTEXT *current, *next;
+    TSS2_RC           rval, prepare_rval = TSS2_RC_SUCCESS;
+    TSS2_RC           responseCode = TSS2_RC_SUCCESS;
+    size_t            i;
+
+    if (!sysContexts || !prepare || !complete)
+        return TSS2_SYS_RC_BAD_REFERENCE;
+
+    if (numContexts == 0)
+        return TSS2_SYS_RC_BAD_VALUE;
+
+    for (i = 0; i < numContexts; i++) {
+        if (!sysContexts[i])
+            return TSS2_SYS_RC_BAD_REFERENCE;
+
+        if (syscontext_cast(sysContexts[i])->tctiContext
+            != syscontext_cast(sysContexts[0])->tctiContext) {
+            LOG_ERROR("All contexts of a batch must use the same TCTI");
+            return TSS2_SYS_RC_BAD_VALUE;
+        }
+    }
+
+    if (numCommands == 0)
+        return TSS2_RC_SUCCESS;
+
+    rval = prepare(sysContexts[0], 0, userData);
+    if (rval)
+        return rval;
+
+    for (i = 0; i < numCommands; i++) {
+        current = sysContexts[i % numContexts];
+        next = sysContexts[(i + 1) % numContexts];
+
+        rval = Tss2_Sys_ExecuteAsync(current);
+        if (rval)
+            return rval;
+
+        /* Marshal the next command while the TPM is busy with this one. */
+        if (i + 1 < numCommands && next != current)
+            prepare_rval = prepare(next, i + 1, userData);
+
+        rval = Tss2_Sys_ExecuteFinish(current, TSS2_TCTI_TIMEOUT_BLOCK);
+        if (rval && (rval & TSS2_RC_LAYER_MASK) != TSS2_TPM_RC_LAYER)
+            return rval;
+
+        responseCode = rval;
+        rval = resubmit(current, &responseCode);
+        if (rval)
+            return rval;
+
+        rval = complete(current, i, responseCode, userData);
+        if (rval)
+            return rval;
+
+        if (prepare_rval) {
+            LOG_WARNING("Preparing command %zu of the batch failed", i + 1);
+            return prepare_rval;
+        }
+
+        if (i + 1 < numCommands && next == current) {
+            rval = prepare(next, i + 1, userData);
+            if (rval)
+                return rval;
+        }
+    }
+
+    return TSS2_RC_SUCCESS;
+}
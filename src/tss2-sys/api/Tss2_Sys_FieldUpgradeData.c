@@ -38,10 +38,6 @@ Tss2_Sys_FieldUpgradeData_Prepare(TSS2_SYS_CONTEXT *sysContext, TPM2B_MAX_BUFFER
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 1;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -29,10 +29,6 @@ Tss2_Sys_FlushContext_Prepare(TSS2_SYS_CONTEXT *sysContext, TPMI_DH_CONTEXT flus
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 0;
-
     return CommonPrepareEpilogue(ctx);
 }
 
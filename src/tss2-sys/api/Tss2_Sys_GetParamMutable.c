@@ -0,0 +1,71 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint8_t
+
+#include "sysapi_util.h" // for _TSS2_SYS_CONTEXT_BLOB, syscontext_cast
+#include "tss2_common.h" // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_SYS_RC_BAD_R...
+#include "tss2_sys.h"    // for Tss2_Sys_GetDecryptParam, Tss2_Sys_GetEncryp...
+
+/*
+ * Like Tss2_Sys_GetDecryptParam(), but return a writable pointer to the
+ * buffer of the first command parameter, so that it can be encrypted in
+ * place instead of with Tss2_Sys_SetDecryptParam(). The pointer is valid
+ * until the next _Prepare call and the size must not be changed.
+ */
+TSS2_RC
+Tss2_Sys_GetDecryptParamMutable(TSS2_SYS_CONTEXT *sysContext,
+                                size_t           *decryptParamSize,
+                                uint8_t         **decryptParamBuffer) {
+    TSS2_SYS_CONTEXT_BLOB *ctx = syscontext_cast(sysContext);
+    const uint8_t         *buffer;
+    TSS2_RC                rval;
+
+    if (!decryptParamBuffer || !ctx)
+        return TSS2_SYS_RC_BAD_REFERENCE;
+
+    rval = Tss2_Sys_GetDecryptParam(sysContext, decryptParamSize, &buffer);
+    if (rval)
+        return rval;
+
+    if (buffer + *decryptParamSize > ctx->cmdBuffer + ctx->maxCmdSize)
+        return TSS2_SYS_RC_INSUFFICIENT_CONTEXT;
+
+    /* The parameter is part of the command buffer owned by the context */
+    *decryptParamBuffer = (uint8_t *)buffer;
+    return TSS2_RC_SUCCESS;
+}
+
+/*
+ * Like Tss2_Sys_GetEncryptParam(), but return a writable pointer to the
+ * buffer of the first response parameter, so that it can be decrypted in
+ * place instead of with Tss2_Sys_SetEncryptParam(). The pointer is valid
+ * until the next command is prepared and the size must not be changed.
+ */
+TSS2_RC
+Tss2_Sys_GetEncryptParamMutable(TSS2_SYS_CONTEXT *sysContext,
+                                size_t           *encryptParamSize,
+                                uint8_t         **encryptParamBuffer) {
+    TSS2_SYS_CONTEXT_BLOB *ctx = syscontext_cast(sysContext);
+    const uint8_t         *buffer;
+    TSS2_RC                rval;
+
+    if (!encryptParamBuffer || !ctx)
+        return TSS2_SYS_RC_BAD_REFERENCE;
+
+    rval = Tss2_Sys_GetEncryptParam(sysContext, encryptParamSize, &buffer);
+    if (rval)
+        return rval;
+
+    /* The size is taken from the response and must not exceed the buffer */
+    if (buffer + *encryptParamSize > ctx->cmdBuffer + ctx->maxCmdSize)
+        return TSS2_SYS_RC_MALFORMED_RESPONSE;
+
+    *encryptParamBuffer = (uint8_t *)buffer;
+    return TSS2_RC_SUCCESS;
+}
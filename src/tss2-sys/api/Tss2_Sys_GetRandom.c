@@ -29,10 +29,6 @@ Tss2_Sys_GetRandom_Prepare(TSS2_SYS_CONTEXT *sysContext, UINT16 bytesRequested)
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 1;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
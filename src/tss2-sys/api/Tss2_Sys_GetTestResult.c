@@ -26,10 +26,6 @@ Tss2_Sys_GetTestResult_Prepare(TSS2_SYS_CONTEXT *sysContext) {
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 1;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
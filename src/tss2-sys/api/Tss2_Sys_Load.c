@@ -62,10 +62,6 @@ Tss2_Sys_Load_Prepare(TSS2_SYS_CONTEXT    *sysContext,
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 1;
-    ctx->encryptAllowed = 1;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -52,10 +52,6 @@ Tss2_Sys_MAC_Start_Prepare(TSS2_SYS_CONTEXT   *sysContext,
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 1;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
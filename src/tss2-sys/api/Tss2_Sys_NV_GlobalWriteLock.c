@@ -30,10 +30,6 @@ Tss2_Sys_NV_GlobalWriteLock_Prepare(TSS2_SYS_CONTEXT *sysContext, TPMI_RH_PROVIS
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
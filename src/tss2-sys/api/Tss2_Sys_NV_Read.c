@@ -46,10 +46,6 @@ Tss2_Sys_NV_Read_Prepare(TSS2_SYS_CONTEXT *sysContext,
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 1;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -69,6 +65,24 @@ Tss2_Sys_NV_Read_Complete(TSS2_SYS_CONTEXT *sysContext, TPM2B_MAX_NV_BUFFER *dat
                                                  data);
 }
 
+TSS2_RC
+Tss2_Sys_NV_Read_CompleteView(TSS2_SYS_CONTEXT *sysContext,
+                              const uint8_t   **data,
+                              UINT16           *dataSize) {
+    TSS2_SYS_CONTEXT_BLOB *ctx = syscontext_cast(sysContext);
+    TSS2_RC                rval;
+
+    if (!ctx || !data || !dataSize)
+        return TSS2_SYS_RC_BAD_REFERENCE;
+
+    rval = CommonComplete(ctx);
+    if (rval)
+        return rval;
+
+    return Tss2_MU_TPM2B_MAX_NV_BUFFER_UnmarshalView(ctx->cmdBuffer, ctx->maxCmdSize,
+                                                     &ctx->nextData, data, dataSize);
+}
+
 TSS2_RC
 Tss2_Sys_NV_Read(TSS2_SYS_CONTEXT             *sysContext,
                  TPMI_RH_NV_AUTH               authHandle,
@@ -30,10 +30,6 @@ Tss2_Sys_NV_ReadPublic_Prepare(TSS2_SYS_CONTEXT *sysContext, TPMI_RH_NV_INDEX nv
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 1;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -54,10 +54,6 @@ Tss2_Sys_NV_Write_Prepare(TSS2_SYS_CONTEXT          *sysContext,
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 1;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -31,10 +31,6 @@ Tss2_Sys_PCR_Read_Prepare(TSS2_SYS_CONTEXT *sysContext, const TPML_PCR_SELECTION
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
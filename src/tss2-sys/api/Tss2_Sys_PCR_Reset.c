@@ -30,10 +30,6 @@ Tss2_Sys_PCR_Reset_Prepare(TSS2_SYS_CONTEXT *sysContext, TPMI_DH_PCR pcrHandle)
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
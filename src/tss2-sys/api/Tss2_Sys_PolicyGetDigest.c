@@ -30,10 +30,6 @@ Tss2_Sys_PolicyGetDigest_Prepare(TSS2_SYS_CONTEXT *sysContext, TPMI_SH_POLICY po
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 1;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -89,10 +89,6 @@ Tss2_Sys_PolicyTicket_Prepare(TSS2_SYS_CONTEXT    *sysContext,
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 1;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -30,10 +30,6 @@ Tss2_Sys_Shutdown_Prepare(TSS2_SYS_CONTEXT *sysContext, TPM2_SU shutdownType) {
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
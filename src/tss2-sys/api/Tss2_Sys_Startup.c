@@ -30,10 +30,6 @@ Tss2_Sys_Startup_Prepare(TSS2_SYS_CONTEXT *sysContext, TPM2_SU startupType) {
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 0;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -38,10 +38,6 @@ Tss2_Sys_StirRandom_Prepare(TSS2_SYS_CONTEXT *sysContext, const TPM2B_SENSITIVE_
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 1;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -31,10 +31,6 @@ Tss2_Sys_TestParms_Prepare(TSS2_SYS_CONTEXT *sysContext, const TPMT_PUBLIC_PARMS
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 0;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
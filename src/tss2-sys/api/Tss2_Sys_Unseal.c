@@ -30,10 +30,6 @@ Tss2_Sys_Unseal_Prepare(TSS2_SYS_CONTEXT *sysContext, TPMI_DH_OBJECT itemHandle)
     if (rval)
         return rval;
 
-    ctx->decryptAllowed = 0;
-    ctx->encryptAllowed = 1;
-    ctx->authAllowed = 1;
-
     return CommonPrepareEpilogue(ctx);
 }
 
@@ -53,6 +49,24 @@ Tss2_Sys_Unseal_Complete(TSS2_SYS_CONTEXT *sysContext, TPM2B_SENSITIVE_DATA *out
                                                   outData);
 }
 
+TSS2_RC
+Tss2_Sys_Unseal_CompleteView(TSS2_SYS_CONTEXT *sysContext,
+                             const uint8_t   **outData,
+                             UINT16           *outDataSize) {
+    TSS2_SYS_CONTEXT_BLOB *ctx = syscontext_cast(sysContext);
+    TSS2_RC                rval;
+
+    if (!ctx || !outData || !outDataSize)
+        return TSS2_SYS_RC_BAD_REFERENCE;
+
+    rval = CommonComplete(ctx);
+    if (rval)
+        return rval;
+
+    return Tss2_MU_TPM2B_SENSITIVE_DATA_UnmarshalView(ctx->cmdBuffer, ctx->maxCmdSize,
+                                                      &ctx->nextData, outData, outDataSize);
+}
+
 TSS2_RC
 Tss2_Sys_Unseal(TSS2_SYS_CONTEXT             *sysContext,
                 TPMI_DH_OBJECT                itemHandle,
@@ -61,6 +61,26 @@ typedef struct {
     size_t nextData;
 } TSS2_SYS_CONTEXT_BLOB;
 
+/*
+ * A prepared command without authorization area and the SYS state that
+ * belongs to it. The marshaled command follows the fixed fields.
+ */
+struct TSS2_SYS_CMD_TEMPLATE {
+    TPM2_CC commandCode;   /* In host endian */
+    UINT32  commandSize;   /* Size of the marshaled command in buffer */
+    UINT32  cpBufferStart; /* Offset of the command parameters in buffer */
+    UINT8   numResponseHandles;
+
+    struct {
+        UINT16 decryptAllowed : 1;
+        UINT16 encryptAllowed : 1;
+        UINT16 decryptNull : 1;
+        UINT16 authAllowed : 1;
+    };
+
+    UINT8 buffer[];
+};
+
 static inline TSS2_SYS_CONTEXT_BLOB *
 syscontext_cast(TSS2_SYS_CONTEXT *ctx) {
     return (TSS2_SYS_CONTEXT_BLOB *)ctx;
@@ -76,12 +96,6 @@ req_header_from_cxt(TSS2_SYS_CONTEXT_BLOB *ctx) {
     return (TPM20_Header_In *)ctx->cmdBuffer;
 }
 
-typedef struct {
-    TPM2_CC commandCode;
-    int     numCommandHandles;
-    int     numResponseHandles;
-} COMMAND_HANDLES;
-
 #ifdef __cplusplus
 extern "C" {
 #endif
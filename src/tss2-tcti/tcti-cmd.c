@@ -396,6 +396,7 @@ tcti_cmd_transmit(TSS2_TCTI_CONTEXT *tcti_ctx, size_t size, const uint8_t *cmd_b
 
     fflush(tcti_cmd->sink);
 
+    TCTI_PROBE_TRANSMIT("cmd", tcti_common, size);
     tcti_common->state = TCTI_STATE_RECEIVE;
 
     return rc;
@@ -542,6 +543,7 @@ tcti_cmd_receive(TSS2_TCTI_CONTEXT *tctiContext,
      */
 out:
     tcti_common->header.size = 0;
+    TCTI_PROBE_RECEIVE("cmd", tcti_common, *response_size, rc);
     tcti_common->state = TCTI_STATE_TRANSMIT;
 
     return rc;
@@ -13,6 +13,7 @@
 #include "tss2_common.h"     // for UINT32, TSS2_RC
 #include "tss2_tcti.h"       // for TSS2_TCTI_CONTEXT, TSS2_TCTI_CONTEXT_CO...
 #include "tss2_tpm2_types.h" // for TPM2_ST, TPM2_HANDLE
+#include "util/probe.h"      // for TSS2_PROBE3, TSS2_PROBE4
 
 #define TCTI_VERSION    0x2
 
@@ -23,6 +24,18 @@ typedef struct {
     UINT32  size;
     UINT32  code;
 } tpm_header_t;
+
+/*
+ * Static tracepoints fired by every TCTI when a command was sent to the TPM
+ * (transition to RECEIVE) and when a response was received or the receive
+ * failed unrecoverably (transition back to TRANSMIT). The name argument is
+ * the TCTI name; the cast turns the string literal into a pointer argument.
+ */
+#define TCTI_PROBE_TRANSMIT(name, common, size)                                                    \
+    TSS2_PROBE3(tcti_transmit, (const char *)(name), (common), (size))
+#define TCTI_PROBE_RECEIVE(name, common, size, rc)                                                 \
+    TSS2_PROBE4(tcti_receive, (const char *)(name), (common), (size), (rc))
+
 /*
  * The elements in this enumeration represent the possible states that the
  * TCTI can be in. The state machine is as follows:
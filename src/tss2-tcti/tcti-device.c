@@ -112,6 +112,7 @@ tcti_device_transmit(TSS2_TCTI_CONTEXT *tctiContext,
         return TSS2_TCTI_RC_IO_ERROR;
     }
 
+    TCTI_PROBE_TRANSMIT("device", tcti_common, command_size);
     tcti_common->state = TCTI_STATE_RECEIVE;
     return TSS2_RC_SUCCESS;
 }
@@ -288,6 +289,7 @@ tcti_device_receive(TSS2_TCTI_CONTEXT *tctiContext,
      * another command is sent to the TPM.
      */
 out:
+    TCTI_PROBE_RECEIVE("device", tcti_common, *response_size, rc);
     tcti_common->state = TCTI_STATE_TRANSMIT;
 
     return rc;
@@ -33,12 +33,14 @@
 #include "tss2_common.h"          // for TSS2_RC_SUCCESS, TSS2_RC, TSS2_TCT...
 #include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_INFO
 #include "tss2_tcti_i2c_helper.h" // for TSS2_TCTI_I2C_HELPER_PLATFORM, Tss...
+#include "util/tpm2_cc_info.h"    // for tpm2_cc_info_poll_interval
 #include "util/tss2_endian.h"     // for LE_TO_HOST_32, LE_TO_HOST_16, HOST...
 
 #define LOGMODULE tcti
 #include "util/log.h" // for LOG_ERROR, LOG_DEBUG, return_if_error
 
-#define TIMEOUT_B 2000 /* The default timeout value as specified in the TCG spec. */
+#define TIMEOUT_B     2000 /* The default timeout value as specified in the TCG spec. */
+#define POLL_INTERVAL 8    /* The default delay between two status polls in ms. */
 
 /*
  * CRC-CCITT KERMIT with following parameters:
@@ -462,7 +464,8 @@ static TSS2_RC
 i2c_tpm_helper_wait_for_status(TSS2_TCTI_I2C_HELPER_CONTEXT *ctx,
                                uint32_t                      status_mask,
                                uint32_t                      status_expected,
-                               int32_t                       timeout) {
+                               int32_t                       timeout,
+                               int                           poll_interval) {
     TSS2_RC  rc;
     uint32_t status;
     bool     blocking = (timeout == TSS2_TCTI_TIMEOUT_BLOCK);
@@ -479,8 +482,8 @@ i2c_tpm_helper_wait_for_status(TSS2_TCTI_I2C_HELPER_CONTEXT *ctx,
         if ((status & status_mask) == status_expected) {
             return TSS2_RC_SUCCESS;
         }
-        /* Delay next poll by 8ms to avoid spamming the TPM */
-        rc = i2c_tpm_helper_delay_ms(ctx, 8);
+        /* Delay next poll to avoid spamming the TPM */
+        rc = i2c_tpm_helper_delay_ms(ctx, poll_interval);
         return_if_error(rc, "i2c_tpm_helper_delay_ms");
 
         rc = i2c_tpm_helper_timeout_expired(ctx, &is_timeout_expired);
@@ -576,12 +579,16 @@ tcti_i2c_helper_transmit(TSS2_TCTI_CONTEXT *tcti_ctx, size_t size, const uint8_t
     LOGBLOB_DEBUG(cmd_buf, size, "Sending command with TPM_CC %#" PRIx32 " and size %" PRIu32,
                   header.code, header.size);
 
+    /* Poll for the response at a rate that matches the expected command duration */
+    ctx->poll_interval = tpm2_cc_info_poll_interval(header.code);
+
     /* Tell TPM to expect command */
     i2c_tpm_helper_write_sts_reg(ctx, TCTI_I2C_HELPER_TPM_STS_COMMAND_READY);
 
     /* Wait until ready bit is set by TPM device */
     uint32_t expected_status_bits = TCTI_I2C_HELPER_TPM_STS_COMMAND_READY;
-    rc = i2c_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits, TIMEOUT_B);
+    rc = i2c_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits, TIMEOUT_B,
+                                        POLL_INTERVAL);
     if (rc != TSS2_RC_SUCCESS) {
         LOG_ERROR("Failed waiting for TPM to become ready");
         return rc;
@@ -600,6 +607,7 @@ tcti_i2c_helper_transmit(TSS2_TCTI_CONTEXT *tcti_ctx, size_t size, const uint8_t
     /* Tell TPM to start processing the command */
     i2c_tpm_helper_write_sts_reg(ctx, TCTI_I2C_HELPER_TPM_STS_GO);
 
+    TCTI_PROBE_TRANSMIT("i2c-helper", tcti_common, size);
     tcti_common->state = TCTI_STATE_RECEIVE;
     return TSS2_RC_SUCCESS;
 }
@@ -633,7 +641,7 @@ tcti_i2c_helper_receive(TSS2_TCTI_CONTEXT *tcti_context,
     if (tcti_common->header.size == 0) {
         /* Wait for response to be ready */
         rc = i2c_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits,
-                                            timeout);
+                                            timeout, ctx->poll_interval);
         if (rc != TSS2_RC_SUCCESS) {
             LOG_ERROR("Failed waiting for status");
             /* Return rc from wait_for_status(). May be TRY_AGAIN after timeout. */
@@ -713,6 +721,7 @@ tcti_i2c_helper_receive(TSS2_TCTI_CONTEXT *tcti_context,
     i2c_tpm_helper_write_sts_reg(ctx, TCTI_I2C_HELPER_TPM_STS_COMMAND_READY);
 
     tcti_common->header.size = 0;
+    TCTI_PROBE_RECEIVE("i2c-helper", tcti_common, *response_size, TSS2_RC_SUCCESS);
     tcti_common->state = TCTI_STATE_TRANSMIT;
 
     return TSS2_RC_SUCCESS;
@@ -804,6 +813,7 @@ Tss2_Tcti_I2c_Helper_Init(TSS2_TCTI_CONTEXT             *tcti_context,
 
     /* Copy platform struct into context */
     tcti_i2c_helper->platform = *platform_conf;
+    tcti_i2c_helper->poll_interval = POLL_INTERVAL;
 
     /* Probe TPM */
     TSS2_TCTI_I2C_HELPER_CONTEXT *ctx = tcti_i2c_helper;
@@ -850,7 +860,8 @@ Tss2_Tcti_I2c_Helper_Init(TSS2_TCTI_CONTEXT             *tcti_context,
     /* Wait up to TIMEOUT_B for TPM to become ready */
     LOG_DEBUG("Waiting for TPM to become ready...");
     uint32_t expected_status_bits = TCTI_I2C_HELPER_TPM_STS_COMMAND_READY;
-    rc = i2c_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits, TIMEOUT_B);
+    rc = i2c_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits, TIMEOUT_B,
+                                        POLL_INTERVAL);
     if (rc == TSS2_TCTI_RC_TRY_AGAIN) {
         /*
          * TPM did not auto transition into ready state,
@@ -858,7 +869,7 @@ Tss2_Tcti_I2c_Helper_Init(TSS2_TCTI_CONTEXT             *tcti_context,
          */
         i2c_tpm_helper_write_sts_reg(ctx, TCTI_I2C_HELPER_TPM_STS_COMMAND_READY);
         rc = i2c_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits,
-                                            TIMEOUT_B);
+                                            TIMEOUT_B, POLL_INTERVAL);
     }
     if (rc != TSS2_RC_SUCCESS) {
         LOG_ERROR("Failed waiting for TPM to become ready");
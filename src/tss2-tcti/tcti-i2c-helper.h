@@ -37,6 +37,7 @@ typedef struct {
     bool                          guard_time_read;
     bool                          guard_time_write;
     uint8_t                       guard_time;
+    int                           poll_interval; /* Status poll delay for the current command in ms */
     char                          header[TCTI_I2C_HELPER_RESP_HEADER_SIZE];
 } TSS2_TCTI_I2C_HELPER_CONTEXT;
 
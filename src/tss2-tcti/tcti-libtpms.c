@@ -264,6 +264,7 @@ tcti_libtpms_transmit(TSS2_TCTI_CONTEXT *tcti_ctx, size_t size, const uint8_t *c
     tcti_libtpms->response_len = resp_size;
     tcti_libtpms->response_buffer_len = respbufsize;
 
+    TCTI_PROBE_TRANSMIT("libtpms", tcti_common, size);
     tcti_common->state = TCTI_STATE_RECEIVE;
 
     return TSS2_RC_SUCCESS;
@@ -388,6 +389,7 @@ tcti_libtpms_receive(TSS2_TCTI_CONTEXT *tctiContext,
     tcti_libtpms->response_buffer_len = 0;
     tcti_libtpms->response_len = 0;
 
+    TCTI_PROBE_RECEIVE("libtpms", tcti_common, *response_size, TSS2_RC_SUCCESS);
     tcti_common->state = TCTI_STATE_TRANSMIT;
 
     return TSS2_RC_SUCCESS;
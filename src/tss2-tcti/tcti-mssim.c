@@ -202,6 +202,7 @@ tcti_mssim_transmit(TSS2_TCTI_CONTEXT *tcti_ctx, size_t size, const uint8_t *cmd
         return rc;
     }
 
+    TCTI_PROBE_TRANSMIT("mssim", tcti_common, size);
     tcti_common->state = TCTI_STATE_RECEIVE;
 
     return rc;
@@ -411,6 +412,7 @@ tcti_mssim_receive(TSS2_TCTI_CONTEXT *tctiContext,
      */
 out:
     tcti_common->header.size = 0;
+    TCTI_PROBE_RECEIVE("mssim", tcti_common, *response_size, rc);
     tcti_common->state = TCTI_STATE_TRANSMIT;
 
     return rc;
@@ -16,12 +16,14 @@
 #include "tss2_common.h"          // for TSS2_RC_SUCCESS, TSS2_RC, TSS2_TCT...
 #include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_INFO
 #include "tss2_tcti_spi_helper.h" // for TSS2_TCTI_SPI_HELPER_PLATFORM, Tss...
+#include "util/tpm2_cc_info.h"    // for tpm2_cc_info_poll_interval
 #include "util/tss2_endian.h"     // for LE_TO_HOST_32
 
 #define LOGMODULE tcti
 #include "util/log.h" // for LOG_ERROR, LOG_DEBUG, return_if_error
 
-#define TIMEOUT_B 2000 // The default timeout value as specified in the TCG spec
+#define TIMEOUT_B     2000 // The default timeout value as specified in the TCG spec
+#define POLL_INTERVAL 8    // The default delay between two status polls in ms
 
 static inline TSS2_RC
 spi_tpm_helper_delay_ms(TSS2_TCTI_SPI_HELPER_CONTEXT *ctx, int milliseconds) {
@@ -407,7 +409,8 @@ static TSS2_RC
 spi_tpm_helper_wait_for_status(TSS2_TCTI_SPI_HELPER_CONTEXT *ctx,
                                uint32_t                      status_mask,
                                uint32_t                      status_expected,
-                               int32_t                       timeout) {
+                               int32_t                       timeout,
+                               int                           poll_interval) {
     TSS2_RC  rc;
     uint32_t status;
     bool     blocking = (timeout == TSS2_TCTI_TIMEOUT_BLOCK);
@@ -424,8 +427,8 @@ spi_tpm_helper_wait_for_status(TSS2_TCTI_SPI_HELPER_CONTEXT *ctx,
         if ((status & status_mask) == status_expected) {
             return TSS2_RC_SUCCESS;
         }
-        // Delay next poll by 8ms to avoid spamming the TPM
-        rc = spi_tpm_helper_delay_ms(ctx, 8);
+        // Delay next poll to avoid spamming the TPM
+        rc = spi_tpm_helper_delay_ms(ctx, poll_interval);
         return_if_error(rc, "spi_tpm_helper_delay_ms");
 
         rc = spi_tpm_helper_timeout_expired(ctx, &is_timeout_expired);
@@ -551,7 +554,7 @@ tcti_spi_helper_receive(TSS2_TCTI_CONTEXT *tcti_context,
     if (tcti_common->header.size == 0) {
         // Wait for response to be ready
         rc = spi_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits,
-                                            timeout);
+                                            timeout, ctx->poll_interval);
         if (rc != TSS2_RC_SUCCESS) {
             LOG_ERROR("Failed waiting for status");
             // Return rc from wait_for_status(). May be TRY_AGAIN after timeout.
@@ -624,6 +627,7 @@ tcti_spi_helper_receive(TSS2_TCTI_CONTEXT *tcti_context,
     spi_tpm_helper_write_sts_reg(ctx, TCTI_SPI_HELPER_TPM_STS_COMMAND_READY);
 
     tcti_common->header.size = 0;
+    TCTI_PROBE_RECEIVE("spi-helper", tcti_common, *response_size, TSS2_RC_SUCCESS);
     tcti_common->state = TCTI_STATE_TRANSMIT;
 
     return TSS2_RC_SUCCESS;
@@ -673,12 +677,16 @@ tcti_spi_helper_transmit(TSS2_TCTI_CONTEXT *tcti_ctx, size_t size, const uint8_t
     LOGBLOB_DEBUG(cmd_buf, size, "Sending command with TPM_CC %#" PRIx32 " and size %" PRIu32,
                   header.code, header.size);
 
+    // Poll for the response at a rate that matches the expected command duration
+    ctx->poll_interval = tpm2_cc_info_poll_interval(header.code);
+
     // Tell TPM to expect command
     spi_tpm_helper_write_sts_reg(ctx, TCTI_SPI_HELPER_TPM_STS_COMMAND_READY);
 
     // Wait until ready bit is set by TPM device
     uint32_t expected_status_bits = TCTI_SPI_HELPER_TPM_STS_COMMAND_READY;
-    rc = spi_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits, TIMEOUT_B);
+    rc = spi_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits, TIMEOUT_B,
+                                        POLL_INTERVAL);
     if (rc != TSS2_RC_SUCCESS) {
         LOG_ERROR("Failed waiting for TPM to become ready");
         return rc;
@@ -690,6 +698,7 @@ tcti_spi_helper_transmit(TSS2_TCTI_CONTEXT *tcti_ctx, size_t size, const uint8_t
     // Tell TPM to start processing the command
     spi_tpm_helper_write_sts_reg(ctx, TCTI_SPI_HELPER_TPM_STS_GO);
 
+    TCTI_PROBE_TRANSMIT("spi-helper", tcti_common, size);
     tcti_common->state = TCTI_STATE_RECEIVE;
     return TSS2_RC_SUCCESS;
 }
@@ -766,6 +775,7 @@ Tss2_Tcti_Spi_Helper_Init(TSS2_TCTI_CONTEXT             *tcti_context,
 
     // Copy platform struct into context
     tcti_spi_helper->platform = *platform_conf;
+    tcti_spi_helper->poll_interval = POLL_INTERVAL;
 
     // Probe TPM
     TSS2_TCTI_SPI_HELPER_CONTEXT *ctx = tcti_spi_helper;
@@ -796,7 +806,8 @@ Tss2_Tcti_Spi_Helper_Init(TSS2_TCTI_CONTEXT             *tcti_context,
     // Wait up to TIMEOUT_B for TPM to become ready
     LOG_DEBUG("Waiting for TPM to become ready...");
     uint32_t expected_status_bits = TCTI_SPI_HELPER_TPM_STS_COMMAND_READY;
-    rc = spi_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits, TIMEOUT_B);
+    rc = spi_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits, TIMEOUT_B,
+                                        POLL_INTERVAL);
     if (rc == TSS2_TCTI_RC_TRY_AGAIN) {
         /*
          * TPM did not auto transition into ready state,
@@ -804,7 +815,7 @@ Tss2_Tcti_Spi_Helper_Init(TSS2_TCTI_CONTEXT             *tcti_context,
          */
         spi_tpm_helper_write_sts_reg(ctx, TCTI_SPI_HELPER_TPM_STS_COMMAND_READY);
         rc = spi_tpm_helper_wait_for_status(ctx, expected_status_bits, expected_status_bits,
-                                            TIMEOUT_B);
+                                            TIMEOUT_B, POLL_INTERVAL);
     }
     if (rc != TSS2_RC_SUCCESS) {
         LOG_ERROR("Failed waiting for TPM to become ready");
@@ -14,6 +14,7 @@
 typedef struct {
     TSS2_TCTI_COMMON_CONTEXT      common;
     TSS2_TCTI_SPI_HELPER_PLATFORM platform;
+    int                           poll_interval; /* Status poll delay for the current command in ms */
     char                          header[TCTI_SPI_HELPER_RESP_HEADER_SIZE];
 } TSS2_TCTI_SPI_HELPER_CONTEXT;
 
@@ -285,6 +285,7 @@ tcti_swtpm_transmit(TSS2_TCTI_CONTEXT *tcti_ctx, size_t size, const uint8_t *cmd
         return rc;
     }
 
+    TCTI_PROBE_TRANSMIT("swtpm", tcti_common, size);
     tcti_common->state = TCTI_STATE_RECEIVE;
 
     return rc;
@@ -439,6 +440,7 @@ out:
     socket_close(&tcti_swtpm->tpm_sock);
 
     tcti_common->header.size = 0;
+    TCTI_PROBE_RECEIVE("swtpm", tcti_common, *response_size, rc);
     tcti_common->state = TCTI_STATE_TRANSMIT;
 
     return rc;
@@ -72,6 +72,7 @@ tcti_tbs_transmit(TSS2_TCTI_CONTEXT *tctiContext,
     memcpy(tcti_tbs->commandBuffer, command_buffer, command_size);
     tcti_tbs->commandSize = command_size;
 
+    TCTI_PROBE_TRANSMIT("tbs", tcti_common, command_size);
     tcti_common->state = TCTI_STATE_RECEIVE;
     return TSS2_RC_SUCCESS;
 }
@@ -160,6 +161,7 @@ tcti_tbs_receive(TSS2_TCTI_CONTEXT *tctiContext,
      * another command is sent to the TPM.
      */
 out:
+    TCTI_PROBE_RECEIVE("tbs", tcti_common, *response_size, rc);
     tcti_common->state = TCTI_STATE_TRANSMIT;
     return rc;
 }
@@ -16,6 +16,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef LOG_ASYNC_ENABLED
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
 #define LOGMODULE log
 #include "log.h"
 
@@ -113,6 +119,346 @@ getLogFile(void) {
 #endif
 }
 
+#ifdef LOG_ASYNC_ENABLED
+/*
+ * Asynchronous logging, enabled with TSS2_LOG_ASYNC=1 (wait for a free slot
+ * if the ring is full) or TSS2_LOG_ASYNC=drop (drop the message and count
+ * it). Threads format their records into the slots of a bounded lock free
+ * multi producer, single consumer ring. A writer thread copies the records
+ * into batches and writes each batch with a single write() call. Threads
+ * that wait for a free slot or for their record to be written sleep on the
+ * space condition, which the writer broadcasts after each batch. Error
+ * messages are flushed before doLog() returns and the ring is drained when
+ * the library is unloaded or the process exits.
+ *
+ * Every library links its own copy of this file, so each library that logs
+ * asynchronously has its own ring and writer thread.
+ */
+#define LOG_ASYNC_SLOTS       1024 /* must be a power of two */
+#define LOG_ASYNC_RECORD_SIZE 512
+#define LOG_ASYNC_BATCH_SIZE  (16 * LOG_ASYNC_RECORD_SIZE)
+#define LOG_ASYNC_IDLE_NS     10000000
+
+typedef enum {
+    LOG_ASYNC_OFF = 0,
+    LOG_ASYNC_BLOCK,
+    LOG_ASYNC_DROP,
+} log_async_policy;
+
+typedef struct {
+    size_t seq;
+    size_t len;
+    char   data[LOG_ASYNC_RECORD_SIZE];
+} log_record;
+
+static struct {
+    log_async_policy policy;
+    log_record      *ring;
+    size_t           enqueue_pos;
+    size_t           dequeue_pos;
+    size_t           written_pos;
+    size_t           dropped;
+    int              running;
+    int              stop;
+    int              idle;
+    int              waiters;
+    int              fd;
+    pthread_t        thread;
+    pthread_mutex_t  lock;
+    pthread_cond_t   wake;
+    pthread_cond_t   space;
+} log_async = { .lock = PTHREAD_MUTEX_INITIALIZER,
+                .wake = PTHREAD_COND_INITIALIZER,
+                .space = PTHREAD_COND_INITIALIZER };
+
+static pthread_once_t log_async_once = PTHREAD_ONCE_INIT;
+
+static void
+log_async_wake(void) {
+    if (__atomic_load_n(&log_async.idle, __ATOMIC_ACQUIRE))
+        pthread_cond_signal(&log_async.wake);
+}
+
+/* Wake the threads waiting in log_async_block(). */
+static void
+log_async_wake_waiters(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&log_async.waiters, __ATOMIC_SEQ_CST) == 0)
+        return;
+    pthread_mutex_lock(&log_async.lock);
+    pthread_cond_broadcast(&log_async.space);
+    pthread_mutex_unlock(&log_async.lock);
+}
+
+static void
+log_async_write(const char *data, size_t len) {
+    ssize_t n;
+
+    while (len > 0) {
+        n = write(log_async.fd, data, len);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return;
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+static void *
+log_async_writer(void *arg) {
+    static char      batch[LOG_ASYNC_BATCH_SIZE];
+    log_record      *record;
+    struct timespec  ts;
+    size_t           used, dropped;
+    int              stop;
+
+    (void)arg;
+    for (;;) {
+        used = 0;
+        while (used + LOG_ASYNC_RECORD_SIZE <= sizeof(batch)) {
+            record = &log_async.ring[log_async.dequeue_pos & (LOG_ASYNC_SLOTS - 1)];
+            if (__atomic_load_n(&record->seq, __ATOMIC_ACQUIRE) != log_async.dequeue_pos + 1)
+                break;
+            memcpy(&batch[used], record->data, record->len);
+            used += record->len;
+            __atomic_store_n(&record->seq, log_async.dequeue_pos + LOG_ASYNC_SLOTS,
+                             __ATOMIC_RELEASE);
+            log_async.dequeue_pos++;
+        }
+
+        if (used > 0) {
+            log_async_write(batch, used);
+            __atomic_store_n(&log_async.written_pos, log_async.dequeue_pos, __ATOMIC_RELEASE);
+            log_async_wake_waiters();
+            continue;
+        }
+
+        dropped = __atomic_exchange_n(&log_async.dropped, 0, __ATOMIC_RELAXED);
+        if (dropped > 0) {
+            used = snprintf(batch, sizeof(batch),
+                            "WARNING:log:%s:%d:%s() %zu log messages dropped \n", __FILE__,
+                            __LINE__, __func__, dropped);
+            log_async_write(batch, used);
+        }
+
+        stop = __atomic_load_n(&log_async.stop, __ATOMIC_ACQUIRE);
+        if (stop)
+            break;
+
+        pthread_mutex_lock(&log_async.lock);
+        __atomic_store_n(&log_async.idle, 1, __ATOMIC_RELEASE);
+        clock_gettime(CLOCK_REALTIME, &ts);
+        if (ts.tv_nsec < 1000000000 - LOG_ASYNC_IDLE_NS) {
+            ts.tv_nsec += LOG_ASYNC_IDLE_NS;
+        } else {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000 - LOG_ASYNC_IDLE_NS;
+        }
+        pthread_cond_timedwait(&log_async.wake, &log_async.lock, &ts);
+        __atomic_store_n(&log_async.idle, 0, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&log_async.lock);
+    }
+
+    return NULL;
+}
+
+/* The writer thread does not survive fork(), the child logs synchronously. */
+static void
+log_async_atfork_child(void) {
+    log_async.running = 0;
+}
+
+static void
+log_async_init(void) {
+    const char *env = getenv("TSS2_LOG_ASYNC");
+    size_t      i;
+
+    if (env == NULL || !strcmp(env, "0"))
+        return;
+
+    log_async.policy = !case_insensitive_strncmp(env, "drop", 5) ? LOG_ASYNC_DROP
+                                                                 : LOG_ASYNC_BLOCK;
+    log_async.ring = calloc(LOG_ASYNC_SLOTS, sizeof(*log_async.ring));
+    if (log_async.ring == NULL)
+        return;
+    for (i = 0; i < LOG_ASYNC_SLOTS; i++)
+        log_async.ring[i].seq = i;
+
+    log_async.fd = fileno(getLogFile());
+    if (pthread_create(&log_async.thread, NULL, log_async_writer, NULL) != 0) {
+        free(log_async.ring);
+        log_async.ring = NULL;
+        return;
+    }
+    pthread_atfork(NULL, NULL, log_async_atfork_child);
+    log_async.running = 1;
+}
+
+static int
+log_async_written(size_t pos) {
+    return (ssize_t)(__atomic_load_n(&log_async.written_pos, __ATOMIC_SEQ_CST) - pos) >= 0;
+}
+
+static int
+log_async_slot_free(size_t pos) {
+    log_record *record = &log_async.ring[pos & (LOG_ASYNC_SLOTS - 1)];
+
+    return (ssize_t)(__atomic_load_n(&record->seq, __ATOMIC_SEQ_CST) - pos) >= 0;
+}
+
+/*
+ * Sleep until ready(pos) holds or the writer stops. The waiter count is
+ * raised before ready() is checked, so the writer either sees the waiter
+ * and broadcasts the space condition or the check sees the writer's progress.
+ */
+static void
+log_async_block(int (*ready)(size_t), size_t pos) {
+    pthread_mutex_lock(&log_async.lock);
+    __atomic_fetch_add(&log_async.waiters, 1, __ATOMIC_SEQ_CST);
+    while (!ready(pos) && !__atomic_load_n(&log_async.stop, __ATOMIC_SEQ_CST)) {
+        pthread_cond_signal(&log_async.wake);
+        pthread_cond_wait(&log_async.space, &log_async.lock);
+    }
+    __atomic_fetch_sub(&log_async.waiters, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&log_async.lock);
+}
+
+/* Wait until the writer has written everything up to position pos. */
+static void
+log_async_wait(size_t pos) {
+    if (!log_async.running || log_async_written(pos))
+        return;
+    log_async_block(log_async_written, pos);
+}
+
+/*
+ * Claim the next free slot of the ring. Returns NULL if the message was
+ * dropped or the writer stopped while the ring was full, otherwise the slot
+ * and its position in the ring.
+ */
+static log_record *
+log_async_reserve(size_t *pos) {
+    log_record *record;
+    size_t      seq;
+
+    *pos = __atomic_load_n(&log_async.enqueue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        record = &log_async.ring[*pos & (LOG_ASYNC_SLOTS - 1)];
+        seq = __atomic_load_n(&record->seq, __ATOMIC_ACQUIRE);
+        if (seq == *pos) {
+            if (__atomic_compare_exchange_n(&log_async.enqueue_pos, pos, *pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                return record;
+        } else if ((ssize_t)(seq - *pos) < 0) {
+            /* The ring is full */
+            if (log_async.policy == LOG_ASYNC_DROP) {
+                __atomic_fetch_add(&log_async.dropped, 1, __ATOMIC_RELAXED);
+                return NULL;
+            }
+            /* The writer no longer drains the ring after shutdown */
+            if (__atomic_load_n(&log_async.stop, __ATOMIC_ACQUIRE))
+                return NULL;
+            log_async_block(log_async_slot_free, *pos);
+            *pos = __atomic_load_n(&log_async.enqueue_pos, __ATOMIC_RELAXED);
+        } else {
+            *pos = __atomic_load_n(&log_async.enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/*
+ * Format a log record into the ring. If module is not NULL, the record starts
+ * with the header of doLog(), so the message is formatted only once, in its
+ * slot. Returns 0 if async logging is not enabled or not running, or if the
+ * writer stopped while the ring was full, in which case the caller writes
+ * synchronously. Records longer than a slot are truncated.
+ */
+static int
+log_async_vprintf(log_level   loglevel,
+                  const char *module,
+                  const char *file,
+                  const char *func,
+                  int         line,
+                  const char *fmt,
+                  va_list     vaargs) {
+    log_record *record;
+    size_t      pos, len = 0;
+    int         n;
+
+    pthread_once(&log_async_once, log_async_init);
+    if (!log_async.running || __atomic_load_n(&log_async.stop, __ATOMIC_ACQUIRE))
+        return 0;
+
+    record = log_async_reserve(&pos);
+    if (record == NULL)
+        return log_async.policy == LOG_ASYNC_DROP;
+
+    if (module != NULL) {
+        n = snprintf(record->data, sizeof(record->data), "%s:%s:%s:%d:%s() ",
+                     log_strings[loglevel], module, file, line, func);
+        if (n > 0)
+            len = (size_t)n < sizeof(record->data) ? (size_t)n : sizeof(record->data) - 1;
+    }
+    n = vsnprintf(&record->data[len], sizeof(record->data) - len, fmt, vaargs);
+    if (n > 0)
+        len += (size_t)n < sizeof(record->data) - len ? (size_t)n : sizeof(record->data) - len - 1;
+    if (module != NULL && len < sizeof(record->data) - 1)
+        record->data[len++] = ' ';
+    if (len == 0 || record->data[len - 1] != '\n') {
+        if (len == sizeof(record->data) - 1)
+            len--;
+        record->data[len++] = '\n';
+    }
+    record->len = len;
+
+    __atomic_store_n(&record->seq, pos + 1, __ATOMIC_RELEASE);
+    log_async_wake();
+
+    if (loglevel <= LOGLEVEL_ERROR)
+        log_async_wait(pos + 1);
+
+    return 1;
+}
+
+static int
+log_async_printf(log_level loglevel, const char *fmt, ...) {
+    va_list vaargs;
+    int     ret;
+
+    va_start(vaargs, fmt);
+    ret = log_async_vprintf(loglevel, NULL, NULL, NULL, 0, fmt, vaargs);
+    va_end(vaargs);
+    return ret;
+}
+
+__attribute__((destructor)) static void
+log_async_shutdown(void) {
+    if (!log_async.running)
+        return;
+
+    __atomic_store_n(&log_async.stop, 1, __ATOMIC_RELEASE);
+    pthread_mutex_lock(&log_async.lock);
+    pthread_cond_signal(&log_async.wake);
+    pthread_cond_broadcast(&log_async.space);
+    pthread_mutex_unlock(&log_async.lock);
+    pthread_join(log_async.thread, NULL);
+    log_async.running = 0;
+}
+
+void
+doLogFlush(void) {
+    if (log_async.running)
+        log_async_wait(__atomic_load_n(&log_async.enqueue_pos, __ATOMIC_ACQUIRE));
+}
+#else  /* LOG_ASYNC_ENABLED */
+#define log_async_vprintf(loglevel, module, file, func, line, fmt, vaargs) 0
+#define log_async_printf(loglevel, fmt, ...)                               0
+
+void
+doLogFlush(void) {}
+#endif /* LOG_ASYNC_ENABLED */
+
 void
 doLogBlob(log_level      loglevel,
           const char    *module,
@@ -188,9 +534,11 @@ doLogBlob(log_level      loglevel,
                 }
             }
             /* print the line and restart */
-            logfile = getLogFile();
-            fprintf(logfile, "%s\n", buffer);
-            fflush(logfile);
+            if (!log_async_printf(loglevel, "%s\n", buffer)) {
+                logfile = getLogFile();
+                fprintf(logfile, "%s\n", buffer);
+                fflush(logfile);
+            }
             off2 = i;
             off = 0;
             memset(buffer, '\0', LINE_LEN);
@@ -217,13 +565,20 @@ doLog(log_level   loglevel,
     if (loglevel > *status)
         return;
 
+    va_list vaargs;
+    va_start(vaargs, msg);
+    if (log_async_vprintf(loglevel, module, file, func, line, msg, vaargs)) {
+        va_end(vaargs);
+        return;
+    }
+    va_end(vaargs);
+
     int  size = snprintf(NULL, 0, "%s:%s:%s:%d:%s() %s \n", log_strings[loglevel], module, file,
                          line, func, msg);
     char fmt[size + 1];
     snprintf(fmt, sizeof(fmt), "%s:%s:%s:%d:%s() %s \n", log_strings[loglevel], module, file, line,
              func, msg);
 
-    va_list vaargs;
     va_start(vaargs, msg);
     logfile = getLogFile();
     vfprintf(logfile, fmt,
@@ -51,6 +51,18 @@ typedef enum {
 
 static log_level LOGMODULE_status COMPILER_ATTR(unused) = LOGLEVEL_UNDEFINED;
 
+/*
+ * Check the level of this module inline, so that a disabled log statement
+ * costs one load and compare instead of a call into doLog() with all of its
+ * arguments. LOGLEVEL_UNDEFINED compares greater than every level, hence
+ * the first statement always reaches doLog(), which resolves the level.
+ */
+#if !defined(_MSC_VER) || defined(__INTEL_COMPILER)
+#define LOG_LEVEL_ENABLED(level) __builtin_expect((level) <= LOGMODULE_status, 0)
+#else
+#define LOG_LEVEL_ENABLED(level) ((level) <= LOGMODULE_status)
+#endif
+
 #ifndef MAXLOGLEVEL
 #error "MAXLOGLEVEL undefined"
 #endif
@@ -64,11 +76,17 @@ static log_level LOGMODULE_status COMPILER_ATTR(unused) = LOGLEVEL_UNDEFINED;
 /* MAXLOGLEVEL is Error or "higher" */
 #if MAXLOGLEVEL >= LOGL_ERROR
 #define LOG_ERROR(FORMAT, ...)                                                                     \
-    doLog(LOGLEVEL_ERROR, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__, __func__,      \
-          __LINE__, FORMAT, ##__VA_ARGS__)
+    do {                                                                                           \
+        if (LOG_LEVEL_ENABLED(LOGLEVEL_ERROR))                                                     \
+            doLog(LOGLEVEL_ERROR, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__,        \
+                  __func__, __LINE__, FORMAT, ##__VA_ARGS__);                                      \
+    } while (0)
 #define LOGBLOB_ERROR(BUFFER, SIZE, FORMAT, ...)                                                   \
-    doLogBlob(LOGLEVEL_ERROR, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__, __func__,  \
-              __LINE__, BUFFER, SIZE, FORMAT, ##__VA_ARGS__)
+    do {                                                                                           \
+        if (LOG_LEVEL_ENABLED(LOGLEVEL_ERROR))                                                     \
+            doLogBlob(LOGLEVEL_ERROR, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status,              \
+                      __FILE__, __func__, __LINE__, BUFFER, SIZE, FORMAT, ##__VA_ARGS__);          \
+    } while (0)
 #else /* MAXLOGLEVEL is not Error or "higher" */
 #define LOG_ERROR(FORMAT, ...)                                                                     \
     {}
@@ -79,11 +97,17 @@ static log_level LOGMODULE_status COMPILER_ATTR(unused) = LOGLEVEL_UNDEFINED;
 /* MAXLOGLEVEL is Warning or "higher" */
 #if MAXLOGLEVEL >= LOGL_WARNING
 #define LOG_WARNING(FORMAT, ...)                                                                   \
-    doLog(LOGLEVEL_WARNING, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__, __func__,    \
-          __LINE__, FORMAT, ##__VA_ARGS__)
+    do {                                                                                           \
+        if (LOG_LEVEL_ENABLED(LOGLEVEL_WARNING))                                                   \
+            doLog(LOGLEVEL_WARNING, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__,      \
+                  __func__, __LINE__, FORMAT, ##__VA_ARGS__);                                      \
+    } while (0)
 #define LOGBLOB_WARNING(BUFFER, SIZE, FORMAT, ...)                                                 \
-    doLogBlob(LOGLEVEL_WARNING, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__,          \
-              __func__, __LINE__, BUFFER, SIZE, FORMAT, ##__VA_ARGS__)
+    do {                                                                                           \
+        if (LOG_LEVEL_ENABLED(LOGLEVEL_WARNING))                                                   \
+            doLogBlob(LOGLEVEL_WARNING, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status,            \
+                      __FILE__, __func__, __LINE__, BUFFER, SIZE, FORMAT, ##__VA_ARGS__);          \
+    } while (0)
 #else /* MAXLOGLEVEL is not Warning or "higher" */
 #define LOG_WARNING(FORMAT, ...)                                                                   \
     {}
@@ -94,11 +118,17 @@ static log_level LOGMODULE_status COMPILER_ATTR(unused) = LOGLEVEL_UNDEFINED;
 /* MAXLOGLEVEL is Info or "higher" */
 #if MAXLOGLEVEL >= LOGL_INFO
 #define LOG_INFO(FORMAT, ...)                                                                      \
-    doLog(LOGLEVEL_INFO, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__, __func__,       \
-          __LINE__, FORMAT, ##__VA_ARGS__)
+    do {                                                                                           \
+        if (LOG_LEVEL_ENABLED(LOGLEVEL_INFO))                                                      \
+            doLog(LOGLEVEL_INFO, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__,         \
+                  __func__, __LINE__, FORMAT, ##__VA_ARGS__);                                      \
+    } while (0)
 #define LOGBLOB_INFO(BUFFER, SIZE, FORMAT, ...)                                                    \
-    doLogBlob(LOGLEVEL_INFO, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__, __func__,   \
-              __LINE__, BUFFER, SIZE, FORMAT, ##__VA_ARGS__)
+    do {                                                                                           \
+        if (LOG_LEVEL_ENABLED(LOGLEVEL_INFO))                                                      \
+            doLogBlob(LOGLEVEL_INFO, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status,               \
+                      __FILE__, __func__, __LINE__, BUFFER, SIZE, FORMAT, ##__VA_ARGS__);          \
+    } while (0)
 #else /* MAXLOGLEVEL is not Info or "higher" */
 #define LOG_INFO(FORMAT, ...)                                                                      \
     {}
@@ -109,11 +139,17 @@ static log_level LOGMODULE_status COMPILER_ATTR(unused) = LOGLEVEL_UNDEFINED;
 /* MAXLOGLEVEL is Debug or "higher" */
 #if MAXLOGLEVEL >= LOGL_DEBUG
 #define LOG_DEBUG(FORMAT, ...)                                                                     \
-    doLog(LOGLEVEL_DEBUG, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__, __func__,      \
-          __LINE__, FORMAT, ##__VA_ARGS__)
+    do {                                                                                           \
+        if (LOG_LEVEL_ENABLED(LOGLEVEL_DEBUG))                                                     \
+            doLog(LOGLEVEL_DEBUG, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__,        \
+                  __func__, __LINE__, FORMAT, ##__VA_ARGS__);                                      \
+    } while (0)
 #define LOGBLOB_DEBUG(BUFFER, SIZE, FORMAT, ...)                                                   \
-    doLogBlob(LOGLEVEL_DEBUG, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__, __func__,  \
-              __LINE__, BUFFER, SIZE, FORMAT, ##__VA_ARGS__)
+    do {                                                                                           \
+        if (LOG_LEVEL_ENABLED(LOGLEVEL_DEBUG))                                                     \
+            doLogBlob(LOGLEVEL_DEBUG, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status,              \
+                      __FILE__, __func__, __LINE__, BUFFER, SIZE, FORMAT, ##__VA_ARGS__);          \
+    } while (0)
 #else /* MAXLOGLEVEL is not Debug or "higher" */
 #define LOG_DEBUG(FORMAT, ...)                                                                     \
     {}
@@ -124,11 +160,17 @@ static log_level LOGMODULE_status COMPILER_ATTR(unused) = LOGLEVEL_UNDEFINED;
 /* MAXLOGLEVEL is Trace */
 #if MAXLOGLEVEL >= LOGL_TRACE
 #define LOG_TRACE(FORMAT, ...)                                                                     \
-    doLog(LOGLEVEL_TRACE, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__, __func__,      \
-          __LINE__, FORMAT, ##__VA_ARGS__)
+    do {                                                                                           \
+        if (LOG_LEVEL_ENABLED(LOGLEVEL_TRACE))                                                     \
+            doLog(LOGLEVEL_TRACE, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__,        \
+                  __func__, __LINE__, FORMAT, ##__VA_ARGS__);                                      \
+    } while (0)
 #define LOGBLOB_TRACE(BUFFER, SIZE, FORMAT, ...)                                                   \
-    doLogBlob(LOGLEVEL_TRACE, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status, __FILE__, __func__,  \
-              __LINE__, BUFFER, SIZE, FORMAT, ##__VA_ARGS__)
+    do {                                                                                           \
+        if (LOG_LEVEL_ENABLED(LOGLEVEL_TRACE))                                                     \
+            doLogBlob(LOGLEVEL_TRACE, xstr(LOGMODULE), LOGDEFAULT, &LOGMODULE_status,              \
+                      __FILE__, __func__, __LINE__, BUFFER, SIZE, FORMAT, ##__VA_ARGS__);          \
+    } while (0)
 #else /* MAXLOGLEVEL is not Trace */
 #define LOG_TRACE(FORMAT, ...)                                                                     \
     {}
@@ -158,4 +200,7 @@ void doLogBlob(log_level      loglevel,
                const char    *msg,
                ...) COMPILER_ATTR(unused, format(printf, 10, 11));
 
+/* Wait until all messages queued by the asynchronous logger are written. */
+void doLogFlush(void);
+
 #endif /* LOG_H */
@@ -0,0 +1,32 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+#ifndef TSS2_PROBE_H
+#define TSS2_PROBE_H
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+/*
+ * Static tracepoints (USDT) of the provider "tss2" for bpftrace, perf or
+ * SystemTap. If configured with --enable-sdt-probes each probe compiles to a
+ * single nop instruction and an ELF note describing its arguments, so that a
+ * tracer can attach to a running process without a DEBUG build. Otherwise
+ * the probes compile to nothing. The available probes are listed in
+ * doc/tracing.md.
+ */
+#ifdef ENABLE_SDT_PROBES
+#include <sys/sdt.h>
+
+#define TSS2_PROBE1(name, a1)             DTRACE_PROBE1(tss2, name, a1)
+#define TSS2_PROBE2(name, a1, a2)         DTRACE_PROBE2(tss2, name, a1, a2)
+#define TSS2_PROBE3(name, a1, a2, a3)     DTRACE_PROBE3(tss2, name, a1, a2, a3)
+#define TSS2_PROBE4(name, a1, a2, a3, a4) DTRACE_PROBE4(tss2, name, a1, a2, a3, a4)
+#else
+#define TSS2_PROBE1(name, a1)             ((void)0)
+#define TSS2_PROBE2(name, a1, a2)         ((void)0)
+#define TSS2_PROBE3(name, a1, a2, a3)     ((void)0)
+#define TSS2_PROBE4(name, a1, a2, a3, a4) ((void)0)
+#endif
+
+#endif /* TSS2_PROBE_H */
@@ -0,0 +1,147 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include "util/tpm2_cc_info.h"
+
+#define CC(name, cmd_handles, auth_handles, rsp_handles, auth, decrypt, encrypt, dur)              \
+    [TPM2_CC_##name - TPM2_CC_FIRST] = { .defined = 1,                                             \
+                                         .numCommandHandles = cmd_handles,                         \
+                                         .numAuthHandles = auth_handles,                           \
+                                         .numResponseHandles = rsp_handles,                        \
+                                         .authAllowed = auth,                                      \
+                                         .decryptAllowed = decrypt,                                \
+                                         .encryptAllowed = encrypt,                                \
+                                         .duration = TPM2_CC_DURATION_##dur }
+
+/*
+ * Indexed by (command code - TPM2_CC_FIRST). Gaps in the command code space
+ * are zero-initialized and thus not defined.
+ *
+ *     name, command handles, auth handles, response handles,
+ *     auth allowed, decrypt allowed, encrypt allowed, duration
+ */
+const TPM2_CC_INFO tpm2_cc_info_table[TPM2_CC_LAST - TPM2_CC_FIRST + 1] = {
+    CC(NV_UndefineSpaceSpecial, 2, 2, 0, 1, 0, 0, MEDIUM),
+    CC(EvictControl, 2, 1, 0, 1, 0, 0, MEDIUM),
+    CC(HierarchyControl, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(NV_UndefineSpace, 2, 1, 0, 1, 0, 0, MEDIUM),
+    CC(ChangeEPS, 1, 1, 0, 1, 0, 0, LONG),
+    CC(ChangePPS, 1, 1, 0, 1, 0, 0, LONG),
+    CC(Clear, 1, 1, 0, 1, 0, 0, MEDIUM),
+    CC(ClearControl, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(ClockSet, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(HierarchyChangeAuth, 1, 1, 0, 1, 1, 0, SHORT),
+    CC(NV_DefineSpace, 1, 1, 0, 1, 1, 0, MEDIUM),
+    CC(PCR_Allocate, 1, 1, 0, 1, 0, 0, MEDIUM),
+    CC(PCR_SetAuthPolicy, 1, 1, 0, 1, 1, 0, SHORT),
+    CC(PP_Commands, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(SetPrimaryPolicy, 1, 1, 0, 1, 1, 0, SHORT),
+    CC(FieldUpgradeStart, 2, 1, 0, 1, 1, 0, LONG),
+    CC(ClockRateAdjust, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(CreatePrimary, 1, 1, 1, 1, 1, 1, LONG),
+    CC(NV_GlobalWriteLock, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(GetCommandAuditDigest, 2, 2, 0, 1, 1, 1, MEDIUM),
+    CC(NV_Increment, 2, 1, 0, 1, 0, 0, MEDIUM),
+    CC(NV_SetBits, 2, 1, 0, 1, 0, 0, MEDIUM),
+    CC(NV_Extend, 2, 1, 0, 1, 1, 0, MEDIUM),
+    CC(NV_Write, 2, 1, 0, 1, 1, 0, MEDIUM),
+    CC(NV_WriteLock, 2, 1, 0, 1, 0, 0, SHORT),
+    CC(DictionaryAttackLockReset, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(DictionaryAttackParameters, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(NV_ChangeAuth, 1, 1, 0, 1, 1, 0, SHORT),
+    CC(PCR_Event, 1, 1, 0, 1, 1, 0, SHORT),
+    CC(PCR_Reset, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(SequenceComplete, 1, 1, 0, 1, 1, 1, SHORT),
+    CC(SetAlgorithmSet, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(SetCommandCodeAuditStatus, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(FieldUpgradeData, 0, 0, 0, 1, 1, 0, LONG),
+    CC(IncrementalSelfTest, 0, 0, 0, 1, 0, 0, LONG),
+    CC(SelfTest, 0, 0, 0, 1, 0, 0, LONG),
+    CC(Startup, 0, 0, 0, 0, 0, 0, SHORT),
+    CC(Shutdown, 0, 0, 0, 1, 0, 0, SHORT),
+    CC(StirRandom, 0, 0, 0, 1, 1, 0, SHORT),
+    CC(ActivateCredential, 2, 2, 0, 1, 1, 1, MEDIUM),
+    CC(Certify, 2, 2, 0, 1, 1, 1, MEDIUM),
+    CC(PolicyNV, 3, 1, 0, 1, 1, 0, SHORT),
+    CC(CertifyCreation, 2, 1, 0, 1, 1, 1, MEDIUM),
+    CC(Duplicate, 2, 1, 0, 1, 1, 1, MEDIUM),
+    CC(GetTime, 2, 2, 0, 1, 1, 1, MEDIUM),
+    CC(GetSessionAuditDigest, 3, 2, 0, 1, 1, 1, MEDIUM),
+    CC(NV_Read, 2, 1, 0, 1, 0, 1, SHORT),
+    CC(NV_ReadLock, 2, 1, 0, 1, 0, 0, SHORT),
+    CC(ObjectChangeAuth, 2, 1, 0, 1, 1, 1, SHORT),
+    CC(PolicySecret, 2, 1, 0, 1, 1, 1, SHORT),
+    CC(Rewrap, 2, 1, 0, 1, 1, 1, MEDIUM),
+    CC(Create, 1, 1, 0, 1, 1, 1, LONG),
+    CC(ECDH_ZGen, 1, 1, 0, 1, 1, 1, MEDIUM),
+    CC(HMAC, 1, 1, 0, 1, 1, 1, SHORT),
+    CC(Import, 1, 1, 0, 1, 1, 1, MEDIUM),
+    CC(Load, 1, 1, 1, 1, 1, 1, MEDIUM),
+    CC(Quote, 1, 1, 0, 1, 1, 1, MEDIUM),
+    CC(RSA_Decrypt, 1, 1, 0, 1, 1, 1, MEDIUM),
+    CC(HMAC_Start, 1, 1, 1, 1, 1, 0, SHORT),
+    CC(SequenceUpdate, 1, 1, 0, 1, 1, 0, SHORT),
+    CC(Sign, 1, 1, 0, 1, 1, 0, MEDIUM),
+    CC(Unseal, 1, 1, 0, 1, 0, 1, SHORT),
+    CC(PolicySigned, 2, 0, 0, 1, 1, 1, MEDIUM),
+    CC(ContextLoad, 0, 0, 1, 0, 0, 0, SHORT),
+    CC(ContextSave, 1, 0, 0, 0, 0, 0, SHORT),
+    CC(ECDH_KeyGen, 1, 0, 0, 1, 0, 1, MEDIUM),
+    CC(EncryptDecrypt, 1, 1, 0, 1, 0, 1, SHORT),
+    CC(FlushContext, 0, 0, 0, 0, 0, 0, SHORT),
+    CC(LoadExternal, 0, 0, 1, 1, 1, 1, MEDIUM),
+    CC(MakeCredential, 1, 0, 0, 1, 1, 1, MEDIUM),
+    CC(NV_ReadPublic, 1, 0, 0, 1, 0, 1, SHORT),
+    CC(PolicyAuthorize, 1, 0, 0, 1, 1, 0, SHORT),
+    CC(PolicyAuthValue, 1, 0, 0, 1, 0, 0, SHORT),
+    CC(PolicyCommandCode, 1, 0, 0, 1, 0, 0, SHORT),
+    CC(PolicyCounterTimer, 1, 0, 0, 1, 1, 0, SHORT),
+    CC(PolicyCpHash, 1, 0, 0, 1, 1, 0, SHORT),
+    CC(PolicyLocality, 1, 0, 0, 1, 0, 0, SHORT),
+    CC(PolicyNameHash, 1, 0, 0, 1, 1, 0, SHORT),
+    CC(PolicyOR, 1, 0, 0, 1, 0, 0, SHORT),
+    CC(PolicyTicket, 1, 0, 0, 1, 1, 0, SHORT),
+    CC(ReadPublic, 1, 0, 0, 1, 0, 1, SHORT),
+    CC(RSA_Encrypt, 1, 0, 0, 1, 1, 1, MEDIUM),
+    CC(StartAuthSession, 2, 0, 1, 1, 1, 1, MEDIUM),
+    CC(VerifySignature, 1, 0, 0, 1, 1, 0, MEDIUM),
+    CC(ECC_Parameters, 0, 0, 0, 1, 0, 0, SHORT),
+    CC(FirmwareRead, 0, 0, 0, 1, 0, 1, SHORT),
+    CC(GetCapability, 0, 0, 0, 1, 0, 0, SHORT),
+    CC(GetRandom, 0, 0, 0, 1, 0, 1, SHORT),
+    CC(GetTestResult, 0, 0, 0, 1, 0, 1, SHORT),
+    CC(Hash, 0, 0, 0, 1, 1, 1, SHORT),
+    CC(PCR_Read, 0, 0, 0, 1, 0, 0, SHORT),
+    CC(PolicyPCR, 1, 0, 0, 1, 1, 0, SHORT),
+    CC(PolicyRestart, 1, 0, 0, 1, 0, 0, SHORT),
+    CC(ReadClock, 0, 0, 0, 1, 0, 0, SHORT),
+    CC(PCR_Extend, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(PCR_SetAuthValue, 1, 1, 0, 1, 1, 0, SHORT),
+    CC(NV_Certify, 3, 2, 0, 1, 1, 1, MEDIUM),
+    CC(EventSequenceComplete, 2, 2, 0, 1, 1, 0, SHORT),
+    CC(HashSequenceStart, 0, 0, 1, 1, 1, 0, SHORT),
+    CC(PolicyPhysicalPresence, 1, 0, 0, 1, 0, 0, SHORT),
+    CC(PolicyDuplicationSelect, 1, 0, 0, 1, 1, 0, SHORT),
+    CC(PolicyGetDigest, 1, 0, 0, 1, 0, 1, SHORT),
+    CC(TestParms, 0, 0, 0, 1, 0, 0, SHORT),
+    CC(Commit, 1, 1, 0, 1, 1, 1, MEDIUM),
+    CC(PolicyPassword, 1, 0, 0, 1, 0, 0, SHORT),
+    CC(ZGen_2Phase, 1, 1, 0, 1, 1, 1, MEDIUM),
+    CC(EC_Ephemeral, 0, 0, 0, 1, 0, 1, MEDIUM),
+    CC(PolicyNvWritten, 1, 0, 0, 1, 0, 0, SHORT),
+    CC(PolicyTemplate, 1, 0, 0, 1, 1, 0, SHORT),
+    CC(CreateLoaded, 1, 1, 1, 1, 1, 1, LONG),
+    CC(PolicyAuthorizeNV, 3, 1, 0, 1, 0, 0, SHORT),
+    CC(EncryptDecrypt2, 1, 1, 0, 1, 1, 1, SHORT),
+    CC(AC_GetCapability, 1, 0, 0, 1, 0, 0, SHORT),
+    CC(AC_Send, 3, 2, 0, 1, 1, 0, SHORT),
+    CC(Policy_AC_SendSelect, 1, 0, 0, 1, 1, 0, SHORT),
+    CC(CertifyX509, 2, 2, 0, 1, 1, 1, MEDIUM),
+    CC(ACT_SetTimeout, 1, 1, 0, 1, 0, 0, SHORT),
+    CC(ECC_Encrypt, 1, 0, 0, 1, 1, 1, MEDIUM),
+    CC(ECC_Decrypt, 1, 1, 0, 1, 1, 1, MEDIUM),
+};
@@ -0,0 +1,74 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifndef TPM2_CC_INFO_H
+#define TPM2_CC_INFO_H
+
+#include <stddef.h> // for NULL
+
+#include "tss2_common.h"     // for UINT16
+#include "tss2_tpm2_types.h" // for TPM2_CC, TPM2_CC_FIRST, TPM2_CC_LAST
+
+/** Nominal execution time class of a TPM command.
+ *
+ * Used by the TCTIs to choose a sensible poll interval while waiting for a
+ * response.
+ */
+typedef enum {
+    TPM2_CC_DURATION_SHORT = 0, /**< Typically well below 20ms. */
+    TPM2_CC_DURATION_MEDIUM,    /**< Asymmetric operation with a loaded key. */
+    TPM2_CC_DURATION_LONG,      /**< Key generation, seed changes, self tests. */
+} TPM2_CC_DURATION;
+
+/** Static properties of a TPM command as defined in TPM 2.0 Part 3. */
+typedef struct {
+    UINT16 defined : 1;            /**< Entry describes a known command. */
+    UINT16 numCommandHandles : 2;  /**< Handles in the command handle area. */
+    UINT16 numAuthHandles : 2;     /**< Handles that require an authorization. */
+    UINT16 numResponseHandles : 1; /**< Handles in the response handle area. */
+    UINT16 authAllowed : 1;        /**< Command may carry an authorization area. */
+    UINT16 decryptAllowed : 1;     /**< First command parameter is a TPM2B. */
+    UINT16 encryptAllowed : 1;     /**< First response parameter is a TPM2B. */
+    UINT16 duration : 2;           /**< One of TPM2_CC_DURATION. */
+} TPM2_CC_INFO;
+
+extern const TPM2_CC_INFO tpm2_cc_info_table[TPM2_CC_LAST - TPM2_CC_FIRST + 1];
+
+/** Look up the static properties of a command.
+ *
+ * The table is indexed directly by the command code, so the lookup is a range
+ * check and a single load.
+ *
+ * @param[in] commandCode The command code in host byte order.
+ * @retval The command properties or NULL for unknown or vendor commands.
+ */
+static inline const TPM2_CC_INFO *
+tpm2_cc_info_get(TPM2_CC commandCode) {
+    const TPM2_CC_INFO *info;
+
+    if (commandCode < TPM2_CC_FIRST || commandCode > TPM2_CC_LAST)
+        return NULL;
+
+    info = &tpm2_cc_info_table[commandCode - TPM2_CC_FIRST];
+    return info->defined ? info : NULL;
+}
+
+/** Suggested interval between two status polls for a command in ms. */
+static inline int
+tpm2_cc_info_poll_interval(TPM2_CC commandCode) {
+    const TPM2_CC_INFO *info = tpm2_cc_info_get(commandCode);
+
+    if (info == NULL)
+        return 8;
+
+    switch (info->duration) {
+    case TPM2_CC_DURATION_SHORT:
+        return 1;
+    case TPM2_CC_DURATION_MEDIUM:
+        return 8;
+    default:
+        return 20;
+    }
+}
+
+#endif /* TPM2_CC_INFO_H */
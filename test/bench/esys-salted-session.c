@@ -0,0 +1,285 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, uint32_t, uint64_t
+#include <stdio.h>    // for printf, fprintf, stderr
+#include <stdlib.h>   // for EXIT_FAILURE, EXIT_SUCCESS, strtoul
+#include <string.h>   // for memcpy
+#include <time.h>     // for timespec, clock_gettime, CLOCK_MONOTONIC
+
+#include "esys_types.h"      // for IESYS_PKEY_CACHE_SIZE
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS
+#include "tss2_esys.h"       // for Esys_StartAuthSession, Esys_FlushContext, ...
+#include "tss2_mu.h"         // for Tss2_MU_TPM2B_PUBLIC_Marshal
+#include "tss2_tcti.h"       // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT_FCN
+#include "tss2_tpm2_types.h" // for TPM2B_PUBLIC, TPM2_CC_StartAuthSession, ...
+
+/*
+ * Benchmark of salted Esys_StartAuthSession calls, each followed by
+ * Esys_FlushContext, against a TCTI that answers from memory. The sessions
+ * are salted either with a single tpmKey, whose converted public key stays in
+ * the key cache of the ESYS context, or with one more tpmKeys than the cache
+ * holds in turn, so that every session converts the public key again.
+ *
+ * Usage: esys-salted-session [sessions]
+ */
+
+#define DEFAULT_ITERATIONS 2000
+#define NUM_KEYS           (IESYS_PKEY_CACHE_SIZE + 1)
+#define KEY_HANDLE         0x81000000
+#define SESSION_HANDLE     0x02000000
+
+#define TCTI_BENCH_MAGIC   0x42454e4348000000ULL /* 'BENCH\0\0\0' */
+#define TCTI_BENCH_VERSION 0x1
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    const TPM2B_PUBLIC *key;       /* public area returned by TPM2_ReadPublic */
+    uint32_t            cc;        /* of the last command */
+    uint32_t            handle;    /* first handle of the last command */
+    uint16_t            salt_size; /* encryptedSalt of the last TPM2_StartAuthSession */
+} TSS2_TCTI_CONTEXT_BENCH;
+
+/* The base point of NIST P-256, the public key of the private key 1 */
+static const BYTE p256_x[] = {
+    0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47, 0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+    0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0, 0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96,
+};
+static const BYTE p256_y[] = {
+    0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b, 0x8e, 0xe7, 0xeb, 0x4a, 0x7c, 0x0f, 0x9e, 0x16,
+    0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce, 0xcb, 0xb6, 0x40, 0x68, 0x37, 0xbf, 0x51, 0xf5,
+};
+
+static double
+elapsed_ns(const struct timespec *start) {
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start->tv_sec) * 1e9 + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+static uint32_t
+get_uint32(const uint8_t *buffer) {
+    return (uint32_t)buffer[0] << 24 | (uint32_t)buffer[1] << 16 | (uint32_t)buffer[2] << 8
+           | buffer[3];
+}
+
+static uint16_t
+get_uint16(const uint8_t *buffer) {
+    return (uint16_t)(buffer[0] << 8 | buffer[1]);
+}
+
+static void
+put_uint32(uint8_t *buffer, uint32_t value) {
+    buffer[0] = (uint8_t)(value >> 24);
+    buffer[1] = (uint8_t)(value >> 16);
+    buffer[2] = (uint8_t)(value >> 8);
+    buffer[3] = (uint8_t)value;
+}
+
+static TSS2_RC
+tcti_bench_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    TSS2_TCTI_CONTEXT_BENCH *tcti = (TSS2_TCTI_CONTEXT_BENCH *)tctiContext;
+    size_t                   offset;
+
+    if (size < 14)
+        return TSS2_TCTI_RC_BAD_VALUE;
+    tcti->cc = get_uint32(&buffer[6]);
+    tcti->handle = get_uint32(&buffer[10]);
+    if (tcti->cc == TPM2_CC_StartAuthSession) {
+        /* tpmKey, bind, nonceCaller, encryptedSalt */
+        offset = 18;
+        offset += sizeof(UINT16) + get_uint16(&buffer[offset]);
+        tcti->salt_size = get_uint16(&buffer[offset]);
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_bench_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                   size_t            *response_size,
+                   uint8_t           *response_buffer,
+                   int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_BENCH *tcti = (TSS2_TCTI_CONTEXT_BENCH *)tctiContext;
+    uint8_t                  response[1024] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x00, /* Response Size */
+        0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+    };
+    size_t                   size = 10;
+    TPM2B_NAME               name = { .size = 34, .name = { 0x00, TPM2_ALG_SHA256 } };
+    TPM2B_NONCE              nonce = { .size = 32 };
+
+    (void)timeout;
+    switch (tcti->cc) {
+    case TPM2_CC_ReadPublic:
+        /* A name that differs for each key, the ESYS key cache is indexed by it */
+        put_uint32(&name.name[2], tcti->handle);
+        if (Tss2_MU_TPM2B_PUBLIC_Marshal(&tcti->key[tcti->handle - KEY_HANDLE], response,
+                                         sizeof(response), &size)
+                != TSS2_RC_SUCCESS
+            || Tss2_MU_TPM2B_NAME_Marshal(&name, response, sizeof(response), &size)
+                   != TSS2_RC_SUCCESS
+            || Tss2_MU_TPM2B_NAME_Marshal(&name, response, sizeof(response), &size)
+                   != TSS2_RC_SUCCESS)
+            return TSS2_TCTI_RC_GENERAL_FAILURE;
+        break;
+    case TPM2_CC_StartAuthSession:
+        put_uint32(&response[size], SESSION_HANDLE);
+        size += 4;
+        if (Tss2_MU_TPM2B_NONCE_Marshal(&nonce, response, sizeof(response), &size)
+            != TSS2_RC_SUCCESS)
+            return TSS2_TCTI_RC_GENERAL_FAILURE;
+        break;
+    default:
+        break;
+    }
+    put_uint32(&response[2], (uint32_t)size);
+
+    *response_size = size;
+    if (response_buffer != NULL)
+        memcpy(response_buffer, response, size);
+    return TSS2_RC_SUCCESS;
+}
+
+/*
+ * Start and flush a salted session per iteration, using the tpmKeys in turn.
+ * Returns sessions per second or -1 on error.
+ */
+static double
+run(ESYS_CONTEXT            *ectx,
+    TSS2_TCTI_CONTEXT_BENCH *tcti,
+    const ESYS_TR           *keys,
+    size_t                   num_keys,
+    unsigned long            iterations) {
+    TPMT_SYM_DEF    symmetric = { .algorithm = TPM2_ALG_AES,
+                                  .keyBits = { .aes = 128 },
+                                  .mode = { .aes = TPM2_ALG_CFB } };
+    struct timespec start;
+    ESYS_TR         session;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned long i = 0; i < iterations; i++) {
+        tcti->salt_size = 0;
+        if (Esys_StartAuthSession(ectx, keys[i % num_keys], ESYS_TR_NONE, ESYS_TR_NONE,
+                                  ESYS_TR_NONE, ESYS_TR_NONE, NULL, TPM2_SE_HMAC, &symmetric,
+                                  TPM2_ALG_SHA256, &session)
+                != TSS2_RC_SUCCESS
+            || tcti->salt_size == 0 || Esys_FlushContext(ectx, session) != TSS2_RC_SUCCESS)
+            return -1;
+    }
+    return (double)iterations * 1e9 / elapsed_ns(&start);
+}
+
+static void
+init_keys(TPM2B_PUBLIC *rsa, TPM2B_PUBLIC *ecc) {
+    TPMT_SYM_DEF_OBJECT symmetric = { .algorithm = TPM2_ALG_AES,
+                                      .keyBits = { .aes = 128 },
+                                      .mode = { .aes = TPM2_ALG_CFB } };
+    TPMA_OBJECT         attributes = TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT
+                             | TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT
+                             | TPMA_OBJECT_SENSITIVEDATAORIGIN | TPMA_OBJECT_USERWITHAUTH;
+    uint32_t            seed = 1;
+
+    for (size_t i = 0; i < NUM_KEYS; i++) {
+        /* The keys differ by their policy, so their names differ */
+        rsa[i].publicArea.type = TPM2_ALG_RSA;
+        rsa[i].publicArea.nameAlg = TPM2_ALG_SHA256;
+        rsa[i].publicArea.objectAttributes = attributes;
+        rsa[i].publicArea.authPolicy.size = TPM2_SHA256_DIGEST_SIZE;
+        rsa[i].publicArea.authPolicy.buffer[0] = (BYTE)i;
+        rsa[i].publicArea.parameters.rsaDetail.symmetric = symmetric;
+        rsa[i].publicArea.parameters.rsaDetail.scheme.scheme = TPM2_ALG_NULL;
+        rsa[i].publicArea.parameters.rsaDetail.keyBits = 2048;
+        rsa[i].publicArea.unique.rsa.size = 256;
+        /* An odd modulus of full length, only the public operation is used */
+        for (size_t j = 0; j < 256; j++) {
+            seed = seed * 1103515245 + 12345;
+            rsa[i].publicArea.unique.rsa.buffer[j] = (BYTE)(seed >> 16);
+        }
+        rsa[i].publicArea.unique.rsa.buffer[0] |= 0xc0;
+        rsa[i].publicArea.unique.rsa.buffer[255] |= 0x01;
+
+        ecc[i].publicArea.type = TPM2_ALG_ECC;
+        ecc[i].publicArea.nameAlg = TPM2_ALG_SHA256;
+        ecc[i].publicArea.objectAttributes = attributes;
+        ecc[i].publicArea.authPolicy = rsa[i].publicArea.authPolicy;
+        ecc[i].publicArea.parameters.eccDetail.symmetric = symmetric;
+        ecc[i].publicArea.parameters.eccDetail.scheme.scheme = TPM2_ALG_NULL;
+        ecc[i].publicArea.parameters.eccDetail.curveID = TPM2_ECC_NIST_P256;
+        ecc[i].publicArea.parameters.eccDetail.kdf.scheme = TPM2_ALG_NULL;
+        ecc[i].publicArea.unique.ecc.x.size = sizeof(p256_x);
+        memcpy(ecc[i].publicArea.unique.ecc.x.buffer, p256_x, sizeof(p256_x));
+        ecc[i].publicArea.unique.ecc.y.size = sizeof(p256_y);
+        memcpy(ecc[i].publicArea.unique.ecc.y.buffer, p256_y, sizeof(p256_y));
+    }
+}
+
+int
+main(int argc, char *argv[]) {
+    static TPM2B_PUBLIC     rsa[NUM_KEYS], ecc[NUM_KEYS];
+    TSS2_TCTI_CONTEXT_BENCH tcti = {
+        .magic = TCTI_BENCH_MAGIC,
+        .version = TCTI_BENCH_VERSION,
+        .transmit = tcti_bench_transmit,
+        .receive = tcti_bench_receive,
+    };
+    unsigned long iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : DEFAULT_ITERATIONS;
+    ESYS_CONTEXT *ectx;
+    ESYS_TR       keys[NUM_KEYS];
+    double        cached, uncached;
+    int           ret = EXIT_SUCCESS;
+
+    const struct {
+        const char         *name;
+        const TPM2B_PUBLIC *key;
+    } cases[] = {
+        { "RSA 2048", rsa },
+        { "ECC P-256", ecc },
+    };
+
+    if (iterations == 0)
+        iterations = DEFAULT_ITERATIONS;
+    init_keys(rsa, ecc);
+
+    printf("%-10s %16s %16s\n", "tpmKey", "cached/s", "uncached/s");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        tcti.key = cases[i].key;
+        if (Esys_Initialize(&ectx, (TSS2_TCTI_CONTEXT *)&tcti, NULL) != TSS2_RC_SUCCESS) {
+            fprintf(stderr, "Esys_Initialize failed\n");
+            return EXIT_FAILURE;
+        }
+        for (size_t k = 0; k < NUM_KEYS; k++) {
+            if (Esys_TR_FromTPMPublic(ectx, KEY_HANDLE + (TPM2_HANDLE)k, ESYS_TR_NONE,
+                                      ESYS_TR_NONE, ESYS_TR_NONE, &keys[k])
+                != TSS2_RC_SUCCESS) {
+                fprintf(stderr, "%s: Esys_TR_FromTPMPublic failed\n", cases[i].name);
+                Esys_Finalize(&ectx);
+                return EXIT_FAILURE;
+            }
+        }
+
+        cached = run(ectx, &tcti, keys, 1, iterations);
+        uncached = run(ectx, &tcti, keys, NUM_KEYS, iterations);
+        Esys_Finalize(&ectx);
+        if (cached < 0 || uncached < 0) {
+            fprintf(stderr, "%s: salted session failed\n", cases[i].name);
+            ret = EXIT_FAILURE;
+            break;
+        }
+        printf("%-10s %16.0f %16.0f\n", cases[i].name, cached, uncached);
+    }
+    return ret;
+}
@@ -0,0 +1,354 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <stdio.h>  // for printf, fprintf, stderr
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS, strtoul
+#include <string.h> // for memcmp, memset
+#include <time.h>   // for timespec, clock_gettime, CLOCK_MONOTONIC
+
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS
+#include "tss2_mu.h"         // for Tss2_MU_TPMS_CAPABILITY_DATA_Marshal, ...
+#include "tss2_tpm2_types.h" // for TPMS_CAPABILITY_DATA, TPMS_TIME_INFO, ...
+
+/*
+ * Benchmark of the marshaling of complete TPM responses: the response header
+ * and the parameters of TPM2_GetCapability for the TPM properties and the
+ * commands, and of TPM2_ReadClock. Each response is marshaled and unmarshaled
+ * with the Tss2_MU functions of its parameters and with one Tss2_MU call per
+ * integer, the way the integer-only structures and lists were handled before
+ * the layout tables. Both must produce the same bytes and structures.
+ *
+ * Usage: response-marshal [iterations]
+ */
+
+#define DEFAULT_ITERATIONS 100000
+
+typedef struct {
+    TPMI_YES_NO          moreData;
+    TPMS_CAPABILITY_DATA capabilityData;
+} CAP_RESPONSE;
+
+typedef TSS2_RC (*MARSHAL_FCN)(const void *src,
+                               uint8_t     buffer[],
+                               size_t      buffer_size,
+                               size_t     *offset);
+typedef TSS2_RC (*UNMARSHAL_FCN)(uint8_t const buffer[],
+                                 size_t        buffer_size,
+                                 size_t       *offset,
+                                 void         *dest);
+
+typedef struct {
+    const char   *name;
+    const void   *response;
+    size_t        size; /**< sizeof() the response structure */
+    MARSHAL_FCN   marshal_by_field;
+    MARSHAL_FCN   marshal;
+    UNMARSHAL_FCN unmarshal_by_field;
+    UNMARSHAL_FCN unmarshal;
+} BENCH_CASE;
+
+static double
+elapsed_ns(const struct timespec *start) {
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start->tv_sec) * 1e9 + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+/* The header of a successful response without sessions, sized afterwards */
+static TSS2_RC
+header_marshal(uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    TSS2_RC r = Tss2_MU_TPM2_ST_Marshal(TPM2_ST_NO_SESSIONS, buffer, buffer_size, offset);
+
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Marshal(0, buffer, buffer_size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Marshal(TPM2_RC_SUCCESS, buffer, buffer_size, offset);
+    return r;
+}
+
+static TSS2_RC
+header_unmarshal(uint8_t const buffer[], size_t buffer_size, size_t *offset) {
+    TPM2_ST tag;
+    UINT32  size;
+    TPM2_RC rc;
+    TSS2_RC r = Tss2_MU_TPM2_ST_Unmarshal(buffer, buffer_size, offset, &tag);
+
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset, &size);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset, &rc);
+    return r;
+}
+
+static TSS2_RC
+cap_marshal(const void *src, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    const CAP_RESPONSE *response = src;
+    TSS2_RC             r = header_marshal(buffer, buffer_size, offset);
+
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_BYTE_Marshal(response->moreData, buffer, buffer_size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_TPMS_CAPABILITY_DATA_Marshal(&response->capabilityData, buffer, buffer_size,
+                                                 offset);
+    return r;
+}
+
+static TSS2_RC
+cap_unmarshal(uint8_t const buffer[], size_t buffer_size, size_t *offset, void *dest) {
+    CAP_RESPONSE *response = dest;
+    TSS2_RC       r = header_unmarshal(buffer, buffer_size, offset);
+
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_BYTE_Unmarshal(buffer, buffer_size, offset, &response->moreData);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_TPMS_CAPABILITY_DATA_Unmarshal(buffer, buffer_size, offset,
+                                                   &response->capabilityData);
+    return r;
+}
+
+static TSS2_RC
+cap_marshal_by_field(const void *src, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    const CAP_RESPONSE         *response = src;
+    const TPMS_CAPABILITY_DATA *data = &response->capabilityData;
+    TSS2_RC                     r = header_marshal(buffer, buffer_size, offset);
+    UINT32                      i;
+
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_BYTE_Marshal(response->moreData, buffer, buffer_size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Marshal(data->capability, buffer, buffer_size, offset);
+    if (data->capability == TPM2_CAP_COMMANDS) {
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT32_Marshal(data->data.command.count, buffer, buffer_size, offset);
+        for (i = 0; r == TSS2_RC_SUCCESS && i < data->data.command.count; i++)
+            r = Tss2_MU_UINT32_Marshal(data->data.command.commandAttributes[i], buffer,
+                                       buffer_size, offset);
+        return r;
+    }
+
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Marshal(data->data.tpmProperties.count, buffer, buffer_size, offset);
+    for (i = 0; r == TSS2_RC_SUCCESS && i < data->data.tpmProperties.count; i++) {
+        r = Tss2_MU_UINT32_Marshal(data->data.tpmProperties.tpmProperty[i].property, buffer,
+                                   buffer_size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT32_Marshal(data->data.tpmProperties.tpmProperty[i].value, buffer,
+                                       buffer_size, offset);
+    }
+    return r;
+}
+
+static TSS2_RC
+cap_unmarshal_by_field(uint8_t const buffer[], size_t buffer_size, size_t *offset, void *dest) {
+    CAP_RESPONSE         *response = dest;
+    TPMS_CAPABILITY_DATA *data = &response->capabilityData;
+    TSS2_RC               r = header_unmarshal(buffer, buffer_size, offset);
+    UINT32                i;
+
+    memset(response, 0, sizeof(*response));
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_BYTE_Unmarshal(buffer, buffer_size, offset, &response->moreData);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset, &data->capability);
+    if (data->capability == TPM2_CAP_COMMANDS) {
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset, &data->data.command.count);
+        for (i = 0; r == TSS2_RC_SUCCESS && i < data->data.command.count; i++)
+            r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset,
+                                         &data->data.command.commandAttributes[i]);
+        return r;
+    }
+
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset,
+                                     &data->data.tpmProperties.count);
+    for (i = 0; r == TSS2_RC_SUCCESS && i < data->data.tpmProperties.count; i++) {
+        r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset,
+                                     &data->data.tpmProperties.tpmProperty[i].property);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset,
+                                         &data->data.tpmProperties.tpmProperty[i].value);
+    }
+    return r;
+}
+
+static TSS2_RC
+clock_marshal(const void *src, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    TSS2_RC r = header_marshal(buffer, buffer_size, offset);
+
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_TPMS_TIME_INFO_Marshal(src, buffer, buffer_size, offset);
+    return r;
+}
+
+static TSS2_RC
+clock_unmarshal(uint8_t const buffer[], size_t buffer_size, size_t *offset, void *dest) {
+    TSS2_RC r = header_unmarshal(buffer, buffer_size, offset);
+
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_TPMS_TIME_INFO_Unmarshal(buffer, buffer_size, offset, dest);
+    return r;
+}
+
+static TSS2_RC
+clock_marshal_by_field(const void *src, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    const TPMS_TIME_INFO *info = src;
+    TSS2_RC               r = header_marshal(buffer, buffer_size, offset);
+
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT64_Marshal(info->time, buffer, buffer_size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT64_Marshal(info->clockInfo.clock, buffer, buffer_size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Marshal(info->clockInfo.resetCount, buffer, buffer_size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Marshal(info->clockInfo.restartCount, buffer, buffer_size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_BYTE_Marshal(info->clockInfo.safe, buffer, buffer_size, offset);
+    return r;
+}
+
+static TSS2_RC
+clock_unmarshal_by_field(uint8_t const buffer[], size_t buffer_size, size_t *offset, void *dest) {
+    TPMS_TIME_INFO *info = dest;
+    TSS2_RC         r = header_unmarshal(buffer, buffer_size, offset);
+
+    memset(info, 0, sizeof(*info));
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT64_Unmarshal(buffer, buffer_size, offset, &info->time);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT64_Unmarshal(buffer, buffer_size, offset, &info->clockInfo.clock);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset, &info->clockInfo.resetCount);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Unmarshal(buffer, buffer_size, offset, &info->clockInfo.restartCount);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_BYTE_Unmarshal(buffer, buffer_size, offset, &info->clockInfo.safe);
+    return r;
+}
+
+static double
+run_marshal(MARSHAL_FCN    fcn,
+            const void    *src,
+            uint8_t       *buffer,
+            size_t         size,
+            unsigned long  iterations) {
+    struct timespec start;
+    size_t          offset;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned long i = 0; i < iterations; i++) {
+        offset = 0;
+        if (fcn(src, buffer, size, &offset) != TSS2_RC_SUCCESS)
+            return -1;
+    }
+    return elapsed_ns(&start) / (double)iterations;
+}
+
+static double
+run_unmarshal(UNMARSHAL_FCN  fcn,
+              const uint8_t *buffer,
+              size_t         size,
+              void          *dest,
+              unsigned long  iterations) {
+    struct timespec start;
+    size_t          offset;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned long i = 0; i < iterations; i++) {
+        offset = 0;
+        if (fcn(buffer, size, &offset, dest) != TSS2_RC_SUCCESS)
+            return -1;
+    }
+    return elapsed_ns(&start) / (double)iterations;
+}
+
+int
+main(int argc, char *argv[]) {
+    static CAP_RESPONSE   properties, commands;
+    static TPMS_TIME_INFO time_info;
+    static uint8_t        expected[TPM2_MAX_COMMAND_SIZE];
+    static uint8_t        buffer[TPM2_MAX_COMMAND_SIZE];
+    static CAP_RESPONSE   dest_expected, dest;
+    unsigned long iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : DEFAULT_ITERATIONS;
+    size_t        size_expected, size;
+    double        ns[4];
+
+    const BENCH_CASE cases[] = {
+        { "GetCapability properties", &properties, sizeof(properties), cap_marshal_by_field,
+          cap_marshal, cap_unmarshal_by_field, cap_unmarshal },
+        { "GetCapability commands", &commands, sizeof(commands), cap_marshal_by_field,
+          cap_marshal, cap_unmarshal_by_field, cap_unmarshal },
+        { "ReadClock", &time_info, sizeof(time_info), clock_marshal_by_field, clock_marshal,
+          clock_unmarshal_by_field, clock_unmarshal },
+    };
+
+    if (iterations == 0)
+        iterations = DEFAULT_ITERATIONS;
+
+    properties.moreData = TPM2_YES;
+    properties.capabilityData.capability = TPM2_CAP_TPM_PROPERTIES;
+    properties.capabilityData.data.tpmProperties.count = TPM2_MAX_TPM_PROPERTIES;
+    for (UINT32 i = 0; i < TPM2_MAX_TPM_PROPERTIES; i++) {
+        properties.capabilityData.data.tpmProperties.tpmProperty[i].property = TPM2_PT_FIXED + i;
+        properties.capabilityData.data.tpmProperties.tpmProperty[i].value = 0xa0b0c0d0 + i;
+    }
+    commands.moreData = TPM2_NO;
+    commands.capabilityData.capability = TPM2_CAP_COMMANDS;
+    commands.capabilityData.data.command.count = TPM2_MAX_CAP_CC;
+    for (UINT32 i = 0; i < TPM2_MAX_CAP_CC; i++)
+        commands.capabilityData.data.command.commandAttributes[i] = TPM2_CC_FIRST + i;
+    time_info.time = 0x0102030405060708;
+    time_info.clockInfo.clock = 0x1112131415161718;
+    time_info.clockInfo.resetCount = 3;
+    time_info.clockInfo.restartCount = 7;
+    time_info.clockInfo.safe = TPM2_YES;
+
+    printf("%-26s %6s %12s %12s %12s %12s\n", "response", "bytes", "marshal/fld", "marshal",
+           "unmarsh/fld", "unmarshal");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        size_expected = 0;
+        size = 0;
+        memset(buffer, 0, sizeof(buffer));
+        memset(&dest, 0, sizeof(dest));
+        if (cases[i].marshal_by_field(cases[i].response, expected, sizeof(expected),
+                                      &size_expected)
+                != TSS2_RC_SUCCESS
+            || cases[i].marshal(cases[i].response, buffer, sizeof(buffer), &size)
+                   != TSS2_RC_SUCCESS
+            || size != size_expected || memcmp(buffer, expected, size) != 0) {
+            fprintf(stderr, "%s: marshaled responses differ\n", cases[i].name);
+            return EXIT_FAILURE;
+        }
+        size_expected = 0;
+        size = 0;
+        if (cases[i].unmarshal_by_field(expected, sizeof(expected), &size_expected,
+                                        &dest_expected)
+                != TSS2_RC_SUCCESS
+            || cases[i].unmarshal(expected, sizeof(expected), &size, &dest) != TSS2_RC_SUCCESS
+            || size != size_expected || memcmp(&dest, cases[i].response, cases[i].size) != 0
+            || memcmp(&dest_expected, cases[i].response, cases[i].size) != 0) {
+            fprintf(stderr, "%s: unmarshaled responses differ\n", cases[i].name);
+            return EXIT_FAILURE;
+        }
+
+        ns[0] = run_marshal(cases[i].marshal_by_field, cases[i].response, buffer, sizeof(buffer),
+                            iterations);
+        ns[1] = run_marshal(cases[i].marshal, cases[i].response, buffer, sizeof(buffer),
+                            iterations);
+        ns[2] = run_unmarshal(cases[i].unmarshal_by_field, expected, size, &dest, iterations);
+        ns[3] = run_unmarshal(cases[i].unmarshal, expected, size, &dest, iterations);
+        if (ns[0] < 0 || ns[1] < 0 || ns[2] < 0 || ns[3] < 0) {
+            fprintf(stderr, "%s: marshaling failed\n", cases[i].name);
+            return EXIT_FAILURE;
+        }
+        printf("%-26s %6zu %12.1f %12.1f %12.1f %12.1f\n", cases[i].name, size, ns[0], ns[1],
+               ns[2], ns[3]);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,229 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t
+#include <stdio.h>    // for printf, fprintf, stderr
+#include <stdlib.h>   // for EXIT_FAILURE, EXIT_SUCCESS, strtoul, calloc, free
+#include <string.h>   // for memcpy
+#include <time.h>     // for timespec, clock_gettime, CLOCK_MONOTONIC
+
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ABI_VERSION
+#include "tss2_sys.h"        // for Tss2_Sys_ExecuteBatch, Tss2_Sys_GetRandom_Prepare, ...
+#include "tss2_tcti.h"       // for TSS2_TCTI_CONTEXT_COMMON_V1, TSS2_TCTI_CONTEXT
+#include "tss2_tpm2_types.h" // for TPM2B_DIGEST
+
+/*
+ * Benchmark of Tss2_Sys_ExecuteBatch against a serial loop of prepare,
+ * Tss2_Sys_Execute and complete, over a TCTI that answers each TPM2_GetRandom
+ * a fixed time after the command was transmitted, like a TPM executing it in
+ * the background. The batch can only hide host-side work behind the TPM's
+ * execution time, so each run is made with the marshaling alone and with
+ * additional host work in the prepare callback, standing for the computation
+ * of e.g. policy digests or command parameters.
+ *
+ * Usage: sys-execute-batch [commands] [latency in us] [host work in us]
+ */
+
+#define DEFAULT_ITERATIONS 2000
+#define DEFAULT_LATENCY_US 100
+#define DEFAULT_WORK_US    50
+#define MAX_CONTEXTS       2
+#define RANDOM_SIZE        32
+
+typedef struct {
+    TSS2_TCTI_CONTEXT_COMMON_V1 v1;
+    struct timespec             deadline; /* of the response of the last command */
+    long                        latency_ns;
+} TSS2_TCTI_CONTEXT_LATENCY;
+
+typedef struct {
+    long   work_ns;   /* host work per prepared command */
+    size_t completed; /* commands completed successfully */
+} BENCH_STATE;
+
+static double
+elapsed_ns(const struct timespec *start) {
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start->tv_sec) * 1e9 + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+static void
+add_ns(struct timespec *ts, long ns) {
+    ts->tv_nsec += ns;
+    while (ts->tv_nsec >= 1000000000) {
+        ts->tv_nsec -= 1000000000;
+        ts->tv_sec++;
+    }
+}
+
+static TSS2_RC
+tcti_latency_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, uint8_t const *command) {
+    TSS2_TCTI_CONTEXT_LATENCY *tcti = (TSS2_TCTI_CONTEXT_LATENCY *)tctiContext;
+
+    (void)size;
+    (void)command;
+    clock_gettime(CLOCK_MONOTONIC, &tcti->deadline);
+    add_ns(&tcti->deadline, tcti->latency_ns);
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_latency_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                     size_t            *size,
+                     uint8_t           *response,
+                     int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_LATENCY *tcti = (TSS2_TCTI_CONTEXT_LATENCY *)tctiContext;
+    uint8_t                    buffer[10 + 2 + RANDOM_SIZE] = {
+        0x80, 0x01,                             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 10 + 2 + RANDOM_SIZE, /* Response Size */
+        0x00, 0x00, 0x00, 0x00,                 /* TPM2_RC_SUCCESS */
+        0x00, RANDOM_SIZE,                      /* size of randomBytes */
+    };
+    struct timespec            now;
+
+    (void)timeout;
+    if (response == NULL) {
+        *size = sizeof(buffer);
+        return TSS2_RC_SUCCESS;
+    }
+
+    /* Spin instead of sleeping, the timer slack of a sleep exceeds short latencies */
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while (now.tv_sec < tcti->deadline.tv_sec
+             || (now.tv_sec == tcti->deadline.tv_sec && now.tv_nsec < tcti->deadline.tv_nsec));
+    memcpy(response, buffer, sizeof(buffer));
+    *size = sizeof(buffer);
+    return TSS2_RC_SUCCESS;
+}
+
+/* Spin for the given time like a computation would. */
+static void
+host_work(long ns) {
+    struct timespec start;
+
+    if (ns <= 0)
+        return;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (elapsed_ns(&start) < (double)ns)
+        ;
+}
+
+static TSS2_RC
+bench_prepare(TSS2_SYS_CONTEXT *sysContext, size_t index, void *userData) {
+    BENCH_STATE *state = userData;
+
+    (void)index;
+    host_work(state->work_ns);
+    return Tss2_Sys_GetRandom_Prepare(sysContext, RANDOM_SIZE);
+}
+
+static TSS2_RC
+bench_complete(TSS2_SYS_CONTEXT *sysContext, size_t index, TSS2_RC responseCode, void *userData) {
+    BENCH_STATE *state = userData;
+    TPM2B_DIGEST random = { 0 };
+    TSS2_RC      r;
+
+    (void)index;
+    if (responseCode != TSS2_RC_SUCCESS)
+        return responseCode;
+    r = Tss2_Sys_GetRandom_Complete(sysContext, &random);
+    if (r == TSS2_RC_SUCCESS && random.size == RANDOM_SIZE)
+        state->completed++;
+    return r;
+}
+
+/* The loop an application writes without the batch API */
+static TSS2_RC
+execute_serial(TSS2_SYS_CONTEXT *sysContext, size_t numCommands, BENCH_STATE *state) {
+    TSS2_RC r = TSS2_RC_SUCCESS;
+
+    for (size_t i = 0; r == TSS2_RC_SUCCESS && i < numCommands; i++) {
+        r = bench_prepare(sysContext, i, state);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_Sys_Execute(sysContext);
+        if (r == TSS2_RC_SUCCESS)
+            r = bench_complete(sysContext, i, TSS2_RC_SUCCESS, state);
+    }
+    return r;
+}
+
+/* Returns the time per command in us, or -1 on error */
+static double
+run(TSS2_SYS_CONTEXT *const *sysContexts,
+    size_t                   numContexts,
+    unsigned long            iterations,
+    long                     work_ns) {
+    BENCH_STATE     state = { .work_ns = work_ns };
+    struct timespec start;
+    TSS2_RC         r;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (numContexts == 0)
+        r = execute_serial(sysContexts[0], iterations, &state);
+    else
+        r = Tss2_Sys_ExecuteBatch(sysContexts, numContexts, iterations, bench_prepare,
+                                  bench_complete, &state);
+    if (r != TSS2_RC_SUCCESS || state.completed != iterations)
+        return -1;
+    return elapsed_ns(&start) / 1e3 / (double)iterations;
+}
+
+int
+main(int argc, char *argv[]) {
+    TSS2_ABI_VERSION          ver = TSS2_ABI_VERSION_CURRENT;
+    TSS2_TCTI_CONTEXT_LATENCY tcti = {
+        .v1 = { .version = 1,
+                .transmit = tcti_latency_transmit,
+                .receive = tcti_latency_receive },
+    };
+    TSS2_SYS_CONTEXT *sys[MAX_CONTEXTS];
+    unsigned long     iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : DEFAULT_ITERATIONS;
+    unsigned long     latency_us = argc > 2 ? strtoul(argv[2], NULL, 0) : DEFAULT_LATENCY_US;
+    unsigned long     work_us = argc > 3 ? strtoul(argv[3], NULL, 0) : DEFAULT_WORK_US;
+    size_t            size = Tss2_Sys_GetContextSize(0);
+    double            serial, batch1, batch2;
+    int               ret = EXIT_SUCCESS;
+
+    const long work_ns[] = { 0, (long)work_us * 1000 };
+
+    if (iterations == 0)
+        iterations = DEFAULT_ITERATIONS;
+    tcti.latency_ns = (long)latency_us * 1000;
+
+    for (size_t i = 0; i < MAX_CONTEXTS; i++) {
+        sys[i] = calloc(1, size);
+        if (sys[i] == NULL
+            || Tss2_Sys_Initialize(sys[i], size, (TSS2_TCTI_CONTEXT *)&tcti, &ver)
+                   != TSS2_RC_SUCCESS) {
+            fprintf(stderr, "Tss2_Sys_Initialize failed\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("TPM latency %lu us, us per command:\n", latency_us);
+    printf("%-14s %10s %10s %10s\n", "host work", "serial", "batch/1", "batch/2");
+    for (size_t i = 0; i < sizeof(work_ns) / sizeof(work_ns[0]); i++) {
+        serial = run(sys, 0, iterations, work_ns[i]);
+        batch1 = run(sys, 1, iterations, work_ns[i]);
+        batch2 = run(sys, 2, iterations, work_ns[i]);
+        if (serial < 0 || batch1 < 0 || batch2 < 0) {
+            fprintf(stderr, "executing the commands failed\n");
+            ret = EXIT_FAILURE;
+            break;
+        }
+        printf("%-11ld us %10.1f %10.1f %10.1f\n", work_ns[i] / 1000, serial, batch1, batch2);
+    }
+
+    for (size_t i = 0; i < MAX_CONTEXTS; i++) {
+        Tss2_Sys_Finalize(sys[i]);
+        free(sys[i]);
+    }
+    return ret;
+}
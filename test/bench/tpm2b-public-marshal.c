@@ -0,0 +1,348 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <stdio.h>  // for printf, fprintf, stderr
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS, strtoul
+#include <string.h> // for memcmp, memset
+#include <time.h>   // for timespec, clock_gettime, CLOCK_MONOTONIC
+
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS
+#include "tss2_mu.h"         // for Tss2_MU_TPM2B_PUBLIC_Marshal, Tss2_MU_UINT16...
+#include "tss2_tpm2_types.h" // for TPM2B_PUBLIC, TPMT_PUBLIC, TPM2_ALG_RSA, ...
+
+/*
+ * Benchmark of the marshaling of TPM2B_PUBLIC, as sent with TPM2_Create and
+ * returned by TPM2_ReadPublic. Each key is (un)marshaled with
+ * Tss2_MU_TPM2B_PUBLIC_(Un)Marshal and with one exported Tss2_MU call per
+ * field, the way the nested marshalers called the logging base type functions
+ * before they used the inline primitives. The results of both must be equal.
+ * Run it without TSS2_LOG to measure the default log level of a distribution
+ * build.
+ *
+ * Usage: tpm2b-public-marshal [iterations]
+ */
+
+#define DEFAULT_ITERATIONS 100000
+
+static double
+elapsed_ns(const struct timespec *start) {
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start->tv_sec) * 1e9 + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+static TSS2_RC
+sym_by_field(const TPMT_SYM_DEF_OBJECT *src, uint8_t buffer[], size_t size, size_t *offset) {
+    TSS2_RC r = Tss2_MU_UINT16_Marshal(src->algorithm, buffer, size, offset);
+
+    if (r != TSS2_RC_SUCCESS || src->algorithm == TPM2_ALG_NULL)
+        return r;
+    r = Tss2_MU_UINT16_Marshal(src->keyBits.sym, buffer, size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT16_Marshal(src->mode.sym, buffer, size, offset);
+    return r;
+}
+
+static TSS2_RC
+scheme_by_field(TPM2_ALG_ID scheme,
+                TPMI_ALG_HASH hash_alg,
+                uint8_t       buffer[],
+                size_t        size,
+                size_t       *offset) {
+    TSS2_RC r = Tss2_MU_UINT16_Marshal(scheme, buffer, size, offset);
+
+    if (r == TSS2_RC_SUCCESS && scheme != TPM2_ALG_NULL)
+        r = Tss2_MU_UINT16_Marshal(hash_alg, buffer, size, offset);
+    return r;
+}
+
+static TSS2_RC
+marshal_by_field(const TPM2B_PUBLIC *src, uint8_t buffer[], size_t size, size_t *offset) {
+    const TPMT_PUBLIC *pub = &src->publicArea;
+    size_t             start = *offset;
+    TSS2_RC            r;
+
+    r = Tss2_MU_UINT16_Marshal(0, buffer, size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT16_Marshal(pub->type, buffer, size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT16_Marshal(pub->nameAlg, buffer, size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Marshal(pub->objectAttributes, buffer, size, offset);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_TPM2B_DIGEST_Marshal(&pub->authPolicy, buffer, size, offset);
+    if (r != TSS2_RC_SUCCESS)
+        return r;
+
+    if (pub->type == TPM2_ALG_RSA) {
+        const TPMS_RSA_PARMS *rsa = &pub->parameters.rsaDetail;
+
+        r = sym_by_field(&rsa->symmetric, buffer, size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = scheme_by_field(rsa->scheme.scheme, rsa->scheme.details.anySig.hashAlg, buffer,
+                                size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT16_Marshal(rsa->keyBits, buffer, size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT32_Marshal(rsa->exponent, buffer, size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_TPM2B_PUBLIC_KEY_RSA_Marshal(&pub->unique.rsa, buffer, size, offset);
+    } else {
+        const TPMS_ECC_PARMS *ecc = &pub->parameters.eccDetail;
+
+        r = sym_by_field(&ecc->symmetric, buffer, size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = scheme_by_field(ecc->scheme.scheme, ecc->scheme.details.anySig.hashAlg, buffer,
+                                size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT16_Marshal(ecc->curveID, buffer, size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = scheme_by_field(ecc->kdf.scheme, ecc->kdf.details.mgf1.hashAlg, buffer, size,
+                                offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_TPM2B_ECC_PARAMETER_Marshal(&pub->unique.ecc.x, buffer, size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_TPM2B_ECC_PARAMETER_Marshal(&pub->unique.ecc.y, buffer, size, offset);
+    }
+    if (r != TSS2_RC_SUCCESS)
+        return r;
+
+    return Tss2_MU_UINT16_Marshal((UINT16)(*offset - start - sizeof(UINT16)), buffer, size,
+                                  &start);
+}
+
+static TSS2_RC
+marshal_by_type(const TPM2B_PUBLIC *src, uint8_t buffer[], size_t size, size_t *offset) {
+    return Tss2_MU_TPM2B_PUBLIC_Marshal(src, buffer, size, offset);
+}
+
+static TSS2_RC
+sym_unmarshal_by_field(uint8_t const        buffer[],
+                       size_t               size,
+                       size_t              *offset,
+                       TPMT_SYM_DEF_OBJECT *dest) {
+    TSS2_RC r = Tss2_MU_UINT16_Unmarshal(buffer, size, offset, &dest->algorithm);
+
+    if (r != TSS2_RC_SUCCESS || dest->algorithm == TPM2_ALG_NULL)
+        return r;
+    r = Tss2_MU_UINT16_Unmarshal(buffer, size, offset, &dest->keyBits.sym);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT16_Unmarshal(buffer, size, offset, &dest->mode.sym);
+    return r;
+}
+
+static TSS2_RC
+scheme_unmarshal_by_field(uint8_t const  buffer[],
+                          size_t         size,
+                          size_t        *offset,
+                          TPM2_ALG_ID   *scheme,
+                          TPMI_ALG_HASH *hash_alg) {
+    TSS2_RC r = Tss2_MU_UINT16_Unmarshal(buffer, size, offset, scheme);
+
+    if (r == TSS2_RC_SUCCESS && *scheme != TPM2_ALG_NULL)
+        r = Tss2_MU_UINT16_Unmarshal(buffer, size, offset, hash_alg);
+    return r;
+}
+
+static TSS2_RC
+unmarshal_by_field(uint8_t const buffer[], size_t size, size_t *offset, TPM2B_PUBLIC *dest) {
+    TPMT_PUBLIC *pub = &dest->publicArea;
+    TSS2_RC      r;
+
+    r = Tss2_MU_UINT16_Unmarshal(buffer, size, offset, &dest->size);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT16_Unmarshal(buffer, size, offset, &pub->type);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT16_Unmarshal(buffer, size, offset, &pub->nameAlg);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_UINT32_Unmarshal(buffer, size, offset, &pub->objectAttributes);
+    if (r == TSS2_RC_SUCCESS)
+        r = Tss2_MU_TPM2B_DIGEST_Unmarshal(buffer, size, offset, &pub->authPolicy);
+    if (r != TSS2_RC_SUCCESS)
+        return r;
+
+    if (pub->type == TPM2_ALG_RSA) {
+        TPMS_RSA_PARMS *rsa = &pub->parameters.rsaDetail;
+
+        r = sym_unmarshal_by_field(buffer, size, offset, &rsa->symmetric);
+        if (r == TSS2_RC_SUCCESS)
+            r = scheme_unmarshal_by_field(buffer, size, offset, &rsa->scheme.scheme,
+                                          &rsa->scheme.details.anySig.hashAlg);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT16_Unmarshal(buffer, size, offset, &rsa->keyBits);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT32_Unmarshal(buffer, size, offset, &rsa->exponent);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_TPM2B_PUBLIC_KEY_RSA_Unmarshal(buffer, size, offset, &pub->unique.rsa);
+    } else {
+        TPMS_ECC_PARMS *ecc = &pub->parameters.eccDetail;
+
+        r = sym_unmarshal_by_field(buffer, size, offset, &ecc->symmetric);
+        if (r == TSS2_RC_SUCCESS)
+            r = scheme_unmarshal_by_field(buffer, size, offset, &ecc->scheme.scheme,
+                                          &ecc->scheme.details.anySig.hashAlg);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT16_Unmarshal(buffer, size, offset, &ecc->curveID);
+        if (r == TSS2_RC_SUCCESS)
+            r = scheme_unmarshal_by_field(buffer, size, offset, &ecc->kdf.scheme,
+                                          &ecc->kdf.details.mgf1.hashAlg);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_TPM2B_ECC_PARAMETER_Unmarshal(buffer, size, offset, &pub->unique.ecc.x);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_TPM2B_ECC_PARAMETER_Unmarshal(buffer, size, offset, &pub->unique.ecc.y);
+    }
+    return r;
+}
+
+static TSS2_RC
+unmarshal_by_type(uint8_t const buffer[], size_t size, size_t *offset, TPM2B_PUBLIC *dest) {
+    return Tss2_MU_TPM2B_PUBLIC_Unmarshal(buffer, size, offset, dest);
+}
+
+typedef TSS2_RC (*MARSHAL_FCN)(const TPM2B_PUBLIC *src,
+                               uint8_t             buffer[],
+                               size_t              buffer_size,
+                               size_t             *offset);
+
+typedef TSS2_RC (*UNMARSHAL_FCN)(uint8_t const buffer[],
+                                 size_t        buffer_size,
+                                 size_t       *offset,
+                                 TPM2B_PUBLIC *dest);
+
+typedef struct {
+    const char         *name;
+    const TPM2B_PUBLIC *key;
+} BENCH_CASE;
+
+static double
+run_marshal(MARSHAL_FCN         fcn,
+            const TPM2B_PUBLIC *key,
+            uint8_t            *buffer,
+            size_t              size,
+            unsigned long       iterations) {
+    struct timespec start;
+    size_t          offset;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned long i = 0; i < iterations; i++) {
+        offset = 0;
+        if (fcn(key, buffer, size, &offset) != TSS2_RC_SUCCESS)
+            return -1;
+    }
+    return elapsed_ns(&start) / (double)iterations;
+}
+
+static double
+run_unmarshal(UNMARSHAL_FCN  fcn,
+              const uint8_t *buffer,
+              size_t         size,
+              TPM2B_PUBLIC  *dest,
+              unsigned long  iterations) {
+    struct timespec start;
+    size_t          offset;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned long i = 0; i < iterations; i++) {
+        offset = 0;
+        if (fcn(buffer, size, &offset, dest) != TSS2_RC_SUCCESS)
+            return -1;
+    }
+    return elapsed_ns(&start) / (double)iterations;
+}
+
+int
+main(int argc, char *argv[]) {
+    static TPM2B_PUBLIC rsa, ecc, expected_key, key;
+    static uint8_t      expected[sizeof(TPM2B_PUBLIC)];
+    static uint8_t      buffer[sizeof(TPM2B_PUBLIC)];
+    unsigned long       iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : DEFAULT_ITERATIONS;
+    size_t              size_expected, size, offset_expected, offset;
+    double              ns_field, ns_type, ns_field_un, ns_type_un;
+
+    const BENCH_CASE cases[] = {
+        { "RSA 2048 storage key", &rsa },
+        { "ECC P-256 signing key", &ecc },
+    };
+
+    if (iterations == 0)
+        iterations = DEFAULT_ITERATIONS;
+
+    rsa.publicArea.type = TPM2_ALG_RSA;
+    rsa.publicArea.nameAlg = TPM2_ALG_SHA256;
+    rsa.publicArea.objectAttributes = TPMA_OBJECT_RESTRICTED | TPMA_OBJECT_DECRYPT
+                                      | TPMA_OBJECT_FIXEDTPM | TPMA_OBJECT_FIXEDPARENT
+                                      | TPMA_OBJECT_SENSITIVEDATAORIGIN
+                                      | TPMA_OBJECT_USERWITHAUTH;
+    rsa.publicArea.authPolicy.size = TPM2_SHA256_DIGEST_SIZE;
+    rsa.publicArea.parameters.rsaDetail.symmetric.algorithm = TPM2_ALG_AES;
+    rsa.publicArea.parameters.rsaDetail.symmetric.keyBits.aes = 128;
+    rsa.publicArea.parameters.rsaDetail.symmetric.mode.aes = TPM2_ALG_CFB;
+    rsa.publicArea.parameters.rsaDetail.scheme.scheme = TPM2_ALG_NULL;
+    rsa.publicArea.parameters.rsaDetail.keyBits = 2048;
+    rsa.publicArea.unique.rsa.size = 256;
+    for (size_t i = 0; i < rsa.publicArea.unique.rsa.size; i++)
+        rsa.publicArea.unique.rsa.buffer[i] = (BYTE)i;
+
+    ecc.publicArea.type = TPM2_ALG_ECC;
+    ecc.publicArea.nameAlg = TPM2_ALG_SHA256;
+    ecc.publicArea.objectAttributes = TPMA_OBJECT_SIGN_ENCRYPT | TPMA_OBJECT_FIXEDTPM
+                                      | TPMA_OBJECT_FIXEDPARENT
+                                      | TPMA_OBJECT_SENSITIVEDATAORIGIN
+                                      | TPMA_OBJECT_USERWITHAUTH;
+    ecc.publicArea.parameters.eccDetail.symmetric.algorithm = TPM2_ALG_NULL;
+    ecc.publicArea.parameters.eccDetail.scheme.scheme = TPM2_ALG_ECDSA;
+    ecc.publicArea.parameters.eccDetail.scheme.details.ecdsa.hashAlg = TPM2_ALG_SHA256;
+    ecc.publicArea.parameters.eccDetail.curveID = TPM2_ECC_NIST_P256;
+    ecc.publicArea.parameters.eccDetail.kdf.scheme = TPM2_ALG_NULL;
+    ecc.publicArea.unique.ecc.x.size = 32;
+    ecc.publicArea.unique.ecc.y.size = 32;
+    for (size_t i = 0; i < 32; i++) {
+        ecc.publicArea.unique.ecc.x.buffer[i] = (BYTE)i;
+        ecc.publicArea.unique.ecc.y.buffer[i] = (BYTE)(0xff - i);
+    }
+
+    printf("%-22s %6s %12s %12s %12s %12s\n", "key", "bytes", "ns/field", "ns/type",
+           "ns/field-un", "ns/type-un");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        size_expected = 0;
+        size = 0;
+        memset(buffer, 0, sizeof(buffer));
+        if (marshal_by_field(cases[i].key, expected, sizeof(expected), &size_expected)
+                != TSS2_RC_SUCCESS
+            || marshal_by_type(cases[i].key, buffer, sizeof(buffer), &size) != TSS2_RC_SUCCESS
+            || size != size_expected || memcmp(buffer, expected, size) != 0) {
+            fprintf(stderr, "%s: marshaled keys differ\n", cases[i].name);
+            return EXIT_FAILURE;
+        }
+
+        offset_expected = 0;
+        offset = 0;
+        memset(&expected_key, 0, sizeof(expected_key));
+        memset(&key, 0, sizeof(key));
+        if (unmarshal_by_field(buffer, size, &offset_expected, &expected_key) != TSS2_RC_SUCCESS
+            || unmarshal_by_type(buffer, size, &offset, &key) != TSS2_RC_SUCCESS
+            || offset != offset_expected || offset != size
+            || memcmp(&key, &expected_key, sizeof(key)) != 0
+            || memcmp(&key.publicArea, &cases[i].key->publicArea, sizeof(key.publicArea)) != 0) {
+            fprintf(stderr, "%s: unmarshaled keys differ\n", cases[i].name);
+            return EXIT_FAILURE;
+        }
+
+        ns_field = run_marshal(marshal_by_field, cases[i].key, buffer, sizeof(buffer), iterations);
+        ns_type = run_marshal(marshal_by_type, cases[i].key, buffer, sizeof(buffer), iterations);
+        ns_field_un = run_unmarshal(unmarshal_by_field, expected, size, &key, iterations);
+        ns_type_un = run_unmarshal(unmarshal_by_type, expected, size, &key, iterations);
+        if (ns_field < 0 || ns_type < 0 || ns_field_un < 0 || ns_type_un < 0) {
+            fprintf(stderr, "%s: marshaling failed\n", cases[i].name);
+            return EXIT_FAILURE;
+        }
+        printf("%-22s %6zu %12.1f %12.1f %12.1f %12.1f\n", cases[i].name, size, ns_field,
+               ns_type, ns_field_un, ns_type_un);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <stdio.h>  // for printf, fprintf, stderr
+#include <stdlib.h> // for EXIT_FAILURE, EXIT_SUCCESS, strtoul
+#include <string.h> // for memcmp, memset
+#include <time.h>   // for timespec, clock_gettime, CLOCK_MONOTONIC
+
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS
+#include "tss2_mu.h"         // for Tss2_MU_TPML_CC_Marshal, Tss2_MU_UINT32...
+#include "tss2_tpm2_types.h" // for TPML_CC, TPML_HANDLE, TPML_TAGGED_TPM_...
+
+/*
+ * Benchmark of the marshaling of full capability lists, as returned by
+ * TPM2_GetCapability. Each list is marshaled with its Tss2_MU function and
+ * with one Tss2_MU call per integer, the way the lists were marshaled before
+ * the layout tables. The output of both must be equal.
+ *
+ * Usage: tpml-marshal [iterations]
+ */
+
+#define DEFAULT_ITERATIONS 100000
+
+static double
+elapsed_ns(const struct timespec *start) {
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start->tv_sec) * 1e9 + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+static TSS2_RC
+cc_by_element(const void *list, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    const TPML_CC *src = list;
+    TSS2_RC       r = Tss2_MU_UINT32_Marshal(src->count, buffer, buffer_size, offset);
+
+    for (UINT32 i = 0; r == TSS2_RC_SUCCESS && i < src->count; i++)
+        r = Tss2_MU_UINT32_Marshal(src->commandCodes[i], buffer, buffer_size, offset);
+    return r;
+}
+
+static TSS2_RC
+cc_by_list(const void *list, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    return Tss2_MU_TPML_CC_Marshal(list, buffer, buffer_size, offset);
+}
+
+static TSS2_RC
+handle_by_element(const void *list, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    const TPML_HANDLE *src = list;
+    TSS2_RC           r = Tss2_MU_UINT32_Marshal(src->count, buffer, buffer_size, offset);
+
+    for (UINT32 i = 0; r == TSS2_RC_SUCCESS && i < src->count; i++)
+        r = Tss2_MU_UINT32_Marshal(src->handle[i], buffer, buffer_size, offset);
+    return r;
+}
+
+static TSS2_RC
+handle_by_list(const void *list, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    return Tss2_MU_TPML_HANDLE_Marshal(list, buffer, buffer_size, offset);
+}
+
+static TSS2_RC
+alg_property_by_element(const void *list, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    const TPML_ALG_PROPERTY *src = list;
+    TSS2_RC                 r = Tss2_MU_UINT32_Marshal(src->count, buffer, buffer_size, offset);
+
+    for (UINT32 i = 0; r == TSS2_RC_SUCCESS && i < src->count; i++) {
+        r = Tss2_MU_UINT16_Marshal(src->algProperties[i].alg, buffer, buffer_size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT32_Marshal(src->algProperties[i].algProperties, buffer, buffer_size,
+                                       offset);
+    }
+    return r;
+}
+
+static TSS2_RC
+alg_property_by_list(const void *list, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    return Tss2_MU_TPML_ALG_PROPERTY_Marshal(list, buffer, buffer_size, offset);
+}
+
+static TSS2_RC
+tagged_by_element(const void *list, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    const TPML_TAGGED_TPM_PROPERTY *src = list;
+    TSS2_RC                        r;
+
+    r = Tss2_MU_UINT32_Marshal(src->count, buffer, buffer_size, offset);
+    for (UINT32 i = 0; r == TSS2_RC_SUCCESS && i < src->count; i++) {
+        r = Tss2_MU_UINT32_Marshal(src->tpmProperty[i].property, buffer, buffer_size, offset);
+        if (r == TSS2_RC_SUCCESS)
+            r = Tss2_MU_UINT32_Marshal(src->tpmProperty[i].value, buffer, buffer_size, offset);
+    }
+    return r;
+}
+
+static TSS2_RC
+tagged_by_list(const void *list, uint8_t buffer[], size_t buffer_size, size_t *offset) {
+    return Tss2_MU_TPML_TAGGED_TPM_PROPERTY_Marshal(list, buffer, buffer_size, offset);
+}
+
+typedef TSS2_RC (*MARSHAL_FCN)(const void *src,
+                               uint8_t     buffer[],
+                               size_t      buffer_size,
+                               size_t     *offset);
+
+typedef struct {
+    const char *name;
+    const void *list;
+    MARSHAL_FCN by_element;
+    MARSHAL_FCN by_list;
+} BENCH_CASE;
+
+static double
+run(MARSHAL_FCN fcn, const void *list, uint8_t *buffer, size_t size, unsigned long iterations) {
+    struct timespec start;
+    size_t          offset;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned long i = 0; i < iterations; i++) {
+        offset = 0;
+        if (fcn(list, buffer, size, &offset) != TSS2_RC_SUCCESS)
+            return -1;
+    }
+    return elapsed_ns(&start) / (double)iterations;
+}
+
+int
+main(int argc, char *argv[]) {
+    static TPML_CC                  cc;
+    static TPML_HANDLE              handle;
+    static TPML_ALG_PROPERTY        alg_property;
+    static TPML_TAGGED_TPM_PROPERTY tagged;
+    static uint8_t                  expected[sizeof(TPMS_CAPABILITY_DATA)];
+    static uint8_t                  buffer[sizeof(TPMS_CAPABILITY_DATA)];
+    unsigned long iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : DEFAULT_ITERATIONS;
+    size_t        size_expected, size;
+    double        ns_element, ns_list;
+
+    const BENCH_CASE cases[] = {
+        { "TPML_CC", &cc, cc_by_element, cc_by_list },
+        { "TPML_HANDLE", &handle, handle_by_element, handle_by_list },
+        { "TPML_ALG_PROPERTY", &alg_property, alg_property_by_element,
+          alg_property_by_list },
+        { "TPML_TAGGED_TPM_PROPERTY", &tagged, tagged_by_element,
+          tagged_by_list },
+    };
+
+    if (iterations == 0)
+        iterations = DEFAULT_ITERATIONS;
+
+    cc.count = TPM2_MAX_CAP_CC;
+    for (UINT32 i = 0; i < cc.count; i++)
+        cc.commandCodes[i] = TPM2_CC_FIRST + i;
+    handle.count = TPM2_MAX_CAP_HANDLES;
+    for (UINT32 i = 0; i < handle.count; i++)
+        handle.handle[i] = TPM2_PERSISTENT_FIRST + i;
+    alg_property.count = TPM2_MAX_CAP_ALGS;
+    for (UINT32 i = 0; i < alg_property.count; i++) {
+        alg_property.algProperties[i].alg = (TPM2_ALG_ID)i;
+        alg_property.algProperties[i].algProperties = 0x01020304 + i;
+    }
+    tagged.count = TPM2_MAX_TPM_PROPERTIES;
+    for (UINT32 i = 0; i < tagged.count; i++) {
+        tagged.tpmProperty[i].property = TPM2_PT_FIXED + i;
+        tagged.tpmProperty[i].value = 0xa0b0c0d0 + i;
+    }
+
+    printf("%-26s %8s %14s %14s\n", "list", "bytes", "ns/element", "ns/list");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        size_expected = 0;
+        size = 0;
+        memset(buffer, 0, sizeof(buffer));
+        if (cases[i].by_element(cases[i].list, expected, sizeof(expected), &size_expected)
+                != TSS2_RC_SUCCESS
+            || cases[i].by_list(cases[i].list, buffer, sizeof(buffer), &size) != TSS2_RC_SUCCESS
+            || size != size_expected || memcmp(buffer, expected, size) != 0) {
+            fprintf(stderr, "%s: marshaled lists differ\n", cases[i].name);
+            return EXIT_FAILURE;
+        }
+
+        ns_element = run(cases[i].by_element, cases[i].list, buffer, sizeof(buffer), iterations);
+        ns_list = run(cases[i].by_list, cases[i].list, buffer, sizeof(buffer), iterations);
+        if (ns_element < 0 || ns_list < 0) {
+            fprintf(stderr, "%s: marshaling failed\n", cases[i].name);
+            return EXIT_FAILURE;
+        }
+        printf("%-26s %8zu %14.1f %14.1f\n", cases[i].name, size, ns_element, ns_list);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t
+#include <stdlib.h>   // for NULL, EXIT_FAILURE, EXIT_SUCCESS, malloc, free
+#include <string.h>   // for memcmp, memcpy
+#include <time.h>     // for timespec, clock_gettime, CLOCK_MONOTONIC
+
+#include "tss2_common.h"     // for TSS2_RC, TSS2_RC_SUCCESS
+#include "tss2_esys.h"       // for Esys_HashBuffer, ESYS_TR_NONE, Esys_Free
+#include "tss2_tpm2_types.h" // for TPM2B_DIGEST, TPM2B_MAX_BUFFER, TPM2_AL...
+
+#define LOGMODULE test
+#include "util/log.h" // for goto_if_error, LOG_ERROR, LOG_INFO
+
+/* Size of the data hashed by each variant */
+#define HASH_STREAM_SIZE (256 * 1024)
+
+static double
+elapsed(const struct timespec *start) {
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start->tv_sec) + (double)(end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/* The plain sequence: one synchronous update per chunk */
+static TSS2_RC
+hash_updates(ESYS_CONTEXT   *esys_context,
+             const uint8_t  *data,
+             size_t          size,
+             TPM2B_DIGEST  **result) {
+    TSS2_RC            r;
+    TPM2B_AUTH         auth = { 0 };
+    TPM2B_MAX_BUFFER   chunk;
+    TPMT_TK_HASHCHECK *validation = NULL;
+    ESYS_TR            sequence;
+    size_t             offset = 0;
+
+    r = Esys_HashSequenceStart(esys_context, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &auth,
+                               TPM2_ALG_SHA256, &sequence);
+    return_if_error(r, "Error: HashSequenceStart");
+
+    while (size - offset > sizeof(chunk.buffer)) {
+        chunk.size = sizeof(chunk.buffer);
+        memcpy(&chunk.buffer[0], &data[offset], chunk.size);
+        offset += chunk.size;
+        r = Esys_SequenceUpdate(esys_context, sequence, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                ESYS_TR_NONE, &chunk);
+        goto_if_error(r, "Error: SequenceUpdate", error);
+    }
+    chunk.size = (UINT16)(size - offset);
+    memcpy(&chunk.buffer[0], &data[offset], chunk.size);
+    r = Esys_SequenceComplete(esys_context, sequence, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                              ESYS_TR_NONE, &chunk, ESYS_TR_RH_NULL, result, &validation);
+    goto_if_error(r, "Error: SequenceComplete", error);
+    Esys_Free(validation);
+    return TSS2_RC_SUCCESS;
+
+error:
+    Esys_FlushContext(esys_context, sequence);
+    return r;
+}
+
+/** Test Esys_HashBuffer and compare its throughput to a plain sequence.
+ *
+ * The same data is hashed by a sequence sending one SequenceUpdate after the
+ * other and by Esys_HashBuffer. The digests must match; the throughput of
+ * both is logged.
+ *
+ * Tested ESYS commands:
+ *  - Esys_HashBuffer() (M)
+ *  - Esys_HashSequenceStart() (M)
+ *  - Esys_SequenceComplete() (M)
+ *  - Esys_SequenceUpdate() (M)
+ *
+ * @param[in,out] esys_context The ESYS_CONTEXT.
+ * @retval EXIT_FAILURE
+ * @retval EXIT_SUCCESS
+ */
+int
+test_esys_hash_stream(ESYS_CONTEXT *esys_context) {
+    TSS2_RC            r;
+    uint8_t           *data;
+    TPM2B_DIGEST      *expected = NULL;
+    TPM2B_DIGEST      *result = NULL;
+    TPMT_TK_HASHCHECK *validation = NULL;
+    struct timespec    start;
+    double             t_updates, t_stream;
+    int                rc = EXIT_FAILURE;
+
+    data = malloc(HASH_STREAM_SIZE);
+    if (data == NULL) {
+        LOG_ERROR("Out of memory.");
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < HASH_STREAM_SIZE; i++)
+        data[i] = (uint8_t)(i * 7);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    r = hash_updates(esys_context, data, HASH_STREAM_SIZE, &expected);
+    goto_if_error(r, "Error: Hash with updates", error);
+    t_updates = elapsed(&start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    r = Esys_HashBuffer(esys_context, ESYS_TR_NONE, ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE,
+                        TPM2_ALG_SHA256, ESYS_TR_RH_NULL, data, HASH_STREAM_SIZE, &result,
+                        &validation);
+    goto_if_error(r, "Error: HashBuffer", error);
+    t_stream = elapsed(&start);
+
+    if (result->size != expected->size
+        || memcmp(&result->buffer[0], &expected->buffer[0], result->size) != 0) {
+        LOG_ERROR("Digests of Esys_HashBuffer and the sequence differ.");
+        goto error;
+    }
+
+    LOG_INFO("Hashed %u KiB: sequence updates %.1f KiB/s, Esys_HashBuffer %.1f KiB/s",
+             HASH_STREAM_SIZE / 1024, HASH_STREAM_SIZE / 1024 / t_updates,
+             HASH_STREAM_SIZE / 1024 / t_stream);
+    rc = EXIT_SUCCESS;
+
+error:
+    Esys_Free(expected);
+    Esys_Free(result);
+    Esys_Free(validation);
+    free(data);
+    return rc;
+}
+
+int
+test_invoke_esys(ESYS_CONTEXT *esys_context) {
+    return test_esys_hash_stream(esys_context);
+}
@@ -450,6 +450,35 @@ tpm2b_tpm2b_max_cap_buffer_unmarshal_marshal(void **state) {
     assert_int_equal(offset, sizeof(buf));
 }
 
+/*
+ * Unmarshal a view into the buffer without copying the payload
+ */
+static void
+tpm2b_unmarshal_view(void **state) {
+    TSS2_RC        rc;
+    size_t         offset = 2;
+    const uint8_t *data = NULL;
+    UINT16         data_size = 0;
+    const uint8_t  buf[] = { 0xff, 0xff,             /* 2 bytes offset */
+                             0x00, 0x04,             /* UINT16 size of 4 */
+                             0xde, 0xad, 0xbe, 0xef, /* DATA of 4 bytes */
+                             0x00, 0x08,             /* truncated TPM2B */
+                             0x01, 0x02 };
+
+    rc = Tss2_MU_TPM2B_MAX_NV_BUFFER_UnmarshalView(buf, sizeof(buf), &offset, &data, &data_size);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_ptr_equal(data, &buf[4]);
+    assert_int_equal(data_size, 4);
+    assert_int_equal(offset, 8);
+
+    rc = Tss2_MU_TPM2B_MAX_NV_BUFFER_UnmarshalView(buf, sizeof(buf), &offset, &data, &data_size);
+    assert_int_equal(rc, TSS2_MU_RC_INSUFFICIENT_BUFFER);
+    assert_int_equal(offset, 8);
+
+    rc = Tss2_MU_TPM2B_MAX_NV_BUFFER_UnmarshalView(NULL, sizeof(buf), &offset, &data, &data_size);
+    assert_int_equal(rc, TSS2_MU_RC_BAD_REFERENCE);
+}
+
 int
 main(void) {
     const struct CMUnitTest tests[]
@@ -466,6 +495,7 @@ main(void) {
             cmocka_unit_test(tpm2b_unmarshal_buffer_size_lt_data_nad_lt_offset),
             cmocka_unit_test(tpm2b_public_rsa_marshal_success),
             cmocka_unit_test(tpm2b_public_rsa_unique_size_marshal_success),
-            cmocka_unit_test(tpm2b_tpm2b_max_cap_buffer_unmarshal_marshal) };
+            cmocka_unit_test(tpm2b_tpm2b_max_cap_buffer_unmarshal_marshal),
+            cmocka_unit_test(tpm2b_unmarshal_view) };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
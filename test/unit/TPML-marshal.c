@@ -9,7 +9,7 @@
 #endif
 
 #include <stddef.h> // for NULL, size_t
-#include <stdint.h> // for uint8_t
+#include <stdint.h> // for uint8_t, uint16_t, uint32_t
 #include <string.h> // for memcpy
 
 #include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test
@@ -438,6 +438,94 @@ tpml_unmarshal_invalid_count(void **state) {
     assert_int_equal(rc, TSS2_SYS_RC_MALFORMED_RESPONSE);
 }
 
+static void
+tpml_tagged_tpm_property_marshal_unmarshal(void **state) {
+    uint8_t const buf[] = {
+        0x00, 0x00, 0x00, 0x02, /* count */
+        0x00, 0x00, 0x01, 0x00, /* property */
+        0x32, 0x2e, 0x30, 0x00, /* value */
+        0x00, 0x00, 0x01, 0x05, /* property */
+        0x49, 0x42, 0x4d, 0x00  /* value */
+    };
+    TPML_TAGGED_TPM_PROPERTY props;
+    uint8_t                  buf2[sizeof(buf)] = { 0 };
+    size_t                   offset = 0;
+    TSS2_RC                  rc;
+
+    rc = Tss2_MU_TPML_TAGGED_TPM_PROPERTY_Unmarshal(buf, sizeof(buf), &offset, &props);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(offset, sizeof(buf));
+    assert_int_equal(props.count, 2);
+    assert_int_equal(props.tpmProperty[0].property, TPM2_PT_FAMILY_INDICATOR);
+    assert_int_equal(props.tpmProperty[0].value, 0x322e3000);
+    assert_int_equal(props.tpmProperty[1].property, TPM2_PT_MANUFACTURER);
+    assert_int_equal(props.tpmProperty[1].value, 0x49424d00);
+
+    offset = 0;
+    rc = Tss2_MU_TPML_TAGGED_TPM_PROPERTY_Marshal(&props, buf2, sizeof(buf2), &offset);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(offset, sizeof(buf));
+    assert_memory_equal(buf, buf2, sizeof(buf));
+
+    offset = 0;
+    rc = Tss2_MU_TPML_TAGGED_TPM_PROPERTY_Unmarshal(buf, sizeof(buf) - 1, &offset, &props);
+    assert_int_equal(rc, TSS2_MU_RC_INSUFFICIENT_BUFFER);
+    assert_int_equal(offset, 0);
+}
+
+/*
+ * Lists long enough to be byte swapped with vector instructions, with a
+ * remainder that is left to the scalar loop.
+ */
+static void
+tpml_bulk_marshal_unmarshal(void **state) {
+    TPML_HANDLE handles = { 0 };
+    TPML_ALG    algs = { 0 };
+    TPML_HANDLE handles2;
+    TPML_ALG    algs2;
+    uint8_t     buffer[sizeof(handles)] = { 0 };
+    uint32_t    handle;
+    uint16_t    alg;
+    size_t      offset = 0;
+    UINT32      i;
+    TSS2_RC     rc;
+
+    handles.count = 101;
+    for (i = 0; i < handles.count; i++)
+        handles.handle[i] = TPM2_PERSISTENT_FIRST + i * 0x01010101;
+
+    rc = Tss2_MU_TPML_HANDLE_Marshal(&handles, buffer, sizeof(buffer), &offset);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(offset, sizeof(UINT32) * (handles.count + 1));
+    for (i = 0; i < handles.count; i++) {
+        memcpy(&handle, &buffer[sizeof(UINT32) * (i + 1)], sizeof(handle));
+        assert_int_equal(handle, HOST_TO_BE_32(handles.handle[i]));
+    }
+
+    offset = 0;
+    rc = Tss2_MU_TPML_HANDLE_Unmarshal(buffer, sizeof(buffer), &offset, &handles2);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_memory_equal(&handles, &handles2, sizeof(handles));
+
+    algs.count = 77;
+    for (i = 0; i < algs.count; i++)
+        algs.algorithms[i] = (TPM2_ALG_ID)(i * 0x0101 + 1);
+
+    offset = 0;
+    rc = Tss2_MU_TPML_ALG_Marshal(&algs, buffer, sizeof(buffer), &offset);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(offset, sizeof(UINT32) + sizeof(UINT16) * algs.count);
+    for (i = 0; i < algs.count; i++) {
+        memcpy(&alg, &buffer[sizeof(UINT32) + sizeof(UINT16) * i], sizeof(alg));
+        assert_int_equal(alg, HOST_TO_BE_16(algs.algorithms[i]));
+    }
+
+    offset = 0;
+    rc = Tss2_MU_TPML_ALG_Unmarshal(buffer, sizeof(buffer), &offset, &algs2);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_memory_equal(&algs, &algs2, sizeof(algs));
+}
+
 #ifndef DISABLE_VENDOR
 static void
 tpml_intel_ptt_marshal_unmarshal(void **state) {
@@ -477,6 +565,8 @@ main(void) {
             cmocka_unit_test(tpml_unmarshal_dest_null_offset_valid),
             cmocka_unit_test(tpml_unmarshal_buffer_size_lt_data_nad_lt_offset),
             cmocka_unit_test(tpml_unmarshal_invalid_count),
+            cmocka_unit_test(tpml_tagged_tpm_property_marshal_unmarshal),
+            cmocka_unit_test(tpml_bulk_marshal_unmarshal),
 #ifndef DISABLE_VENDOR
             cmocka_unit_test(tpml_intel_ptt_marshal_unmarshal)
 #endif
@@ -362,6 +362,48 @@ tpms_capability_data_intel_ptt_marshal_unmarshal(void **state) {
     assert_memory_equal(buf, buf2, sizeof(buf2));
 }
 
+static void
+tpms_time_attest_info_marshal_unmarshal(void **state) {
+    uint8_t const buf[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, /* time */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, /* clock */
+        0x00, 0x00, 0x00, 0x05,                         /* resetCount */
+        0x00, 0x00, 0x00, 0x06,                         /* restartCount */
+        0x01,                                           /* safe */
+        0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x08  /* firmwareVersion */
+    };
+    TPMS_TIME_ATTEST_INFO info;
+    uint8_t               buf2[sizeof(buf)] = { 0 };
+    size_t                offset = 0;
+    TSS2_RC               rc;
+
+    rc = Tss2_MU_TPMS_TIME_ATTEST_INFO_Unmarshal(buf, sizeof(buf), &offset, &info);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(offset, sizeof(buf));
+    assert_int_equal(info.time.time, 0x0102);
+    assert_int_equal(info.time.clockInfo.clock, 0x0304);
+    assert_int_equal(info.time.clockInfo.resetCount, 5);
+    assert_int_equal(info.time.clockInfo.restartCount, 6);
+    assert_int_equal(info.time.clockInfo.safe, 1);
+    assert_int_equal(info.firmwareVersion, 0x0000000700000008);
+
+    offset = 0;
+    rc = Tss2_MU_TPMS_TIME_ATTEST_INFO_Marshal(&info, buf2, sizeof(buf2), &offset);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(offset, sizeof(buf));
+    assert_memory_equal(buf, buf2, sizeof(buf));
+
+    offset = 0;
+    rc = Tss2_MU_TPMS_TIME_ATTEST_INFO_Marshal(&info, NULL, 0, &offset);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(offset, sizeof(buf));
+
+    offset = 1;
+    rc = Tss2_MU_TPMS_TIME_ATTEST_INFO_Marshal(&info, buf2, sizeof(buf2), &offset);
+    assert_int_equal(rc, TSS2_MU_RC_INSUFFICIENT_BUFFER);
+    assert_int_equal(offset, 1);
+}
+
 int
 main(void) {
     const struct CMUnitTest tests[]
@@ -375,6 +417,7 @@ main(void) {
             cmocka_unit_test(tpms_unmarshal_buffer_null_offset_null),
             cmocka_unit_test(tpms_unmarshal_dest_null_offset_valid),
             cmocka_unit_test(tpms_unmarshal_buffer_size_lt_data_nad_lt_offset),
-            cmocka_unit_test(tpms_capability_data_intel_ptt_marshal_unmarshal) };
+            cmocka_unit_test(tpms_capability_data_intel_ptt_marshal_unmarshal),
+            cmocka_unit_test(tpms_time_attest_info_marshal_unmarshal) };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
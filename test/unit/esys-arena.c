@@ -0,0 +1,241 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, uint32_t, int32_t, uint64_t
+#include <stdlib.h>   // for NULL, size_t, free, calloc
+#include <string.h>   // for memcpy
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_...
+#include "tss2_esys.h"            // for Esys_ArenaEnable, Esys_ArenaReset
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT
+#include "tss2_tpm2_types.h"      // for TPM2B_DIGEST, TPM2_RC_FAILURE
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks that the outputs of the _Finish functions are taken
+ * from the arena of the ESYS context if the arena mode is enabled, that
+ * outputs of failed or repeated _Finish calls are returned to the arena and
+ * that Esys_ArenaReset() makes the memory available again.
+ */
+
+#define TCTI_RANDOM_MAGIC   0x52414e444f4d0000ULL /* 'RANDOM\0\0' */
+#define TCTI_RANDOM_VERSION 0x1
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    uint32_t delays;  /* number of receive calls to answer with TRY_AGAIN */
+    uint32_t failure; /* answer the next command with TPM2_RC_FAILURE */
+} TSS2_TCTI_CONTEXT_RANDOM;
+
+static TSS2_RC
+tcti_random_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    (void)tctiContext;
+    (void)size;
+    (void)buffer;
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_random_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                    size_t            *response_size,
+                    uint8_t           *response_buffer,
+                    int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_RANDOM *tcti = (TSS2_TCTI_CONTEXT_RANDOM *)tctiContext;
+    static const uint8_t      random_response[] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x1C, /* Response Size 28 */
+        0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+        0x00, 0x10,             /* randomBytes.size */
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+    };
+    static const uint8_t failure_response[] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x0A, /* Response Size 10 */
+        0x00, 0x00, 0x01, 0x01  /* TPM2_RC_FAILURE */
+    };
+    const uint8_t *response = &random_response[0];
+    size_t         size = sizeof(random_response);
+
+    (void)timeout;
+    if (tcti->delays > 0) {
+        tcti->delays--;
+        return TSS2_TCTI_RC_TRY_AGAIN;
+    }
+    if (tcti->failure) {
+        response = &failure_response[0];
+        size = sizeof(failure_response);
+    }
+    *response_size = size;
+    if (response_buffer != NULL) {
+        memcpy(response_buffer, response, size);
+        tcti->failure = 0;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+static int
+setup(void **state) {
+    TSS2_RC                   r;
+    ESYS_CONTEXT             *ectx;
+    TSS2_TCTI_CONTEXT_RANDOM *tcti = calloc(1, sizeof(*tcti));
+
+    if (tcti == NULL)
+        return -1;
+    tcti->magic = TCTI_RANDOM_MAGIC;
+    tcti->version = TCTI_RANDOM_VERSION;
+    tcti->transmit = tcti_random_transmit;
+    tcti->receive = tcti_random_receive;
+
+    r = Esys_Initialize(&ectx, (TSS2_TCTI_CONTEXT *)tcti, NULL);
+    *state = (void *)ectx;
+    return (int)r;
+}
+
+static int
+teardown(void **state) {
+    TSS2_TCTI_CONTEXT *tcti;
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+
+    Esys_GetTcti(ectx, &tcti);
+    Esys_Finalize(&ectx);
+    free(tcti);
+    return 0;
+}
+
+static TSS2_TCTI_CONTEXT_RANDOM *
+get_tcti(ESYS_CONTEXT *ectx) {
+    TSS2_TCTI_CONTEXT *tcti;
+
+    assert_int_equal(Esys_GetTcti(ectx, &tcti), TSS2_RC_SUCCESS);
+    return (TSS2_TCTI_CONTEXT_RANDOM *)tcti;
+}
+
+static TPM2B_DIGEST *
+get_random(ESYS_CONTEXT *ectx) {
+    TPM2B_DIGEST *randomBytes = NULL;
+    TSS2_RC       r;
+
+    r = Esys_GetRandom(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, 16, &randomBytes);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_non_null(randomBytes);
+    assert_int_equal(randomBytes->size, 16);
+    assert_int_equal(randomBytes->buffer[15], 16);
+    return randomBytes;
+}
+
+static void
+test_bad_reference(void **state) {
+    (void)state;
+
+    assert_int_equal(Esys_ArenaEnable(NULL, 1024), TSS2_ESYS_RC_BAD_REFERENCE);
+    assert_int_equal(Esys_ArenaReset(NULL), TSS2_ESYS_RC_BAD_REFERENCE);
+}
+
+static void
+test_reset(void **state) {
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)*state;
+    TPM2B_DIGEST *first, *second;
+
+    assert_int_equal(Esys_ArenaEnable(ectx, 1024), TSS2_RC_SUCCESS);
+    first = get_random(ectx);
+    second = get_random(ectx);
+    assert_ptr_not_equal(first, second);
+    assert_true((uint8_t *)second - (uint8_t *)first < 1024);
+
+    assert_int_equal(Esys_ArenaReset(ectx), TSS2_RC_SUCCESS);
+    assert_ptr_equal(get_random(ectx), first);
+    assert_ptr_equal(get_random(ectx), second);
+}
+
+static void
+test_growth(void **state) {
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)*state;
+    TPM2B_DIGEST *outputs[8];
+
+    /* Each output needs a block of its own */
+    assert_int_equal(Esys_ArenaEnable(ectx, sizeof(TPM2B_DIGEST) / 2), TSS2_RC_SUCCESS);
+    for (size_t i = 0; i < 8; i++) {
+        outputs[i] = get_random(ectx);
+        for (size_t j = 0; j < i; j++)
+            assert_ptr_not_equal(outputs[i], outputs[j]);
+    }
+
+    /* The blocks are reused in the same order */
+    assert_int_equal(Esys_ArenaReset(ectx), TSS2_RC_SUCCESS);
+    for (size_t i = 0; i < 8; i++)
+        assert_ptr_equal(get_random(ectx), outputs[i]);
+}
+
+static void
+test_failed_finish(void **state) {
+    ESYS_CONTEXT             *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_RANDOM *tcti = get_tcti(ectx);
+    TPM2B_DIGEST             *randomBytes = NULL;
+    TPM2B_DIGEST             *first;
+    TSS2_RC                   r;
+
+    assert_int_equal(Esys_ArenaEnable(ectx, 1024), TSS2_RC_SUCCESS);
+    first = get_random(ectx);
+    assert_int_equal(Esys_ArenaReset(ectx), TSS2_RC_SUCCESS);
+
+    /* The outputs of a failing command are returned to the arena */
+    tcti->failure = 1;
+    r = Esys_GetRandom(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, 16, &randomBytes);
+    assert_int_equal(r, TPM2_RC_FAILURE);
+    assert_ptr_equal(get_random(ectx), first);
+
+    /* Every polling call of a _Finish function allocates its outputs */
+    assert_int_equal(Esys_ArenaReset(ectx), TSS2_RC_SUCCESS);
+    r = Esys_GetRandom_Async(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, 16);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    tcti->delays = 3;
+    for (int i = 0; i < 3; i++) {
+        r = Esys_GetRandom_Finish(ectx, &randomBytes);
+        assert_int_equal(r, TSS2_TCTI_RC_TRY_AGAIN);
+    }
+    r = Esys_GetRandom_Finish(ectx, &randomBytes);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_ptr_equal(randomBytes, first);
+}
+
+static void
+test_disable(void **state) {
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)*state;
+    TPM2B_DIGEST *randomBytes;
+
+    assert_int_equal(Esys_ArenaEnable(ectx, 1024), TSS2_RC_SUCCESS);
+    get_random(ectx);
+    assert_int_equal(Esys_ArenaEnable(ectx, 0), TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_ArenaReset(ectx), TSS2_RC_SUCCESS);
+
+    /* Outputs are owned by the application again */
+    randomBytes = get_random(ectx);
+    Esys_Free(randomBytes);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_bad_reference),
+        cmocka_unit_test_setup_teardown(test_reset, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_growth, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_failed_finish, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_disable, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,337 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t, uint32_t, uint64_t
+#include <stdlib.h>   // for NULL, size_t, free, calloc
+#include <string.h>   // for memcpy
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_...
+#include "tss2_esys.h"            // for Esys_CapabilityCacheEnable, Esys_Get...
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT
+#include "tss2_tpm2_types.h"      // for TPMS_CAPABILITY_DATA, TPM2_CAP_ALGS
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks that the capability cache answers synchronous queries
+ * of fixed capabilities without TPM commands, using a TCTI that splits its responses
+ * into pages of a few entries.
+ */
+
+#define TCTI_CAP_MAGIC   0x4341500000000000ULL /* 'CAP\0\0\0\0\0' */
+#define TCTI_CAP_VERSION 0x1
+#define PAGE_SIZE        4
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    uint32_t capability; /* of the last query */
+    uint32_t property;   /* of the last query */
+    uint32_t count;      /* of the last query */
+    uint32_t commands;   /* number of TPM2_GetCapability commands */
+} TSS2_TCTI_CONTEXT_CAP;
+
+/* 12 fixed and 3 variable properties */
+static const uint32_t properties[] = {
+    0x100, 0x101, 0x102, 0x103, 0x104, 0x105, 0x106, 0x107,
+    0x108, 0x109, 0x10a, 0x10b, 0x200, 0x201, 0x202,
+};
+
+static const uint16_t algorithms[] = {
+    TPM2_ALG_RSA, TPM2_ALG_SHA1, TPM2_ALG_HMAC, TPM2_ALG_SHA256, TPM2_ALG_ECC,
+};
+
+static uint32_t
+get_uint32(const uint8_t *buffer) {
+    return (uint32_t)buffer[0] << 24 | (uint32_t)buffer[1] << 16 | (uint32_t)buffer[2] << 8
+           | buffer[3];
+}
+
+static void
+put_uint32(uint8_t *buffer, uint32_t value) {
+    buffer[0] = (uint8_t)(value >> 24);
+    buffer[1] = (uint8_t)(value >> 16);
+    buffer[2] = (uint8_t)(value >> 8);
+    buffer[3] = (uint8_t)value;
+}
+
+static TSS2_RC
+tcti_cap_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    TSS2_TCTI_CONTEXT_CAP *tcti = (TSS2_TCTI_CONTEXT_CAP *)tctiContext;
+
+    assert_int_equal(size, 22);
+    assert_int_equal(get_uint32(&buffer[6]), TPM2_CC_GetCapability);
+    tcti->capability = get_uint32(&buffer[10]);
+    tcti->property = get_uint32(&buffer[14]);
+    tcti->count = get_uint32(&buffer[18]);
+    tcti->commands++;
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_cap_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                 size_t            *response_size,
+                 uint8_t           *response_buffer,
+                 int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_CAP *tcti = (TSS2_TCTI_CONTEXT_CAP *)tctiContext;
+    uint8_t                response[256] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x00, /* Response Size */
+        0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+    };
+    size_t   size = 19, total, i;
+    uint32_t count = 0, key;
+
+    (void)timeout;
+    if (tcti->capability == TPM2_CAP_ALGS)
+        total = sizeof(algorithms) / sizeof(algorithms[0]);
+    else
+        total = sizeof(properties) / sizeof(properties[0]);
+
+    for (i = 0; i < total; i++) {
+        key = (tcti->capability == TPM2_CAP_ALGS) ? algorithms[i] : properties[i];
+        if (key < tcti->property)
+            continue;
+        if (count == tcti->count || count == PAGE_SIZE)
+            break;
+        if (tcti->capability == TPM2_CAP_ALGS) {
+            response[size++] = (uint8_t)(key >> 8);
+            response[size++] = (uint8_t)key;
+        } else {
+            put_uint32(&response[size], key);
+            size += 4;
+        }
+        put_uint32(&response[size], key * 2);
+        size += 4;
+        count++;
+    }
+    response[10] = (i < total) ? TPM2_YES : TPM2_NO;
+    put_uint32(&response[11], tcti->capability);
+    put_uint32(&response[15], count);
+    put_uint32(&response[2], (uint32_t)size);
+
+    *response_size = size;
+    if (response_buffer != NULL)
+        memcpy(response_buffer, &response[0], size);
+    return TSS2_RC_SUCCESS;
+}
+
+static int
+setup(void **state) {
+    TSS2_RC                r;
+    ESYS_CONTEXT          *ectx;
+    TSS2_TCTI_CONTEXT_CAP *tcti = calloc(1, sizeof(*tcti));
+
+    if (tcti == NULL)
+        return -1;
+    tcti->magic = TCTI_CAP_MAGIC;
+    tcti->version = TCTI_CAP_VERSION;
+    tcti->transmit = tcti_cap_transmit;
+    tcti->receive = tcti_cap_receive;
+
+    r = Esys_Initialize(&ectx, (TSS2_TCTI_CONTEXT *)tcti, NULL);
+    if (r != TSS2_RC_SUCCESS)
+        return (int)r;
+    r = Esys_CapabilityCacheEnable(ectx);
+    *state = (void *)ectx;
+    return (int)r;
+}
+
+static int
+teardown(void **state) {
+    TSS2_TCTI_CONTEXT *tcti;
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+
+    Esys_GetTcti(ectx, &tcti);
+    Esys_Finalize(&ectx);
+    free(tcti);
+    return 0;
+}
+
+static TSS2_TCTI_CONTEXT_CAP *
+get_tcti(ESYS_CONTEXT *ectx) {
+    TSS2_TCTI_CONTEXT *tcti;
+
+    assert_int_equal(Esys_GetTcti(ectx, &tcti), TSS2_RC_SUCCESS);
+    return (TSS2_TCTI_CONTEXT_CAP *)tcti;
+}
+
+/* Read all TPM properties like an application, following moreData */
+static size_t
+read_properties(ESYS_CONTEXT *ectx) {
+    TPMS_CAPABILITY_DATA *data;
+    TPMI_YES_NO           more = TPM2_YES;
+    UINT32                property = TPM2_PT_FIXED;
+    size_t                read = 0;
+
+    while (more == TPM2_YES) {
+        assert_int_equal(Esys_GetCapability(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                            TPM2_CAP_TPM_PROPERTIES, property,
+                                            TPM2_MAX_TPM_PROPERTIES, &more, &data),
+                         TSS2_RC_SUCCESS);
+        assert_int_equal(data->capability, TPM2_CAP_TPM_PROPERTIES);
+        assert_true(data->data.tpmProperties.count > 0);
+        for (UINT32 i = 0; i < data->data.tpmProperties.count; i++) {
+            assert_int_equal(data->data.tpmProperties.tpmProperty[i].property, properties[read]);
+            assert_int_equal(data->data.tpmProperties.tpmProperty[i].value, properties[read] * 2);
+            read++;
+        }
+        property = data->data.tpmProperties.tpmProperty[data->data.tpmProperties.count - 1].property
+                   + 1;
+        free(data);
+    }
+    return read;
+}
+
+static void
+test_properties(void **state) {
+    ESYS_CONTEXT          *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_CAP *tcti = get_tcti(ectx);
+    TPMS_CAPABILITY_DATA  *data;
+    TPMI_YES_NO            more;
+
+    /* The pages of the first read are merged into the cache */
+    assert_int_equal(read_properties(ectx), 15);
+    assert_int_equal(tcti->commands, 4);
+
+    /* The fixed properties come at once, only the variable ones are sent */
+    assert_int_equal(read_properties(ectx), 15);
+    assert_int_equal(tcti->commands, 5);
+    assert_int_equal(tcti->property, 0x10c);
+
+    assert_int_equal(Esys_GetCapability(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                        TPM2_CAP_TPM_PROPERTIES, 0x105, 1, &more, &data),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->commands, 5);
+    assert_int_equal(more, TPM2_YES);
+    assert_int_equal(data->data.tpmProperties.count, 1);
+    assert_int_equal(data->data.tpmProperties.tpmProperty[0].value, 0x105 * 2);
+    free(data);
+
+    /* Variable properties are never cached */
+    assert_int_equal(Esys_GetCapability(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                        TPM2_CAP_TPM_PROPERTIES, TPM2_PT_VAR, 1, &more, &data),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->commands, 6);
+    free(data);
+
+    /* After invalidation the TPM is asked again */
+    assert_int_equal(Esys_CapabilityCacheInvalidate(ectx), TSS2_RC_SUCCESS);
+    assert_int_equal(read_properties(ectx), 15);
+    assert_int_equal(tcti->commands, 10);
+}
+
+static void
+test_algorithms(void **state) {
+    ESYS_CONTEXT          *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_CAP *tcti = get_tcti(ectx);
+    TPMS_CAPABILITY_DATA  *data;
+    TPMI_YES_NO            more;
+
+    assert_int_equal(Esys_GetCapability(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                        TPM2_CAP_ALGS, TPM2_ALG_FIRST, TPM2_MAX_CAP_ALGS, &more,
+                                        &data),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(more, TPM2_YES);
+    assert_int_equal(data->data.algorithms.count, PAGE_SIZE);
+    free(data);
+    assert_int_equal(Esys_GetCapability(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                        TPM2_CAP_ALGS, TPM2_ALG_SHA256 + 1, TPM2_MAX_CAP_ALGS,
+                                        &more, &data),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(more, TPM2_NO);
+    free(data);
+    assert_int_equal(tcti->commands, 2);
+
+    /* Served from the cache in one answer */
+    assert_int_equal(Esys_GetCapability(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                        TPM2_CAP_ALGS, TPM2_ALG_FIRST, TPM2_MAX_CAP_ALGS, &more,
+                                        &data),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->commands, 2);
+    assert_int_equal(more, TPM2_NO);
+    assert_int_equal(data->data.algorithms.count, 5);
+    for (UINT32 i = 0; i < 5; i++)
+        assert_int_equal(data->data.algorithms.algProperties[i].alg, algorithms[i]);
+    free(data);
+
+    assert_int_equal(Esys_GetCapability(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                        TPM2_CAP_ALGS, TPM2_ALG_HMAC, 2, &more, &data),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->commands, 2);
+    assert_int_equal(more, TPM2_YES);
+    assert_int_equal(data->data.algorithms.count, 2);
+    assert_int_equal(data->data.algorithms.algProperties[0].alg, TPM2_ALG_HMAC);
+    assert_int_equal(data->data.algorithms.algProperties[1].alg, TPM2_ALG_SHA256);
+    free(data);
+
+    /* Without the cache every query is sent */
+    assert_int_equal(Esys_CapabilityCacheDisable(ectx), TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_GetCapability(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                        TPM2_CAP_ALGS, TPM2_ALG_HMAC, 2, &more, &data),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->commands, 3);
+    free(data);
+}
+
+static void
+test_async(void **state) {
+    ESYS_CONTEXT          *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_CAP *tcti = get_tcti(ectx);
+    TPMS_CAPABILITY_DATA  *data;
+    TPMI_YES_NO            more;
+
+    assert_int_equal(read_properties(ectx), 15);
+    assert_int_equal(tcti->commands, 4);
+
+    assert_int_equal(Esys_GetCapability_Async(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                              TPM2_CAP_TPM_PROPERTIES, TPM2_PT_FIXED,
+                                              TPM2_MAX_TPM_PROPERTIES),
+                     TSS2_RC_SUCCESS);
+    /* The asynchronous query is always sent, so the TCTI signals its response */
+    assert_int_equal(tcti->commands, 5);
+    assert_int_equal(Esys_CapabilityCacheInvalidate(ectx), TSS2_ESYS_RC_BAD_SEQUENCE);
+    assert_int_equal(Esys_GetCapability_Finish(ectx, &more, &data), TSS2_RC_SUCCESS);
+    assert_int_equal(more, TPM2_YES);
+    assert_int_equal(data->data.tpmProperties.count, PAGE_SIZE);
+    free(data);
+
+    /* The synchronous query is still answered by the cache */
+    assert_int_equal(Esys_GetCapability(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                        TPM2_CAP_TPM_PROPERTIES, TPM2_PT_FIXED,
+                                        TPM2_MAX_TPM_PROPERTIES, &more, &data),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->commands, 5);
+    assert_int_equal(more, TPM2_YES);
+    assert_int_equal(data->data.tpmProperties.count, 12);
+    free(data);
+
+    /* Outputs may be omitted */
+    assert_int_equal(Esys_GetCapability(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE,
+                                        TPM2_CAP_TPM_PROPERTIES, TPM2_PT_FIXED, 1, NULL, NULL),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->commands, 5);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_properties, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_algorithms, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_async, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
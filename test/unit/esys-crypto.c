@@ -10,6 +10,7 @@
 
 #include <inttypes.h> // for uint8_t
 #include <stdlib.h>   // for NULL, size_t, malloc
+#include <string.h>   // for memcmp
 
 #include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test
 #include "esys_crypto.h"          // for iesys_initialize_crypto_backend, iesys...
@@ -140,6 +141,98 @@ check_hmac_functions(void **state) {
     iesys_crypto_hash_abort(&crypto_cb, &context);
 }
 
+static void
+check_hmac_key_cache(void **state) {
+    TSS2_RC              rc;
+    IESYS_HMAC_KEY_CACHE keyCache = { 0 };
+    uint8_t              key[32] = { 1, 2, 3, 4 };
+    uint8_t              pHash[32] = { 5, 6, 7, 8 };
+    TPM2B_NONCE          nonceNewer = { .size = 16, .buffer = { 9 } };
+    TPM2B_NONCE          nonceOlder = { .size = 16, .buffer = { 10 } };
+    TPM2B_AUTH           hmac, hmac_cached;
+    BYTE                 kdfa[64], kdfa_cached[64]; /* rounded up to the digest size */
+
+    ESYS_CRYPTO_CALLBACKS crypto_cb = { 0 };
+    rc = iesys_initialize_crypto_backend(&crypto_cb, NULL);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+
+    for (int i = 0; i < 3; i++) {
+        if (i == 2) {
+            /* A changed key has to rekey the cache */
+            key[0] ^= 0xff;
+            iesys_crypto_hmac_cache_invalidate(&keyCache);
+        }
+        hmac.size = sizeof(TPMU_HA);
+        rc = iesys_crypto_authHmac(&crypto_cb, NULL, TPM2_ALG_SHA256, &key[0], sizeof(key),
+                                   &pHash[0], sizeof(pHash), &nonceNewer, &nonceOlder, NULL, NULL,
+                                   TPMA_SESSION_CONTINUESESSION, &hmac);
+        assert_int_equal(rc, TSS2_RC_SUCCESS);
+        hmac_cached.size = sizeof(TPMU_HA);
+        rc = iesys_crypto_authHmac(&crypto_cb, &keyCache, TPM2_ALG_SHA256, &key[0], sizeof(key),
+                                   &pHash[0], sizeof(pHash), &nonceNewer, &nonceOlder, NULL, NULL,
+                                   TPMA_SESSION_CONTINUESESSION, &hmac_cached);
+        assert_int_equal(rc, TSS2_RC_SUCCESS);
+        assert_int_equal(hmac.size, 32);
+        assert_int_equal(hmac_cached.size, hmac.size);
+        assert_memory_equal(&hmac_cached.buffer[0], &hmac.buffer[0], hmac.size);
+#ifdef iesys_crypto_hmac_dup_internal
+        assert_non_null(keyCache.context);
+#endif
+
+        /* KDFa needs two HMACs for 48 bytes */
+        rc = iesys_crypto_KDFa(&crypto_cb, NULL, TPM2_ALG_SHA256, &key[0], sizeof(key), "CFB",
+                               &nonceNewer, &nonceOlder, 48 * 8, NULL, &kdfa[0], 0);
+        assert_int_equal(rc, TSS2_RC_SUCCESS);
+        rc = iesys_crypto_KDFa(&crypto_cb, &keyCache, TPM2_ALG_SHA256, &key[0], sizeof(key), "CFB",
+                               &nonceNewer, &nonceOlder, 48 * 8, NULL, &kdfa_cached[0], 0);
+        assert_int_equal(rc, TSS2_RC_SUCCESS);
+        assert_memory_equal(&kdfa_cached[0], &kdfa[0], 48);
+    }
+
+    iesys_crypto_hmac_cache_clear(&crypto_cb, &keyCache);
+    assert_null(keyCache.context);
+}
+
+static void
+check_xor_obfuscation(void **state) {
+    TSS2_RC              rc;
+    IESYS_HMAC_KEY_CACHE keyCache = { 0 };
+    uint8_t              key[32] = { 1, 2, 3, 4 };
+    TPM2B_NONCE          nonceNewer = { .size = 16, .buffer = { 9 } };
+    TPM2B_NONCE          nonceOlder = { .size = 16, .buffer = { 10 } };
+    BYTE                 data[101], kdfa[128]; /* rounded up to the digest size */
+
+    ESYS_CRYPTO_CALLBACKS crypto_cb = { 0 };
+    rc = iesys_initialize_crypto_backend(&crypto_cb, NULL);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+
+    rc = iesys_xor_parameter_obfuscation(&crypto_cb, NULL, TPM2_ALG_SHA256, NULL, sizeof(key),
+                                         &nonceNewer, &nonceOlder, &data[0], sizeof(data));
+    assert_int_equal(rc, TSS2_ESYS_RC_BAD_REFERENCE);
+
+    /* The key stream is the KDFa output for the whole data */
+    rc = iesys_crypto_KDFa(&crypto_cb, NULL, TPM2_ALG_SHA256, &key[0], sizeof(key), "XOR",
+                           &nonceNewer, &nonceOlder, sizeof(data) * 8, NULL, &kdfa[0], 0);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (BYTE)i;
+    rc = iesys_xor_parameter_obfuscation(&crypto_cb, &keyCache, TPM2_ALG_SHA256, &key[0],
+                                         sizeof(key), &nonceNewer, &nonceOlder, &data[0],
+                                         sizeof(data));
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    for (size_t i = 0; i < sizeof(data); i++)
+        assert_int_equal(data[i], (BYTE)i ^ kdfa[i]);
+
+    /* Applying it twice restores the data */
+    rc = iesys_xor_parameter_obfuscation(&crypto_cb, NULL, TPM2_ALG_SHA256, &key[0], sizeof(key),
+                                         &nonceNewer, &nonceOlder, &data[0], sizeof(data));
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    for (size_t i = 0; i < sizeof(data); i++)
+        assert_int_equal(data[i], (BYTE)i);
+
+    iesys_crypto_hmac_cache_clear(&crypto_cb, &keyCache);
+}
+
 static void
 check_random(void **state) {
     TSS2_RC     rc;
@@ -154,6 +247,52 @@ check_random(void **state) {
     assert_int_equal(rc, TSS2_RC_SUCCESS);
 }
 
+static void
+check_random_pool(void **state) {
+    TSS2_RC           rc;
+    IESYS_RANDOM_POOL pool = { 0 };
+    TPM2B_NONCE       nonce1, nonce2;
+    BYTE              zero[sizeof(nonce1.buffer)] = { 0 };
+
+    ESYS_CRYPTO_CALLBACKS crypto_cb = { 0 };
+    rc = iesys_initialize_crypto_backend(&crypto_cb, NULL);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+
+    rc = iesys_crypto_get_random2b_pooled(&crypto_cb, &pool, &nonce1, sizeof(nonce1.buffer) + 1);
+    assert_int_equal(rc, TSS2_ESYS_RC_BAD_VALUE);
+
+    rc = iesys_crypto_get_random2b_pooled(&crypto_cb, &pool, &nonce1, 32);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(nonce1.size, 32);
+    rc = iesys_crypto_get_random2b_pooled(&crypto_cb, &pool, &nonce2, 0);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(nonce2.size, sizeof(nonce2.buffer));
+    assert_true(memcmp(&nonce1.buffer[0], &nonce2.buffer[0], 32) != 0);
+
+#ifdef iesys_crypto_get_random_internal
+    /* The bytes handed out are wiped from the pool */
+    assert_int_equal(pool.available, IESYS_RANDOM_POOL_SIZE - 32 - sizeof(nonce2.buffer));
+    assert_memory_equal(&pool.buffer[pool.available], &zero[0], sizeof(nonce2.buffer));
+
+    /* A different process draws a new block */
+    pool.pid = -1;
+    rc = iesys_crypto_get_random2b_pooled(&crypto_cb, &pool, &nonce1, 32);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(pool.available, IESYS_RANDOM_POOL_SIZE - 32);
+
+    /* The pool is refilled once exhausted */
+    for (int i = 0; i < IESYS_RANDOM_POOL_SIZE / 32; i++) {
+        rc = iesys_crypto_get_random2b_pooled(&crypto_cb, &pool, &nonce1, 32);
+        assert_int_equal(rc, TSS2_RC_SUCCESS);
+    }
+    assert_int_equal(pool.available, IESYS_RANDOM_POOL_SIZE - 32);
+#endif
+
+    iesys_crypto_random_pool_clear(&pool);
+    assert_int_equal(pool.available, 0);
+    assert_memory_equal(&pool.buffer[0], &zero[0], sizeof(zero));
+}
+
 static void
 check_pk_encrypt(void **state) {
     TSS2_RC rc;
@@ -212,6 +351,92 @@ check_pk_encrypt(void **state) {
     assert_int_equal(rc, TSS2_ESYS_RC_BAD_VALUE);
 }
 
+static void
+check_pkey_cache(void **state) {
+    TSS2_RC             rc;
+    IESYS_PKEY_CACHE    cache = { 0 };
+    TPM2B_NAME          names[IESYS_PKEY_CACHE_SIZE + 1];
+    TPM2B_NAME          no_name = { 0 };
+    TPM2B_ECC_PARAMETER Z;
+    TPMS_ECC_POINT      Q;
+    BYTE                out_buffer[sizeof(TPMS_ECC_POINT)];
+    size_t              out_size;
+    /* The base point of NIST P-256 as TPM public key */
+    TPM2B_PUBLIC key = {
+        .publicArea = {
+            .type = TPM2_ALG_ECC,
+            .nameAlg = TPM2_ALG_SHA256,
+            .parameters.eccDetail.curveID = TPM2_ECC_NIST_P256,
+            .unique.ecc = {
+                .x = { .size = 32,
+                       .buffer = { 0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47,
+                                   0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+                                   0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0,
+                                   0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96 } },
+                .y = { .size = 32,
+                       .buffer = { 0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b,
+                                   0x8e, 0xe7, 0xeb, 0x4a, 0x7c, 0x0f, 0x9e, 0x16,
+                                   0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce,
+                                   0xcb, 0xb6, 0x40, 0x68, 0x37, 0xbf, 0x51, 0xf5 } },
+            },
+        },
+    };
+
+    ESYS_CRYPTO_CALLBACKS crypto_cb = { 0 };
+    rc = iesys_initialize_crypto_backend(&crypto_cb, NULL);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+
+    for (int i = 0; i < IESYS_PKEY_CACHE_SIZE + 1; i++) {
+        names[i].size = 4;
+        memset(&names[i].name[0], 'a' + i, names[i].size);
+    }
+
+    /* Keys without a name are not cached */
+    rc = iesys_crypto_get_ecdh_point_cached(&crypto_cb, &cache, &no_name, &key, sizeof(out_buffer),
+                                            &Z, &Q, &out_buffer[0], &out_size);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_int_equal(Z.size, 32);
+    assert_null(cache.entry[0].pkey);
+
+    for (int i = 0; i < IESYS_PKEY_CACHE_SIZE; i++) {
+        rc = iesys_crypto_get_ecdh_point_cached(&crypto_cb, &cache, &names[i], &key,
+                                                sizeof(out_buffer), &Z, &Q, &out_buffer[0],
+                                                &out_size);
+        assert_int_equal(rc, TSS2_RC_SUCCESS);
+    }
+
+#ifdef iesys_crypto_pkey_load_internal
+    IESYS_CRYPTO_PKEY_BLOB *first = cache.entry[0].pkey;
+    assert_non_null(first);
+    assert_memory_equal(&cache.entry[0].name, &names[0], sizeof(names[0]));
+
+    /* A cached key is reused */
+    rc = iesys_crypto_get_ecdh_point_cached(&crypto_cb, &cache, &names[0], &key, sizeof(out_buffer),
+                                            &Z, &Q, &out_buffer[0], &out_size);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_ptr_equal(cache.entry[0].pkey, first);
+
+    /* The least recently used key is replaced */
+    rc = iesys_crypto_get_ecdh_point_cached(&crypto_cb, &cache, &names[IESYS_PKEY_CACHE_SIZE],
+                                            &key, sizeof(out_buffer), &Z, &Q, &out_buffer[0],
+                                            &out_size);
+    assert_int_equal(rc, TSS2_RC_SUCCESS);
+    assert_ptr_equal(cache.entry[0].pkey, first);
+    assert_memory_equal(&cache.entry[1].name, &names[IESYS_PKEY_CACHE_SIZE], sizeof(names[0]));
+
+    /* Keys which cannot be converted are not cached */
+    key.publicArea.parameters.eccDetail.curveID = TPM2_ECC_BN_P638;
+    rc = iesys_crypto_get_ecdh_point_cached(&crypto_cb, &cache, &names[1], &key, sizeof(out_buffer),
+                                            &Z, &Q, &out_buffer[0], &out_size);
+    assert_int_equal(rc, TSS2_ESYS_RC_NOT_IMPLEMENTED);
+    assert_memory_equal(&cache.entry[1].name, &names[IESYS_PKEY_CACHE_SIZE], sizeof(names[0]));
+#endif
+
+    iesys_crypto_pkey_cache_clear(&cache);
+    for (int i = 0; i < IESYS_PKEY_CACHE_SIZE; i++)
+        assert_null(cache.entry[i].pkey);
+}
+
 static void
 check_aes_encrypt(void **state) {
     TSS2_RC rc;
@@ -424,7 +649,9 @@ int
 main(int argc, char *argv[]) {
     const struct CMUnitTest tests[]
         = { cmocka_unit_test(check_hash_functions), cmocka_unit_test(check_hmac_functions),
-            cmocka_unit_test(check_random),         cmocka_unit_test(check_pk_encrypt),
+            cmocka_unit_test(check_hmac_key_cache), cmocka_unit_test(check_xor_obfuscation),
+            cmocka_unit_test(check_random),         cmocka_unit_test(check_random_pool),
+            cmocka_unit_test(check_pk_encrypt),     cmocka_unit_test(check_pkey_cache),
             cmocka_unit_test(check_aes_encrypt),
 #if HAVE_EVP_SM4_CFB && !defined(OPENSSL_NO_SM4)
             cmocka_unit_test(check_sm4_encrypt),
@@ -0,0 +1,319 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <fcntl.h>    // for fcntl, F_GETFL, F_SETFL, O_NONBLOCK
+#include <inttypes.h> // for uint8_t, int32_t, uint32_t, uint64_t
+#include <poll.h>     // for POLLIN
+#include <stdbool.h>  // for bool, false, true
+#include <stdlib.h>   // for NULL, size_t, free, calloc
+#include <string.h>   // for memcpy
+#include <unistd.h>   // for close, pipe, read, write
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_...
+#include "tss2_esys.h"            // for ESYS_EXECUTOR, Esys_Executor_New, E...
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_POLL_H...
+#include "tss2_tpm2_types.h"      // for TPM2B_DIGEST
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks that the executor drives the asynchronous commands of
+ * many ESYS contexts from one thread, using TCTIs whose poll handle becomes
+ * readable once a response is ready.
+ */
+
+#define TCTI_PIPE_MAGIC   0x5049504500000000ULL /* 'PIPE\0\0\0\0' */
+#define TCTI_PIPE_VERSION 0x2
+#define NUM_CONTEXTS      12
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    int      pipe[2];  /* readable while a response is ready */
+    bool     respond;  /* make the response ready on transmit */
+    bool     ready;    /* the response size was queried */
+    uint32_t commands; /* number of transmitted commands */
+} TSS2_TCTI_CONTEXT_PIPE;
+
+static void
+tcti_pipe_ready(TSS2_TCTI_CONTEXT_PIPE *tcti) {
+    assert_int_equal(write(tcti->pipe[1], "", 1), 1);
+}
+
+static TSS2_RC
+tcti_pipe_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    TSS2_TCTI_CONTEXT_PIPE *tcti = (TSS2_TCTI_CONTEXT_PIPE *)tctiContext;
+
+    (void)size;
+    (void)buffer;
+    tcti->commands++;
+    if (tcti->respond)
+        tcti_pipe_ready(tcti);
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_pipe_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                  size_t            *response_size,
+                  uint8_t           *response_buffer,
+                  int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_PIPE *tcti = (TSS2_TCTI_CONTEXT_PIPE *)tctiContext;
+    uint8_t                 byte;
+    static const uint8_t    response[] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x10, /* Response Size */
+        0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+        0x00, 0x04,             /* randomBytes.size */
+        0xde, 0xad, 0xbe, 0xef, /* randomBytes.buffer */
+    };
+
+    /* The executor only finishes commands whose poll handle is readable */
+    assert_int_equal(timeout, 0);
+    if (!tcti->ready && read(tcti->pipe[0], &byte, 1) != 1)
+        return TSS2_TCTI_RC_TRY_AGAIN;
+
+    /* The first call only queries the size */
+    tcti->ready = response_buffer == NULL;
+    *response_size = sizeof(response);
+    if (response_buffer != NULL)
+        memcpy(response_buffer, &response[0], sizeof(response));
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_pipe_get_poll_handles(TSS2_TCTI_CONTEXT     *tctiContext,
+                           TSS2_TCTI_POLL_HANDLE *handles,
+                           size_t                *num_handles) {
+    TSS2_TCTI_CONTEXT_PIPE *tcti = (TSS2_TCTI_CONTEXT_PIPE *)tctiContext;
+
+    if (handles != NULL) {
+        handles[0].fd = tcti->pipe[0];
+        handles[0].events = POLLIN;
+    }
+    *num_handles = 1;
+    return TSS2_RC_SUCCESS;
+}
+
+static int
+setup(void **state) {
+    ESYS_CONTEXT **ectx = calloc(NUM_CONTEXTS, sizeof(*ectx));
+
+    if (ectx == NULL)
+        return -1;
+    for (size_t i = 0; i < NUM_CONTEXTS; i++) {
+        TSS2_TCTI_CONTEXT_PIPE *tcti = calloc(1, sizeof(*tcti));
+
+        if (tcti == NULL || pipe(tcti->pipe) != 0)
+            return -1;
+        fcntl(tcti->pipe[0], F_SETFL, fcntl(tcti->pipe[0], F_GETFL) | O_NONBLOCK);
+        tcti->magic = TCTI_PIPE_MAGIC;
+        tcti->version = TCTI_PIPE_VERSION;
+        tcti->transmit = tcti_pipe_transmit;
+        tcti->receive = tcti_pipe_receive;
+        tcti->getPollHandles = tcti_pipe_get_poll_handles;
+        tcti->respond = true;
+
+        if (Esys_Initialize(&ectx[i], (TSS2_TCTI_CONTEXT *)tcti, NULL) != TSS2_RC_SUCCESS)
+            return -1;
+    }
+    *state = (void *)ectx;
+    return 0;
+}
+
+static int
+teardown(void **state) {
+    ESYS_CONTEXT **ectx = (ESYS_CONTEXT **)*state;
+
+    for (size_t i = 0; i < NUM_CONTEXTS; i++) {
+        TSS2_TCTI_CONTEXT_PIPE *tcti;
+
+        Esys_GetTcti(ectx[i], (TSS2_TCTI_CONTEXT **)&tcti);
+        Esys_Finalize(&ectx[i]);
+        close(tcti->pipe[0]);
+        close(tcti->pipe[1]);
+        free(tcti);
+    }
+    free(ectx);
+    return 0;
+}
+
+static TSS2_TCTI_CONTEXT_PIPE *
+get_tcti(ESYS_CONTEXT *ectx) {
+    TSS2_TCTI_CONTEXT *tcti;
+
+    assert_int_equal(Esys_GetTcti(ectx, &tcti), TSS2_RC_SUCCESS);
+    return (TSS2_TCTI_CONTEXT_PIPE *)tcti;
+}
+
+typedef struct {
+    ESYS_EXECUTOR *executor;
+    TSS2_RC        rc;
+    uint32_t       delivered; /* number of deliveries */
+    uint32_t       order;     /* delivery position within the context */
+    uint32_t      *counter;   /* deliveries of the context so far */
+    bool           resubmit;  /* submit again from the done callback */
+} SUBMISSION;
+
+static TSS2_RC
+get_random_async(ESYS_CONTEXT *esys_context, void *userdata) {
+    (void)userdata;
+    return Esys_GetRandom_Async(esys_context, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, 4);
+}
+
+static TSS2_RC
+get_random_finish(ESYS_CONTEXT *esys_context, void *userdata) {
+    TSS2_RC       r;
+    TPM2B_DIGEST *random_bytes = NULL;
+
+    (void)userdata;
+    r = Esys_GetRandom_Finish(esys_context, &random_bytes);
+    Esys_Free(random_bytes);
+    return r;
+}
+
+static TSS2_RC
+failing_async(ESYS_CONTEXT *esys_context, void *userdata) {
+    (void)esys_context;
+    (void)userdata;
+    return TSS2_ESYS_RC_BAD_VALUE;
+}
+
+static void
+done(ESYS_CONTEXT *esys_context, TSS2_RC rc, void *userdata) {
+    SUBMISSION *submission = userdata;
+
+    submission->rc = rc;
+    submission->delivered++;
+    submission->order = (*submission->counter)++;
+    if (submission->resubmit) {
+        submission->resubmit = false;
+        Esys_Executor_Submit(submission->executor, esys_context, get_random_async,
+                             get_random_finish, done, submission);
+    }
+}
+
+static void
+test_many_contexts(void **state) {
+    ESYS_CONTEXT **ectx = (ESYS_CONTEXT **)*state;
+    ESYS_EXECUTOR *executor;
+    SUBMISSION     submissions[NUM_CONTEXTS][3] = { 0 };
+    uint32_t       counters[NUM_CONTEXTS] = { 0 };
+
+    assert_int_equal(Esys_Executor_New(&executor, 0), TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_Executor_Submit(executor, ectx[0], NULL, get_random_finish, done, NULL),
+                     TSS2_ESYS_RC_BAD_REFERENCE);
+    for (size_t i = 0; i < NUM_CONTEXTS; i++) {
+        for (size_t j = 0; j < 3; j++) {
+            submissions[i][j].executor = executor;
+            submissions[i][j].counter = &counters[i];
+        }
+        submissions[i][0].resubmit = true;
+        assert_int_equal(Esys_Executor_Submit(executor, ectx[i], get_random_async,
+                                              get_random_finish, done, &submissions[i][0]),
+                         TSS2_RC_SUCCESS);
+        assert_int_equal(Esys_Executor_Submit(executor, ectx[i], failing_async,
+                                              get_random_finish, done, &submissions[i][1]),
+                         TSS2_RC_SUCCESS);
+        assert_int_equal(Esys_Executor_Submit(executor, ectx[i], get_random_async,
+                                              get_random_finish, done, &submissions[i][2]),
+                         TSS2_RC_SUCCESS);
+    }
+
+    assert_int_equal(Esys_Executor_Run(executor, -1), TSS2_RC_SUCCESS);
+    for (size_t i = 0; i < NUM_CONTEXTS; i++) {
+        /* The resubmission is queued behind the other submissions */
+        assert_int_equal(submissions[i][0].delivered, 2);
+        assert_int_equal(submissions[i][0].order, 3);
+        assert_int_equal(submissions[i][0].rc, TSS2_RC_SUCCESS);
+        assert_int_equal(submissions[i][1].delivered, 1);
+        assert_int_equal(submissions[i][1].order, 1);
+        assert_int_equal(submissions[i][1].rc, TSS2_ESYS_RC_BAD_VALUE);
+        assert_int_equal(submissions[i][2].delivered, 1);
+        assert_int_equal(submissions[i][2].order, 2);
+        assert_int_equal(submissions[i][2].rc, TSS2_RC_SUCCESS);
+        assert_int_equal(get_tcti(ectx[i])->commands, 3);
+    }
+    Esys_Executor_Free(&executor);
+    assert_null(executor);
+}
+
+static void
+test_timeout(void **state) {
+    ESYS_CONTEXT          **ectx = (ESYS_CONTEXT **)*state;
+    TSS2_TCTI_CONTEXT_PIPE *tcti = get_tcti(ectx[0]);
+    ESYS_EXECUTOR          *executor;
+    SUBMISSION              submission = { 0 };
+    uint32_t                counter = 0;
+
+    submission.counter = &counter;
+    tcti->respond = false;
+    assert_int_equal(Esys_Executor_New(&executor, 0), TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_Executor_Run(executor, 0), TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_Executor_Submit(executor, ectx[0], get_random_async,
+                                          get_random_finish, done, &submission),
+                     TSS2_RC_SUCCESS);
+
+    assert_int_equal(Esys_Executor_Run(executor, 10), TSS2_ESYS_RC_TRY_AGAIN);
+    assert_int_equal(tcti->commands, 1);
+    assert_int_equal(submission.delivered, 0);
+
+    tcti_pipe_ready(tcti);
+    assert_int_equal(Esys_Executor_Run(executor, -1), TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->commands, 1);
+    assert_int_equal(submission.delivered, 1);
+    assert_int_equal(submission.rc, TSS2_RC_SUCCESS);
+    Esys_Executor_Free(&executor);
+}
+
+static void
+test_thread_pool(void **state) {
+    ESYS_CONTEXT **ectx = (ESYS_CONTEXT **)*state;
+    ESYS_EXECUTOR *executor;
+    SUBMISSION     submissions[NUM_CONTEXTS][2] = { 0 };
+    uint32_t       counters[NUM_CONTEXTS] = { 0 };
+
+    assert_int_equal(Esys_Executor_New(&executor, 4), TSS2_RC_SUCCESS);
+    for (size_t i = 0; i < NUM_CONTEXTS; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            submissions[i][j].executor = executor;
+            submissions[i][j].counter = &counters[i];
+            assert_int_equal(Esys_Executor_Submit(executor, ectx[i], get_random_async,
+                                                  get_random_finish, done, &submissions[i][j]),
+                             TSS2_RC_SUCCESS);
+        }
+    }
+    submissions[0][1].resubmit = true;
+
+    assert_int_equal(Esys_Executor_Run(executor, -1), TSS2_RC_SUCCESS);
+    for (size_t i = 0; i < NUM_CONTEXTS; i++) {
+        assert_int_equal(submissions[i][0].delivered, 1);
+        assert_int_equal(submissions[i][0].order, 0);
+        assert_int_equal(submissions[i][1].delivered, i == 0 ? 2 : 1);
+        assert_int_equal(submissions[i][1].order, i == 0 ? 2 : 1);
+        assert_int_equal(submissions[i][1].rc, TSS2_RC_SUCCESS);
+    }
+    Esys_Executor_Free(&executor);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_many_contexts, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_timeout, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_thread_pool, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
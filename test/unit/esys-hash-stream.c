@@ -0,0 +1,316 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t, uint32_t, uint64_t
+#include <stdbool.h>  // for bool, false, true
+#include <stdlib.h>   // for NULL, size_t, free, calloc
+#include <string.h>   // for memcpy
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_...
+#include "tss2_esys.h"            // for Esys_HashStream, Esys_HashBuffer
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT
+#include "tss2_tpm2_types.h"      // for TPM2_CC_SequenceUpdate, TPM2B_DIGEST
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks that Esys_HashStream feeds its input to a hash
+ * sequence in full chunks, reads ahead while an update is in flight and
+ * sends the last chunk with TPM2_SequenceComplete.
+ */
+
+#define TCTI_SEQ_MAGIC   0x5345510000000000ULL /* 'SEQ\0\0\0\0\0' */
+#define TCTI_SEQ_VERSION 0x1
+#define DATA_SIZE        3000
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    uint32_t command_code;    /* of the last command */
+    bool     in_flight;       /* a command was sent, its response not received */
+    uint32_t updates;         /* number of TPM2_SequenceUpdate commands */
+    uint32_t completes;       /* number of TPM2_SequenceComplete commands */
+    uint32_t flushes;         /* number of TPM2_FlushContext commands */
+    uint8_t  data[DATA_SIZE]; /* data received by the sequence */
+    size_t   size;
+    size_t   chunks[4];       /* sizes of the first chunks */
+} TSS2_TCTI_CONTEXT_SEQ;
+
+static TSS2_RC
+tcti_seq_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    TSS2_TCTI_CONTEXT_SEQ *tcti = (TSS2_TCTI_CONTEXT_SEQ *)tctiContext;
+    size_t                 offset, chunk;
+
+    assert_true(size >= 10);
+    tcti->command_code = (uint32_t)buffer[6] << 24 | (uint32_t)buffer[7] << 16
+                         | (uint32_t)buffer[8] << 8 | buffer[9];
+    tcti->in_flight = true;
+
+    switch (tcti->command_code) {
+    case TPM2_CC_SequenceUpdate:
+    case TPM2_CC_SequenceComplete:
+        /* header, sequenceHandle, authorizationSize, sessions, buffer */
+        offset = 18 + ((size_t)buffer[16] << 8 | buffer[17]);
+        chunk = (size_t)buffer[offset] << 8 | buffer[offset + 1];
+        assert_true(chunk <= TPM2_MAX_DIGEST_BUFFER);
+        assert_true(tcti->size + chunk <= sizeof(tcti->data));
+        memcpy(&tcti->data[tcti->size], &buffer[offset + 2], chunk);
+        tcti->size += chunk;
+        if (tcti->updates + tcti->completes < 4)
+            tcti->chunks[tcti->updates + tcti->completes] = chunk;
+        if (tcti->command_code == TPM2_CC_SequenceUpdate)
+            tcti->updates++;
+        else
+            tcti->completes++;
+        break;
+    case TPM2_CC_FlushContext:
+        tcti->flushes++;
+        break;
+    default:
+        break;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+static const uint8_t complete_parameters[] = {
+    0x00, 0x00, 0x00, 0x2a,                         /* parameterSize */
+    0x00, 0x20,                                     /* result.size */
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, /* result.buffer */
+    0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20,
+    0x80, 0x24,                                     /* TPM2_ST_HASHCHECK */
+    0x40, 0x00, 0x00, 0x01,                         /* TPM2_RH_OWNER */
+    0x00, 0x00,                                     /* digest */
+};
+
+static const uint8_t password_response[] = {
+    0x00, 0x00, /* nonce */
+    0x01,       /* sessionAttributes */
+    0x00, 0x00, /* hmac */
+};
+
+static TSS2_RC
+tcti_seq_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                 size_t            *response_size,
+                 uint8_t           *response_buffer,
+                 int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_SEQ *tcti = (TSS2_TCTI_CONTEXT_SEQ *)tctiContext;
+    uint8_t                response[128] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x0A, /* Response Size */
+        0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+    };
+    size_t size = 10;
+
+    (void)timeout;
+    switch (tcti->command_code) {
+    case TPM2_CC_HashSequenceStart:
+        response[10] = 0x80;
+        response[13] = 0x01;
+        size += 4;
+        break;
+    case TPM2_CC_SequenceUpdate:
+        response[1] = 0x02;
+        size += 4; /* parameterSize */
+        memcpy(&response[size], &password_response[0], sizeof(password_response));
+        size += sizeof(password_response);
+        break;
+    case TPM2_CC_SequenceComplete:
+        response[1] = 0x02;
+        memcpy(&response[size], &complete_parameters[0], sizeof(complete_parameters));
+        size += sizeof(complete_parameters);
+        memcpy(&response[size], &password_response[0], sizeof(password_response));
+        size += sizeof(password_response);
+        break;
+    default:
+        break;
+    }
+    response[5] = (uint8_t)size;
+
+    *response_size = size;
+    if (response_buffer != NULL) {
+        memcpy(response_buffer, &response[0], size);
+        tcti->in_flight = false;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+static int
+setup(void **state) {
+    TSS2_RC                r;
+    ESYS_CONTEXT          *ectx;
+    TSS2_TCTI_CONTEXT_SEQ *tcti = calloc(1, sizeof(*tcti));
+
+    if (tcti == NULL)
+        return -1;
+    tcti->magic = TCTI_SEQ_MAGIC;
+    tcti->version = TCTI_SEQ_VERSION;
+    tcti->transmit = tcti_seq_transmit;
+    tcti->receive = tcti_seq_receive;
+
+    r = Esys_Initialize(&ectx, (TSS2_TCTI_CONTEXT *)tcti, NULL);
+    *state = (void *)ectx;
+    return (int)r;
+}
+
+static int
+teardown(void **state) {
+    TSS2_TCTI_CONTEXT *tcti;
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+
+    Esys_GetTcti(ectx, &tcti);
+    Esys_Finalize(&ectx);
+    free(tcti);
+    return 0;
+}
+
+static TSS2_TCTI_CONTEXT_SEQ *
+get_tcti(ESYS_CONTEXT *ectx) {
+    TSS2_TCTI_CONTEXT *tcti;
+
+    assert_int_equal(Esys_GetTcti(ectx, &tcti), TSS2_RC_SUCCESS);
+    return (TSS2_TCTI_CONTEXT_SEQ *)tcti;
+}
+
+typedef struct {
+    TSS2_TCTI_CONTEXT_SEQ *tcti;
+    uint8_t                data[DATA_SIZE];
+    size_t                 offset;
+    uint32_t               overlapped; /* reads while an update was in flight */
+    uint32_t               calls;
+    uint32_t               fail;       /* fail the call with this number */
+} READER;
+
+/* Returns at most 700 bytes per call to exercise short reads */
+static TSS2_RC
+read_data(uint8_t *buffer, size_t *size, void *userdata) {
+    READER *reader = userdata;
+    size_t  n = DATA_SIZE - reader->offset;
+
+    if (++reader->calls == reader->fail)
+        return TSS2_ESYS_RC_GENERAL_FAILURE;
+    if (reader->tcti->in_flight)
+        reader->overlapped++;
+    if (n > 700)
+        n = 700;
+    if (n > *size)
+        n = *size;
+    memcpy(buffer, &reader->data[reader->offset], n);
+    reader->offset += n;
+    *size = n;
+    return TSS2_RC_SUCCESS;
+}
+
+static void
+test_stream(void **state) {
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+    READER             reader = { .tcti = get_tcti(ectx) };
+    TPM2B_DIGEST      *result = NULL;
+    TPMT_TK_HASHCHECK *validation = NULL;
+
+    for (size_t i = 0; i < DATA_SIZE; i++)
+        reader.data[i] = (uint8_t)(i * 7);
+
+    assert_int_equal(Esys_HashStream(ectx, ESYS_TR_NONE, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                     ESYS_TR_NONE, TPM2_ALG_SHA256, ESYS_TR_RH_OWNER, read_data,
+                                     &reader, &result, &validation),
+                     TSS2_RC_SUCCESS);
+
+    assert_int_equal(reader.tcti->updates, 2);
+    assert_int_equal(reader.tcti->completes, 1);
+    assert_int_equal(reader.tcti->chunks[0], TPM2_MAX_DIGEST_BUFFER);
+    assert_int_equal(reader.tcti->chunks[1], TPM2_MAX_DIGEST_BUFFER);
+    assert_int_equal(reader.tcti->chunks[2], DATA_SIZE - 2 * TPM2_MAX_DIGEST_BUFFER);
+    assert_int_equal(reader.tcti->size, DATA_SIZE);
+    assert_memory_equal(&reader.tcti->data[0], &reader.data[0], DATA_SIZE);
+    /* The third chunk and the end of the data were read during the updates */
+    assert_true(reader.overlapped >= 2);
+
+    assert_int_equal(result->size, 32);
+    assert_int_equal(result->buffer[31], 0x20);
+    assert_int_equal(validation->tag, TPM2_ST_HASHCHECK);
+    assert_int_equal(validation->hierarchy, TPM2_RH_OWNER);
+    Esys_Free(result);
+    Esys_Free(validation);
+}
+
+static void
+test_buffer(void **state) {
+    ESYS_CONTEXT          *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_SEQ *tcti = get_tcti(ectx);
+    TPM2B_DIGEST          *result = NULL;
+    const uint8_t          data[] = { 'a', 'b', 'c' };
+
+    assert_int_equal(Esys_HashBuffer(ectx, ESYS_TR_NONE, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                     ESYS_TR_NONE, TPM2_ALG_SHA256, ESYS_TR_RH_NULL, NULL, 1,
+                                     &result, NULL),
+                     TSS2_ESYS_RC_BAD_REFERENCE);
+
+    /* Data that fits into one chunk only needs TPM2_SequenceComplete */
+    assert_int_equal(Esys_HashBuffer(ectx, ESYS_TR_NONE, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                     ESYS_TR_NONE, TPM2_ALG_SHA256, ESYS_TR_RH_NULL, &data[0],
+                                     sizeof(data), &result, NULL),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->updates, 0);
+    assert_int_equal(tcti->completes, 1);
+    assert_int_equal(tcti->size, sizeof(data));
+    assert_memory_equal(&tcti->data[0], &data[0], sizeof(data));
+    Esys_Free(result);
+
+    assert_int_equal(Esys_HashBuffer(ectx, ESYS_TR_NONE, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                     ESYS_TR_NONE, TPM2_ALG_SHA256, ESYS_TR_RH_NULL, NULL, 0,
+                                     &result, NULL),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->updates, 0);
+    assert_int_equal(tcti->completes, 2);
+    assert_int_equal(tcti->chunks[1], 0);
+    Esys_Free(result);
+}
+
+static void
+test_read_error(void **state) {
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+    READER             reader = { .tcti = get_tcti(ectx), .fail = 5 };
+    TPM2B_DIGEST      *result = NULL;
+    TPMT_TK_HASHCHECK *validation = NULL;
+
+    assert_int_equal(Esys_HashStream(ectx, ESYS_TR_NONE, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                     ESYS_TR_NONE, TPM2_ALG_SHA256, ESYS_TR_RH_OWNER, NULL,
+                                     &reader, &result, &validation),
+                     TSS2_ESYS_RC_BAD_REFERENCE);
+
+    /* The fifth read happens while the first update is in flight */
+    assert_int_equal(Esys_HashStream(ectx, ESYS_TR_NONE, ESYS_TR_PASSWORD, ESYS_TR_NONE,
+                                     ESYS_TR_NONE, TPM2_ALG_SHA256, ESYS_TR_RH_OWNER, read_data,
+                                     &reader, &result, &validation),
+                     TSS2_ESYS_RC_GENERAL_FAILURE);
+    assert_int_equal(reader.tcti->updates, 1);
+    assert_int_equal(reader.tcti->completes, 0);
+    assert_int_equal(reader.tcti->flushes, 1);
+    assert_null(result);
+    assert_null(validation);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_stream, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_buffer, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_read_error, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
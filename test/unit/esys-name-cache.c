@@ -0,0 +1,273 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, uint32_t, int32_t, uint64_t
+#include <stdio.h>    // for fclose, fopen, fputs, remove, snprintf
+#include <stdlib.h>   // for NULL, size_t, free, calloc, mkdtemp
+#include <string.h>   // for memcmp, memcpy, memset
+#include <unistd.h>   // for rmdir
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_...
+#include "tss2_esys.h"            // for Esys_SetNameCache, Esys_TR_FromTPMPu...
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT
+#include "tss2_tpm2_types.h"      // for TPM2_CC_ReadPublic, TPM2B_NAME
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks that Esys_TR_FromTPMPublic stores the metadata of
+ * persistent objects in the name cache, uses cached entries with and without
+ * verification by the TPM and replaces entries that are outdated or invalid.
+ */
+
+#define TCTI_READPUBLIC_MAGIC   0x5245414450554200ULL /* 'READPUB\0' */
+#define TCTI_READPUBLIC_VERSION 0x1
+
+#define PERSISTENT_HANDLE 0x81000001
+#define TRANSIENT_HANDLE  0x80000001
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    uint32_t reads; /* number of TPM2_ReadPublic commands */
+    uint8_t  key;   /* fill byte of the unique field and the name */
+} TSS2_TCTI_CONTEXT_READPUBLIC;
+
+static TSS2_RC
+tcti_readpublic_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    TSS2_TCTI_CONTEXT_READPUBLIC *tcti = (TSS2_TCTI_CONTEXT_READPUBLIC *)tctiContext;
+
+    assert_true(size >= 10);
+    assert_int_equal((uint32_t)buffer[6] << 24 | (uint32_t)buffer[7] << 16
+                         | (uint32_t)buffer[8] << 8 | buffer[9],
+                     TPM2_CC_ReadPublic);
+    tcti->reads++;
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_readpublic_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                        size_t            *response_size,
+                        uint8_t           *response_buffer,
+                        int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_READPUBLIC *tcti = (TSS2_TCTI_CONTEXT_READPUBLIC *)tctiContext;
+    uint8_t                       response[96] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x60, /* Response Size 96 */
+        0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+        0x00, 0x2e,             /* outPublic.size */
+        0x00, 0x08,             /* type TPM2_ALG_KEYEDHASH */
+        0x00, 0x0b,             /* nameAlg TPM2_ALG_SHA256 */
+        0x00, 0x04, 0x00, 0x72, /* objectAttributes */
+        0x00, 0x00,             /* authPolicy.size */
+        0x00, 0x10,             /* scheme TPM2_ALG_NULL */
+        0x00, 0x20,             /* unique.size */
+    };
+
+    (void)timeout;
+    memset(&response[26], tcti->key, 32); /* unique.buffer */
+    response[58] = 0x00;                  /* name.size */
+    response[59] = 0x22;
+    response[60] = 0x00;                  /* name.name */
+    response[61] = 0x0b;
+    memset(&response[62], tcti->key, 32);
+    response[94] = 0x00;                  /* qualifiedName.size */
+    response[95] = 0x00;
+
+    *response_size = sizeof(response);
+    if (response_buffer != NULL)
+        memcpy(response_buffer, response, sizeof(response));
+    return TSS2_RC_SUCCESS;
+}
+
+typedef struct {
+    ESYS_CONTEXT *ectx;
+    char          dir[32];
+    char          entry[64];
+} NAME_CACHE_STATE;
+
+static int
+setup(void **state) {
+    TSS2_RC                       r;
+    NAME_CACHE_STATE             *s = calloc(1, sizeof(*s));
+    TSS2_TCTI_CONTEXT_READPUBLIC *tcti = calloc(1, sizeof(*tcti));
+
+    if (s == NULL || tcti == NULL)
+        return -1;
+    tcti->magic = TCTI_READPUBLIC_MAGIC;
+    tcti->version = TCTI_READPUBLIC_VERSION;
+    tcti->transmit = tcti_readpublic_transmit;
+    tcti->receive = tcti_readpublic_receive;
+    tcti->key = 1;
+
+    snprintf(s->dir, sizeof(s->dir), "/tmp/tss2-name-cache-XXXXXX");
+    if (mkdtemp(s->dir) == NULL)
+        return -1;
+    snprintf(s->entry, sizeof(s->entry), "%s/%08x.tr", s->dir, PERSISTENT_HANDLE);
+
+    r = Esys_Initialize(&s->ectx, (TSS2_TCTI_CONTEXT *)tcti, NULL);
+    *state = (void *)s;
+    return (int)r;
+}
+
+static int
+teardown(void **state) {
+    TSS2_TCTI_CONTEXT *tcti;
+    NAME_CACHE_STATE  *s = (NAME_CACHE_STATE *)*state;
+
+    Esys_GetTcti(s->ectx, &tcti);
+    Esys_Finalize(&s->ectx);
+    free(tcti);
+    remove(s->entry);
+    rmdir(s->dir);
+    free(s);
+    return 0;
+}
+
+static TSS2_TCTI_CONTEXT_READPUBLIC *
+get_tcti(ESYS_CONTEXT *ectx) {
+    TSS2_TCTI_CONTEXT *tcti;
+
+    assert_int_equal(Esys_GetTcti(ectx, &tcti), TSS2_RC_SUCCESS);
+    return (TSS2_TCTI_CONTEXT_READPUBLIC *)tcti;
+}
+
+/* Create an ESYS_TR for the handle, return its name and close it again. */
+static TPM2B_NAME
+from_tpm_public(ESYS_CONTEXT *ectx, TPM2_HANDLE tpm_handle) {
+    ESYS_TR     object = ESYS_TR_NONE;
+    TPM2B_NAME *name = NULL;
+    TPM2B_NAME  result;
+    TSS2_RC     r;
+
+    r = Esys_TR_FromTPMPublic(ectx, tpm_handle, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, &object);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    r = Esys_TR_GetName(ectx, object, &name);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(name->size, 34);
+    result = *name;
+    Esys_Free(name);
+    r = Esys_TR_Close(ectx, &object);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    return result;
+}
+
+static void
+assert_name_equal(const TPM2B_NAME *name1, const TPM2B_NAME *name2) {
+    assert_int_equal(name1->size, name2->size);
+    assert_memory_equal(&name1->name[0], &name2->name[0], name1->size);
+}
+
+static void
+test_bad_parameters(void **state) {
+    NAME_CACHE_STATE *s = (NAME_CACHE_STATE *)*state;
+
+    assert_int_equal(Esys_SetNameCache(NULL, s->dir, 0), TSS2_ESYS_RC_BAD_REFERENCE);
+    assert_int_equal(Esys_SetNameCache(s->ectx, s->dir, 0x2), TSS2_ESYS_RC_BAD_VALUE);
+}
+
+static void
+test_no_verify(void **state) {
+    NAME_CACHE_STATE             *s = (NAME_CACHE_STATE *)*state;
+    TSS2_TCTI_CONTEXT_READPUBLIC *tcti = get_tcti(s->ectx);
+    TPM2B_NAME                    name1, name2;
+
+    assert_int_equal(Esys_SetNameCache(s->ectx, s->dir, ESYS_NAME_CACHE_NO_VERIFY),
+                     TSS2_RC_SUCCESS);
+    name1 = from_tpm_public(s->ectx, PERSISTENT_HANDLE);
+    assert_int_equal(tcti->reads, 1);
+
+    /* The cached entry is used without a TPM command */
+    name2 = from_tpm_public(s->ectx, PERSISTENT_HANDLE);
+    assert_int_equal(tcti->reads, 1);
+    assert_name_equal(&name1, &name2);
+
+    /* Without the cache the TPM is queried again */
+    assert_int_equal(Esys_SetNameCache(s->ectx, NULL, 0), TSS2_RC_SUCCESS);
+    from_tpm_public(s->ectx, PERSISTENT_HANDLE);
+    assert_int_equal(tcti->reads, 2);
+}
+
+static void
+test_verify_refresh(void **state) {
+    NAME_CACHE_STATE             *s = (NAME_CACHE_STATE *)*state;
+    TSS2_TCTI_CONTEXT_READPUBLIC *tcti = get_tcti(s->ectx);
+    TPM2B_NAME                    name1, name2;
+
+    assert_int_equal(Esys_SetNameCache(s->ectx, s->dir, 0), TSS2_RC_SUCCESS);
+    name1 = from_tpm_public(s->ectx, PERSISTENT_HANDLE);
+    assert_int_equal(tcti->reads, 1);
+
+    /* The cached entry is verified by the TPM */
+    name2 = from_tpm_public(s->ectx, PERSISTENT_HANDLE);
+    assert_int_equal(tcti->reads, 2);
+    assert_name_equal(&name1, &name2);
+
+    /* The key behind the handle changed; the outdated entry is replaced */
+    tcti->key = 2;
+    name2 = from_tpm_public(s->ectx, PERSISTENT_HANDLE);
+    assert_int_equal(tcti->reads, 3);
+    assert_true(memcmp(&name1.name[0], &name2.name[0], name1.size) != 0);
+
+    assert_int_equal(Esys_SetNameCache(s->ectx, s->dir, ESYS_NAME_CACHE_NO_VERIFY),
+                     TSS2_RC_SUCCESS);
+    name1 = from_tpm_public(s->ectx, PERSISTENT_HANDLE);
+    assert_int_equal(tcti->reads, 3);
+    assert_name_equal(&name1, &name2);
+}
+
+static void
+test_invalid_entry(void **state) {
+    NAME_CACHE_STATE             *s = (NAME_CACHE_STATE *)*state;
+    TSS2_TCTI_CONTEXT_READPUBLIC *tcti = get_tcti(s->ectx);
+    FILE                         *file = fopen(s->entry, "wb");
+
+    assert_non_null(file);
+    fputs("garbage", file);
+    fclose(file);
+
+    /* The invalid entry is ignored and replaced */
+    assert_int_equal(Esys_SetNameCache(s->ectx, s->dir, ESYS_NAME_CACHE_NO_VERIFY),
+                     TSS2_RC_SUCCESS);
+    from_tpm_public(s->ectx, PERSISTENT_HANDLE);
+    assert_int_equal(tcti->reads, 1);
+    from_tpm_public(s->ectx, PERSISTENT_HANDLE);
+    assert_int_equal(tcti->reads, 1);
+}
+
+static void
+test_transient_not_cached(void **state) {
+    NAME_CACHE_STATE             *s = (NAME_CACHE_STATE *)*state;
+    TSS2_TCTI_CONTEXT_READPUBLIC *tcti = get_tcti(s->ectx);
+
+    assert_int_equal(Esys_SetNameCache(s->ectx, s->dir, ESYS_NAME_CACHE_NO_VERIFY),
+                     TSS2_RC_SUCCESS);
+    from_tpm_public(s->ectx, TRANSIENT_HANDLE);
+    from_tpm_public(s->ectx, TRANSIENT_HANDLE);
+    assert_int_equal(tcti->reads, 2);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_bad_parameters, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_no_verify, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_verify_refresh, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_invalid_entry, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_transient_not_cached, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,324 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t, uint32_t, uint64_t
+#include <stdlib.h>   // for NULL, size_t, free, calloc
+#include <string.h>   // for memcpy
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "esys_int.h"             // for RSRC_NODE_T, ESYS_CONTEXT
+#include "tss2-esys/esys_iutil.h" // for esys_CreateResourceObject, iesys_rs...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_...
+#include "tss2_esys.h"            // for Esys_NV_ReadAll, Esys_NV_WriteAll
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT
+#include "tss2_tpm2_types.h"      // for TPM2_CC_NV_Read, TPM2B_NV_PUBLIC
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks that Esys_NV_ReadAll and Esys_NV_WriteAll split the
+ * data into chunks of TPM2_PT_NV_BUFFER_MAX, which is only queried once, using
+ * a TCTI that simulates an NV index.
+ */
+
+#define TCTI_NV_MAGIC   0x4e56000000000000ULL /* 'NV\0\0\0\0\0\0' */
+#define TCTI_NV_VERSION 0x1
+#define NV_SIZE         6000
+#define NV_HANDLE       0x01000001
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    uint32_t command_code;  /* of the last command */
+    TSS2_RC  rc;            /* response code of the last command */
+    uint8_t  nv[NV_SIZE];   /* contents of the NV index */
+    size_t   read_offset;   /* of the last TPM2_NV_Read */
+    size_t   read_size;     /* of the last TPM2_NV_Read */
+    uint32_t nv_buffer_max; /* reported TPM2_PT_NV_BUFFER_MAX */
+    uint32_t capabilities;  /* number of TPM2_GetCapability commands */
+    uint32_t reads;         /* number of TPM2_NV_Read commands */
+    uint32_t writes;        /* number of TPM2_NV_Write commands */
+    uint32_t fail_write;    /* fail the TPM2_NV_Write with this number */
+    size_t   max_chunk;     /* largest chunk read or written */
+} TSS2_TCTI_CONTEXT_NV;
+
+static size_t
+get_uint16(const uint8_t *buffer) {
+    return (size_t)buffer[0] << 8 | buffer[1];
+}
+
+static TSS2_RC
+tcti_nv_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    TSS2_TCTI_CONTEXT_NV *tcti = (TSS2_TCTI_CONTEXT_NV *)tctiContext;
+    size_t                params, chunk, offset;
+
+    assert_true(size >= 10);
+    tcti->command_code = (uint32_t)buffer[6] << 24 | (uint32_t)buffer[7] << 16
+                         | (uint32_t)buffer[8] << 8 | buffer[9];
+    tcti->rc = TPM2_RC_SUCCESS;
+    /* header, authHandle, nvIndex, authorizationSize, sessions */
+    params = 22 + ((size_t)buffer[20] << 8 | buffer[21]);
+
+    switch (tcti->command_code) {
+    case TPM2_CC_GetCapability:
+        tcti->capabilities++;
+        break;
+    case TPM2_CC_NV_Read:
+        tcti->reads++;
+        tcti->read_size = get_uint16(&buffer[params]);
+        tcti->read_offset = get_uint16(&buffer[params + 2]);
+        assert_true(tcti->read_offset + tcti->read_size <= NV_SIZE);
+        if (tcti->read_size > tcti->max_chunk)
+            tcti->max_chunk = tcti->read_size;
+        break;
+    case TPM2_CC_NV_Write:
+        if (++tcti->writes == tcti->fail_write) {
+            tcti->rc = TPM2_RC_NV_LOCKED;
+            break;
+        }
+        chunk = get_uint16(&buffer[params]);
+        offset = get_uint16(&buffer[params + 2 + chunk]);
+        assert_true(offset + chunk <= NV_SIZE);
+        memcpy(&tcti->nv[offset], &buffer[params + 2], chunk);
+        if (chunk > tcti->max_chunk)
+            tcti->max_chunk = chunk;
+        break;
+    default:
+        break;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+static const uint8_t password_response[] = {
+    0x00, 0x00, /* nonce */
+    0x01,       /* sessionAttributes */
+    0x00, 0x00, /* hmac */
+};
+
+static TSS2_RC
+tcti_nv_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                size_t            *response_size,
+                uint8_t           *response_buffer,
+                int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_NV *tcti = (TSS2_TCTI_CONTEXT_NV *)tctiContext;
+    uint8_t               response[4096] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x0A, /* Response Size */
+        0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+    };
+    size_t size = 10, params = 0;
+
+    (void)timeout;
+    if (tcti->rc != TPM2_RC_SUCCESS) {
+        response[8] = (uint8_t)(tcti->rc >> 8);
+        response[9] = (uint8_t)tcti->rc;
+    } else if (tcti->command_code == TPM2_CC_GetCapability) {
+        static const uint8_t capability[] = {
+            0x00,                   /* moreData */
+            0x00, 0x00, 0x00, 0x06, /* TPM2_CAP_TPM_PROPERTIES */
+            0x00, 0x00, 0x00, 0x01, /* count */
+            0x00, 0x00, 0x01, 0x2c, /* TPM2_PT_NV_BUFFER_MAX */
+        };
+        memcpy(&response[size], &capability[0], sizeof(capability));
+        size += sizeof(capability);
+        response[size++] = (uint8_t)(tcti->nv_buffer_max >> 24);
+        response[size++] = (uint8_t)(tcti->nv_buffer_max >> 16);
+        response[size++] = (uint8_t)(tcti->nv_buffer_max >> 8);
+        response[size++] = (uint8_t)tcti->nv_buffer_max;
+    } else if (tcti->command_code == TPM2_CC_NV_Read
+               || tcti->command_code == TPM2_CC_NV_Write) {
+        response[1] = 0x02;
+        if (tcti->command_code == TPM2_CC_NV_Read) {
+            params = 2 + tcti->read_size;
+            response[size + 4] = (uint8_t)(tcti->read_size >> 8);
+            response[size + 5] = (uint8_t)tcti->read_size;
+            memcpy(&response[size + 6], &tcti->nv[tcti->read_offset], tcti->read_size);
+        }
+        response[size + 2] = (uint8_t)(params >> 8);
+        response[size + 3] = (uint8_t)params;
+        size += 4 + params;
+        memcpy(&response[size], &password_response[0], sizeof(password_response));
+        size += sizeof(password_response);
+    }
+    response[4] = (uint8_t)(size >> 8);
+    response[5] = (uint8_t)size;
+
+    *response_size = size;
+    if (response_buffer != NULL)
+        memcpy(response_buffer, &response[0], size);
+    return TSS2_RC_SUCCESS;
+}
+
+static const TPM2B_NV_PUBLIC nv_public = {
+    .size = 14,
+    .nvPublic = {
+        .nvIndex = NV_HANDLE,
+        .nameAlg = TPM2_ALG_SHA256,
+        .attributes = TPMA_NV_AUTHWRITE | TPMA_NV_AUTHREAD,
+        .authPolicy = { .size = 0 },
+        .dataSize = NV_SIZE,
+    },
+};
+
+static int
+setup(void **state) {
+    TSS2_RC               r;
+    ESYS_CONTEXT         *ectx;
+    RSRC_NODE_T          *node;
+    TSS2_TCTI_CONTEXT_NV *tcti = calloc(1, sizeof(*tcti));
+
+    if (tcti == NULL)
+        return -1;
+    tcti->magic = TCTI_NV_MAGIC;
+    tcti->version = TCTI_NV_VERSION;
+    tcti->transmit = tcti_nv_transmit;
+    tcti->receive = tcti_nv_receive;
+    tcti->nv_buffer_max = 1024;
+
+    r = Esys_Initialize(&ectx, (TSS2_TCTI_CONTEXT *)tcti, NULL);
+    if (r != TSS2_RC_SUCCESS)
+        return (int)r;
+
+    /* The ESYS_TR of the simulated NV index */
+    r = esys_CreateResourceObject(ectx, ESYS_TR_MIN_OBJECT, &node);
+    if (r != TSS2_RC_SUCCESS)
+        return (int)r;
+    node->rsrc.handle = NV_HANDLE;
+    r = iesys_rsrc_set_nv_public(ectx, node, &nv_public);
+    *state = (void *)ectx;
+    return (int)r;
+}
+
+static int
+teardown(void **state) {
+    TSS2_TCTI_CONTEXT *tcti;
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+
+    Esys_GetTcti(ectx, &tcti);
+    Esys_Finalize(&ectx);
+    free(tcti);
+    return 0;
+}
+
+static TSS2_TCTI_CONTEXT_NV *
+get_tcti(ESYS_CONTEXT *ectx) {
+    TSS2_TCTI_CONTEXT *tcti;
+
+    assert_int_equal(Esys_GetTcti(ectx, &tcti), TSS2_RC_SUCCESS);
+    return (TSS2_TCTI_CONTEXT_NV *)tcti;
+}
+
+typedef struct {
+    size_t calls;
+    size_t done[8];
+} PROGRESS;
+
+static void
+progress(size_t done, size_t total, void *userdata) {
+    PROGRESS *progress = userdata;
+
+    assert_true(done <= total);
+    if (progress->calls < 8)
+        progress->done[progress->calls] = done;
+    progress->calls++;
+}
+
+static void
+test_write_read(void **state) {
+    ESYS_CONTEXT         *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_NV *tcti = get_tcti(ectx);
+    PROGRESS              written = { 0 }, read = { 0 };
+    static uint8_t        data[3000], result[3000];
+
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(i * 13);
+
+    assert_int_equal(Esys_NV_WriteAll(ectx, ESYS_TR_MIN_OBJECT, ESYS_TR_MIN_OBJECT,
+                                      ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, 100,
+                                      &data[0], sizeof(data), progress, &written),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->writes, 3);
+    assert_int_equal(tcti->max_chunk, 1024);
+    assert_memory_equal(&tcti->nv[100], &data[0], sizeof(data));
+    assert_int_equal(written.calls, 3);
+    assert_int_equal(written.done[0], 1024);
+    assert_int_equal(written.done[1], 2048);
+    assert_int_equal(written.done[2], 3000);
+
+    assert_int_equal(Esys_NV_ReadAll(ectx, ESYS_TR_MIN_OBJECT, ESYS_TR_MIN_OBJECT,
+                                     ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, 100,
+                                     &result[0], sizeof(result), progress, &read),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->reads, 3);
+    assert_memory_equal(&result[0], &data[0], sizeof(data));
+    assert_int_equal(read.calls, 3);
+    assert_int_equal(read.done[2], 3000);
+
+    /* TPM2_PT_NV_BUFFER_MAX is queried once per context */
+    assert_int_equal(tcti->capabilities, 1);
+}
+
+static void
+test_bad_parameters(void **state) {
+    ESYS_CONTEXT         *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_NV *tcti = get_tcti(ectx);
+    uint8_t               data[16] = { 0 };
+
+    assert_int_equal(Esys_NV_ReadAll(ectx, ESYS_TR_MIN_OBJECT, ESYS_TR_MIN_OBJECT,
+                                     ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, 0, NULL, 1,
+                                     NULL, NULL),
+                     TSS2_ESYS_RC_BAD_REFERENCE);
+    assert_int_equal(Esys_NV_WriteAll(ectx, ESYS_TR_MIN_OBJECT, ESYS_TR_MIN_OBJECT,
+                                      ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, 65000,
+                                      &data[0], 1000, NULL, NULL),
+                     TSS2_ESYS_RC_BAD_VALUE);
+
+    /* Nothing to transfer */
+    assert_int_equal(Esys_NV_ReadAll(ectx, ESYS_TR_MIN_OBJECT, ESYS_TR_MIN_OBJECT,
+                                     ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, 0, &data[0], 0,
+                                     NULL, NULL),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->reads, 0);
+}
+
+static void
+test_large_buffer_and_error(void **state) {
+    ESYS_CONTEXT         *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_NV *tcti = get_tcti(ectx);
+    PROGRESS              written = { 0 };
+    static uint8_t        data[5000];
+
+    /* A larger TPM buffer is capped at the size of TPM2B_MAX_NV_BUFFER */
+    tcti->nv_buffer_max = 4096;
+    tcti->fail_write = 3;
+    assert_int_equal(Esys_NV_WriteAll(ectx, ESYS_TR_MIN_OBJECT, ESYS_TR_MIN_OBJECT,
+                                      ESYS_TR_PASSWORD, ESYS_TR_NONE, ESYS_TR_NONE, 0, &data[0],
+                                      sizeof(data), progress, &written),
+                     TPM2_RC_NV_LOCKED);
+    assert_int_equal(tcti->writes, 3);
+    assert_int_equal(tcti->max_chunk, TPM2_MAX_NV_BUFFER_SIZE);
+    assert_int_equal(written.calls, 2);
+    assert_int_equal(written.done[1], 2 * TPM2_MAX_NV_BUFFER_SIZE);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_write_read, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_bad_parameters, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_large_buffer_and_error, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
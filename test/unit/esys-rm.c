@@ -0,0 +1,309 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t, uint32_t, uint64_t
+#include <stdlib.h>   // for NULL, size_t, free, calloc
+#include <string.h>   // for memcpy
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "esys_int.h"             // for RSRC_NODE_T, ESYS_CONTEXT
+#include "tss2-esys/esys_iutil.h" // for esys_CreateResourceObject, esys_Get...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_...
+#include "tss2_esys.h"            // for Esys_ResourceManagerEnable, Esys_Re...
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT
+#include "tss2_tpm2_types.h"      // for TPM2_CC_ContextSave, TPM2_RC_OBJECT_...
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks that the embedded resource manager swaps out the
+ * least recently used transient objects and loads them again on use, using a
+ * TCTI that simulates a TPM with two object slots.
+ */
+
+#define TCTI_SLOTS_MAGIC   0x534c4f5453000000ULL /* 'SLOTS\0\0\0' */
+#define TCTI_SLOTS_VERSION 0x1
+#define TCTI_SLOTS_MAX     2
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    uint32_t    command_code;           /* of the last command */
+    TSS2_RC     rc;                     /* response code of the last command */
+    TPM2_HANDLE loaded[TCTI_SLOTS_MAX]; /* loaded transient objects, 0 if free */
+    TPM2_HANDLE next_handle;            /* handle of the next loaded object */
+    TPM2_HANDLE loaded_handle;          /* response of the last TPM2_ContextLoad */
+    uint32_t    saves;                  /* number of TPM2_ContextSave commands */
+    uint32_t    loads;                  /* number of TPM2_ContextLoad commands */
+    uint32_t    flushes;                /* number of TPM2_FlushContext commands */
+} TSS2_TCTI_CONTEXT_SLOTS;
+
+static TPM2_HANDLE *
+tcti_slots_find(TSS2_TCTI_CONTEXT_SLOTS *tcti, TPM2_HANDLE handle) {
+    for (size_t i = 0; i < TCTI_SLOTS_MAX; i++)
+        if (tcti->loaded[i] == handle)
+            return &tcti->loaded[i];
+    return NULL;
+}
+
+static TSS2_RC
+tcti_slots_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    TSS2_TCTI_CONTEXT_SLOTS *tcti = (TSS2_TCTI_CONTEXT_SLOTS *)tctiContext;
+    TPM2_HANDLE              handle = 0, *slot;
+
+    assert_true(size >= 10);
+    tcti->command_code = (uint32_t)buffer[6] << 24 | (uint32_t)buffer[7] << 16
+                         | (uint32_t)buffer[8] << 8 | buffer[9];
+    if (size >= 14)
+        handle = (uint32_t)buffer[10] << 24 | (uint32_t)buffer[11] << 16
+                 | (uint32_t)buffer[12] << 8 | buffer[13];
+
+    tcti->rc = TPM2_RC_SUCCESS;
+    switch (tcti->command_code) {
+    case TPM2_CC_ContextSave:
+        tcti->saves++;
+        if (tcti_slots_find(tcti, handle) == NULL)
+            tcti->rc = TPM2_RC_REFERENCE_H0;
+        break;
+    case TPM2_CC_FlushContext:
+        tcti->flushes++;
+        slot = tcti_slots_find(tcti, handle);
+        if (slot == NULL)
+            tcti->rc = TPM2_RC_REFERENCE_H0;
+        else
+            *slot = 0;
+        break;
+    case TPM2_CC_ContextLoad:
+        tcti->loads++;
+        slot = tcti_slots_find(tcti, 0);
+        if (slot == NULL) {
+            tcti->rc = TPM2_RC_OBJECT_MEMORY;
+        } else {
+            *slot = tcti->next_handle++;
+            tcti->loaded_handle = *slot;
+        }
+        break;
+    default:
+        break;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+static const uint8_t save_parameters[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, /* sequence */
+    0x80, 0x00, 0x00, 0x00,                         /* savedHandle */
+    0x40, 0x00, 0x00, 0x07,                         /* hierarchy */
+    0x00, 0x04, 0xde, 0xad, 0xbe, 0xef,             /* contextBlob */
+};
+
+static const uint8_t capability_parameters[] = {
+    0x00,                                           /* moreData */
+    0x00, 0x00, 0x00, 0x06,                         /* TPM2_CAP_TPM_PROPERTIES */
+    0x00, 0x00, 0x00, 0x03,                         /* count */
+    0x00, 0x00, 0x01, 0x0e, 0x00, 0x00, 0x00, 0x03, /* TPM2_PT_HR_TRANSIENT_MIN */
+    0x00, 0x00, 0x01, 0x0f, 0x00, 0x00, 0x00, 0x07, /* TPM2_PT_HR_PERSISTENT_MIN */
+    0x00, 0x00, 0x01, 0x10, 0x00, 0x00, 0x00, 0x04, /* TPM2_PT_HR_LOADED_MIN */
+};
+
+static TSS2_RC
+tcti_slots_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                   size_t            *response_size,
+                   uint8_t           *response_buffer,
+                   int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_SLOTS *tcti = (TSS2_TCTI_CONTEXT_SLOTS *)tctiContext;
+    uint8_t                  response[64] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x0A, /* Response Size */
+        0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+    };
+    size_t size = 10;
+
+    (void)timeout;
+    if (tcti->rc != TPM2_RC_SUCCESS) {
+        response[8] = (uint8_t)(tcti->rc >> 8);
+        response[9] = (uint8_t)tcti->rc;
+    } else if (tcti->command_code == TPM2_CC_ContextSave) {
+        memcpy(&response[10], &save_parameters[0], sizeof(save_parameters));
+        size += sizeof(save_parameters);
+    } else if (tcti->command_code == TPM2_CC_ContextLoad) {
+        response[10] = (uint8_t)(tcti->loaded_handle >> 24);
+        response[11] = (uint8_t)(tcti->loaded_handle >> 16);
+        response[12] = (uint8_t)(tcti->loaded_handle >> 8);
+        response[13] = (uint8_t)tcti->loaded_handle;
+        size += 4;
+    } else if (tcti->command_code == TPM2_CC_GetCapability) {
+        memcpy(&response[10], &capability_parameters[0], sizeof(capability_parameters));
+        size += sizeof(capability_parameters);
+    }
+    response[5] = (uint8_t)size;
+
+    *response_size = size;
+    if (response_buffer != NULL)
+        memcpy(response_buffer, &response[0], size);
+    return TSS2_RC_SUCCESS;
+}
+
+static int
+setup(void **state) {
+    TSS2_RC                  r;
+    ESYS_CONTEXT            *ectx;
+    TSS2_TCTI_CONTEXT_SLOTS *tcti = calloc(1, sizeof(*tcti));
+
+    if (tcti == NULL)
+        return -1;
+    tcti->magic = TCTI_SLOTS_MAGIC;
+    tcti->version = TCTI_SLOTS_VERSION;
+    tcti->transmit = tcti_slots_transmit;
+    tcti->receive = tcti_slots_receive;
+    tcti->next_handle = TPM2_TRANSIENT_FIRST;
+
+    r = Esys_Initialize(&ectx, (TSS2_TCTI_CONTEXT *)tcti, NULL);
+    *state = (void *)ectx;
+    return (int)r;
+}
+
+static int
+teardown(void **state) {
+    TSS2_TCTI_CONTEXT *tcti;
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+
+    Esys_GetTcti(ectx, &tcti);
+    Esys_Finalize(&ectx);
+    free(tcti);
+    return 0;
+}
+
+static TSS2_TCTI_CONTEXT_SLOTS *
+get_tcti(ESYS_CONTEXT *ectx) {
+    TSS2_TCTI_CONTEXT *tcti;
+
+    assert_int_equal(Esys_GetTcti(ectx, &tcti), TSS2_RC_SUCCESS);
+    return (TSS2_TCTI_CONTEXT_SLOTS *)tcti;
+}
+
+/* Creates an ESYS_TR for an object loaded into the simulated TPM */
+static RSRC_NODE_T *
+create_loaded_object(ESYS_CONTEXT *ectx, ESYS_TR esys_handle) {
+    TSS2_TCTI_CONTEXT_SLOTS *tcti = get_tcti(ectx);
+    TPM2_HANDLE             *slot = tcti_slots_find(tcti, 0);
+    RSRC_NODE_T             *node = NULL;
+
+    assert_non_null(slot);
+    assert_int_equal(esys_CreateResourceObject(ectx, esys_handle, &node), TSS2_RC_SUCCESS);
+    node->rsrc.handle = tcti->next_handle++;
+    *slot = node->rsrc.handle;
+    return node;
+}
+
+static void
+test_bad_parameters(void **state) {
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)*state;
+
+    assert_int_equal(Esys_ResourceManagerEnable(NULL, 1, 1), TSS2_ESYS_RC_BAD_REFERENCE);
+    assert_int_equal(Esys_ResourceManagerDisable(NULL), TSS2_ESYS_RC_BAD_REFERENCE);
+    assert_int_equal(Esys_ResourceManagerDisable(ectx), TSS2_RC_SUCCESS);
+
+    /* Limits that are not given are taken from the TPM */
+    assert_int_equal(Esys_ResourceManagerEnable(ectx, 0, 0), TSS2_RC_SUCCESS);
+    assert_int_equal(ectx->rm.max_objects, 3);
+    assert_int_equal(ectx->rm.max_sessions, 4);
+    assert_int_equal(Esys_ResourceManagerEnable(ectx, 5, 0), TSS2_RC_SUCCESS);
+    assert_int_equal(ectx->rm.max_objects, 5);
+    assert_int_equal(ectx->rm.max_sessions, 4);
+    assert_int_equal(Esys_ResourceManagerDisable(ectx), TSS2_RC_SUCCESS);
+    assert_null(ectx->rm.sys);
+}
+
+static void
+test_swap(void **state) {
+    ESYS_CONTEXT            *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_SLOTS *tcti = get_tcti(ectx);
+    RSRC_NODE_T             *first, *second, *third;
+    TPMS_CONTEXT            *context = NULL, *other = NULL;
+    TPM2B_NAME              *name = NULL;
+    ESYS_TR                  loaded = ESYS_TR_NONE;
+
+    assert_int_equal(Esys_ResourceManagerEnable(ectx, TCTI_SLOTS_MAX, 1), TSS2_RC_SUCCESS);
+    first = create_loaded_object(ectx, 0x4000);
+    second = create_loaded_object(ectx, 0x4001);
+
+    /* Using an object does not swap anything while the TPM has room */
+    assert_int_equal(Esys_ContextSave(ectx, 0x4000, &context), TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->saves, 1);
+    assert_int_equal(tcti->flushes, 0);
+
+    /* The least recently used object makes room for a new one */
+    assert_int_equal(Esys_ContextLoad(ectx, context, &loaded), TSS2_RC_SUCCESS);
+    assert_int_equal(esys_GetResourceObject(ectx, loaded, &third), TSS2_RC_SUCCESS);
+    assert_non_null(second->rm_context);
+    assert_null(first->rm_context);
+    assert_int_equal(tcti->saves, 2);
+    assert_int_equal(tcti->flushes, 1);
+    assert_non_null(tcti_slots_find(tcti, third->rsrc.handle));
+
+    /* Swapped out objects are loaded again with a new TPM handle on use */
+    assert_int_equal(Esys_ContextSave(ectx, 0x4001, &other), TSS2_RC_SUCCESS);
+    assert_null(second->rm_context);
+    assert_non_null(first->rm_context);
+    assert_non_null(tcti_slots_find(tcti, second->rsrc.handle));
+    assert_int_equal(tcti->loads, 2);
+
+    /* The metadata of swapped out objects is available without the TPM */
+    assert_int_equal(Esys_TR_GetName(ectx, 0x4000, &name), TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->loads, 2);
+
+    Esys_Free(name);
+    Esys_Free(context);
+    Esys_Free(other);
+}
+
+static void
+test_disable(void **state) {
+    ESYS_CONTEXT            *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_SLOTS *tcti = get_tcti(ectx);
+    RSRC_NODE_T             *first;
+    TPMS_CONTEXT            *context = NULL;
+    ESYS_TR                  loaded = ESYS_TR_NONE;
+
+    assert_int_equal(Esys_ResourceManagerEnable(ectx, TCTI_SLOTS_MAX, 1), TSS2_RC_SUCCESS);
+    first = create_loaded_object(ectx, 0x4000);
+    create_loaded_object(ectx, 0x4001);
+
+    assert_int_equal(Esys_ContextSave(ectx, 0x4001, &context), TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_ContextLoad(ectx, context, &loaded), TSS2_RC_SUCCESS);
+    assert_non_null(first->rm_context);
+
+    /* Swapped out objects do not fit into the TPM */
+    assert_int_equal(Esys_ResourceManagerDisable(ectx), TPM2_RC_OBJECT_MEMORY);
+    assert_non_null(ectx->rm.sys);
+
+    assert_int_equal(Esys_FlushContext(ectx, loaded), TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_ResourceManagerDisable(ectx), TSS2_RC_SUCCESS);
+    assert_null(ectx->rm.sys);
+    assert_null(first->rm_context);
+    assert_non_null(tcti_slots_find(tcti, first->rsrc.handle));
+
+    Esys_Free(context);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_bad_parameters, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_swap, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_disable, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,266 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t, uint32_t, uint64_t
+#include <stdlib.h>   // for NULL, size_t, free, calloc
+#include <string.h>   // for memcmp, memset
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "esys_int.h"             // for RSRC_NODE_T, ESYS_CONTEXT, IESYS_NV_...
+#include "esys_types.h"           // for IESYS_RESOURCE, IESYSC_KEY_RSRC, IES...
+#include "tss2-esys/esys_iutil.h" // for esys_CreateResourceObject, iesys_rs...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS
+#include "tss2_esys.h"            // for Esys_TR_Serialize, Esys_TR_Deserialize
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT
+#include "tss2_tpm2_types.h"      // for TPM2B_PUBLIC, TPM2B_NV_PUBLIC, TPMA_NV...
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks the compact meta data of ESYS_TR objects: public
+ * areas of keys are returned unchanged, NV indices with the same public area
+ * share one entry and all resource types survive Esys_TR_Serialize() and
+ * Esys_TR_Deserialize().
+ */
+
+#define TCTI_NONE_MAGIC   0x4e4f4e4500000000ULL /* 'NONE\0\0\0\0' */
+#define TCTI_NONE_VERSION 0x1
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+} TSS2_TCTI_CONTEXT_NONE;
+
+static TSS2_RC
+tcti_none_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    (void)tctiContext;
+    (void)size;
+    (void)buffer;
+    return TSS2_TCTI_RC_NOT_IMPLEMENTED;
+}
+
+static TSS2_RC
+tcti_none_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                  size_t            *response_size,
+                  uint8_t           *response_buffer,
+                  int32_t            timeout) {
+    (void)tctiContext;
+    (void)response_size;
+    (void)response_buffer;
+    (void)timeout;
+    return TSS2_TCTI_RC_NOT_IMPLEMENTED;
+}
+
+static int
+setup(void **state) {
+    TSS2_RC                 r;
+    ESYS_CONTEXT           *ectx;
+    TSS2_TCTI_CONTEXT_NONE *tcti = calloc(1, sizeof(*tcti));
+
+    if (tcti == NULL)
+        return -1;
+    tcti->magic = TCTI_NONE_MAGIC;
+    tcti->version = TCTI_NONE_VERSION;
+    tcti->transmit = tcti_none_transmit;
+    tcti->receive = tcti_none_receive;
+
+    r = Esys_Initialize(&ectx, (TSS2_TCTI_CONTEXT *)tcti, NULL);
+    *state = (void *)ectx;
+    return (int)r;
+}
+
+static int
+teardown(void **state) {
+    TSS2_TCTI_CONTEXT *tcti;
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+
+    Esys_GetTcti(ectx, &tcti);
+    Esys_Finalize(&ectx);
+    free(tcti);
+    return 0;
+}
+
+static RSRC_NODE_T *
+create_node(ESYS_CONTEXT *ectx, ESYS_TR esys_handle) {
+    RSRC_NODE_T *node = NULL;
+
+    assert_int_equal(esys_CreateResourceObject(ectx, esys_handle, &node), TSS2_RC_SUCCESS);
+    assert_non_null(node);
+    return node;
+}
+
+static size_t
+nv_public_entries(ESYS_CONTEXT *ectx) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < IESYS_NV_PUBLIC_BUCKETS; i++)
+        for (IESYS_NV_PUBLIC_ENTRY *entry = ectx->nv_publics[i]; entry != NULL;
+             entry = entry->next)
+            count++;
+    return count;
+}
+
+static const TPM2B_NV_PUBLIC nv_public = {
+    .size = 14,
+    .nvPublic = {
+        .nvIndex = 0x01000001,
+        .nameAlg = TPM2_ALG_SHA256,
+        .attributes = TPMA_NV_OWNERWRITE | TPMA_NV_AUTHWRITE | TPMA_NV_AUTHREAD,
+        .authPolicy = { .size = 0 },
+        .dataSize = 32,
+    },
+};
+
+static void
+test_key_public(void **state) {
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)*state;
+    RSRC_NODE_T  *node = create_node(ectx, 0x4000);
+    TPM2B_PUBLIC  public, result;
+
+    /* Objects without a public area return a zeroed one */
+    assert_int_equal(iesys_rsrc_key_public(node, &result), TSS2_RC_SUCCESS);
+    assert_int_equal(result.size, 0);
+
+    memset(&public, 0, sizeof(public));
+    public.publicArea.type = TPM2_ALG_KEYEDHASH;
+    public.publicArea.nameAlg = TPM2_ALG_SHA256;
+    public.publicArea.objectAttributes = TPMA_OBJECT_USERWITHAUTH | TPMA_OBJECT_SIGN_ENCRYPT;
+    public.publicArea.parameters.keyedHashDetail.scheme.scheme = TPM2_ALG_NULL;
+    public.publicArea.unique.keyedHash.size = 32;
+    memset(&public.publicArea.unique.keyedHash.buffer[0], 0xaa, 32);
+
+    assert_int_equal(iesys_rsrc_set_key_public(ectx, node, &public), TSS2_RC_SUCCESS);
+    assert_int_equal(node->rsrc.rsrcType, IESYSC_KEY_RSRC);
+    assert_true(node->rsrc.misc.rsrc_key_pub->size < sizeof(TPM2B_PUBLIC) / 4);
+
+    assert_int_equal(iesys_rsrc_key_public(node, &result), TSS2_RC_SUCCESS);
+    assert_int_equal(result.publicArea.type, TPM2_ALG_KEYEDHASH);
+    assert_int_equal(result.publicArea.nameAlg, TPM2_ALG_SHA256);
+    assert_int_equal(result.publicArea.objectAttributes, public.publicArea.objectAttributes);
+    assert_int_equal(result.publicArea.unique.keyedHash.size, 32);
+    assert_memory_equal(&result.publicArea.unique.keyedHash.buffer[0],
+                        &public.publicArea.unique.keyedHash.buffer[0], 32);
+}
+
+static void
+test_nv_public_shared(void **state) {
+    ESYS_CONTEXT   *ectx = (ESYS_CONTEXT *)*state;
+    RSRC_NODE_T    *first = create_node(ectx, 0x4000);
+    RSRC_NODE_T    *second = create_node(ectx, 0x4001);
+    TPM2B_NV_PUBLIC public = nv_public, result;
+    TPM2B_NAME      name;
+    ESYS_TR         esys_handle;
+
+    assert_int_equal(iesys_rsrc_set_nv_public(ectx, first, &public), TSS2_RC_SUCCESS);
+    public.nvPublic.nvIndex++;
+    assert_int_equal(iesys_rsrc_set_nv_public(ectx, second, &public), TSS2_RC_SUCCESS);
+
+    /* Indices with the same public area share the entry */
+    assert_ptr_equal(first->rsrc.misc.rsrc_nv_pub.entry, second->rsrc.misc.rsrc_nv_pub.entry);
+    assert_int_equal(first->rsrc.misc.rsrc_nv_pub.entry->refCount, 2);
+    assert_int_equal(nv_public_entries(ectx), 1);
+
+    iesys_rsrc_nv_public(first, &result);
+    assert_int_equal(result.size, nv_public.size);
+    assert_memory_equal(&result.nvPublic, &nv_public.nvPublic, sizeof(result.nvPublic));
+    iesys_rsrc_nv_public(second, &result);
+    assert_int_equal(result.nvPublic.nvIndex, nv_public.nvPublic.nvIndex + 1);
+
+    /* Writing the index moves it to an entry of its own and updates its name */
+    assert_int_equal(iesys_rsrc_nv_add_attributes(ectx, first, TPMA_NV_WRITTEN), TSS2_RC_SUCCESS);
+    assert_ptr_not_equal(first->rsrc.misc.rsrc_nv_pub.entry, second->rsrc.misc.rsrc_nv_pub.entry);
+    assert_int_equal(second->rsrc.misc.rsrc_nv_pub.entry->refCount, 1);
+    assert_int_equal(nv_public_entries(ectx), 2);
+
+    public = nv_public;
+    public.nvPublic.attributes |= TPMA_NV_WRITTEN;
+    assert_int_equal(iesys_nv_get_name(&ectx->crypto_backend, &public, &name), TSS2_RC_SUCCESS);
+    assert_int_equal(first->rsrc.name.size, name.size);
+    assert_memory_equal(&first->rsrc.name.name[0], &name.name[0], name.size);
+
+    /* Entries are released with their last index */
+    esys_handle = 0x4001;
+    assert_int_equal(Esys_TR_Close(ectx, &esys_handle), TSS2_RC_SUCCESS);
+    assert_int_equal(nv_public_entries(ectx), 1);
+    esys_handle = 0x4000;
+    assert_int_equal(Esys_TR_Close(ectx, &esys_handle), TSS2_RC_SUCCESS);
+    assert_int_equal(nv_public_entries(ectx), 0);
+}
+
+static void
+check_serialization(ESYS_CONTEXT *ectx, ESYS_TR esys_handle) {
+    RSRC_NODE_T   *node;
+    IESYS_RESOURCE rsrc, result;
+    uint8_t       *buffer = NULL;
+    size_t         size = 0;
+    ESYS_TR        copy = ESYS_TR_NONE;
+
+    assert_int_equal(Esys_TR_Serialize(ectx, esys_handle, &buffer, &size), TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_TR_Deserialize(ectx, buffer, size, &copy), TSS2_RC_SUCCESS);
+    Esys_Free(buffer);
+
+    assert_int_equal(esys_GetResourceObject(ectx, esys_handle, &node), TSS2_RC_SUCCESS);
+    assert_int_equal(iesys_rsrc_get(node, &rsrc), TSS2_RC_SUCCESS);
+    assert_int_equal(esys_GetResourceObject(ectx, copy, &node), TSS2_RC_SUCCESS);
+    assert_int_equal(iesys_rsrc_get(node, &result), TSS2_RC_SUCCESS);
+    assert_memory_equal(&rsrc, &result, sizeof(rsrc));
+
+    assert_int_equal(Esys_TR_Close(ectx, &copy), TSS2_RC_SUCCESS);
+}
+
+static void
+test_serialization(void **state) {
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)*state;
+    RSRC_NODE_T  *node;
+    IESYS_SESSION session;
+    TPM2B_PUBLIC  public;
+
+    node = create_node(ectx, 0x4000);
+    node->rsrc.handle = 0x81000001;
+    memset(&public, 0, sizeof(public));
+    public.publicArea.type = TPM2_ALG_SYMCIPHER;
+    public.publicArea.nameAlg = TPM2_ALG_SHA256;
+    public.publicArea.parameters.symDetail.sym.algorithm = TPM2_ALG_NULL;
+    assert_int_equal(iesys_rsrc_set_key_public(ectx, node, &public), TSS2_RC_SUCCESS);
+    check_serialization(ectx, 0x4000);
+
+    node = create_node(ectx, 0x4001);
+    node->rsrc.handle = nv_public.nvPublic.nvIndex;
+    assert_int_equal(iesys_rsrc_set_nv_public(ectx, node, &nv_public), TSS2_RC_SUCCESS);
+    check_serialization(ectx, 0x4001);
+    assert_int_equal(node->rsrc.misc.rsrc_nv_pub.entry->refCount, 1);
+
+    node = create_node(ectx, 0x4002);
+    node->rsrc.handle = TPM2_HMAC_SESSION_FIRST;
+    memset(&session, 0, sizeof(session));
+    session.sessionType = TPM2_SE_HMAC;
+    session.authHash = TPM2_ALG_SHA256;
+    session.symmetric.algorithm = TPM2_ALG_NULL;
+    session.sessionAttributes = TPMA_SESSION_CONTINUESESSION;
+    session.nonceTPM.size = 32;
+    memset(&session.nonceTPM.buffer[0], 0x55, 32);
+    assert_int_equal(iesys_rsrc_set_session(ectx, node, &session), TSS2_RC_SUCCESS);
+    check_serialization(ectx, 0x4002);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_key_public, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_nv_public_shared, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_serialization, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
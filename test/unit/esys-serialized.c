@@ -0,0 +1,266 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t, uint32_t, uint64_t
+#include <pthread.h>  // for pthread_create, pthread_join, pthread_t
+#include <stdlib.h>   // for NULL, size_t, free, calloc
+#include <string.h>   // for memcpy
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_...
+#include "tss2_esys.h"            // for Esys_SerializedModeEnable, Esys_GetRandom
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT
+#include "tss2_tpm2_types.h"      // for TPM2B_DIGEST, TPM2B_NAME, TPM2_CC_Ge...
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks that threads sharing an ESYS context in serialized
+ * mode send their commands one at a time, using a TCTI that answers
+ * TPM2_GetRandom and counts commands overlapping each other.
+ */
+
+#define TCTI_THREAD_MAGIC   0x5448524541440000ULL /* 'THREAD\0\0' */
+#define TCTI_THREAD_VERSION 0x1
+#define NUM_THREADS         8
+#define NUM_ITERATIONS      50
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    uint16_t requested; /* bytes of the last TPM2_GetRandom */
+    int      busy;      /* a command was sent and not yet received */
+    uint32_t overlaps;  /* commands sent while another one was busy */
+    uint32_t commands;  /* number of TPM2_GetRandom commands */
+} TSS2_TCTI_CONTEXT_THREAD;
+
+static TSS2_RC
+tcti_thread_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    TSS2_TCTI_CONTEXT_THREAD *tcti = (TSS2_TCTI_CONTEXT_THREAD *)tctiContext;
+
+    if (size != 12 || buffer[9] != (uint8_t)TPM2_CC_GetRandom)
+        return TSS2_TCTI_RC_BAD_VALUE;
+    if (tcti->busy)
+        tcti->overlaps++;
+    tcti->busy = 1;
+    tcti->requested = (uint16_t)(buffer[10] << 8 | buffer[11]);
+    tcti->commands++;
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_thread_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                    size_t            *response_size,
+                    uint8_t           *response_buffer,
+                    int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_THREAD *tcti = (TSS2_TCTI_CONTEXT_THREAD *)tctiContext;
+    uint8_t                   response[64] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x00, /* Response Size */
+        0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+    };
+    size_t size = 12 + tcti->requested;
+
+    (void)timeout;
+    response[5] = (uint8_t)size;
+    response[11] = (uint8_t)tcti->requested;
+    for (size_t i = 0; i < tcti->requested; i++)
+        response[12 + i] = (uint8_t)(tcti->requested + i);
+
+    *response_size = size;
+    if (response_buffer != NULL) {
+        memcpy(response_buffer, &response[0], size);
+        tcti->busy = 0;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+static int
+setup(void **state) {
+    TSS2_RC                   r;
+    ESYS_CONTEXT             *ectx;
+    TSS2_TCTI_CONTEXT_THREAD *tcti = calloc(1, sizeof(*tcti));
+
+    if (tcti == NULL)
+        return -1;
+    tcti->magic = TCTI_THREAD_MAGIC;
+    tcti->version = TCTI_THREAD_VERSION;
+    tcti->transmit = tcti_thread_transmit;
+    tcti->receive = tcti_thread_receive;
+
+    r = Esys_Initialize(&ectx, (TSS2_TCTI_CONTEXT *)tcti, NULL);
+    if (r != TSS2_RC_SUCCESS)
+        return (int)r;
+    r = Esys_SerializedModeEnable(ectx);
+    *state = (void *)ectx;
+    return (int)r;
+}
+
+static int
+teardown(void **state) {
+    TSS2_TCTI_CONTEXT *tcti;
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+
+    Esys_GetTcti(ectx, &tcti);
+    Esys_Finalize(&ectx);
+    free(tcti);
+    return 0;
+}
+
+static TSS2_TCTI_CONTEXT_THREAD *
+get_tcti(ESYS_CONTEXT *ectx) {
+    TSS2_TCTI_CONTEXT *tcti;
+
+    assert_int_equal(Esys_GetTcti(ectx, &tcti), TSS2_RC_SUCCESS);
+    return (TSS2_TCTI_CONTEXT_THREAD *)tcti;
+}
+
+typedef struct {
+    ESYS_CONTEXT *ectx;
+    ESYS_TR       object; /* copy of ESYS_TR_RH_OWNER for the thread */
+    size_t        index;
+    size_t        failures;
+} THREAD_ARGS;
+
+static void *
+random_thread(void *arg) {
+    THREAD_ARGS  *args = (THREAD_ARGS *)arg;
+    TPM2B_DIGEST *random;
+    UINT16        bytes = (UINT16)(args->index + 1);
+
+    for (size_t i = 0; i < NUM_ITERATIONS; i++) {
+        if (Esys_GetRandom(args->ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, bytes, &random)
+            != TSS2_RC_SUCCESS) {
+            args->failures++;
+            continue;
+        }
+        /* The response belongs to the command of this thread */
+        if (random->size != bytes || random->buffer[0] != bytes)
+            args->failures++;
+        free(random);
+    }
+    return NULL;
+}
+
+static void *
+object_thread(void *arg) {
+    THREAD_ARGS *args = (THREAD_ARGS *)arg;
+    TPM2B_AUTH  auth = { .size = 1, .buffer = { (uint8_t)args->index } };
+    TPM2B_NAME *name;
+    TPM2_HANDLE handle;
+
+    for (size_t i = 0; i < NUM_ITERATIONS; i++) {
+        if (Esys_TR_SetAuth(args->ectx, args->object, &auth) != TSS2_RC_SUCCESS)
+            args->failures++;
+        if (Esys_TR_GetName(args->ectx, args->object, &name) != TSS2_RC_SUCCESS) {
+            args->failures++;
+        } else {
+            if (name->size != 4 || name->name[0] != 0x40 || name->name[3] != 0x01)
+                args->failures++;
+            free(name);
+        }
+        if (Esys_TR_GetTpmHandle(args->ectx, ESYS_TR_RH_OWNER, &handle) != TSS2_RC_SUCCESS
+            || handle != TPM2_RH_OWNER)
+            args->failures++;
+        if (Esys_TR_GetTpmHandle(args->ectx, args->object, &handle) != TSS2_RC_SUCCESS
+            || handle != TPM2_RH_OWNER)
+            args->failures++;
+    }
+    return NULL;
+}
+
+static void
+run_threads(ESYS_CONTEXT *ectx, void *(*start)(void *), THREAD_ARGS *args) {
+    pthread_t threads[NUM_THREADS];
+
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+        args[i].ectx = ectx;
+        args[i].index = i;
+        args[i].failures = 0;
+        assert_int_equal(pthread_create(&threads[i], NULL, start, &args[i]), 0);
+    }
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        assert_int_equal(args[i].failures, 0);
+    }
+}
+
+static void
+test_commands(void **state) {
+    ESYS_CONTEXT             *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_THREAD *tcti = get_tcti(ectx);
+    THREAD_ARGS               args[NUM_THREADS];
+
+    run_threads(ectx, random_thread, args);
+    assert_int_equal(tcti->commands, NUM_THREADS * NUM_ITERATIONS);
+    assert_int_equal(tcti->overlaps, 0);
+}
+
+static void
+test_objects(void **state) {
+    ESYS_CONTEXT             *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_THREAD *tcti = get_tcti(ectx);
+    THREAD_ARGS               args[NUM_THREADS];
+    uint8_t                  *buffer;
+    size_t                    size;
+
+    /* Objects of their own, which are looked up without the command queue */
+    assert_int_equal(Esys_TR_Serialize(ectx, ESYS_TR_RH_OWNER, &buffer, &size), TSS2_RC_SUCCESS);
+    for (size_t i = 0; i < NUM_THREADS; i++)
+        assert_int_equal(Esys_TR_Deserialize(ectx, buffer, size, &args[i].object),
+                         TSS2_RC_SUCCESS);
+    free(buffer);
+
+    run_threads(ectx, object_thread, args);
+    assert_int_equal(tcti->commands, 0);
+
+    for (size_t i = 0; i < NUM_THREADS; i++)
+        assert_int_equal(Esys_TR_Close(ectx, &args[i].object), TSS2_RC_SUCCESS);
+}
+
+static void
+test_sequence(void **state) {
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)*state;
+    TPM2B_DIGEST *random;
+
+    assert_int_equal(Esys_SerializedModeEnable(NULL), TSS2_ESYS_RC_BAD_REFERENCE);
+    assert_int_equal(Esys_SerializedModeEnable(ectx), TSS2_RC_SUCCESS);
+
+    /* The _Finish could be called by any thread */
+    assert_int_equal(Esys_GetRandom_Async(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, 4),
+                     TSS2_ESYS_RC_BAD_SEQUENCE);
+    assert_int_equal(Esys_GetRandom(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, 4, &random),
+                     TSS2_RC_SUCCESS);
+    free(random);
+
+    assert_int_equal(Esys_SerializedModeDisable(ectx), TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_GetRandom_Async(ectx, ESYS_TR_NONE, ESYS_TR_NONE, ESYS_TR_NONE, 4),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_SerializedModeEnable(ectx), TSS2_ESYS_RC_BAD_SEQUENCE);
+    assert_int_equal(Esys_GetRandom_Finish(ectx, &random), TSS2_RC_SUCCESS);
+    assert_int_equal(random->size, 4);
+    free(random);
+    assert_int_equal(Esys_SerializedModeDisable(ectx), TSS2_RC_SUCCESS);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_commands, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_objects, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sequence, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
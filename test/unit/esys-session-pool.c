@@ -0,0 +1,366 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, uint32_t, int32_t, uint64_t
+#include <pthread.h>  // for pthread_create, pthread_join, pthread_t
+#include <stdlib.h>   // for NULL, size_t, free, malloc
+#include <string.h>   // for memcpy, memset
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_...
+#include "tss2_esys.h"            // for Esys_SessionPool_New, ESYS_CONTEXT
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT
+#include "tss2_tpm2_types.h"      // for TPM2_CC_StartAuthSession, TPM2_SE_HMAC
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks the lending, retirement and refilling of the sessions
+ * of an ESYS session pool against a TCTI that answers TPM2_StartAuthSession
+ * and TPM2_FlushContext, also with threads sharing the pool.
+ */
+
+#define TCTI_SESSIONS_MAGIC   0x53455353494f4e00ULL /* 'SESSION\0' */
+#define TCTI_SESSIONS_VERSION 0x1
+#define NUM_THREADS           4
+#define NUM_ITERATIONS        50
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    uint32_t command_code; /* of the last command */
+    uint32_t starts;       /* number of TPM2_StartAuthSession commands */
+    uint32_t flushes;      /* number of TPM2_FlushContext commands */
+    uint32_t delays;       /* number of receive calls to answer with TRY_AGAIN */
+    int      busy;         /* a command was sent and not yet received */
+    uint32_t overlaps;     /* commands sent while another one was busy */
+} TSS2_TCTI_CONTEXT_SESSIONS;
+
+static TSS2_RC
+tcti_sessions_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    TSS2_TCTI_CONTEXT_SESSIONS *tcti = (TSS2_TCTI_CONTEXT_SESSIONS *)tctiContext;
+
+    assert_true(size >= 10);
+    if (tcti->busy)
+        tcti->overlaps++;
+    tcti->busy = 1;
+    tcti->command_code = (uint32_t)buffer[6] << 24 | (uint32_t)buffer[7] << 16
+                         | (uint32_t)buffer[8] << 8 | buffer[9];
+    if (tcti->command_code == TPM2_CC_StartAuthSession)
+        tcti->starts++;
+    else if (tcti->command_code == TPM2_CC_FlushContext)
+        tcti->flushes++;
+    return TSS2_RC_SUCCESS;
+}
+
+static const uint8_t flush_response[] = {
+    0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+    0x00, 0x00, 0x00, 0x0A, /* Response Size 10 */
+    0x00, 0x00, 0x00, 0x00  /* TPM2_RC_SUCCESS */
+};
+
+static TSS2_RC
+tcti_sessions_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                      size_t            *response_size,
+                      uint8_t           *response_buffer,
+                      int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_SESSIONS *tcti = (TSS2_TCTI_CONTEXT_SESSIONS *)tctiContext;
+    uint8_t                     start_response[] = {
+        0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+        0x00, 0x00, 0x00, 0x30, /* Response Size 48 */
+        0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+        0x02, 0x00, 0x00, 0x00, /* sessionHandle */
+        0x00, 0x20,             /* nonceTPM.size */
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+    };
+    const uint8_t *response = &flush_response[0];
+    size_t         size = sizeof(flush_response);
+
+    (void)timeout;
+    if (tcti->delays > 0) {
+        tcti->delays--;
+        return TSS2_TCTI_RC_TRY_AGAIN;
+    }
+
+    if (tcti->command_code == TPM2_CC_StartAuthSession) {
+        start_response[13] = (uint8_t)tcti->starts;
+        response = &start_response[0];
+        size = sizeof(start_response);
+    }
+    *response_size = size;
+    if (response_buffer != NULL) {
+        memcpy(response_buffer, response, size);
+        tcti->busy = 0;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+static int
+setup(void **state) {
+    TSS2_RC                     r;
+    ESYS_CONTEXT               *ectx;
+    TSS2_TCTI_CONTEXT_SESSIONS *tcti = calloc(1, sizeof(*tcti));
+
+    if (tcti == NULL)
+        return -1;
+    tcti->magic = TCTI_SESSIONS_MAGIC;
+    tcti->version = TCTI_SESSIONS_VERSION;
+    tcti->transmit = tcti_sessions_transmit;
+    tcti->receive = tcti_sessions_receive;
+
+    r = Esys_Initialize(&ectx, (TSS2_TCTI_CONTEXT *)tcti, NULL);
+    *state = (void *)ectx;
+    return (int)r;
+}
+
+static int
+teardown(void **state) {
+    TSS2_TCTI_CONTEXT *tcti;
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+
+    Esys_GetTcti(ectx, &tcti);
+    Esys_Finalize(&ectx);
+    free(tcti);
+    return 0;
+}
+
+static TSS2_TCTI_CONTEXT_SESSIONS *
+get_tcti(ESYS_CONTEXT *ectx) {
+    TSS2_TCTI_CONTEXT *tcti;
+
+    assert_int_equal(Esys_GetTcti(ectx, &tcti), TSS2_RC_SUCCESS);
+    return (TSS2_TCTI_CONTEXT_SESSIONS *)tcti;
+}
+
+static const TPMT_SYM_DEF symmetric = {
+    .algorithm = TPM2_ALG_AES,
+    .keyBits = { .aes = 128 },
+    .mode = { .aes = TPM2_ALG_CFB },
+};
+
+static void
+test_bad_parameters(void **state) {
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+    ESYS_SESSION_POOL *pool = NULL;
+    TSS2_RC            r;
+
+    r = Esys_SessionPool_New(NULL, ESYS_TR_NONE, ESYS_TR_NONE, TPM2_SE_HMAC, &symmetric,
+                             TPM2_ALG_SHA256, 1, 2, &pool);
+    assert_int_equal(r, TSS2_ESYS_RC_BAD_REFERENCE);
+
+    r = Esys_SessionPool_New(ectx, ESYS_TR_NONE, ESYS_TR_NONE, TPM2_SE_POLICY, &symmetric,
+                             TPM2_ALG_SHA256, 1, 2, &pool);
+    assert_int_equal(r, TSS2_ESYS_RC_BAD_VALUE);
+
+    r = Esys_SessionPool_New(ectx, ESYS_TR_NONE, ESYS_TR_NONE, TPM2_SE_HMAC, &symmetric,
+                             TPM2_ALG_SHA256, 3, 2, &pool);
+    assert_int_equal(r, TSS2_ESYS_RC_BAD_VALUE);
+    assert_null(pool);
+    assert_int_equal(get_tcti(ectx)->starts, 0);
+
+    Esys_SessionPool_Free(&pool);
+}
+
+static void
+test_lend_and_retire(void **state) {
+    ESYS_CONTEXT               *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_SESSIONS *tcti = get_tcti(ectx);
+    ESYS_SESSION_POOL          *pool = NULL;
+    ESYS_TR                     session[4];
+    TPMA_SESSION                flags;
+    TSS2_RC                     r;
+
+    r = Esys_SessionPool_New(ectx, ESYS_TR_NONE, ESYS_TR_NONE, TPM2_SE_HMAC, &symmetric,
+                             TPM2_ALG_SHA256, 2, 3, &pool);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->starts, 2);
+
+    /* Idle sessions are lent out first, then new ones are started up to max */
+    for (int i = 0; i < 3; i++) {
+        r = Esys_SessionPool_Get(pool, &session[i]);
+        assert_int_equal(r, TSS2_RC_SUCCESS);
+        r = Esys_TRSess_GetAttributes(ectx, session[i], &flags);
+        assert_int_equal(r, TSS2_RC_SUCCESS);
+        assert_int_equal(flags, TPMA_SESSION_CONTINUESESSION);
+    }
+    assert_int_equal(tcti->starts, 3);
+    r = Esys_SessionPool_Get(pool, &session[3]);
+    assert_int_equal(r, TSS2_ESYS_RC_TRY_AGAIN);
+
+    r = Esys_SessionPool_Put(pool, ESYS_TR_NONE, TSS2_RC_SUCCESS);
+    assert_int_equal(r, TSS2_ESYS_RC_BAD_TR);
+
+    /* Attributes of the last borrower are reset */
+    r = Esys_TRSess_SetAttributes(ectx, session[0], TPMA_SESSION_ENCRYPT, 0xff);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    r = Esys_SessionPool_Put(pool, session[0], TSS2_RC_SUCCESS);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    r = Esys_SessionPool_Get(pool, &session[3]);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(session[3], session[0]);
+    r = Esys_TRSess_GetAttributes(ectx, session[3], &flags);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(flags, TPMA_SESSION_CONTINUESESSION);
+
+    /* Sessions are retired after an error */
+    r = Esys_SessionPool_Put(pool, session[1], TPM2_RC_FAILURE);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->flushes, 1);
+    r = Esys_TRSess_GetAttributes(ectx, session[1], &flags);
+    assert_int_equal(r, TSS2_ESYS_RC_BAD_TR);
+
+    /* and after reaching the usage cap */
+    r = Esys_SessionPool_SetMaxUses(pool, 2);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    r = Esys_SessionPool_Put(pool, session[2], TSS2_RC_SUCCESS);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->flushes, 1);
+    r = Esys_SessionPool_Put(pool, session[3], TSS2_RC_SUCCESS);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->flushes, 2);
+
+    /* One idle session is left, the refill starts another one */
+    r = Esys_SessionPool_Refill(pool, -1);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->starts, 4);
+
+    Esys_SessionPool_Free(&pool);
+    assert_null(pool);
+    assert_int_equal(tcti->flushes, 4);
+}
+
+static void
+test_async_refill(void **state) {
+    ESYS_CONTEXT               *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_SESSIONS *tcti = get_tcti(ectx);
+    ESYS_SESSION_POOL          *pool = NULL;
+    ESYS_TR                     session;
+    TSS2_RC                     r;
+
+    r = Esys_SessionPool_New(ectx, ESYS_TR_NONE, ESYS_TR_NONE, TPM2_SE_HMAC, &symmetric,
+                             TPM2_ALG_SHA256, 1, 2, &pool);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    r = Esys_SessionPool_Get(pool, &session);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->starts, 1);
+
+    /* The refill does not block on a slow TPM */
+    tcti->delays = 2;
+    r = Esys_SessionPool_Refill(pool, 0);
+    assert_int_equal(r, TSS2_ESYS_RC_TRY_AGAIN);
+    assert_int_equal(tcti->starts, 2);
+    r = Esys_SessionPool_Refill(pool, 0);
+    assert_int_equal(r, TSS2_ESYS_RC_TRY_AGAIN);
+    r = Esys_SessionPool_Refill(pool, 0);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    /* The pool holds max sessions */
+    r = Esys_SessionPool_Put(pool, session, TSS2_RC_SUCCESS);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    r = Esys_SessionPool_Refill(pool, 0);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->starts, 2);
+
+    /* A pending start is completed before a session is lent out */
+    r = Esys_SessionPool_Get(pool, &session);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    r = Esys_SessionPool_Put(pool, session, TPM2_RC_FAILURE);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    r = Esys_SessionPool_Get(pool, &session);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    tcti->delays = 1;
+    r = Esys_SessionPool_Refill(pool, 0);
+    assert_int_equal(r, TSS2_ESYS_RC_TRY_AGAIN);
+    r = Esys_SessionPool_Get(pool, &session);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->starts, 3);
+
+    Esys_SessionPool_Free(&pool);
+    assert_int_equal(tcti->flushes, 3);
+}
+
+typedef struct {
+    ESYS_SESSION_POOL *pool;
+    size_t             index;
+    size_t             failures;
+} THREAD_ARGS;
+
+static void *
+lend_thread(void *arg) {
+    THREAD_ARGS *args = (THREAD_ARGS *)arg;
+    ESYS_TR      session;
+    TSS2_RC      rc;
+
+    for (size_t i = 0; i < NUM_ITERATIONS; i++) {
+        if (Esys_SessionPool_Get(args->pool, &session) != TSS2_RC_SUCCESS) {
+            args->failures++;
+            continue;
+        }
+        /* Every fifth session is retired and replaced */
+        rc = ((args->index + i) % 5 == 0) ? TPM2_RC_FAILURE : TSS2_RC_SUCCESS;
+        if (Esys_SessionPool_Put(args->pool, session, rc) != TSS2_RC_SUCCESS)
+            args->failures++;
+        /* Blocks in serialized mode instead of leaving a start in flight */
+        if (Esys_SessionPool_Refill(args->pool, 0) != TSS2_RC_SUCCESS)
+            args->failures++;
+    }
+    return NULL;
+}
+
+static void
+test_threads(void **state) {
+    ESYS_CONTEXT               *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_SESSIONS *tcti = get_tcti(ectx);
+    ESYS_SESSION_POOL          *pool = NULL;
+    pthread_t                   threads[NUM_THREADS];
+    THREAD_ARGS                 args[NUM_THREADS];
+    TSS2_RC                     r;
+
+    r = Esys_SerializedModeEnable(ectx);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    r = Esys_SessionPool_New(ectx, ESYS_TR_NONE, ESYS_TR_NONE, TPM2_SE_HMAC, &symmetric,
+                             TPM2_ALG_SHA256, 2, NUM_THREADS, &pool);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+        args[i].pool = pool;
+        args[i].index = i;
+        args[i].failures = 0;
+        assert_int_equal(pthread_create(&threads[i], NULL, lend_thread, &args[i]), 0);
+    }
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        assert_int_equal(args[i].failures, 0);
+    }
+    assert_int_equal(tcti->overlaps, 0);
+    assert_int_equal(tcti->flushes, NUM_THREADS * NUM_ITERATIONS / 5);
+
+    /* Every session started is flushed exactly once */
+    Esys_SessionPool_Free(&pool);
+    assert_int_equal(tcti->flushes, tcti->starts);
+    assert_int_equal(tcti->overlaps, 0);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_bad_parameters, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_lend_and_retire, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_async_refill, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_threads, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,345 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t, uint32_t, uint64_t
+#include <stdlib.h>   // for NULL, size_t, free, calloc
+#include <string.h>   // for memcpy, memset
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
+#include "esys_int.h"             // for RSRC_NODE_T, ESYS_CONTEXT
+#include "esys_types.h"           // for IESYS_RESOURCE, IESYS_SESSION
+#include "tss2-esys/esys_iutil.h" // for esys_CreateResourceObject, iesys_rs...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_ESYS_...
+#include "tss2_esys.h"            // for Esys_Context_Save, Esys_Context_Res...
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_TRANSMIT
+#include "tss2_tpm2_types.h"      // for TPM2_CC_ContextSave, TPM2_CC_Context...
+
+#define LOGMODULE tests
+#include "util/log.h" // for LOG_ERROR
+
+/**
+ * This unit test checks that Esys_Context_Restore() recreates the ESYS_TR
+ * objects saved with Esys_Context_Save() with their original ESYS_TR values,
+ * metadata and auth values, using a TCTI that answers TPM2_ContextSave,
+ * TPM2_ContextLoad and TPM2_FlushContext.
+ */
+
+#define TCTI_CONTEXTS_MAGIC   0x434f4e5445585400ULL /* 'CONTEXT\0' */
+#define TCTI_CONTEXTS_VERSION 0x1
+
+typedef struct {
+    uint64_t               magic;
+    uint32_t               version;
+    TSS2_TCTI_TRANSMIT_FCN transmit;
+    TSS2_TCTI_RECEIVE_FCN  receive;
+    TSS2_RC (*finalize)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC (*cancel)(TSS2_TCTI_CONTEXT *tctiContext);
+    TSS2_RC(*getPollHandles)
+    (TSS2_TCTI_CONTEXT *tctiContext, TSS2_TCTI_POLL_HANDLE *handles, size_t *num_handles);
+    TSS2_RC (*setLocality)(TSS2_TCTI_CONTEXT *tctiContext, uint8_t locality);
+    uint32_t command_code; /* of the last command */
+    uint32_t saves;        /* number of TPM2_ContextSave commands */
+    uint32_t loads;        /* number of TPM2_ContextLoad commands */
+    uint32_t flushes;      /* number of TPM2_FlushContext commands */
+    uint32_t fail_loads;   /* number of TPM2_ContextLoad commands to fail */
+} TSS2_TCTI_CONTEXT_CONTEXTS;
+
+static TSS2_RC
+tcti_contexts_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, const uint8_t *buffer) {
+    TSS2_TCTI_CONTEXT_CONTEXTS *tcti = (TSS2_TCTI_CONTEXT_CONTEXTS *)tctiContext;
+
+    assert_true(size >= 10);
+    tcti->command_code = (uint32_t)buffer[6] << 24 | (uint32_t)buffer[7] << 16
+                         | (uint32_t)buffer[8] << 8 | buffer[9];
+    if (tcti->command_code == TPM2_CC_ContextSave)
+        tcti->saves++;
+    else if (tcti->command_code == TPM2_CC_ContextLoad)
+        tcti->loads++;
+    else if (tcti->command_code == TPM2_CC_FlushContext)
+        tcti->flushes++;
+    return TSS2_RC_SUCCESS;
+}
+
+static const uint8_t flush_response[] = {
+    0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+    0x00, 0x00, 0x00, 0x0A, /* Response Size 10 */
+    0x00, 0x00, 0x00, 0x00  /* TPM2_RC_SUCCESS */
+};
+
+static const uint8_t error_response[] = {
+    0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+    0x00, 0x00, 0x00, 0x0A, /* Response Size 10 */
+    0x00, 0x00, 0x00, 0x9F  /* TPM2_RC_INTEGRITY */
+};
+
+static const uint8_t save_response[] = {
+    0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+    0x00, 0x00, 0x00, 0x20, /* Response Size 32 */
+    0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, /* sequence */
+    0x02, 0x00, 0x00, 0x00, /* savedHandle */
+    0x40, 0x00, 0x00, 0x07, /* hierarchy */
+    0x00, 0x04,             /* contextBlob.size */
+    0xde, 0xad, 0xbe, 0xef,
+};
+
+static const uint8_t load_response[] = {
+    0x80, 0x01,             /* TPM2_ST_NO_SESSIONS */
+    0x00, 0x00, 0x00, 0x0E, /* Response Size 14 */
+    0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+    0x02, 0x00, 0x00, 0x00, /* loadedHandle */
+};
+
+static TSS2_RC
+tcti_contexts_receive(TSS2_TCTI_CONTEXT *tctiContext,
+                      size_t            *response_size,
+                      uint8_t           *response_buffer,
+                      int32_t            timeout) {
+    TSS2_TCTI_CONTEXT_CONTEXTS *tcti = (TSS2_TCTI_CONTEXT_CONTEXTS *)tctiContext;
+    const uint8_t              *response = &flush_response[0];
+    size_t                      size = sizeof(flush_response);
+
+    (void)timeout;
+    if (tcti->command_code == TPM2_CC_ContextSave) {
+        response = &save_response[0];
+        size = sizeof(save_response);
+    } else if (tcti->command_code == TPM2_CC_ContextLoad && tcti->fail_loads > 0) {
+        response = &error_response[0];
+        size = sizeof(error_response);
+    } else if (tcti->command_code == TPM2_CC_ContextLoad) {
+        response = &load_response[0];
+        size = sizeof(load_response);
+    }
+    *response_size = size;
+    if (response_buffer != NULL) {
+        memcpy(response_buffer, response, size);
+        if (response == &error_response[0])
+            tcti->fail_loads--;
+    }
+    return TSS2_RC_SUCCESS;
+}
+
+static int
+setup(void **state) {
+    TSS2_RC                     r;
+    ESYS_CONTEXT               *ectx;
+    TSS2_TCTI_CONTEXT_CONTEXTS *tcti = calloc(1, sizeof(*tcti));
+
+    if (tcti == NULL)
+        return -1;
+    tcti->magic = TCTI_CONTEXTS_MAGIC;
+    tcti->version = TCTI_CONTEXTS_VERSION;
+    tcti->transmit = tcti_contexts_transmit;
+    tcti->receive = tcti_contexts_receive;
+
+    r = Esys_Initialize(&ectx, (TSS2_TCTI_CONTEXT *)tcti, NULL);
+    *state = (void *)ectx;
+    return (int)r;
+}
+
+static int
+teardown(void **state) {
+    TSS2_TCTI_CONTEXT *tcti;
+    ESYS_CONTEXT      *ectx = (ESYS_CONTEXT *)*state;
+
+    Esys_GetTcti(ectx, &tcti);
+    Esys_Finalize(&ectx);
+    free(tcti);
+    return 0;
+}
+
+static TSS2_TCTI_CONTEXT_CONTEXTS *
+get_tcti(ESYS_CONTEXT *ectx) {
+    TSS2_TCTI_CONTEXT *tcti;
+
+    assert_int_equal(Esys_GetTcti(ectx, &tcti), TSS2_RC_SUCCESS);
+    return (TSS2_TCTI_CONTEXT_CONTEXTS *)tcti;
+}
+
+static RSRC_NODE_T *
+create_node(ESYS_CONTEXT *ectx, ESYS_TR esys_handle, TPM2_HANDLE tpm_handle) {
+    RSRC_NODE_T *node = NULL;
+
+    assert_int_equal(esys_CreateResourceObject(ectx, esys_handle, &node), TSS2_RC_SUCCESS);
+    assert_non_null(node);
+    node->rsrc.handle = tpm_handle;
+    node->auth.size = 4;
+    memset(&node->auth.buffer[0], (int)esys_handle, 4);
+    return node;
+}
+
+/* Creates a persistent key at 0x4000, an NV index at 0x4001 and a session at 0x4002 */
+static void
+create_objects(ESYS_CONTEXT *ectx) {
+    RSRC_NODE_T    *node;
+    TPM2B_PUBLIC    public;
+    TPM2B_NV_PUBLIC nv_public;
+    IESYS_SESSION   session;
+
+    node = create_node(ectx, 0x4000, 0x81000001);
+    memset(&public, 0, sizeof(public));
+    public.publicArea.type = TPM2_ALG_SYMCIPHER;
+    public.publicArea.nameAlg = TPM2_ALG_SHA256;
+    public.publicArea.parameters.symDetail.sym.algorithm = TPM2_ALG_NULL;
+    assert_int_equal(iesys_rsrc_set_key_public(ectx, node, &public), TSS2_RC_SUCCESS);
+
+    node = create_node(ectx, 0x4001, 0x01000001);
+    memset(&nv_public, 0, sizeof(nv_public));
+    nv_public.nvPublic.nvIndex = 0x01000001;
+    nv_public.nvPublic.nameAlg = TPM2_ALG_SHA256;
+    nv_public.nvPublic.attributes = TPMA_NV_AUTHWRITE | TPMA_NV_AUTHREAD;
+    nv_public.nvPublic.dataSize = 32;
+    assert_int_equal(iesys_rsrc_set_nv_public(ectx, node, &nv_public), TSS2_RC_SUCCESS);
+
+    node = create_node(ectx, 0x4002, TPM2_HMAC_SESSION_FIRST);
+    memset(&session, 0, sizeof(session));
+    session.sessionType = TPM2_SE_HMAC;
+    session.authHash = TPM2_ALG_SHA256;
+    session.symmetric.algorithm = TPM2_ALG_NULL;
+    session.sessionAttributes = TPMA_SESSION_CONTINUESESSION;
+    session.nonceTPM.size = 32;
+    memset(&session.nonceTPM.buffer[0], 0x55, 32);
+    assert_int_equal(iesys_rsrc_set_session(ectx, node, &session), TSS2_RC_SUCCESS);
+
+    ectx->esys_handle_cnt = 0x4003;
+}
+
+static void
+get_object(ESYS_CONTEXT *ectx, ESYS_TR esys_handle, IESYS_RESOURCE *rsrc, TPM2B_AUTH *auth) {
+    RSRC_NODE_T *node;
+
+    assert_int_equal(esys_GetResourceObject(ectx, esys_handle, &node), TSS2_RC_SUCCESS);
+    assert_int_equal(iesys_rsrc_get(node, rsrc), TSS2_RC_SUCCESS);
+    *auth = node->auth;
+}
+
+static size_t
+count_objects(ESYS_CONTEXT *ectx) {
+    size_t count = 0;
+
+    for (RSRC_NODE_T *node = ectx->rsrc_list; node != NULL; node = node->next)
+        count++;
+    return count;
+}
+
+static void
+test_save_restore(void **state) {
+    ESYS_CONTEXT               *ectx = (ESYS_CONTEXT *)*state, *restored = NULL;
+    TSS2_TCTI_CONTEXT_CONTEXTS *tcti = get_tcti(ectx);
+    IESYS_RESOURCE              rsrc[3], result;
+    TPM2B_AUTH                  auth[3], result_auth;
+    uint8_t                    *buffer = NULL;
+    size_t                      size = 0;
+
+    create_objects(ectx);
+    for (int i = 0; i < 3; i++)
+        get_object(ectx, 0x4000 + i, &rsrc[i], &auth[i]);
+
+    assert_int_equal(Esys_Context_Save(ectx, &buffer, &size), TSS2_RC_SUCCESS);
+    assert_non_null(buffer);
+    /* Only the session needs the TPM and its ESYS_TR is closed */
+    assert_int_equal(tcti->saves, 1);
+    assert_int_equal(count_objects(ectx), 2);
+
+    assert_int_equal(Esys_Initialize(&restored, (TSS2_TCTI_CONTEXT *)tcti, NULL),
+                     TSS2_RC_SUCCESS);
+    assert_int_equal(Esys_Context_Restore(restored, buffer, size), TSS2_RC_SUCCESS);
+    assert_int_equal(tcti->loads, 1);
+    assert_int_equal(count_objects(restored), 3);
+    assert_int_equal(restored->esys_handle_cnt, 0x4003);
+
+    for (int i = 0; i < 3; i++) {
+        get_object(restored, 0x4000 + i, &result, &result_auth);
+        assert_memory_equal(&result, &rsrc[i], sizeof(result));
+        assert_int_equal(result_auth.size, auth[i].size);
+        assert_memory_equal(&result_auth.buffer[0], &auth[i].buffer[0], auth[i].size);
+    }
+
+    /* Snapshots are only restored into empty contexts */
+    assert_int_equal(Esys_Context_Restore(restored, buffer, size), TSS2_ESYS_RC_BAD_SEQUENCE);
+
+    Esys_Finalize(&restored);
+    Esys_Free(buffer);
+}
+
+static void
+test_restore_invalid(void **state) {
+    ESYS_CONTEXT *ectx = (ESYS_CONTEXT *)*state;
+    uint8_t      *buffer = NULL, *longer;
+    size_t        size = 0;
+
+    assert_int_equal(Esys_Context_Save(NULL, &buffer, &size), TSS2_ESYS_RC_BAD_REFERENCE);
+    assert_int_equal(Esys_Context_Restore(ectx, NULL, 0), TSS2_ESYS_RC_BAD_REFERENCE);
+
+    create_objects(ectx);
+    assert_int_equal(Esys_Context_Save(ectx, &buffer, &size), TSS2_RC_SUCCESS);
+    while (ectx->rsrc_list != NULL) {
+        ESYS_TR esys_handle = ectx->rsrc_list->esys_handle;
+        assert_int_equal(Esys_TR_Close(ectx, &esys_handle), TSS2_RC_SUCCESS);
+    }
+
+    /* Truncated snapshots and trailing data are rejected without leftovers */
+    assert_int_not_equal(Esys_Context_Restore(ectx, buffer, size - 1), TSS2_RC_SUCCESS);
+    assert_null(ectx->rsrc_list);
+    longer = calloc(1, size + 1);
+    assert_non_null(longer);
+    memcpy(longer, buffer, size);
+    assert_int_equal(Esys_Context_Restore(ectx, longer, size + 1), TSS2_ESYS_RC_BAD_VALUE);
+    assert_null(ectx->rsrc_list);
+    free(longer);
+
+    /* Wrong magic and crypto backend */
+    buffer[0] ^= 0xff;
+    assert_int_equal(Esys_Context_Restore(ectx, buffer, size), TSS2_ESYS_RC_BAD_VALUE);
+    buffer[0] ^= 0xff;
+    buffer[6] ^= 0xff;
+    assert_int_equal(Esys_Context_Restore(ectx, buffer, size), TSS2_ESYS_RC_BAD_VALUE);
+    buffer[6] ^= 0xff;
+    assert_null(ectx->rsrc_list);
+
+    Esys_Free(buffer);
+}
+
+static void
+test_restore_load_failure(void **state) {
+    ESYS_CONTEXT               *ectx = (ESYS_CONTEXT *)*state;
+    TSS2_TCTI_CONTEXT_CONTEXTS *tcti = get_tcti(ectx);
+    uint8_t                    *buffer = NULL;
+    size_t                      size = 0;
+    ESYS_TR                     esys_handle;
+    TSS2_RC                     r;
+
+    create_objects(ectx);
+    assert_int_equal(Esys_Context_Save(ectx, &buffer, &size), TSS2_RC_SUCCESS);
+    while (ectx->rsrc_list != NULL) {
+        esys_handle = ectx->rsrc_list->esys_handle;
+        assert_int_equal(Esys_TR_Close(ectx, &esys_handle), TSS2_RC_SUCCESS);
+    }
+    ectx->esys_handle_cnt = 0x1000;
+
+    tcti->fail_loads = 1;
+    r = Esys_Context_Restore(ectx, buffer, size);
+    assert_int_equal(r, TPM2_RC_INTEGRITY);
+    assert_null(ectx->rsrc_list);
+    assert_int_equal(ectx->esys_handle_cnt, 0x1000);
+    assert_int_equal(tcti->flushes, 0);
+
+    /* A successful restore after the failure */
+    assert_int_equal(Esys_Context_Restore(ectx, buffer, size), TSS2_RC_SUCCESS);
+    assert_int_equal(count_objects(ectx), 3);
+    Esys_Free(buffer);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_save_restore, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_restore_invalid, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_restore_load_failure, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -15,7 +15,7 @@
 #include "../helper/cmocka_all.h" // for assert_int_equal, cmocka_unit_test...
 #include "esys_int.h"             // for RSRC_NODE_T
 #include "esys_types.h"           // for IESYS_RESOURCE, IESYSC_WITHOUT_MIS...
-#include "tss2-esys/esys_iutil.h" // for esys_CreateResourceObject
+#include "tss2-esys/esys_iutil.h" // for esys_CreateResourceObject, iesys_rs...
 #include "tss2_common.h"          // for TSS2_RC, TSS2_TCTI_RC_NO_CONNECTION
 #include "tss2_esys.h"            // for Esys_GetTcti, ESYS_TR_NONE, ESYS_C...
 #include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_CANCEL
@@ -151,14 +151,18 @@ setup(void **state) {
     r = esys_CreateResourceObject(ectx, objectHandle, &objectHandleNode);
     if (r)
         return (int)r;
-    objectHandleNode->rsrc.rsrcType = IESYSC_SESSION_RSRC;
+    r = iesys_rsrc_set_session(ectx, objectHandleNode, NULL);
+    if (r)
+        return (int)r;
     objectHandleNode->rsrc.handle = TPM2_POLICY_SESSION_FIRST;
 
     objectHandle = DUMMY_TR_HANDLE_HMAC_SESSION;
     r = esys_CreateResourceObject(ectx, objectHandle, &objectHandleNode);
     if (r)
         return (int)r;
-    objectHandleNode->rsrc.rsrcType = IESYSC_SESSION_RSRC;
+    r = iesys_rsrc_set_session(ectx, objectHandleNode, NULL);
+    if (r)
+        return (int)r;
     objectHandleNode->rsrc.handle = TPM2_HMAC_SESSION_FIRST;
 
     objectHandle = DUMMY_TR_HANDLE_KEY;
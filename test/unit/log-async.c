@@ -0,0 +1,117 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <pthread.h> // for pthread_create, pthread_join, pthread_t
+#include <stdio.h>   // for fopen, fgets, sscanf, freopen, NULL
+#include <stdlib.h>  // for setenv, mkstemp
+#include <string.h>  // for strstr
+#include <unistd.h>  // for close, unlink
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, CMUnitTest, cmocka_run_group_tests
+
+#define LOGMODULE test
+#include "util/log.h" // for LOG_INFO, LOG_ERROR, doLogFlush
+
+#if defined(LOG_ASYNC_ENABLED) && defined(LOG_FILE_ENABLED) && MAXLOGLEVEL >= LOGL_INFO
+#define NUM_THREADS  4
+#define NUM_MESSAGES 2000
+
+static char logpath[] = "/tmp/tss2-log-async-XXXXXX";
+
+static void *
+log_thread(void *arg) {
+    int id = (int)(size_t)arg;
+    int i;
+
+    for (i = 0; i < NUM_MESSAGES; i++)
+        LOG_INFO("thread %d message %d", id, i);
+
+    return NULL;
+}
+
+static int
+count_lines(const char *match) {
+    char  line[1024];
+    int   lines = 0;
+    FILE *f = fopen(logpath, "r");
+
+    assert_non_null(f);
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (strstr(line, match) != NULL)
+            lines++;
+    }
+    fclose(f);
+    return lines;
+}
+
+static void
+log_async_ordering(void **state) {
+    pthread_t threads[NUM_THREADS];
+    int       next[NUM_THREADS] = { 0 };
+    char      line[1024];
+    char     *msg;
+    int       id, i;
+    FILE     *f;
+
+    for (i = 0; i < NUM_THREADS; i++)
+        assert_int_equal(pthread_create(&threads[i], NULL, log_thread, (void *)(size_t)i), 0);
+    for (i = 0; i < NUM_THREADS; i++)
+        pthread_join(threads[i], NULL);
+
+    doLogFlush();
+
+    /* Every message must be written exactly once and in order per thread */
+    f = fopen(logpath, "r");
+    assert_non_null(f);
+    while (fgets(line, sizeof(line), f) != NULL) {
+        msg = strstr(line, "thread ");
+        if (msg == NULL)
+            continue;
+        assert_int_equal(sscanf(msg, "thread %d message %d", &id, &i), 2);
+        assert_in_range(id, 0, NUM_THREADS - 1);
+        assert_int_equal(i, next[id]);
+        next[id]++;
+    }
+    fclose(f);
+
+    for (i = 0; i < NUM_THREADS; i++)
+        assert_int_equal(next[i], NUM_MESSAGES);
+}
+
+static void
+log_async_error_flush(void **state) {
+    /* Errors are on disk when LOG_ERROR returns, without an explicit flush */
+    LOG_ERROR("fatal test error");
+    assert_int_equal(count_lines("fatal test error"), 1);
+}
+#endif
+
+int
+main(int argc, char *argv[]) {
+#if defined(LOG_ASYNC_ENABLED) && defined(LOG_FILE_ENABLED) && MAXLOGLEVEL >= LOGL_INFO
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(log_async_ordering),
+        cmocka_unit_test(log_async_error_flush),
+    };
+    int fd, ret;
+
+    fd = mkstemp(logpath);
+    if (fd < 0)
+        return 1;
+    close(fd);
+
+    setenv("TSS2_LOG", "test+info", 1);
+    setenv("TSS2_LOG_ASYNC", "1", 1);
+    setenv("TSS2_LOGFILE", logpath, 1);
+
+    ret = cmocka_run_group_tests(tests, NULL, NULL);
+    unlink(logpath);
+    return ret;
+#else
+    return 77;
+#endif
+}
@@ -0,0 +1,196 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t
+#include <stdlib.h>   // for NULL, calloc, free, size_t
+#include <string.h>   // for memcpy, memset
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, CMUnitTest, ass...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_SY...
+#include "tss2_sys.h"             // for TSS2_SYS_CONTEXT, Tss2_Sys_SaveCo...
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_CONT...
+#include "tss2_tpm2_types.h"      // for TPM2_RC_SUCCESS, TPM2_RS_PW
+
+const uint8_t get_random_16[] = {
+    0x80, 0x01,             /* TPM_ST_NO_SESSION */
+    0x00, 0x00, 0x00, 0x0C, /* Command Size */
+    0x00, 0x00, 0x01, 0x7B, /* TPM2_CC_GetRandom */
+    0x00, 0x10,             /* bytesRequested */
+};
+
+const uint8_t ok_response[] = {
+    0x80, 0x01,             /* TPM_ST_NO_SESSION */
+    0x00, 0x00, 0x00, 0x1C, /* Response Size 10 + 2 + 16 */
+    0x00, 0x00, 0x00, 0x00, /* TPM_RC_SUCCESS */
+    0x00, 0x10,             /* size of buffer */
+    0xde, 0xad, 0xbe, 0xef, 0xde, 0xad, 0xbe, 0xef, 0xde, 0xad, 0xbe, 0xef, 0xde, 0xad, 0xbe, 0xef,
+};
+
+static uint8_t last_command[sizeof(get_random_16)];
+
+static TSS2_RC
+tcti_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, uint8_t const *command) {
+    if (size != sizeof(last_command))
+        return TSS2_TCTI_RC_BAD_VALUE;
+
+    memcpy(last_command, command, size);
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_receive(TSS2_TCTI_CONTEXT *tctiContext, size_t *size, uint8_t *response, int32_t timeout) {
+    *size = sizeof(ok_response);
+    if (response != NULL)
+        memcpy(response, ok_response, sizeof(ok_response));
+
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_ABI_VERSION            ver = TSS2_ABI_VERSION_CURRENT;
+static TSS2_TCTI_CONTEXT_COMMON_V1 _tcti_v1_ctx;
+
+static int
+setup(void **state) {
+    TSS2_SYS_CONTEXT  *sys_ctx;
+    TSS2_TCTI_CONTEXT *tcti_ctx = (TSS2_TCTI_CONTEXT *)&_tcti_v1_ctx;
+    UINT32             size_ctx;
+    TSS2_RC            r;
+
+    size_ctx = Tss2_Sys_GetContextSize(0);
+    sys_ctx = calloc(1, size_ctx);
+    assert_non_null(sys_ctx);
+    _tcti_v1_ctx.version = 1;
+    _tcti_v1_ctx.transmit = tcti_transmit;
+    _tcti_v1_ctx.receive = tcti_receive;
+
+    r = Tss2_Sys_Initialize(sys_ctx, size_ctx, tcti_ctx, &ver);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    memset(last_command, 0, sizeof(last_command));
+    *state = sys_ctx;
+
+    return 0;
+}
+
+static int
+teardown(void **state) {
+    TSS2_SYS_CONTEXT *sys_ctx = (TSS2_SYS_CONTEXT *)*state;
+
+    if (sys_ctx)
+        free(sys_ctx);
+
+    return 0;
+}
+
+static void
+test_template_reuse(void **state) {
+    TSS2_SYS_CONTEXT      *sys_ctx = (TSS2_SYS_CONTEXT *)*state;
+    TSS2_SYS_CMD_TEMPLATE *tmpl;
+    size_t                 size = 0;
+    TPM2B_DIGEST           random = { 0 };
+    int                    i;
+    TSS2_RC                r;
+
+    r = Tss2_Sys_GetRandom_Prepare(sys_ctx, 16);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    r = Tss2_Sys_SaveCommandTemplate(sys_ctx, NULL, &size);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_true(size > sizeof(get_random_16));
+
+    tmpl = calloc(1, size);
+    assert_non_null(tmpl);
+    r = Tss2_Sys_SaveCommandTemplate(sys_ctx, tmpl, &size);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    for (i = 0; i < 3; i++) {
+        r = Tss2_Sys_LoadCommandTemplate(sys_ctx, tmpl);
+        assert_int_equal(r, TSS2_RC_SUCCESS);
+
+        r = Tss2_Sys_Execute(sys_ctx);
+        assert_int_equal(r, TSS2_RC_SUCCESS);
+        assert_memory_equal(last_command, get_random_16, sizeof(get_random_16));
+
+        r = Tss2_Sys_GetRandom_Complete(sys_ctx, &random);
+        assert_int_equal(r, TSS2_RC_SUCCESS);
+        assert_int_equal(random.size, 16);
+    }
+
+    free(tmpl);
+}
+
+static void
+test_template_patch(void **state) {
+    TSS2_SYS_CONTEXT      *sys_ctx = (TSS2_SYS_CONTEXT *)*state;
+    TSS2_SYS_CMD_TEMPLATE *tmpl;
+    size_t                 size = 0;
+    const uint8_t          bytes_requested[] = { 0x00, 0x10 };
+    TSS2_RC                r;
+
+    r = Tss2_Sys_GetRandom_Prepare(sys_ctx, 32);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    r = Tss2_Sys_SaveCommandTemplate(sys_ctx, NULL, &size);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    tmpl = calloc(1, size);
+    assert_non_null(tmpl);
+    r = Tss2_Sys_SaveCommandTemplate(sys_ctx, tmpl, &size);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    r = Tss2_Sys_LoadCommandTemplate(sys_ctx, tmpl);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    r = Tss2_Sys_PatchCpBuffer(sys_ctx, 1, sizeof(bytes_requested), bytes_requested);
+    assert_int_equal(r, TSS2_SYS_RC_BAD_SIZE);
+
+    r = Tss2_Sys_PatchCpBuffer(sys_ctx, 0, sizeof(bytes_requested), bytes_requested);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    r = Tss2_Sys_Execute(sys_ctx);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_memory_equal(last_command, get_random_16, sizeof(get_random_16));
+
+    free(tmpl);
+}
+
+static void
+test_template_bad_sequence(void **state) {
+    TSS2_SYS_CONTEXT      *sys_ctx = (TSS2_SYS_CONTEXT *)*state;
+    TSS2L_SYS_AUTH_COMMAND auths = { .count = 1, .auths = { { .sessionHandle = TPM2_RS_PW } } };
+    uint8_t                buffer[64];
+    size_t                 size = 0;
+    TSS2_RC                r;
+
+    r = Tss2_Sys_SaveCommandTemplate(sys_ctx, NULL, &size);
+    assert_int_equal(r, TSS2_SYS_RC_BAD_SEQUENCE);
+
+    r = Tss2_Sys_PatchCpBuffer(sys_ctx, 0, 1, buffer);
+    assert_int_equal(r, TSS2_SYS_RC_BAD_SEQUENCE);
+
+    r = Tss2_Sys_GetRandom_Prepare(sys_ctx, 16);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    size = 1;
+    r = Tss2_Sys_SaveCommandTemplate(sys_ctx, (TSS2_SYS_CMD_TEMPLATE *)buffer, &size);
+    assert_int_equal(r, TSS2_SYS_RC_INSUFFICIENT_BUFFER);
+
+    r = Tss2_Sys_SetCmdAuths(sys_ctx, &auths);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    r = Tss2_Sys_SaveCommandTemplate(sys_ctx, NULL, &size);
+    assert_int_equal(r, TSS2_SYS_RC_BAD_SEQUENCE);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_template_reuse, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_template_patch, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_template_bad_sequence, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,204 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t
+#include <stdlib.h>   // for NULL, calloc, free, size_t
+#include <string.h>   // for memcpy, memset
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, CMUnitTest, ass...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_SY...
+#include "tss2_sys.h"             // for TSS2_SYS_CONTEXT, Tss2_Sys_Execut...
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_CONT...
+#include "tss2_tpm2_types.h"      // for TPM2_RC_SUCCESS, TPM2_RC_RETRY
+
+#define NUM_CONTEXTS 2
+
+const uint8_t ok_response[] = {
+    0x80, 0x01,             /* TPM_ST_NO_SESSION */
+    0x00, 0x00, 0x00, 0x12, /* Response Size 10 + 2 + 6 */
+    0x00, 0x00, 0x00, 0x00, /* TPM_RC_SUCCESS */
+    0x00, 0x06,             /* size of buffer */
+    0xde, 0xad, 0xbe, 0xef, 0xde, 0xad,
+};
+
+const uint8_t retry_response[] = {
+    0x80, 0x01,             /* TPM_ST_NO_SESSION */
+    0x00, 0x00, 0x00, 0x0A, /* Response Size 10 */
+    0x00, 0x00, 0x09, 0x22  /* TPM2_RC_RETRY */
+};
+
+/* Sequence of prepare (P), transmit (T), receive (R) and complete (C) events */
+static char events[64];
+static int  retries;
+
+static void
+add_event(char event) {
+    size_t len = strlen(events);
+
+    assert_true(len + 1 < sizeof(events));
+    events[len] = event;
+}
+
+static TSS2_RC
+tcti_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, uint8_t const *command) {
+    add_event('T');
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_receive(TSS2_TCTI_CONTEXT *tctiContext, size_t *size, uint8_t *response, int32_t timeout) {
+    if (response == NULL) {
+        *size = sizeof(ok_response);
+        return TSS2_RC_SUCCESS;
+    }
+
+    add_event('R');
+    if (retries > 0) {
+        retries--;
+        memcpy(response, retry_response, sizeof(retry_response));
+        *size = sizeof(retry_response);
+        return TSS2_RC_SUCCESS;
+    }
+    memcpy(response, ok_response, sizeof(ok_response));
+    *size = sizeof(ok_response);
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+batch_prepare(TSS2_SYS_CONTEXT *sysContext, size_t index, void *userData) {
+    add_event('P');
+    return Tss2_Sys_GetRandom_Prepare(sysContext, 6);
+}
+
+static TSS2_RC
+batch_complete(TSS2_SYS_CONTEXT *sysContext, size_t index, TSS2_RC responseCode, void *userData) {
+    size_t      *completed = userData;
+    TPM2B_DIGEST random = { 0 };
+    TSS2_RC      r;
+
+    add_event('C');
+    assert_int_equal(responseCode, TSS2_RC_SUCCESS);
+    assert_int_equal(index, *completed);
+
+    r = Tss2_Sys_GetRandom_Complete(sysContext, &random);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(random.size, 6);
+
+    *completed += 1;
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_ABI_VERSION            ver = TSS2_ABI_VERSION_CURRENT;
+static TSS2_TCTI_CONTEXT_COMMON_V1 _tcti_v1_ctx;
+
+static int
+setup(void **state) {
+    TSS2_SYS_CONTEXT **sys_ctxs;
+    TSS2_TCTI_CONTEXT *tcti_ctx = (TSS2_TCTI_CONTEXT *)&_tcti_v1_ctx;
+    UINT32             size_ctx;
+    TSS2_RC            r;
+    int                i;
+
+    _tcti_v1_ctx.version = 1;
+    _tcti_v1_ctx.transmit = tcti_transmit;
+    _tcti_v1_ctx.receive = tcti_receive;
+
+    sys_ctxs = calloc(NUM_CONTEXTS, sizeof(*sys_ctxs));
+    assert_non_null(sys_ctxs);
+
+    size_ctx = Tss2_Sys_GetContextSize(0);
+    for (i = 0; i < NUM_CONTEXTS; i++) {
+        sys_ctxs[i] = calloc(1, size_ctx);
+        assert_non_null(sys_ctxs[i]);
+
+        r = Tss2_Sys_Initialize(sys_ctxs[i], size_ctx, tcti_ctx, &ver);
+        assert_int_equal(r, TSS2_RC_SUCCESS);
+    }
+
+    memset(events, 0, sizeof(events));
+    retries = 0;
+    *state = sys_ctxs;
+
+    return 0;
+}
+
+static int
+teardown(void **state) {
+    TSS2_SYS_CONTEXT **sys_ctxs = *state;
+    int                i;
+
+    for (i = 0; i < NUM_CONTEXTS; i++)
+        free(sys_ctxs[i]);
+    free(sys_ctxs);
+
+    return 0;
+}
+
+static void
+test_batch_pipelined(void **state) {
+    TSS2_SYS_CONTEXT **sys_ctxs = *state;
+    size_t             completed = 0;
+    TSS2_RC            r;
+
+    r = Tss2_Sys_ExecuteBatch(sys_ctxs, NUM_CONTEXTS, 3, batch_prepare, batch_complete,
+                              &completed);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(completed, 3);
+    assert_string_equal(events, "PTPRCTPRCTRC");
+}
+
+static void
+test_batch_single_context(void **state) {
+    TSS2_SYS_CONTEXT **sys_ctxs = *state;
+    size_t             completed = 0;
+    TSS2_RC            r;
+
+    r = Tss2_Sys_ExecuteBatch(sys_ctxs, 1, 3, batch_prepare, batch_complete, &completed);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(completed, 3);
+    assert_string_equal(events, "PTRCPTRCPTRC");
+}
+
+static void
+test_batch_resubmit(void **state) {
+    TSS2_SYS_CONTEXT **sys_ctxs = *state;
+    size_t             completed = 0;
+    TSS2_RC            r;
+
+    retries = 2;
+    r = Tss2_Sys_ExecuteBatch(sys_ctxs, NUM_CONTEXTS, 2, batch_prepare, batch_complete,
+                              &completed);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+    assert_int_equal(completed, 2);
+    assert_string_equal(events, "PTPRTRTRCTRC");
+}
+
+static void
+test_batch_bad_args(void **state) {
+    TSS2_SYS_CONTEXT **sys_ctxs = *state;
+    TSS2_RC            r;
+
+    r = Tss2_Sys_ExecuteBatch(NULL, NUM_CONTEXTS, 1, batch_prepare, batch_complete, NULL);
+    assert_int_equal(r, TSS2_SYS_RC_BAD_REFERENCE);
+
+    r = Tss2_Sys_ExecuteBatch(sys_ctxs, 0, 1, batch_prepare, batch_complete, NULL);
+    assert_int_equal(r, TSS2_SYS_RC_BAD_VALUE);
+
+    r = Tss2_Sys_ExecuteBatch(sys_ctxs, NUM_CONTEXTS, 1, batch_prepare, NULL, NULL);
+    assert_int_equal(r, TSS2_SYS_RC_BAD_REFERENCE);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_batch_pipelined, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_batch_single_context, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_batch_resubmit, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_batch_bad_args, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
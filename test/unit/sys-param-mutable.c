@@ -0,0 +1,181 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <inttypes.h> // for uint8_t, int32_t
+#include <stdlib.h>   // for NULL, calloc, free, size_t
+#include <string.h>   // for memcpy
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, CMUnitTest, ass...
+#include "tss2_common.h"          // for TSS2_RC, TSS2_RC_SUCCESS, TSS2_SY...
+#include "tss2_sys.h"             // for Tss2_Sys_GetDecryptParamMutable, ...
+#include "tss2_tcti.h"            // for TSS2_TCTI_CONTEXT, TSS2_TCTI_CONT...
+#include "tss2_tpm2_types.h"      // for TPM2B_DIGEST, TPM2_RS_PW
+
+static const uint8_t random_response[] = {
+    0x80, 0x02,             /* TPM2_ST_SESSIONS */
+    0x00, 0x00, 0x00, 0x1b, /* Response Size 10 + 4 + 8 + 5 */
+    0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+    0x00, 0x00, 0x00, 0x08, /* parameterSize */
+    0x00, 0x06,             /* size of buffer */
+    0xde, 0xad, 0xbe, 0xef, 0xde, 0xad,
+    0x00, 0x00,             /* nonce */
+    0x01,                   /* sessionAttributes */
+    0x00, 0x00,             /* hmac */
+};
+
+static const uint8_t oversized_response[] = {
+    0x80, 0x02,             /* TPM2_ST_SESSIONS */
+    0x00, 0x00, 0x00, 0x1b, /* Response Size 10 + 4 + 8 + 5 */
+    0x00, 0x00, 0x00, 0x00, /* TPM2_RC_SUCCESS */
+    0x00, 0x00, 0x00, 0x08, /* parameterSize */
+    0xff, 0xff,             /* size of buffer beyond the response */
+    0xde, 0xad, 0xbe, 0xef, 0xde, 0xad,
+    0x00, 0x00,             /* nonce */
+    0x01,                   /* sessionAttributes */
+    0x00, 0x00,             /* hmac */
+};
+
+static const uint8_t *response_data = random_response;
+
+static TSS2_RC
+tcti_transmit(TSS2_TCTI_CONTEXT *tctiContext, size_t size, uint8_t const *command) {
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_RC
+tcti_receive(TSS2_TCTI_CONTEXT *tctiContext, size_t *size, uint8_t *response, int32_t timeout) {
+    *size = sizeof(random_response);
+    if (response != NULL)
+        memcpy(response, response_data, sizeof(random_response));
+    return TSS2_RC_SUCCESS;
+}
+
+static TSS2_ABI_VERSION            ver = TSS2_ABI_VERSION_CURRENT;
+static TSS2_TCTI_CONTEXT_COMMON_V1 _tcti_v1_ctx;
+
+static int
+setup(void **state) {
+    TSS2_SYS_CONTEXT *sys_ctx;
+    UINT32            size_ctx;
+    TSS2_RC           r;
+
+    _tcti_v1_ctx.version = 1;
+    _tcti_v1_ctx.transmit = tcti_transmit;
+    _tcti_v1_ctx.receive = tcti_receive;
+    response_data = random_response;
+
+    size_ctx = Tss2_Sys_GetContextSize(0);
+    sys_ctx = calloc(1, size_ctx);
+    assert_non_null(sys_ctx);
+    r = Tss2_Sys_Initialize(sys_ctx, size_ctx, (TSS2_TCTI_CONTEXT *)&_tcti_v1_ctx, &ver);
+    assert_int_equal(r, TSS2_RC_SUCCESS);
+
+    *state = sys_ctx;
+    return 0;
+}
+
+static int
+teardown(void **state) {
+    TSS2_SYS_CONTEXT *sys_ctx = (TSS2_SYS_CONTEXT *)*state;
+
+    Tss2_Sys_Finalize(sys_ctx);
+    free(sys_ctx);
+    return 0;
+}
+
+/* Send TPM2_GetRandom with a password session, so the response has sessions */
+static void
+execute_get_random(TSS2_SYS_CONTEXT *sys_ctx) {
+    TSS2L_SYS_AUTH_COMMAND auths = {
+        .count = 1,
+        .auths = { { .sessionHandle = TPM2_RH_PW } },
+    };
+
+    assert_int_equal(Tss2_Sys_GetRandom_Prepare(sys_ctx, 6), TSS2_RC_SUCCESS);
+    assert_int_equal(Tss2_Sys_SetCmdAuths(sys_ctx, &auths), TSS2_RC_SUCCESS);
+    assert_int_equal(Tss2_Sys_Execute(sys_ctx), TSS2_RC_SUCCESS);
+}
+
+static void
+test_decrypt_param(void **state) {
+    TSS2_SYS_CONTEXT    *sys_ctx = (TSS2_SYS_CONTEXT *)*state;
+    TPM2B_SENSITIVE_DATA data = { .size = 4, .buffer = { 1, 2, 3, 4 } };
+    static const uint8_t expected[] = { 0x00, 0x04, 0xfe, 0xfd, 0xfc, 0xfb };
+    uint8_t             *buffer;
+    const uint8_t       *const_buffer, *cp_buffer;
+    size_t               size, cp_size;
+
+    assert_int_equal(Tss2_Sys_StirRandom_Prepare(sys_ctx, &data), TSS2_RC_SUCCESS);
+    assert_int_equal(Tss2_Sys_GetDecryptParamMutable(sys_ctx, &size, &buffer), TSS2_RC_SUCCESS);
+    assert_int_equal(size, 4);
+
+    /* Modified in place, as parameter encryption does */
+    for (size_t i = 0; i < size; i++)
+        buffer[i] ^= 0xff;
+
+    assert_int_equal(Tss2_Sys_GetDecryptParam(sys_ctx, &size, &const_buffer), TSS2_RC_SUCCESS);
+    assert_ptr_equal(const_buffer, buffer);
+    assert_int_equal(Tss2_Sys_GetCpBuffer(sys_ctx, &cp_size, &cp_buffer), TSS2_RC_SUCCESS);
+    assert_int_equal(cp_size, sizeof(expected));
+    assert_memory_equal(cp_buffer, expected, sizeof(expected));
+}
+
+static void
+test_encrypt_param(void **state) {
+    TSS2_SYS_CONTEXT *sys_ctx = (TSS2_SYS_CONTEXT *)*state;
+    TPM2B_DIGEST      random = { 0 };
+    uint8_t          *buffer;
+    size_t            size;
+
+    execute_get_random(sys_ctx);
+    assert_int_equal(Tss2_Sys_GetEncryptParamMutable(sys_ctx, &size, &buffer), TSS2_RC_SUCCESS);
+    assert_int_equal(size, 6);
+    assert_int_equal(buffer[0], 0xde);
+
+    for (size_t i = 0; i < size; i++)
+        buffer[i] = (uint8_t)i;
+
+    assert_int_equal(Tss2_Sys_GetRandom_Complete(sys_ctx, &random), TSS2_RC_SUCCESS);
+    assert_int_equal(random.size, 6);
+    for (size_t i = 0; i < size; i++)
+        assert_int_equal(random.buffer[i], i);
+}
+
+static void
+test_errors(void **state) {
+    TSS2_SYS_CONTEXT *sys_ctx = (TSS2_SYS_CONTEXT *)*state;
+    uint8_t          *buffer;
+    size_t            size;
+
+    assert_int_equal(Tss2_Sys_GetDecryptParamMutable(NULL, &size, &buffer),
+                     TSS2_SYS_RC_BAD_REFERENCE);
+    assert_int_equal(Tss2_Sys_GetEncryptParamMutable(sys_ctx, &size, NULL),
+                     TSS2_SYS_RC_BAD_REFERENCE);
+
+    /* TPM2_GetRandom has no command parameter to encrypt */
+    assert_int_equal(Tss2_Sys_GetRandom_Prepare(sys_ctx, 6), TSS2_RC_SUCCESS);
+    assert_int_equal(Tss2_Sys_GetDecryptParamMutable(sys_ctx, &size, &buffer),
+                     TSS2_SYS_RC_NO_DECRYPT_PARAM);
+    assert_int_equal(Tss2_Sys_GetEncryptParamMutable(sys_ctx, &size, &buffer),
+                     TSS2_SYS_RC_BAD_SEQUENCE);
+
+    /* A size beyond the buffer is not handed out for writing */
+    response_data = oversized_response;
+    execute_get_random(sys_ctx);
+    assert_int_equal(Tss2_Sys_GetEncryptParamMutable(sys_ctx, &size, &buffer),
+                     TSS2_SYS_RC_MALFORMED_RESPONSE);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_decrypt_param, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_encrypt_param, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_errors, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
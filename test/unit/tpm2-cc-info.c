@@ -0,0 +1,76 @@
+/* SPDX-FileCopyrightText: 2026, tpm2-software community */
+/* SPDX-License-Identifier: BSD-2-Clause */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // IWYU pragma: keep
+#endif
+
+#include <stdio.h> // for NULL
+
+#include "../helper/cmocka_all.h" // for assert_int_equal, assert_non_null, ...
+#include "tss2_tpm2_types.h"      // for TPM2_CC_Create, TPM2_CC_GetRandom, ...
+#include "util/tpm2_cc_info.h"    // for tpm2_cc_info_get, TPM2_CC_INFO
+
+static void
+tpm2_cc_info_create_test(void **state) {
+    const TPM2_CC_INFO *info = tpm2_cc_info_get(TPM2_CC_Create);
+
+    assert_non_null(info);
+    assert_int_equal(info->numCommandHandles, 1);
+    assert_int_equal(info->numAuthHandles, 1);
+    assert_int_equal(info->numResponseHandles, 0);
+    assert_int_equal(info->authAllowed, 1);
+    assert_int_equal(info->decryptAllowed, 1);
+    assert_int_equal(info->encryptAllowed, 1);
+    assert_int_equal(info->duration, TPM2_CC_DURATION_LONG);
+}
+
+static void
+tpm2_cc_info_load_test(void **state) {
+    const TPM2_CC_INFO *info = tpm2_cc_info_get(TPM2_CC_Load);
+
+    assert_non_null(info);
+    assert_int_equal(info->numCommandHandles, 1);
+    assert_int_equal(info->numResponseHandles, 1);
+    assert_int_equal(info->decryptAllowed, 1);
+    assert_int_equal(info->encryptAllowed, 1);
+}
+
+static void
+tpm2_cc_info_no_auth_test(void **state) {
+    const TPM2_CC_INFO *info = tpm2_cc_info_get(TPM2_CC_GetRandom);
+
+    assert_non_null(info);
+    assert_int_equal(info->numCommandHandles, 0);
+    assert_int_equal(info->numAuthHandles, 0);
+    assert_int_equal(info->decryptAllowed, 0);
+    assert_int_equal(info->encryptAllowed, 1);
+    assert_int_equal(info->duration, TPM2_CC_DURATION_SHORT);
+}
+
+static void
+tpm2_cc_info_unknown_test(void **state) {
+    assert_null(tpm2_cc_info_get(TPM2_CC_FIRST - 1));
+    assert_null(tpm2_cc_info_get(TPM2_CC_LAST + 1));
+    assert_null(tpm2_cc_info_get(TPM2_CC_Vendor_TCG_Test));
+    assert_int_equal(tpm2_cc_info_poll_interval(TPM2_CC_Vendor_TCG_Test), 8);
+}
+
+static void
+tpm2_cc_info_poll_interval_test(void **state) {
+    assert_int_equal(tpm2_cc_info_poll_interval(TPM2_CC_GetRandom), 1);
+    assert_int_equal(tpm2_cc_info_poll_interval(TPM2_CC_Sign), 8);
+    assert_int_equal(tpm2_cc_info_poll_interval(TPM2_CC_CreatePrimary), 20);
+}
+
+int
+main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(tpm2_cc_info_create_test),
+        cmocka_unit_test(tpm2_cc_info_load_test),
+        cmocka_unit_test(tpm2_cc_info_no_auth_test),
+        cmocka_unit_test(tpm2_cc_info_unknown_test),
+        cmocka_unit_test(tpm2_cc_info_poll_interval_test),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}